@@ -5,7 +5,7 @@ include $(CLEAR_VARS)
 
 LOCAL_CFLAGS := -g
 LOCAL_MODULE := libarstream_android
-LOCAL_SRC_FILES := JNI/c/ARSTREAM_JNIReader.c JNI/c/ARSTREAM_JNISender.c
+LOCAL_SRC_FILES := JNI/c/ARSTREAM_JNIReader.c JNI/c/ARSTREAM_JNISender.c JNI/c/ARSTREAM_JNITrace.c
 LOCAL_LDLIBS := -llog -lz
 LOCAL_SHARED_LIBRARIES := \
 	libARStream \
@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Capture.h
+ * @brief Capture of the packets received by a stream reader, and their replay
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_CAPTURE_H_
+#define _ARSTREAM_CAPTURE_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Magic number at the start of a capture file
+ *
+ * A capture file is made of a 16 bytes header :
+ * - the 8 bytes magic number "ARSCAP01"
+ * - the maximum packet size of the capturing reader (32 bits little endian)
+ * - 4 reserved bytes (0)
+ *
+ * followed by one record per packet received by the reader, in reception order :
+ * - the time since the previous packet (or since the start of the capture) in microseconds, as an unsigned LEB128 varint
+ * - the packet size, as an unsigned LEB128 varint
+ * - the packet (stream data header and fragment), as received
+ */
+#define ARSTREAM_CAPTURE_MAGIC "ARSCAP01"
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Timing of a replayed capture
+ */
+typedef enum {
+    ARSTREAM_CAPTURE_REPLAY_ORIGINAL_TIMING = 0, /**< Packets are given to the reader at the times they were captured */
+    ARSTREAM_CAPTURE_REPLAY_AS_FAST_AS_POSSIBLE, /**< Packets are given to the reader as soon as it reads */
+} eARSTREAM_CAPTURE_REPLAY_MODE;
+
+/**
+ * @brief Statistics of a capture or of a replay
+ */
+typedef struct {
+    uint64_t nbPackets; /**< Number of packets written to (capture) or read from (replay) the file */
+    uint64_t nbBytes; /**< Number of packet bytes written or read (without the record headers) */
+    uint64_t durationUs; /**< Capture time of the last packet, relative to the start of the capture */
+    uint32_t nbErrors; /**< Capture : write errors (the capture stops on the first one). Replay : skipped (too large) or corrupted records */
+    int isFinished; /**< Replay only : 1 once the whole file was given to the reader */
+} ARSTREAM_Capture_Stats_t;
+
+#endif /* _ARSTREAM_CAPTURE_H_ */
@@ -0,0 +1,155 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_CipherFilter.h
+ * @brief ChaCha20 encryption filter for the ARSTREAM_Sender / ARSTREAM_Reader filter chains
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_CIPHER_FILTER_H_
+#define _ARSTREAM_CIPHER_FILTER_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+#include <stddef.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Filter.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Size of the key, in bytes
+ */
+#define ARSTREAM_CIPHER_FILTER_KEY_SIZE (32)
+
+/**
+ * @brief Size of the per-frame nonce prepended to each encrypted frame, in bytes
+ */
+#define ARSTREAM_CIPHER_FILTER_NONCE_SIZE (8)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Direction of an ARSTREAM_CipherFilter_t
+ */
+typedef enum {
+    ARSTREAM_CIPHER_FILTER_MODE_ENCRYPT = 0, /**< Sender side : frames are encrypted, and grow by ARSTREAM_CIPHER_FILTER_NONCE_SIZE bytes */
+    ARSTREAM_CIPHER_FILTER_MODE_DECRYPT, /**< Reader side : frames are decrypted, and shrink by ARSTREAM_CIPHER_FILTER_NONCE_SIZE bytes */
+    ARSTREAM_CIPHER_FILTER_MODE_MAX,
+} eARSTREAM_CIPHER_FILTER_MODE;
+
+/**
+ * @brief An ARSTREAM_CipherFilter_t instance encrypts or decrypts whole frames with ChaCha20 (RFC 8439)
+ *
+ * Each encrypted frame starts with a 64 bits little endian nonce, followed by the ciphertext (same size as the
+ * plaintext). The encryption side draws its first nonce at random, then increments it for each frame, so a key
+ * can be shared by several streams and reused across sessions.
+ *
+ * The filter is meant to be the last one of the sender chain, and the first one of the reader chain.
+ *
+ * @warning This filter provides confidentiality only : frames are not authenticated, and a modified ciphertext
+ * is decrypted to a modified plaintext without any error
+ */
+typedef struct ARSTREAM_CipherFilter_t ARSTREAM_CipherFilter_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_CipherFilter_t
+ * @warning This function allocates memory. An ARSTREAM_CipherFilter_t must be deleted by a call to ARSTREAM_CipherFilter_Delete
+ *
+ * @param[in] key The ARSTREAM_CIPHER_FILTER_KEY_SIZE bytes key, shared by the sender and the reader (copied)
+ * @param[in] mode Encryption (sender) or decryption (reader)
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_CipherFilter_t, or NULL if an error occured
+ *
+ * @note In encryption mode, the creation fails if no random nonce can be read from the system
+ * @see ARSTREAM_CipherFilter_GetFilter()
+ * @see ARSTREAM_CipherFilter_Delete()
+ */
+ARSTREAM_CipherFilter_t* ARSTREAM_CipherFilter_New (const uint8_t *key, eARSTREAM_CIPHER_FILTER_MODE mode, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Deletes an ARSTREAM_CipherFilter_t
+ * @warning This function should NOT be called while a sender or a reader using the filter is still running
+ *
+ * @param cipherFilter Pointer to the ARSTREAM_CipherFilter_t * to delete
+ *
+ * @return ARSTREAM_OK if the ARSTREAM_CipherFilter_t was deleted
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if cipherFilter does not point to a valid ARSTREAM_CipherFilter_t
+ *
+ * @note The library use a double pointer, so it can set *cipherFilter to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_CipherFilter_Delete (ARSTREAM_CipherFilter_t **cipherFilter);
+
+/**
+ * @brief Gets the ARSTREAM_Filter_t of an ARSTREAM_CipherFilter_t
+ * The returned filter can be given to ARSTREAM_Sender_AddFilter() (encryption mode) or to ARSTREAM_Reader_AddFilter()
+ * (decryption mode). It stays valid until the ARSTREAM_CipherFilter_t is deleted.
+ *
+ * @param[in] cipherFilter The ARSTREAM_CipherFilter_t
+ * @return A pointer to the filter, or NULL if cipherFilter is NULL
+ */
+ARSTREAM_Filter_t* ARSTREAM_CipherFilter_GetFilter (ARSTREAM_CipherFilter_t *cipherFilter);
+
+/**
+ * @brief Encrypts or decrypts a buffer with ChaCha20 (RFC 8439)
+ * This is the raw stream cipher used by the filter, exposed for interoperability tests.
+ *
+ * @param[in] key The ARSTREAM_CIPHER_FILTER_KEY_SIZE bytes key
+ * @param[in] nonce The 12 bytes RFC 8439 nonce
+ * @param[in] counter Initial block counter
+ * @param[in] input Data to process
+ * @param[out] output Processed data (may be equal to input)
+ * @param[in] size Size of input and output
+ */
+void ARSTREAM_CipherFilter_ChaCha20 (const uint8_t *key, const uint8_t *nonce, uint32_t counter, const uint8_t *input, uint8_t *output, size_t size);
+
+/**
+ * @brief Gets the name of the ChaCha20 implementation chosen at build time
+ * @return "neon", "sse2" or "c"
+ */
+const char* ARSTREAM_CipherFilter_GetImplementation (void);
+
+#endif /* _ARSTREAM_CIPHER_FILTER_H_ */
@@ -64,6 +64,7 @@ typedef enum {
     ARSTREAM_ERROR_FRAME_TOO_LARGE, /**< Bad parameter : frame too large */
     ARSTREAM_ERROR_BUSY, /**< Object is busy and the operation can not be applied on running objects */
     ARSTREAM_ERROR_QUEUE_FULL, /**< Frame queue is full */
+    ARSTREAM_ERROR_NOT_SYNCHRONIZED, /**< Clocks are not synchronized yet */
 } eARSTREAM_ERROR;
 
 /**
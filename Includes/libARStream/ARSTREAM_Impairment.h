@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Impairment.h
+ * @brief Network impairment emulation for the stream sender and reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_IMPAIRMENT_H_
+#define _ARSTREAM_IMPAIRMENT_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Maximum number of packets held by an impaired link at the same time
+ * Packets sent while the link is full are counted in ARSTREAM_Impairment_Stats_t.nbLostQueue
+ */
+#define ARSTREAM_IMPAIRMENT_MAX_PACKETS (4096)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Description of the impairments applied to the packets sent by a sender (data) or a reader (acks)
+ *
+ * All the random decisions are taken from a PRNG seeded with the seed field, in the order
+ * of the packets, so two runs with the same config and the same packet sequence take the same decisions.
+ *
+ * Losses follow a Gilbert-Elliott model : the link is either in the "good" state (loss rate lossPercent)
+ * or in the "bad" state (loss rate burstLossPercent). Before each packet, the link goes from good to bad
+ * with the probability burstEnterPercent, and from bad to good with the probability burstExitPercent.
+ * Setting burstEnterPercent to 0 gives a plain random loss.
+ *
+ * The delay of a packet is delayMs, plus a uniform random jitter in [0, jitterMs]. Unless it is
+ * reordered, a packet never overtakes the previous one. A reordered packet gets reorderDelayMs more,
+ * and is overtaken by the packets sent during this time.
+ *
+ * If bandwidthKbps is not zero, packets are serialized on a link of this bandwidth before being delayed,
+ * and dropped if the serialization backlog would exceed queueLimitBytes (0 for an unlimited backlog).
+ *
+ * @see ARSTREAM_Impairment_DefaultConfig()
+ */
+typedef struct {
+    uint32_t seed; /**< Seed of the PRNG (0 is replaced by 1) */
+    float lossPercent; /**< Loss rate in the good state (0 to 100) */
+    float burstEnterPercent; /**< Probability to go from the good to the bad state, per packet (0 to 100) */
+    float burstExitPercent; /**< Probability to go from the bad to the good state, per packet (0 to 100) */
+    float burstLossPercent; /**< Loss rate in the bad state (0 to 100) */
+    uint32_t delayMs; /**< Fixed delay */
+    uint32_t jitterMs; /**< Maximum random delay added to delayMs */
+    float reorderPercent; /**< Probability to reorder a packet (0 to 100) */
+    uint32_t reorderDelayMs; /**< Extra delay of the reordered packets */
+    float duplicatePercent; /**< Probability to deliver a packet twice (0 to 100) */
+    uint32_t bandwidthKbps; /**< Bandwidth of the link in kbit/s (0 for unlimited) */
+    uint32_t queueLimitBytes; /**< Maximum serialization backlog in bytes (0 for unlimited, unused if bandwidthKbps is 0) */
+} ARSTREAM_Impairment_Config_t;
+
+/**
+ * @brief Statistics of an impaired link
+ */
+typedef struct {
+    uint64_t nbPackets; /**< Number of packets sent on the link */
+    uint64_t nbLostRandom; /**< Number of packets lost in the good state */
+    uint64_t nbLostBurst; /**< Number of packets lost in the bad state */
+    uint64_t nbLostQueue; /**< Number of packets dropped because the link was full */
+    uint64_t nbDuplicated; /**< Number of duplicated packets */
+    uint64_t nbReordered; /**< Number of reordered packets */
+    uint64_t nbDelivered; /**< Number of packets (including duplicates) given to the underlying transport */
+    uint32_t meanDelayUs; /**< Mean time spent by the delivered packets in the impaired link */
+    uint32_t maxDelayUs; /**< Maximum time spent by a delivered packet in the impaired link */
+} ARSTREAM_Impairment_Stats_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Sets an ARSTREAM_Impairment_Config_t to a perfect link (no loss, no delay, no bandwidth limit)
+ * @param[out] config The config to set
+ */
+void ARSTREAM_Impairment_DefaultConfig (ARSTREAM_Impairment_Config_t *config);
+
+#endif /* _ARSTREAM_IMPAIRMENT_H_ */
@@ -0,0 +1,191 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_JitterBuffer.h
+ * @brief Playout jitter buffer for reassembled frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_JITTER_BUFFER_H_
+#define _ARSTREAM_JITTER_BUFFER_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Reader.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Default minimum playout delay, in ms
+ */
+#define ARSTREAM_JITTER_BUFFER_MIN_DELAY_MS_DEFAULT (0)
+
+/**
+ * @brief Default maximum playout delay, in ms
+ */
+#define ARSTREAM_JITTER_BUFFER_MAX_DELAY_MS_DEFAULT (200)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Callback called when a frame leaves the jitter buffer
+ *
+ * @param[in] cause The cause given to ARSTREAM_JitterBuffer_PushFrame() (ARSTREAM_READER_CAUSE_FRAME_COMPLETE or ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE) when the frame reached its playout time, ARSTREAM_READER_CAUSE_CANCEL when the jitter buffer is stopping
+ * @param[in] framePointer Pointer to the frame, as given to ARSTREAM_JitterBuffer_PushFrame()
+ * @param[in] frameSize Size of the frame
+ * @param[in] numberOfSkippedFrames Number of skipped frames, as given to ARSTREAM_JitterBuffer_PushFrame()
+ * @param[in] isFlushFrame Flush frame flag, as given to ARSTREAM_JitterBuffer_PushFrame()
+ * @param[in] timestampUs Timestamp of the frame (as given to ARSTREAM_JitterBuffer_PushFrame(), or estimated by the jitter buffer)
+ * @param[in] custom Custom pointer passed during ARSTREAM_JitterBuffer_New
+ *
+ * @note Once this callback returns, the jitter buffer does not use framePointer anymore.
+ */
+typedef void (*ARSTREAM_JitterBuffer_FrameCallback_t) (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint64_t timestampUs, void *custom);
+
+/**
+ * @brief Statistics of an ARSTREAM_JitterBuffer_t
+ */
+typedef struct {
+    uint32_t nbFramesIn; /**< Number of frames pushed into the jitter buffer */
+    uint32_t nbFramesOut; /**< Number of frames given to the callback */
+    uint32_t nbFramesRejected; /**< Number of frames which were rejected because the jitter buffer was full */
+    uint32_t nbLateFrames; /**< Number of frames which arrived after their playout time */
+    uint32_t nbEarlyFrames; /**< Number of frames which arrived before their playout time, and were delayed */
+    uint32_t meanLatenessUs; /**< Mean delay after the playout time of the late frames */
+    uint32_t maxLatenessUs; /**< Max delay after the playout time of the late frames */
+    uint32_t meanHoldTimeUs; /**< Mean time spent by the early frames in the jitter buffer */
+    uint32_t jitterUs; /**< Current estimation of the network jitter */
+    uint32_t targetDelayUs; /**< Current playout delay */
+} ARSTREAM_JitterBuffer_Stats_t;
+
+/**
+ * @brief An ARSTREAM_JitterBuffer_t instance delays the frames given by an ARSTREAM_Reader_t to smooth their output
+ */
+typedef struct ARSTREAM_JitterBuffer_t ARSTREAM_JitterBuffer_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_JitterBuffer_t
+ * @warning This function allocates memory. An ARSTREAM_JitterBuffer_t must be deleted by a call to ARSTREAM_JitterBuffer_Delete
+ *
+ * @param[in] callback The callback which will be called when a frame reaches its playout time
+ * @param[in] maxNumberOfFrames Maximum number of frames held by the jitter buffer
+ * @param[in] minDelayMs Minimum playout delay
+ * @param[in] maxDelayMs Maximum playout delay. If minDelayMs == maxDelayMs, the playout delay is fixed. Otherwise, the delay adapts to the measured jitter within these bounds.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_JitterBuffer_t, or NULL if an error occured
+ * @see ARSTREAM_JitterBuffer_Stop()
+ * @see ARSTREAM_JitterBuffer_Delete()
+ */
+ARSTREAM_JitterBuffer_t* ARSTREAM_JitterBuffer_New (ARSTREAM_JitterBuffer_FrameCallback_t callback, int maxNumberOfFrames, int32_t minDelayMs, int32_t maxDelayMs, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Stops a running ARSTREAM_JitterBuffer_t
+ * @warning Once stopped, an ARSTREAM_JitterBuffer_t can not be restarted
+ *
+ * @param[in] jitterBuffer The ARSTREAM_JitterBuffer_t to stop
+ *
+ * @note Calling this function multiple times has no effect
+ * @note Frames still held by the jitter buffer are given back to the callback with the ARSTREAM_READER_CAUSE_CANCEL cause
+ */
+void ARSTREAM_JitterBuffer_Stop (ARSTREAM_JitterBuffer_t *jitterBuffer);
+
+/**
+ * @brief Deletes an ARSTREAM_JitterBuffer_t
+ * @warning This function should NOT be called on a running ARSTREAM_JitterBuffer_t
+ *
+ * @param jitterBuffer Pointer to the ARSTREAM_JitterBuffer_t * to delete
+ *
+ * @return ARSTREAM_OK if the ARSTREAM_JitterBuffer_t was deleted
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_JitterBuffer_t is still busy and can not be stopped now (probably because ARSTREAM_JitterBuffer_Stop() was not called yet)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if jitterBuffer does not point to a valid ARSTREAM_JitterBuffer_t
+ *
+ * @note The library use a double pointer, so it can set *jitterBuffer to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_Delete (ARSTREAM_JitterBuffer_t **jitterBuffer);
+
+/**
+ * @brief Adds a reassembled frame to the jitter buffer
+ * This function is typically called from the ARSTREAM_Reader_FrameCompleteCallback_t. The jitter buffer keeps a reference on
+ * framePointer until it is given back through the ARSTREAM_JitterBuffer_FrameCallback_t, so the application must not reuse
+ * it as a reader buffer before that.
+ *
+ * @param[in] jitterBuffer The ARSTREAM_JitterBuffer_t
+ * @param[in] cause Cause given by the reader : ARSTREAM_READER_CAUSE_FRAME_COMPLETE, or ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE for a partial frame (forwarded to the ARSTREAM_JitterBuffer_FrameCallback_t)
+ * @param[in] framePointer Pointer to the frame
+ * @param[in] frameSize Size of the frame
+ * @param[in] numberOfSkippedFrames Number of frames skipped before this one (as given by the reader)
+ * @param[in] isFlushFrame Boolean-like (0-1) flag telling if the frame is a flush frame
+ * @param[in] timestampUs Sender timestamp of the frame, in microseconds, or 0 if the sender does not provide timestamps. In this case, timestamps are estimated from the frame rate measured on the reception times.
+ *
+ * @return ARSTREAM_OK if the frame was added
+ * @return ARSTREAM_ERROR_QUEUE_FULL if the jitter buffer already holds maxNumberOfFrames frames (the frame is not added)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if jitterBuffer does not point to a valid ARSTREAM_JitterBuffer_t, if framePointer is NULL, or if cause is not a frame delivery cause
+ *
+ * @note ARSTREAM_Reader_GetMissingRegions() only works from within the reader callback, so the missing regions of an incomplete frame must be read before it is pushed
+ */
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_PushFrame (ARSTREAM_JitterBuffer_t *jitterBuffer, eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint64_t timestampUs);
+
+/**
+ * @brief Runs the output loop of the ARSTREAM_JitterBuffer_t
+ * @warning This function never returns until ARSTREAM_JitterBuffer_Stop() is called. Thus, it should be called on its own thread
+ * @post Stop the ARSTREAM_JitterBuffer_t by calling ARSTREAM_JitterBuffer_Stop() before joining the thread calling this function
+ * @param[in] ARSTREAM_JitterBuffer_t_Param A valid (ARSTREAM_JitterBuffer_t *) casted as a (void *)
+ */
+void* ARSTREAM_JitterBuffer_RunThread (void *ARSTREAM_JitterBuffer_t_Param);
+
+/**
+ * @brief Gets the statistics of the jitter buffer
+ * @param[in] jitterBuffer The ARSTREAM_JitterBuffer_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if stats was filled
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if jitterBuffer does not point to a valid ARSTREAM_JitterBuffer_t, or if stats is NULL
+ */
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_GetStats (ARSTREAM_JitterBuffer_t *jitterBuffer, ARSTREAM_JitterBuffer_Stats_t *stats);
+
+#endif /* _ARSTREAM_JITTER_BUFFER_H_ */
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Loopback.h
+ * @brief In-process link between one ARSTREAM_Sender_t and one ARSTREAM_Reader_t
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_LOOPBACK_H_
+#define _ARSTREAM_LOOPBACK_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Default number of packets which can be in flight in each direction
+ */
+#define ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS (1024)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Direction of the packets in the loopback
+ */
+typedef enum {
+    ARSTREAM_LOOPBACK_DIRECTION_DATA = 0, /**< Fragments, from the sender to the reader */
+    ARSTREAM_LOOPBACK_DIRECTION_ACK, /**< Acks and key frame requests, from the reader to the sender */
+    ARSTREAM_LOOPBACK_DIRECTION_MAX,
+} eARSTREAM_LOOPBACK_DIRECTION;
+
+/**
+ * @brief Hook called for each packet entering the loopback, to simulate losses and delays
+ *
+ * @param[in] packet The packet data (including the stream headers)
+ * @param[in] size The packet size
+ * @param[in] custom Custom pointer given to ARSTREAM_Loopback_SetHook()
+ * @return A negative value to drop the packet, or the delay (in microseconds) before the packet can be read
+ *
+ * @note Packets are delivered in order : a delayed packet also delays the following ones
+ * @warning The hook is called from the sending thread of the direction (sender data thread or reader ack thread)
+ */
+typedef int (*ARSTREAM_Loopback_PacketHook_t) (uint8_t *packet, uint32_t size, void *custom);
+
+/**
+ * @brief Statistics of one direction of the loopback
+ */
+typedef struct {
+    uint64_t nbPackets; /**< Number of packets delivered to the peer */
+    uint64_t nbBytes; /**< Number of bytes delivered to the peer */
+    uint64_t nbDroppedByHook; /**< Number of packets dropped by the hook */
+    uint64_t nbDroppedFull; /**< Number of packets dropped because the peer did not read fast enough */
+} ARSTREAM_Loopback_Stats_t;
+
+/**
+ * @brief An ARSTREAM_Loopback_t links one ARSTREAM_Sender_t to one ARSTREAM_Reader_t in the same process
+ * Packets go through lock-free single producer/single consumer rings, so the measured
+ * costs are the ones of the library (fragmentation, acks, filters, callbacks) and not
+ * the ones of a network stack.
+ * @see ARSTREAM_Sender_NewLoopback()
+ * @see ARSTREAM_Reader_NewLoopback()
+ */
+typedef struct ARSTREAM_Loopback_t ARSTREAM_Loopback_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_Loopback_t
+ * @warning This function allocates memory. An ARSTREAM_Loopback_t must be deleted by a call to ARSTREAM_Loopback_Delete
+ *
+ * @param[in] nbPackets Number of packets which can be in flight in each direction (rounded up to a power of 2)
+ * @param[in] maxFragmentSize Maximum fragment size of the sender and reader which will use this loopback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Loopback_t, or NULL if an error occured
+ */
+ARSTREAM_Loopback_t* ARSTREAM_Loopback_New (uint32_t nbPackets, uint32_t maxFragmentSize, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Sets (or removes) the hook of one direction of the loopback
+ * @param[in] loopback The loopback
+ * @param[in] direction The direction of the packets given to the hook
+ * @param[in] hook The hook, or NULL to deliver all packets without delay
+ * @param[in] custom Custom pointer passed to the hook
+ * @return ARSTREAM_OK on success, ARSTREAM_ERROR_BAD_PARAMETERS on bad parameters
+ *
+ * @warning Must be called before starting the threads of the sender and of the reader
+ */
+eARSTREAM_ERROR ARSTREAM_Loopback_SetHook (ARSTREAM_Loopback_t *loopback, eARSTREAM_LOOPBACK_DIRECTION direction, ARSTREAM_Loopback_PacketHook_t hook, void *custom);
+
+/**
+ * @brief Gets the statistics of one direction of the loopback
+ * @param[in] loopback The loopback
+ * @param[in] direction The direction
+ * @param[out] stats Pointer to the structure to fill
+ * @return ARSTREAM_OK on success, ARSTREAM_ERROR_BAD_PARAMETERS on bad parameters
+ */
+eARSTREAM_ERROR ARSTREAM_Loopback_GetStats (ARSTREAM_Loopback_t *loopback, eARSTREAM_LOOPBACK_DIRECTION direction, ARSTREAM_Loopback_Stats_t *stats);
+
+/**
+ * @brief Deletes an ARSTREAM_Loopback_t
+ * @param[in] loopback Pointer to the ARSTREAM_Loopback_t * to delete
+ * @return ARSTREAM_OK if the loopback was deleted
+ * @return ARSTREAM_ERROR_BUSY if a sender or a reader still uses the loopback
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if loopback is an invalid pointer
+ *
+ * @note The library use a double pointer, so it can set *loopback to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_Loopback_Delete (ARSTREAM_Loopback_t **loopback);
+
+#endif /* _ARSTREAM_LOOPBACK_H_ */
@@ -0,0 +1,187 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Publisher.h
+ * @brief Refcounted multi-consumer publication of received frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_PUBLISHER_H_
+#define _ARSTREAM_PUBLISHER_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Reader.h>
+
+/*
+ * Macros
+ */
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Behavior of a subscriber when its queue is full
+ */
+typedef enum {
+    ARSTREAM_PUBLISHER_DROP_OLDEST = 0, /**< The oldest queued frame is released to make room for the new one */
+    ARSTREAM_PUBLISHER_DROP_NEWEST, /**< The new frame is not queued */
+    ARSTREAM_PUBLISHER_DROP_UNTIL_FLUSH_FRAME, /**< All queued frames are released, and new frames are dropped until the next flush frame */
+    ARSTREAM_PUBLISHER_DROP_MAX,
+} eARSTREAM_PUBLISHER_DROP_POLICY;
+
+/**
+ * @brief A published frame
+ * @warning Published frames are shared between all subscribers, and must not be modified
+ */
+typedef struct {
+    const uint8_t *data; /**< Frame data */
+    uint32_t size; /**< Frame size */
+    int isFlushFrame; /**< Boolean-like (0-1) flag telling if the frame is a flush frame (typically an I-Frame) for the sender */
+    int isIncomplete; /**< Boolean-like (0-1) flag telling if the frame was delivered as ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE */
+    int numberOfSkippedFrames; /**< Number of frames skipped by the reader before this one */
+    uint32_t index; /**< Index of the frame in the publisher (incremented for each published frame) */
+} ARSTREAM_Publisher_Frame_t;
+
+/**
+ * @brief An ARSTREAM_Publisher_t instance owns a pool of frame buffers, and shares the frames of an ARSTREAM_Reader_t between its subscribers
+ */
+typedef struct ARSTREAM_Publisher_t ARSTREAM_Publisher_t;
+
+/**
+ * @brief A subscriber of an ARSTREAM_Publisher_t
+ */
+typedef struct ARSTREAM_Publisher_Subscriber_t ARSTREAM_Publisher_Subscriber_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_Publisher_t
+ * @warning This function allocates memory. An ARSTREAM_Publisher_t must be deleted by a call to ARSTREAM_Publisher_Delete
+ *
+ * @param[in] nbBuffers Number of buffers in the pool. This should be greater than the sum of the subscribers queue depths, plus one buffer for the reader.
+ * @param[in] bufferCapacity Initial capacity of each buffer (buffers are grown if the reader needs it)
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Publisher_t, or NULL if an error occured
+ *
+ * @note To use the publisher, create the reader with ARSTREAM_Publisher_FrameCompleteCallback as the callback, the publisher
+ * as the custom pointer, and a first buffer given by ARSTREAM_Publisher_GetFirstBuffer()
+ */
+ARSTREAM_Publisher_t* ARSTREAM_Publisher_New (int nbBuffers, uint32_t bufferCapacity, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Deletes an ARSTREAM_Publisher_t
+ *
+ * @param publisher Pointer to the ARSTREAM_Publisher_t * to delete
+ *
+ * @return ARSTREAM_OK if the ARSTREAM_Publisher_t was deleted
+ * @return ARSTREAM_ERROR_BUSY if some subscribers are still registered, or if some buffers are still in use (by the reader, or by a subscriber)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if publisher does not point to a valid ARSTREAM_Publisher_t
+ *
+ * @note The library use a double pointer, so it can set *publisher to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_Publisher_Delete (ARSTREAM_Publisher_t **publisher);
+
+/**
+ * @brief Gets the first buffer to give to ARSTREAM_Reader_New()
+ * @param[in] publisher The ARSTREAM_Publisher_t
+ * @param[out] bufferCapacity Capacity of the returned buffer
+ * @return A buffer of the pool, or NULL if no buffer is available
+ */
+uint8_t* ARSTREAM_Publisher_GetFirstBuffer (ARSTREAM_Publisher_t *publisher, uint32_t *bufferCapacity);
+
+/**
+ * @brief ARSTREAM_Reader_FrameCompleteCallback_t implementation which publishes the frames to the subscribers
+ * @note The custom pointer of the reader must be the ARSTREAM_Publisher_t
+ * @note If a frame needs a bigger buffer while all the buffers are held by the subscribers, the frame is skipped
+ * and counted in ARSTREAM_Publisher_GetNumberOfDroppedFrames()
+ * @see ARSTREAM_Reader_FrameCompleteCallback_t
+ */
+uint8_t* ARSTREAM_Publisher_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+
+/**
+ * @brief Adds a new subscriber to the publisher
+ * @param[in] publisher The ARSTREAM_Publisher_t
+ * @param[in] queueDepth Maximum number of frames waiting in the queue of the subscriber
+ * @param[in] dropPolicy Behavior of the subscriber when its queue is full
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new subscriber, or NULL if an error occured
+ * @note The subscriber only receives the frames published after this call
+ */
+ARSTREAM_Publisher_Subscriber_t* ARSTREAM_Publisher_Subscribe (ARSTREAM_Publisher_t *publisher, int queueDepth, eARSTREAM_PUBLISHER_DROP_POLICY dropPolicy, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Removes a subscriber from its publisher
+ * Frames still in the subscriber queue are released.
+ * @param subscriber Pointer to the ARSTREAM_Publisher_Subscriber_t * to remove
+ * @return ARSTREAM_OK if the subscriber was removed
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if subscriber does not point to a valid subscriber
+ * @warning This function must not be called while another thread waits in ARSTREAM_Publisher_PopFrame() for the same subscriber
+ * @note The library use a double pointer, so it can set *subscriber to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_Publisher_Unsubscribe (ARSTREAM_Publisher_Subscriber_t **subscriber);
+
+/**
+ * @brief Gets the next frame of a subscriber
+ * @param[in] subscriber The subscriber
+ * @param[in] timeoutMs Maximum time to wait for a frame. 0 does not wait, -1 waits until a frame is available.
+ * @param[out] nbDroppedFrames Optionnal pointer which will hold the number of frames dropped by this subscriber queue since the previous call
+ * @return The next frame, or NULL if no frame was available before the timeout
+ * @note Each returned frame must be released with ARSTREAM_Publisher_ReleaseFrame()
+ */
+const ARSTREAM_Publisher_Frame_t* ARSTREAM_Publisher_PopFrame (ARSTREAM_Publisher_Subscriber_t *subscriber, int timeoutMs, int *nbDroppedFrames);
+
+/**
+ * @brief Releases a frame returned by ARSTREAM_Publisher_PopFrame()
+ * The buffer of the frame goes back to the pool once all subscribers released it.
+ * @param[in] frame The frame to release
+ */
+void ARSTREAM_Publisher_ReleaseFrame (const ARSTREAM_Publisher_Frame_t *frame);
+
+/**
+ * @brief Gets the number of frames which could not be published because all the buffers of the pool were in use
+ * @param[in] publisher The ARSTREAM_Publisher_t
+ * @return The number of frames dropped by the publisher, or -1 if publisher is invalid
+ */
+int ARSTREAM_Publisher_GetNumberOfDroppedFrames (ARSTREAM_Publisher_t *publisher);
+
+#endif /* _ARSTREAM_PUBLISHER_H_ */
@@ -49,11 +49,16 @@
 #include <libARNetwork/ARNETWORK_Manager.h>
 #include <libARStream/ARSTREAM_Error.h>
 #include <libARStream/ARSTREAM_Filter.h>
+#include <libARStream/ARSTREAM_Impairment.h>
+#include <libARStream/ARSTREAM_Capture.h>
+#include <libARStream/ARSTREAM_Loopback.h>
+#include <libARStream/ARSTREAM_Stats.h>
 
 /*
  * Macros
  */
 #define ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT (5)
+#define ARSTREAM_READER_KEY_FRAME_REQUEST_INTERVAL_DEFAULT_MS (200)
 
 /*
  * Types
@@ -67,9 +72,20 @@ typedef enum {
     ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL, /**< Frame buffer is too small for the frame on the network */
     ARSTREAM_READER_CAUSE_COPY_COMPLETE, /**< Copy of previous frame buffer is complete (called only after ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL) */
     ARSTREAM_READER_CAUSE_CANCEL, /**< Reader is closing, so buffer is no longer used */
+    ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE, /**< Frame is incomplete (only sent when partial frame delivery is enabled) */
     ARSTREAM_READER_CAUSE_MAX,
 } eARSTREAM_READER_CAUSE;
 
+/**
+ * @brief Reasons sent along with a key frame request
+ */
+typedef enum {
+    ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_STARTUP = 0, /**< The reader did not receive any flush frame yet */
+    ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_LOSS, /**< A frame was lost, so the next frames can not be decoded */
+    ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_APPLICATION, /**< The application asked for a key frame (e.g. after a decoding error) */
+    ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_MAX,
+} eARSTREAM_READER_KEY_FRAME_REQUEST_REASON;
+
 /**
  * @brief Callback called when a new frame is ready in a buffer
  *
@@ -87,12 +103,70 @@ typedef enum {
  * @note If cause is ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL, datas will be copied into the new frame. Old frame buffer will still be in use until the callback is called again with ARSTREAM_READER_CAUSE_COPY_COMPLETE cause. If the new frame is still too small, the callback will be called again, until a suitable buffer is provided. newBufferCapacity holds a suitable capacity for the new buffer, but still has to be updated by the application.
  * @note If cause is ARSTREAM_READER_CAUSE_COPY_COMPLETE, the return value and newBufferCapacity are unused. If numberOfSkippedFrames is non-zero, then the current frame will be skipped (usually because the buffer returned after the ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL was smaller than the previous buffer).
  * @note If cause is ARSTREAM_READER_CAUSE_CANCEL, the return value and newBufferCapacity are unused
+ * @note If cause is ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE, the callback behaves as for ARSTREAM_READER_CAUSE_FRAME_COMPLETE, but some fragments of the frame were lost. Missing regions are zero-filled and can be retrieved with ARSTREAM_Reader_GetMissingRegions() from within the callback.
  *
  * @warning If the cause is ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL, returning a buffer shorter than 'frameSize' will cause the library to skip the current frame
  * @warning In any case, returning a NULL buffer is not supported.
  */
 typedef uint8_t* (*ARSTREAM_Reader_FrameCompleteCallback_t) (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
 
+/**
+ * @brief Callback called when the contiguous beginning of the current frame grows
+ *
+ * @param[in] framePointer Pointer to the buffer holding the current frame
+ * @param[in] previousPrefixSize Size of the prefix given in the previous call for the same frame (0 for a new frame)
+ * @param[in] prefixSize Number of contiguous bytes available from the beginning of the frame
+ * @param[in] isFlushFrame Boolean-like (0-1) flag telling if the frame is a flush frame (typically an I-Frame) for the sender
+ * @param[in] custom Custom pointer passed during ARSTREAM_Reader_New
+ *
+ * @note Bytes between previousPrefixSize and prefixSize are new, and can be given to the decoder right away.
+ * @note framePointer may change between two calls for the same frame if the buffer was reallocated (see ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL). The previously given bytes stay at the same offsets.
+ * @note The frame completion is still signaled through the ARSTREAM_Reader_FrameCompleteCallback_t. If a call with previousPrefixSize == 0 happens before the completion, the previous frame was dropped.
+ * @warning framePointer must not be modified or released by the application.
+ */
+typedef void (*ARSTREAM_Reader_FramePrefixCallback_t) (uint8_t *framePointer, uint32_t previousPrefixSize, uint32_t prefixSize, int isFlushFrame, void *custom);
+
+/**
+ * @brief Byte range of a frame which was not received
+ * @see ARSTREAM_Reader_GetMissingRegions()
+ */
+typedef struct {
+    uint32_t offset; /**< Offset of the first missing byte in the frame */
+    uint32_t size; /**< Number of missing bytes */
+} ARSTREAM_Reader_MissingRegion_t;
+
+/**
+ * @brief Statistics on the interruptions of the delivered stream
+ * A freeze is the time between the last frame delivered before a loss, and the next delivered frame.
+ * @see ARSTREAM_Reader_GetFreezeStats()
+ */
+typedef struct {
+    uint32_t nbFreezes; /**< Number of freezes since the reader started */
+    uint32_t totalFreezeMs; /**< Cumulated duration of all freezes */
+    uint32_t maxFreezeMs; /**< Duration of the longest freeze */
+    uint32_t lastFreezeMs; /**< Duration of the most recent freeze */
+    uint32_t firstFrameDelayMs; /**< Time between the start of the reader and the first delivered frame (0 if no frame was delivered yet) */
+    uint32_t nbKeyFrameRequests; /**< Number of key frame requests sent to the sender */
+} ARSTREAM_Reader_FreezeStats_t;
+
+/**
+ * @brief Statistics of an ARSTREAM_Reader_t, since ARSTREAM_Reader_RunDataThread() started
+ * All the fields are 32 bits wide, so the structure has no padding and can be copied as is (e.g. to a Java ByteBuffer)
+ * @see ARSTREAM_Reader_GetStats()
+ */
+typedef struct {
+    uint32_t nbFragmentsReceived; /**< Number of fragments received, including duplicates */
+    uint32_t nbFragmentsUseful; /**< Number of fragments which were useful (not received before, and not part of a skipped frame) */
+    uint32_t nbFramesComplete; /**< Number of complete frames delivered to the application */
+    uint32_t nbFramesIncomplete; /**< Number of frames delivered with ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE */
+    uint32_t nbFramesDropped; /**< Number of frames superseded by a newer frame before their completion */
+    uint32_t nbFramesSkipped; /**< Number of frames not delivered while waiting for a flush frame (see ARSTREAM_Reader_SetSkipUntilFlushFrame()) */
+    uint32_t nbAcksSent; /**< Number of acks (or frame skip messages) sent to the sender */
+    float efficiency; /**< Same as ARSTREAM_Reader_GetEstimatedEfficiency() */
+    ARSTREAM_Reader_FreezeStats_t freezeStats; /**< Same as ARSTREAM_Reader_GetFreezeStats() */
+    uint32_t reassemblyTimeHistogram [ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS]; /**< Time between the first received fragment of a complete frame and its last missing fragment (see ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS) */
+} ARSTREAM_Reader_Stats_t;
+
 /**
  * @brief An ARSTREAM_Reader_t instance allow reading streamed frames from a network
  */
@@ -141,6 +215,77 @@ void ARSTREAM_Reader_InitStreamAckBuffer (ARNETWORK_IOBufferParam_t *bufferParam
  */
 ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBufferID, int ackBufferID, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error);
 
+/**
+ * @brief Creates a new ARSTREAM_Reader_t which reads a stream from its own UDP socket, without any ARNETWORK_Manager_t
+ * @warning This function allocates memory. An ARSTREAM_Reader_t muse be deleted by a call to ARSTREAM_Reader_Delete
+ *
+ * @param[in] ifaceAddr IP address (dotted notation) of the interface to listen on, or NULL for all interfaces
+ * @param[in] readerPort UDP port to listen on
+ * @param[in] callback The callback which will be called every time a new frame is available
+ * @param[in] frameBuffer The adress of the first frameBuffer to use
+ * @param[in] frameBufferSize The length of the frameBuffer (to avoid overflow)
+ * @param[in] maxFragmentSize Maximum allowed size for a video data fragment. Must match the one of the sender.
+ * @param[in] maxAckInterval Maximum interval between sending ACKs. 0 disables only periodic ACKs. -1 disables ACKs completely.
+ * If unsure, use the default value in ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Reader_t, or NULL if an error occured
+ *
+ * @note Acks are sent back to the source of the last received fragment
+ *
+ * @see ARSTREAM_Sender_NewUDP()
+ * @see ARSTREAM_Reader_StopReader()
+ * @see ARSTREAM_Reader_Delete()
+ */
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewUDP (const char *ifaceAddr, int readerPort, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Creates a new ARSTREAM_Reader_t which reads the stream of an ARSTREAM_Sender_t of the same process
+ * This is meant to measure the cost of the library, without any network.
+ * @warning This function allocates memory. An ARSTREAM_Reader_t muse be deleted by a call to ARSTREAM_Reader_Delete
+ *
+ * @param[in] loopback The loopback shared with the sender. Must be deleted after the reader.
+ * @param[in] callback The callback which will be called every time a new frame is available
+ * @param[in] frameBuffer The adress of the first frameBuffer to use
+ * @param[in] frameBufferSize The length of the frameBuffer (to avoid overflow)
+ * @param[in] maxFragmentSize Maximum allowed size for a video data fragment. Must match the one of the sender.
+ * @param[in] maxAckInterval Maximum interval between sending ACKs. 0 disables only periodic ACKs. -1 disables ACKs completely.
+ * If unsure, use the default value in ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Reader_t, or NULL if an error occured
+ *
+ * @see ARSTREAM_Loopback_New()
+ * @see ARSTREAM_Sender_NewLoopback()
+ * @see ARSTREAM_Reader_StopReader()
+ * @see ARSTREAM_Reader_Delete()
+ */
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewLoopback (ARSTREAM_Loopback_t *loopback, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Creates a new ARSTREAM_Reader_t which reads the packets of a capture file instead of a network
+ * This is meant to benchmark and regression test the reassembly, the filters and the callbacks on real world
+ * packet sequences (including their losses and retransmissions), without any network.
+ * The acks and key frame requests of the reader are dropped.
+ * @warning This function allocates memory. An ARSTREAM_Reader_t muse be deleted by a call to ARSTREAM_Reader_Delete
+ *
+ * @param[in] capturePath Path of a file written by ARSTREAM_Reader_StartCapture()
+ * @param[in] mode Timing of the replay
+ * @param[in] callback The callback which will be called every time a new frame is available
+ * @param[in] frameBuffer The adress of the first frameBuffer to use
+ * @param[in] frameBufferSize The length of the frameBuffer (to avoid overflow)
+ * @param[in] maxFragmentSize Maximum allowed size for a video data fragment. Should match the one of the captured stream.
+ * @param[in] maxAckInterval Maximum interval between sending ACKs. 0 disables only periodic ACKs. -1 disables ACKs completely.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Reader_t, or NULL if an error occured
+ *
+ * @see ARSTREAM_Reader_GetReplayStats()
+ * @see ARSTREAM_Reader_StopReader()
+ * @see ARSTREAM_Reader_Delete()
+ */
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewReplay (const char *capturePath, eARSTREAM_CAPTURE_REPLAY_MODE mode, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error);
+
 /**
  * @brief Stops a running ARSTREAM_Reader_t
  * @warning Once stopped, an ARSTREAM_Reader_t can not be restarted
@@ -186,6 +331,7 @@ void* ARSTREAM_Reader_RunAckThread (void *ARSTREAM_Reader_t_Param);
  * An efficiency of 1.0f means that we did not receive any useless packet.
  * Efficiency is computed on all frames for which the Reader got at least a packet, even if the frame was not complete.
  * @warning This function is a debug-only function and will disappear on release builds
+ * @note This function can be called from the callbacks of the reader.
  * @param[in] reader The ARSTREAM_Reader_t
  */
 float ARSTREAM_Reader_GetEstimatedEfficiency (ARSTREAM_Reader_t *reader);
@@ -210,4 +356,189 @@ void* ARSTREAM_Reader_GetCustom (ARSTREAM_Reader_t *reader);
  */
 eARSTREAM_ERROR ARSTREAM_Reader_AddFilter (ARSTREAM_Reader_t *reader, ARSTREAM_Filter_t *filter);
 
+/**
+ * @brief Enables or disables the delivery of incomplete frames
+ * When enabled, a frame which is missing some fragments is not dropped anymore. Instead, it is given to the callback with
+ * the ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE cause when a newer frame starts, or when no fragment of the frame was received
+ * for frameTimeoutMs milliseconds. This is intended for decoders which are able to conceal the missing parts of a frame.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] enable Boolean-like (0-1) flag to enable or disable partial frame delivery (disabled by default)
+ * @param[in] frameTimeoutMs Delay after the last received fragment before delivering an incomplete frame. 0 only delivers incomplete frames when a newer frame starts.
+ *
+ * @return ARSTREAM_OK if the setting was applied
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, or if frameTimeoutMs is negative
+ *
+ * @note Incomplete frames are only delivered when no filter is attached to the reader, as filters expect complete frames.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_SetPartialFrameDelivery (ARSTREAM_Reader_t *reader, int enable, int32_t frameTimeoutMs);
+
+/**
+ * @brief Sets a callback which receives the contiguous beginning of each frame as its fragments arrive
+ * This allows the decoding of a frame to start before its last fragment is received.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] prefixCallback The callback to call when the contiguous prefix of the current frame grows, or NULL to disable progressive delivery
+ *
+ * @return ARSTREAM_OK if the callback was set
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t
+ *
+ * @note The prefix callback is called from the data thread, and is not called when filters are attached to the reader.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_SetFramePrefixCallback (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_FramePrefixCallback_t prefixCallback);
+
+/**
+ * @brief Enables or disables the skipping of non-flush frames after a loss
+ * When enabled, once a frame is lost, the following non-flush frames are not reassembled nor given to the callback, as
+ * they can not be decoded without their reference. The reader resumes at the next flush frame (typically an I-Frame),
+ * whose numberOfSkippedFrames includes all the skipped frames. The reader tells the sender to stop retrying the skipped
+ * frames, which are then reported as ARSTREAM_SENDER_STATUS_FRAME_CANCEL (and not as sent). The reader also waits for a
+ * first flush frame when started.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] enable Boolean-like (0-1) flag to enable or disable the skipping (disabled by default)
+ *
+ * @return ARSTREAM_OK if the setting was applied
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t
+ *
+ * @note Frames delivered with ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE are not considered lost.
+ * @note Senders older than this reader do not understand the skip message: they keep retrying a skipped frame until
+ * their next frame.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_SetSkipUntilFlushFrame (ARSTREAM_Reader_t *reader, int enable);
+
+/**
+ * @brief Enables or disables the automatic key frame requests
+ * When enabled, the reader asks the sender for a key frame when it starts, and each time a frame is lost. The request
+ * is repeated every minIntervalMs milliseconds until a flush frame is delivered. The sender reports the requests with
+ * the ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST status.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] enable Boolean-like (0-1) flag to enable or disable the automatic requests (disabled by default)
+ * @param[in] minIntervalMs Minimum time between two requests (ARSTREAM_READER_KEY_FRAME_REQUEST_INTERVAL_DEFAULT_MS is a good default)
+ *
+ * @return ARSTREAM_OK if the setting was applied
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, or if minIntervalMs is not positive
+ *
+ * @note Senders older than the key frame requests ignore them, but log an error for each request they receive (at most
+ * one every minIntervalMs milliseconds). Current senders log unknown packets only once.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_SetKeyFrameRequests (ARSTREAM_Reader_t *reader, int enable, int minIntervalMs);
+
+/**
+ * @brief Asks the sender for a key frame
+ * The request is sent by the ack thread, and repeated until a flush frame is delivered. Calling this function while
+ * a request is already pending has no effect.
+ * @param[in] reader The ARSTREAM_Reader_t
+ *
+ * @return ARSTREAM_OK if the request was registered
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t
+ *
+ * @note This function can be called at any time, even if the automatic requests are disabled, and from the callbacks of the reader.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_RequestKeyFrame (ARSTREAM_Reader_t *reader);
+
+/**
+ * @brief Gets the freeze statistics of the reader
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if stats was filled
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, or if stats is NULL
+ *
+ * @note This function can be called from the callbacks of the reader.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_GetFreezeStats (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_FreezeStats_t *stats);
+
+/**
+ * @brief Gets a snapshot of all the statistics of the reader
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if stats was filled
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, or if stats is NULL
+ *
+ * @note This function can be called at any time, from any thread, including the callbacks of the reader. It does not allocate memory.
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_GetStats (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_Stats_t *stats);
+
+/**
+ * @brief Gets the missing regions of the frame currently delivered with ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE
+ * Adjacent missing fragments are merged into a single region. If the last fragments of a frame were lost, the actual frame
+ * size is unknown, and the last region may extend past the frameSize given to the callback.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] regions Array which will hold the missing regions (can be NULL if maxRegions is 0)
+ * @param[in] maxRegions Capacity of the regions array
+ *
+ * @return The total number of missing regions (which may be greater than maxRegions), or -1 if the parameters are invalid
+ *
+ * @warning This function must only be called from within the callback, while handling an ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE cause.
+ */
+int ARSTREAM_Reader_GetMissingRegions (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_MissingRegion_t *regions, int maxRegions);
+
+/**
+ * @brief Impairs the acks and key frame requests sent by the reader, to emulate a bad network
+ * The impairments are applied on top of the transport of the reader (ARNETWORK, UDP or loopback).
+ * Use ARSTREAM_Sender_SetImpairment() on the peer to impair the other direction.
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] config The impairments to apply (copied)
+ *
+ * @return ARSTREAM_OK if the impairments were set
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, or if config is NULL
+ *
+ * @note Calling this function again (while the reader is stopped) replaces the previous impairments, and seeds the PRNG again.
+ * The impairment statistics are kept. To remove the impairments, set a config from ARSTREAM_Impairment_DefaultConfig().
+ *
+ * @warning This function is a test function, which should not be used in production
+ * @see ARSTREAM_Impairment_Config_t
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_SetImpairment (ARSTREAM_Reader_t *reader, const ARSTREAM_Impairment_Config_t *config);
+
+/**
+ * @brief Gets the statistics of the impairments set by ARSTREAM_Reader_SetImpairment()
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, if stats is NULL, or if no impairments were set
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_GetImpairmentStats (ARSTREAM_Reader_t *reader, ARSTREAM_Impairment_Stats_t *stats);
+
+/**
+ * @brief Records every packet received by the reader, with its reception time, into a capture file
+ * The capture is written by the reader data thread, through a large buffer, and closed by ARSTREAM_Reader_Delete().
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[in] path Path of the capture file (created or truncated, see ARSTREAM_Capture.h for the format)
+ *
+ * @return ARSTREAM_OK if the capture file was created
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, if path is NULL, if the file can not be created,
+ * or if a capture was already started
+ *
+ * @warning This function is a test function, which should not be used in production
+ * @see ARSTREAM_Reader_NewReplay()
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_StartCapture (ARSTREAM_Reader_t *reader, const char *path);
+
+/**
+ * @brief Gets the statistics of the capture started by ARSTREAM_Reader_StartCapture()
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, if stats is NULL, or if no capture was started
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_GetCaptureStats (ARSTREAM_Reader_t *reader, ARSTREAM_Capture_Stats_t *stats);
+
+/**
+ * @brief Gets the progress of the replay of an ARSTREAM_Reader_t created by ARSTREAM_Reader_NewReplay()
+ * @param[in] reader The ARSTREAM_Reader_t
+ * @param[out] stats Pointer to the structure to fill (stats->isFinished is set once the whole capture was read)
+ *
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader_t, if stats is NULL, or if the reader does not replay a capture
+ */
+eARSTREAM_ERROR ARSTREAM_Reader_GetReplayStats (ARSTREAM_Reader_t *reader, ARSTREAM_Capture_Stats_t *stats);
+
 #endif /* _ARSTREAM_READER_H_ */
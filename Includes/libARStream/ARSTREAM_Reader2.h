@@ -0,0 +1,237 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Reader2.h
+ * @brief Stream reader over UDP, using an RTP-like protocol (H.264 payload format, see RFC6184)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_READER2_H_
+#define _ARSTREAM_READER2_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Default maximum size of a network packet (RTP header included)
+ * @see ARSTREAM_SENDER2_DEFAULT_MAX_PACKET_SIZE
+ */
+#define ARSTREAM_READER2_DEFAULT_MAX_PACKET_SIZE (1500 - 20 - 8)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Causes for AU callback
+ */
+typedef enum {
+    ARSTREAM_READER2_CAUSE_AU_COMPLETE = 0, /**< Access unit is complete (no error) */
+    ARSTREAM_READER2_CAUSE_AU_INCOMPLETE, /**< Access unit is missing some packets (some NAL units may be missing) */
+    ARSTREAM_READER2_CAUSE_AU_BUFFER_TOO_SMALL, /**< Access unit buffer is too small for the access unit on the network */
+    ARSTREAM_READER2_CAUSE_AU_COPY_COMPLETE, /**< Copy of previous access unit buffer is complete (called only after ARSTREAM_READER2_CAUSE_AU_BUFFER_TOO_SMALL) */
+    ARSTREAM_READER2_CAUSE_CANCEL, /**< Reader is closing, so buffer is no longer used */
+    ARSTREAM_READER2_CAUSE_MAX,
+} eARSTREAM_READER2_CAUSE;
+
+/**
+ * @brief Callback called when a new access unit is ready in a buffer
+ *
+ * @param[in] cause Describes why this callback was called
+ * @param[in] auBuffer Pointer to the access unit buffer which was received
+ * @param[in] auSize Used size in auBuffer
+ * @param[in] auTimestampUs Timestamp of the access unit, in microseconds, as given to ARSTREAM_Sender2_SendNewAu() (modulo 2^32 ticks of the 90kHz clock)
+ * @param[inout] newBufferCapacity Capacity of the next buffer to use
+ * @param[in] custom Custom pointer passed during ARSTREAM_Reader2_New
+ *
+ * @return address of a new buffer which will hold the next access unit
+ *
+ * @note The access units are given as H.264 byte streams: each NAL unit is prefixed by a 00 00 00 01 start code.
+ * @note If cause is ARSTREAM_READER2_CAUSE_AU_COMPLETE or ARSTREAM_READER2_CAUSE_AU_INCOMPLETE, auBuffer contains a valid access unit.
+ * @note If cause is ARSTREAM_READER2_CAUSE_AU_BUFFER_TOO_SMALL, then the returned buffer will be used to store the current access unit. Its capacity must be at least the input value of *newBufferCapacity, or the access unit will be dropped.
+ * @note If cause is ARSTREAM_READER2_CAUSE_AU_COPY_COMPLETE, the return value and newBufferCapacity are unused.
+ * @note If cause is ARSTREAM_READER2_CAUSE_CANCEL, the return value and newBufferCapacity are unused.
+ *
+ * @warning If the cause is ARSTREAM_READER2_CAUSE_AU_BUFFER_TOO_SMALL, returning a buffer shorter than 'auSize' will cause the library to skip the current access unit.
+ */
+typedef uint8_t* (*ARSTREAM_Reader2_AuCallback_t) (eARSTREAM_READER2_CAUSE cause, uint8_t *auBuffer, uint32_t auSize, uint64_t auTimestampUs, uint32_t *newBufferCapacity, void *custom);
+
+/**
+ * @brief An ARSTREAM_Reader2_t instance allow reading H.264 access units streamed over UDP by an ARSTREAM_Sender2_t
+ */
+typedef struct ARSTREAM_Reader2_t ARSTREAM_Reader2_t;
+
+/**
+ * @brief State of the synchronization between the sender and the reader clocks
+ * @note Both clocks are the ARSAL_Time_GetTime() clocks of their host, in microseconds
+ */
+typedef struct {
+    int isSynchronized; /**< 1 if the other fields are valid, 0 if no clock exchange succeeded yet */
+    int64_t offsetUs; /**< Sender clock minus reader clock, at the time of the call */
+    double skewPpm; /**< Drift of the sender clock relative to the reader clock, in parts per million (0 until enough samples are available) */
+    uint32_t minRttUs; /**< Smallest round trip time of the recent clock exchanges */
+    uint32_t nbExchanges; /**< Total number of successful clock exchanges */
+} ARSTREAM_Reader2_ClockSync_t;
+
+/**
+ * @brief Reception statistics of an ARSTREAM_Reader2_t (the values sent in the receiver reports)
+ */
+typedef struct {
+    uint32_t packetsReceived; /**< Number of data packets received (including late and duplicate ones) */
+    uint64_t bytesReceived; /**< Number of payload bytes received (RTP headers excluded) */
+    int32_t cumulativeLost; /**< Number of packets lost since the beginning of the stream (may be negative with duplicates) */
+    uint32_t extHighestSeqNum; /**< Extended highest sequence number received */
+    uint32_t jitterUs; /**< Interarrival jitter (see RFC3550) */
+    double fractionLost; /**< Fraction of the packets lost, as sent in the last receiver report (0.0 to 1.0) */
+    uint32_t nbSenderReports; /**< Number of sender reports received */
+    uint32_t nbReceiverReports; /**< Number of receiver reports sent */
+} ARSTREAM_Reader2_Stats_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_Reader2_t
+ * @warning This function allocates memory. An ARSTREAM_Reader2_t muse be deleted by a call to ARSTREAM_Reader2_Delete
+ *
+ * @param[in] ifaceAddr IP address (dotted notation) of the local interface to listen on, or NULL to listen on all interfaces
+ * @param[in] readerPort UDP port on which the data is received
+ * @param[in] callback The callback which will be called every time a new access unit is available
+ * @param[in] auBuffer The buffer which will contain the first access unit
+ * @param[in] auBufferSize The size of the auBuffer
+ * @param[in] maxPacketSize Maximum size of a network packet, RTP header included (must be at least the maxPacketSize of the sender)
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Reader2_t, or NULL if an error occured
+ * @see ARSTREAM_Reader2_StopReader()
+ * @see ARSTREAM_Reader2_Delete()
+ */
+ARSTREAM_Reader2_t* ARSTREAM_Reader2_New (const char *ifaceAddr, int readerPort, ARSTREAM_Reader2_AuCallback_t callback, uint8_t *auBuffer, uint32_t auBufferSize, uint32_t maxPacketSize, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Stops a running ARSTREAM_Reader2_t
+ * @warning Once stopped, an ARSTREAM_Reader2_t can not be restarted
+ *
+ * @param[in] reader The ARSTREAM_Reader2_t to stop
+ *
+ * @note Calling this function multiple times has no effect
+ */
+void ARSTREAM_Reader2_StopReader (ARSTREAM_Reader2_t *reader);
+
+/**
+ * @brief Deletes an ARSTREAM_Reader2_t
+ * @warning This function should NOT be called on a running ARSTREAM_Reader2_t
+ *
+ * @param reader Pointer to the ARSTREAM_Reader2_t * to delete
+ *
+ * @return ARSTREAM_OK if the ARSTREAM_Reader2_t was deleted
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Reader2_t is still busy and can not be stopped now (probably because ARSTREAM_Reader2_StopReader() was not called yet)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader does not point to a valid ARSTREAM_Reader2_t
+ *
+ * @note The library use a double pointer, so it can set *reader to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_Reader2_Delete (ARSTREAM_Reader2_t **reader);
+
+/**
+ * @brief Runs the data loop of the ARSTREAM_Reader2_t
+ * @warning This function never returns until ARSTREAM_Reader2_StopReader() is called. The tread can then be joined.
+ *
+ * @param ARSTREAM_Reader2_t_Param A valid (ARSTREAM_Reader2_t *) casted as a (void *)
+ */
+void* ARSTREAM_Reader2_RunDataThread (void *ARSTREAM_Reader2_t_Param);
+
+/**
+ * @brief Gets the current estimate of the sender clock relative to the reader clock
+ *
+ * The reader periodically exchanges clock frames with the sender on the reverse path of the
+ * data flow (this requires the ARSTREAM_Sender2_RunControlThread() of the sender to run).
+ * The offset is filtered using the exchanges with the lowest round trip times, and the skew
+ * is estimated over the last exchanges.
+ * The estimation starts over when the reader detects a new stream source (see ARSTREAM_Reader2_GetStats()).
+ *
+ * @param[in] reader The ARSTREAM_Reader2_t
+ * @param[out] clockSync Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if clockSync was filled (clockSync->isSynchronized may still be 0)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader or clockSync is NULL
+ */
+eARSTREAM_ERROR ARSTREAM_Reader2_GetClockSync (ARSTREAM_Reader2_t *reader, ARSTREAM_Reader2_ClockSync_t *clockSync);
+
+/**
+ * @brief Maps a time of the sender clock onto the reader clock
+ *
+ * @param[in] reader The ARSTREAM_Reader2_t
+ * @param[in] senderTimeUs A time on the sender clock, typically the auTimestampUs of an access unit
+ * @param[out] localTimeUs The same time on the reader clock (ARSAL_Time_GetTime(), in microseconds)
+ *
+ * @return ARSTREAM_OK if localTimeUs was set
+ * @return ARSTREAM_ERROR_NOT_SYNCHRONIZED if no clock exchange succeeded yet
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader or localTimeUs is NULL
+ *
+ * @note Access unit timestamps are transmitted as 32 bits 90kHz RTP timestamps, so only their
+ * lower bits are known by the reader. The wrap-around is resolved using the current sender time,
+ * so senderTimeUs must be within a few hours of the current time.
+ * @note The one way latency of an access unit is the reception time minus the mapped auTimestampUs
+ */
+eARSTREAM_ERROR ARSTREAM_Reader2_SenderTimeToLocalTime (ARSTREAM_Reader2_t *reader, uint64_t senderTimeUs, uint64_t *localTimeUs);
+
+/**
+ * @brief Gets the reception statistics of an ARSTREAM_Reader2_t
+ *
+ * These statistics are also sent to the sender in RTCP-like receiver reports, which use at most
+ * half a percent of the stream bandwidth.
+ * The statistics start over from zero when the reader detects a new stream source: a new sender
+ * address, a new SSRC (each ARSTREAM_Sender2_t uses a random one), or a confirmed large jump in
+ * the sequence numbers. The access unit in progress is then delivered as incomplete.
+ *
+ * @param[in] reader The ARSTREAM_Reader2_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if stats was filled
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if reader or stats is NULL
+ * @see ARSTREAM_Sender2_GetStats()
+ */
+eARSTREAM_ERROR ARSTREAM_Reader2_GetStats (ARSTREAM_Reader2_t *reader, ARSTREAM_Reader2_Stats_t *stats);
+
+#endif /* _ARSTREAM_READER2_H_ */
@@ -49,6 +49,9 @@
 #include <libARNetwork/ARNETWORK_Manager.h>
 #include <libARStream/ARSTREAM_Filter.h>
 #include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Impairment.h>
+#include <libARStream/ARSTREAM_Loopback.h>
+#include <libARStream/ARSTREAM_Stats.h>
 
 /*
  * Macros
@@ -65,6 +68,7 @@ typedef enum {
     ARSTREAM_SENDER_STATUS_FRAME_SENT = 0, /**< Frame was sent and acknowledged by peer */
     ARSTREAM_SENDER_STATUS_FRAME_CANCEL, /**< Frame was not sent, and was cancelled by a new frame */
     ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK, /**< We received a full ack for an old frame. The callback will be called with null pointer and zero size. */
+    ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST, /**< The reader asked for a key frame. The callback will be called with null pointer, and the reason as the size. */
     ARSTREAM_SENDER_STATUS_MAX,
 } eARSTREAM_SENDER_STATUS;
 
@@ -78,11 +82,16 @@ typedef enum {
  * is no way to identify the "old" frame, but the library guarantees that the LATE_ACK status
  * will only be called for previously cancelled frames, and at most once per cancelled frame.
  *
+ * This callback is also used when the reader asks for a key frame. In this case, the framePointer
+ * is NULL, and the frameSize holds the reason of the request (eARSTREAM_READER_KEY_FRAME_REQUEST_REASON).
+ * The application should then send its next frame as a flush frame (typically an IDR frame).
+ * Duplicate requests are filtered out by the library.
+ *
  * @param[in] status Why the call was made
  * @param[in] framePointer Pointer to the frame which was sent/cancelled
  * @param[in] frameSize Size, in bytes, of the frame
  * @param[in] custom Custom pointer passed during ARSTREAM_Sender_New
- * @warning If the status is ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK, then the framePointer will be NULL.
+ * @warning If the status is ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK or ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST, then the framePointer will be NULL.
  * @see eARSTREAM_SENDER_STATUS
  */
 typedef void (*ARSTREAM_Sender_FrameUpdateCallback_t)(eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
@@ -92,6 +101,27 @@ typedef void (*ARSTREAM_Sender_FrameUpdateCallback_t)(eARSTREAM_SENDER_STATUS st
  */
 typedef struct ARSTREAM_Sender_t ARSTREAM_Sender_t;
 
+/**
+ * @brief Statistics of an ARSTREAM_Sender_t, since its creation
+ * All the fields are 32 bits wide, so the structure has no padding and can be copied as is (e.g. to a Java ByteBuffer)
+ * @see ARSTREAM_Sender_GetStats()
+ */
+typedef struct {
+    uint32_t nbFramesQueued; /**< Number of frames accepted by ARSTREAM_Sender_SendNewFrame() */
+    uint32_t nbFramesQueueFull; /**< Number of frames refused by ARSTREAM_Sender_SendNewFrame() with ARSTREAM_ERROR_QUEUE_FULL */
+    uint32_t nbFramesAcked; /**< Number of frames fully acknowledged by the reader */
+    uint32_t nbFramesCancelled; /**< Number of frames cancelled, from the queue or while being sent */
+    uint32_t nbLateAcks; /**< Number of cancelled frames which were acknowledged afterwards */
+    uint32_t nbFragmentsSent; /**< Number of fragments given to the transport, including retries */
+    uint32_t nbFragmentsRetried; /**< Number of fragments sent again because they were not acknowledged in time */
+    uint32_t nbKeyFrameRequests; /**< Number of key frame requests reported to the application */
+    uint32_t queueDepth; /**< Number of frames currently waiting in the queue */
+    uint32_t maxQueueDepth; /**< Highest number of frames waiting in the queue */
+    uint32_t queueSize; /**< Size of the queue (framesBufferSize given on creation) */
+    float efficiency; /**< Same as ARSTREAM_Sender_GetEstimatedEfficiency() */
+    uint32_t ackTimeHistogram [ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS]; /**< Time between the first send of a frame and its full acknowledge (see ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS) */
+} ARSTREAM_Sender_Stats_t;
+
 /**
  * @brief Default minimum wait time for ARSTREAM_Sender_SetTimeBetweenRetries calls
  */
@@ -154,6 +184,50 @@ void ARSTREAM_Sender_InitStreamAckBuffer (ARNETWORK_IOBufferParam_t *bufferParam
  */
 ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBufferID, int ackBufferID, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error);
 
+/**
+ * @brief Creates a new ARSTREAM_Sender_t which streams over its own UDP socket, without any ARNETWORK_Manager_t
+ * @warning This function allocates memory. An ARSTREAM_Sender_t muse be deleted by a call to ARSTREAM_Sender_Delete
+ *
+ * @param[in] readerAddr IP address (dotted notation) of the ARSTREAM_Reader_t
+ * @param[in] readerPort UDP port of the ARSTREAM_Reader_t
+ * @param[in] callback The status update callback which will be called every time the status of a send-frame is updated
+ * @param[in] framesBufferSize Number of frames that the ARSTREAM_Sender_t instance will be able to hold in queue
+ * @param[in] maxFragmentSize Maximum allowed size for a video data fragment. Video frames larger that will be fragmented.
+ * @param[in] maxNumberOfFragment number maximum of fragment of one frame.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Sender_t, or NULL if an error occured
+ *
+ * @note The reader must be created with ARSTREAM_Reader_NewUDP()
+ * @note maxFragmentSize plus the stream header should fit in the path MTU to avoid IP fragmentation
+ *
+ * @see ARSTREAM_Reader_NewUDP()
+ * @see ARSTREAM_Sender_StopSender()
+ * @see ARSTREAM_Sender_Delete()
+ */
+ARSTREAM_Sender_t* ARSTREAM_Sender_NewUDP (const char *readerAddr, int readerPort, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Creates a new ARSTREAM_Sender_t which streams to an ARSTREAM_Reader_t of the same process
+ * This is meant to measure the cost of the library, without any network.
+ * @warning This function allocates memory. An ARSTREAM_Sender_t muse be deleted by a call to ARSTREAM_Sender_Delete
+ *
+ * @param[in] loopback The loopback shared with the reader. Must be deleted after the sender.
+ * @param[in] callback The status update callback which will be called every time the status of a send-frame is updated
+ * @param[in] framesBufferSize Number of frames that the ARSTREAM_Sender_t instance will be able to hold in queue
+ * @param[in] maxFragmentSize Maximum allowed size for a video data fragment. Must not exceed the one of the loopback.
+ * @param[in] maxNumberOfFragment number maximum of fragment of one frame.
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Sender_t, or NULL if an error occured
+ *
+ * @see ARSTREAM_Loopback_New()
+ * @see ARSTREAM_Reader_NewLoopback()
+ * @see ARSTREAM_Sender_StopSender()
+ * @see ARSTREAM_Sender_Delete()
+ */
+ARSTREAM_Sender_t* ARSTREAM_Sender_NewLoopback (ARSTREAM_Loopback_t *loopback, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error);
+
 /**
  * @brief Sets the minimum and maximum time between retries.
  * Setting a small retry time might increase reliability, at the cost of network and cpu loads.
@@ -244,6 +318,7 @@ void* ARSTREAM_Sender_RunAckThread (void *ARSTREAM_Sender_t_Param);
  * @brief Gets the estimated network efficiency for the ARSTREAM link
  * An efficiency of 1.0f means that we did not do any retries
  * @warning This function is a debug-only function and will disappear on release builds
+ * @note This function can be called from the callbacks of the sender.
  * @param[in] sender The ARSTREAM_Sender_t
  */
 float ARSTREAM_Sender_GetEstimatedEfficiency (ARSTREAM_Sender_t *sender);
@@ -268,4 +343,45 @@ void* ARSTREAM_Sender_GetCustom (ARSTREAM_Sender_t *sender);
  */
 eARSTREAM_ERROR ARSTREAM_Sender_AddFilter (ARSTREAM_Sender_t *sender, ARSTREAM_Filter_t *filter);
 
+/**
+ * @brief Impairs the fragments sent by the sender, to emulate a bad network
+ * The impairments are applied on top of the transport of the sender (ARNETWORK, UDP or loopback).
+ * Use ARSTREAM_Reader_SetImpairment() on the peer to impair the other direction.
+ * @param[in] sender The ARSTREAM_Sender_t
+ * @param[in] config The impairments to apply (copied)
+ *
+ * @return ARSTREAM_OK if the impairments were set
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Sender_t is running
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if sender does not point to a valid ARSTREAM_Sender_t, or if config is NULL
+ *
+ * @note Calling this function again (while the sender is stopped) replaces the previous impairments, and seeds the PRNG again.
+ * The impairment statistics are kept. To remove the impairments, set a config from ARSTREAM_Impairment_DefaultConfig().
+ *
+ * @warning This function is a test function, which should not be used in production
+ * @see ARSTREAM_Impairment_Config_t
+ */
+eARSTREAM_ERROR ARSTREAM_Sender_SetImpairment (ARSTREAM_Sender_t *sender, const ARSTREAM_Impairment_Config_t *config);
+
+/**
+ * @brief Gets the statistics of the impairments set by ARSTREAM_Sender_SetImpairment()
+ * @param[in] sender The ARSTREAM_Sender_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if sender does not point to a valid ARSTREAM_Sender_t, if stats is NULL, or if no impairments were set
+ */
+eARSTREAM_ERROR ARSTREAM_Sender_GetImpairmentStats (ARSTREAM_Sender_t *sender, ARSTREAM_Impairment_Stats_t *stats);
+
+/**
+ * @brief Gets a snapshot of the statistics of the sender
+ * @param[in] sender The ARSTREAM_Sender_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if sender does not point to a valid ARSTREAM_Sender_t, or if stats is NULL
+ *
+ * @note This function can be called at any time, from any thread, including the callbacks of the sender. It does not allocate memory.
+ */
+eARSTREAM_ERROR ARSTREAM_Sender_GetStats (ARSTREAM_Sender_t *sender, ARSTREAM_Sender_Stats_t *stats);
+
 #endif /* _ARSTREAM_SENDER_H_ */
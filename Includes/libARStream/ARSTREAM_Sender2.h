@@ -0,0 +1,215 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Sender2.h
+ * @brief Stream sender over UDP, using an RTP-like protocol (H.264 payload format, see RFC6184)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_SENDER2_H_
+#define _ARSTREAM_SENDER2_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Default maximum size of a network packet (RTP header included), to avoid IP fragmentation on a 1500 bytes MTU
+ */
+#define ARSTREAM_SENDER2_DEFAULT_MAX_PACKET_SIZE (1500 - 20 - 8)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Callback status values
+ */
+typedef enum {
+    ARSTREAM_SENDER2_STATUS_AU_SENT = 0, /**< Access unit was sent on the network */
+    ARSTREAM_SENDER2_STATUS_AU_CANCELLED, /**< Access unit was not sent, and was cancelled by a flush or by the sender stop */
+    ARSTREAM_SENDER2_STATUS_MAX,
+} eARSTREAM_SENDER2_STATUS;
+
+/**
+ * @brief Callback type for sender informations
+ * This callback is called when an access unit buffer is no longer needed by the library.
+ *
+ * @param[in] status Why the call was made
+ * @param[in] auBuffer Pointer to the access unit which was sent/cancelled
+ * @param[in] auSize Size, in bytes, of the access unit
+ * @param[in] custom Custom pointer passed during ARSTREAM_Sender2_New
+ * @see eARSTREAM_SENDER2_STATUS
+ */
+typedef void (*ARSTREAM_Sender2_AuCallback_t)(eARSTREAM_SENDER2_STATUS status, uint8_t *auBuffer, uint32_t auSize, void *custom);
+
+/**
+ * @brief An ARSTREAM_Sender2_t instance allow streaming H.264 access units over UDP
+ */
+typedef struct ARSTREAM_Sender2_t ARSTREAM_Sender2_t;
+
+/**
+ * @brief Statistics of an ARSTREAM_Sender2_t, including the last receiver report from the reader
+ * @note Receiver reports are only received while ARSTREAM_Sender2_RunControlThread() is running
+ */
+typedef struct {
+    uint32_t packetsSent; /**< Number of data packets sent */
+    uint64_t bytesSent; /**< Number of payload bytes sent (RTP headers excluded) */
+    uint32_t nbSenderReports; /**< Number of sender reports sent */
+    uint32_t nbReceiverReports; /**< Number of receiver reports received. If 0, the fields below are not valid */
+    double fractionLost; /**< Fraction of the packets lost between the two last receiver reports (0.0 to 1.0) */
+    int32_t cumulativeLost; /**< Number of packets lost since the beginning of the stream (may be negative with duplicates) */
+    uint32_t extHighestSeqNum; /**< Extended highest sequence number received by the reader */
+    uint32_t jitterUs; /**< Interarrival jitter, as computed by the reader */
+    uint32_t rttUs; /**< Round trip time computed from the last receiver report, 0 if unknown */
+    uint32_t lastReportAgeMs; /**< Time since the last receiver report was received */
+} ARSTREAM_Sender2_Stats_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a new ARSTREAM_Sender2_t
+ * @warning This function allocates memory. An ARSTREAM_Sender2_t muse be deleted by a call to ARSTREAM_Sender2_Delete
+ *
+ * @param[in] readerAddr IP address (dotted notation) of the ARSTREAM_Reader2_t
+ * @param[in] readerPort UDP port on which the ARSTREAM_Reader2_t receives the data
+ * @param[in] callback The status update callback which will be called every time the status of an access unit is updated
+ * @param[in] auFifoSize Number of access units that can be queued in the sender
+ * @param[in] maxPacketSize Maximum size of a network packet, RTP header included (ARSTREAM_SENDER2_DEFAULT_MAX_PACKET_SIZE is a good default)
+ * @param[in] custom Custom pointer which will be passed to callback
+ * @param[out] error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return A pointer to the new ARSTREAM_Sender2_t, or NULL if an error occured
+ * @see ARSTREAM_Sender2_StopSender()
+ * @see ARSTREAM_Sender2_Delete()
+ */
+ARSTREAM_Sender2_t* ARSTREAM_Sender2_New (const char *readerAddr, int readerPort, ARSTREAM_Sender2_AuCallback_t callback, uint32_t auFifoSize, uint32_t maxPacketSize, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Stops a running ARSTREAM_Sender2_t
+ * @warning Once stopped, an ARSTREAM_Sender2_t can not be restarted
+ *
+ * @param[in] sender The ARSTREAM_Sender2_t to stop
+ *
+ * @note Calling this function multiple times has no effect
+ */
+void ARSTREAM_Sender2_StopSender (ARSTREAM_Sender2_t *sender);
+
+/**
+ * @brief Deletes an ARSTREAM_Sender2_t
+ * @warning This function should NOT be called on a running ARSTREAM_Sender2_t
+ *
+ * @param sender Pointer to the ARSTREAM_Sender2_t * to delete
+ *
+ * @return ARSTREAM_OK if the ARSTREAM_Sender2_t was deleted
+ * @return ARSTREAM_ERROR_BUSY if the ARSTREAM_Sender2_t is still busy and can not be stopped now (probably because ARSTREAM_Sender2_StopSender() was not called yet)
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if sender does not point to a valid ARSTREAM_Sender2_t
+ *
+ * @note The library use a double pointer, so it can set *sender to NULL after freeing it
+ */
+eARSTREAM_ERROR ARSTREAM_Sender2_Delete (ARSTREAM_Sender2_t **sender);
+
+/**
+ * @brief Sends a new access unit
+ * The access unit must be an H.264 byte stream (NAL units prefixed by 00 00 01 or 00 00 00 01 start codes).
+ * A buffer without any start code is sent as a single NAL unit.
+ *
+ * @param[in] sender The ARSTREAM_Sender2_t which will try to send the access unit
+ * @param[in] auBuffer Pointer to the buffer which contains the access unit
+ * @param[in] auSize Size, in bytes, of the access unit
+ * @param[in] auTimestampUs Timestamp of the access unit, in microseconds (sent with a 90kHz resolution)
+ * @param[in] flushPreviousAus Boolean-like flag (0/1). If active, tells the sender to cancel the access units which are still waiting in its queue
+ * @param[out] nbPreviousAus Optionnal int pointer which will store the number of access units previously in the queue
+ *
+ * @return ARSTREAM_OK if no error happened
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if the sender or auBuffer pointer is invalid, or if auSize is zero
+ * @return ARSTREAM_ERROR_QUEUE_FULL if the queue is full, and flushPreviousAus is not active
+ *
+ * @note For the reader to map auTimestampUs onto its own clock (see ARSTREAM_Reader2_SenderTimeToLocalTime()), it must be taken on the ARSAL_Time_GetTime() clock
+ */
+eARSTREAM_ERROR ARSTREAM_Sender2_SendNewAu (ARSTREAM_Sender2_t *sender, uint8_t *auBuffer, uint32_t auSize, uint64_t auTimestampUs, int flushPreviousAus, int *nbPreviousAus);
+
+/**
+ * @brief Flushes all currently queued access units
+ *
+ * @param[in] sender The ARSTREAM_Sender2_t to be flushed.
+ *
+ * @return ARSTREAM_OK if no error occured.
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if the sender is invalid.
+ */
+eARSTREAM_ERROR ARSTREAM_Sender2_FlushAuQueue (ARSTREAM_Sender2_t *sender);
+
+/**
+ * @brief Runs the data loop of the ARSTREAM_Sender2_t
+ * @warning This function never returns until ARSTREAM_Sender2_StopSender() is called. The tread can then be joined.
+ *
+ * @param ARSTREAM_Sender2_t_Param A valid (ARSTREAM_Sender2_t *) casted as a (void *)
+ */
+void* ARSTREAM_Sender2_RunDataThread (void *ARSTREAM_Sender2_t_Param);
+
+/**
+ * @brief Runs the control loop of the ARSTREAM_Sender2_t
+ * This loop answers the clock synchronization requests of the reader, and receives its reports.
+ * Running it is optional: without it, the reader clock is never synchronized, and no receiver report is available.
+ * @warning This function never returns until ARSTREAM_Sender2_StopSender() is called. The tread can then be joined.
+ *
+ * @param ARSTREAM_Sender2_t_Param A valid (ARSTREAM_Sender2_t *) casted as a (void *)
+ */
+void* ARSTREAM_Sender2_RunControlThread (void *ARSTREAM_Sender2_t_Param);
+
+/**
+ * @brief Gets the statistics of an ARSTREAM_Sender2_t
+ *
+ * The sender sends RTCP-like sender reports, and the reader answers with receiver reports
+ * (loss, jitter, and the delay needed to compute the round trip time). Both are multiplexed
+ * with the stream, and each end limits its reports to half a percent of the stream bandwidth.
+ *
+ * @param[in] sender The ARSTREAM_Sender2_t
+ * @param[out] stats Pointer to the structure to fill
+ *
+ * @return ARSTREAM_OK if stats was filled
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if sender or stats is NULL
+ */
+eARSTREAM_ERROR ARSTREAM_Sender2_GetStats (ARSTREAM_Sender2_t *sender, ARSTREAM_Sender2_Stats_t *stats);
+
+#endif /* _ARSTREAM_SENDER2_H_ */
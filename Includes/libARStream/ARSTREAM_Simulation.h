@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Simulation.h
+ * @brief Virtual clock and discrete-event scheduler of the simulation builds
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_SIMULATION_H_
+#define _ARSTREAM_SIMULATION_H_
+
+/*
+ * The simulation API only exists when the library is built with ARSTREAM_SIMULATION=1.
+ *
+ * In these builds, the ARSTREAM_Sender_t, the ARSTREAM_Reader_t, the loopback transport and the
+ * impairment layer read the time from a virtual clock, and all their waits (condition waits, transport
+ * reads, sleeps) are handled by a discrete-event scheduler :
+ * - Only one simulated thread runs at a time. It runs until it waits.
+ * - Woken threads run in a fixed order (wake-up time, then creation order).
+ * - When all the simulated threads wait, the virtual clock jumps to the earliest wait deadline.
+ * Runs are thus deterministic, and idle time costs nothing : hours of streaming run in seconds.
+ *
+ * All the threads which use a sender or a reader (including their own threads) must be simulated threads :
+ * the thread calling ARSTREAM_Simulation_Init(), or threads created by ARSTREAM_Simulation_ThreadCreate().
+ * A simulated thread must not block outside of the simulation functions while another simulated
+ * thread holds a lock it needs (e.g. no plain sleep, no blocking socket).
+ * Only the loopback transport can be used (with or without impairments).
+ */
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+#include <time.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Starts the simulation. The calling thread becomes the first simulated thread.
+ * @param[in] startTimeUs Initial value of the virtual clock
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BUSY if the simulation is already started
+ * @return ARSTREAM_ERROR_ALLOC on allocation error
+ */
+eARSTREAM_ERROR ARSTREAM_Simulation_Init (uint64_t startTimeUs);
+
+/**
+ * @brief Stops the simulation
+ * @return ARSTREAM_OK on success
+ * @return ARSTREAM_ERROR_BUSY if simulated threads (other than the caller) were not joined
+ * @return ARSTREAM_ERROR_BAD_PARAMETERS if the simulation is not started, or if not called by the thread which started it
+ */
+eARSTREAM_ERROR ARSTREAM_Simulation_Deinit (void);
+
+/**
+ * @brief Gets the virtual time
+ * @param[out] res The virtual time (same epoch as the startTimeUs given to ARSTREAM_Simulation_Init())
+ * @return 0
+ */
+int ARSTREAM_Simulation_GetTime (struct timespec *res);
+
+/**
+ * @brief Gets the virtual time in microseconds
+ */
+uint64_t ARSTREAM_Simulation_GetTimeUs (void);
+
+/**
+ * @brief Gets the number of scheduling decisions done since the start of the simulation
+ * This is a cheap fingerprint of a run : two runs of the same scenario must give the same value.
+ */
+uint64_t ARSTREAM_Simulation_GetNbSwitches (void);
+
+/**
+ * @brief Suspends the calling simulated thread for some virtual time
+ * @param[in] us Duration in microseconds (0 lets the other runnable threads run first)
+ */
+void ARSTREAM_Simulation_SleepUs (uint64_t us);
+
+/**
+ * @brief Waits until an object is notified, or until a virtual deadline
+ * @param[in] object Any address, used to match ARSTREAM_Simulation_Notify() calls
+ * @param[in] deadlineUs Virtual time at which the wait ends, or UINT64_MAX for no deadline
+ * @return 0 if notified, ETIMEDOUT if the deadline was reached
+ */
+int ARSTREAM_Simulation_Wait (const void *object, uint64_t deadlineUs);
+
+/**
+ * @brief Wakes the simulated threads waiting on an object
+ * @param[in] object The object given to ARSTREAM_Simulation_Wait()
+ * @param[in] all 0 to wake only the oldest waiting thread, 1 to wake all of them
+ */
+void ARSTREAM_Simulation_Notify (const void *object, int all);
+
+/**
+ * @brief Simulated versions of the ARSAL_Cond functions, with the same return values
+ * The cond is only used as an identifier : it does not need to be initialized.
+ */
+int ARSTREAM_Simulation_CondWait (ARSAL_Cond_t *cond, ARSAL_Mutex_t *mutex);
+int ARSTREAM_Simulation_CondTimedwait (ARSAL_Cond_t *cond, ARSAL_Mutex_t *mutex, int timeout);
+int ARSTREAM_Simulation_CondSignal (ARSAL_Cond_t *cond);
+int ARSTREAM_Simulation_CondBroadcast (ARSAL_Cond_t *cond);
+
+/**
+ * @brief Creates a simulated thread. It will first run when the calling thread waits.
+ * @param[out] thread The new thread
+ * @param[in] routine The thread routine
+ * @param[in] arg The routine argument
+ * @return 0 on success, -1 on error
+ */
+int ARSTREAM_Simulation_ThreadCreate (ARSAL_Thread_t *thread, ARSAL_Thread_Routine_t routine, void *arg);
+
+/**
+ * @brief Waits (in virtual time) for the end of a simulated thread
+ * @param[in] thread The thread to join
+ * @param[out] retval Optional pointer to the return value of the routine
+ * @return 0 on success, -1 if thread is not a simulated thread
+ * @note This replaces ARSAL_Thread_Join(). The thread must still be destroyed with ARSAL_Thread_Destroy().
+ */
+int ARSTREAM_Simulation_ThreadJoin (ARSAL_Thread_t thread, void **retval);
+
+#endif /* ARSTREAM_SIMULATION */
+
+#endif /* _ARSTREAM_SIMULATION_H_ */
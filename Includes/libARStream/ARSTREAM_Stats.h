@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Stats.h
+ * @brief Common definitions of the ARSTREAM_Sender and ARSTREAM_Reader statistics
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_STATS_H_
+#define _ARSTREAM_STATS_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Number of buckets of the latency histograms
+ *
+ * Histograms use power of two buckets, in milliseconds :
+ * - bucket 0 counts the values under 1 ms
+ * - bucket i counts the values in [2^(i-1), 2^i[ ms
+ * - the last bucket also counts all the larger values (16 seconds or more)
+ */
+#define ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS (16)
+
+/**
+ * @brief Lower bound, in milliseconds, of a histogram bucket
+ */
+#define ARSTREAM_STATS_HISTOGRAM_BUCKET_MIN_MS(BUCKET) (((BUCKET) == 0) ? 0 : (1u << ((BUCKET) - 1)))
+
+#endif /* _ARSTREAM_STATS_H_ */
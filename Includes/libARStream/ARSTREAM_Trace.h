@@ -0,0 +1,211 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Trace.h
+ * @brief Per-frame lifecycle tracing of the stream sender and reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_TRACE_H_
+#define _ARSTREAM_TRACE_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+#include <stdio.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * @brief Default number of events of a thread ring
+ * @see ARSTREAM_Trace_SetRingSize()
+ */
+#define ARSTREAM_TRACE_DEFAULT_RING_SIZE (16384)
+
+/**
+ * @brief Maximum number of traced threads
+ * Rings of the threads which called ARSTREAM_Trace_ReleaseThread() are reused once drained
+ */
+#define ARSTREAM_TRACE_MAX_THREADS (64)
+
+/**
+ * @brief Maximum length of a thread name, including the terminating null byte
+ */
+#define ARSTREAM_TRACE_THREAD_NAME_SIZE (32)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Stages of the life of a frame
+ * The meaning of the arg field of ARSTREAM_Trace_Event_t is given for each event
+ */
+typedef enum {
+    ARSTREAM_TRACE_EVENT_SENDER_FRAME_QUEUED = 0, /**< ARSTREAM_Sender_SendNewFrame queued the frame (arg: frame size) */
+    ARSTREAM_TRACE_EVENT_SENDER_FILTERS_BEGIN, /**< The sender filters start processing the frame (arg: number of filters) */
+    ARSTREAM_TRACE_EVENT_SENDER_FILTERS_END, /**< The sender filters processed the frame (arg: output size) */
+    ARSTREAM_TRACE_EVENT_SENDER_FRAME_START, /**< The frame becomes the current frame of the sender (arg: number of fragments) */
+    ARSTREAM_TRACE_EVENT_SENDER_FIRST_FRAGMENT, /**< The first fragment of the frame was given to the transport (arg: fragment index) */
+    ARSTREAM_TRACE_EVENT_SENDER_RETRY, /**< A new send pass on a frame which was already sent (arg: number of fragments sent again) */
+    ARSTREAM_TRACE_EVENT_SENDER_ACK_RECEIVED, /**< An ack of the current frame was received (arg: number of acknowledged fragments) */
+    ARSTREAM_TRACE_EVENT_SENDER_FRAME_ACKED, /**< The last fragment of the frame was acknowledged (arg: number of fragments) */
+    ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED, /**< The frame was cancelled before being acknowledged (arg: unused) */
+    ARSTREAM_TRACE_EVENT_READER_FIRST_FRAGMENT, /**< The reader received the first fragment of the frame (arg: number of fragments) */
+    ARSTREAM_TRACE_EVENT_READER_FRAME_COMPLETE, /**< The reader received all the fragments of the frame (arg: number of missed frames before it) */
+    ARSTREAM_TRACE_EVENT_READER_FILTERS_BEGIN, /**< The reader filters start processing the frame (arg: number of filters) */
+    ARSTREAM_TRACE_EVENT_READER_FILTERS_END, /**< The reader filters processed the frame (arg: output size) */
+    ARSTREAM_TRACE_EVENT_READER_FRAME_DELIVERED, /**< The frame complete callback returned (arg: frame size) */
+    ARSTREAM_TRACE_EVENT_READER_FRAME_PARTIAL, /**< The frame was delivered incomplete (arg: number of missing regions) */
+    ARSTREAM_TRACE_EVENT_READER_FRAME_DROPPED, /**< The frame was superseded before completion (arg: number of missing fragments) */
+    ARSTREAM_TRACE_EVENT_READER_FRAME_SKIPPED, /**< The frame was not delivered as it can not be decoded (arg: unused) */
+    ARSTREAM_TRACE_EVENT_READER_ACK_SENT, /**< The reader sent an ack of the frame (arg: number of acknowledged fragments) */
+    ARSTREAM_TRACE_EVENT_MAX, /**< Number of events */
+} eARSTREAM_TRACE_EVENT;
+
+/**
+ * @brief A trace event (16 bytes)
+ */
+typedef struct {
+    uint64_t timestampNs; /**< ARSAL_Time_GetTime() time (the virtual time in the simulation builds) */
+    uint32_t arg; /**< Event specific value, see eARSTREAM_TRACE_EVENT */
+    uint16_t frameNumber; /**< Frame number (as sent on the network) */
+    uint8_t event; /**< An eARSTREAM_TRACE_EVENT */
+    uint8_t threadIndex; /**< Index of the ring which recorded the event */
+} ARSTREAM_Trace_Event_t;
+
+/**
+ * @brief Callback of ARSTREAM_Trace_Drain()
+ * @param event The event
+ * @param threadName The name of the thread which recorded the event
+ * @param custom The custom pointer given to ARSTREAM_Trace_Drain()
+ */
+typedef void (*ARSTREAM_Trace_Callback_t) (const ARSTREAM_Trace_Event_t *event, const char *threadName, void *custom);
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Enables or disables the recording of the trace events
+ * Tracing is disabled by default. While disabled, each tracepoint costs a single predictable branch.
+ * In the builds made with ARSTREAM_TRACE=0, tracepoints are compiled out and this function returns ARSTREAM_ERROR_BAD_PARAMETERS.
+ * @param enable 1 to record the events, 0 to stop recording them
+ * @return ARSTREAM_OK, or ARSTREAM_ERROR_BAD_PARAMETERS if tracing was compiled out
+ */
+eARSTREAM_ERROR ARSTREAM_Trace_Enable (int enable);
+
+/**
+ * @brief Sets the number of events of the rings created after this call
+ * Each traced thread records its events in its own single producer / single consumer ring.
+ * When a ring is full, new events are dropped (and counted, see ARSTREAM_Trace_GetNbDroppedEvents())
+ * @param nbEvents Number of events of a ring, must be a power of two
+ * @return ARSTREAM_OK, or ARSTREAM_ERROR_BAD_PARAMETERS if nbEvents is not a power of two
+ */
+eARSTREAM_ERROR ARSTREAM_Trace_SetRingSize (uint32_t nbEvents);
+
+/**
+ * @brief Names the calling thread in the traces
+ * The library threads (sender and reader data/ack threads) name themselves.
+ * @param name The name (truncated to ARSTREAM_TRACE_THREAD_NAME_SIZE - 1 characters, copied)
+ */
+void ARSTREAM_Trace_SetThreadName (const char *name);
+
+/**
+ * @brief Tells that the calling thread will not record events anymore
+ * Its ring is given to another thread once drained. The library threads call it before returning.
+ */
+void ARSTREAM_Trace_ReleaseThread (void);
+
+/**
+ * @brief Gets the name of an event
+ * @param event The event
+ * @return A constant string (e.g. "SENDER_FRAME_QUEUED")
+ */
+const char* ARSTREAM_Trace_EventToString (eARSTREAM_TRACE_EVENT event);
+
+/**
+ * @brief Removes all the recorded events from the rings, and calls a callback for each of them
+ * Events of a thread are given in order. Events of different threads are not merged.
+ * Can be called while the events are recorded, but not from two threads at the same time.
+ * @param callback The callback to call for each event
+ * @param custom Custom pointer given to the callback
+ * @return The number of events, or -1 if another drain is running
+ */
+int ARSTREAM_Trace_Drain (ARSTREAM_Trace_Callback_t callback, void *custom);
+
+/**
+ * @brief Moves up to maxEvents recorded events from the rings to an array
+ * The rings are emptied in order, and the events which do not fit are kept for the next call.
+ * Events of a thread are given in order. Events of different threads are not merged.
+ * Use ARSTREAM_Trace_GetThreadName() to get the thread of an event from its threadIndex.
+ * Can be called while the events are recorded, but not from two threads at the same time (also see ARSTREAM_Trace_Drain()).
+ * @param events The array to fill
+ * @param maxEvents Number of events of the array
+ * @return The number of events written to the array, or -1 if another drain is running
+ * @note This function does not allocate memory
+ */
+int ARSTREAM_Trace_DrainToArray (ARSTREAM_Trace_Event_t *events, int maxEvents);
+
+/**
+ * @brief Gets the name of the thread which currently owns a ring
+ * @param threadIndex The threadIndex of an ARSTREAM_Trace_Event_t
+ * @return The name, or NULL if the ring does not exist
+ * @warning The name changes if the ring is given to another thread (see ARSTREAM_Trace_ReleaseThread()), so drain the events before their thread stops
+ */
+const char* ARSTREAM_Trace_GetThreadName (uint8_t threadIndex);
+
+/**
+ * @brief Drains the rings into a Chrome trace JSON document (chrome://tracing, ui.perfetto.dev)
+ * Each event is an instant event on the track of its thread. Filters are duration slices.
+ * The life of each frame is an async slice, from SENDER_FRAME_QUEUED to SENDER_FRAME_ACKED/CANCELLED
+ * on the sender side, and from READER_FIRST_FRAGMENT to its delivery, drop or skip on the reader side.
+ * @param file The file to write to (opened by the caller)
+ * @return ARSTREAM_OK, ARSTREAM_ERROR_BAD_PARAMETERS if file is NULL, or ARSTREAM_ERROR_BUSY if another drain is running
+ */
+eARSTREAM_ERROR ARSTREAM_Trace_WriteChromeJson (FILE *file);
+
+/**
+ * @brief Gets the number of events lost because a ring was full, or no ring was available
+ * @return The number of dropped events since the start of the process
+ */
+uint64_t ARSTREAM_Trace_GetNbDroppedEvents (void);
+
+#endif /* _ARSTREAM_TRACE_H_ */
@@ -39,8 +39,19 @@
 #define _ARSTREAM_H_
 
 #include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Capture.h>
+#include <libARStream/ARSTREAM_CipherFilter.h>
 #include <libARStream/ARSTREAM_Filter.h>
+#include <libARStream/ARSTREAM_Impairment.h>
+#include <libARStream/ARSTREAM_Loopback.h>
 #include <libARStream/ARSTREAM_Sender.h>
 #include <libARStream/ARSTREAM_Reader.h>
+#include <libARStream/ARSTREAM_JitterBuffer.h>
+#include <libARStream/ARSTREAM_Publisher.h>
+#include <libARStream/ARSTREAM_Sender2.h>
+#include <libARStream/ARSTREAM_Reader2.h>
+#include <libARStream/ARSTREAM_Simulation.h>
+#include <libARStream/ARSTREAM_Stats.h>
+#include <libARStream/ARSTREAM_Trace.h>
 
 #endif /* _ARSTREAM_H_ */
@@ -29,16 +29,27 @@
   SUCH DAMAGE.
 */
 #include <jni.h>
+#include <stdlib.h>
+#include <string.h>
 #include <libARStream/ARSTREAM_Reader.h>
 #include <libARSAL/ARSAL_Print.h>
 
 #define JNI_READER_TAG "ARSTREAM_JNIReader"
 
+/**
+ * Native side of a Java ARStreamReader, given as the custom pointer of the ARSTREAM_Reader_t
+ */
+typedef struct {
+    jobject thizz; /**< Global reference to the Java object */
+    int64_t *nextFrameBufferSlot; /**< Address of the Java direct buffer where the callback wrapper stores the next frame buffer and its capacity */
+} ARSTREAM_JNIReader_Context_t;
+
 static jmethodID g_cbWrapper_id = 0;
 static JavaVM *g_vm = NULL;
 
-static uint8_t* internalCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *thizz)
+static uint8_t* internalCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
 {
+    ARSTREAM_JNIReader_Context_t *context = (ARSTREAM_JNIReader_Context_t *)custom;
     JNIEnv *env = NULL;
     int wasAlreadyAttached = 1;
     int envStatus = (*g_vm)->GetEnv(g_vm, (void **)&env, JNI_VERSION_1_6);
@@ -60,20 +71,19 @@ static uint8_t* internalCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePo
     }
 
     jboolean isFlush = (isFlushFrame == 1) ? JNI_TRUE : JNI_FALSE;
-    jlongArray newNativeDataInfos = (*env)->CallObjectMethod(env, (jobject)thizz, g_cbWrapper_id, (jint)cause, (jlong)(intptr_t)framePointer, (jint)frameSize, isFlush, (jint)numberOfSkippedFrames, (jint)*newBufferCapacity);
-
-    uint8_t *retVal = NULL;
-    *newBufferCapacity = 0;
-    if (newNativeDataInfos != NULL)
+    /* The wrapper returns the next buffer through the slot : no Java object is created per frame */
+    context->nextFrameBufferSlot[0] = 0;
+    context->nextFrameBufferSlot[1] = 0;
+    (*env)->CallVoidMethod(env, context->thizz, g_cbWrapper_id, (jint)cause, (jlong)(intptr_t)framePointer, (jint)frameSize, isFlush, (jint)numberOfSkippedFrames, (jint)*newBufferCapacity);
+    if ((*env)->ExceptionCheck(env) == JNI_TRUE)
     {
-        jlong *array = (*env)->GetLongArrayElements(env, newNativeDataInfos, NULL);
-        retVal = (uint8_t *)(intptr_t)array[0];
-        *newBufferCapacity = (int)array[1];
-        (*env)->ReleaseLongArrayElements(env, newNativeDataInfos, array, 0);
-
-        (*env)->DeleteLocalRef (env, newNativeDataInfos);
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
     }
 
+    uint8_t *retVal = (uint8_t *)(intptr_t)context->nextFrameBufferSlot[0];
+    *newBufferCapacity = (uint32_t)context->nextFrameBufferSlot[1];
+
     if (wasAlreadyAttached == 0)
     {
         (*g_vm)->DetachCurrentThread(g_vm);
@@ -90,7 +100,7 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeInitClass (JNIEnv *env, jcla
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_READER_TAG, "Unable to get JavaVM pointer");
     }
-    g_cbWrapper_id = (*env)->GetMethodID (env, clazz, "callbackWrapper", "(IJIZII)[J");
+    g_cbWrapper_id = (*env)->GetMethodID (env, clazz, "callbackWrapper", "(IJIZII)V");
 }
 
 JNIEXPORT jint JNICALL
@@ -99,6 +109,30 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetDefaultMaxAckInterval (JN
     return ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetStatsSize (JNIEnv *env, jclass clazz)
+{
+    return (jint)sizeof (ARSTREAM_Reader_Stats_t);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetStatsHistogramNbBuckets (JNIEnv *env, jclass clazz)
+{
+    return ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetFreezeStatsSize (JNIEnv *env, jclass clazz)
+{
+    return (jint)sizeof (ARSTREAM_Reader_FreezeStats_t);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetDefaultKeyFrameRequestInterval (JNIEnv *env, jclass clazz)
+{
+    return ARSTREAM_READER_KEY_FRAME_REQUEST_INTERVAL_DEFAULT_MS;
+}
+
 JNIEXPORT void JNICALL
 Java_com_parrot_arsdk_arstream_ARStreamReader_nativeSetDataBufferParams (JNIEnv *env, jclass clazz, jlong cParams, jint id, jint maxFragmentSize, jint maxNumberOfFragment)
 {
@@ -112,15 +146,35 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeSetAckBufferParams (JNIEnv *
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_parrot_arsdk_arstream_ARStreamReader_nativeConstructor (JNIEnv *env, jobject thizz, jlong cNetManager, jint dataBufferId, jint ackBufferId, jlong frameBuffer, jint frameBufferSize, jint maxFragmentSize, jint maxAckInterval)
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeConstructor (JNIEnv *env, jobject thizz, jlong cNetManager, jint dataBufferId, jint ackBufferId, jlong frameBuffer, jint frameBufferSize, jint maxFragmentSize, jint maxAckInterval, jobject nextFrameBufferSlot)
 {
     eARSTREAM_ERROR err = ARSTREAM_OK;
-    jobject g_thizz = (*env)->NewGlobalRef(env, thizz);
-    ARSTREAM_Reader_t *retReader = ARSTREAM_Reader_New ((ARNETWORK_Manager_t *)(intptr_t)cNetManager, dataBufferId, ackBufferId, internalCallback, (uint8_t *)(intptr_t)frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, (void *)g_thizz, &err);
+    ARSTREAM_Reader_t *retReader = NULL;
+    ARSTREAM_JNIReader_Context_t *context = NULL;
+
+    if ((nextFrameBufferSlot == NULL) ||
+        ((*env)->GetDirectBufferCapacity(env, nextFrameBufferSlot) < (jlong)(2 * sizeof (int64_t))))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_READER_TAG, "Invalid next frame buffer slot");
+        return 0;
+    }
+    context = malloc (sizeof (ARSTREAM_JNIReader_Context_t));
+    if (context == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_READER_TAG, "Unable to allocate the reader context");
+        return 0;
+    }
+    // The slot is owned by the Java object, which outlives the native reader
+    context->nextFrameBufferSlot = (int64_t *)(*env)->GetDirectBufferAddress(env, nextFrameBufferSlot);
+    context->thizz = (*env)->NewGlobalRef(env, thizz);
+
+    retReader = ARSTREAM_Reader_New ((ARNETWORK_Manager_t *)(intptr_t)cNetManager, dataBufferId, ackBufferId, internalCallback, (uint8_t *)(intptr_t)frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, (void *)context, &err);
 
     if (err != ARSTREAM_OK)
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_READER_TAG, "Error while creating reader : %s", ARSTREAM_Error_ToString (err));
+        (*env)->DeleteGlobalRef(env, context->thizz);
+        free (context);
     }
     return (jlong)(intptr_t)retReader;
 }
@@ -148,20 +202,21 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeDispose (JNIEnv *env, jobjec
 {
     jboolean retVal = JNI_TRUE;
     ARSTREAM_Reader_t *reader = (ARSTREAM_Reader_t *)(intptr_t)cReader;
-    void *ref = ARSTREAM_Reader_GetCustom(reader);
+    ARSTREAM_JNIReader_Context_t *context = (ARSTREAM_JNIReader_Context_t *)ARSTREAM_Reader_GetCustom(reader);
     eARSTREAM_ERROR err = ARSTREAM_Reader_Delete (&reader);
     if (err != ARSTREAM_OK)
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_READER_TAG, "Unable to delete reader : %s", ARSTREAM_Error_ToString (err));
         retVal = JNI_FALSE;
     }
-    if (retVal == JNI_TRUE && ref != NULL)
+    if (retVal == JNI_TRUE && context != NULL)
     {
-        (*env)->DeleteGlobalRef(env, (jobject)ref);
+        (*env)->DeleteGlobalRef(env, context->thizz);
         if ((*env)->ExceptionOccurred(env) != NULL)
         {
             (*env)->ExceptionDescribe(env);
         }
+        free (context);
     }
     return retVal;
 }
@@ -172,6 +227,27 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetEfficiency (JNIEnv *env,
     return ARSTREAM_Reader_GetEstimatedEfficiency ((ARSTREAM_Reader_t *)(intptr_t)cReader);
 }
 
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetStats (JNIEnv *env, jobject thizz, jlong cReader, jobject buffer)
+{
+    ARSTREAM_Reader_Stats_t stats;
+    uint8_t *address = (*env)->GetDirectBufferAddress (env, buffer);
+    eARSTREAM_ERROR err;
+
+    if ((address == NULL) ||
+        ((*env)->GetDirectBufferCapacity (env, buffer) < (jlong)sizeof (stats)))
+    {
+        return (jint)ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    err = ARSTREAM_Reader_GetStats ((ARSTREAM_Reader_t *)(intptr_t)cReader, &stats);
+    if (err == ARSTREAM_OK)
+    {
+        // The buffer may not be aligned for the structure
+        memcpy (address, &stats, sizeof (stats));
+    }
+    return (jint)err;
+}
+
 JNIEXPORT jint JNICALL
 Java_com_parrot_arsdk_arstream_ARStreamReader_nativeAddFilter (JNIEnv *env, jobject thizz, jlong cReader, jlong cFilter)
 {
@@ -179,3 +255,51 @@ Java_com_parrot_arsdk_arstream_ARStreamReader_nativeAddFilter (JNIEnv *env, jobj
     ARSTREAM_Filter_t *filter = (ARSTREAM_Filter_t *)(intptr_t)cFilter;
     return ARSTREAM_Reader_AddFilter (reader, filter);
 }
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeSetPartialFrameDelivery (JNIEnv *env, jobject thizz, jlong cReader, jboolean enable, jint frameTimeoutMs)
+{
+    ARSTREAM_Reader_t *reader = (ARSTREAM_Reader_t *)(intptr_t)cReader;
+    return ARSTREAM_Reader_SetPartialFrameDelivery (reader, (enable == JNI_TRUE) ? 1 : 0, frameTimeoutMs);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeSetSkipUntilFlushFrame (JNIEnv *env, jobject thizz, jlong cReader, jboolean enable)
+{
+    ARSTREAM_Reader_t *reader = (ARSTREAM_Reader_t *)(intptr_t)cReader;
+    return ARSTREAM_Reader_SetSkipUntilFlushFrame (reader, (enable == JNI_TRUE) ? 1 : 0);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeSetKeyFrameRequests (JNIEnv *env, jobject thizz, jlong cReader, jboolean enable, jint minIntervalMs)
+{
+    ARSTREAM_Reader_t *reader = (ARSTREAM_Reader_t *)(intptr_t)cReader;
+    return ARSTREAM_Reader_SetKeyFrameRequests (reader, (enable == JNI_TRUE) ? 1 : 0, minIntervalMs);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeRequestKeyFrame (JNIEnv *env, jobject thizz, jlong cReader)
+{
+    return ARSTREAM_Reader_RequestKeyFrame ((ARSTREAM_Reader_t *)(intptr_t)cReader);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamReader_nativeGetFreezeStats (JNIEnv *env, jobject thizz, jlong cReader, jobject buffer)
+{
+    ARSTREAM_Reader_FreezeStats_t stats;
+    uint8_t *address = (*env)->GetDirectBufferAddress (env, buffer);
+    eARSTREAM_ERROR err;
+
+    if ((address == NULL) ||
+        ((*env)->GetDirectBufferCapacity (env, buffer) < (jlong)sizeof (stats)))
+    {
+        return (jint)ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    err = ARSTREAM_Reader_GetFreezeStats ((ARSTREAM_Reader_t *)(intptr_t)cReader, &stats);
+    if (err == ARSTREAM_OK)
+    {
+        // The buffer may not be aligned for the structure
+        memcpy (address, &stats, sizeof (stats));
+    }
+    return (jint)err;
+}
@@ -29,17 +29,71 @@
   SUCH DAMAGE.
 */
 #include <jni.h>
+#include <stdlib.h>
+#include <string.h>
 #include <libARStream/ARSTREAM_Sender.h>
 #include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
 
 #define JNI_SENDER_TAG "ARSTREAM_JNISender"
 
+/**
+ * Native side of a Java ARStreamSender, given as the custom pointer of the ARSTREAM_Sender_t
+ */
+typedef struct {
+    jobject thizz; /**< Global reference to the Java object */
+    ARSAL_Mutex_t mutex; /**< Protects slotFrames (send thread vs. sender threads) */
+    int nbSlots;
+    uint8_t **slotFrames; /**< Frame owned by the native sender in each Java slot (NULL if free) */
+} ARSTREAM_JNISender_Context_t;
+
 static jmethodID g_cbWrapper_id = 0;
 static JavaVM *g_vm = NULL;
 
+static void ARSTREAM_JNISender_DeleteContext (JNIEnv *env, ARSTREAM_JNISender_Context_t *context)
+{
+    if (context != NULL)
+    {
+        if (context->thizz != NULL)
+        {
+            (*env)->DeleteGlobalRef(env, context->thizz);
+        }
+        ARSAL_Mutex_Destroy (&(context->mutex));
+        free (context->slotFrames);
+        free (context);
+    }
+}
+
+/**
+ * Finds and frees the slot of a frame
+ * @return The slot, or -1 if the frame was not sent through Java
+ */
+static jint ARSTREAM_JNISender_ReleaseSlot (ARSTREAM_JNISender_Context_t *context, uint8_t *framePointer)
+{
+    jint retSlot = -1;
+    int i;
+    if (framePointer == NULL)
+    {
+        return -1;
+    }
+    ARSAL_Mutex_Lock (&(context->mutex));
+    for (i = 0; i < context->nbSlots; i++)
+    {
+        if (context->slotFrames[i] == framePointer)
+        {
+            context->slotFrames[i] = NULL;
+            retSlot = i;
+            break;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(context->mutex));
+    return retSlot;
+}
 
-static void internalCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *thizz)
+static void internalCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
 {
+    ARSTREAM_JNISender_Context_t *context = (ARSTREAM_JNISender_Context_t *)custom;
+    jint slot = -1;
     JNIEnv *env = NULL;
     int wasAlreadyAttached = 1;
     int envStatus = (*g_vm)->GetEnv(g_vm, (void **)&env, JNI_VERSION_1_6);
@@ -58,7 +112,17 @@ static void internalCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePoin
         return;
     }
 
-    (*env)->CallVoidMethod(env, (jobject)thizz, g_cbWrapper_id, (jint)status, (jlong)(intptr_t)framePointer, (jint)frameSize);
+    if ((status == ARSTREAM_SENDER_STATUS_FRAME_SENT) ||
+        (status == ARSTREAM_SENDER_STATUS_FRAME_CANCEL))
+    {
+        slot = ARSTREAM_JNISender_ReleaseSlot (context, framePointer);
+    }
+    (*env)->CallVoidMethod(env, context->thizz, g_cbWrapper_id, (jint)status, slot, (jint)frameSize);
+    if ((*env)->ExceptionCheck(env) == JNI_TRUE)
+    {
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
+    }
 
     if (wasAlreadyAttached == 0)
     {
@@ -86,6 +150,18 @@ Java_com_parrot_arsdk_arstream_ARStreamSender_nativeGetInfiniteTimeBetweenRetrie
     return ARSTREAM_SENDER_INFINITE_TIME_BETWEEN_RETRIES;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamSender_nativeGetStatsSize (JNIEnv *env, jclass clazz)
+{
+    return (jint)sizeof (ARSTREAM_Sender_Stats_t);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamSender_nativeGetStatsHistogramNbBuckets (JNIEnv *env, jclass clazz)
+{
+    return ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS;
+}
+
 JNIEXPORT void JNICALL
 Java_com_parrot_arsdk_arstream_ARStreamSender_nativeInitClass (JNIEnv *env, jclass clazz)
 {
@@ -94,7 +170,7 @@ Java_com_parrot_arsdk_arstream_ARStreamSender_nativeInitClass (JNIEnv *env, jcla
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_SENDER_TAG, "Unable to get JavaVM pointer");
     }
-    g_cbWrapper_id = (*env)->GetMethodID (env, clazz, "callbackWrapper", "(IJI)V");
+    g_cbWrapper_id = (*env)->GetMethodID (env, clazz, "callbackWrapper", "(III)V");
 }
 
 JNIEXPORT void JNICALL
@@ -110,15 +186,43 @@ Java_com_parrot_arsdk_arstream_ARStreamSender_nativeSetAckBufferParams (JNIEnv *
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_parrot_arsdk_arstream_ARStreamSender_nativeConstructor (JNIEnv *env, jobject thizz, jlong cNetManager, jint dataBufferId, jint ackBufferId, jint framesBufferSize, jint maxFragmentSize, jint maxNumberOfFragment)
+Java_com_parrot_arsdk_arstream_ARStreamSender_nativeConstructor (JNIEnv *env, jobject thizz, jlong cNetManager, jint dataBufferId, jint ackBufferId, jint framesBufferSize, jint maxFragmentSize, jint maxNumberOfFragment, jint nbSlots)
 {
     eARSTREAM_ERROR err = ARSTREAM_OK;
-    jobject g_thizz = (*env)->NewGlobalRef(env, thizz);
-    ARSTREAM_Sender_t *retSender = ARSTREAM_Sender_New ((ARNETWORK_Manager_t *)(intptr_t)cNetManager, dataBufferId, ackBufferId, internalCallback, framesBufferSize, maxFragmentSize, maxNumberOfFragment, (void *)g_thizz, &err);
+    ARSTREAM_Sender_t *retSender = NULL;
+    ARSTREAM_JNISender_Context_t *context = NULL;
+
+    if (nbSlots <= 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_SENDER_TAG, "Invalid number of frame slots : %d", nbSlots);
+        return 0;
+    }
+    context = calloc (1, sizeof (ARSTREAM_JNISender_Context_t));
+    if (context != NULL)
+    {
+        context->nbSlots = nbSlots;
+        context->slotFrames = calloc (nbSlots, sizeof (uint8_t *));
+    }
+    if ((context == NULL) ||
+        (context->slotFrames == NULL) ||
+        (ARSAL_Mutex_Init (&(context->mutex)) != 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_SENDER_TAG, "Unable to allocate the sender context");
+        if (context != NULL)
+        {
+            free (context->slotFrames);
+        }
+        free (context);
+        return 0;
+    }
+    context->thizz = (*env)->NewGlobalRef(env, thizz);
+
+    retSender = ARSTREAM_Sender_New ((ARNETWORK_Manager_t *)(intptr_t)cNetManager, dataBufferId, ackBufferId, internalCallback, framesBufferSize, maxFragmentSize, maxNumberOfFragment, (void *)context, &err);
 
     if (err != ARSTREAM_OK)
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_SENDER_TAG, "Error while creating sender : %s", ARSTREAM_Error_ToString (err));
+        ARSTREAM_JNISender_DeleteContext (env, context);
     }
     return (jlong)(intptr_t)retSender;
 }
@@ -153,16 +257,16 @@ Java_com_parrot_arsdk_arstream_ARStreamSender_nativeDispose (JNIEnv *env, jobjec
 {
     jboolean retVal = JNI_TRUE;
     ARSTREAM_Sender_t *sender = (ARSTREAM_Sender_t *)(intptr_t)cSender;
-    void *ref = ARSTREAM_Sender_GetCustom (sender);
+    ARSTREAM_JNISender_Context_t *context = (ARSTREAM_JNISender_Context_t *)ARSTREAM_Sender_GetCustom (sender);
     eARSTREAM_ERROR err = ARSTREAM_Sender_Delete (&sender);
     if (err != ARSTREAM_OK)
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_SENDER_TAG, "Unable to delete sender : %s", ARSTREAM_Error_ToString (err));
         retVal = JNI_FALSE;
     }
-    if (retVal == JNI_TRUE && ref != NULL)
+    if (retVal == JNI_TRUE && context != NULL)
     {
-        (*env)->DeleteGlobalRef(env, (jobject)ref);
+        ARSTREAM_JNISender_DeleteContext (env, context);
     }
     return retVal;
 }
@@ -174,10 +278,52 @@ Java_com_parrot_arsdk_arstream_ARStreamSender_nativeGetEfficiency (JNIEnv *env,
 }
 
 JNIEXPORT jint JNICALL
-Java_com_parrot_arsdk_arstream_ARStreamSender_nativeSendNewFrame (JNIEnv *env, jobject thizz, jlong cSender, jlong frameBuffer, jint frameSize, jboolean flushPreviousFrames)
+Java_com_parrot_arsdk_arstream_ARStreamSender_nativeGetStats (JNIEnv *env, jobject thizz, jlong cSender, jobject buffer)
+{
+    ARSTREAM_Sender_Stats_t stats;
+    uint8_t *address = (*env)->GetDirectBufferAddress (env, buffer);
+    eARSTREAM_ERROR err;
+
+    if ((address == NULL) ||
+        ((*env)->GetDirectBufferCapacity (env, buffer) < (jlong)sizeof (stats)))
+    {
+        return (jint)ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    err = ARSTREAM_Sender_GetStats ((ARSTREAM_Sender_t *)(intptr_t)cSender, &stats);
+    if (err == ARSTREAM_OK)
+    {
+        // The buffer may not be aligned for the structure
+        memcpy (address, &stats, sizeof (stats));
+    }
+    return (jint)err;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamSender_nativeSendNewFrame (JNIEnv *env, jobject thizz, jlong cSender, jlong frameBuffer, jint frameSize, jboolean flushPreviousFrames, jint slot)
 {
+    ARSTREAM_Sender_t *sender = (ARSTREAM_Sender_t *)(intptr_t)cSender;
+    ARSTREAM_JNISender_Context_t *context = (ARSTREAM_JNISender_Context_t *)ARSTREAM_Sender_GetCustom (sender);
     int flush = (flushPreviousFrames == JNI_TRUE) ? 1 : 0;
-    eARSTREAM_ERROR err = ARSTREAM_Sender_SendNewFrame((ARSTREAM_Sender_t *)(intptr_t)cSender, (uint8_t *)(intptr_t)frameBuffer, frameSize, flush, NULL);
+    eARSTREAM_ERROR err;
+
+    if ((context == NULL) ||
+        (slot < 0) ||
+        (slot >= context->nbSlots))
+    {
+        return (jint)ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    // Registered before sending : the frame can be acknowledged before SendNewFrame returns
+    ARSAL_Mutex_Lock (&(context->mutex));
+    context->slotFrames[slot] = (uint8_t *)(intptr_t)frameBuffer;
+    ARSAL_Mutex_Unlock (&(context->mutex));
+
+    err = ARSTREAM_Sender_SendNewFrame(sender, (uint8_t *)(intptr_t)frameBuffer, frameSize, flush, NULL);
+    if (err != ARSTREAM_OK)
+    {
+        ARSAL_Mutex_Lock (&(context->mutex));
+        context->slotFrames[slot] = NULL;
+        ARSAL_Mutex_Unlock (&(context->mutex));
+    }
     return (jint)err;
 }
 
@@ -0,0 +1,137 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+#include <jni.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libARStream/ARSTREAM_Trace.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#define JNI_TRACE_TAG "ARSTREAM_JNITrace"
+
+/**
+ * Number of events copied at once when the Java buffer is not aligned
+ */
+#define JNI_TRACE_DRAIN_BATCH_SIZE (64)
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeGetEventSize (JNIEnv *env, jclass clazz)
+{
+    return (jint)sizeof (ARSTREAM_Trace_Event_t);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeGetNbEvents (JNIEnv *env, jclass clazz)
+{
+    return ARSTREAM_TRACE_EVENT_MAX;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeGetEventName (JNIEnv *env, jclass clazz, jint event)
+{
+    return (*env)->NewStringUTF (env, ARSTREAM_Trace_EventToString ((eARSTREAM_TRACE_EVENT)event));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeEnable (JNIEnv *env, jclass clazz, jboolean enable)
+{
+    return (jint)ARSTREAM_Trace_Enable ((enable == JNI_TRUE) ? 1 : 0);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeSetRingSize (JNIEnv *env, jclass clazz, jint nbEvents)
+{
+    if (nbEvents <= 0)
+    {
+        return (jint)ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    return (jint)ARSTREAM_Trace_SetRingSize ((uint32_t)nbEvents);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeDrain (JNIEnv *env, jclass clazz, jobject buffer)
+{
+    uint8_t *address = (*env)->GetDirectBufferAddress (env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity (env, buffer);
+    int maxEvents, nbEvents, nbCopied;
+
+    if ((address == NULL) ||
+        (capacity < (jlong)sizeof (ARSTREAM_Trace_Event_t)))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, JNI_TRACE_TAG, "Drain buffer must be a direct buffer of at least one event");
+        return -1;
+    }
+    maxEvents = (int)(capacity / sizeof (ARSTREAM_Trace_Event_t));
+
+    // Write the events in place when the buffer is aligned for them
+    if (((uintptr_t)address % sizeof (uint64_t)) == 0)
+    {
+        return ARSTREAM_Trace_DrainToArray ((ARSTREAM_Trace_Event_t *)address, maxEvents);
+    }
+
+    // Otherwise go through a small aligned array
+    nbEvents = 0;
+    do
+    {
+        ARSTREAM_Trace_Event_t events [JNI_TRACE_DRAIN_BATCH_SIZE];
+        int batchSize = maxEvents - nbEvents;
+        if (batchSize > JNI_TRACE_DRAIN_BATCH_SIZE)
+        {
+            batchSize = JNI_TRACE_DRAIN_BATCH_SIZE;
+        }
+        nbCopied = ARSTREAM_Trace_DrainToArray (events, batchSize);
+        if (nbCopied < 0)
+        {
+            return (nbEvents > 0) ? nbEvents : -1;
+        }
+        memcpy (&address [nbEvents * sizeof (ARSTREAM_Trace_Event_t)], events, nbCopied * sizeof (ARSTREAM_Trace_Event_t));
+        nbEvents += nbCopied;
+    } while ((nbCopied == JNI_TRACE_DRAIN_BATCH_SIZE) &&
+             (nbEvents < maxEvents));
+    return nbEvents;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeGetThreadName (JNIEnv *env, jclass clazz, jint threadIndex)
+{
+    const char *name = NULL;
+    if ((threadIndex >= 0) &&
+        (threadIndex < ARSTREAM_TRACE_MAX_THREADS))
+    {
+        name = ARSTREAM_Trace_GetThreadName ((uint8_t)threadIndex);
+    }
+    return (name != NULL) ? (*env)->NewStringUTF (env, name) : NULL;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_parrot_arsdk_arstream_ARStreamTrace_nativeGetNbDroppedEvents (JNIEnv *env, jclass clazz)
+{
+    return (jlong)ARSTREAM_Trace_GetNbDroppedEvents ();
+}
@@ -30,6 +30,9 @@
 */
 package com.parrot.arsdk.arstream;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 import com.parrot.arsdk.arsal.ARNativeData;
 import com.parrot.arsdk.arsal.ARSALPrint;
 
@@ -49,6 +52,16 @@ public class ARStreamReader
 {
     private static final String TAG = ARStreamReader.class.getSimpleName ();
 
+    /**
+     * Size of the next frame buffer slot : C-Pointer (long) then capacity (long)
+     */
+    private static final int NEXT_FRAME_BUFFER_SLOT_SIZE = 16;
+
+    /**
+     * Reader causes, indexed by their C value (avoids a boxed lookup per frame)
+     */
+    private static final ARSTREAM_READER_CAUSE_ENUM[] CAUSES = new ARSTREAM_READER_CAUSE_ENUM[ARSTREAM_READER_CAUSE_ENUM.ARSTREAM_READER_CAUSE_MAX.getValue()];
+
     /* *********************** */
     /* INTERNAL REPRESENTATION */
     /* *********************** */
@@ -73,6 +86,13 @@ public class ARStreamReader
      */
     private ARStreamReaderListener eventListener;
 
+    /**
+     * Next frame buffer, written by the callback wrapper and read by the
+     * native callback (native byte order).<br>
+     * Allocated once, so that no Java object is created per frame.
+     */
+    private final ByteBuffer nextFrameBufferSlot = ByteBuffer.allocateDirect (NEXT_FRAME_BUFFER_SLOT_SIZE).order (ByteOrder.nativeOrder ());
+
     /**
      * Check validity before all function calls
      */
@@ -93,6 +113,42 @@ public class ARStreamReader
     /* **************** */
     public static final int DEFAULT_MAX_ACK_INTERVAL = nativeGetDefaultMaxAckInterval();
 
+    /*
+     * Layout of the statistics written by getStats (ARSTREAM_Reader_Stats_t)
+     * All the fields are 32 bits wide, in native byte order (ByteOrder.nativeOrder())
+     */
+    public static final int STATS_SIZE = nativeGetStatsSize();
+    public static final int STATS_HISTOGRAM_NB_BUCKETS = nativeGetStatsHistogramNbBuckets();
+    public static final int STATS_NB_FRAGMENTS_RECEIVED = 0;
+    public static final int STATS_NB_FRAGMENTS_USEFUL = 4;
+    public static final int STATS_NB_FRAMES_COMPLETE = 8;
+    public static final int STATS_NB_FRAMES_INCOMPLETE = 12;
+    public static final int STATS_NB_FRAMES_DROPPED = 16;
+    public static final int STATS_NB_FRAMES_SKIPPED = 20;
+    public static final int STATS_NB_ACKS_SENT = 24;
+    public static final int STATS_EFFICIENCY = 28; /* float */
+    public static final int STATS_NB_FREEZES = 32;
+    public static final int STATS_TOTAL_FREEZE_MS = 36;
+    public static final int STATS_MAX_FREEZE_MS = 40;
+    public static final int STATS_LAST_FREEZE_MS = 44;
+    public static final int STATS_FIRST_FRAME_DELAY_MS = 48;
+    public static final int STATS_NB_KEY_FRAME_REQUESTS = 52;
+    public static final int STATS_REASSEMBLY_TIME_HISTOGRAM = 56; /* STATS_HISTOGRAM_NB_BUCKETS ints, bucket i counts [2^(i-1), 2^i[ ms */
+
+    /*
+     * Layout of the statistics written by getFreezeStats (ARSTREAM_Reader_FreezeStats_t)
+     * All the fields are 32 bits wide, in native byte order (ByteOrder.nativeOrder())
+     */
+    public static final int FREEZE_STATS_SIZE = nativeGetFreezeStatsSize();
+    public static final int FREEZE_STATS_NB_FREEZES = 0;
+    public static final int FREEZE_STATS_TOTAL_FREEZE_MS = 4;
+    public static final int FREEZE_STATS_MAX_FREEZE_MS = 8;
+    public static final int FREEZE_STATS_LAST_FREEZE_MS = 12;
+    public static final int FREEZE_STATS_FIRST_FRAME_DELAY_MS = 16;
+    public static final int FREEZE_STATS_NB_KEY_FRAME_REQUESTS = 20;
+
+    public static final int DEFAULT_KEY_FRAME_REQUEST_INTERVAL_MS = nativeGetDefaultKeyFrameRequestInterval();
+
     /* **************** */
     /* STATIC FUNCTIONS */
     /* **************** */
@@ -140,7 +196,7 @@ public class ARStreamReader
      */
     public ARStreamReader (ARNetworkManager netManager, int dataBufferId, int ackBufferId, ARNativeData initialFrameBuffer, ARStreamReaderListener theEventListener, int maxFragmentSize, int maxAckInterval)
     {
-        this.cReader = nativeConstructor (netManager.getManager (), dataBufferId, ackBufferId, initialFrameBuffer.getData (), initialFrameBuffer.getCapacity (), maxFragmentSize, maxAckInterval);
+        this.cReader = nativeConstructor (netManager.getManager (), dataBufferId, ackBufferId, initialFrameBuffer.getData (), initialFrameBuffer.getCapacity (), maxFragmentSize, maxAckInterval, nextFrameBufferSlot);
         if (this.cReader != 0) {
             this.valid = true;
             this.eventListener = theEventListener;
@@ -249,6 +305,21 @@ public class ARStreamReader
         return nativeGetEfficiency (cReader);
     }
 
+    /**
+     * Gets a snapshot of all the reader statistics in a single native call<br>
+     * The buffer is filled from its index 0 and its position is not modified, so
+     * the same buffer can be reused for each poll without any allocation.
+     * Read the fields at the STATS_* offsets, with the native byte order.
+     * @param stats A direct ByteBuffer of at least STATS_SIZE bytes
+     * @return ARSTREAM_OK if the buffer was filled
+     */
+    public ARSTREAM_ERROR_ENUM getStats (ByteBuffer stats) {
+        if ((stats == null) || (!stats.isDirect ()) || (stats.capacity () < STATS_SIZE)) {
+            return ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        return ARSTREAM_ERROR_ENUM.getFromValue (nativeGetStats (cReader, stats));
+    }
+
     /**
      * Adds a new ARStreamFilter to the filter chain (at the end).<br>
      * This function can only be called on non-started instances.
@@ -262,28 +333,105 @@ public class ARStreamReader
         return ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_BAD_PARAMETERS;
     }
 
+    /**
+     * Enables or disables the delivery of incomplete frames.<br>
+     * When enabled, frames which miss some fragments are given to the
+     * listener with the <code>ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE</code>
+     * cause instead of being dropped. Missing parts are zero-filled.<br>
+     * This function can only be called on non-started instances.
+     * @param enable Enable the partial frame delivery.
+     * @param frameTimeoutMs Delay without new fragment before delivering an incomplete frame (0 to only deliver it when a newer frame starts).
+     * @return ARSTREAM_OK if the setting was applied.
+     */
+    public ARSTREAM_ERROR_ENUM setPartialFrameDelivery (boolean enable, int frameTimeoutMs) {
+        return ARSTREAM_ERROR_ENUM.getFromValue(nativeSetPartialFrameDelivery(cReader, enable, frameTimeoutMs));
+    }
+
+    /**
+     * Enables or disables the skipping of non-flush frames after a loss.<br>
+     * When enabled, frames following a lost frame are not given to the
+     * listener until the next flush frame, as they can not be decoded.
+     * The sender is told to stop retrying them.<br>
+     * This function can only be called on non-started instances.
+     * @param enable Enable the skipping.
+     * @return ARSTREAM_OK if the setting was applied.
+     */
+    public ARSTREAM_ERROR_ENUM setSkipUntilFlushFrame (boolean enable) {
+        return ARSTREAM_ERROR_ENUM.getFromValue(nativeSetSkipUntilFlushFrame(cReader, enable));
+    }
+
+    /**
+     * Enables or disables the automatic key frame requests.<br>
+     * When enabled, the reader asks the sender for a key frame when it
+     * starts, and each time a frame is lost. The request is repeated every
+     * minIntervalMs until a flush frame is received.<br>
+     * This function can only be called on non-started instances.
+     * @param enable Enable the automatic requests.
+     * @param minIntervalMs Minimum time between two requests (see DEFAULT_KEY_FRAME_REQUEST_INTERVAL_MS).
+     * @return ARSTREAM_OK if the setting was applied.
+     */
+    public ARSTREAM_ERROR_ENUM setKeyFrameRequests (boolean enable, int minIntervalMs) {
+        return ARSTREAM_ERROR_ENUM.getFromValue(nativeSetKeyFrameRequests(cReader, enable, minIntervalMs));
+    }
+
+    /**
+     * Asks the sender for a key frame (e.g. after a decoding error).<br>
+     * The request is repeated until a flush frame is received. This function
+     * can be called at any time, including from the listener.
+     * @return ARSTREAM_OK if the request was registered.
+     */
+    public ARSTREAM_ERROR_ENUM requestKeyFrame () {
+        return ARSTREAM_ERROR_ENUM.getFromValue(nativeRequestKeyFrame(cReader));
+    }
+
+    /**
+     * Gets the freeze statistics of the reader<br>
+     * The buffer is filled from its index 0 and its position is not modified.
+     * Read the fields at the FREEZE_STATS_* offsets, with the native byte order.
+     * @param stats A direct ByteBuffer of at least FREEZE_STATS_SIZE bytes
+     * @return ARSTREAM_OK if the buffer was filled
+     */
+    public ARSTREAM_ERROR_ENUM getFreezeStats (ByteBuffer stats) {
+        if ((stats == null) || (!stats.isDirect ()) || (stats.capacity () < FREEZE_STATS_SIZE)) {
+            return ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        return ARSTREAM_ERROR_ENUM.getFromValue (nativeGetFreezeStats (cReader, stats));
+    }
+
     /* ***************** */
     /* PRIVATE FUNCTIONS */
     /* ***************** */
 
     /**
-     * Callback wrapper for the listener
+     * Stores the next frame buffer in the slot read by the native callback
+     */
+    private void setNextFrameBuffer (long pointer, int capacity) {
+        nextFrameBufferSlot.putLong (0, pointer);
+        nextFrameBufferSlot.putLong (8, capacity);
+    }
+
+    /**
+     * Callback wrapper for the listener<br>
+     * The next frame buffer is returned through <code>nextFrameBufferSlot</code>
      */
-    private long[] callbackWrapper (int icause, long ndPointer, int ndSize, boolean isFlush, int nbSkip, int newBufferCapacity) {
-        ARSTREAM_READER_CAUSE_ENUM cause = ARSTREAM_READER_CAUSE_ENUM.getFromValue (icause);
+    private void callbackWrapper (int icause, long ndPointer, int ndSize, boolean isFlush, int nbSkip, int newBufferCapacity) {
+        ARSTREAM_READER_CAUSE_ENUM cause = ((icause >= 0) && (icause < CAUSES.length)) ? CAUSES[icause] : null;
         if (cause == null) {
             ARSALPrint.e (TAG, "Bad cause : " + icause);
-            return null;
+            setNextFrameBuffer (0, 0);
+            return;
         }
 
         if ((currentFrameBuffer == null || ndPointer != currentFrameBuffer.getData()) &&
             (previousFrameBuffer == null || ndPointer != previousFrameBuffer.getData())) {
             ARSALPrint.e (TAG, "Bad frame buffer");
-            return null;
+            setNextFrameBuffer (0, 0);
+            return;
         }
 
         switch (cause) {
         case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+        case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
             currentFrameBuffer.setUsedSize(ndSize);
             currentFrameBuffer = eventListener.didUpdateFrameStatus (cause, currentFrameBuffer, isFlush, nbSkip, newBufferCapacity);
             break;
@@ -304,11 +452,9 @@ public class ARStreamReader
             break;
         }
         if (currentFrameBuffer != null) {
-            long retVal[] = { currentFrameBuffer.getData(), currentFrameBuffer.getCapacity() };
-            return retVal;
+            setNextFrameBuffer (currentFrameBuffer.getData(), currentFrameBuffer.getCapacity());
         } else {
-            long retVal[] = { 0, 0 };
-            return retVal;
+            setNextFrameBuffer (0, 0);
         }
     }
 
@@ -321,6 +467,22 @@ public class ARStreamReader
      */
     private native static int nativeGetDefaultMaxAckInterval ();
 
+    /**
+     * Get the size and the number of histogram buckets of ARSTREAM_Reader_Stats_t
+     */
+    private native static int nativeGetStatsSize ();
+    private native static int nativeGetStatsHistogramNbBuckets ();
+
+    /**
+     * Get the size of ARSTREAM_Reader_FreezeStats_t
+     */
+    private native static int nativeGetFreezeStatsSize ();
+
+    /**
+     * Get the default minimum interval between two key frame requests
+     */
+    private native static int nativeGetDefaultKeyFrameRequestInterval ();
+
     /**
      * Sets an ARNetworkIOBufferParams internal values to represent an
      * ARStream data buffer.
@@ -349,9 +511,10 @@ public class ARStreamReader
      * @param frameBufferSize size of the initial frame buffer
      * @param maxFragmentSize Maximum size of the fragment to send
      * @param maxAckInterval Maximum duration without sending an ACK.
+     * @param nextFrameBufferSlot Direct buffer where the callback wrapper stores the next frame buffer
      * @return C-Pointer to the ARSTREAM_Reader object (or null if any error occured)
      */
-    private native long nativeConstructor (long cNetManager, int dataBufferId, int ackBufferId, long frameBuffer, int frameBufferSize, int maxFragmentSize, int maxAckInterval);
+    private native long nativeConstructor (long cNetManager, int dataBufferId, int ackBufferId, long frameBuffer, int frameBufferSize, int maxFragmentSize, int maxAckInterval, ByteBuffer nextFrameBufferSlot);
 
     /**
      * Entry point for the data thread<br>
@@ -385,6 +548,13 @@ public class ARStreamReader
      */
     private native float nativeGetEfficiency (long cReader);
 
+    /**
+     * Copies the reader statistics into a direct buffer
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     * @param stats Direct buffer of at least STATS_SIZE bytes
+     */
+    private native int nativeGetStats (long cReader, ByteBuffer stats);
+
     /**
      * Adds a filter to the Reader
      * @param cReader C-Pointer to the ARSTREAM_Reader C object
@@ -392,6 +562,42 @@ public class ARStreamReader
      */
     private native int nativeAddFilter (long cReader, long cFilter);
 
+    /**
+     * Enables or disables the partial frame delivery
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     * @param enable Enable the partial frame delivery
+     * @param frameTimeoutMs Delay before delivering a timed out incomplete frame
+     */
+    private native int nativeSetPartialFrameDelivery (long cReader, boolean enable, int frameTimeoutMs);
+
+    /**
+     * Enables or disables the skipping of non-flush frames after a loss
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     * @param enable Enable the skipping
+     */
+    private native int nativeSetSkipUntilFlushFrame (long cReader, boolean enable);
+
+    /**
+     * Enables or disables the automatic key frame requests
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     * @param enable Enable the automatic requests
+     * @param minIntervalMs Minimum time between two requests
+     */
+    private native int nativeSetKeyFrameRequests (long cReader, boolean enable, int minIntervalMs);
+
+    /**
+     * Asks the sender for a key frame
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     */
+    private native int nativeRequestKeyFrame (long cReader);
+
+    /**
+     * Copies the reader freeze statistics into a direct buffer
+     * @param cReader C-Pointer to the ARSTREAM_Reader C object
+     * @param stats Direct buffer of at least FREEZE_STATS_SIZE bytes
+     */
+    private native int nativeGetFreezeStats (long cReader, ByteBuffer stats);
+
     /**
      * Initializes global static references in native code
      */
@@ -401,6 +607,11 @@ public class ARStreamReader
     /* STATIC BLOC */
     /* *********** */
     static {
+        for (ARSTREAM_READER_CAUSE_ENUM cause : ARSTREAM_READER_CAUSE_ENUM.values ()) {
+            if ((cause.getValue () >= 0) && (cause.getValue () < CAUSES.length)) {
+                CAUSES[cause.getValue ()] = cause;
+            }
+        }
         nativeInitClass ();
     }
 }
@@ -63,7 +63,12 @@ public interface ARStreamReaderListener
      *    - 'isFlushFrame' is undefined<br>
      *    - 'nbSkippedFrames' in undefined<br>
      *    - 'newBufferCapacity' is undefined<br>
-     *    - Return value is unused and should be null
+     *    - Return value is unused and should be null<br>
+     * <br>
+     * The ARStreamReader does not allocate any Java object per frame. To keep the
+     * decoding path free of garbage, return buffers from a pool allocated once
+     * (and given back to it on frame complete, copy complete and cancel events)
+     * instead of creating a new ARNativeData for each frame.
      * @param cause The event that triggered this call (see global func description)
      * @param currentFrame The frame buffer for the event (see global func description)
      * @param isFlushFrame Indicates if the frame forced a sender flush. This is typically set on I-Frames (see global func description)
@@ -30,8 +30,7 @@
 */
 package com.parrot.arsdk.arstream;
 
-import java.util.Map;
-import java.util.HashMap;
+import java.nio.ByteBuffer;
 
 import com.parrot.arsdk.arsal.ARNativeData;
 import com.parrot.arsdk.arsal.ARSALPrint;
@@ -52,6 +51,11 @@ public class ARStreamSender
 {
     private static final String TAG = ARStreamSender.class.getSimpleName ();
 
+    /**
+     * Sender statuses, indexed by their C value (avoids a boxed lookup per frame)
+     */
+    private static final ARSTREAM_SENDER_STATUS_ENUM[] STATUSES = new ARSTREAM_SENDER_STATUS_ENUM[ARSTREAM_SENDER_STATUS_ENUM.ARSTREAM_SENDER_STATUS_MAX.getValue()];
+
     /* *********************** */
     /* INTERNAL REPRESENTATION */
     /* *********************** */
@@ -62,9 +66,21 @@ public class ARStreamSender
     private long cSender;
 
     /**
-     * Current frames buffer storage
+     * Frames owned by the native sender, indexed by slot.<br>
+     * The slot of a frame is given to native code with the frame, and
+     * given back with its status, so no lookup or boxing is needed.
+     */
+    private ARNativeData[] frameSlots;
+
+    /**
+     * Stack of the free indexes of <code>frameSlots</code>
+     */
+    private int[] freeSlots;
+
+    /**
+     * Number of valid entries in <code>freeSlots</code>
      */
-    private Map<Long, ARNativeData> frames;
+    private int nbFreeSlots;
 
     /**
      * Event listener
@@ -93,6 +109,26 @@ public class ARStreamSender
     public static final int DEFAULT_MAXIUMU_TIME_BETWEEN_RETRIES_MS = nativeGetDefaultMaxTimeBetweenRetries();
     public static final int INFINITE_TIME_BETWEEN_RETRIES = nativeGetInfiniteTimeBetweenRetries();
 
+    /*
+     * Layout of the statistics written by getStats (ARSTREAM_Sender_Stats_t)
+     * All the fields are 32 bits wide, in native byte order (ByteOrder.nativeOrder())
+     */
+    public static final int STATS_SIZE = nativeGetStatsSize();
+    public static final int STATS_HISTOGRAM_NB_BUCKETS = nativeGetStatsHistogramNbBuckets();
+    public static final int STATS_NB_FRAMES_QUEUED = 0;
+    public static final int STATS_NB_FRAMES_QUEUE_FULL = 4;
+    public static final int STATS_NB_FRAMES_ACKED = 8;
+    public static final int STATS_NB_FRAMES_CANCELLED = 12;
+    public static final int STATS_NB_LATE_ACKS = 16;
+    public static final int STATS_NB_FRAGMENTS_SENT = 20;
+    public static final int STATS_NB_FRAGMENTS_RETRIED = 24;
+    public static final int STATS_NB_KEY_FRAME_REQUESTS = 28;
+    public static final int STATS_QUEUE_DEPTH = 32;
+    public static final int STATS_MAX_QUEUE_DEPTH = 36;
+    public static final int STATS_QUEUE_SIZE = 40;
+    public static final int STATS_EFFICIENCY = 44; /* float */
+    public static final int STATS_ACK_TIME_HISTOGRAM = 48; /* STATS_HISTOGRAM_NB_BUCKETS ints, bucket i counts [2^(i-1), 2^i[ ms */
+
     /* **************** */
     /* STATIC FUNCTIONS */
     /* **************** */
@@ -141,12 +177,19 @@ public class ARStreamSender
      */
     public ARStreamSender (ARNetworkManager netManager, int dataBufferId, int ackBufferId, ARStreamSenderListener theEventListener, int frameBufferSize,  int maxFragmentSize, int maxNumberOfFragment)
     {
-        this.cSender = nativeConstructor (netManager.getManager (), dataBufferId, ackBufferId, frameBufferSize, maxFragmentSize, maxNumberOfFragment);
+        // The native sender owns at most the queued frames and the frame being sent.
+        // One more slot covers a flush frame registered before the cancel events of the frames it replaces.
+        int nbSlots = frameBufferSize + 2;
+        this.cSender = nativeConstructor (netManager.getManager (), dataBufferId, ackBufferId, frameBufferSize, maxFragmentSize, maxNumberOfFragment, nbSlots);
         if (this.cSender != 0) {
             this.valid = true;
             this.eventListener = theEventListener;
-            // HashMap will realloc when over 75% of its capacity, so put a greater capacity than needed to avoid that
-            this.frames = new HashMap<Long, ARNativeData> (frameBufferSize * 2);
+            this.frameSlots = new ARNativeData[nbSlots];
+            this.freeSlots = new int[nbSlots];
+            for (int i = 0; i < nbSlots; i++) {
+                this.freeSlots[i] = nbSlots - 1 - i;
+            }
+            this.nbFreeSlots = nbSlots;
             this.dataRunnable = new Runnable () {
                 public void run () {
                     nativeRunDataThread (ARStreamSender.this.cSender);
@@ -250,21 +293,21 @@ public class ARStreamSender
      * @param flush If active, the ARStreamSender will cancel any remaining prevous frame, and start sending this one immediately
      */
     public ARSTREAM_ERROR_ENUM sendNewFrame (ARNativeData frame, boolean flush) {
-        ARSTREAM_ERROR_ENUM err = ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_BAD_PARAMETERS;
+        int slot;
         synchronized (this)
         {
-            frames.put(frame.getData(), frame);
+            if (nbFreeSlots == 0) {
+                return ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_QUEUE_FULL;
+            }
+            slot = freeSlots[--nbFreeSlots];
+            frameSlots[slot] = frame;
         }
-        int intErr = nativeSendNewFrame(cSender, frame.getData(), frame.getDataSize(), flush);
-        err = ARSTREAM_ERROR_ENUM.getFromValue(intErr);
-        if (err != ARSTREAM_ERROR_ENUM.ARSTREAM_OK)
+        int intErr = nativeSendNewFrame(cSender, frame.getData(), frame.getDataSize(), flush, slot);
+        if (intErr != ARSTREAM_ERROR_ENUM.ARSTREAM_OK.getValue())
         {
-            synchronized (this)
-            {
-                frames.remove(frame.getData());
-            }
+            releaseSlot(slot);
         }
-        return err;
+        return ARSTREAM_ERROR_ENUM.getFromValue(intErr);
     }
 
     /**
@@ -304,6 +347,21 @@ public class ARStreamSender
         return nativeGetEfficiency (cSender);
     }
 
+    /**
+     * Gets a snapshot of all the sender statistics in a single native call<br>
+     * The buffer is filled from its index 0 and its position is not modified, so
+     * the same buffer can be reused for each poll without any allocation.
+     * Read the fields at the STATS_* offsets, with the native byte order.
+     * @param stats A direct ByteBuffer of at least STATS_SIZE bytes
+     * @return ARSTREAM_OK if the buffer was filled
+     */
+    public ARSTREAM_ERROR_ENUM getStats (ByteBuffer stats) {
+        if ((stats == null) || (!stats.isDirect ()) || (stats.capacity () < STATS_SIZE)) {
+            return ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        return ARSTREAM_ERROR_ENUM.getFromValue (nativeGetStats (cSender, stats));
+    }
+
     /**
      * Adds a new ARStreamFilter to the filter chain (at the end).<br>
      * This function can only be called on non-started instances.
@@ -321,11 +379,24 @@ public class ARStreamSender
     /* PRIVATE FUNCTIONS */
     /* ***************** */
 
+    /**
+     * Frees a slot, and returns the frame it held
+     */
+    private synchronized ARNativeData releaseSlot (int slot) {
+        ARNativeData data = frameSlots[slot];
+        if (data != null) {
+            frameSlots[slot] = null;
+            freeSlots[nbFreeSlots++] = slot;
+        }
+        return data;
+    }
+
     /**
      * Callback wrapper for the listener
+     * @param slot Slot given with the frame to nativeSendNewFrame (-1 for statuses without frame)
      */
-    private void callbackWrapper (int istatus, long ndPointer, int ndSize) {
-        ARSTREAM_SENDER_STATUS_ENUM status = ARSTREAM_SENDER_STATUS_ENUM.getFromValue (istatus);
+    private void callbackWrapper (int istatus, int slot, int ndSize) {
+        ARSTREAM_SENDER_STATUS_ENUM status = ((istatus >= 0) && (istatus < STATUSES.length)) ? STATUSES[istatus] : null;
         if (status == null) {
             return;
         }
@@ -333,13 +404,21 @@ public class ARStreamSender
             case ARSTREAM_SENDER_STATUS_FRAME_SENT:
             case ARSTREAM_SENDER_STATUS_FRAME_CANCEL:
                 ARNativeData data = null;
-                synchronized (this)
-                {
-                    data = frames.remove (ndPointer);
+                if ((slot >= 0) && (slot < frameSlots.length)) {
+                    data = releaseSlot (slot);
                 }
                 eventListener.didUpdateFrameStatus(status, data);
                 break;
 
+            case ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST:
+                // The native callback gives the reason as the size
+                if (eventListener instanceof ARStreamSenderKeyFrameRequestListener) {
+                    ((ARStreamSenderKeyFrameRequestListener)eventListener).didReceiveKeyFrameRequest(ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_ENUM.getFromValue(ndSize));
+                } else {
+                    eventListener.didUpdateFrameStatus(status, null);
+                }
+                break;
+
             default:
                 ARSALPrint.e (TAG, "Unknown status :" + status);
                 break;
@@ -376,9 +455,10 @@ public class ARStreamSender
      * @param ackBufferId id of the ack buffer to use
      * @param nbFramesToBuffer number of frames that the object can keep in its internal buffer
      * @param maxNumberOfFragment Maximum number of the fragment to send
+     * @param nbSlots Number of frame slots (slots given to nativeSendNewFrame are in [0, nbSlots[)
      * @return C-Pointer to the ARSTREAM_Sender object (or null if any error occured)
      */
-    private native long nativeConstructor (long cNetManager, int dataBufferId, int ackBufferId, int nbFramesToBuffer, int maxFragmentSize, int maxNumberOfFragment);
+    private native long nativeConstructor (long cNetManager, int dataBufferId, int ackBufferId, int nbFramesToBuffer, int maxFragmentSize, int maxNumberOfFragment, int nbSlots);
 
     /**
      * Entry point for the data thread<br>
@@ -412,14 +492,22 @@ public class ARStreamSender
      */
     private native float nativeGetEfficiency (long cSender);
 
+    /**
+     * Copies the sender statistics into a direct buffer
+     * @param cSender C-Pointer to the ARSTREAM_Sender C object
+     * @param stats Direct buffer of at least STATS_SIZE bytes
+     */
+    private native int nativeGetStats (long cSender, ByteBuffer stats);
+
     /**
      * Tries to send a new frame.
      * @param cSender C-Pointer to the ARSTREAM_Sender C object
      * @param frameBuffer The c pointer to the frame.
      * @param frameSize The size in bytes of the frame.
      * @param flushPreviousFrame Whether to flush any queued frames or not.
+     * @param slot Slot of the frame, given back to callbackWrapper with the status of the frame.
      */
-    private native int nativeSendNewFrame (long cSender, long frameBuffer, int frameSize, boolean flushPreviousFrame);
+    private native int nativeSendNewFrame (long cSender, long frameBuffer, int frameSize, boolean flushPreviousFrame, int slot);
 
     /**
      * Flushes the frames queue.
@@ -453,11 +541,18 @@ public class ARStreamSender
     private native static int nativeGetDefaultMinTimeBetweenRetries();
     private native static int nativeGetDefaultMaxTimeBetweenRetries();
     private native static int nativeGetInfiniteTimeBetweenRetries();
+    private native static int nativeGetStatsSize();
+    private native static int nativeGetStatsHistogramNbBuckets();
 
     /* *********** */
     /* STATIC BLOC */
     /* *********** */
     static {
+        for (ARSTREAM_SENDER_STATUS_ENUM status : ARSTREAM_SENDER_STATUS_ENUM.values ()) {
+            if ((status.getValue () >= 0) && (status.getValue () < STATUSES.length)) {
+                STATUSES[status.getValue ()] = status;
+            }
+        }
         nativeInitClass ();
     }
 }
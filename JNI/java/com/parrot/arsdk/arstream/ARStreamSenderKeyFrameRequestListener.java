@@ -0,0 +1,48 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+package com.parrot.arsdk.arstream;
+
+/**
+ * Optional interface for the listener of an ARStreamSender, which receives
+ * the reason of the key frame requests
+ */
+public interface ARStreamSenderKeyFrameRequestListener
+{
+    /**
+     * Called when the reader asks for a key frame. The next frame should be
+     * sent as a flush frame.<br>
+     * When the listener implements this interface, this method is called
+     * instead of didUpdateFrameStatus with the
+     * ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST status.
+     * @param reason Why the reader needs a key frame
+     */
+    public void didReceiveKeyFrameRequest (ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_ENUM reason);
+}
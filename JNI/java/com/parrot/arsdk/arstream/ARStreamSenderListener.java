@@ -38,12 +38,17 @@ import com.parrot.arsdk.arsal.ARNativeData;
 public interface ARStreamSenderListener
 {
     /**
-     * This callback can be called in two different cases:<br>
+     * This callback can be called in three different cases:<br>
      *    - Frame sent:<br>
      *       The frame was successfully sent to the reader<br>
      *    - Frame cancel:<br>
      *       The frame was cancelled before it was acknowledged<br>
-     *       This does not ensure that the frame was not received.
+     *       This does not ensure that the frame was not received.<br>
+     *    - Key frame request:<br>
+     *       The reader asked for a key frame, the next frame should be<br>
+     *       sent as a flush frame. currentFrame is null in this case.<br>
+     *       Listeners which also implement ARStreamSenderKeyFrameRequestListener<br>
+     *       get the reason of the request there instead.
      * @param cause The event that triggered this call (see global func description)
      * @param currentFrame The frame buffer for the event (see global func description)
      */
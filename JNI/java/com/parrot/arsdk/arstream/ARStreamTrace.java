@@ -0,0 +1,168 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+package com.parrot.arsdk.arstream;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Access to the frame lifecycle traces of the ARSTREAM_Sender and ARSTREAM_Reader (see ARSTREAM_Trace.h).<br>
+ * <br>
+ * Events are drained in batches into a caller-provided direct ByteBuffer, so a
+ * dashboard can poll them at a high rate without allocating objects:<br>
+ * <pre>
+ * ByteBuffer events = ByteBuffer.allocateDirect (1024 * ARStreamTrace.EVENT_SIZE).order (ByteOrder.nativeOrder ());
+ * int nb = ARStreamTrace.drain (events);
+ * for (int i = 0; i &lt; nb; i++) {
+ *     int base = i * ARStreamTrace.EVENT_SIZE;
+ *     long timestampNs = events.getLong (base + ARStreamTrace.EVENT_TIMESTAMP_NS);
+ *     int event = events.get (base + ARStreamTrace.EVENT_TYPE);
+ * }
+ * </pre>
+ */
+public class ARStreamTrace
+{
+    /* **************** */
+    /* PUBLIC CONSTANTS */
+    /* **************** */
+
+    /*
+     * Layout of an event written by drain (ARSTREAM_Trace_Event_t), in native byte order (ByteOrder.nativeOrder())
+     */
+    public static final int EVENT_SIZE = nativeGetEventSize();
+    public static final int EVENT_TIMESTAMP_NS = 0; /* long */
+    public static final int EVENT_ARG = 8; /* int, meaning depends on the event type */
+    public static final int EVENT_FRAME_NUMBER = 12; /* unsigned short */
+    public static final int EVENT_TYPE = 14; /* unsigned byte, see getEventName */
+    public static final int EVENT_THREAD_INDEX = 15; /* unsigned byte, see getThreadName */
+
+    /**
+     * Number of event types
+     */
+    public static final int NB_EVENT_TYPES = nativeGetNbEvents();
+
+    /**
+     * Event names, indexed by event type (avoids a native call per event)
+     */
+    private static final String[] EVENT_NAMES = new String[NB_EVENT_TYPES];
+
+    /* **************** */
+    /* STATIC FUNCTIONS */
+    /* **************** */
+
+    /**
+     * Enables or disables the recording of the trace events (disabled by default)
+     * @param enable True to record the events
+     * @return ARSTREAM_OK, or ARSTREAM_ERROR_BAD_PARAMETERS if the library was built without tracepoints
+     */
+    public static ARSTREAM_ERROR_ENUM enable (boolean enable) {
+        return ARSTREAM_ERROR_ENUM.getFromValue (nativeEnable (enable));
+    }
+
+    /**
+     * Sets the number of events of the rings created after this call
+     * @param nbEvents Number of events of a ring, must be a power of two
+     * @return ARSTREAM_OK if the size was set
+     */
+    public static ARSTREAM_ERROR_ENUM setRingSize (int nbEvents) {
+        return ARSTREAM_ERROR_ENUM.getFromValue (nativeSetRingSize (nbEvents));
+    }
+
+    /**
+     * Moves the recorded events to a buffer, in a single native call<br>
+     * The buffer is filled from its index 0 and its position is not modified.
+     * Events which do not fit in the buffer are kept for the next call.
+     * @param events A direct ByteBuffer of at least EVENT_SIZE bytes
+     * @return The number of events written, or -1 on error (bad buffer, or another drain running)
+     */
+    public static int drain (ByteBuffer events) {
+        if ((events == null) || (!events.isDirect ())) {
+            return -1;
+        }
+        return nativeDrain (events);
+    }
+
+    /**
+     * Gets the name of an event type
+     * @param event The EVENT_TYPE field of an event
+     * @return The name (e.g. "SENDER_FRAME_QUEUED"), or "UNKNOWN"
+     */
+    public static String getEventName (int event) {
+        if ((event < 0) || (event >= NB_EVENT_TYPES)) {
+            return "UNKNOWN";
+        }
+        return EVENT_NAMES[event];
+    }
+
+    /**
+     * Gets the name of the thread which recorded an event<br>
+     * This call allocates a new String : the names should be cached by thread index.
+     * @param threadIndex The EVENT_THREAD_INDEX field of an event
+     * @return The name, or null if the index is not valid
+     */
+    public static String getThreadName (int threadIndex) {
+        return nativeGetThreadName (threadIndex);
+    }
+
+    /**
+     * Gets the number of events lost because a ring was full
+     * @return The number of dropped events since the start of the process
+     */
+    public static long getNbDroppedEvents () {
+        return nativeGetNbDroppedEvents ();
+    }
+
+    /* **************** */
+    /* NATIVE FUNCTIONS */
+    /* **************** */
+
+    private native static int nativeGetEventSize ();
+    private native static int nativeGetNbEvents ();
+    private native static String nativeGetEventName (int event);
+    private native static int nativeEnable (boolean enable);
+    private native static int nativeSetRingSize (int nbEvents);
+
+    /**
+     * Drains the trace rings into a direct buffer
+     * @param events Direct buffer of at least EVENT_SIZE bytes
+     */
+    private native static int nativeDrain (ByteBuffer events);
+    private native static String nativeGetThreadName (int threadIndex);
+    private native static long nativeGetNbDroppedEvents ();
+
+    /* *********** */
+    /* STATIC BLOC */
+    /* *********** */
+    static {
+        for (int i = 0; i < NB_EVENT_TYPES; i++) {
+            EVENT_NAMES[i] = nativeGetEventName (i);
+        }
+    }
+}
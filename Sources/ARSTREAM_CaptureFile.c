@@ -0,0 +1,287 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_CaptureFile.c
+ * @brief Capture files of the packets received by a stream reader (see ARSTREAM_Capture.h for the format)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_CaptureFile.h"
+#include "ARSTREAM_Clock.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_CAPTURE_FILE_TAG "ARSTREAM_CaptureFile"
+
+/**
+ * Size of the stdio buffer of the file : the reader data thread only does a system call every few hundred packets
+ */
+#define ARSTREAM_CAPTURE_FILE_BUFFER_SIZE (256 * 1024)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+struct ARSTREAM_CaptureFile_t {
+    FILE *file;
+    char *fileBuffer;
+    uint64_t startTimeUs;
+    uint64_t lastTimeUs;
+    int hasFailed;
+
+    /* Written by the capturing thread only, read with atomics by ARSTREAM_CaptureFile_GetStats */
+    ARSTREAM_Capture_Stats_t stats;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Gets the current time in microseconds
+ */
+static uint64_t ARSTREAM_CaptureFile_GetTimeUs (void);
+
+/**
+ * @brief Encodes an unsigned LEB128 varint
+ * @return The number of bytes written (at most ARSTREAM_CAPTURE_FILE_MAX_VARINT_SIZE)
+ */
+static size_t ARSTREAM_CaptureFile_WriteVarint (uint8_t *data, uint64_t value);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_CaptureFile_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static size_t ARSTREAM_CaptureFile_WriteVarint (uint8_t *data, uint64_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        data [size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    data [size++] = (uint8_t)value;
+    return size;
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_CaptureFile_t* ARSTREAM_CaptureFile_New (const char *path, uint32_t maxPacketSize, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_CaptureFile_t *retCapture = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    uint8_t header [ARSTREAM_CAPTURE_FILE_HEADER_SIZE];
+
+    /* ARGS Check */
+    if (path == NULL)
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retCapture;
+    }
+
+    retCapture = calloc (1, sizeof (ARSTREAM_CaptureFile_t));
+    if (retCapture == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        retCapture->fileBuffer = malloc (ARSTREAM_CAPTURE_FILE_BUFFER_SIZE);
+        if (retCapture->fileBuffer == NULL)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        retCapture->file = fopen (path, "wb");
+        if (retCapture->file == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CAPTURE_FILE_TAG, "Unable to create %s : %s", path, strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        setvbuf (retCapture->file, retCapture->fileBuffer, _IOFBF, ARSTREAM_CAPTURE_FILE_BUFFER_SIZE);
+        memset (header, 0, sizeof (header));
+        memcpy (header, ARSTREAM_CAPTURE_MAGIC, ARSTREAM_CAPTURE_FILE_MAGIC_SIZE);
+        header [8] = (uint8_t)(maxPacketSize);
+        header [9] = (uint8_t)(maxPacketSize >> 8);
+        header [10] = (uint8_t)(maxPacketSize >> 16);
+        header [11] = (uint8_t)(maxPacketSize >> 24);
+        if (fwrite (header, sizeof (header), 1, retCapture->file) != 1)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CAPTURE_FILE_TAG, "Unable to write the header of %s", path);
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        retCapture->startTimeUs = ARSTREAM_CaptureFile_GetTimeUs ();
+        retCapture->lastTimeUs = retCapture->startTimeUs;
+    }
+    else if (retCapture != NULL)
+    {
+        if (retCapture->file != NULL)
+        {
+            fclose (retCapture->file);
+        }
+        free (retCapture->fileBuffer);
+        free (retCapture);
+        retCapture = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retCapture;
+}
+
+void ARSTREAM_CaptureFile_Write (ARSTREAM_CaptureFile_t *capture, const uint8_t *packet, uint32_t size)
+{
+    uint8_t recordHeader [2 * ARSTREAM_CAPTURE_FILE_MAX_VARINT_SIZE];
+    size_t recordHeaderSize;
+    uint64_t nowUs;
+
+    if ((capture == NULL) ||
+        (capture->hasFailed != 0))
+    {
+        return;
+    }
+
+    nowUs = ARSTREAM_CaptureFile_GetTimeUs ();
+    recordHeaderSize = ARSTREAM_CaptureFile_WriteVarint (recordHeader, nowUs - capture->lastTimeUs);
+    recordHeaderSize += ARSTREAM_CaptureFile_WriteVarint (&recordHeader [recordHeaderSize], size);
+    capture->lastTimeUs = nowUs;
+
+    if ((fwrite (recordHeader, 1, recordHeaderSize, capture->file) != recordHeaderSize) ||
+        (fwrite (packet, 1, size, capture->file) != size))
+    {
+        // Stop there : a partial record would corrupt the rest of the file
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CAPTURE_FILE_TAG, "Capture write error : %s, capture stopped", strerror (errno));
+        capture->hasFailed = 1;
+        __atomic_store_n (&(capture->stats.nbErrors), capture->stats.nbErrors + 1, __ATOMIC_RELAXED);
+        return;
+    }
+    __atomic_store_n (&(capture->stats.nbPackets), capture->stats.nbPackets + 1, __ATOMIC_RELAXED);
+    __atomic_store_n (&(capture->stats.nbBytes), capture->stats.nbBytes + size, __ATOMIC_RELAXED);
+    __atomic_store_n (&(capture->stats.durationUs), nowUs - capture->startTimeUs, __ATOMIC_RELAXED);
+}
+
+void ARSTREAM_CaptureFile_GetStats (ARSTREAM_CaptureFile_t *capture, ARSTREAM_Capture_Stats_t *stats)
+{
+    if ((capture != NULL) &&
+        (stats != NULL))
+    {
+        memset (stats, 0, sizeof (ARSTREAM_Capture_Stats_t));
+        stats->nbPackets = __atomic_load_n (&(capture->stats.nbPackets), __ATOMIC_RELAXED);
+        stats->nbBytes = __atomic_load_n (&(capture->stats.nbBytes), __ATOMIC_RELAXED);
+        stats->durationUs = __atomic_load_n (&(capture->stats.durationUs), __ATOMIC_RELAXED);
+        stats->nbErrors = __atomic_load_n (&(capture->stats.nbErrors), __ATOMIC_RELAXED);
+    }
+}
+
+void ARSTREAM_CaptureFile_Delete (ARSTREAM_CaptureFile_t **capture)
+{
+    if ((capture != NULL) &&
+        (*capture != NULL))
+    {
+        if (fclose ((*capture)->file) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CAPTURE_FILE_TAG, "Capture flush error : %s", strerror (errno));
+        }
+        free ((*capture)->fileBuffer);
+        free (*capture);
+        *capture = NULL;
+    }
+}
+
+size_t ARSTREAM_CaptureFile_ReadVarint (const uint8_t *data, size_t size, uint64_t *value)
+{
+    uint64_t result = 0;
+    size_t index;
+    for (index = 0; (index < size) && (index < ARSTREAM_CAPTURE_FILE_MAX_VARINT_SIZE); index++)
+    {
+        result |= (uint64_t)(data [index] & 0x7F) << (7 * index);
+        if ((data [index] & 0x80) == 0)
+        {
+            *value = result;
+            return index + 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_CaptureFile.h
+ * @brief Capture files of the packets received by a stream reader (see ARSTREAM_Capture.h for the format)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_CAPTURE_FILE_PRIVATE_H_
+#define _ARSTREAM_CAPTURE_FILE_PRIVATE_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+#include <stddef.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Capture.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * Size of the file header
+ */
+#define ARSTREAM_CAPTURE_FILE_HEADER_SIZE (16)
+
+/**
+ * Size of the magic number at the start of the file header
+ */
+#define ARSTREAM_CAPTURE_FILE_MAGIC_SIZE (8)
+
+/**
+ * Maximum size of a LEB128 encoded 64 bits value
+ */
+#define ARSTREAM_CAPTURE_FILE_MAX_VARINT_SIZE (10)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief A capture file being written
+ */
+typedef struct ARSTREAM_CaptureFile_t ARSTREAM_CaptureFile_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates (or truncates) a capture file and writes its header
+ * @param path Path of the file
+ * @param maxPacketSize Maximum size of the captured packets
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return The new capture, or NULL on error
+ */
+ARSTREAM_CaptureFile_t* ARSTREAM_CaptureFile_New (const char *path, uint32_t maxPacketSize, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Appends a received packet to the capture
+ * Records are buffered, the file is only written when the buffer is full.
+ * @param capture The capture
+ * @param packet The packet, as received
+ * @param size The packet size
+ * @warning Must always be called from the same thread
+ */
+void ARSTREAM_CaptureFile_Write (ARSTREAM_CaptureFile_t *capture, const uint8_t *packet, uint32_t size);
+
+/**
+ * @brief Gets the statistics of a capture (can be called from any thread)
+ * @param capture The capture
+ * @param stats Pointer to the structure to fill
+ */
+void ARSTREAM_CaptureFile_GetStats (ARSTREAM_CaptureFile_t *capture, ARSTREAM_Capture_Stats_t *stats);
+
+/**
+ * @brief Flushes and closes a capture file
+ * @param capture Pointer to the capture to delete, set to NULL after deletion
+ */
+void ARSTREAM_CaptureFile_Delete (ARSTREAM_CaptureFile_t **capture);
+
+/**
+ * @brief Decodes an unsigned LEB128 varint
+ * @param data The encoded data
+ * @param size The number of bytes available in data
+ * @param value Pointer which will hold the value
+ * @return The number of bytes used, or 0 if the varint is truncated or longer than 64 bits
+ */
+size_t ARSTREAM_CaptureFile_ReadVarint (const uint8_t *data, size_t size, uint64_t *value);
+
+#endif /* _ARSTREAM_CAPTURE_FILE_PRIVATE_H_ */
@@ -0,0 +1,656 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_CipherFilter.c
+ * @brief ChaCha20 encryption filter for the ARSTREAM_Sender / ARSTREAM_Reader filter chains
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_CipherFilter.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_CIPHER_FILTER_TAG "ARSTREAM_CipherFilter"
+
+/* Source of the initial nonce of the encryption side */
+#define ARSTREAM_CIPHER_FILTER_RANDOM_DEVICE "/dev/urandom"
+/* Pool buffers are allocated by steps of this size, so that growing frames do not realloc each time */
+#define ARSTREAM_CIPHER_FILTER_BUFFER_ROUNDING (4096)
+/* Upper bound of the pool. Reaching it means that some buffers are never released */
+#define ARSTREAM_CIPHER_FILTER_MAX_BUFFERS (64)
+
+#define ARSTREAM_CIPHER_FILTER_BLOCK_SIZE (64)
+
+/*
+ * 4-blocks vector implementation, unless ARSTREAM_CIPHER_FILTER_NO_SIMD is defined
+ * Both implementations work on little endian 32 bits lanes, as the scalar one.
+ */
+#if !defined (ARSTREAM_CIPHER_FILTER_NO_SIMD) && (defined (__ARM_NEON) || defined (__ARM_NEON__)) && !defined (__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define ARSTREAM_CIPHER_FILTER_IMPLEMENTATION "neon"
+#define ARSTREAM_CIPHER_FILTER_HAS_VEC (1)
+#define ARSTREAM_CIPHER_FILTER_HAS_NEON (1)
+typedef uint32x4_t ARSTREAM_CipherFilter_Vec_t;
+#define CHACHA_VEC_ADD(A,B) vaddq_u32 ((A), (B))
+#define CHACHA_VEC_XOR(A,B) veorq_u32 ((A), (B))
+#define CHACHA_VEC_ROTL(V,N) vsriq_n_u32 (vshlq_n_u32 ((V), (N)), (V), 32 - (N))
+#define CHACHA_VEC_SET1(X) vdupq_n_u32 ((X))
+#define CHACHA_VEC_LOAD(P) vreinterpretq_u32_u8 (vld1q_u8 ((const uint8_t *)(P)))
+#define CHACHA_VEC_STORE(P,V) vst1q_u8 ((uint8_t *)(P), vreinterpretq_u8_u32 ((V)))
+#elif !defined (ARSTREAM_CIPHER_FILTER_NO_SIMD) && defined (__SSE2__)
+#include <emmintrin.h>
+#define ARSTREAM_CIPHER_FILTER_IMPLEMENTATION "sse2"
+#define ARSTREAM_CIPHER_FILTER_HAS_VEC (1)
+#define ARSTREAM_CIPHER_FILTER_HAS_NEON (0)
+typedef __m128i ARSTREAM_CipherFilter_Vec_t;
+#define CHACHA_VEC_ADD(A,B) _mm_add_epi32 ((A), (B))
+#define CHACHA_VEC_XOR(A,B) _mm_xor_si128 ((A), (B))
+#define CHACHA_VEC_ROTL(V,N) _mm_or_si128 (_mm_slli_epi32 ((V), (N)), _mm_srli_epi32 ((V), 32 - (N)))
+#define CHACHA_VEC_SET1(X) _mm_set1_epi32 ((int)(X))
+#define CHACHA_VEC_LOAD(P) _mm_loadu_si128 ((const __m128i *)(P))
+#define CHACHA_VEC_STORE(P,V) _mm_storeu_si128 ((__m128i *)(P), (V))
+#else
+#define ARSTREAM_CIPHER_FILTER_IMPLEMENTATION "c"
+#define ARSTREAM_CIPHER_FILTER_HAS_VEC (0)
+#define ARSTREAM_CIPHER_FILTER_HAS_NEON (0)
+#endif
+
+#define CHACHA_ROTL(V,N) (((V) << (N)) | ((V) >> (32 - (N))))
+
+#define CHACHA_QUARTERROUND(A,B,C,D)            \
+    do                                          \
+    {                                           \
+        A += B; D ^= A; D = CHACHA_ROTL (D, 16);  \
+        C += D; B ^= C; B = CHACHA_ROTL (B, 12);  \
+        A += B; D ^= A; D = CHACHA_ROTL (D, 8);   \
+        C += D; B ^= C; B = CHACHA_ROTL (B, 7);   \
+    } while (0)
+
+#define CHACHA_VEC_QUARTERROUND(A,B,C,D)                                            \
+    do                                                                              \
+    {                                                                               \
+        A = CHACHA_VEC_ADD (A, B); D = CHACHA_VEC_XOR (D, A); D = CHACHA_VEC_ROTL (D, 16); \
+        C = CHACHA_VEC_ADD (C, D); B = CHACHA_VEC_XOR (B, C); B = CHACHA_VEC_ROTL (B, 12); \
+        A = CHACHA_VEC_ADD (A, B); D = CHACHA_VEC_XOR (D, A); D = CHACHA_VEC_ROTL (D, 8);  \
+        C = CHACHA_VEC_ADD (C, D); B = CHACHA_VEC_XOR (B, C); B = CHACHA_VEC_ROTL (B, 7);  \
+    } while (0)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    uint8_t *buffer;
+    int capacity;
+    int isUsed;
+} ARSTREAM_CipherFilter_Buffer_t;
+
+struct ARSTREAM_CipherFilter_t {
+    /* Configuration on New */
+    eARSTREAM_CIPHER_FILTER_MODE mode;
+    uint32_t key [8];
+    ARSTREAM_Filter_t filter;
+
+    /* Next nonce of the encryption side, atomically incremented */
+    uint64_t nextNonce;
+
+    /* Output buffers pool (released from the sender ack thread, or from the reader data thread) */
+    ARSAL_Mutex_t poolMutex;
+    ARSTREAM_CipherFilter_Buffer_t *pool;
+    int poolSize;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Reads a little endian 32 bits word
+ */
+static inline uint32_t ARSTREAM_CipherFilter_Load32 (const uint8_t *p);
+
+/**
+ * @brief Writes a little endian 32 bits word
+ */
+static inline void ARSTREAM_CipherFilter_Store32 (uint8_t *p, uint32_t v);
+
+/**
+ * @brief Initializes a ChaCha20 state (constants, key, counter and nonce)
+ */
+static void ARSTREAM_CipherFilter_InitState (uint32_t state[16], const uint32_t key[8], uint32_t counter, const uint8_t *nonce);
+
+/**
+ * @brief XORs size bytes of input with the keystream of state into output
+ * state[12] (the block counter) is advanced by the number of blocks used
+ */
+static void ARSTREAM_CipherFilter_Xor (uint32_t state[16], const uint8_t *input, uint8_t *output, size_t size);
+
+#if ARSTREAM_CIPHER_FILTER_HAS_VEC
+/**
+ * @brief XORs 4 full blocks (256 bytes) of input with the keystream of the blocks state[12] to state[12] + 3
+ */
+static void ARSTREAM_CipherFilter_Xor4Blocks (const uint32_t state[16], const uint8_t *input, uint8_t *output);
+#endif
+
+/**
+ * @brief ARSTREAM_Filter_t callbacks
+ */
+static uint8_t* ARSTREAM_CipherFilter_GetBuffer (void *context, int size);
+static int ARSTREAM_CipherFilter_GetOutputSize (void *context, int inputSize);
+static int ARSTREAM_CipherFilter_FilterBuffer (void *context, uint8_t *input, int inSize, uint8_t *output, int outSize);
+static void ARSTREAM_CipherFilter_ReleaseBuffer (void *context, uint8_t *buffer);
+
+/*
+ * Internal functions implementation
+ */
+
+static inline uint32_t ARSTREAM_CipherFilter_Load32 (const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void ARSTREAM_CipherFilter_Store32 (uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void ARSTREAM_CipherFilter_InitState (uint32_t state[16], const uint32_t key[8], uint32_t counter, const uint8_t *nonce)
+{
+    /* "expand 32-byte k" */
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    memcpy (&state[4], key, 8 * sizeof (uint32_t));
+    state[12] = counter;
+    state[13] = ARSTREAM_CipherFilter_Load32 (&nonce[0]);
+    state[14] = ARSTREAM_CipherFilter_Load32 (&nonce[4]);
+    state[15] = ARSTREAM_CipherFilter_Load32 (&nonce[8]);
+}
+
+#if ARSTREAM_CIPHER_FILTER_HAS_VEC
+static void ARSTREAM_CipherFilter_Xor4Blocks (const uint32_t state[16], const uint8_t *input, uint8_t *output)
+{
+    /* One vector per state word, one lane per block */
+    ARSTREAM_CipherFilter_Vec_t s[16], x[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        s[i] = CHACHA_VEC_SET1 (state[i]);
+    }
+#if ARSTREAM_CIPHER_FILTER_HAS_NEON
+    {
+        static const uint32_t lanes[4] = { 0, 1, 2, 3 };
+        s[12] = vaddq_u32 (s[12], vld1q_u32 (lanes));
+    }
+#else
+    s[12] = _mm_add_epi32 (s[12], _mm_set_epi32 (3, 2, 1, 0));
+#endif
+    memcpy (x, s, sizeof (x));
+
+    for (i = 0; i < 10; i++)
+    {
+        CHACHA_VEC_QUARTERROUND (x[0], x[4], x[8], x[12]);
+        CHACHA_VEC_QUARTERROUND (x[1], x[5], x[9], x[13]);
+        CHACHA_VEC_QUARTERROUND (x[2], x[6], x[10], x[14]);
+        CHACHA_VEC_QUARTERROUND (x[3], x[7], x[11], x[15]);
+        CHACHA_VEC_QUARTERROUND (x[0], x[5], x[10], x[15]);
+        CHACHA_VEC_QUARTERROUND (x[1], x[6], x[11], x[12]);
+        CHACHA_VEC_QUARTERROUND (x[2], x[7], x[8], x[13]);
+        CHACHA_VEC_QUARTERROUND (x[3], x[4], x[9], x[14]);
+    }
+
+    /* Transpose each group of 4 words, so that each vector holds 16 consecutive bytes of one block */
+    for (i = 0; i < 16; i += 4)
+    {
+        ARSTREAM_CipherFilter_Vec_t r0, r1, r2, r3;
+        ARSTREAM_CipherFilter_Vec_t a = CHACHA_VEC_ADD (x[i], s[i]);
+        ARSTREAM_CipherFilter_Vec_t b = CHACHA_VEC_ADD (x[i + 1], s[i + 1]);
+        ARSTREAM_CipherFilter_Vec_t c = CHACHA_VEC_ADD (x[i + 2], s[i + 2]);
+        ARSTREAM_CipherFilter_Vec_t d = CHACHA_VEC_ADD (x[i + 3], s[i + 3]);
+#if ARSTREAM_CIPHER_FILTER_HAS_NEON
+        uint32x4x2_t ab = vtrnq_u32 (a, b);
+        uint32x4x2_t cd = vtrnq_u32 (c, d);
+        r0 = vcombine_u32 (vget_low_u32 (ab.val[0]), vget_low_u32 (cd.val[0]));
+        r1 = vcombine_u32 (vget_low_u32 (ab.val[1]), vget_low_u32 (cd.val[1]));
+        r2 = vcombine_u32 (vget_high_u32 (ab.val[0]), vget_high_u32 (cd.val[0]));
+        r3 = vcombine_u32 (vget_high_u32 (ab.val[1]), vget_high_u32 (cd.val[1]));
+#else
+        __m128i t0 = _mm_unpacklo_epi32 (a, b);
+        __m128i t1 = _mm_unpacklo_epi32 (c, d);
+        __m128i t2 = _mm_unpackhi_epi32 (a, b);
+        __m128i t3 = _mm_unpackhi_epi32 (c, d);
+        r0 = _mm_unpacklo_epi64 (t0, t1);
+        r1 = _mm_unpackhi_epi64 (t0, t1);
+        r2 = _mm_unpacklo_epi64 (t2, t3);
+        r3 = _mm_unpackhi_epi64 (t2, t3);
+#endif
+        CHACHA_VEC_STORE (&output[4 * i], CHACHA_VEC_XOR (r0, CHACHA_VEC_LOAD (&input[4 * i])));
+        CHACHA_VEC_STORE (&output[64 + 4 * i], CHACHA_VEC_XOR (r1, CHACHA_VEC_LOAD (&input[64 + 4 * i])));
+        CHACHA_VEC_STORE (&output[128 + 4 * i], CHACHA_VEC_XOR (r2, CHACHA_VEC_LOAD (&input[128 + 4 * i])));
+        CHACHA_VEC_STORE (&output[192 + 4 * i], CHACHA_VEC_XOR (r3, CHACHA_VEC_LOAD (&input[192 + 4 * i])));
+    }
+}
+#endif
+
+static void ARSTREAM_CipherFilter_Xor (uint32_t state[16], const uint8_t *input, uint8_t *output, size_t size)
+{
+    uint32_t x[16];
+    uint8_t keystream [ARSTREAM_CIPHER_FILTER_BLOCK_SIZE];
+    size_t blockSize, j;
+    int i;
+
+#if ARSTREAM_CIPHER_FILTER_HAS_VEC
+    while (size >= 4 * ARSTREAM_CIPHER_FILTER_BLOCK_SIZE)
+    {
+        ARSTREAM_CipherFilter_Xor4Blocks (state, input, output);
+        state[12] += 4;
+        input += 4 * ARSTREAM_CIPHER_FILTER_BLOCK_SIZE;
+        output += 4 * ARSTREAM_CIPHER_FILTER_BLOCK_SIZE;
+        size -= 4 * ARSTREAM_CIPHER_FILTER_BLOCK_SIZE;
+    }
+#endif
+
+    while (size > 0)
+    {
+        memcpy (x, state, sizeof (x));
+        for (i = 0; i < 10; i++)
+        {
+            CHACHA_QUARTERROUND (x[0], x[4], x[8], x[12]);
+            CHACHA_QUARTERROUND (x[1], x[5], x[9], x[13]);
+            CHACHA_QUARTERROUND (x[2], x[6], x[10], x[14]);
+            CHACHA_QUARTERROUND (x[3], x[7], x[11], x[15]);
+            CHACHA_QUARTERROUND (x[0], x[5], x[10], x[15]);
+            CHACHA_QUARTERROUND (x[1], x[6], x[11], x[12]);
+            CHACHA_QUARTERROUND (x[2], x[7], x[8], x[13]);
+            CHACHA_QUARTERROUND (x[3], x[4], x[9], x[14]);
+        }
+        blockSize = (size < ARSTREAM_CIPHER_FILTER_BLOCK_SIZE) ? size : ARSTREAM_CIPHER_FILTER_BLOCK_SIZE;
+        if (blockSize == ARSTREAM_CIPHER_FILTER_BLOCK_SIZE)
+        {
+            for (i = 0; i < 16; i++)
+            {
+                ARSTREAM_CipherFilter_Store32 (&output[4 * i], ARSTREAM_CipherFilter_Load32 (&input[4 * i]) ^ (x[i] + state[i]));
+            }
+        }
+        else
+        {
+            for (i = 0; i < 16; i++)
+            {
+                ARSTREAM_CipherFilter_Store32 (&keystream[4 * i], x[i] + state[i]);
+            }
+            for (j = 0; j < blockSize; j++)
+            {
+                output[j] = input[j] ^ keystream[j];
+            }
+        }
+        state[12]++;
+        input += blockSize;
+        output += blockSize;
+        size -= blockSize;
+    }
+}
+
+static uint8_t* ARSTREAM_CipherFilter_GetBuffer (void *context, int size)
+{
+    ARSTREAM_CipherFilter_t *cipherFilter = (ARSTREAM_CipherFilter_t *)context;
+    ARSTREAM_CipherFilter_Buffer_t *entry = NULL;
+    uint8_t *retBuffer = NULL;
+    int capacity;
+    int i;
+
+    if (size < 0)
+    {
+        return NULL;
+    }
+    capacity = ((size / ARSTREAM_CIPHER_FILTER_BUFFER_ROUNDING) + 1) * ARSTREAM_CIPHER_FILTER_BUFFER_ROUNDING;
+
+    ARSAL_Mutex_Lock (&(cipherFilter->poolMutex));
+    /* Prefer a free buffer which is already large enough, else grow any free buffer */
+    for (i = 0; i < cipherFilter->poolSize; i++)
+    {
+        if (cipherFilter->pool[i].isUsed == 0)
+        {
+            if ((entry == NULL) ||
+                (cipherFilter->pool[i].capacity >= size))
+            {
+                entry = &(cipherFilter->pool[i]);
+            }
+            if (entry->capacity >= size)
+            {
+                break;
+            }
+        }
+    }
+    if ((entry == NULL) &&
+        (cipherFilter->poolSize < ARSTREAM_CIPHER_FILTER_MAX_BUFFERS))
+    {
+        ARSTREAM_CipherFilter_Buffer_t *newPool = realloc (cipherFilter->pool, (cipherFilter->poolSize + 1) * sizeof (ARSTREAM_CipherFilter_Buffer_t));
+        if (newPool != NULL)
+        {
+            cipherFilter->pool = newPool;
+            entry = &(cipherFilter->pool[cipherFilter->poolSize++]);
+            entry->buffer = NULL;
+            entry->capacity = 0;
+            entry->isUsed = 0;
+        }
+    }
+    if ((entry != NULL) &&
+        (entry->capacity < size))
+    {
+        uint8_t *newBuffer = realloc (entry->buffer, capacity);
+        if (newBuffer != NULL)
+        {
+            entry->buffer = newBuffer;
+            entry->capacity = capacity;
+        }
+    }
+    if ((entry != NULL) &&
+        (entry->buffer != NULL) &&
+        (entry->capacity >= size))
+    {
+        entry->isUsed = 1;
+        retBuffer = entry->buffer;
+    }
+    ARSAL_Mutex_Unlock (&(cipherFilter->poolMutex));
+
+    if (retBuffer == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CIPHER_FILTER_TAG, "Unable to get a %d bytes buffer (%d buffers in the pool)", size, cipherFilter->poolSize);
+    }
+    return retBuffer;
+}
+
+static int ARSTREAM_CipherFilter_GetOutputSize (void *context, int inputSize)
+{
+    ARSTREAM_CipherFilter_t *cipherFilter = (ARSTREAM_CipherFilter_t *)context;
+    if (cipherFilter->mode == ARSTREAM_CIPHER_FILTER_MODE_ENCRYPT)
+    {
+        return inputSize + ARSTREAM_CIPHER_FILTER_NONCE_SIZE;
+    }
+    /* Exact size, so that the reader does not ask the application for a larger buffer than the decrypted frame. Partial frames may be shorter than the nonce */
+    return (inputSize > ARSTREAM_CIPHER_FILTER_NONCE_SIZE) ? inputSize - ARSTREAM_CIPHER_FILTER_NONCE_SIZE : 0;
+}
+
+static int ARSTREAM_CipherFilter_FilterBuffer (void *context, uint8_t *input, int inSize, uint8_t *output, int outSize)
+{
+    ARSTREAM_CipherFilter_t *cipherFilter = (ARSTREAM_CipherFilter_t *)context;
+    uint8_t nonce [12] = { 0 };
+    uint32_t state[16];
+    uint64_t frameNonce;
+    int retVal = 0;
+
+    if (cipherFilter->mode == ARSTREAM_CIPHER_FILTER_MODE_ENCRYPT)
+    {
+        if ((inSize < 0) ||
+            (outSize < inSize + ARSTREAM_CIPHER_FILTER_NONCE_SIZE))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CIPHER_FILTER_TAG, "Output buffer too small (%d bytes for a %d bytes frame)", outSize, inSize);
+            return 0;
+        }
+        frameNonce = __atomic_fetch_add (&(cipherFilter->nextNonce), 1, __ATOMIC_RELAXED);
+        ARSTREAM_CipherFilter_Store32 (&output[0], (uint32_t)frameNonce);
+        ARSTREAM_CipherFilter_Store32 (&output[4], (uint32_t)(frameNonce >> 32));
+        memcpy (&nonce[4], output, ARSTREAM_CIPHER_FILTER_NONCE_SIZE);
+        ARSTREAM_CipherFilter_InitState (state, cipherFilter->key, 0, nonce);
+        ARSTREAM_CipherFilter_Xor (state, input, &output[ARSTREAM_CIPHER_FILTER_NONCE_SIZE], inSize);
+        retVal = inSize + ARSTREAM_CIPHER_FILTER_NONCE_SIZE;
+    }
+    else
+    {
+        if ((inSize < ARSTREAM_CIPHER_FILTER_NONCE_SIZE) ||
+            (outSize < inSize - ARSTREAM_CIPHER_FILTER_NONCE_SIZE))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CIPHER_FILTER_TAG, "Bad encrypted frame (%d bytes, %d bytes output buffer)", inSize, outSize);
+            return 0;
+        }
+        memcpy (&nonce[4], input, ARSTREAM_CIPHER_FILTER_NONCE_SIZE);
+        ARSTREAM_CipherFilter_InitState (state, cipherFilter->key, 0, nonce);
+        ARSTREAM_CipherFilter_Xor (state, &input[ARSTREAM_CIPHER_FILTER_NONCE_SIZE], output, inSize - ARSTREAM_CIPHER_FILTER_NONCE_SIZE);
+        retVal = inSize - ARSTREAM_CIPHER_FILTER_NONCE_SIZE;
+    }
+    return retVal;
+}
+
+static void ARSTREAM_CipherFilter_ReleaseBuffer (void *context, uint8_t *buffer)
+{
+    ARSTREAM_CipherFilter_t *cipherFilter = (ARSTREAM_CipherFilter_t *)context;
+    int found = 0;
+    int i;
+
+    /* The reader releases its initial (NULL) frame buffer on the first fragment */
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    ARSAL_Mutex_Lock (&(cipherFilter->poolMutex));
+    for (i = 0; i < cipherFilter->poolSize; i++)
+    {
+        if (cipherFilter->pool[i].buffer == buffer)
+        {
+            cipherFilter->pool[i].isUsed = 0;
+            found = 1;
+            break;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(cipherFilter->poolMutex));
+
+    if (found == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CIPHER_FILTER_TAG, "Released buffer %p does not belong to the filter", buffer);
+    }
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_CipherFilter_t* ARSTREAM_CipherFilter_New (const uint8_t *key, eARSTREAM_CIPHER_FILTER_MODE mode, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_CipherFilter_t *retFilter = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    int mutexWasInit = 0;
+    int i;
+
+    /* ARGS Check */
+    if ((key == NULL) ||
+        (mode < 0) ||
+        (mode >= ARSTREAM_CIPHER_FILTER_MODE_MAX))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return NULL;
+    }
+
+    /* Alloc new filter */
+    retFilter = calloc (1, sizeof (ARSTREAM_CipherFilter_t));
+    if (retFilter == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Copy parameters */
+    if (internalError == ARSTREAM_OK)
+    {
+        retFilter->mode = mode;
+        for (i = 0; i < 8; i++)
+        {
+            retFilter->key[i] = ARSTREAM_CipherFilter_Load32 (&key[4 * i]);
+        }
+        retFilter->filter.getBuffer = ARSTREAM_CipherFilter_GetBuffer;
+        retFilter->filter.getOutputSize = ARSTREAM_CipherFilter_GetOutputSize;
+        retFilter->filter.filterBuffer = ARSTREAM_CipherFilter_FilterBuffer;
+        retFilter->filter.releaseBuffer = ARSTREAM_CipherFilter_ReleaseBuffer;
+        retFilter->filter.context = retFilter;
+    }
+
+    /* Draw the first nonce : a (key, nonce) pair must never be used twice */
+    if ((internalError == ARSTREAM_OK) &&
+        (mode == ARSTREAM_CIPHER_FILTER_MODE_ENCRYPT))
+    {
+        FILE *random = fopen (ARSTREAM_CIPHER_FILTER_RANDOM_DEVICE, "rb");
+        if ((random == NULL) ||
+            (fread (&(retFilter->nextNonce), sizeof (uint64_t), 1, random) != 1))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_CIPHER_FILTER_TAG, "Unable to read a random nonce from %s", ARSTREAM_CIPHER_FILTER_RANDOM_DEVICE);
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        if (random != NULL)
+        {
+            fclose (random);
+        }
+    }
+
+    /* Setup internal mutexes */
+    if (internalError == ARSTREAM_OK)
+    {
+        if (ARSAL_Mutex_Init (&(retFilter->poolMutex)) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            mutexWasInit = 1;
+        }
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retFilter != NULL))
+    {
+        if (mutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retFilter->poolMutex));
+        }
+        memset (retFilter->key, 0, sizeof (retFilter->key));
+        free (retFilter);
+        retFilter = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retFilter;
+}
+
+eARSTREAM_ERROR ARSTREAM_CipherFilter_Delete (ARSTREAM_CipherFilter_t **cipherFilter)
+{
+    int i;
+
+    if ((cipherFilter == NULL) ||
+        (*cipherFilter == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    for (i = 0; i < (*cipherFilter)->poolSize; i++)
+    {
+        /* A stopped sender keeps its last (stop) frame, so one buffer may still be marked as used */
+        if ((*cipherFilter)->pool[i].isUsed != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_CIPHER_FILTER_TAG, "Buffer %p was not released", (*cipherFilter)->pool[i].buffer);
+        }
+        free ((*cipherFilter)->pool[i].buffer);
+    }
+    free ((*cipherFilter)->pool);
+    ARSAL_Mutex_Destroy (&((*cipherFilter)->poolMutex));
+    memset ((*cipherFilter)->key, 0, sizeof ((*cipherFilter)->key));
+    free (*cipherFilter);
+    *cipherFilter = NULL;
+    return ARSTREAM_OK;
+}
+
+ARSTREAM_Filter_t* ARSTREAM_CipherFilter_GetFilter (ARSTREAM_CipherFilter_t *cipherFilter)
+{
+    if (cipherFilter == NULL)
+    {
+        return NULL;
+    }
+    return &(cipherFilter->filter);
+}
+
+void ARSTREAM_CipherFilter_ChaCha20 (const uint8_t *key, const uint8_t *nonce, uint32_t counter, const uint8_t *input, uint8_t *output, size_t size)
+{
+    uint32_t keyWords [8];
+    uint32_t state[16];
+    int i;
+
+    if ((key == NULL) ||
+        (nonce == NULL) ||
+        (input == NULL) ||
+        (output == NULL))
+    {
+        return;
+    }
+    for (i = 0; i < 8; i++)
+    {
+        keyWords[i] = ARSTREAM_CipherFilter_Load32 (&key[4 * i]);
+    }
+    ARSTREAM_CipherFilter_InitState (state, keyWords, counter, nonce);
+    ARSTREAM_CipherFilter_Xor (state, input, output, size);
+}
+
+const char* ARSTREAM_CipherFilter_GetImplementation (void)
+{
+    return ARSTREAM_CIPHER_FILTER_IMPLEMENTATION;
+}
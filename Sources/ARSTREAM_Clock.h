@@ -0,0 +1,106 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Clock.h
+ * @brief Time, waits and threads of the stream sender and reader (real or simulated)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_CLOCK_PRIVATE_H_
+#define _ARSTREAM_CLOCK_PRIVATE_H_
+
+/*
+ * All the timing of the sender, the reader, the loopback transport and the impairment layer
+ * goes through these macros, so the simulation builds (ARSTREAM_SIMULATION=1) can run them
+ * on the virtual clock of ARSTREAM_Simulation.c
+ */
+
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Simulation.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_Clock_GetTime(TS) ARSTREAM_Simulation_GetTime ((TS))
+#define ARSTREAM_Clock_CondWait(COND,MUTEX) ARSTREAM_Simulation_CondWait ((COND), (MUTEX))
+#define ARSTREAM_Clock_CondTimedwait(COND,MUTEX,TIMEOUT) ARSTREAM_Simulation_CondTimedwait ((COND), (MUTEX), (TIMEOUT))
+#define ARSTREAM_Clock_CondSignal(COND) ARSTREAM_Simulation_CondSignal ((COND))
+#define ARSTREAM_Clock_ThreadCreate(THREAD,ROUTINE,ARG) ARSTREAM_Simulation_ThreadCreate ((THREAD), (ROUTINE), (ARG))
+#define ARSTREAM_Clock_ThreadJoin(THREAD,RETVAL) ARSTREAM_Simulation_ThreadJoin ((THREAD), (RETVAL))
+#define ARSTREAM_Clock_SleepUs(US) ARSTREAM_Simulation_SleepUs ((US))
+
+/**
+ * Waits for a notification on OBJECT, or for US microseconds
+ */
+#define ARSTREAM_Clock_WaitUs(OBJECT,US) ((void)ARSTREAM_Simulation_Wait ((OBJECT), ARSTREAM_Simulation_GetTimeUs () + (US)))
+
+/**
+ * Wakes the threads waiting in ARSTREAM_Clock_WaitUs() on OBJECT
+ */
+#define ARSTREAM_Clock_Notify(OBJECT) ARSTREAM_Simulation_Notify ((OBJECT), 1)
+
+#else /* ARSTREAM_SIMULATION */
+
+/*
+ * System Headers
+ */
+#include <unistd.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_Clock_GetTime(TS) ARSAL_Time_GetTime ((TS))
+#define ARSTREAM_Clock_CondWait(COND,MUTEX) ARSAL_Cond_Wait ((COND), (MUTEX))
+#define ARSTREAM_Clock_CondTimedwait(COND,MUTEX,TIMEOUT) ARSAL_Cond_Timedwait ((COND), (MUTEX), (TIMEOUT))
+#define ARSTREAM_Clock_CondSignal(COND) ARSAL_Cond_Signal ((COND))
+#define ARSTREAM_Clock_ThreadCreate(THREAD,ROUTINE,ARG) ARSAL_Thread_Create ((THREAD), (ROUTINE), (ARG))
+#define ARSTREAM_Clock_ThreadJoin(THREAD,RETVAL) ARSAL_Thread_Join ((THREAD), (RETVAL))
+#define ARSTREAM_Clock_SleepUs(US) usleep ((useconds_t)(US))
+#define ARSTREAM_Clock_WaitUs(OBJECT,US) usleep ((useconds_t)(US))
+#define ARSTREAM_Clock_Notify(OBJECT) do { } while (0)
+
+#endif /* ARSTREAM_SIMULATION */
+
+#endif /* _ARSTREAM_CLOCK_PRIVATE_H_ */
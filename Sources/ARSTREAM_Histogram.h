@@ -0,0 +1,74 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Histogram.h
+ * @brief Latency histograms of the stream sender and reader statistics
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_HISTOGRAM_PRIVATE_H_
+#define _ARSTREAM_HISTOGRAM_PRIVATE_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Stats.h>
+
+/*
+ * Functions
+ */
+
+/**
+ * @brief Counts a value in a histogram of ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS buckets
+ * @param histogram The histogram
+ * @param valueMs The value, in milliseconds (negative values, from clock adjustments, are counted in bucket 0)
+ */
+static inline void ARSTREAM_Histogram_Add (uint32_t *histogram, int32_t valueMs)
+{
+    int bucket = 0;
+    if (valueMs > 0)
+    {
+        bucket = 32 - __builtin_clz ((uint32_t)valueMs);
+        if (bucket >= ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS)
+        {
+            bucket = ARSTREAM_STATS_HISTOGRAM_NB_BUCKETS - 1;
+        }
+    }
+    histogram [bucket]++;
+}
+
+#endif /* _ARSTREAM_HISTOGRAM_PRIVATE_H_ */
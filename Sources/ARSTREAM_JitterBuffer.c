@@ -0,0 +1,557 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_JitterBuffer.c
+ * @brief Playout jitter buffer for reassembled frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_JitterBuffer.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_JITTER_BUFFER_TAG "ARSTREAM_JitterBuffer"
+
+/* Playout delay is set to this many times the jitter estimate */
+#define ARSTREAM_JITTER_BUFFER_JITTER_MULTIPLIER (4)
+/* When the link gets cleaner, the delay shrinks by 1/(2^SHIFT) of the excess for each frame */
+#define ARSTREAM_JITTER_BUFFER_DELAY_DECREASE_SHIFT (6)
+/* Number of frames over which the minimum transit time is searched */
+#define ARSTREAM_JITTER_BUFFER_TRANSIT_WINDOW (256)
+/* Wait time of the output thread when the jitter buffer is empty */
+#define ARSTREAM_JITTER_BUFFER_IDLE_WAIT_MS (100)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    eARSTREAM_READER_CAUSE cause; // FRAME_COMPLETE or FRAME_INCOMPLETE, as pushed
+    uint8_t *framePointer;
+    uint32_t frameSize;
+    int numberOfSkippedFrames;
+    int isFlushFrame;
+    uint64_t timestampUs;
+    uint64_t arrivalTimeUs;
+    int64_t baseTimeUs; // Local time of playout for a zero delay
+    int isEarly;
+} ARSTREAM_JitterBuffer_Frame_t;
+
+struct ARSTREAM_JitterBuffer_t {
+    /* Configuration on New */
+    ARSTREAM_JitterBuffer_FrameCallback_t callback;
+    int maxNumberOfFrames;
+    int64_t minDelayUs;
+    int64_t maxDelayUs;
+    void *custom;
+
+    /* Frames queue */
+    ARSAL_Mutex_t mutex;
+    ARSAL_Cond_t cond;
+    ARSTREAM_JitterBuffer_Frame_t *frames;
+    int indexGet;
+    int nbFrames;
+
+    /* Playout clock */
+    int hasPreviousFrame;
+    uint64_t previousTimestampUs;
+    uint64_t previousArrivalTimeUs;
+    int64_t previousTransitUs;
+    int64_t framePeriodUs;
+    int64_t jitterUs;
+    int64_t minTransitUs [2]; // Current and previous windows
+    int transitWindowCount;
+    int64_t targetDelayUs;
+
+    /* Statistics */
+    uint32_t nbFramesIn;
+    uint32_t nbFramesOut;
+    uint32_t nbFramesRejected;
+    uint32_t nbLateFrames;
+    uint32_t nbEarlyFrames;
+    uint32_t nbEarlyFramesOut;
+    uint64_t latenessSumUs;
+    uint32_t maxLatenessUs;
+    uint64_t holdTimeSumUs;
+
+    /* Thread status */
+    int threadShouldStop;
+    int threadStarted;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Gets the current time, in microseconds
+ * @return The current time
+ */
+static uint64_t ARSTREAM_JitterBuffer_GetTimeUs (void);
+
+/**
+ * @brief Updates the jitter estimation and the playout delay with a new frame
+ * @param jitterBuffer The jitter buffer
+ * @param frame The new frame (its baseTimeUs is set by this function)
+ * @warning Must be called with the jitter buffer mutex held
+ */
+static void ARSTREAM_JitterBuffer_UpdateClock (ARSTREAM_JitterBuffer_t *jitterBuffer, ARSTREAM_JitterBuffer_Frame_t *frame);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_JitterBuffer_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSAL_Time_GetTime (&now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+static void ARSTREAM_JitterBuffer_UpdateClock (ARSTREAM_JitterBuffer_t *jitterBuffer, ARSTREAM_JitterBuffer_Frame_t *frame)
+{
+    int64_t transitUs;
+    int64_t baseOffsetUs;
+    int isEstimated = 0;
+
+    /* Estimate the timestamp from the measured frame rate if the sender did not give one */
+    if (frame->timestampUs == 0)
+    {
+        isEstimated = 1;
+        if (jitterBuffer->hasPreviousFrame == 1)
+        {
+            int nbPeriods = 1 + ((frame->numberOfSkippedFrames > 0) ? frame->numberOfSkippedFrames : 0);
+            int64_t periodUs = (int64_t)(frame->arrivalTimeUs - jitterBuffer->previousArrivalTimeUs) / nbPeriods;
+            if (jitterBuffer->framePeriodUs == 0)
+            {
+                jitterBuffer->framePeriodUs = periodUs;
+            }
+            else
+            {
+                jitterBuffer->framePeriodUs += (periodUs - jitterBuffer->framePeriodUs) / 8;
+            }
+            frame->timestampUs = jitterBuffer->previousTimestampUs + (jitterBuffer->framePeriodUs * nbPeriods);
+        }
+        else
+        {
+            frame->timestampUs = frame->arrivalTimeUs;
+        }
+    }
+
+    /* RFC 3550-like jitter estimation on the transit time */
+    transitUs = (int64_t)frame->arrivalTimeUs - (int64_t)frame->timestampUs;
+    if (jitterBuffer->hasPreviousFrame == 1)
+    {
+        int64_t deltaUs = transitUs - jitterBuffer->previousTransitUs;
+        if (deltaUs < 0)
+        {
+            deltaUs = -deltaUs;
+        }
+        jitterBuffer->jitterUs += (deltaUs - jitterBuffer->jitterUs) / 16;
+    }
+    else
+    {
+        jitterBuffer->minTransitUs [0] = transitUs;
+        jitterBuffer->minTransitUs [1] = transitUs;
+    }
+
+    /* The fastest frame of the recent windows gives the clock offset */
+    if (transitUs < jitterBuffer->minTransitUs [0])
+    {
+        jitterBuffer->minTransitUs [0] = transitUs;
+    }
+    jitterBuffer->transitWindowCount++;
+    if (jitterBuffer->transitWindowCount >= ARSTREAM_JITTER_BUFFER_TRANSIT_WINDOW)
+    {
+        jitterBuffer->minTransitUs [1] = jitterBuffer->minTransitUs [0];
+        jitterBuffer->minTransitUs [0] = transitUs;
+        jitterBuffer->transitWindowCount = 0;
+    }
+    baseOffsetUs = jitterBuffer->minTransitUs [0];
+    if (jitterBuffer->minTransitUs [1] < baseOffsetUs)
+    {
+        baseOffsetUs = jitterBuffer->minTransitUs [1];
+    }
+
+    /* Estimated timestamps drift after a pause of the stream: resync them on the reception time */
+    if ((isEstimated == 1) &&
+        (transitUs - baseOffsetUs > 2 * jitterBuffer->maxDelayUs))
+    {
+        frame->timestampUs = frame->arrivalTimeUs - baseOffsetUs;
+        transitUs = baseOffsetUs;
+    }
+
+    /* Adapt the playout delay */
+    if (jitterBuffer->minDelayUs != jitterBuffer->maxDelayUs)
+    {
+        int64_t desiredDelayUs = ARSTREAM_JITTER_BUFFER_JITTER_MULTIPLIER * jitterBuffer->jitterUs;
+        if (desiredDelayUs < jitterBuffer->minDelayUs)
+        {
+            desiredDelayUs = jitterBuffer->minDelayUs;
+        }
+        if (desiredDelayUs > jitterBuffer->maxDelayUs)
+        {
+            desiredDelayUs = jitterBuffer->maxDelayUs;
+        }
+
+        if (desiredDelayUs > jitterBuffer->targetDelayUs)
+        {
+            jitterBuffer->targetDelayUs = desiredDelayUs;
+        }
+        else
+        {
+            jitterBuffer->targetDelayUs -= (jitterBuffer->targetDelayUs - desiredDelayUs) >> ARSTREAM_JITTER_BUFFER_DELAY_DECREASE_SHIFT;
+        }
+    }
+
+    frame->baseTimeUs = (int64_t)frame->timestampUs + baseOffsetUs;
+
+    jitterBuffer->hasPreviousFrame = 1;
+    jitterBuffer->previousTimestampUs = frame->timestampUs;
+    jitterBuffer->previousArrivalTimeUs = frame->arrivalTimeUs;
+    jitterBuffer->previousTransitUs = transitUs;
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_JitterBuffer_t* ARSTREAM_JitterBuffer_New (ARSTREAM_JitterBuffer_FrameCallback_t callback, int maxNumberOfFrames, int32_t minDelayMs, int32_t maxDelayMs, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_JitterBuffer_t *retJitterBuffer = NULL;
+    int mutexWasInit = 0;
+    int condWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((callback == NULL) ||
+        (maxNumberOfFrames <= 0) ||
+        (minDelayMs < 0) ||
+        (maxDelayMs < minDelayMs))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retJitterBuffer;
+    }
+
+    /* Alloc new jitter buffer */
+    retJitterBuffer = malloc (sizeof (ARSTREAM_JitterBuffer_t));
+    if (retJitterBuffer == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Copy parameters */
+    if (internalError == ARSTREAM_OK)
+    {
+        memset (retJitterBuffer, 0, sizeof (ARSTREAM_JitterBuffer_t));
+        retJitterBuffer->callback = callback;
+        retJitterBuffer->maxNumberOfFrames = maxNumberOfFrames;
+        retJitterBuffer->minDelayUs = (int64_t)minDelayMs * 1000;
+        retJitterBuffer->maxDelayUs = (int64_t)maxDelayMs * 1000;
+        retJitterBuffer->targetDelayUs = retJitterBuffer->minDelayUs;
+        retJitterBuffer->custom = custom;
+    }
+
+    /* Setup internal mutexes/conditions */
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retJitterBuffer->mutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            mutexWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        int condInitRet = ARSAL_Cond_Init (&(retJitterBuffer->cond));
+        if (condInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            condWasInit = 1;
+        }
+    }
+
+    /* Alloc frames queue */
+    if (internalError == ARSTREAM_OK)
+    {
+        retJitterBuffer->frames = malloc (maxNumberOfFrames * sizeof (ARSTREAM_JitterBuffer_Frame_t));
+        if (retJitterBuffer->frames == NULL)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retJitterBuffer != NULL))
+    {
+        if (mutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retJitterBuffer->mutex));
+        }
+        if (condWasInit == 1)
+        {
+            ARSAL_Cond_Destroy (&(retJitterBuffer->cond));
+        }
+        free (retJitterBuffer);
+        retJitterBuffer = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retJitterBuffer;
+}
+
+void ARSTREAM_JitterBuffer_Stop (ARSTREAM_JitterBuffer_t *jitterBuffer)
+{
+    if (jitterBuffer != NULL)
+    {
+        ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+        jitterBuffer->threadShouldStop = 1;
+        ARSAL_Cond_Signal (&(jitterBuffer->cond));
+        ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+    }
+}
+
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_Delete (ARSTREAM_JitterBuffer_t **jitterBuffer)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    if ((jitterBuffer != NULL) &&
+        (*jitterBuffer != NULL))
+    {
+        if ((*jitterBuffer)->threadStarted == 0)
+        {
+            ARSAL_Mutex_Destroy (&((*jitterBuffer)->mutex));
+            ARSAL_Cond_Destroy (&((*jitterBuffer)->cond));
+            free ((*jitterBuffer)->frames);
+            free (*jitterBuffer);
+            *jitterBuffer = NULL;
+            retVal = ARSTREAM_OK;
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_JITTER_BUFFER_TAG, "Call ARSTREAM_JitterBuffer_Stop before calling this function");
+            retVal = ARSTREAM_ERROR_BUSY;
+        }
+    }
+    return retVal;
+}
+
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_PushFrame (ARSTREAM_JitterBuffer_t *jitterBuffer, eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint64_t timestampUs)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_OK;
+    if ((jitterBuffer == NULL) ||
+        (framePointer == NULL) ||
+        ((cause != ARSTREAM_READER_CAUSE_FRAME_COMPLETE) &&
+         (cause != ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE)))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+    jitterBuffer->nbFramesIn++;
+    if (jitterBuffer->nbFrames >= jitterBuffer->maxNumberOfFrames)
+    {
+        jitterBuffer->nbFramesRejected++;
+        retVal = ARSTREAM_ERROR_QUEUE_FULL;
+    }
+    else
+    {
+        int index = (jitterBuffer->indexGet + jitterBuffer->nbFrames) % jitterBuffer->maxNumberOfFrames;
+        ARSTREAM_JitterBuffer_Frame_t *frame = &(jitterBuffer->frames [index]);
+        int64_t playoutTimeUs;
+        frame->cause = cause;
+        frame->framePointer = framePointer;
+        frame->frameSize = frameSize;
+        frame->numberOfSkippedFrames = numberOfSkippedFrames;
+        frame->isFlushFrame = isFlushFrame;
+        frame->timestampUs = timestampUs;
+        frame->arrivalTimeUs = ARSTREAM_JitterBuffer_GetTimeUs ();
+        ARSTREAM_JitterBuffer_UpdateClock (jitterBuffer, frame);
+
+        playoutTimeUs = frame->baseTimeUs + jitterBuffer->targetDelayUs;
+        if ((int64_t)frame->arrivalTimeUs > playoutTimeUs)
+        {
+            uint32_t latenessUs = (uint32_t)((int64_t)frame->arrivalTimeUs - playoutTimeUs);
+            frame->isEarly = 0;
+            jitterBuffer->nbLateFrames++;
+            jitterBuffer->latenessSumUs += latenessUs;
+            if (latenessUs > jitterBuffer->maxLatenessUs)
+            {
+                jitterBuffer->maxLatenessUs = latenessUs;
+            }
+            /* Late frames raise the playout delay right away */
+            if (jitterBuffer->minDelayUs != jitterBuffer->maxDelayUs)
+            {
+                jitterBuffer->targetDelayUs += latenessUs;
+                if (jitterBuffer->targetDelayUs > jitterBuffer->maxDelayUs)
+                {
+                    jitterBuffer->targetDelayUs = jitterBuffer->maxDelayUs;
+                }
+            }
+        }
+        else
+        {
+            frame->isEarly = 1;
+            jitterBuffer->nbEarlyFrames++;
+        }
+
+        jitterBuffer->nbFrames++;
+        ARSAL_Cond_Signal (&(jitterBuffer->cond));
+    }
+    ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+    return retVal;
+}
+
+void* ARSTREAM_JitterBuffer_RunThread (void *ARSTREAM_JitterBuffer_t_Param)
+{
+    ARSTREAM_JitterBuffer_t *jitterBuffer = (ARSTREAM_JitterBuffer_t *)ARSTREAM_JitterBuffer_t_Param;
+    ARSTREAM_JitterBuffer_Frame_t frame;
+
+    /* Parameters check */
+    if (jitterBuffer == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_JITTER_BUFFER_TAG, "Error while starting %s, bad parameters", __FUNCTION__);
+        return (void *)0;
+    }
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_JITTER_BUFFER_TAG, "Jitter buffer thread running");
+    jitterBuffer->threadStarted = 1;
+
+    ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+    while (jitterBuffer->threadShouldStop == 0)
+    {
+        if (jitterBuffer->nbFrames == 0)
+        {
+            ARSAL_Cond_Timedwait (&(jitterBuffer->cond), &(jitterBuffer->mutex), ARSTREAM_JITTER_BUFFER_IDLE_WAIT_MS);
+        }
+        else
+        {
+            ARSTREAM_JitterBuffer_Frame_t *head = &(jitterBuffer->frames [jitterBuffer->indexGet]);
+            int64_t nowUs = (int64_t)ARSTREAM_JitterBuffer_GetTimeUs ();
+            int64_t playoutTimeUs = head->baseTimeUs + jitterBuffer->targetDelayUs;
+            if (nowUs >= playoutTimeUs)
+            {
+                frame = *head;
+                jitterBuffer->indexGet = (jitterBuffer->indexGet + 1) % jitterBuffer->maxNumberOfFrames;
+                jitterBuffer->nbFrames--;
+                jitterBuffer->nbFramesOut++;
+                if (frame.isEarly == 1)
+                {
+                    jitterBuffer->nbEarlyFramesOut++;
+                    jitterBuffer->holdTimeSumUs += nowUs - (int64_t)frame.arrivalTimeUs;
+                }
+                ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+                jitterBuffer->callback (frame.cause, frame.framePointer, frame.frameSize, frame.numberOfSkippedFrames, frame.isFlushFrame, frame.timestampUs, jitterBuffer->custom);
+                ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+            }
+            else
+            {
+                int waitMs = (int)((playoutTimeUs - nowUs + 999) / 1000);
+                ARSAL_Cond_Timedwait (&(jitterBuffer->cond), &(jitterBuffer->mutex), waitMs);
+            }
+        }
+    }
+
+    /* Give back all remaining frames */
+    while (jitterBuffer->nbFrames > 0)
+    {
+        frame = jitterBuffer->frames [jitterBuffer->indexGet];
+        jitterBuffer->indexGet = (jitterBuffer->indexGet + 1) % jitterBuffer->maxNumberOfFrames;
+        jitterBuffer->nbFrames--;
+        ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+        jitterBuffer->callback (ARSTREAM_READER_CAUSE_CANCEL, frame.framePointer, frame.frameSize, frame.numberOfSkippedFrames, frame.isFlushFrame, frame.timestampUs, jitterBuffer->custom);
+        ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+    }
+    ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_JITTER_BUFFER_TAG, "Jitter buffer thread ended");
+    jitterBuffer->threadStarted = 0;
+    return (void *)0;
+}
+
+eARSTREAM_ERROR ARSTREAM_JitterBuffer_GetStats (ARSTREAM_JitterBuffer_t *jitterBuffer, ARSTREAM_JitterBuffer_Stats_t *stats)
+{
+    if ((jitterBuffer == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    ARSAL_Mutex_Lock (&(jitterBuffer->mutex));
+    stats->nbFramesIn = jitterBuffer->nbFramesIn;
+    stats->nbFramesOut = jitterBuffer->nbFramesOut;
+    stats->nbFramesRejected = jitterBuffer->nbFramesRejected;
+    stats->nbLateFrames = jitterBuffer->nbLateFrames;
+    stats->nbEarlyFrames = jitterBuffer->nbEarlyFrames;
+    stats->meanLatenessUs = (jitterBuffer->nbLateFrames > 0) ? (uint32_t)(jitterBuffer->latenessSumUs / jitterBuffer->nbLateFrames) : 0;
+    stats->maxLatenessUs = jitterBuffer->maxLatenessUs;
+    stats->meanHoldTimeUs = (jitterBuffer->nbEarlyFramesOut > 0) ? (uint32_t)(jitterBuffer->holdTimeSumUs / jitterBuffer->nbEarlyFramesOut) : 0;
+    stats->jitterUs = (uint32_t)jitterBuffer->jitterUs;
+    stats->targetDelayUs = (uint32_t)jitterBuffer->targetDelayUs;
+    ARSAL_Mutex_Unlock (&(jitterBuffer->mutex));
+    return ARSTREAM_OK;
+}
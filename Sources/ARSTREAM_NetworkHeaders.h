@@ -60,16 +60,29 @@
 
 #define ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME (1)
 
-#define ARSTREAM_NETWORK_HEADERS2_SSRC 0x41525354
+#define ARSTREAM_NETWORK_HEADERS_KEY_FRAME_REQUEST_MAGIC (0x4B465251) // "KFRQ"
+
+#define ARSTREAM_NETWORK_HEADERS_FRAME_SKIP_MAGIC (0x534B4950) // "SKIP"
 
 #define ARSTREAM_NETWORK_IP_HEADER_SIZE 20
 #define ARSTREAM_NETWORK_UDP_HEADER_SIZE 8
 
-#define ARSTREAM_NETWORK_HEADERS2_RTP_SSRC 0x41525354
-
 #define ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_STAPA 24
 #define ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_FUA 28
 
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_RECEIVER_SSRC 0x41525352
+
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_SINGLE_REPORT 0x81 // Version 2, no padding, one report block
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_NO_REPORT 0x80 // Version 2, no padding, no report block
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_SR 200
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_RR 201
+
+/**
+ * Each end of a v2 stream sends at most one report every ARSTREAM_NETWORK_HEADERS2_RTCP_BANDWIDTH_RATIO
+ * bytes of report (IP/UDP overhead included), so that the reports use less than 1% of the stream
+ */
+#define ARSTREAM_NETWORK_HEADERS2_RTCP_BANDWIDTH_RATIO (200)
+
 /*
  * Types
  */
@@ -112,6 +125,33 @@ typedef struct {
     uint64_t lowPacketsAck; /**< Lower 64 packets bitfield */
 } __attribute__ ((packed)) ARSTREAM_NetworkHeaders_AckPacket_t;
 
+/**
+ * @brief Content of key frame request frames
+ *
+ * These frames are sent on the ack buffer, and are distinguished from
+ * the ARSTREAM_NetworkHeaders_AckPacket_t by their size
+ */
+typedef struct {
+    uint32_t magic; /**< Always ARSTREAM_NETWORK_HEADERS_KEY_FRAME_REQUEST_MAGIC */
+    uint16_t frameNumber; /**< id of the last frame seen by the reader */
+    uint8_t reason; /**< Why the key frame is needed (eARSTREAM_READER_KEY_FRAME_REQUEST_REASON) */
+    uint8_t reserved; /**< Unused, set to zero */
+} __attribute__ ((packed)) ARSTREAM_NetworkHeaders_KeyFrameRequest_t;
+
+/**
+ * @brief Content of frame skip frames
+ *
+ * These frames are sent on the ack buffer instead of the ack of a frame which the reader
+ * skips. The sender stops retrying the frame, and reports it as cancelled.
+ * They have the size of an ARSTREAM_NetworkHeaders_KeyFrameRequest_t, and are distinguished
+ * from it by their magic
+ */
+typedef struct {
+    uint32_t magic; /**< Always ARSTREAM_NETWORK_HEADERS_FRAME_SKIP_MAGIC */
+    uint16_t frameNumber; /**< id of the skipped frame */
+    uint16_t reserved; /**< Unused, set to zero */
+} __attribute__ ((packed)) ARSTREAM_NetworkHeaders_FrameSkip_t;
+
 /**
  * @brief Header for v2 stream data frames (RTP-like, see RFC3550)
  */
@@ -136,6 +176,37 @@ typedef struct {
     uint32_t transmitTimestampL;
 } __attribute__ ((packed)) ARSTREAM_NetworkHeaders_ClockFrame_t;
 
+/**
+ * @brief Format of v2 stream sender reports (RTCP SR, see RFC3550, multiplexed with the data, see RFC5761)
+ */
+typedef struct {
+    uint8_t flags; /**< Always ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_NO_REPORT */
+    uint8_t packetType; /**< Always ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_SR */
+    uint16_t length; /**< Size of the packet in 32 bits words, minus one */
+    uint32_t ssrc; /**< Stream SSRC */
+    uint32_t ntpTimestampH; /**< Sender clock, seconds */
+    uint32_t ntpTimestampL; /**< Sender clock, fraction of seconds (1/2^32 s) */
+    uint32_t rtpTimestamp; /**< RTP timestamp of the last sent access unit */
+    uint32_t senderPacketCount; /**< Number of data packets sent */
+    uint32_t senderByteCount; /**< Number of payload bytes sent */
+} __attribute__ ((packed)) ARSTREAM_NetworkHeaders_SenderReport_t;
+
+/**
+ * @brief Format of v2 stream receiver reports (RTCP RR with one report block, see RFC3550)
+ */
+typedef struct {
+    uint8_t flags; /**< Always ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_SINGLE_REPORT */
+    uint8_t packetType; /**< Always ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_RR */
+    uint16_t length; /**< Size of the packet in 32 bits words, minus one */
+    uint32_t ssrc; /**< Reader SSRC */
+    uint32_t sourceSsrc; /**< Stream SSRC */
+    uint32_t lost; /**< Fraction lost since the last report (8 bits, 1/256 units), then cumulative number of packets lost (24 bits, signed) */
+    uint32_t extHighestSeqNum; /**< Extended highest sequence number received */
+    uint32_t interarrivalJitter; /**< Interarrival jitter, in RTP timestamp units */
+    uint32_t lsr; /**< Middle 32 bits of the NTP timestamp of the last sender report received, 0 if none */
+    uint32_t dlsr; /**< Delay since the last sender report was received, in 1/65536 s */
+} __attribute__ ((packed)) ARSTREAM_NetworkHeaders_ReceiverReport_t;
+
 /*
  * Functions declarations
  */
@@ -0,0 +1,666 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Publisher.c
+ * @brief Refcounted multi-consumer publication of received frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_Publisher.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_PUBLISHER_TAG "ARSTREAM_Publisher"
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    ARSTREAM_Publisher_Frame_t frame; // Must be the first member (see ARSTREAM_Publisher_ReleaseFrame)
+    ARSTREAM_Publisher_t *publisher;
+    uint8_t *buffer;
+    uint32_t capacity;
+    int refCount;
+    int isFree;
+} ARSTREAM_Publisher_Buffer_t;
+
+struct ARSTREAM_Publisher_Subscriber_t {
+    ARSTREAM_Publisher_t *publisher;
+    int queueDepth;
+    eARSTREAM_PUBLISHER_DROP_POLICY dropPolicy;
+    ARSTREAM_Publisher_Buffer_t **queue;
+    int indexGet;
+    int nbFrames;
+    int nbDroppedFrames;
+    int waitForFlushFrame;
+    ARSAL_Cond_t cond;
+    ARSTREAM_Publisher_Subscriber_t *next;
+};
+
+struct ARSTREAM_Publisher_t {
+    ARSAL_Mutex_t mutex;
+    ARSTREAM_Publisher_Buffer_t *buffers;
+    int nbBuffers;
+    uint8_t *readerBuffer; // Buffer currently used by the reader
+    ARSTREAM_Publisher_Subscriber_t *subscribers;
+    uint32_t nextIndex;
+    int nbDroppedFrames;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Finds the pool buffer which holds a given pointer
+ * @param publisher The publisher
+ * @param pointer The buffer pointer
+ * @return The pool buffer, or NULL if pointer is not a buffer of the pool
+ */
+static ARSTREAM_Publisher_Buffer_t* ARSTREAM_Publisher_FindBuffer (ARSTREAM_Publisher_t *publisher, uint8_t *pointer);
+
+/**
+ * @brief Takes a free buffer from the pool
+ * @param publisher The publisher
+ * @param minCapacity Minimum capacity of the buffer (the buffer is reallocated if needed)
+ * @return A buffer, or NULL if no buffer is available
+ * @warning Must be called with the publisher mutex held
+ */
+static ARSTREAM_Publisher_Buffer_t* ARSTREAM_Publisher_TakeFreeBuffer (ARSTREAM_Publisher_t *publisher, uint32_t minCapacity);
+
+/**
+ * @brief Drops a reference on a published buffer, and puts it back in the pool if it was the last one
+ * @param buffer The buffer
+ * @warning Must be called with the publisher mutex held
+ */
+static void ARSTREAM_Publisher_UnrefBuffer (ARSTREAM_Publisher_Buffer_t *buffer);
+
+/**
+ * @brief Adds a published buffer to a subscriber queue, according to its drop policy
+ * @param subscriber The subscriber
+ * @param buffer The published buffer
+ * @warning Must be called with the publisher mutex held
+ */
+static void ARSTREAM_Publisher_PushToSubscriber (ARSTREAM_Publisher_Subscriber_t *subscriber, ARSTREAM_Publisher_Buffer_t *buffer);
+
+/*
+ * Internal functions implementation
+ */
+
+static ARSTREAM_Publisher_Buffer_t* ARSTREAM_Publisher_FindBuffer (ARSTREAM_Publisher_t *publisher, uint8_t *pointer)
+{
+    int i;
+    for (i = 0; i < publisher->nbBuffers; i++)
+    {
+        if (publisher->buffers[i].buffer == pointer)
+        {
+            return &(publisher->buffers[i]);
+        }
+    }
+    return NULL;
+}
+
+static ARSTREAM_Publisher_Buffer_t* ARSTREAM_Publisher_TakeFreeBuffer (ARSTREAM_Publisher_t *publisher, uint32_t minCapacity)
+{
+    int i;
+    for (i = 0; i < publisher->nbBuffers; i++)
+    {
+        ARSTREAM_Publisher_Buffer_t *buffer = &(publisher->buffers[i]);
+        if (buffer->isFree == 1)
+        {
+            if (buffer->capacity < minCapacity)
+            {
+                uint8_t *newBuffer = realloc (buffer->buffer, minCapacity);
+                if (newBuffer == NULL)
+                {
+                    ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_PUBLISHER_TAG, "Unable to grow a buffer to %u bytes", minCapacity);
+                    return NULL;
+                }
+                buffer->buffer = newBuffer;
+                buffer->capacity = minCapacity;
+            }
+            buffer->isFree = 0;
+            return buffer;
+        }
+    }
+    return NULL;
+}
+
+static void ARSTREAM_Publisher_UnrefBuffer (ARSTREAM_Publisher_Buffer_t *buffer)
+{
+    buffer->refCount--;
+    if (buffer->refCount <= 0)
+    {
+        buffer->refCount = 0;
+        buffer->isFree = 1;
+    }
+}
+
+static void ARSTREAM_Publisher_PushToSubscriber (ARSTREAM_Publisher_Subscriber_t *subscriber, ARSTREAM_Publisher_Buffer_t *buffer)
+{
+    if (subscriber->waitForFlushFrame == 1)
+    {
+        if (buffer->frame.isFlushFrame == 0)
+        {
+            subscriber->nbDroppedFrames++;
+            return;
+        }
+        subscriber->waitForFlushFrame = 0;
+    }
+
+    if (subscriber->nbFrames >= subscriber->queueDepth)
+    {
+        switch (subscriber->dropPolicy)
+        {
+        case ARSTREAM_PUBLISHER_DROP_OLDEST:
+            ARSTREAM_Publisher_UnrefBuffer (subscriber->queue[subscriber->indexGet]);
+            subscriber->indexGet = (subscriber->indexGet + 1) % subscriber->queueDepth;
+            subscriber->nbFrames--;
+            subscriber->nbDroppedFrames++;
+            break;
+        case ARSTREAM_PUBLISHER_DROP_UNTIL_FLUSH_FRAME:
+            while (subscriber->nbFrames > 0)
+            {
+                ARSTREAM_Publisher_UnrefBuffer (subscriber->queue[subscriber->indexGet]);
+                subscriber->indexGet = (subscriber->indexGet + 1) % subscriber->queueDepth;
+                subscriber->nbFrames--;
+                subscriber->nbDroppedFrames++;
+            }
+            if (buffer->frame.isFlushFrame == 0)
+            {
+                subscriber->waitForFlushFrame = 1;
+                subscriber->nbDroppedFrames++;
+                return;
+            }
+            break;
+        case ARSTREAM_PUBLISHER_DROP_NEWEST:
+        default:
+            subscriber->nbDroppedFrames++;
+            return;
+        }
+    }
+
+    subscriber->queue[(subscriber->indexGet + subscriber->nbFrames) % subscriber->queueDepth] = buffer;
+    subscriber->nbFrames++;
+    buffer->refCount++;
+    ARSAL_Cond_Signal (&(subscriber->cond));
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Publisher_t* ARSTREAM_Publisher_New (int nbBuffers, uint32_t bufferCapacity, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Publisher_t *retPublisher = NULL;
+    int mutexWasInit = 0;
+    int i;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((nbBuffers < 2) ||
+        (bufferCapacity == 0))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retPublisher;
+    }
+
+    /* Alloc new publisher */
+    retPublisher = calloc (1, sizeof (ARSTREAM_Publisher_t));
+    if (retPublisher == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Setup internal mutex */
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retPublisher->mutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            mutexWasInit = 1;
+        }
+    }
+
+    /* Alloc buffers pool */
+    if (internalError == ARSTREAM_OK)
+    {
+        retPublisher->buffers = calloc (nbBuffers, sizeof (ARSTREAM_Publisher_Buffer_t));
+        if (retPublisher->buffers == NULL)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        retPublisher->nbBuffers = nbBuffers;
+        for (i = 0; (i < nbBuffers) && (internalError == ARSTREAM_OK); i++)
+        {
+            ARSTREAM_Publisher_Buffer_t *buffer = &(retPublisher->buffers[i]);
+            buffer->publisher = retPublisher;
+            buffer->buffer = malloc (bufferCapacity);
+            buffer->capacity = bufferCapacity;
+            buffer->refCount = 0;
+            buffer->isFree = 1;
+            if (buffer->buffer == NULL)
+            {
+                internalError = ARSTREAM_ERROR_ALLOC;
+            }
+        }
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retPublisher != NULL))
+    {
+        if (mutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retPublisher->mutex));
+        }
+        if (retPublisher->buffers != NULL)
+        {
+            for (i = 0; i < retPublisher->nbBuffers; i++)
+            {
+                free (retPublisher->buffers[i].buffer);
+            }
+            free (retPublisher->buffers);
+        }
+        free (retPublisher);
+        retPublisher = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retPublisher;
+}
+
+eARSTREAM_ERROR ARSTREAM_Publisher_Delete (ARSTREAM_Publisher_t **publisher)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    if ((publisher != NULL) &&
+        (*publisher != NULL))
+    {
+        int canDelete = 1;
+        int i;
+        ARSAL_Mutex_Lock (&((*publisher)->mutex));
+        if ((*publisher)->subscribers != NULL)
+        {
+            canDelete = 0;
+        }
+        for (i = 0; i < (*publisher)->nbBuffers; i++)
+        {
+            if ((*publisher)->buffers[i].isFree == 0)
+            {
+                canDelete = 0;
+            }
+        }
+        ARSAL_Mutex_Unlock (&((*publisher)->mutex));
+
+        if (canDelete == 1)
+        {
+            for (i = 0; i < (*publisher)->nbBuffers; i++)
+            {
+                free ((*publisher)->buffers[i].buffer);
+            }
+            free ((*publisher)->buffers);
+            ARSAL_Mutex_Destroy (&((*publisher)->mutex));
+            free (*publisher);
+            *publisher = NULL;
+            retVal = ARSTREAM_OK;
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_PUBLISHER_TAG, "Unsubscribe all subscribers, release all frames and stop the reader before calling this function");
+            retVal = ARSTREAM_ERROR_BUSY;
+        }
+    }
+    return retVal;
+}
+
+uint8_t* ARSTREAM_Publisher_GetFirstBuffer (ARSTREAM_Publisher_t *publisher, uint32_t *bufferCapacity)
+{
+    uint8_t *retVal = NULL;
+    if ((publisher == NULL) ||
+        (bufferCapacity == NULL))
+    {
+        return retVal;
+    }
+
+    ARSAL_Mutex_Lock (&(publisher->mutex));
+    ARSTREAM_Publisher_Buffer_t *buffer = ARSTREAM_Publisher_TakeFreeBuffer (publisher, 0);
+    if (buffer != NULL)
+    {
+        retVal = buffer->buffer;
+        *bufferCapacity = buffer->capacity;
+        publisher->readerBuffer = retVal;
+    }
+    ARSAL_Mutex_Unlock (&(publisher->mutex));
+    return retVal;
+}
+
+uint8_t* ARSTREAM_Publisher_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    ARSTREAM_Publisher_t *publisher = (ARSTREAM_Publisher_t *)custom;
+    ARSTREAM_Publisher_Buffer_t *current;
+    ARSTREAM_Publisher_Buffer_t *next;
+    ARSTREAM_Publisher_Subscriber_t *subscriber;
+    uint8_t *retVal = framePointer;
+
+    ARSAL_Mutex_Lock (&(publisher->mutex));
+    current = ARSTREAM_Publisher_FindBuffer (publisher, framePointer);
+    switch (cause)
+    {
+    case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+    case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+        next = ARSTREAM_Publisher_TakeFreeBuffer (publisher, 0);
+        if (current == NULL)
+        {
+            // Not a buffer of the pool (the reader was not started with ARSTREAM_Publisher_GetFirstBuffer()): it can not be published
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_PUBLISHER_TAG, "Frame buffer %p does not belong to the publisher", framePointer);
+            publisher->nbDroppedFrames++;
+            if (next != NULL)
+            {
+                // Switch the reader to the pool
+                retVal = next->buffer;
+                *newBufferCapacity = next->capacity;
+            }
+            else
+            {
+                // Only the size of the frame is known to fit in the foreign buffer
+                *newBufferCapacity = frameSize;
+            }
+            break;
+        }
+        if (next == NULL)
+        {
+            // All buffers are held by the subscribers: reuse the current buffer for the next frame
+            publisher->nbDroppedFrames++;
+            *newBufferCapacity = current->capacity;
+            break;
+        }
+
+        current->frame.data = current->buffer;
+        current->frame.size = frameSize;
+        current->frame.isFlushFrame = isFlushFrame;
+        current->frame.isIncomplete = (cause == ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE) ? 1 : 0;
+        current->frame.numberOfSkippedFrames = numberOfSkippedFrames;
+        current->frame.index = publisher->nextIndex++;
+        // Keep a reference while publishing, so the buffer is not freed by a drop policy
+        current->refCount = 1;
+        for (subscriber = publisher->subscribers; subscriber != NULL; subscriber = subscriber->next)
+        {
+            ARSTREAM_Publisher_PushToSubscriber (subscriber, current);
+        }
+        ARSTREAM_Publisher_UnrefBuffer (current);
+
+        retVal = next->buffer;
+        *newBufferCapacity = next->capacity;
+        break;
+
+    case ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL:
+        next = ARSTREAM_Publisher_TakeFreeBuffer (publisher, *newBufferCapacity);
+        if (next != NULL)
+        {
+            retVal = next->buffer;
+            *newBufferCapacity = next->capacity;
+        }
+        else
+        {
+            // No buffer available: the reader skips the current frame, and gives its buffer back with COPY_COMPLETE.
+            // It asks again for a buffer with the next fragment it receives.
+            publisher->nbDroppedFrames++;
+            retVal = NULL;
+            *newBufferCapacity = 0;
+        }
+        break;
+
+    case ARSTREAM_READER_CAUSE_COPY_COMPLETE:
+        // Never free the buffer the reader is now using
+        if ((current != NULL) &&
+            (framePointer != publisher->readerBuffer))
+        {
+            current->isFree = 1;
+        }
+        break;
+
+    case ARSTREAM_READER_CAUSE_CANCEL:
+        if (current != NULL)
+        {
+            current->isFree = 1;
+        }
+        publisher->readerBuffer = NULL;
+        retVal = NULL;
+        break;
+
+    default:
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_PUBLISHER_TAG, "Unknown cause %d", cause);
+        break;
+    }
+
+    if ((cause != ARSTREAM_READER_CAUSE_COPY_COMPLETE) &&
+        (cause != ARSTREAM_READER_CAUSE_CANCEL))
+    {
+        publisher->readerBuffer = retVal;
+    }
+    ARSAL_Mutex_Unlock (&(publisher->mutex));
+    return retVal;
+}
+
+ARSTREAM_Publisher_Subscriber_t* ARSTREAM_Publisher_Subscribe (ARSTREAM_Publisher_t *publisher, int queueDepth, eARSTREAM_PUBLISHER_DROP_POLICY dropPolicy, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Publisher_Subscriber_t *retSubscriber = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((publisher == NULL) ||
+        (queueDepth <= 0) ||
+        (dropPolicy < 0) ||
+        (dropPolicy >= ARSTREAM_PUBLISHER_DROP_MAX))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retSubscriber;
+    }
+
+    /* Alloc new subscriber */
+    retSubscriber = calloc (1, sizeof (ARSTREAM_Publisher_Subscriber_t));
+    if (retSubscriber == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        retSubscriber->publisher = publisher;
+        retSubscriber->queueDepth = queueDepth;
+        retSubscriber->dropPolicy = dropPolicy;
+        retSubscriber->queue = malloc (queueDepth * sizeof (ARSTREAM_Publisher_Buffer_t *));
+        if (retSubscriber->queue == NULL)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        int condInitRet = ARSAL_Cond_Init (&(retSubscriber->cond));
+        if (condInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        ARSAL_Mutex_Lock (&(publisher->mutex));
+        retSubscriber->next = publisher->subscribers;
+        publisher->subscribers = retSubscriber;
+        ARSAL_Mutex_Unlock (&(publisher->mutex));
+    }
+    else if (retSubscriber != NULL)
+    {
+        free (retSubscriber->queue);
+        free (retSubscriber);
+        retSubscriber = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retSubscriber;
+}
+
+eARSTREAM_ERROR ARSTREAM_Publisher_Unsubscribe (ARSTREAM_Publisher_Subscriber_t **subscriber)
+{
+    ARSTREAM_Publisher_t *publisher;
+    ARSTREAM_Publisher_Subscriber_t **link;
+    if ((subscriber == NULL) ||
+        (*subscriber == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    publisher = (*subscriber)->publisher;
+    ARSAL_Mutex_Lock (&(publisher->mutex));
+    for (link = &(publisher->subscribers); *link != NULL; link = &((*link)->next))
+    {
+        if (*link == *subscriber)
+        {
+            *link = (*subscriber)->next;
+            break;
+        }
+    }
+    while ((*subscriber)->nbFrames > 0)
+    {
+        ARSTREAM_Publisher_UnrefBuffer ((*subscriber)->queue[(*subscriber)->indexGet]);
+        (*subscriber)->indexGet = ((*subscriber)->indexGet + 1) % (*subscriber)->queueDepth;
+        (*subscriber)->nbFrames--;
+    }
+    ARSAL_Mutex_Unlock (&(publisher->mutex));
+
+    ARSAL_Cond_Destroy (&((*subscriber)->cond));
+    free ((*subscriber)->queue);
+    free (*subscriber);
+    *subscriber = NULL;
+    return ARSTREAM_OK;
+}
+
+const ARSTREAM_Publisher_Frame_t* ARSTREAM_Publisher_PopFrame (ARSTREAM_Publisher_Subscriber_t *subscriber, int timeoutMs, int *nbDroppedFrames)
+{
+    const ARSTREAM_Publisher_Frame_t *retFrame = NULL;
+    ARSTREAM_Publisher_t *publisher;
+    if (subscriber == NULL)
+    {
+        return retFrame;
+    }
+
+    publisher = subscriber->publisher;
+    ARSAL_Mutex_Lock (&(publisher->mutex));
+    if (subscriber->nbFrames == 0)
+    {
+        if (timeoutMs < 0)
+        {
+            while (subscriber->nbFrames == 0)
+            {
+                ARSAL_Cond_Wait (&(subscriber->cond), &(publisher->mutex));
+            }
+        }
+        else if (timeoutMs > 0)
+        {
+            ARSAL_Cond_Timedwait (&(subscriber->cond), &(publisher->mutex), timeoutMs);
+        }
+    }
+    if (subscriber->nbFrames > 0)
+    {
+        retFrame = &(subscriber->queue[subscriber->indexGet]->frame);
+        subscriber->indexGet = (subscriber->indexGet + 1) % subscriber->queueDepth;
+        subscriber->nbFrames--;
+    }
+    SET_WITH_CHECK (nbDroppedFrames, subscriber->nbDroppedFrames);
+    subscriber->nbDroppedFrames = 0;
+    ARSAL_Mutex_Unlock (&(publisher->mutex));
+    return retFrame;
+}
+
+void ARSTREAM_Publisher_ReleaseFrame (const ARSTREAM_Publisher_Frame_t *frame)
+{
+    ARSTREAM_Publisher_Buffer_t *buffer = (ARSTREAM_Publisher_Buffer_t *)frame;
+    ARSTREAM_Publisher_t *publisher;
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    publisher = buffer->publisher;
+    ARSAL_Mutex_Lock (&(publisher->mutex));
+    ARSTREAM_Publisher_UnrefBuffer (buffer);
+    ARSAL_Mutex_Unlock (&(publisher->mutex));
+}
+
+int ARSTREAM_Publisher_GetNumberOfDroppedFrames (ARSTREAM_Publisher_t *publisher)
+{
+    int retVal = -1;
+    if (publisher != NULL)
+    {
+        ARSAL_Mutex_Lock (&(publisher->mutex));
+        retVal = publisher->nbDroppedFrames;
+        ARSAL_Mutex_Unlock (&(publisher->mutex));
+    }
+    return retVal;
+}
@@ -52,6 +52,11 @@
 
 #include "ARSTREAM_Buffers.h"
 #include "ARSTREAM_NetworkHeaders.h"
+#include "ARSTREAM_Transport.h"
+#include "ARSTREAM_CaptureFile.h"
+#include "ARSTREAM_Clock.h"
+#include "ARSTREAM_TracePoints.h"
+#include "ARSTREAM_Histogram.h"
 
 /*
  * ARSDK Headers
@@ -60,6 +65,7 @@
 #include <libARStream/ARSTREAM_Reader.h>
 #include <libARSAL/ARSAL_Print.h>
 #include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Time.h>
 #include <libARSAL/ARSAL_Endianness.h>
 
 /*
@@ -89,9 +95,7 @@
 
 struct ARSTREAM_Reader_t {
     /* Configuration on New */
-    ARNETWORK_Manager_t *manager;
-    int dataBufferID;
-    int ackBufferID;
+    ARSTREAM_Transport_t *transport;
     uint32_t maxFragmentSize;
     int32_t maxAckInterval;
     ARSTREAM_Reader_FrameCompleteCallback_t callback;
@@ -112,6 +116,10 @@ struct ARSTREAM_Reader_t {
     ARSAL_Mutex_t ackSendMutex;
     ARSAL_Cond_t ackSendCond;
 
+    /* Protects stats, freezeStats and the efficiency counters. Taken after ackPacketMutex, and never held
+     * while calling the callbacks, so that the getters can be called from them */
+    ARSAL_Mutex_t statsMutex;
+
     /* Thread status */
     int threadsShouldStop;
     int dataThreadStarted;
@@ -125,6 +133,48 @@ struct ARSTREAM_Reader_t {
     /* Filters */
     ARSTREAM_Filter_t **filters;
     int nbFilters;
+
+    /* Partial frame delivery */
+    int partialFrameDelivery;
+    int32_t partialFrameTimeoutMs;
+    uint8_t currentFrameFlags;
+    uint8_t currentFrameFragmentsPerFrame;
+    struct timespec lastFragmentTime;
+    ARSTREAM_Reader_MissingRegion_t missingRegions [ARSTREAM_NETWORK_HEADERS_MAX_FRAGMENTS_PER_FRAME];
+    int nbMissingRegions;
+
+    /* Progressive frame delivery */
+    ARSTREAM_Reader_FramePrefixCallback_t prefixCallback;
+    int currentFramePrefixFragments; // Number of contiguous fragments from the start of the frame
+    uint32_t currentFramePrefixSize; // Last size given to the prefix callback
+
+    /* Skip until flush frame */
+    int skipUntilFlushFrame;
+    int waitForFlushFrame; // Set after a loss, until the next flush frame
+    int currentFrameIsSkipped; // The ack thread sends an ARSTREAM_NetworkHeaders_FrameSkip_t instead of the ack of the current frame
+
+    /* Key frame requests */
+    int keyFrameRequests;
+    int keyFrameRequestIntervalMs;
+    int keyFrameRequestPending; // Set until a flush frame is delivered
+    int keyFrameRequestedByApplication; // Set by ARSTREAM_Reader_RequestKeyFrame(), taken by the ack thread (atomic)
+    int keyFrameRequestWasSent;
+    uint8_t keyFrameRequestReason;
+    struct timespec lastKeyFrameRequestTime;
+
+    /* Freeze statistics */
+    ARSTREAM_Reader_FreezeStats_t freezeStats;
+    struct timespec startTime;
+    struct timespec lastDeliveryTime;
+    int hasDeliveredFrame;
+
+    /* Statistics (protected by statsMutex, efficiency and freezeStats are filled by ARSTREAM_Reader_GetStats) */
+    ARSTREAM_Reader_Stats_t stats;
+    struct timespec currentFrameStartTime;
+
+    /* Capture of the received packets, and replay */
+    ARSTREAM_CaptureFile_t *capture;
+    ARSTREAM_Transport_t *replayTransport; // Not owned : may be wrapped by ARSTREAM_Reader_SetImpairment()
 };
 
 /*
@@ -132,30 +182,200 @@ struct ARSTREAM_Reader_t {
  */
 
 /**
- * @brief ARNETWORK_Manager_Callback_t for ARNETWORK_... calls
- * @param IoBufferId Unused as we always send on one unique buffer
- * @param dataPtr Unused as we don't need to free the memory
- * @param customData Unused
- * @param status Unused
- * @return ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT
+ * @brief Creates a new reader on top of a transport
+ * @param transport The transport to use. Owned by the reader on success only.
+ * @see ARSTREAM_Reader_New for the other parameters
  */
-eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Reader_NetworkCallback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status);
+static ARSTREAM_Reader_t* ARSTREAM_Reader_NewWithTransport (ARSTREAM_Transport_t *transport, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Checks if the current frame can be delivered as an incomplete frame
+ * @param reader The reader
+ * @param skipCurrentFrame Non-zero if the current frame was already delivered, or can not be delivered
+ * @return 1 if partial frame delivery is enabled and the current frame is pending, 0 otherwise
+ */
+static int ARSTREAM_Reader_PartialFrameIsPending (ARSTREAM_Reader_t *reader, int skipCurrentFrame);
+
+/**
+ * @brief Delivers the current (incomplete) frame to the application
+ * Missing fragments are zero-filled, and their byte ranges are saved for ARSTREAM_Reader_GetMissingRegions()
+ * @param reader The reader
+ * @param previousFNum Pointer to the number of the last delivered frame (updated by this function)
+ * @warning Must be called with the ackPacketMutex held
+ */
+static void ARSTREAM_Reader_DeliverIncompleteFrame (ARSTREAM_Reader_t *reader, uint16_t *previousFNum);
+
+/**
+ * @brief Gives the newly contiguous bytes of the current frame to the prefix callback
+ * @param reader The reader
+ */
+static void ARSTREAM_Reader_UpdateFramePrefix (ARSTREAM_Reader_t *reader);
+
+/**
+ * @brief Registers a key frame request, which will be sent by the ack thread
+ * Nothing is done if a request is already pending
+ * @param reader The reader
+ * @param reason Why the key frame is needed
+ * @warning Must be called with the ackPacketMutex held
+ */
+static void ARSTREAM_Reader_AskForKeyFrame (ARSTREAM_Reader_t *reader, eARSTREAM_READER_KEY_FRAME_REQUEST_REASON reason);
+
+/**
+ * @brief Updates the freeze statistics and the key frame requests when a frame is given to the application
+ * @param reader The reader
+ * @param nbMissedFrame Number of frames lost since the previously delivered frame
+ * @param isFlushFrame Boolean-like (0-1) flag telling if the delivered frame is a flush frame
+ * @warning Must be called with the ackPacketMutex held
+ */
+static void ARSTREAM_Reader_FrameDelivered (ARSTREAM_Reader_t *reader, int nbMissedFrame, int isFlushFrame);
 
 /*
  * Internal functions implementation
  */
 
-//TODO: Network, NULL callback should be ok ?
-eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Reader_NetworkCallback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status)
+static int ARSTREAM_Reader_PartialFrameIsPending (ARSTREAM_Reader_t *reader, int skipCurrentFrame)
 {
-    /* Avoid "unused parameters" warnings */
-    (void)IoBufferId;
-    (void)dataPtr;
-    (void)customData;
-    (void)status;
+    int retVal = 0;
+    if ((reader->partialFrameDelivery == 1) &&
+        (reader->nbFilters == 0) &&
+        (skipCurrentFrame == 0) &&
+        (reader->currentFrameFragmentsPerFrame > 0) &&
+        (reader->currentFrameSize > 0))
+    {
+        retVal = 1;
+    }
+    return retVal;
+}
 
-    /* Dummy return value */
-    return ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT;
+static void ARSTREAM_Reader_DeliverIncompleteFrame (ARSTREAM_Reader_t *reader, uint16_t *previousFNum)
+{
+    uint16_t frameNumber = reader->ackPacket.frameNumber;
+    int isFlushFrame = ((reader->currentFrameFlags & ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME) != 0) ? 1 : 0;
+    int nbMissedFrame = 0;
+    int fragment;
+    ARSTREAM_Reader_MissingRegion_t *region = NULL;
+
+    reader->nbMissingRegions = 0;
+    for (fragment = 0; fragment < reader->currentFrameFragmentsPerFrame; fragment++)
+    {
+        if (ARSTREAM_NetworkHeaders_AckPacketFlagIsSet (&(reader->ackPacket), fragment) == 0)
+        {
+            uint32_t offset = reader->maxFragmentSize * fragment;
+            // Merge with the previous region if they are contiguous
+            if ((region != NULL) &&
+                (region->offset + region->size == offset))
+            {
+                region->size += reader->maxFragmentSize;
+            }
+            else
+            {
+                region = &(reader->missingRegions [reader->nbMissingRegions]);
+                reader->nbMissingRegions++;
+                region->offset = offset;
+                region->size = reader->maxFragmentSize;
+            }
+            // Do not leave data from a previous frame in the buffer
+            if (offset < reader->currentFrameSize)
+            {
+                uint32_t size = reader->currentFrameSize - offset;
+                if (size > reader->maxFragmentSize)
+                {
+                    size = reader->maxFragmentSize;
+                }
+                memset (&(reader->currentFrameBuffer)[offset], 0, size);
+            }
+        }
+    }
+
+    if (frameNumber != *previousFNum + 1)
+    {
+        nbMissedFrame = frameNumber - *previousFNum - 1;
+    }
+    *previousFNum = frameNumber;
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    reader->stats.nbFramesIncomplete++;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    ARSTREAM_Reader_FrameDelivered (reader, nbMissedFrame, isFlushFrame);
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Delivering incomplete frame %d (%d missing regions)", frameNumber, reader->nbMissingRegions);
+    reader->outputFrameBuffer = reader->callback (ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE, reader->currentFrameBuffer, reader->currentFrameSize, nbMissedFrame, isFlushFrame, &(reader->outputFrameBufferSize), reader->custom);
+    ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_PARTIAL, frameNumber, reader->nbMissingRegions);
+    reader->currentFrameBuffer = reader->outputFrameBuffer;
+    reader->currentFrameBufferSize = reader->outputFrameBufferSize;
+    reader->nbMissingRegions = 0;
+}
+
+static void ARSTREAM_Reader_UpdateFramePrefix (ARSTREAM_Reader_t *reader)
+{
+    uint32_t prefixSize;
+    while ((reader->currentFramePrefixFragments < reader->currentFrameFragmentsPerFrame) &&
+           (ARSTREAM_NetworkHeaders_AckPacketFlagIsSet (&(reader->ackPacket), reader->currentFramePrefixFragments) == 1))
+    {
+        reader->currentFramePrefixFragments++;
+    }
+
+    // Only the last fragment can be smaller than maxFragmentSize
+    if (reader->currentFramePrefixFragments == reader->currentFrameFragmentsPerFrame)
+    {
+        prefixSize = reader->currentFrameSize;
+    }
+    else
+    {
+        prefixSize = reader->maxFragmentSize * reader->currentFramePrefixFragments;
+    }
+
+    if (prefixSize > reader->currentFramePrefixSize)
+    {
+        int isFlushFrame = ((reader->currentFrameFlags & ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME) != 0) ? 1 : 0;
+        reader->prefixCallback (reader->currentFrameBuffer, reader->currentFramePrefixSize, prefixSize, isFlushFrame, reader->custom);
+        reader->currentFramePrefixSize = prefixSize;
+    }
+}
+
+static void ARSTREAM_Reader_AskForKeyFrame (ARSTREAM_Reader_t *reader, eARSTREAM_READER_KEY_FRAME_REQUEST_REASON reason)
+{
+    if (reader->keyFrameRequestPending == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Asking for a key frame (reason %d)", reason);
+        reader->keyFrameRequestPending = 1;
+        reader->keyFrameRequestWasSent = 0;
+        reader->keyFrameRequestReason = reason;
+    }
+}
+
+static void ARSTREAM_Reader_FrameDelivered (ARSTREAM_Reader_t *reader, int nbMissedFrame, int isFlushFrame)
+{
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    if (reader->hasDeliveredFrame == 0)
+    {
+        reader->freezeStats.firstFrameDelayMs = ARSAL_Time_ComputeTimespecMsTimeDiff (&(reader->startTime), &now);
+        reader->hasDeliveredFrame = 1;
+    }
+    else if (nbMissedFrame > 0)
+    {
+        uint32_t freezeMs = ARSAL_Time_ComputeTimespecMsTimeDiff (&(reader->lastDeliveryTime), &now);
+        reader->freezeStats.nbFreezes++;
+        reader->freezeStats.totalFreezeMs += freezeMs;
+        reader->freezeStats.lastFreezeMs = freezeMs;
+        if (freezeMs > reader->freezeStats.maxFreezeMs)
+        {
+            reader->freezeStats.maxFreezeMs = freezeMs;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    reader->lastDeliveryTime = now;
+
+    if (isFlushFrame == 1)
+    {
+        reader->keyFrameRequestPending = 0;
+    }
+    else if ((nbMissedFrame > 0) &&
+             (reader->keyFrameRequests == 1))
+    {
+        ARSTREAM_Reader_AskForKeyFrame (reader, ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_LOSS);
+    }
 }
 
 /*
@@ -175,9 +395,7 @@ void ARSTREAM_Reader_InitStreamAckBuffer (ARNETWORK_IOBufferParam_t *bufferParam
 ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBufferID, int ackBufferID, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error)
 {
     ARSTREAM_Reader_t *retReader = NULL;
-    int ackPacketMutexWasInit = 0;
-    int ackSendMutexWasInit = 0;
-    int ackSendCondWasInit = 0;
+    ARSTREAM_Transport_t *transport = NULL;
     eARSTREAM_ERROR internalError = ARSTREAM_OK;
     /* ARGS Check */
     if ((manager == NULL) ||
@@ -191,6 +409,127 @@ ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBu
         return retReader;
     }
 
+    transport = ARSTREAM_Transport_NewNetwork (manager, ackBufferID, dataBufferID, &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retReader = ARSTREAM_Reader_NewWithTransport (transport, callback, frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, custom, &internalError);
+        if (retReader == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retReader;
+}
+
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewUDP (const char *ifaceAddr, int readerPort, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Reader_t *retReader = NULL;
+    ARSTREAM_Transport_t *transport = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((readerPort <= 0) ||
+        (callback == NULL) ||
+        (frameBuffer == NULL) ||
+        (frameBufferSize == 0) ||
+        (maxFragmentSize == 0) ||
+        (maxAckInterval < -1))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retReader;
+    }
+
+    // Acks are sent to the source of the last received fragment
+    transport = ARSTREAM_Transport_NewUDP (NULL, 0, ifaceAddr, readerPort, maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retReader = ARSTREAM_Reader_NewWithTransport (transport, callback, frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, custom, &internalError);
+        if (retReader == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retReader;
+}
+
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewLoopback (ARSTREAM_Loopback_t *loopback, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Reader_t *retReader = NULL;
+    ARSTREAM_Transport_t *transport = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((loopback == NULL) ||
+        (callback == NULL) ||
+        (frameBuffer == NULL) ||
+        (frameBufferSize == 0) ||
+        (maxFragmentSize == 0) ||
+        (maxAckInterval < -1))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retReader;
+    }
+
+    transport = ARSTREAM_Transport_NewLoopback (loopback, ARSTREAM_TRANSPORT_LOOPBACK_SIDE_READER, maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retReader = ARSTREAM_Reader_NewWithTransport (transport, callback, frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, custom, &internalError);
+        if (retReader == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retReader;
+}
+
+ARSTREAM_Reader_t* ARSTREAM_Reader_NewReplay (const char *capturePath, eARSTREAM_CAPTURE_REPLAY_MODE mode, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Reader_t *retReader = NULL;
+    ARSTREAM_Transport_t *transport = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((capturePath == NULL) ||
+        (callback == NULL) ||
+        (frameBuffer == NULL) ||
+        (frameBufferSize == 0) ||
+        (maxFragmentSize == 0) ||
+        (maxAckInterval < -1))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retReader;
+    }
+
+    transport = ARSTREAM_Transport_NewReplay (capturePath, mode, maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retReader = ARSTREAM_Reader_NewWithTransport (transport, callback, frameBuffer, frameBufferSize, maxFragmentSize, maxAckInterval, custom, &internalError);
+        if (retReader == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+        else
+        {
+            retReader->replayTransport = transport;
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retReader;
+}
+
+static ARSTREAM_Reader_t* ARSTREAM_Reader_NewWithTransport (ARSTREAM_Transport_t *transport, ARSTREAM_Reader_FrameCompleteCallback_t callback, uint8_t *frameBuffer, uint32_t frameBufferSize, uint32_t maxFragmentSize, int32_t maxAckInterval, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Reader_t *retReader = NULL;
+    int ackPacketMutexWasInit = 0;
+    int ackSendMutexWasInit = 0;
+    int ackSendCondWasInit = 0;
+    int statsMutexWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+
     /* Alloc new reader */
     retReader = malloc (sizeof (ARSTREAM_Reader_t));
     if (retReader == NULL)
@@ -201,9 +540,9 @@ ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBu
     /* Copy parameters */
     if (internalError == ARSTREAM_OK)
     {
-        retReader->manager = manager;
-        retReader->dataBufferID = dataBufferID;
-        retReader->ackBufferID = ackBufferID;
+        retReader->transport = transport;
+        retReader->capture = NULL;
+        retReader->replayTransport = NULL;
         retReader->maxFragmentSize = maxFragmentSize;
         retReader->maxAckInterval = maxAckInterval;
         retReader->callback = callback;
@@ -249,6 +588,18 @@ ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBu
             ackSendCondWasInit = 1;
         }
     }
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retReader->statsMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            statsMutexWasInit = 1;
+        }
+    }
 
     /* Setup internal variables */
     if (internalError == ARSTREAM_OK)
@@ -268,6 +619,26 @@ ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBu
         }
         retReader->filters = NULL;
         retReader->nbFilters = 0;
+        retReader->partialFrameDelivery = 0;
+        retReader->partialFrameTimeoutMs = 0;
+        retReader->currentFrameFlags = 0;
+        retReader->currentFrameFragmentsPerFrame = 0;
+        retReader->nbMissingRegions = 0;
+        retReader->prefixCallback = NULL;
+        retReader->currentFramePrefixFragments = 0;
+        retReader->currentFramePrefixSize = 0;
+        retReader->skipUntilFlushFrame = 0;
+        retReader->waitForFlushFrame = 0;
+        retReader->currentFrameIsSkipped = 0;
+        retReader->keyFrameRequests = 0;
+        retReader->keyFrameRequestIntervalMs = ARSTREAM_READER_KEY_FRAME_REQUEST_INTERVAL_DEFAULT_MS;
+        retReader->keyFrameRequestPending = 0;
+        retReader->keyFrameRequestedByApplication = 0;
+        retReader->keyFrameRequestWasSent = 0;
+        retReader->keyFrameRequestReason = 0;
+        memset (&(retReader->freezeStats), 0, sizeof (retReader->freezeStats));
+        memset (&(retReader->stats), 0, sizeof (retReader->stats));
+        retReader->hasDeliveredFrame = 0;
     }
 
     if ((internalError != ARSTREAM_OK) &&
@@ -285,6 +656,10 @@ ARSTREAM_Reader_t* ARSTREAM_Reader_New (ARNETWORK_Manager_t *manager, int dataBu
         {
             ARSAL_Cond_Destroy (&(retReader->ackSendCond));
         }
+        if (statsMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retReader->statsMutex));
+        }
         free (retReader);
         retReader = NULL;
     }
@@ -304,7 +679,7 @@ void ARSTREAM_Reader_StopReader (ARSTREAM_Reader_t *reader)
         if (reader->ackThreadStarted == 1)
         {
             ARSAL_Mutex_Lock (&(reader->ackSendMutex));
-            ARSAL_Cond_Signal (&(reader->ackSendCond));
+            ARSTREAM_Clock_CondSignal (&(reader->ackSendCond));
             ARSAL_Mutex_Unlock (&(reader->ackSendMutex));
         }
     }
@@ -325,9 +700,12 @@ eARSTREAM_ERROR ARSTREAM_Reader_Delete (ARSTREAM_Reader_t **reader)
 
         if (canDelete == 1)
         {
+            ARSTREAM_Transport_Delete (&((*reader)->transport));
+            ARSTREAM_CaptureFile_Delete (&((*reader)->capture));
             ARSAL_Mutex_Destroy (&((*reader)->ackPacketMutex));
             ARSAL_Mutex_Destroy (&((*reader)->ackSendMutex));
             ARSAL_Cond_Destroy (&((*reader)->ackSendCond));
+            ARSAL_Mutex_Destroy (&((*reader)->statsMutex));
             free ((*reader)->filters);
             free (*reader);
             *reader = NULL;
@@ -370,7 +748,23 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
     header = (ARSTREAM_NetworkHeaders_DataHeader_t *)recvData;
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Stream reader thread running");
+    ARSTREAM_TRACE_THREAD_BEGIN ("ARSTREAM_Reader_Data");
     reader->dataThreadStarted = 1;
+    // Non-flush frames received before the first flush frame can not be decoded
+    reader->waitForFlushFrame = reader->skipUntilFlushFrame;
+
+    ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    memset (&(reader->freezeStats), 0, sizeof (reader->freezeStats));
+    memset (&(reader->stats), 0, sizeof (reader->stats));
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    reader->hasDeliveredFrame = 0;
+    ARSTREAM_Clock_GetTime (&(reader->startTime));
+    if (reader->keyFrameRequests == 1)
+    {
+        ARSTREAM_Reader_AskForKeyFrame (reader, ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_STARTUP);
+    }
+    ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
 
     // If we don't have filters, use the output buffer as the current one
     if (reader->nbFilters == 0)
@@ -381,47 +775,129 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
 
     while (reader->threadsShouldStop == 0)
     {
-        eARNETWORK_ERROR err = ARNETWORK_Manager_ReadDataWithTimeout (reader->manager, reader->dataBufferID, recvData, recvDataLen, &recvSize, ARSTREAM_READER_DATAREAD_TIMEOUT_MS);
-        if (ARNETWORK_OK != err)
+        int readTimeoutMs = ARSTREAM_READER_DATAREAD_TIMEOUT_MS;
+        // Deliver the current frame if it timed out
+        if ((ARSTREAM_Reader_PartialFrameIsPending (reader, skipCurrentFrame) == 1) &&
+            (reader->partialFrameTimeoutMs > 0))
         {
-            if (ARNETWORK_ERROR_BUFFER_EMPTY != err)
+            struct timespec now;
+            int32_t elapsedMs;
+            ARSTREAM_Clock_GetTime (&now);
+            elapsedMs = ARSAL_Time_ComputeTimespecMsTimeDiff (&(reader->lastFragmentTime), &now);
+            if (elapsedMs >= reader->partialFrameTimeoutMs)
+            {
+                ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
+                ARSTREAM_Reader_DeliverIncompleteFrame (reader, &previousFNum);
+                ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
+                skipCurrentFrame = 1;
+                continue;
+            }
+            if (reader->partialFrameTimeoutMs - elapsedMs < readTimeoutMs)
             {
-                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER_TAG, "Error while reading stream data: %s", ARNETWORK_Error_ToString (err));
+                readTimeoutMs = reader->partialFrameTimeoutMs - elapsedMs;
             }
         }
+
+        recvSize = ARSTREAM_Transport_Read (reader->transport, recvData, recvDataLen, readTimeoutMs);
+        if ((reader->capture != NULL) &&
+            (recvSize > 0))
+        {
+            ARSTREAM_CaptureFile_Write (reader->capture, recvData, recvSize);
+        }
+        if (recvSize < (int)sizeof (ARSTREAM_NetworkHeaders_DataHeader_t))
+        {
+            // Timeout, read error (already logged by the transport), or runt packet
+            continue;
+        }
         else
         {
             int cpIndex, cpSize, endIndex, filterEndIndex;
             ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
             if (header->frameNumber != reader->ackPacket.frameNumber)
             {
+                // Deliver the previous frame if it was superseded before completion
+                if ((ARSTREAM_Reader_PartialFrameIsPending (reader, skipCurrentFrame) == 1) &&
+                    ((int16_t)(header->frameNumber - reader->ackPacket.frameNumber) > 0))
+                {
+                    ARSTREAM_Reader_DeliverIncompleteFrame (reader, &previousFNum);
+                    skipCurrentFrame = 1;
+                }
+                ARSAL_Mutex_Lock (&(reader->statsMutex));
                 reader->efficiency_index ++;
                 reader->efficiency_index %= ARSTREAM_READER_EFFICIENCY_AVERAGE_NB_FRAMES;
                 reader->efficiency_nbTotal [reader->efficiency_index] = 0;
                 reader->efficiency_nbUseful [reader->efficiency_index] = 0;
-                skipCurrentFrame = 0;
-                reader->currentFrameSize = 0;
-                reader->ackPacket.frameNumber = header->frameNumber;
+                ARSAL_Mutex_Unlock (&(reader->statsMutex));
                 uint32_t nackPackets = ARSTREAM_NetworkHeaders_AckPacketCountNotSet (&(reader->ackPacket), header->fragmentsPerFrame);
-                if (nackPackets != 0)
+                if ((nackPackets != 0) &&
+                    (skipCurrentFrame == 0))
                 {
                     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Dropping a frame (missing %d fragments)", nackPackets);
+                    ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_DROPPED, reader->ackPacket.frameNumber, nackPackets);
+                    ARSAL_Mutex_Lock (&(reader->statsMutex));
+                    reader->stats.nbFramesDropped++;
+                    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+                    if (reader->skipUntilFlushFrame == 1)
+                    {
+                        reader->waitForFlushFrame = 1;
+                    }
+                    if (reader->keyFrameRequests == 1)
+                    {
+                        ARSTREAM_Reader_AskForKeyFrame (reader, ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_LOSS);
+                    }
                 }
+                skipCurrentFrame = 0;
+                reader->currentFrameSize = 0;
+                reader->ackPacket.frameNumber = header->frameNumber;
+                reader->currentFrameFlags = header->frameFlags;
+                reader->currentFrameFragmentsPerFrame = header->fragmentsPerFrame;
+                reader->currentFramePrefixFragments = 0;
+                reader->currentFramePrefixSize = 0;
+                reader->currentFrameIsSkipped = 0;
                 ARSTREAM_NetworkHeaders_AckPacketResetUpTo (&(reader->ackPacket), header->fragmentsPerFrame);
+                ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FIRST_FRAGMENT, header->frameNumber, header->fragmentsPerFrame);
+                ARSTREAM_Clock_GetTime (&(reader->currentFrameStartTime));
+                if (reader->waitForFlushFrame == 1)
+                {
+                    if ((header->frameFlags & ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME) != 0)
+                    {
+                        reader->waitForFlushFrame = 0;
+                    }
+                    else
+                    {
+                        // Tell the sender to stop retrying the frame, without acking it
+                        ARSAL_PRINT (ARSAL_PRINT_VERBOSE, ARSTREAM_READER_TAG, "Skipping frame %d while waiting for a flush frame", header->frameNumber);
+                        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_SKIPPED, header->frameNumber, 0);
+                        ARSAL_Mutex_Lock (&(reader->statsMutex));
+                        reader->stats.nbFramesSkipped++;
+                        ARSAL_Mutex_Unlock (&(reader->statsMutex));
+                        reader->currentFrameIsSkipped = 1;
+                        skipCurrentFrame = 1;
+                    }
+                }
+            }
+            if (reader->partialFrameDelivery == 1)
+            {
+                ARSTREAM_Clock_GetTime (&(reader->lastFragmentTime));
             }
             packetWasAlreadyAck = ARSTREAM_NetworkHeaders_AckPacketFlagIsSet (&(reader->ackPacket), header->fragmentNumber);
             ARSTREAM_NetworkHeaders_AckPacketSetFlag (&(reader->ackPacket), header->fragmentNumber);
 
+            ARSAL_Mutex_Lock (&(reader->statsMutex));
             reader->efficiency_nbTotal [reader->efficiency_index] ++;
-            if (packetWasAlreadyAck == 0)
+            reader->stats.nbFragmentsReceived++;
+            if ((packetWasAlreadyAck == 0) &&
+                (reader->currentFrameIsSkipped == 0))
             {
                 reader->efficiency_nbUseful [reader->efficiency_index] ++;
+                reader->stats.nbFragmentsUseful++;
             }
+            ARSAL_Mutex_Unlock (&(reader->statsMutex));
 
             ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
 
             ARSAL_Mutex_Lock (&(reader->ackSendMutex));
-            ARSAL_Cond_Signal (&(reader->ackSendCond));
+            ARSTREAM_Clock_CondSignal (&(reader->ackSendCond));
             ARSAL_Mutex_Unlock (&(reader->ackSendMutex));
 
 
@@ -476,7 +952,7 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                         }
                         reader->callback (ARSTREAM_READER_CAUSE_COPY_COMPLETE, reader->outputFrameBuffer, reader->currentFrameSize, 0, skipCurrentFrame, &dummy, reader->custom);
                         reader->outputFrameBuffer = tmpFrame;
-                        reader->outputFrameBufferSize = finalOutputSize;
+                        reader->outputFrameBufferSize = (tmpFrame != NULL) ? newOutputSize : 0;
                     }
 
                     // Copy into new buffer
@@ -495,9 +971,13 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                 else
                 {
                     nextFrameBuffer = reader->callback (ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL, reader->outputFrameBuffer, reader->currentFrameSize, 0, 0, &nextFrameBufferSize, reader->custom);
-                    if (nextFrameBufferSize >= reader->currentFrameSize && nextFrameBufferSize > 0)
+                    if ((nextFrameBuffer != NULL) && (nextFrameBufferSize >= reader->currentFrameSize) && (nextFrameBufferSize > 0))
                     {
-                        memcpy (nextFrameBuffer, reader->currentFrameBuffer, reader->currentFrameSize);
+                        if ((reader->currentFrameSize > 0) &&
+                            (nextFrameBuffer != reader->currentFrameBuffer))
+                        {
+                            memcpy (nextFrameBuffer, reader->currentFrameBuffer, reader->currentFrameSize);
+                        }
                     }
                     else
                     {
@@ -524,10 +1004,34 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                     reader->currentFrameSize = endIndex;
                 }
 
+                if ((reader->prefixCallback != NULL) &&
+                    (reader->nbFilters == 0) &&
+                    (packetWasAlreadyAck == 0))
+                {
+                    ARSTREAM_Reader_UpdateFramePrefix (reader);
+                }
+
                 ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
                 if (ARSTREAM_NetworkHeaders_AckPacketAllFlagsSet (&(reader->ackPacket), header->fragmentsPerFrame))
                 {
-                    if (header->frameNumber != previousFNum)
+                    if ((reader->skipUntilFlushFrame == 1) &&
+                        ((header->frameFlags & ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME) == 0) &&
+                        ((int16_t)(header->frameNumber - previousFNum) > 1))
+                    {
+                        // A frame was lost since the last delivered one, this frame can not be decoded
+                        ARSAL_PRINT (ARSAL_PRINT_INFO, ARSTREAM_READER_TAG, "Missed frames before frame %d, waiting for a flush frame", header->frameNumber);
+                        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_SKIPPED, header->frameNumber, 0);
+                        ARSAL_Mutex_Lock (&(reader->statsMutex));
+                        reader->stats.nbFramesSkipped++;
+                        ARSAL_Mutex_Unlock (&(reader->statsMutex));
+                        reader->waitForFlushFrame = 1;
+                        skipCurrentFrame = 1;
+                        if (reader->keyFrameRequests == 1)
+                        {
+                            ARSTREAM_Reader_AskForKeyFrame (reader, ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_LOSS);
+                        }
+                    }
+                    else if (header->frameNumber != previousFNum)
                     {
                         int nbMissedFrame = 0;
                         int isFlushFrame = ((header->frameFlags & ARSTREAM_NETWORK_HEADERS_FLAG_FLUSH_FRAME) != 0) ? 1 : 0;
@@ -539,6 +1043,12 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                         }
                         previousFNum = header->frameNumber;
                         skipCurrentFrame = 1;
+                        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_COMPLETE, header->frameNumber, nbMissedFrame);
+                        ARSTREAM_Reader_FrameDelivered (reader, nbMissedFrame, isFlushFrame);
+                        ARSAL_Mutex_Lock (&(reader->statsMutex));
+                        reader->stats.nbFramesComplete++;
+                        ARSTREAM_Histogram_Add (reader->stats.reassemblyTimeHistogram, ARSAL_Time_ComputeTimespecMsTimeDiff (&(reader->currentFrameStartTime), &(reader->lastDeliveryTime)));
+                        ARSAL_Mutex_Unlock (&(reader->statsMutex));
                         // If we have filters, apply them !
                         if (reader->nbFilters > 0)
                         {
@@ -550,6 +1060,7 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                             uint8_t *outBuffer;
                             int outSize;
                             int maxOutSize;
+                            ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FILTERS_BEGIN, header->frameNumber, reader->nbFilters);
                             // Chain filters
                             for (i = 0; i < (reader->nbFilters - 1); i++)
                             {
@@ -575,7 +1086,9 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                                                            reader->outputFrameBufferSize);
                             filter->releaseBuffer(filter->context,
                                                   inBuffer);
+                            ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FILTERS_END, header->frameNumber, outSize);
                             reader->outputFrameBuffer = reader->callback (ARSTREAM_READER_CAUSE_FRAME_COMPLETE, reader->outputFrameBuffer, outSize, nbMissedFrame, isFlushFrame, &(reader->outputFrameBufferSize), reader->custom);
+                            ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_DELIVERED, header->frameNumber, outSize);
                             // Get a new buffer from first filter
                             filter = reader->filters[0];
                             reader->currentFrameBuffer = filter->getBuffer(filter->context,
@@ -585,6 +1098,7 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
                         else
                         {
                             reader->outputFrameBuffer = reader->callback (ARSTREAM_READER_CAUSE_FRAME_COMPLETE, reader->currentFrameBuffer, reader->currentFrameSize, nbMissedFrame, isFlushFrame, &(reader->outputFrameBufferSize), reader->custom);
+                            ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_FRAME_DELIVERED, header->frameNumber, reader->currentFrameSize);
                             reader->currentFrameBuffer = reader->outputFrameBuffer;
                             reader->currentFrameBufferSize = reader->outputFrameBufferSize;
                         }
@@ -606,6 +1120,7 @@ void* ARSTREAM_Reader_RunDataThread (void *ARSTREAM_Reader_t_Param)
     }
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Stream reader thread ended");
+    ARSTREAM_TRACE_THREAD_END ();
     reader->dataThreadStarted = 0;
     return (void *)0;
 }
@@ -617,10 +1132,15 @@ void* ARSTREAM_Reader_RunAckThread (void *ARSTREAM_Reader_t_Param)
         .highPacketsAck = 0,
         .lowPacketsAck = 0
     };
+    ARSTREAM_NetworkHeaders_KeyFrameRequest_t requestPacket;
+    ARSTREAM_NetworkHeaders_FrameSkip_t skipPacket;
     ARSTREAM_Reader_t *reader = (ARSTREAM_Reader_t *)ARSTREAM_Reader_t_Param;
     memset(&sendPacket, 0, sizeof(sendPacket));
+    memset(&requestPacket, 0, sizeof(requestPacket));
+    memset(&skipPacket, 0, sizeof(skipPacket));
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Ack sender thread running");
+    ARSTREAM_TRACE_THREAD_BEGIN ("ARSTREAM_Reader_Ack");
     reader->ackThreadStarted = 1;
 
     while (reader->threadsShouldStop == 0)
@@ -629,11 +1149,11 @@ void* ARSTREAM_Reader_RunAckThread (void *ARSTREAM_Reader_t_Param)
         ARSAL_Mutex_Lock (&(reader->ackSendMutex));
         if (reader->maxAckInterval <= 0)
         {
-            ARSAL_Cond_Wait (&(reader->ackSendCond), &(reader->ackSendMutex));
+            ARSTREAM_Clock_CondWait (&(reader->ackSendCond), &(reader->ackSendMutex));
         }
         else
         {
-            int retval = ARSAL_Cond_Timedwait (&(reader->ackSendCond), &(reader->ackSendMutex), reader->maxAckInterval);
+            int retval = ARSTREAM_Clock_CondTimedwait (&(reader->ackSendCond), &(reader->ackSendMutex), reader->maxAckInterval);
             if (retval == -1 && errno == ETIMEDOUT)
             {
                 isPeriodicAck = 1;
@@ -645,16 +1165,70 @@ void* ARSTREAM_Reader_RunAckThread (void *ARSTREAM_Reader_t_Param)
         if ((reader->maxAckInterval > 0) ||
             ((reader->maxAckInterval == 0) && (isPeriodicAck == 0)))
         {
+            int isSkipped;
             ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
-            sendPacket.frameNumber = htods  (reader->ackPacket.frameNumber);
-            sendPacket.highPacketsAck = htodll (reader->ackPacket.highPacketsAck);
-            sendPacket.lowPacketsAck  = htodll (reader->ackPacket.lowPacketsAck);
+            isSkipped = reader->currentFrameIsSkipped;
+            if (isSkipped == 1)
+            {
+                skipPacket.magic = htodl (ARSTREAM_NETWORK_HEADERS_FRAME_SKIP_MAGIC);
+                skipPacket.frameNumber = htods (reader->ackPacket.frameNumber);
+            }
+            else
+            {
+                sendPacket.frameNumber = htods  (reader->ackPacket.frameNumber);
+                sendPacket.highPacketsAck = htodll (reader->ackPacket.highPacketsAck);
+                sendPacket.lowPacketsAck  = htodll (reader->ackPacket.lowPacketsAck);
+                ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_READER_ACK_SENT, reader->ackPacket.frameNumber, ARSTREAM_NetworkHeaders_AckPacketCountSet (&(reader->ackPacket), reader->currentFrameFragmentsPerFrame));
+            }
             ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
-            ARNETWORK_Manager_SendData (reader->manager, reader->ackBufferID, (uint8_t *)&sendPacket, sizeof (sendPacket), NULL, ARSTREAM_Reader_NetworkCallback, 1);
+            ARSAL_Mutex_Lock (&(reader->statsMutex));
+            reader->stats.nbAcksSent++;
+            ARSAL_Mutex_Unlock (&(reader->statsMutex));
+            if (isSkipped == 1)
+            {
+                ARSTREAM_Transport_Send (reader->transport, (uint8_t *)&skipPacket, sizeof (skipPacket), NULL);
+            }
+            else
+            {
+                ARSTREAM_Transport_Send (reader->transport, (uint8_t *)&sendPacket, sizeof (sendPacket), NULL);
+            }
+        }
+
+        /* Send (or repeat) the pending key frame request, at most once per keyFrameRequestIntervalMs */
+        int sendRequest = 0;
+        ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
+        if (__atomic_exchange_n (&(reader->keyFrameRequestedByApplication), 0, __ATOMIC_ACQ_REL) != 0)
+        {
+            ARSTREAM_Reader_AskForKeyFrame (reader, ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_APPLICATION);
+        }
+        if (reader->keyFrameRequestPending == 1)
+        {
+            struct timespec now;
+            ARSTREAM_Clock_GetTime (&now);
+            if ((reader->keyFrameRequestWasSent == 0) ||
+                (ARSAL_Time_ComputeTimespecMsTimeDiff (&(reader->lastKeyFrameRequestTime), &now) >= reader->keyFrameRequestIntervalMs))
+            {
+                requestPacket.magic = htodl (ARSTREAM_NETWORK_HEADERS_KEY_FRAME_REQUEST_MAGIC);
+                requestPacket.frameNumber = htods (reader->ackPacket.frameNumber);
+                requestPacket.reason = reader->keyFrameRequestReason;
+                reader->keyFrameRequestWasSent = 1;
+                reader->lastKeyFrameRequestTime = now;
+                ARSAL_Mutex_Lock (&(reader->statsMutex));
+                reader->freezeStats.nbKeyFrameRequests++;
+                ARSAL_Mutex_Unlock (&(reader->statsMutex));
+                sendRequest = 1;
+            }
         }
+        ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
+        if (sendRequest == 1)
+        {
+            ARSTREAM_Transport_Send (reader->transport, (uint8_t *)&requestPacket, sizeof (requestPacket), NULL);
+        }
+        ARSTREAM_Transport_Flush (reader->transport);
     }
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER_TAG, "Ack sender thread ended");
+    ARSTREAM_TRACE_THREAD_END ();
     reader->ackThreadStarted = 0;
     return (void *)0;
 }
@@ -669,13 +1243,13 @@ float ARSTREAM_Reader_GetEstimatedEfficiency (ARSTREAM_Reader_t *reader)
     uint32_t totalPackets = 0;
     uint32_t usefulPackets = 0;
     int i;
-    ARSAL_Mutex_Lock (&(reader->ackPacketMutex));
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
     for (i = 0; i < ARSTREAM_READER_EFFICIENCY_AVERAGE_NB_FRAMES; i++)
     {
         totalPackets += reader->efficiency_nbTotal [i];
         usefulPackets += reader->efficiency_nbUseful [i];
     }
-    ARSAL_Mutex_Unlock (&(reader->ackPacketMutex));
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
     if (totalPackets == 0)
     {
         retVal = 0.0f; // We didn't receive anything yet ... not really efficient
@@ -731,3 +1305,217 @@ eARSTREAM_ERROR ARSTREAM_Reader_AddFilter (ARSTREAM_Reader_t *reader, ARSTREAM_F
     }
     return err;
 }
+
+eARSTREAM_ERROR ARSTREAM_Reader_SetPartialFrameDelivery (ARSTREAM_Reader_t *reader, int enable, int32_t frameTimeoutMs)
+{
+    if (reader == NULL || frameTimeoutMs < 0)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    reader->partialFrameDelivery = (enable != 0) ? 1 : 0;
+    reader->partialFrameTimeoutMs = frameTimeoutMs;
+    return ARSTREAM_OK;
+}
+
+int ARSTREAM_Reader_GetMissingRegions (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_MissingRegion_t *regions, int maxRegions)
+{
+    int i;
+    if ((reader == NULL) ||
+        (maxRegions < 0) ||
+        ((regions == NULL) && (maxRegions > 0)))
+    {
+        return -1;
+    }
+
+    for (i = 0; (i < reader->nbMissingRegions) && (i < maxRegions); i++)
+    {
+        regions[i] = reader->missingRegions[i];
+    }
+    return reader->nbMissingRegions;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_SetFramePrefixCallback (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_FramePrefixCallback_t prefixCallback)
+{
+    if (reader == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    reader->prefixCallback = prefixCallback;
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_SetSkipUntilFlushFrame (ARSTREAM_Reader_t *reader, int enable)
+{
+    if (reader == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    reader->skipUntilFlushFrame = (enable != 0) ? 1 : 0;
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_SetKeyFrameRequests (ARSTREAM_Reader_t *reader, int enable, int minIntervalMs)
+{
+    if (reader == NULL || minIntervalMs <= 0)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    reader->keyFrameRequests = (enable != 0) ? 1 : 0;
+    reader->keyFrameRequestIntervalMs = minIntervalMs;
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_RequestKeyFrame (ARSTREAM_Reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    // The ackPacketMutex may be held by the caller (frame complete callback): the ack thread takes the request
+    __atomic_store_n (&(reader->keyFrameRequestedByApplication), 1, __ATOMIC_RELEASE);
+
+    ARSAL_Mutex_Lock (&(reader->ackSendMutex));
+    ARSTREAM_Clock_CondSignal (&(reader->ackSendCond));
+    ARSAL_Mutex_Unlock (&(reader->ackSendMutex));
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_GetFreezeStats (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_FreezeStats_t *stats)
+{
+    if ((reader == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    *stats = reader->freezeStats;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_GetStats (ARSTREAM_Reader_t *reader, ARSTREAM_Reader_Stats_t *stats)
+{
+    if ((reader == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    *stats = reader->stats;
+    stats->freezeStats = reader->freezeStats;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    stats->efficiency = ARSTREAM_Reader_GetEstimatedEfficiency (reader);
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_SetImpairment (ARSTREAM_Reader_t *reader, const ARSTREAM_Impairment_Config_t *config)
+{
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    ARSTREAM_Transport_t *impaired;
+
+    if (reader == NULL || config == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    /* Already impaired : only replace the configuration */
+    if (ARSTREAM_Transport_SetImpairmentConfig (reader->transport, config) == ARSTREAM_OK)
+    {
+        return ARSTREAM_OK;
+    }
+
+    impaired = ARSTREAM_Transport_NewImpairment (reader->transport, config, &err);
+    if (impaired != NULL)
+    {
+        reader->transport = impaired;
+    }
+    return err;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_GetImpairmentStats (ARSTREAM_Reader_t *reader, ARSTREAM_Impairment_Stats_t *stats)
+{
+    if (reader == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    return ARSTREAM_Transport_GetImpairmentStats (reader->transport, stats);
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_StartCapture (ARSTREAM_Reader_t *reader, const char *path)
+{
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+
+    if ((reader == NULL) ||
+        (path == NULL) ||
+        (reader->capture != NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (reader->dataThreadStarted != 0 ||
+        reader->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    reader->capture = ARSTREAM_CaptureFile_New (path, reader->maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &err);
+    return err;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_GetCaptureStats (ARSTREAM_Reader_t *reader, ARSTREAM_Capture_Stats_t *stats)
+{
+    if ((reader == NULL) ||
+        (stats == NULL) ||
+        (reader->capture == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ARSTREAM_CaptureFile_GetStats (reader->capture, stats);
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader_GetReplayStats (ARSTREAM_Reader_t *reader, ARSTREAM_Capture_Stats_t *stats)
+{
+    if (reader == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    return ARSTREAM_Transport_GetReplayStats (reader->replayTransport, stats);
+}
@@ -0,0 +1,1197 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Reader2.c
+ * @brief Stream reader over UDP, using an RTP-like protocol (H.264 payload format, see RFC6184)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <sys/time.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_NetworkHeaders.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_Reader2.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Socket.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * Tag for ARSAL_PRINT
+ */
+#define ARSTREAM_READER2_TAG "ARSTREAM_Reader2"
+
+/**
+ * Timeout of the socket reads, to check the thread stop flag
+ */
+#define ARSTREAM_READER2_DATAREAD_TIMEOUT_MS (100)
+
+/**
+ * Requested socket receive buffer size, to absorb the packet bursts of large access units
+ */
+#define ARSTREAM_READER2_SOCKET_RCVBUF_SIZE (600 * 1024)
+
+/**
+ * RTP clock rate for video
+ */
+#define ARSTREAM_READER2_RTP_CLOCKRATE (90000)
+
+#define ARSTREAM_READER2_RTP_VERSION_MASK (0xC000)
+#define ARSTREAM_READER2_RTP_VERSION (0x8000)
+#define ARSTREAM_READER2_RTP_MARKER_FLAG (0x0080)
+
+/**
+ * Size of the start code prefixed to each NAL unit in the output access units
+ */
+#define ARSTREAM_READER2_START_CODE_SIZE (4)
+
+/**
+ * Sequence number validation (see RFC3550 A.1)
+ * A jump of more than MAX_DROPOUT packets forward, or more than MAX_MISORDER packets backward, is only
+ * accepted once confirmed by the next packet: the sender restarted without changing its SSRC
+ */
+#define ARSTREAM_READER2_MAX_DROPOUT (3000)
+#define ARSTREAM_READER2_MAX_MISORDER (100)
+
+/**
+ * Period of the clock synchronization exchanges
+ * The first exchanges use a shorter period to get a first estimate quickly
+ */
+#define ARSTREAM_READER2_CLOCK_SYNC_PERIOD_MS (1000)
+#define ARSTREAM_READER2_CLOCK_SYNC_STARTUP_PERIOD_MS (100)
+#define ARSTREAM_READER2_CLOCK_SYNC_STARTUP_EXCHANGES (8)
+
+/**
+ * Number of clock exchanges kept for the offset/skew estimation
+ */
+#define ARSTREAM_READER2_CLOCK_SAMPLES (16)
+
+/**
+ * Minimum number of good samples, and minimum time span of these samples, needed to estimate the skew
+ */
+#define ARSTREAM_READER2_CLOCK_SKEW_MIN_SAMPLES (4)
+#define ARSTREAM_READER2_CLOCK_SKEW_MIN_SPAN_US (4000000)
+
+/**
+ * Skew estimates above this value are considered bogus and ignored
+ */
+#define ARSTREAM_READER2_CLOCK_SKEW_MAX_PPM (500.0)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief One clock exchange with the sender
+ */
+typedef struct {
+    uint64_t localTimeUs; /**< Middle of the exchange, on the reader clock */
+    int64_t offsetUs; /**< Sender clock minus reader clock */
+    uint32_t rttUs; /**< Round trip time of the exchange, sender processing time excluded */
+} ARSTREAM_Reader2_ClockSample_t;
+
+struct ARSTREAM_Reader2_t {
+    /* Configuration on New */
+    ARSTREAM_Reader2_AuCallback_t callback;
+    uint32_t maxPacketSize;
+    void *custom;
+
+    /* Network */
+    int dataSocket;
+
+    /* Current access unit */
+    uint8_t *auBuffer;
+    uint32_t auBufferSize;
+    uint32_t auSize;
+    int auInProgress;
+    int auIsMissingPackets;
+    int auIsSkipped; // The buffer was too small
+    uint32_t auRtpTimestamp;
+    uint32_t fuNaluStart; // Offset of the FU-A NAL unit being reassembled
+    int fuInProgress;
+
+    /* Sequence and timestamp tracking */
+    int hasReceivedPacket;
+    uint32_t ssrc;
+    uint16_t expectedSeqNum;
+    int hasBadSeqNum;
+    uint16_t badSeqNum; // Sequence number that would confirm a large jump
+    uint32_t lastRtpTimestamp;
+    uint64_t extendedRtpTimestamp;
+
+    /* Clock synchronization */
+    ARSAL_Mutex_t clockMutex;
+    struct sockaddr_in senderSin;
+    int hasSenderAddr;
+    uint64_t lastClockRequestTime;
+    uint64_t lastClockOriginate;
+    ARSTREAM_Reader2_ClockSample_t clockSamples [ARSTREAM_READER2_CLOCK_SAMPLES];
+    uint32_t nbClockExchanges;
+    int clockIsSynchronized;
+    uint64_t clockRefTimeUs;
+    int64_t clockRefOffsetUs;
+    double clockSkew;
+    uint32_t clockMinRttUs;
+
+    /* Reports */
+    ARSAL_Mutex_t statsMutex;
+    ARSTREAM_Reader2_Stats_t stats;
+    uint16_t baseSeqNum;
+    uint16_t maxSeqNum;
+    uint32_t seqNumCycles;
+    uint32_t lastTransit;
+    uint32_t jitter; // RTP timestamp units, scaled by 16 (see RFC3550 A.8)
+    uint32_t expectedPrior;
+    uint32_t receivedPrior;
+    uint64_t bytesSinceReceiverReport;
+    uint32_t lastSenderReport; // Middle 32 bits of the last sender report NTP timestamp
+    uint64_t lastSenderReportTime;
+
+    /* Thread status */
+    int threadsShouldStop;
+    int dataThreadStarted;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Makes sure that the access unit buffer can hold a given size
+ * The application is asked for a larger buffer if needed
+ * @param reader The reader
+ * @param size The needed size
+ * @return 1 if the buffer is large enough, 0 if the current access unit must be skipped
+ */
+static int ARSTREAM_Reader2_EnsureCapacity (ARSTREAM_Reader2_t *reader, uint32_t size);
+
+/**
+ * @brief Appends a start code and (a part of) a NAL unit to the current access unit
+ * @param reader The reader
+ * @param naluHeader Pointer to the NAL unit header byte, or NULL to append without start code and header
+ * @param data Data to append after the header
+ * @param dataSize Size of data
+ */
+static void ARSTREAM_Reader2_AppendNalu (ARSTREAM_Reader2_t *reader, const uint8_t *naluHeader, const uint8_t *data, uint32_t dataSize);
+
+/**
+ * @brief Gives the current access unit to the application
+ * @param reader The reader
+ */
+static void ARSTREAM_Reader2_DeliverAu (ARSTREAM_Reader2_t *reader);
+
+/**
+ * @brief Processes the payload of a received packet
+ * @param reader The reader
+ * @param payload The payload of the packet
+ * @param payloadSize The size of the payload
+ */
+static void ARSTREAM_Reader2_ProcessPayload (ARSTREAM_Reader2_t *reader, const uint8_t *payload, uint32_t payloadSize);
+
+/**
+ * @brief Gets the current time of the reader clock
+ * @return The current time, in microseconds
+ */
+static uint64_t ARSTREAM_Reader2_GetTimeUs (void);
+
+/**
+ * @brief Sends a clock request to the sender if the last one is old enough
+ * @param reader The reader
+ */
+static void ARSTREAM_Reader2_SendClockRequest (ARSTREAM_Reader2_t *reader);
+
+/**
+ * @brief Processes a clock frame sent back by the sender, and updates the clock estimation
+ * @param reader The reader
+ * @param clockFrame The received clock frame
+ * @param receptionTime Reception time of the clock frame
+ */
+static void ARSTREAM_Reader2_ProcessClockFrame (ARSTREAM_Reader2_t *reader, ARSTREAM_NetworkHeaders_ClockFrame_t *clockFrame, uint64_t receptionTime);
+
+/**
+ * @brief Updates the offset and skew estimation from the recent clock samples
+ * @param reader The reader
+ * @warning Must be called with the clockMutex locked
+ */
+static void ARSTREAM_Reader2_UpdateClockEstimation (ARSTREAM_Reader2_t *reader);
+
+/**
+ * @brief Gets the estimated clock offset at a given time
+ * @param reader The reader
+ * @param localTimeUs The time on the reader clock
+ * @return The sender clock minus reader clock, in microseconds
+ * @warning Must be called with the clockMutex locked, on a synchronized reader
+ */
+static int64_t ARSTREAM_Reader2_GetClockOffset (ARSTREAM_Reader2_t *reader, uint64_t localTimeUs);
+
+/**
+ * @brief Updates the reception statistics with a new data packet
+ * @param reader The reader
+ * @param header The RTP header of the packet
+ * @param packetSize The size of the packet
+ * @param receptionTime Reception time of the packet
+ */
+static void ARSTREAM_Reader2_UpdateReceptionStats (ARSTREAM_Reader2_t *reader, ARSTREAM_NetworkHeaders_DataHeader2_t *header, uint32_t packetSize, uint64_t receptionTime);
+
+/**
+ * @brief Sends a receiver report if enough data was received since the last one
+ * @param reader The reader
+ */
+static void ARSTREAM_Reader2_SendReceiverReport (ARSTREAM_Reader2_t *reader);
+
+/**
+ * @brief Forgets everything known about the current stream source, after a sender restart
+ * The access unit in progress is delivered as incomplete, and the sequence tracking,
+ * reception statistics and clock synchronization start over with the next packet
+ * @param reader The reader
+ */
+static void ARSTREAM_Reader2_ResetSource (ARSTREAM_Reader2_t *reader);
+
+/*
+ * Internal functions implementation
+ */
+
+static int ARSTREAM_Reader2_EnsureCapacity (ARSTREAM_Reader2_t *reader, uint32_t size)
+{
+    if (reader->auIsSkipped == 1)
+    {
+        return 0;
+    }
+    if (size > reader->auBufferSize)
+    {
+        uint32_t newBufferSize = size;
+        uint32_t dummy;
+        uint8_t *newBuffer = reader->callback (ARSTREAM_READER2_CAUSE_AU_BUFFER_TOO_SMALL, reader->auBuffer, reader->auSize, 0, &newBufferSize, reader->custom);
+        if ((newBuffer != NULL) &&
+            (newBufferSize >= size))
+        {
+            memcpy (newBuffer, reader->auBuffer, reader->auSize);
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Access unit buffer is too small, skipping the access unit");
+            reader->auIsSkipped = 1;
+        }
+        reader->callback (ARSTREAM_READER2_CAUSE_AU_COPY_COMPLETE, reader->auBuffer, reader->auSize, 0, &dummy, reader->custom);
+        reader->auBuffer = newBuffer;
+        reader->auBufferSize = (newBuffer != NULL) ? newBufferSize : 0;
+    }
+    return (reader->auIsSkipped == 1) ? 0 : 1;
+}
+
+static void ARSTREAM_Reader2_AppendNalu (ARSTREAM_Reader2_t *reader, const uint8_t *naluHeader, const uint8_t *data, uint32_t dataSize)
+{
+    uint32_t size = dataSize;
+    if (naluHeader != NULL)
+    {
+        size += ARSTREAM_READER2_START_CODE_SIZE + 1;
+    }
+    if (ARSTREAM_Reader2_EnsureCapacity (reader, reader->auSize + size) == 1)
+    {
+        uint8_t *dst = &(reader->auBuffer [reader->auSize]);
+        if (naluHeader != NULL)
+        {
+            dst[0] = 0;
+            dst[1] = 0;
+            dst[2] = 0;
+            dst[3] = 1;
+            dst[4] = *naluHeader;
+            dst += ARSTREAM_READER2_START_CODE_SIZE + 1;
+        }
+        memcpy (dst, data, dataSize);
+        reader->auSize += size;
+    }
+}
+
+static void ARSTREAM_Reader2_DeliverAu (ARSTREAM_Reader2_t *reader)
+{
+    // Do not deliver a truncated NAL unit
+    if (reader->fuInProgress == 1)
+    {
+        reader->auSize = reader->fuNaluStart;
+        reader->auIsMissingPackets = 1;
+    }
+    if ((reader->auIsSkipped == 0) &&
+        (reader->auSize > 0))
+    {
+        eARSTREAM_READER2_CAUSE cause = ARSTREAM_READER2_CAUSE_AU_COMPLETE;
+        uint64_t timestampUs = reader->extendedRtpTimestamp * 1000000 / ARSTREAM_READER2_RTP_CLOCKRATE;
+        if (reader->auIsMissingPackets == 1)
+        {
+            cause = ARSTREAM_READER2_CAUSE_AU_INCOMPLETE;
+        }
+        reader->auBuffer = reader->callback (cause, reader->auBuffer, reader->auSize, timestampUs, &(reader->auBufferSize), reader->custom);
+    }
+    reader->auSize = 0;
+    reader->auInProgress = 0;
+    reader->auIsMissingPackets = 0;
+    reader->auIsSkipped = (reader->auBuffer == NULL) ? 1 : 0;
+    reader->fuInProgress = 0;
+}
+
+static void ARSTREAM_Reader2_ProcessPayload (ARSTREAM_Reader2_t *reader, const uint8_t *payload, uint32_t payloadSize)
+{
+    uint8_t naluType;
+    if (payloadSize < 1)
+    {
+        return;
+    }
+    naluType = payload[0] & 0x1F;
+
+    if (naluType == ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_STAPA)
+    {
+        uint32_t offset = 1;
+        while (offset + 2 < payloadSize)
+        {
+            uint32_t naluSize = (payload[offset] << 8) | payload[offset+1];
+            offset += 2;
+            if ((naluSize == 0) ||
+                (offset + naluSize > payloadSize))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_READER2_TAG, "Invalid STAP-A packet");
+                reader->auIsMissingPackets = 1;
+                break;
+            }
+            ARSTREAM_Reader2_AppendNalu (reader, &payload[offset], &payload[offset+1], naluSize - 1);
+            offset += naluSize;
+        }
+    }
+    else if (naluType == ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_FUA)
+    {
+        uint8_t fuHeader;
+        if (payloadSize < 2)
+        {
+            return;
+        }
+        fuHeader = payload[1];
+        if ((fuHeader & 0x80) != 0)
+        {
+            // Start of a fragmented NAL unit : rebuild its header
+            uint8_t naluHeader = (payload[0] & 0xE0) | (fuHeader & 0x1F);
+            reader->fuNaluStart = reader->auSize;
+            reader->fuInProgress = 1;
+            ARSTREAM_Reader2_AppendNalu (reader, &naluHeader, &payload[2], payloadSize - 2);
+        }
+        else if (reader->fuInProgress == 1)
+        {
+            ARSTREAM_Reader2_AppendNalu (reader, NULL, &payload[2], payloadSize - 2);
+        }
+        else
+        {
+            // The beginning of this NAL unit was lost
+            reader->auIsMissingPackets = 1;
+        }
+        if ((fuHeader & 0x40) != 0)
+        {
+            reader->fuInProgress = 0;
+        }
+    }
+    else if ((naluType > 0) &&
+             (naluType < ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_STAPA))
+    {
+        // Single NAL unit packet
+        ARSTREAM_Reader2_AppendNalu (reader, &payload[0], &payload[1], payloadSize - 1);
+    }
+    else
+    {
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_READER2_TAG, "Unsupported NAL unit type %d", naluType);
+    }
+}
+
+static uint64_t ARSTREAM_Reader2_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSAL_Time_GetTime (&now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+static void ARSTREAM_Reader2_SendClockRequest (ARSTREAM_Reader2_t *reader)
+{
+    ARSTREAM_NetworkHeaders_ClockFrame_t clockFrame;
+    uint64_t now = ARSTREAM_Reader2_GetTimeUs ();
+    uint64_t periodUs = ARSTREAM_READER2_CLOCK_SYNC_PERIOD_MS * 1000;
+    if (reader->nbClockExchanges < ARSTREAM_READER2_CLOCK_SYNC_STARTUP_EXCHANGES)
+    {
+        periodUs = ARSTREAM_READER2_CLOCK_SYNC_STARTUP_PERIOD_MS * 1000;
+    }
+    if ((reader->hasSenderAddr == 0) ||
+        ((reader->lastClockRequestTime != 0) &&
+         (now - reader->lastClockRequestTime < periodUs)))
+    {
+        return;
+    }
+
+    memset (&clockFrame, 0, sizeof (clockFrame));
+    clockFrame.originateTimestampH = htonl ((uint32_t)(now >> 32));
+    clockFrame.originateTimestampL = htonl ((uint32_t)(now & 0xFFFFFFFF));
+    // A late answer to a previous request will not match, and will be ignored
+    reader->lastClockOriginate = now;
+    reader->lastClockRequestTime = now;
+    if (ARSAL_Socket_Sendto (reader->dataSocket, &clockFrame, sizeof (clockFrame), 0, (struct sockaddr *)&(reader->senderSin), sizeof (reader->senderSin)) < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Clock request send error : %s", strerror (errno));
+    }
+}
+
+static void ARSTREAM_Reader2_ProcessClockFrame (ARSTREAM_Reader2_t *reader, ARSTREAM_NetworkHeaders_ClockFrame_t *clockFrame, uint64_t receptionTime)
+{
+    uint64_t originate = ((uint64_t)ntohl (clockFrame->originateTimestampH) << 32) + ntohl (clockFrame->originateTimestampL);
+    uint64_t receive = ((uint64_t)ntohl (clockFrame->receiveTimestampH) << 32) + ntohl (clockFrame->receiveTimestampL);
+    uint64_t transmit = ((uint64_t)ntohl (clockFrame->transmitTimestampH) << 32) + ntohl (clockFrame->transmitTimestampL);
+    ARSTREAM_Reader2_ClockSample_t *sample;
+    int64_t rtt;
+
+    if ((reader->lastClockOriginate == 0) ||
+        (originate != reader->lastClockOriginate) ||
+        (transmit < receive))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Ignoring unexpected clock frame");
+        return;
+    }
+    reader->lastClockOriginate = 0;
+
+    rtt = (int64_t)(receptionTime - originate) - (int64_t)(transmit - receive);
+    if (rtt < 0)
+    {
+        rtt = 0;
+    }
+    else if (rtt > UINT32_MAX)
+    {
+        rtt = UINT32_MAX;
+    }
+
+    ARSAL_Mutex_Lock (&(reader->clockMutex));
+    sample = &(reader->clockSamples [reader->nbClockExchanges % ARSTREAM_READER2_CLOCK_SAMPLES]);
+    sample->localTimeUs = originate + ((receptionTime - originate) / 2);
+    sample->offsetUs = (((int64_t)(receive - originate)) + ((int64_t)(transmit - receptionTime))) / 2;
+    sample->rttUs = (uint32_t)rtt;
+    reader->nbClockExchanges++;
+    ARSTREAM_Reader2_UpdateClockEstimation (reader);
+    ARSAL_Mutex_Unlock (&(reader->clockMutex));
+}
+
+static void ARSTREAM_Reader2_UpdateClockEstimation (ARSTREAM_Reader2_t *reader)
+{
+    uint32_t nbSamples = reader->nbClockExchanges;
+    uint32_t i, nbGood = 0;
+    ARSTREAM_Reader2_ClockSample_t *best = &(reader->clockSamples [0]);
+    uint32_t minRtt = best->rttUs;
+    uint32_t maxGoodRtt;
+    uint64_t firstGoodTime = UINT64_MAX, lastGoodTime = 0;
+    uint64_t timeBase;
+    double sumT = 0., sumO = 0., sumTT = 0., sumTO = 0.;
+
+    if (nbSamples > ARSTREAM_READER2_CLOCK_SAMPLES)
+    {
+        nbSamples = ARSTREAM_READER2_CLOCK_SAMPLES;
+    }
+
+    /* Exchanges with the lowest round trip times have the most symmetric delays, so the best offsets */
+    for (i = 1; i < nbSamples; i++)
+    {
+        ARSTREAM_Reader2_ClockSample_t *sample = &(reader->clockSamples [i]);
+        if ((sample->rttUs < minRtt) ||
+            ((sample->rttUs == minRtt) &&
+             (sample->localTimeUs > best->localTimeUs)))
+        {
+            minRtt = sample->rttUs;
+            best = sample;
+        }
+    }
+    maxGoodRtt = minRtt + (minRtt / 2) + 500;
+
+    /* Skew : linear regression of the offset over the good samples */
+    timeBase = best->localTimeUs;
+    for (i = 0; i < nbSamples; i++)
+    {
+        ARSTREAM_Reader2_ClockSample_t *sample = &(reader->clockSamples [i]);
+        if (sample->rttUs <= maxGoodRtt)
+        {
+            double t = (double)((int64_t)(sample->localTimeUs - timeBase));
+            double o = (double)(sample->offsetUs - best->offsetUs);
+            sumT += t;
+            sumO += o;
+            sumTT += t * t;
+            sumTO += t * o;
+            nbGood++;
+            if (sample->localTimeUs < firstGoodTime)
+            {
+                firstGoodTime = sample->localTimeUs;
+            }
+            if (sample->localTimeUs > lastGoodTime)
+            {
+                lastGoodTime = sample->localTimeUs;
+            }
+        }
+    }
+
+    reader->clockRefTimeUs = best->localTimeUs;
+    reader->clockRefOffsetUs = best->offsetUs;
+    reader->clockMinRttUs = minRtt;
+    if ((nbGood >= ARSTREAM_READER2_CLOCK_SKEW_MIN_SAMPLES) &&
+        (lastGoodTime - firstGoodTime >= ARSTREAM_READER2_CLOCK_SKEW_MIN_SPAN_US))
+    {
+        double n = (double)nbGood;
+        double denom = (n * sumTT) - (sumT * sumT);
+        if (denom > 0.)
+        {
+            double skew = ((n * sumTO) - (sumT * sumO)) / denom;
+            if ((skew * 1000000. <= ARSTREAM_READER2_CLOCK_SKEW_MAX_PPM) &&
+                (skew * 1000000. >= -ARSTREAM_READER2_CLOCK_SKEW_MAX_PPM))
+            {
+                // Use the regression line rather than the best sample, it averages the remaining jitter
+                double meanT = sumT / n;
+                double meanO = sumO / n;
+                reader->clockSkew = skew;
+                reader->clockRefTimeUs = timeBase + (int64_t)meanT;
+                reader->clockRefOffsetUs = best->offsetUs + (int64_t)meanO;
+            }
+        }
+    }
+    reader->clockIsSynchronized = 1;
+}
+
+static int64_t ARSTREAM_Reader2_GetClockOffset (ARSTREAM_Reader2_t *reader, uint64_t localTimeUs)
+{
+    double elapsed = (double)((int64_t)(localTimeUs - reader->clockRefTimeUs));
+    return reader->clockRefOffsetUs + (int64_t)(reader->clockSkew * elapsed);
+}
+
+static void ARSTREAM_Reader2_UpdateReceptionStats (ARSTREAM_Reader2_t *reader, ARSTREAM_NetworkHeaders_DataHeader2_t *header, uint32_t packetSize, uint64_t receptionTime)
+{
+    uint16_t seqNum = ntohs (header->seqNum);
+    uint32_t arrival = (uint32_t)(receptionTime * ARSTREAM_READER2_RTP_CLOCKRATE / 1000000);
+    uint32_t transit = arrival - ntohl (header->timestamp);
+
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    if (reader->stats.packetsReceived == 0)
+    {
+        reader->baseSeqNum = seqNum;
+        reader->maxSeqNum = seqNum;
+    }
+    else
+    {
+        int32_t d = (int32_t)(transit - reader->lastTransit);
+        if (d < 0)
+        {
+            d = -d;
+        }
+        reader->jitter += d - ((reader->jitter + 8) >> 4);
+
+        if ((int16_t)(seqNum - reader->maxSeqNum) > 0)
+        {
+            if (seqNum < reader->maxSeqNum)
+            {
+                reader->seqNumCycles += 0x10000;
+            }
+            reader->maxSeqNum = seqNum;
+        }
+    }
+    reader->lastTransit = transit;
+    reader->stats.packetsReceived++;
+    reader->stats.bytesReceived += packetSize - sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t);
+    reader->stats.extHighestSeqNum = reader->seqNumCycles + reader->maxSeqNum;
+    reader->stats.cumulativeLost = (int32_t)(reader->stats.extHighestSeqNum - reader->baseSeqNum + 1 - reader->stats.packetsReceived);
+    reader->stats.jitterUs = (uint32_t)((uint64_t)(reader->jitter >> 4) * 1000000 / ARSTREAM_READER2_RTP_CLOCKRATE);
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+
+    reader->bytesSinceReceiverReport += packetSize + ARSTREAM_NETWORK_UDP_HEADER_SIZE + ARSTREAM_NETWORK_IP_HEADER_SIZE;
+}
+
+static void ARSTREAM_Reader2_SendReceiverReport (ARSTREAM_Reader2_t *reader)
+{
+    ARSTREAM_NetworkHeaders_ReceiverReport_t report;
+    uint32_t expected, expectedInterval, receivedInterval, fraction = 0, dlsr = 0;
+    int32_t lostInterval, cumulativeLost;
+    if ((reader->hasSenderAddr == 0) ||
+        (reader->bytesSinceReceiverReport < (sizeof (report) + ARSTREAM_NETWORK_UDP_HEADER_SIZE + ARSTREAM_NETWORK_IP_HEADER_SIZE) * ARSTREAM_NETWORK_HEADERS2_RTCP_BANDWIDTH_RATIO))
+    {
+        return;
+    }
+    reader->bytesSinceReceiverReport = 0;
+
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    expected = reader->stats.extHighestSeqNum - reader->baseSeqNum + 1;
+    expectedInterval = expected - reader->expectedPrior;
+    receivedInterval = reader->stats.packetsReceived - reader->receivedPrior;
+    lostInterval = (int32_t)(expectedInterval - receivedInterval);
+    reader->expectedPrior = expected;
+    reader->receivedPrior = reader->stats.packetsReceived;
+    if ((expectedInterval > 0) &&
+        (lostInterval > 0))
+    {
+        fraction = ((uint32_t)lostInterval << 8) / expectedInterval;
+        if (fraction > 255)
+        {
+            fraction = 255;
+        }
+    }
+    cumulativeLost = reader->stats.cumulativeLost;
+    if (cumulativeLost > 0x7FFFFF)
+    {
+        cumulativeLost = 0x7FFFFF;
+    }
+    else if (cumulativeLost < -0x800000)
+    {
+        cumulativeLost = -0x800000;
+    }
+    if (reader->lastSenderReport != 0)
+    {
+        dlsr = (uint32_t)((ARSTREAM_Reader2_GetTimeUs () - reader->lastSenderReportTime) * 65536 / 1000000);
+    }
+
+    report.flags = ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_SINGLE_REPORT;
+    report.packetType = ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_RR;
+    report.length = htons (sizeof (report) / 4 - 1);
+    report.ssrc = htonl (ARSTREAM_NETWORK_HEADERS2_RTCP_RECEIVER_SSRC);
+    report.sourceSsrc = htonl (reader->ssrc);
+    report.lost = htonl ((fraction << 24) | ((uint32_t)cumulativeLost & 0xFFFFFF));
+    report.extHighestSeqNum = htonl (reader->stats.extHighestSeqNum);
+    report.interarrivalJitter = htonl (reader->jitter >> 4);
+    report.lsr = htonl (reader->lastSenderReport);
+    report.dlsr = htonl (dlsr);
+    reader->stats.fractionLost = (double)fraction / 256.;
+    reader->stats.nbReceiverReports++;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+
+    if (ARSAL_Socket_Sendto (reader->dataSocket, &report, sizeof (report), 0, (struct sockaddr *)&(reader->senderSin), sizeof (reader->senderSin)) < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Receiver report send error : %s", strerror (errno));
+    }
+}
+
+static void ARSTREAM_Reader2_ResetSource (ARSTREAM_Reader2_t *reader)
+{
+    if (reader->auInProgress == 1)
+    {
+        reader->auIsMissingPackets = 1;
+        ARSTREAM_Reader2_DeliverAu (reader);
+    }
+    reader->hasReceivedPacket = 0;
+    reader->hasBadSeqNum = 0;
+
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    memset (&(reader->stats), 0, sizeof (reader->stats));
+    reader->baseSeqNum = 0;
+    reader->maxSeqNum = 0;
+    reader->seqNumCycles = 0;
+    reader->lastTransit = 0;
+    reader->jitter = 0;
+    reader->expectedPrior = 0;
+    reader->receivedPrior = 0;
+    reader->lastSenderReport = 0;
+    reader->lastSenderReportTime = 0;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    reader->bytesSinceReceiverReport = 0;
+
+    /* The new sender may not share the clock of the previous one */
+    ARSAL_Mutex_Lock (&(reader->clockMutex));
+    reader->lastClockRequestTime = 0;
+    reader->lastClockOriginate = 0;
+    reader->nbClockExchanges = 0;
+    reader->clockIsSynchronized = 0;
+    reader->clockSkew = 0.;
+    ARSAL_Mutex_Unlock (&(reader->clockMutex));
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Reader2_t* ARSTREAM_Reader2_New (const char *ifaceAddr, int readerPort, ARSTREAM_Reader2_AuCallback_t callback, uint8_t *auBuffer, uint32_t auBufferSize, uint32_t maxPacketSize, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Reader2_t *retReader = NULL;
+    int clockMutexWasInit = 0;
+    int statsMutexWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    struct sockaddr_in localSin;
+
+    /* ARGS Check */
+    memset (&localSin, 0, sizeof (localSin));
+    localSin.sin_family = AF_INET;
+    localSin.sin_port = htons (readerPort);
+    localSin.sin_addr.s_addr = htonl (INADDR_ANY);
+    if (((ifaceAddr != NULL) &&
+         (inet_pton (AF_INET, ifaceAddr, &(localSin.sin_addr)) != 1)) ||
+        (callback == NULL) ||
+        (auBuffer == NULL) ||
+        (auBufferSize == 0) ||
+        (maxPacketSize <= sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t)))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retReader;
+    }
+
+    /* Alloc new reader */
+    retReader = calloc (1, sizeof (ARSTREAM_Reader2_t));
+    if (retReader == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Copy parameters */
+    if (internalError == ARSTREAM_OK)
+    {
+        retReader->callback = callback;
+        retReader->maxPacketSize = maxPacketSize;
+        retReader->custom = custom;
+        retReader->auBuffer = auBuffer;
+        retReader->auBufferSize = auBufferSize;
+        retReader->dataSocket = -1;
+    }
+
+    /* Setup internal mutexes */
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retReader->clockMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            clockMutexWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retReader->statsMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            statsMutexWasInit = 1;
+        }
+    }
+
+    /* Setup the socket */
+    if (internalError == ARSTREAM_OK)
+    {
+        struct timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = ARSTREAM_READER2_DATAREAD_TIMEOUT_MS * 1000;
+        retReader->dataSocket = ARSAL_Socket_Create (AF_INET, SOCK_DGRAM, 0);
+        if (retReader->dataSocket < 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Socket creation error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else if (ARSAL_Socket_Bind (retReader->dataSocket, (struct sockaddr *)&localSin, sizeof (localSin)) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Socket bind error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else if (ARSAL_Socket_Setsockopt (retReader->dataSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout)) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Socket timeout setup error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            int rcvBufSize = ARSTREAM_READER2_SOCKET_RCVBUF_SIZE;
+            if (ARSAL_Socket_Setsockopt (retReader->dataSocket, SOL_SOCKET, SO_RCVBUF, &rcvBufSize, sizeof (rcvBufSize)) != 0)
+            {
+                /* Not fatal: the reader still works with the default size, it may only lose packets on large bursts */
+                ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_READER2_TAG, "Unable to set the socket receive buffer size : %s", strerror (errno));
+            }
+        }
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retReader != NULL))
+    {
+        if (clockMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retReader->clockMutex));
+        }
+        if (statsMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retReader->statsMutex));
+        }
+        if (retReader->dataSocket >= 0)
+        {
+            ARSAL_Socket_Close (retReader->dataSocket);
+        }
+        free (retReader);
+        retReader = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retReader;
+}
+
+void ARSTREAM_Reader2_StopReader (ARSTREAM_Reader2_t *reader)
+{
+    if (reader != NULL)
+    {
+        reader->threadsShouldStop = 1;
+    }
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader2_Delete (ARSTREAM_Reader2_t **reader)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    if ((reader != NULL) &&
+        (*reader != NULL))
+    {
+        if ((*reader)->dataThreadStarted == 0)
+        {
+            ARSAL_Mutex_Destroy (&((*reader)->clockMutex));
+            ARSAL_Mutex_Destroy (&((*reader)->statsMutex));
+            ARSAL_Socket_Close ((*reader)->dataSocket);
+            free (*reader);
+            *reader = NULL;
+            retVal = ARSTREAM_OK;
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Call ARSTREAM_Reader2_StopReader before calling this function");
+            retVal = ARSTREAM_ERROR_BUSY;
+        }
+    }
+    return retVal;
+}
+
+void* ARSTREAM_Reader2_RunDataThread (void *ARSTREAM_Reader2_t_Param)
+{
+    ARSTREAM_Reader2_t *reader = (ARSTREAM_Reader2_t *)ARSTREAM_Reader2_t_Param;
+    uint8_t *recvData = NULL;
+    ARSTREAM_NetworkHeaders_DataHeader2_t *header;
+    uint32_t dummy;
+
+    /* Parameters check */
+    if (reader == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Error while starting %s, bad parameters", __FUNCTION__);
+        return (void *)0;
+    }
+
+    /* Alloc and check */
+    recvData = malloc (reader->maxPacketSize);
+    if (recvData == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Error while starting %s, can not alloc memory", __FUNCTION__);
+        return (void *)0;
+    }
+    header = (ARSTREAM_NetworkHeaders_DataHeader2_t *)recvData;
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Reader thread running");
+    reader->dataThreadStarted = 1;
+
+    while (reader->threadsShouldStop == 0)
+    {
+        uint16_t flags, seqNum;
+        uint32_t rtpTimestamp, ssrc;
+        int16_t seqDelta = 0;
+        int isLate = 0;
+        struct sockaddr_in srcSin;
+        socklen_t srcSinSize = sizeof (srcSin);
+        ssize_t recvSize;
+
+        ARSTREAM_Reader2_SendClockRequest (reader);
+        ARSTREAM_Reader2_SendReceiverReport (reader);
+
+        recvSize = ARSAL_Socket_Recvfrom (reader->dataSocket, recvData, reader->maxPacketSize, 0, (struct sockaddr *)&srcSin, &srcSinSize);
+        if (recvSize < 0)
+        {
+            if ((errno != EAGAIN) &&
+                (errno != EWOULDBLOCK) &&
+                (errno != EINTR))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_READER2_TAG, "Error while reading stream data: %s", strerror (errno));
+            }
+            continue;
+        }
+        if (recvSize < (ssize_t)sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_READER2_TAG, "Invalid packet size %zd", recvSize);
+            continue;
+        }
+
+        flags = ntohs (header->flags);
+        seqNum = ntohs (header->seqNum);
+        rtpTimestamp = ntohl (header->timestamp);
+        if ((flags & ARSTREAM_READER2_RTP_VERSION_MASK) != ARSTREAM_READER2_RTP_VERSION)
+        {
+            /* Clock frames answers from the sender start with the high bits of our own timestamps, so never look like RTP packets */
+            if ((recvSize == sizeof (ARSTREAM_NetworkHeaders_ClockFrame_t)) &&
+                (reader->hasSenderAddr == 1) &&
+                (srcSin.sin_addr.s_addr == reader->senderSin.sin_addr.s_addr) &&
+                (srcSin.sin_port == reader->senderSin.sin_port))
+            {
+                ARSTREAM_Reader2_ProcessClockFrame (reader, (ARSTREAM_NetworkHeaders_ClockFrame_t *)recvData, ARSTREAM_Reader2_GetTimeUs ());
+            }
+            else
+            {
+                ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_READER2_TAG, "Invalid RTP version");
+            }
+            continue;
+        }
+
+        /* Clock requests are sent back to the source of the stream */
+        if ((reader->hasSenderAddr == 0) ||
+            (srcSin.sin_addr.s_addr != reader->senderSin.sin_addr.s_addr) ||
+            (srcSin.sin_port != reader->senderSin.sin_port))
+        {
+            if (reader->hasSenderAddr == 1)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_INFO, ARSTREAM_READER2_TAG, "Stream source changed to %s:%d", inet_ntoa (srcSin.sin_addr), ntohs (srcSin.sin_port));
+                ARSTREAM_Reader2_ResetSource (reader);
+            }
+            reader->senderSin = srcSin;
+            reader->hasSenderAddr = 1;
+            reader->lastClockRequestTime = 0;
+        }
+
+        /* Sender reports are multiplexed with the data (their packet type would be 72 with a marker bit) */
+        if ((flags & 0x00FF) == ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_SR)
+        {
+            ARSTREAM_NetworkHeaders_SenderReport_t *senderReport = (ARSTREAM_NetworkHeaders_SenderReport_t *)recvData;
+            /* Reports of another session are ignored until its data packets reset the reader */
+            if ((recvSize == sizeof (ARSTREAM_NetworkHeaders_SenderReport_t)) &&
+                ((reader->hasReceivedPacket == 0) ||
+                 (ntohl (senderReport->ssrc) == reader->ssrc)))
+            {
+                ARSAL_Mutex_Lock (&(reader->statsMutex));
+                reader->lastSenderReport = ((ntohl (senderReport->ntpTimestampH) & 0xFFFF) << 16) | (ntohl (senderReport->ntpTimestampL) >> 16);
+                reader->lastSenderReportTime = ARSTREAM_Reader2_GetTimeUs ();
+                reader->stats.nbSenderReports++;
+                ARSAL_Mutex_Unlock (&(reader->statsMutex));
+            }
+            continue;
+        }
+
+        /* Each sender session uses a new random SSRC */
+        ssrc = ntohl (header->ssrc);
+        if ((reader->hasReceivedPacket == 1) &&
+            (ssrc != reader->ssrc))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_INFO, ARSTREAM_READER2_TAG, "Stream SSRC changed from 0x%08x to 0x%08x", reader->ssrc, ssrc);
+            ARSTREAM_Reader2_ResetSource (reader);
+        }
+
+        /* Sequence number validation */
+        if (reader->hasReceivedPacket == 1)
+        {
+            uint16_t udelta = seqNum - reader->expectedSeqNum;
+            if (udelta < ARSTREAM_READER2_MAX_DROPOUT)
+            {
+                seqDelta = (int16_t)udelta;
+                reader->hasBadSeqNum = 0;
+            }
+            else if (udelta < 0x10000 - ARSTREAM_READER2_MAX_MISORDER)
+            {
+                if ((reader->hasBadSeqNum == 1) &&
+                    (seqNum == reader->badSeqNum))
+                {
+                    ARSAL_PRINT (ARSAL_PRINT_INFO, ARSTREAM_READER2_TAG, "Sequence number jumped from %d to %d, resynchronizing", reader->expectedSeqNum, seqNum);
+                    ARSTREAM_Reader2_ResetSource (reader);
+                }
+                else
+                {
+                    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Dropping packet %d, too far from the expected %d", seqNum, reader->expectedSeqNum);
+                    reader->hasBadSeqNum = 1;
+                    reader->badSeqNum = seqNum + 1;
+                    continue;
+                }
+            }
+            else
+            {
+                isLate = 1;
+            }
+        }
+
+        ARSTREAM_Reader2_UpdateReceptionStats (reader, header, recvSize, ARSTREAM_Reader2_GetTimeUs ());
+
+        /* Sequence number tracking */
+        if (isLate == 1)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Dropping late or duplicate packet %d (expected %d)", seqNum, reader->expectedSeqNum);
+            continue;
+        }
+        if (reader->hasReceivedPacket == 0)
+        {
+            reader->hasReceivedPacket = 1;
+            reader->ssrc = ssrc;
+            reader->lastRtpTimestamp = rtpTimestamp;
+            reader->extendedRtpTimestamp = rtpTimestamp;
+        }
+        else if (seqDelta > 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Missed %d packets", seqDelta);
+        }
+        reader->expectedSeqNum = seqNum + 1;
+
+        /* Access unit boundaries */
+        if ((reader->auInProgress == 1) &&
+            (rtpTimestamp != reader->auRtpTimestamp))
+        {
+            // The last packet of the previous access unit was lost
+            if (seqDelta > 0)
+            {
+                reader->auIsMissingPackets = 1;
+            }
+            ARSTREAM_Reader2_DeliverAu (reader);
+        }
+        if (reader->auInProgress == 0)
+        {
+            reader->auInProgress = 1;
+            reader->auRtpTimestamp = rtpTimestamp;
+            reader->extendedRtpTimestamp += (int32_t)(rtpTimestamp - reader->lastRtpTimestamp);
+            reader->lastRtpTimestamp = rtpTimestamp;
+            reader->auIsMissingPackets = (seqDelta > 0) ? 1 : 0;
+        }
+        else if (seqDelta > 0)
+        {
+            reader->auIsMissingPackets = 1;
+            if (reader->fuInProgress == 1)
+            {
+                // Drop the truncated NAL unit
+                reader->auSize = reader->fuNaluStart;
+                reader->fuInProgress = 0;
+            }
+        }
+
+        ARSTREAM_Reader2_ProcessPayload (reader, recvData + sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t), recvSize - sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t));
+
+        if ((flags & ARSTREAM_READER2_RTP_MARKER_FLAG) != 0)
+        {
+            ARSTREAM_Reader2_DeliverAu (reader);
+        }
+    }
+
+    free (recvData);
+
+    reader->callback (ARSTREAM_READER2_CAUSE_CANCEL, reader->auBuffer, 0, 0, &dummy, reader->custom);
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_READER2_TAG, "Reader thread ended");
+    reader->dataThreadStarted = 0;
+    return (void *)0;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader2_GetClockSync (ARSTREAM_Reader2_t *reader, ARSTREAM_Reader2_ClockSync_t *clockSync)
+{
+    if ((reader == NULL) ||
+        (clockSync == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    memset (clockSync, 0, sizeof (ARSTREAM_Reader2_ClockSync_t));
+    ARSAL_Mutex_Lock (&(reader->clockMutex));
+    clockSync->nbExchanges = reader->nbClockExchanges;
+    if (reader->clockIsSynchronized == 1)
+    {
+        clockSync->isSynchronized = 1;
+        clockSync->offsetUs = ARSTREAM_Reader2_GetClockOffset (reader, ARSTREAM_Reader2_GetTimeUs ());
+        clockSync->skewPpm = reader->clockSkew * 1000000.;
+        clockSync->minRttUs = reader->clockMinRttUs;
+    }
+    ARSAL_Mutex_Unlock (&(reader->clockMutex));
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader2_SenderTimeToLocalTime (ARSTREAM_Reader2_t *reader, uint64_t senderTimeUs, uint64_t *localTimeUs)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_OK;
+    if ((reader == NULL) ||
+        (localTimeUs == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ARSAL_Mutex_Lock (&(reader->clockMutex));
+    if (reader->clockIsSynchronized == 1)
+    {
+        uint64_t now = ARSTREAM_Reader2_GetTimeUs ();
+        int64_t offset = ARSTREAM_Reader2_GetClockOffset (reader, now);
+        /* Restore the bits lost in the 32 bits RTP timestamp, from the current sender time */
+        uint64_t senderNowTicks = (now + offset) * ARSTREAM_READER2_RTP_CLOCKRATE / 1000000;
+        uint64_t ticks = ((senderTimeUs * ARSTREAM_READER2_RTP_CLOCKRATE) + 500000) / 1000000;
+        int32_t delta = (int32_t)((uint32_t)ticks - (uint32_t)senderNowTicks);
+        uint64_t fullSenderTimeUs = (senderNowTicks + delta) * 1000000 / ARSTREAM_READER2_RTP_CLOCKRATE;
+        *localTimeUs = fullSenderTimeUs - ARSTREAM_Reader2_GetClockOffset (reader, fullSenderTimeUs - offset);
+    }
+    else
+    {
+        retVal = ARSTREAM_ERROR_NOT_SYNCHRONIZED;
+    }
+    ARSAL_Mutex_Unlock (&(reader->clockMutex));
+    return retVal;
+}
+
+eARSTREAM_ERROR ARSTREAM_Reader2_GetStats (ARSTREAM_Reader2_t *reader, ARSTREAM_Reader2_Stats_t *stats)
+{
+    if ((reader == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ARSAL_Mutex_Lock (&(reader->statsMutex));
+    *stats = reader->stats;
+    ARSAL_Mutex_Unlock (&(reader->statsMutex));
+    return ARSTREAM_OK;
+}
@@ -52,6 +52,10 @@
 
 #include "ARSTREAM_Buffers.h"
 #include "ARSTREAM_NetworkHeaders.h"
+#include "ARSTREAM_Transport.h"
+#include "ARSTREAM_Clock.h"
+#include "ARSTREAM_TracePoints.h"
+#include "ARSTREAM_Histogram.h"
 
 /*
  * ARSDK Headers
@@ -110,6 +114,11 @@
  */
 #define ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE (10)
 
+/**
+ * Minimum time between two KEY_FRAME_REQUEST callbacks
+ */
+#define ARSTREAM_SENDER_KEY_FRAME_REQUEST_MIN_INTERVAL_MS (100)
+
 /**
  * Sets *PTR to VAL if PTR is not null
  */
@@ -136,9 +145,7 @@ typedef struct {
 
 struct ARSTREAM_Sender_t {
     /* Configuration on New */
-    ARNETWORK_Manager_t *manager;
-    int dataBufferID;
-    int ackBufferID;
+    ARSTREAM_Transport_t *transport;
     ARSTREAM_Sender_FrameUpdateCallback_t callback;
     uint32_t maxNumberOfNextFrames;
     uint32_t maxFragmentSize;
@@ -178,7 +185,7 @@ struct ARSTREAM_Sender_t {
     int dataThreadStarted;
     int ackThreadStarted;
 
-    /* Efficiency calculations */
+    /* Efficiency calculations (protected by statsMutex) */
     int efficiency_nbFragments [ARSTREAM_SENDER_EFFICIENCY_AVERAGE_NB_FRAMES];
     int efficiency_nbSent [ARSTREAM_SENDER_EFFICIENCY_AVERAGE_NB_FRAMES];
     int efficiency_index;
@@ -186,9 +193,25 @@ struct ARSTREAM_Sender_t {
     /* Filters */
     ARSTREAM_Filter_t **filters;
     int nbFilters;
+
+    /* Key frame requests */
+    uint32_t lastFlushFrameNumber; // Protected by nextFrameMutex
+    int keyFrameRequestWasRaised;
+    struct timespec lastKeyFrameRequestTime;
+
+    /* Set once an unknown packet was read on the ack buffer, so it is not logged for each packet */
+    int unknownAckPacketWasLogged;
+
+    /* Statistics. statsMutex is always taken last, and never held while calling the callbacks,
+     * so that the getters can be called from them */
+    ARSAL_Mutex_t statsMutex;
+    ARSTREAM_Sender_Stats_t queueStats; // Queue related fields only, protected by statsMutex
+    ARSTREAM_Sender_Stats_t sendStats; // Other fields, protected by statsMutex
+    struct timespec currentFrameStartTime;
 };
 
 typedef struct {
+    ARSTREAM_Transport_SendParam_t transportParam; // Must be the first member
     ARSTREAM_Sender_t *sender;
     uint32_t frameNumber;
     int fragmentIndex;
@@ -225,16 +248,20 @@ static int ARSTREAM_Sender_AddToQueue (ARSTREAM_Sender_t *sender, uint32_t size,
 static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sender_Frame_t *newFrame);
 
 /**
- * @brief ARNETWORK_Manager_Callback_t for ARNETWORK_... calls
- * @param IoBufferId Unused as we always send on one unique buffer
- * @param dataPtr Unused as we don't need to free the memory
- * @param customData (ARSTREAM_Sender_NetworkCallbackParam_t *) Sender + fragment index
+ * @brief ARSTREAM_Transport_SendCallback_t for ARSTREAM_Transport_Send calls
+ * @param param (ARSTREAM_Sender_NetworkCallbackParam_t *) Sender + fragment index
  * @param status Network information
- * @return ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT
  *
- * @warning customData is a malloc'd pointer, and must be freed within this callback, during last call
+ * @warning param is a malloc'd pointer, and must be freed within this callback
  */
-eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Sender_NetworkCallback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status);
+static void ARSTREAM_Sender_NetworkCallback (ARSTREAM_Transport_SendParam_t *param, eARSTREAM_TRANSPORT_SEND_STATUS status);
+
+/**
+ * @brief Creates a new sender on top of a transport
+ * @param transport The transport to use. Owned by the sender on success only.
+ * @see ARSTREAM_Sender_New for the other parameters
+ */
+static ARSTREAM_Sender_t* ARSTREAM_Sender_NewWithTransport (ARSTREAM_Transport_t *transport, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error);
 
 /**
  * @brief Signals that the current frame of the sender was acknowledged
@@ -262,6 +289,26 @@ static int ARSTREAM_Sender_SendLateAck (ARSTREAM_Sender_t *sender, uint16_t fram
  */
 static void ARSTREAM_Sender_CallCallback (ARSTREAM_Sender_t *sender, eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, int isCurrent);
 
+/**
+ * @brief Handles a key frame request from the reader
+ * Requests are ignored if a flush frame was queued after the last frame seen by
+ * the reader (the key frame is already on its way), or if the previous request
+ * was reported less than ARSTREAM_SENDER_KEY_FRAME_REQUEST_MIN_INTERVAL_MS ago
+ * @param sender The sender
+ * @param request The request, in host endianness
+ */
+static void ARSTREAM_Sender_HandleKeyFrameRequest (ARSTREAM_Sender_t *sender, ARSTREAM_NetworkHeaders_KeyFrameRequest_t *request);
+
+/**
+ * @brief Handles a frame skip message from the reader
+ * If the message is about the current frame, its retries are stopped and
+ * the frame is reported as cancelled
+ * @param sender The sender
+ * @param frameNumber The skipped frame, in host endianness
+ * @warning Must be called with the ackMutex held
+ */
+static void ARSTREAM_Sender_FrameWasSkipped (ARSTREAM_Sender_t *sender, uint16_t frameNumber);
+
 /*
  * Internal functions implementation
  */
@@ -271,10 +318,18 @@ static void ARSTREAM_Sender_FlushQueue (ARSTREAM_Sender_t *sender)
     while (sender->numberOfWaitingFrames > 0)
     {
         ARSTREAM_Sender_Frame_t *nextFrame = &(sender->nextFrames [sender->indexGetNextFrame]);
-        ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_CANCEL, nextFrame->frameBuffer, nextFrame->frameSize, 0);
+        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED, nextFrame->frameNumber, 0);
         sender->indexGetNextFrame++;
         sender->indexGetNextFrame %= sender->maxNumberOfNextFrames;
         sender->numberOfWaitingFrames--;
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        if (nextFrame->frameBuffer != NULL)
+        {
+            sender->queueStats.nbFramesCancelled++;
+        }
+        sender->queueStats.queueDepth = sender->numberOfWaitingFrames;
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
+        ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_CANCEL, nextFrame->frameBuffer, nextFrame->frameSize, 0);
     }
 }
 
@@ -299,17 +354,39 @@ static int ARSTREAM_Sender_AddToQueue (ARSTREAM_Sender_t *sender, uint32_t size,
         nextFrame->frameBuffer = buffer;
         nextFrame->frameSize   = size;
         nextFrame->isHighPriority = wasFlushFrame;
+        if (wasFlushFrame == 1)
+        {
+            sender->lastFlushFrameNumber = nextFrame->frameNumber;
+        }
+        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_QUEUED, nextFrame->frameNumber, size);
 
         sender->indexAddNextFrame++;
         sender->indexAddNextFrame %= sender->maxNumberOfNextFrames;
 
         sender->numberOfWaitingFrames++;
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        if (buffer != NULL)
+        {
+            sender->queueStats.nbFramesQueued++;
+        }
+        sender->queueStats.queueDepth = sender->numberOfWaitingFrames;
+        if (sender->numberOfWaitingFrames > sender->queueStats.maxQueueDepth)
+        {
+            sender->queueStats.maxQueueDepth = sender->numberOfWaitingFrames;
+        }
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
 
-        ARSAL_Cond_Signal (&(sender->nextFrameCond));
+        ARSTREAM_Clock_CondSignal (&(sender->nextFrameCond));
     }
     else
     {
         retVal = -1;
+        if (buffer != NULL)
+        {
+            ARSAL_Mutex_Lock (&(sender->statsMutex));
+            sender->queueStats.nbFramesQueueFull++;
+            ARSAL_Mutex_Unlock (&(sender->statsMutex));
+        }
     }
     ARSAL_Mutex_Unlock (&(sender->nextFrameMutex));
     return retVal;
@@ -341,7 +418,7 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
     {
         struct timespec start, end;
         int timewaited = 0;
-        int waitTime = ARNETWORK_Manager_GetEstimatedLatency (sender->manager);
+        int waitTime = ARSTREAM_Transport_GetEstimatedLatency (sender->transport);
         if (waitTime < 0) // Unable to get latency
         {
             waitTime = ARSTREAM_SENDER_DEFAULT_ESTIMATED_LATENCY_MS;
@@ -358,9 +435,9 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
         while ((retVal == 0) &&
                (hadTimeout == 0))
         {
-            ARSAL_Time_GetTime(&start);
-            int err = ARSAL_Cond_Timedwait (&(sender->nextFrameCond), &(sender->nextFrameMutex), waitTime - timewaited);
-            ARSAL_Time_GetTime(&end);
+            ARSTREAM_Clock_GetTime (&start);
+            int err = ARSTREAM_Clock_CondTimedwait (&(sender->nextFrameCond), &(sender->nextFrameMutex), waitTime - timewaited);
+            ARSTREAM_Clock_GetTime (&end);
             timewaited += ARSAL_Time_ComputeTimespecMsTimeDiff (&start, &end);
             if (err == ETIMEDOUT)
             {
@@ -389,6 +466,9 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
         ARSTREAM_Sender_Frame_t *frame = &(sender->nextFrames [sender->indexGetNextFrame]);
         sender->indexGetNextFrame++;
         sender->indexGetNextFrame %= sender->maxNumberOfNextFrames;
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        sender->queueStats.queueDepth = sender->numberOfWaitingFrames;
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
 
         // Apply filters
         int inSize = frame->frameSize;
@@ -398,6 +478,7 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
         uint8_t *outBuffer = NULL;
         int i;
         ARSTREAM_Filter_t *prevFilter = NULL;
+        ARSTREAM_TRACE_POINT_IF (sender->nbFilters > 0, ARSTREAM_TRACE_EVENT_SENDER_FILTERS_BEGIN, frame->frameNumber, sender->nbFilters);
         for (i = 0; i < sender->nbFilters; i++)
         {
             ARSTREAM_Filter_t *filter = sender->filters[i];
@@ -427,7 +508,9 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
             }
             inBuffer = outBuffer;
             inSize = outSize;
+            prevFilter = filter;
         }
+        ARSTREAM_TRACE_POINT_IF (sender->nbFilters > 0, ARSTREAM_TRACE_EVENT_SENDER_FILTERS_END, frame->frameNumber, inSize);
         newFrame->frameNumber = frame->frameNumber;
         newFrame->frameBuffer = inBuffer;
         newFrame->frameSize   = inSize;
@@ -437,12 +520,10 @@ static int ARSTREAM_Sender_PopFromQueue (ARSTREAM_Sender_t *sender, ARSTREAM_Sen
     return retVal;
 }
 
-eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Sender_NetworkCallback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status)
+static void ARSTREAM_Sender_NetworkCallback (ARSTREAM_Transport_SendParam_t *param, eARSTREAM_TRANSPORT_SEND_STATUS status)
 {
-    eARNETWORK_MANAGER_CALLBACK_RETURN retVal = ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT;
-
     /* Get params */
-    ARSTREAM_Sender_NetworkCallbackParam_t *cbParams = (ARSTREAM_Sender_NetworkCallbackParam_t *)customData;
+    ARSTREAM_Sender_NetworkCallbackParam_t *cbParams = (ARSTREAM_Sender_NetworkCallbackParam_t *)param;
 
     /* Get Sender */
     ARSTREAM_Sender_t *sender = cbParams->sender;
@@ -453,13 +534,9 @@ eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Sender_NetworkCallback (int IoBuffer
     /* Get frameNumber */
     uint32_t frameNumber = cbParams->frameNumber;
 
-    /* Remove "unused parameter" warnings */
-    (void)IoBufferId;
-    (void)dataPtr;
-
     switch (status)
     {
-    case ARNETWORK_MANAGER_CALLBACK_STATUS_SENT:
+    case ARSTREAM_TRANSPORT_SEND_STATUS_SENT:
         ARSAL_Mutex_Lock (&(sender->packetsToSendMutex));
         // Modify packetsToSend only if it refers to the frame we're sending
         if (frameNumber == sender->packetsToSend.frameNumber)
@@ -478,35 +555,51 @@ eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_Sender_NetworkCallback (int IoBuffer
         /* Free cbParams */
         free (cbParams);
         break;
-    case ARNETWORK_MANAGER_CALLBACK_STATUS_CANCEL:
+    case ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL:
         /* Free cbParams */
         free (cbParams);
         break;
     default:
         break;
     }
-    return retVal;
 }
 
 
 static void ARSTREAM_Sender_FrameWasAck (ARSTREAM_Sender_t *sender)
 {
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    sender->sendStats.nbFramesAcked++;
+    ARSTREAM_Histogram_Add (sender->sendStats.ackTimeHistogram, ARSAL_Time_ComputeTimespecMsTimeDiff (&(sender->currentFrameStartTime), &now));
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+    ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_ACKED, sender->currentFrame.frameNumber, sender->currentFrameNbFragments);
     ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_SENT, sender->currentFrame.frameBuffer, sender->currentFrame.frameSize, 1);
     sender->currentFrameCbWasCalled = 1;
     ARSAL_Mutex_Lock (&(sender->nextFrameMutex));
-    ARSAL_Cond_Signal (&(sender->nextFrameCond));
+    ARSTREAM_Clock_CondSignal (&(sender->nextFrameCond));
     ARSAL_Mutex_Unlock (&(sender->nextFrameMutex));
 }
 
 static int ARSTREAM_Sender_SendLateAck (ARSTREAM_Sender_t *sender, uint16_t frameId)
 {
     int retVal = 0;
-    int deltaNum = sender->currentFrame.frameNumber - frameId;
-    int index = (ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE + sender->previousFrameIndex - deltaNum) % ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE;
+    int deltaNum = (uint16_t)(sender->currentFrame.frameNumber - frameId);
+    int index;
+    // Only the last ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE frames are memorized
+    if ((deltaNum <= 0) ||
+        (deltaNum > ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE))
+    {
+        return retVal;
+    }
+    index = (ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE + sender->previousFrameIndex - deltaNum) % ARSTREAM_SENDER_PREVIOUS_FRAME_NB_SAVE;
     if (sender->previousFramesStatus[index] == 0)
     {
         sender->previousFramesStatus[index] = 1;
         retVal = 1;
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        sender->sendStats.nbLateAcks++;
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
         ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK, NULL, 0, 0);
     }
     return retVal;
@@ -515,8 +608,10 @@ static int ARSTREAM_Sender_SendLateAck (ARSTREAM_Sender_t *sender, uint16_t fram
 static void ARSTREAM_Sender_CallCallback (ARSTREAM_Sender_t *sender, eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, int isCurrent)
 {
     int needToCall = 1;
-    // Dont call if the frame is null, except for LATE_ACKs
-    if (framePointer == NULL && status != ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK)
+    // Dont call if the frame is null, except for LATE_ACKs and KEY_FRAME_REQUESTs
+    if (framePointer == NULL &&
+        status != ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK &&
+        status != ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST)
     {
         needToCall = 0;
     }
@@ -541,6 +636,39 @@ static void ARSTREAM_Sender_CallCallback (ARSTREAM_Sender_t *sender, eARSTREAM_S
     }
 }
 
+static void ARSTREAM_Sender_HandleKeyFrameRequest (ARSTREAM_Sender_t *sender, ARSTREAM_NetworkHeaders_KeyFrameRequest_t *request)
+{
+    int isDuplicate = 0;
+    struct timespec now;
+
+    ARSAL_Mutex_Lock (&(sender->nextFrameMutex));
+    if ((sender->lastFlushFrameNumber != 0) &&
+        ((int16_t)((uint16_t)sender->lastFlushFrameNumber - request->frameNumber) > 0))
+    {
+        isDuplicate = 1;
+    }
+    ARSAL_Mutex_Unlock (&(sender->nextFrameMutex));
+
+    ARSTREAM_Clock_GetTime (&now);
+    if ((isDuplicate == 0) &&
+        (sender->keyFrameRequestWasRaised == 1) &&
+        (ARSAL_Time_ComputeTimespecMsTimeDiff (&(sender->lastKeyFrameRequestTime), &now) < ARSTREAM_SENDER_KEY_FRAME_REQUEST_MIN_INTERVAL_MS))
+    {
+        isDuplicate = 1;
+    }
+
+    if (isDuplicate == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER_TAG, "Key frame requested after frame %d (reason %d)", request->frameNumber, request->reason);
+        sender->keyFrameRequestWasRaised = 1;
+        sender->lastKeyFrameRequestTime = now;
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        sender->sendStats.nbKeyFrameRequests++;
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
+        ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST, NULL, request->reason, 0);
+    }
+}
+
 /*
  * Implementation
  */
@@ -558,12 +686,7 @@ void ARSTREAM_Sender_InitStreamAckBuffer (ARNETWORK_IOBufferParam_t *bufferParam
 ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBufferID, int ackBufferID, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error)
 {
     ARSTREAM_Sender_t *retSender = NULL;
-    int packetsToSendMutexWasInit = 0;
-    int ackMutexWasInit = 0;
-    int nextFrameMutexWasInit = 0;
-    int nextFrameCondWasInit = 0;
-    int nextFramesArrayWasCreated = 0;
-    int previousFramesArrayWasCreated = 0;
+    ARSTREAM_Transport_t *transport = NULL;
     eARSTREAM_ERROR internalError = ARSTREAM_OK;
     /* ARGS Check */
     if ((manager == NULL) ||
@@ -575,6 +698,90 @@ ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBu
         return retSender;
     }
 
+    transport = ARSTREAM_Transport_NewNetwork (manager, dataBufferID, ackBufferID, &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender = ARSTREAM_Sender_NewWithTransport (transport, callback, framesBufferSize, maxFragmentSize, maxNumberOfFragment, custom, &internalError);
+        if (retSender == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retSender;
+}
+
+ARSTREAM_Sender_t* ARSTREAM_Sender_NewUDP (const char *readerAddr, int readerPort, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Sender_t *retSender = NULL;
+    ARSTREAM_Transport_t *transport = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((readerAddr == NULL) ||
+        (readerPort <= 0) ||
+        (callback == NULL) ||
+        (maxFragmentSize == 0) ||
+        (maxNumberOfFragment > ARSTREAM_NETWORK_HEADERS_MAX_FRAGMENTS_PER_FRAME))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retSender;
+    }
+
+    transport = ARSTREAM_Transport_NewUDP (readerAddr, readerPort, NULL, 0, maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender = ARSTREAM_Sender_NewWithTransport (transport, callback, framesBufferSize, maxFragmentSize, maxNumberOfFragment, custom, &internalError);
+        if (retSender == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retSender;
+}
+
+ARSTREAM_Sender_t* ARSTREAM_Sender_NewLoopback (ARSTREAM_Loopback_t *loopback, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Sender_t *retSender = NULL;
+    ARSTREAM_Transport_t *transport = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    /* ARGS Check */
+    if ((loopback == NULL) ||
+        (callback == NULL) ||
+        (maxFragmentSize == 0) ||
+        (maxNumberOfFragment > ARSTREAM_NETWORK_HEADERS_MAX_FRAGMENTS_PER_FRAME))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retSender;
+    }
+
+    transport = ARSTREAM_Transport_NewLoopback (loopback, ARSTREAM_TRANSPORT_LOOPBACK_SIDE_SENDER, maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &internalError);
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender = ARSTREAM_Sender_NewWithTransport (transport, callback, framesBufferSize, maxFragmentSize, maxNumberOfFragment, custom, &internalError);
+        if (retSender == NULL)
+        {
+            ARSTREAM_Transport_Delete (&transport);
+        }
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retSender;
+}
+
+static ARSTREAM_Sender_t* ARSTREAM_Sender_NewWithTransport (ARSTREAM_Transport_t *transport, ARSTREAM_Sender_FrameUpdateCallback_t callback, uint32_t framesBufferSize, uint32_t maxFragmentSize, uint32_t maxNumberOfFragment,  void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Sender_t *retSender = NULL;
+    int packetsToSendMutexWasInit = 0;
+    int ackMutexWasInit = 0;
+    int nextFrameMutexWasInit = 0;
+    int statsMutexWasInit = 0;
+    int nextFrameCondWasInit = 0;
+    int nextFramesArrayWasCreated = 0;
+    int previousFramesArrayWasCreated = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
     /* Alloc new sender */
     retSender = malloc (sizeof (ARSTREAM_Sender_t));
     if (retSender == NULL)
@@ -585,9 +792,7 @@ ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBu
     /* Copy parameters */
     if (internalError == ARSTREAM_OK)
     {
-        retSender->manager = manager;
-        retSender->dataBufferID = dataBufferID;
-        retSender->ackBufferID = ackBufferID;
+        retSender->transport = transport;
         retSender->callback = callback;
         retSender->custom = custom;
         retSender->maxNumberOfFragment = maxNumberOfFragment;
@@ -640,6 +845,18 @@ ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBu
         }
     }
     if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retSender->statsMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            statsMutexWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
     {
         int condInitRet = ARSAL_Cond_Init (&(retSender->nextFrameCond));
         if (condInitRet != 0)
@@ -706,6 +923,11 @@ ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBu
         }
         retSender->filters = NULL;
         retSender->nbFilters = 0;
+        retSender->lastFlushFrameNumber = 0;
+        retSender->keyFrameRequestWasRaised = 0;
+        retSender->unknownAckPacketWasLogged = 0;
+        memset (&(retSender->queueStats), 0, sizeof (retSender->queueStats));
+        memset (&(retSender->sendStats), 0, sizeof (retSender->sendStats));
     }
 
     if ((internalError != ARSTREAM_OK) &&
@@ -723,6 +945,10 @@ ARSTREAM_Sender_t* ARSTREAM_Sender_New (ARNETWORK_Manager_t *manager, int dataBu
         {
             ARSAL_Mutex_Destroy (&(retSender->nextFrameMutex));
         }
+        if (statsMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retSender->statsMutex));
+        }
         if (nextFrameCondWasInit == 1)
         {
             ARSAL_Cond_Destroy (&(retSender->nextFrameCond));
@@ -794,9 +1020,11 @@ eARSTREAM_ERROR ARSTREAM_Sender_Delete (ARSTREAM_Sender_t **sender)
             ARSAL_Mutex_Lock (&((*sender)->nextFrameMutex));
             ARSTREAM_Sender_FlushQueue (*sender);
             ARSAL_Mutex_Unlock (&((*sender)->nextFrameMutex));
+            ARSTREAM_Transport_Delete (&((*sender)->transport));
             ARSAL_Mutex_Destroy (&((*sender)->packetsToSendMutex));
             ARSAL_Mutex_Destroy (&((*sender)->ackMutex));
             ARSAL_Mutex_Destroy (&((*sender)->nextFrameMutex));
+            ARSAL_Mutex_Destroy (&((*sender)->statsMutex));
             ARSAL_Cond_Destroy (&((*sender)->nextFrameCond));
             free ((*sender)->nextFrames);
             free ((*sender)->previousFramesStatus);
@@ -900,6 +1128,7 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
     header = (ARSTREAM_NetworkHeaders_DataHeader_t *)sendFragment;
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER_TAG, "Sender thread running");
+    ARSTREAM_TRACE_THREAD_BEGIN ("ARSTREAM_Sender_Data");
     sender->dataThreadStarted = 1;
 
     while (sender->threadsShouldStop == 0)
@@ -918,6 +1147,7 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
         {
             int previousWasAck = 1;
             ARSAL_PRINT (ARSAL_PRINT_VERBOSE, ARSTREAM_SENDER_TAG, "Previous frame was sent in %d packets. Frame size was %d packets", numbersOfFragmentsSentForCurrentFrame, nbPackets);
+            ARSAL_Mutex_Lock (&(sender->statsMutex));
             sender->efficiency_nbFragments [sender->efficiency_index ] = nbPackets;
             sender->efficiency_nbSent [sender->efficiency_index] = numbersOfFragmentsSentForCurrentFrame;
             numbersOfFragmentsSentForCurrentFrame = 0;
@@ -926,6 +1156,7 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
             sender->efficiency_index %= ARSTREAM_SENDER_EFFICIENCY_AVERAGE_NB_FRAMES;
             sender->efficiency_nbSent [sender->efficiency_index] = 0;
             sender->efficiency_nbFragments [sender->efficiency_index] = 0;
+            ARSAL_Mutex_Unlock (&(sender->statsMutex));
 
             /* Cancel current frame if it was not already sent */
             /* Do not do it for the first "NULL" frame that is in the
@@ -938,7 +1169,11 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
 #endif
 
                 previousWasAck = 0;
-                ARNETWORK_Manager_FlushInputBuffer (sender->manager, sender->dataBufferID);
+                ARSAL_Mutex_Lock (&(sender->statsMutex));
+                sender->sendStats.nbFramesCancelled++;
+                ARSAL_Mutex_Unlock (&(sender->statsMutex));
+                ARSTREAM_Transport_Cancel (sender->transport);
+                ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED, sender->currentFrame.frameNumber, 0);
 
                 ARSTREAM_Sender_CallCallback(sender, ARSTREAM_SENDER_STATUS_FRAME_CANCEL, sender->currentFrame.frameBuffer, sender->currentFrame.frameSize, 1);
             }
@@ -984,6 +1219,8 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
                 }
             }
             sender->currentFrameNbFragments = nbPackets;
+            ARSTREAM_Clock_GetTime (&(sender->currentFrameStartTime));
+            ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_START, sender->currentFrame.frameNumber, nbPackets);
 
             ARSAL_PRINT (ARSAL_PRINT_VERBOSE, ARSTREAM_SENDER_TAG, "New frame has size %d (=%d packets)", sendSize, nbPackets);
         }
@@ -1003,11 +1240,11 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
         }
 
         /* Send all "packets to send" */
+        int nbFragmentsSentBefore = numbersOfFragmentsSentForCurrentFrame;
         for (cnt = 0; cnt < nbPackets; cnt++)
         {
             if (ARSTREAM_NetworkHeaders_AckPacketFlagIsSet (&(sender->packetsToSend), cnt))
             {
-                eARNETWORK_ERROR netError = ARNETWORK_OK;
                 uint32_t maxFragSize = sender->maxFragmentSize;
                 numbersOfFragmentsSentForCurrentFrame ++;
                 int currFragmentSize = (cnt == nbPackets-1) ? lastFragmentSize : maxFragSize;
@@ -1015,21 +1252,33 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
                 header->fragmentsPerFrame = nbPackets;
                 memcpy (&sendFragment[sizeof (ARSTREAM_NetworkHeaders_DataHeader_t)], &(sender->currentFrame.frameBuffer)[maxFragSize*cnt], currFragmentSize);
                 ARSTREAM_Sender_NetworkCallbackParam_t *cbParams = malloc (sizeof (ARSTREAM_Sender_NetworkCallbackParam_t));
+                cbParams->transportParam.callback = ARSTREAM_Sender_NetworkCallback;
                 cbParams->sender = sender;
                 cbParams->fragmentIndex = cnt;
                 cbParams->frameNumber = sender->packetsToSend.frameNumber;
                 ARSAL_Mutex_Unlock (&(sender->packetsToSendMutex));
-                netError = ARNETWORK_Manager_SendData (sender->manager, sender->dataBufferID, sendFragment, currFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), (void *)cbParams, ARSTREAM_Sender_NetworkCallback, 1);
-                if (netError != ARNETWORK_OK)
+                if (ARSTREAM_Transport_Send (sender->transport, sendFragment, currFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t), &(cbParams->transportParam)) != 0)
                 {
-                    ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER_TAG, "Error occurred during sending of the fragment ; error: %d : %s", netError, ARNETWORK_Error_ToString(netError));
+                    ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER_TAG, "Error occurred during sending of the fragment %d", cnt);
+                    free (cbParams);
                 }
+                ARSTREAM_TRACE_POINT_IF (numbersOfFragmentsSentForCurrentFrame == 1, ARSTREAM_TRACE_EVENT_SENDER_FIRST_FRAGMENT, header->frameNumber, cnt);
 
                 ARSAL_Mutex_Lock (&(sender->packetsToSendMutex));
             }
         }
+        ARSTREAM_TRACE_POINT_IF ((nbFragmentsSentBefore > 0) && (numbersOfFragmentsSentForCurrentFrame > nbFragmentsSentBefore),
+                                 ARSTREAM_TRACE_EVENT_SENDER_RETRY, header->frameNumber, numbersOfFragmentsSentForCurrentFrame - nbFragmentsSentBefore);
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        sender->sendStats.nbFragmentsSent += numbersOfFragmentsSentForCurrentFrame - nbFragmentsSentBefore;
+        if (nbFragmentsSentBefore > 0)
+        {
+            sender->sendStats.nbFragmentsRetried += numbersOfFragmentsSentForCurrentFrame - nbFragmentsSentBefore;
+        }
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
         ARSAL_Mutex_Unlock (&(sender->ackMutex));
         ARSAL_Mutex_Unlock (&(sender->packetsToSendMutex));
+        ARSTREAM_Transport_Flush (sender->transport);
     }
     /* END OF PROCESS LOOP */
 
@@ -1039,10 +1288,15 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
         ARSTREAM_NetworkHeaders_AckPacketDump ("Cancel frame:", &(sender->ackPacket));
         ARSAL_PRINT (ARSAL_PRINT_VERBOSE, ARSTREAM_SENDER_TAG, "Receiver acknowledged %d of %d packets", ARSTREAM_NetworkHeaders_AckPacketCountSet (&(sender->ackPacket), nbPackets), nbPackets);
 #endif
+        ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED, sender->currentFrame.frameNumber, 0);
+        ARSAL_Mutex_Lock (&(sender->statsMutex));
+        sender->sendStats.nbFramesCancelled++;
+        ARSAL_Mutex_Unlock (&(sender->statsMutex));
         ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_CANCEL, sender->currentFrame.frameBuffer, sender->currentFrame.frameSize, 1);
     }
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER_TAG, "Sender thread ended");
+    ARSTREAM_TRACE_THREAD_END ();
     sender->dataThreadStarted = 0;
 
     if(sendFragment)
@@ -1054,44 +1308,88 @@ void* ARSTREAM_Sender_RunDataThread (void *ARSTREAM_Sender_t_Param)
     return (void *)0;
 }
 
+static void ARSTREAM_Sender_FrameWasSkipped (ARSTREAM_Sender_t *sender, uint16_t frameNumber)
+{
+    if ((sender->ackPacket.frameNumber != frameNumber) ||
+        (sender->currentFrameCbWasCalled == 1))
+    {
+        return;
+    }
+    ARSAL_PRINT (ARSAL_PRINT_VERBOSE, ARSTREAM_SENDER_TAG, "Frame %d was skipped by the reader", frameNumber);
+    // Nothing left to send for this frame
+    ARSTREAM_NetworkHeaders_AckPacketResetUpTo (&(sender->ackPacket), 0);
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    sender->sendStats.nbFramesCancelled++;
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+    ARSTREAM_Transport_Cancel (sender->transport);
+    ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED, sender->currentFrame.frameNumber, 0);
+    ARSTREAM_Sender_CallCallback (sender, ARSTREAM_SENDER_STATUS_FRAME_CANCEL, sender->currentFrame.frameBuffer, sender->currentFrame.frameSize, 1);
+    sender->currentFrameCbWasCalled = 1;
+    ARSAL_Mutex_Lock (&(sender->nextFrameMutex));
+    ARSTREAM_Clock_CondSignal (&(sender->nextFrameCond));
+    ARSAL_Mutex_Unlock (&(sender->nextFrameMutex));
+}
 
 void* ARSTREAM_Sender_RunAckThread (void *ARSTREAM_Sender_t_Param)
 {
+    union {
+        ARSTREAM_NetworkHeaders_AckPacket_t ack;
+        ARSTREAM_NetworkHeaders_KeyFrameRequest_t keyFrameRequest;
+        ARSTREAM_NetworkHeaders_FrameSkip_t frameSkip;
+    } recvData;
     ARSTREAM_NetworkHeaders_AckPacket_t recvPacket;
     int recvSize;
     ARSTREAM_Sender_t *sender = (ARSTREAM_Sender_t *)ARSTREAM_Sender_t_Param;
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER_TAG, "Ack thread running");
+    ARSTREAM_TRACE_THREAD_BEGIN ("ARSTREAM_Sender_Ack");
     sender->ackThreadStarted = 1;
 
     ARSTREAM_NetworkHeaders_AckPacketReset (&recvPacket);
 
     while (sender->threadsShouldStop == 0)
     {
-        eARNETWORK_ERROR err = ARNETWORK_Manager_ReadDataWithTimeout (sender->manager, sender->ackBufferID, (uint8_t *)&recvPacket, sizeof (recvPacket), &recvSize, 1000);
-        if (ARNETWORK_OK != err)
+        recvSize = ARSTREAM_Transport_Read (sender->transport, (uint8_t *)&recvData, sizeof (recvData), 1000);
+        if (recvSize < 0)
         {
-            if (ARNETWORK_ERROR_BUFFER_EMPTY != err)
-            {
-                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER_TAG, "Error while reading ACK data: %s", ARNETWORK_Error_ToString (err));
-            }
+            // Timeout, or read error (already logged by the transport)
+            continue;
+        }
+        else if ((recvSize == sizeof (recvData.keyFrameRequest)) &&
+                 (dtohl (recvData.keyFrameRequest.magic) == ARSTREAM_NETWORK_HEADERS_KEY_FRAME_REQUEST_MAGIC))
+        {
+            recvData.keyFrameRequest.frameNumber = dtohs (recvData.keyFrameRequest.frameNumber);
+            ARSTREAM_Sender_HandleKeyFrameRequest (sender, &(recvData.keyFrameRequest));
+        }
+        else if ((recvSize == sizeof (recvData.frameSkip)) &&
+                 (dtohl (recvData.frameSkip.magic) == ARSTREAM_NETWORK_HEADERS_FRAME_SKIP_MAGIC))
+        {
+            ARSAL_Mutex_Lock (&(sender->ackMutex));
+            ARSTREAM_Sender_FrameWasSkipped (sender, dtohs (recvData.frameSkip.frameNumber));
+            ARSAL_Mutex_Unlock (&(sender->ackMutex));
         }
         else if (recvSize != sizeof (recvPacket))
         {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER_TAG, "Read %d octets, expected %zu", recvSize, sizeof (recvPacket));
+            // Probably sent by a newer reader: log it once, the acks of the same reader are still handled
+            if (sender->unknownAckPacketWasLogged == 0)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER_TAG, "Read %d octets, expected %zu (further unknown packets are ignored silently)", recvSize, sizeof (recvPacket));
+                sender->unknownAckPacketWasLogged = 1;
+            }
         }
         else
         {
             /* Switch recvPacket endianness */
-            recvPacket.frameNumber = dtohs (recvPacket.frameNumber);
-            recvPacket.highPacketsAck = dtohll (recvPacket.highPacketsAck);
-            recvPacket.lowPacketsAck = dtohll (recvPacket.lowPacketsAck);
+            recvPacket.frameNumber = dtohs (recvData.ack.frameNumber);
+            recvPacket.highPacketsAck = dtohll (recvData.ack.highPacketsAck);
+            recvPacket.lowPacketsAck = dtohll (recvData.ack.lowPacketsAck);
 
             /* Apply recvPacket to sender->ackPacket if frame numbers are the same */
             ARSAL_Mutex_Lock (&(sender->ackMutex));
             if (sender->ackPacket.frameNumber == recvPacket.frameNumber)
             {
                 ARSTREAM_NetworkHeaders_AckPacketSetFlags (&(sender->ackPacket), &recvPacket);
+                ARSTREAM_TRACE_POINT (ARSTREAM_TRACE_EVENT_SENDER_ACK_RECEIVED, recvPacket.frameNumber, ARSTREAM_NetworkHeaders_AckPacketCountSet (&(sender->ackPacket), sender->currentFrameNbFragments));
                 if ((sender->currentFrameCbWasCalled == 0) &&
                     (ARSTREAM_NetworkHeaders_AckPacketAllFlagsSet (&(sender->ackPacket), sender->currentFrameNbFragments) == 1))
                 {
@@ -1107,6 +1405,7 @@ void* ARSTREAM_Sender_RunAckThread (void *ARSTREAM_Sender_t_Param)
     }
 
     ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER_TAG, "Ack thread ended");
+    ARSTREAM_TRACE_THREAD_END ();
     sender->ackThreadStarted = 0;
     return (void *)0;
 }
@@ -1121,13 +1420,13 @@ float ARSTREAM_Sender_GetEstimatedEfficiency (ARSTREAM_Sender_t *sender)
     uint32_t totalPackets = 0;
     uint32_t sentPackets = 0;
     int i;
-    ARSAL_Mutex_Lock (&(sender->ackMutex));
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
     for (i = 0; i < ARSTREAM_SENDER_EFFICIENCY_AVERAGE_NB_FRAMES; i++)
     {
         totalPackets += sender->efficiency_nbFragments [i];
         sentPackets += sender->efficiency_nbSent [i];
     }
-    ARSAL_Mutex_Unlock (&(sender->ackMutex));
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
     if (sentPackets == 0)
     {
         retVal = 1.0f; // We didn't send any packet yet, so we have a 100% success !
@@ -1183,3 +1482,66 @@ eARSTREAM_ERROR ARSTREAM_Sender_AddFilter (ARSTREAM_Sender_t *sender, ARSTREAM_F
     }
     return err;
 }
+
+eARSTREAM_ERROR ARSTREAM_Sender_SetImpairment (ARSTREAM_Sender_t *sender, const ARSTREAM_Impairment_Config_t *config)
+{
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    ARSTREAM_Transport_t *impaired;
+
+    if (sender == NULL || config == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (sender->dataThreadStarted != 0 ||
+        sender->ackThreadStarted != 0)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    /* Already impaired : only replace the configuration */
+    if (ARSTREAM_Transport_SetImpairmentConfig (sender->transport, config) == ARSTREAM_OK)
+    {
+        return ARSTREAM_OK;
+    }
+
+    impaired = ARSTREAM_Transport_NewImpairment (sender->transport, config, &err);
+    if (impaired != NULL)
+    {
+        sender->transport = impaired;
+    }
+    return err;
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender_GetImpairmentStats (ARSTREAM_Sender_t *sender, ARSTREAM_Impairment_Stats_t *stats)
+{
+    if (sender == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    return ARSTREAM_Transport_GetImpairmentStats (sender->transport, stats);
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender_GetStats (ARSTREAM_Sender_t *sender, ARSTREAM_Sender_Stats_t *stats)
+{
+    if ((sender == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    /* Only statsMutex is taken here : ackMutex and nextFrameMutex are
+     * held while calling the callback, from which this can be called */
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    *stats = sender->sendStats;
+    stats->nbFramesQueued = sender->queueStats.nbFramesQueued;
+    stats->nbFramesQueueFull = sender->queueStats.nbFramesQueueFull;
+    stats->nbFramesCancelled += sender->queueStats.nbFramesCancelled;
+    stats->queueDepth = sender->queueStats.queueDepth;
+    stats->maxQueueDepth = sender->queueStats.maxQueueDepth;
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+
+    stats->queueSize = sender->maxNumberOfNextFrames;
+    stats->efficiency = ARSTREAM_Sender_GetEstimatedEfficiency (sender);
+    return ARSTREAM_OK;
+}
@@ -0,0 +1,901 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Sender2.c
+ * @brief Stream sender over UDP, using an RTP-like protocol (H.264 payload format, see RFC6184)
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <sys/time.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_NetworkHeaders.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_Sender2.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Socket.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * Tag for ARSAL_PRINT
+ */
+#define ARSTREAM_SENDER2_TAG "ARSTREAM_Sender2"
+
+/**
+ * Time to wait for a new access unit before checking the thread stop flag
+ */
+#define ARSTREAM_SENDER2_AU_WAIT_TIMEOUT_MS (100)
+
+/**
+ * Timeout of the control socket reads, to check the thread stop flag
+ */
+#define ARSTREAM_SENDER2_CONTROL_READ_TIMEOUT_MS (100)
+
+/**
+ * RTP flags : version 2, no padding, no extension, no CSRC, dynamic payload type 96
+ */
+#define ARSTREAM_SENDER2_RTP_FLAGS (0x8060)
+#define ARSTREAM_SENDER2_RTP_MARKER_FLAG (0x0080)
+
+/**
+ * RTP clock rate for video
+ */
+#define ARSTREAM_SENDER2_RTP_CLOCKRATE (90000)
+
+/**
+ * Source of the random SSRC and initial sequence number of each session
+ */
+#define ARSTREAM_SENDER2_RANDOM_DEVICE "/dev/urandom"
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    uint8_t *auBuffer;
+    uint32_t auSize;
+    uint64_t auTimestampUs;
+} ARSTREAM_Sender2_Au_t;
+
+struct ARSTREAM_Sender2_t {
+    /* Configuration on New */
+    ARSTREAM_Sender2_AuCallback_t callback;
+    uint32_t auFifoSize;
+    uint32_t maxPacketSize;
+    void *custom;
+
+    /* Network */
+    int dataSocket;
+    uint8_t *packet;
+    uint32_t ssrc; // Random for each session, so that the reader can tell a restarted sender apart
+    uint16_t seqNum;
+    uint32_t lastRtpTimestamp;
+
+    /* Reports */
+    ARSAL_Mutex_t statsMutex;
+    ARSTREAM_Sender2_Stats_t stats;
+    uint64_t bytesSinceSenderReport;
+    uint64_t lastReceiverReportTime;
+
+    /* Access unit queue */
+    ARSAL_Mutex_t auFifoMutex;
+    ARSAL_Cond_t auFifoCond;
+    ARSTREAM_Sender2_Au_t *auFifo;
+    uint32_t auFifoIndexAdd;
+    uint32_t auFifoIndexGet;
+    uint32_t auFifoCount;
+
+    /* Thread status */
+    int threadsShouldStop;
+    int dataThreadStarted;
+    int controlThreadStarted;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Flush the access unit queue
+ * @param sender The sender to flush
+ * @warning Must be called within a sender->auFifoMutex lock
+ */
+static void ARSTREAM_Sender2_FlushQueue (ARSTREAM_Sender2_t *sender);
+
+/**
+ * @brief Finds the next NAL unit of an H.264 byte stream
+ * @param au The byte stream
+ * @param auSize Size of the byte stream
+ * @param offset Offset where the search starts (updated to the end of the found NAL unit)
+ * @param nalu Pointer which will be set to the beginning of the NAL unit (after its start code)
+ * @param naluSize Pointer which will be set to the size of the NAL unit
+ * @return 1 if a NAL unit was found, 0 otherwise
+ */
+static int ARSTREAM_Sender2_GetNextNalu (uint8_t *au, uint32_t auSize, uint32_t *offset, uint8_t **nalu, uint32_t *naluSize);
+
+/**
+ * @brief Sends the packet built in sender->packet
+ * @param sender The sender
+ * @param payload Pointer to the payload, which must be preceded by sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t) bytes available for the header
+ * @param payloadSize Size of the payload
+ * @param timestamp RTP timestamp of the packet
+ * @param marker Boolean-like (0-1) flag, set on the last packet of an access unit
+ */
+static void ARSTREAM_Sender2_SendPacket (ARSTREAM_Sender2_t *sender, uint8_t *payload, uint32_t payloadSize, uint32_t timestamp, int marker);
+
+/**
+ * @brief Packetizes and sends an access unit
+ * Small NAL units are aggregated in STAP-A packets, and large ones are split in FU-A packets
+ * @param sender The sender
+ * @param au The access unit to send
+ */
+static void ARSTREAM_Sender2_SendAu (ARSTREAM_Sender2_t *sender, ARSTREAM_Sender2_Au_t *au);
+
+/**
+ * @brief Gets the current time of the sender clock
+ * @return The current time, in microseconds
+ */
+static uint64_t ARSTREAM_Sender2_GetTimeUs (void);
+
+/**
+ * @brief Picks the random SSRC and initial sequence number of a new session (see RFC3550 5.1 and 8)
+ * @param sender The sender
+ */
+static void ARSTREAM_Sender2_InitSession (ARSTREAM_Sender2_t *sender);
+
+/**
+ * @brief Sends a sender report if enough data was sent since the last one
+ * @param sender The sender
+ */
+static void ARSTREAM_Sender2_SendSenderReport (ARSTREAM_Sender2_t *sender);
+
+/**
+ * @brief Processes a receiver report from the reader
+ * @param sender The sender
+ * @param report The received report
+ * @param receptionTime Reception time of the report
+ */
+static void ARSTREAM_Sender2_ProcessReceiverReport (ARSTREAM_Sender2_t *sender, ARSTREAM_NetworkHeaders_ReceiverReport_t *report, uint64_t receptionTime);
+
+/*
+ * Internal functions implementation
+ */
+
+static void ARSTREAM_Sender2_FlushQueue (ARSTREAM_Sender2_t *sender)
+{
+    while (sender->auFifoCount > 0)
+    {
+        ARSTREAM_Sender2_Au_t *au = &(sender->auFifo [sender->auFifoIndexGet]);
+        sender->callback (ARSTREAM_SENDER2_STATUS_AU_CANCELLED, au->auBuffer, au->auSize, sender->custom);
+        sender->auFifoIndexGet++;
+        sender->auFifoIndexGet %= sender->auFifoSize;
+        sender->auFifoCount--;
+    }
+}
+
+static int ARSTREAM_Sender2_GetNextNalu (uint8_t *au, uint32_t auSize, uint32_t *offset, uint8_t **nalu, uint32_t *naluSize)
+{
+    uint32_t i = *offset;
+    uint32_t start;
+
+    if (i >= auSize)
+    {
+        return 0;
+    }
+
+    // Skip the start code
+    while ((i + 2 < auSize) &&
+           !((au[i] == 0) && (au[i+1] == 0) && (au[i+2] == 1)))
+    {
+        i++;
+    }
+    if (i + 2 >= auSize)
+    {
+        if (*offset == 0)
+        {
+            // No start code at all, send the whole buffer as a single NAL unit
+            *nalu = au;
+            *naluSize = auSize;
+            *offset = auSize;
+            return 1;
+        }
+        return 0;
+    }
+    start = i + 3;
+
+    // Find the next start code (00 00 00 or 00 00 01)
+    i = start;
+    while ((i + 2 < auSize) &&
+           !((au[i] == 0) && (au[i+1] == 0) && (au[i+2] <= 1)))
+    {
+        i++;
+    }
+    if (i + 2 >= auSize)
+    {
+        i = auSize;
+    }
+
+    *nalu = &au[start];
+    *naluSize = i - start;
+    *offset = i;
+    return (*naluSize > 0) ? 1 : 0;
+}
+
+static void ARSTREAM_Sender2_SendPacket (ARSTREAM_Sender2_t *sender, uint8_t *payload, uint32_t payloadSize, uint32_t timestamp, int marker)
+{
+    ARSTREAM_NetworkHeaders_DataHeader2_t *header = (ARSTREAM_NetworkHeaders_DataHeader2_t *)(payload - sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t));
+    uint16_t flags = ARSTREAM_SENDER2_RTP_FLAGS;
+    if (marker == 1)
+    {
+        flags |= ARSTREAM_SENDER2_RTP_MARKER_FLAG;
+    }
+    header->flags = htons (flags);
+    header->seqNum = htons (sender->seqNum);
+    header->timestamp = htonl (timestamp);
+    header->ssrc = htonl (sender->ssrc);
+    sender->seqNum++;
+    sender->lastRtpTimestamp = timestamp;
+
+    if (ARSAL_Socket_Send (sender->dataSocket, header, payloadSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t), 0) < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Send error : %s", strerror (errno));
+    }
+
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    sender->stats.packetsSent++;
+    sender->stats.bytesSent += payloadSize;
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+    sender->bytesSinceSenderReport += payloadSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t) + ARSTREAM_NETWORK_UDP_HEADER_SIZE + ARSTREAM_NETWORK_IP_HEADER_SIZE;
+}
+
+static void ARSTREAM_Sender2_SendAu (ARSTREAM_Sender2_t *sender, ARSTREAM_Sender2_Au_t *au)
+{
+    uint8_t *payload = sender->packet + sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t);
+    uint32_t maxPayloadSize = sender->maxPacketSize - sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t);
+    uint32_t timestamp = (uint32_t)(au->auTimestampUs * ARSTREAM_SENDER2_RTP_CLOCKRATE / 1000000);
+    uint32_t offset = 0;
+    uint32_t stapSize = 0; // Size of the STAP-A payload being built (0 if none)
+    int stapNbNalus = 0;
+    uint8_t *nalu = NULL;
+    uint32_t naluSize = 0;
+    uint8_t *nextNalu = NULL;
+    uint32_t nextNaluSize = 0;
+    int hasNext;
+
+    hasNext = ARSTREAM_Sender2_GetNextNalu (au->auBuffer, au->auSize, &offset, &nextNalu, &nextNaluSize);
+    while (hasNext == 1)
+    {
+        int isLast;
+        nalu = nextNalu;
+        naluSize = nextNaluSize;
+        hasNext = ARSTREAM_Sender2_GetNextNalu (au->auBuffer, au->auSize, &offset, &nextNalu, &nextNaluSize);
+        isLast = (hasNext == 1) ? 0 : 1;
+
+        // Flush the current aggregation if this NAL unit does not fit in
+        if ((stapSize > 0) &&
+            (stapSize + 2 + naluSize > maxPayloadSize))
+        {
+            if (stapNbNalus == 1)
+            {
+                // Single NAL unit packet : skip the STAP-A and size headers
+                ARSTREAM_Sender2_SendPacket (sender, payload + 3, stapSize - 3, timestamp, 0);
+            }
+            else
+            {
+                ARSTREAM_Sender2_SendPacket (sender, payload, stapSize, timestamp, 0);
+            }
+            stapSize = 0;
+            stapNbNalus = 0;
+        }
+
+        if (1 + 2 + naluSize <= maxPayloadSize)
+        {
+            // Aggregate the NAL unit
+            if (stapSize == 0)
+            {
+                payload[0] = ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_STAPA;
+                stapSize = 1;
+            }
+            // STAP-A header : F bit is the OR of all F bits, NRI is the maximum NRI
+            payload[0] |= (nalu[0] & 0x80);
+            if ((nalu[0] & 0x60) > (payload[0] & 0x60))
+            {
+                payload[0] = (payload[0] & 0x9F) | (nalu[0] & 0x60);
+            }
+            payload[stapSize] = (naluSize >> 8) & 0xFF;
+            payload[stapSize+1] = naluSize & 0xFF;
+            memcpy (&payload[stapSize+2], nalu, naluSize);
+            stapSize += 2 + naluSize;
+            stapNbNalus++;
+        }
+        else
+        {
+            // Fragment the NAL unit in FU-A packets
+            uint8_t naluHeader = nalu[0];
+            uint32_t fragmentOffset = 1;
+            uint32_t maxFragmentSize = maxPayloadSize - 2;
+            while (fragmentOffset < naluSize)
+            {
+                uint32_t fragmentSize = naluSize - fragmentOffset;
+                int isLastFragment = 1;
+                if (fragmentSize > maxFragmentSize)
+                {
+                    fragmentSize = maxFragmentSize;
+                    isLastFragment = 0;
+                }
+                payload[0] = (naluHeader & 0xE0) | ARSTREAM_NETWORK_HEADERS2_NALU_TYPE_FUA;
+                payload[1] = naluHeader & 0x1F;
+                if (fragmentOffset == 1)
+                {
+                    payload[1] |= 0x80; // Start bit
+                }
+                if (isLastFragment == 1)
+                {
+                    payload[1] |= 0x40; // End bit
+                }
+                memcpy (&payload[2], &nalu[fragmentOffset], fragmentSize);
+                ARSTREAM_Sender2_SendPacket (sender, payload, fragmentSize + 2, timestamp, ((isLast == 1) && (isLastFragment == 1)) ? 1 : 0);
+                fragmentOffset += fragmentSize;
+            }
+        }
+
+        if ((isLast == 1) &&
+            (stapSize > 0))
+        {
+            if (stapNbNalus == 1)
+            {
+                ARSTREAM_Sender2_SendPacket (sender, payload + 3, stapSize - 3, timestamp, 1);
+            }
+            else
+            {
+                ARSTREAM_Sender2_SendPacket (sender, payload, stapSize, timestamp, 1);
+            }
+            stapSize = 0;
+            stapNbNalus = 0;
+        }
+    }
+}
+
+static uint64_t ARSTREAM_Sender2_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSAL_Time_GetTime (&now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+static void ARSTREAM_Sender2_InitSession (ARSTREAM_Sender2_t *sender)
+{
+    uint16_t random [3];
+    FILE *device = fopen (ARSTREAM_SENDER2_RANDOM_DEVICE, "rb");
+    if ((device == NULL) ||
+        (fread (random, sizeof (random), 1, device) != 1))
+    {
+        /* Not fatal: the values only have to differ between two sessions, not to be unpredictable */
+        uint64_t seed = ARSTREAM_Sender2_GetTimeUs () ^ (uint64_t)(uintptr_t)sender;
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_SENDER2_TAG, "Unable to read from %s, using the time as the session seed", ARSTREAM_SENDER2_RANDOM_DEVICE);
+        seed = (seed ^ (seed >> 33)) * 0xFF51AFD7ED558CCDULL;
+        seed = (seed ^ (seed >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+        seed ^= seed >> 33;
+        random [0] = (uint16_t)seed;
+        random [1] = (uint16_t)(seed >> 16);
+        random [2] = (uint16_t)(seed >> 32);
+    }
+    if (device != NULL)
+    {
+        fclose (device);
+    }
+    sender->ssrc = ((uint32_t)random [0] << 16) | random [1];
+    sender->seqNum = random [2];
+}
+
+static void ARSTREAM_Sender2_SendSenderReport (ARSTREAM_Sender2_t *sender)
+{
+    ARSTREAM_NetworkHeaders_SenderReport_t report;
+    uint64_t now;
+    uint32_t packetsSent, bytesSent;
+    if (sender->bytesSinceSenderReport < (sizeof (report) + ARSTREAM_NETWORK_UDP_HEADER_SIZE + ARSTREAM_NETWORK_IP_HEADER_SIZE) * ARSTREAM_NETWORK_HEADERS2_RTCP_BANDWIDTH_RATIO)
+    {
+        return;
+    }
+    sender->bytesSinceSenderReport = 0;
+
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    packetsSent = sender->stats.packetsSent;
+    bytesSent = (uint32_t)sender->stats.bytesSent;
+    sender->stats.nbSenderReports++;
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+
+    now = ARSTREAM_Sender2_GetTimeUs ();
+    report.flags = ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_NO_REPORT;
+    report.packetType = ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_SR;
+    report.length = htons (sizeof (report) / 4 - 1);
+    report.ssrc = htonl (sender->ssrc);
+    report.ntpTimestampH = htonl ((uint32_t)(now / 1000000));
+    report.ntpTimestampL = htonl ((uint32_t)(((now % 1000000) << 32) / 1000000));
+    report.rtpTimestamp = htonl (sender->lastRtpTimestamp);
+    report.senderPacketCount = htonl (packetsSent);
+    report.senderByteCount = htonl (bytesSent);
+    if (ARSAL_Socket_Send (sender->dataSocket, &report, sizeof (report), 0) < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Send error : %s", strerror (errno));
+    }
+}
+
+static void ARSTREAM_Sender2_ProcessReceiverReport (ARSTREAM_Sender2_t *sender, ARSTREAM_NetworkHeaders_ReceiverReport_t *report, uint64_t receptionTime)
+{
+    uint32_t lost = ntohl (report->lost);
+    uint32_t lsr = ntohl (report->lsr);
+    uint32_t dlsr = ntohl (report->dlsr);
+    int32_t cumulativeLost = (int32_t)(lost << 8) >> 8; // Sign extend the 24 bits value
+
+    if (ntohl (report->sourceSsrc) != sender->ssrc)
+    {
+        /* The reader did not see this session yet, the report is about a previous sender */
+        return;
+    }
+
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    sender->stats.nbReceiverReports++;
+    sender->stats.fractionLost = (double)(lost >> 24) / 256.;
+    sender->stats.cumulativeLost = cumulativeLost;
+    sender->stats.extHighestSeqNum = ntohl (report->extHighestSeqNum);
+    sender->stats.jitterUs = (uint32_t)((uint64_t)ntohl (report->interarrivalJitter) * 1000000 / ARSTREAM_SENDER2_RTP_CLOCKRATE);
+    if (lsr != 0)
+    {
+        /* Round trip time, using the middle 32 bits of NTP-like timestamps (1/65536 s units) */
+        uint32_t now = (uint32_t)(((receptionTime / 1000000) & 0xFFFF) << 16) | (uint32_t)((((receptionTime % 1000000) << 16) / 1000000) & 0xFFFF);
+        uint32_t rtt = now - lsr - dlsr;
+        if (rtt < 0x80000000)
+        {
+            sender->stats.rttUs = (uint32_t)((uint64_t)rtt * 1000000 / 65536);
+        }
+    }
+    sender->lastReceiverReportTime = receptionTime;
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Sender2_t* ARSTREAM_Sender2_New (const char *readerAddr, int readerPort, ARSTREAM_Sender2_AuCallback_t callback, uint32_t auFifoSize, uint32_t maxPacketSize, void *custom, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Sender2_t *retSender = NULL;
+    int auFifoMutexWasInit = 0;
+    int auFifoCondWasInit = 0;
+    int statsMutexWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    struct sockaddr_in readerSin;
+
+    /* ARGS Check */
+    memset (&readerSin, 0, sizeof (readerSin));
+    readerSin.sin_family = AF_INET;
+    readerSin.sin_port = htons (readerPort);
+    if ((readerAddr == NULL) ||
+        (inet_pton (AF_INET, readerAddr, &(readerSin.sin_addr)) != 1) ||
+        (callback == NULL) ||
+        (auFifoSize == 0) ||
+        (maxPacketSize <= sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t) + 3) ||
+        (maxPacketSize > ARSTREAM_NETWORK_MAX_RTP_PAYLOAD_SIZE + sizeof (ARSTREAM_NetworkHeaders_DataHeader2_t)))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retSender;
+    }
+
+    /* Alloc new sender */
+    retSender = calloc (1, sizeof (ARSTREAM_Sender2_t));
+    if (retSender == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Copy parameters */
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender->callback = callback;
+        retSender->auFifoSize = auFifoSize;
+        retSender->maxPacketSize = maxPacketSize;
+        retSender->custom = custom;
+        retSender->dataSocket = -1;
+        ARSTREAM_Sender2_InitSession (retSender);
+    }
+
+    /* Setup internal mutexes/conds */
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retSender->auFifoMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            auFifoMutexWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        int condInitRet = ARSAL_Cond_Init (&(retSender->auFifoCond));
+        if (condInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            auFifoCondWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retSender->statsMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            statsMutexWasInit = 1;
+        }
+    }
+
+    /* Allocate buffers */
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender->auFifo = malloc (auFifoSize * sizeof (ARSTREAM_Sender2_Au_t));
+        retSender->packet = malloc (maxPacketSize);
+        if ((retSender->auFifo == NULL) ||
+            (retSender->packet == NULL))
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    /* Setup the socket */
+    if (internalError == ARSTREAM_OK)
+    {
+        retSender->dataSocket = ARSAL_Socket_Create (AF_INET, SOCK_DGRAM, 0);
+        if (retSender->dataSocket < 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Socket creation error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else if (ARSAL_Socket_Connect (retSender->dataSocket, (struct sockaddr *)&readerSin, sizeof (readerSin)) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Socket connect error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else
+        {
+            struct timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = ARSTREAM_SENDER2_CONTROL_READ_TIMEOUT_MS * 1000;
+            if (ARSAL_Socket_Setsockopt (retSender->dataSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout)) != 0)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Socket timeout setup error : %s", strerror (errno));
+                internalError = ARSTREAM_ERROR_ALLOC;
+            }
+        }
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retSender != NULL))
+    {
+        if (auFifoMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retSender->auFifoMutex));
+        }
+        if (auFifoCondWasInit == 1)
+        {
+            ARSAL_Cond_Destroy (&(retSender->auFifoCond));
+        }
+        if (statsMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retSender->statsMutex));
+        }
+        if (retSender->dataSocket >= 0)
+        {
+            ARSAL_Socket_Close (retSender->dataSocket);
+        }
+        free (retSender->auFifo);
+        free (retSender->packet);
+        free (retSender);
+        retSender = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retSender;
+}
+
+void ARSTREAM_Sender2_StopSender (ARSTREAM_Sender2_t *sender)
+{
+    if (sender != NULL)
+    {
+        ARSAL_Mutex_Lock (&(sender->auFifoMutex));
+        sender->threadsShouldStop = 1;
+        ARSAL_Cond_Signal (&(sender->auFifoCond));
+        ARSAL_Mutex_Unlock (&(sender->auFifoMutex));
+    }
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender2_Delete (ARSTREAM_Sender2_t **sender)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    if ((sender != NULL) &&
+        (*sender != NULL))
+    {
+        if (((*sender)->dataThreadStarted == 0) &&
+            ((*sender)->controlThreadStarted == 0))
+        {
+            ARSAL_Mutex_Lock (&((*sender)->auFifoMutex));
+            ARSTREAM_Sender2_FlushQueue (*sender);
+            ARSAL_Mutex_Unlock (&((*sender)->auFifoMutex));
+            ARSAL_Mutex_Destroy (&((*sender)->auFifoMutex));
+            ARSAL_Cond_Destroy (&((*sender)->auFifoCond));
+            ARSAL_Mutex_Destroy (&((*sender)->statsMutex));
+            ARSAL_Socket_Close ((*sender)->dataSocket);
+            free ((*sender)->auFifo);
+            free ((*sender)->packet);
+            free (*sender);
+            *sender = NULL;
+            retVal = ARSTREAM_OK;
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Call ARSTREAM_Sender2_StopSender before calling this function");
+            retVal = ARSTREAM_ERROR_BUSY;
+        }
+    }
+    return retVal;
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender2_SendNewAu (ARSTREAM_Sender2_t *sender, uint8_t *auBuffer, uint32_t auSize, uint64_t auTimestampUs, int flushPreviousAus, int *nbPreviousAus)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_OK;
+    // Args check
+    if ((sender == NULL) ||
+        (auBuffer == NULL) ||
+        (auSize == 0) ||
+        ((flushPreviousAus != 0) &&
+         (flushPreviousAus != 1)))
+    {
+        retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    if (retVal == ARSTREAM_OK)
+    {
+        ARSAL_Mutex_Lock (&(sender->auFifoMutex));
+        SET_WITH_CHECK (nbPreviousAus, sender->auFifoCount);
+        if (flushPreviousAus == 1)
+        {
+            ARSTREAM_Sender2_FlushQueue (sender);
+        }
+        if (sender->auFifoCount < sender->auFifoSize)
+        {
+            ARSTREAM_Sender2_Au_t *au = &(sender->auFifo [sender->auFifoIndexAdd]);
+            au->auBuffer = auBuffer;
+            au->auSize = auSize;
+            au->auTimestampUs = auTimestampUs;
+            sender->auFifoIndexAdd++;
+            sender->auFifoIndexAdd %= sender->auFifoSize;
+            sender->auFifoCount++;
+            ARSAL_Cond_Signal (&(sender->auFifoCond));
+        }
+        else
+        {
+            retVal = ARSTREAM_ERROR_QUEUE_FULL;
+        }
+        ARSAL_Mutex_Unlock (&(sender->auFifoMutex));
+    }
+    return retVal;
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender2_FlushAuQueue (ARSTREAM_Sender2_t *sender)
+{
+    if (sender == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ARSAL_Mutex_Lock (&(sender->auFifoMutex));
+    ARSTREAM_Sender2_FlushQueue (sender);
+    ARSAL_Mutex_Unlock (&(sender->auFifoMutex));
+    return ARSTREAM_OK;
+}
+
+void* ARSTREAM_Sender2_RunDataThread (void *ARSTREAM_Sender2_t_Param)
+{
+    ARSTREAM_Sender2_t *sender = (ARSTREAM_Sender2_t *)ARSTREAM_Sender2_t_Param;
+    ARSTREAM_Sender2_Au_t au;
+
+    /* Parameters check */
+    if (sender == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Error while starting %s, bad parameters", __FUNCTION__);
+        return (void *)0;
+    }
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Sender thread running");
+    sender->dataThreadStarted = 1;
+
+    while (sender->threadsShouldStop == 0)
+    {
+        int hasAu = 0;
+        ARSAL_Mutex_Lock (&(sender->auFifoMutex));
+        if ((sender->auFifoCount == 0) &&
+            (sender->threadsShouldStop == 0))
+        {
+            ARSAL_Cond_Timedwait (&(sender->auFifoCond), &(sender->auFifoMutex), ARSTREAM_SENDER2_AU_WAIT_TIMEOUT_MS);
+        }
+        if ((sender->auFifoCount > 0) &&
+            (sender->threadsShouldStop == 0))
+        {
+            au = sender->auFifo [sender->auFifoIndexGet];
+            sender->auFifoIndexGet++;
+            sender->auFifoIndexGet %= sender->auFifoSize;
+            sender->auFifoCount--;
+            hasAu = 1;
+        }
+        ARSAL_Mutex_Unlock (&(sender->auFifoMutex));
+
+        if (hasAu == 1)
+        {
+            ARSTREAM_Sender2_SendAu (sender, &au);
+            ARSTREAM_Sender2_SendSenderReport (sender);
+            sender->callback (ARSTREAM_SENDER2_STATUS_AU_SENT, au.auBuffer, au.auSize, sender->custom);
+        }
+    }
+
+    ARSAL_Mutex_Lock (&(sender->auFifoMutex));
+    ARSTREAM_Sender2_FlushQueue (sender);
+    ARSAL_Mutex_Unlock (&(sender->auFifoMutex));
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Sender thread ended");
+    sender->dataThreadStarted = 0;
+    return (void *)0;
+}
+
+void* ARSTREAM_Sender2_RunControlThread (void *ARSTREAM_Sender2_t_Param)
+{
+    ARSTREAM_Sender2_t *sender = (ARSTREAM_Sender2_t *)ARSTREAM_Sender2_t_Param;
+    union {
+        ARSTREAM_NetworkHeaders_ClockFrame_t clockFrame;
+        ARSTREAM_NetworkHeaders_ReceiverReport_t receiverReport;
+    } recvData;
+
+    /* Parameters check */
+    if (sender == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Error while starting %s, bad parameters", __FUNCTION__);
+        return (void *)0;
+    }
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Control thread running");
+    sender->controlThreadStarted = 1;
+
+    while (sender->threadsShouldStop == 0)
+    {
+        uint64_t receiveTimestamp, transmitTimestamp;
+        ARSTREAM_NetworkHeaders_ClockFrame_t *clockFrame = &(recvData.clockFrame);
+        ssize_t recvSize = ARSAL_Socket_Recv (sender->dataSocket, &recvData, sizeof (recvData), 0);
+        receiveTimestamp = ARSTREAM_Sender2_GetTimeUs ();
+        if (recvSize < 0)
+        {
+            if ((errno != EAGAIN) &&
+                (errno != EWOULDBLOCK) &&
+                (errno != EINTR) &&
+                (errno != ECONNREFUSED))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_SENDER2_TAG, "Error while reading control data: %s", strerror (errno));
+            }
+            continue;
+        }
+
+        if ((recvSize == sizeof (ARSTREAM_NetworkHeaders_ReceiverReport_t)) &&
+            (recvData.receiverReport.flags == ARSTREAM_NETWORK_HEADERS2_RTCP_FLAGS_SINGLE_REPORT) &&
+            (recvData.receiverReport.packetType == ARSTREAM_NETWORK_HEADERS2_RTCP_PACKET_TYPE_RR))
+        {
+            ARSTREAM_Sender2_ProcessReceiverReport (sender, &(recvData.receiverReport), receiveTimestamp);
+            continue;
+        }
+        if (recvSize != sizeof (ARSTREAM_NetworkHeaders_ClockFrame_t))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_SENDER2_TAG, "Invalid control packet size %zd", recvSize);
+            continue;
+        }
+
+        /* Clock request : keep the originate timestamp, add ours */
+        clockFrame->receiveTimestampH = htonl ((uint32_t)(receiveTimestamp >> 32));
+        clockFrame->receiveTimestampL = htonl ((uint32_t)(receiveTimestamp & 0xFFFFFFFF));
+        transmitTimestamp = ARSTREAM_Sender2_GetTimeUs ();
+        clockFrame->transmitTimestampH = htonl ((uint32_t)(transmitTimestamp >> 32));
+        clockFrame->transmitTimestampL = htonl ((uint32_t)(transmitTimestamp & 0xFFFFFFFF));
+        if (ARSAL_Socket_Send (sender->dataSocket, clockFrame, sizeof (ARSTREAM_NetworkHeaders_ClockFrame_t), 0) < 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Send error : %s", strerror (errno));
+        }
+    }
+
+    ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_SENDER2_TAG, "Control thread ended");
+    sender->controlThreadStarted = 0;
+    return (void *)0;
+}
+
+eARSTREAM_ERROR ARSTREAM_Sender2_GetStats (ARSTREAM_Sender2_t *sender, ARSTREAM_Sender2_Stats_t *stats)
+{
+    if ((sender == NULL) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ARSAL_Mutex_Lock (&(sender->statsMutex));
+    *stats = sender->stats;
+    if (sender->stats.nbReceiverReports > 0)
+    {
+        stats->lastReportAgeMs = (uint32_t)((ARSTREAM_Sender2_GetTimeUs () - sender->lastReceiverReportTime) / 1000);
+    }
+    ARSAL_Mutex_Unlock (&(sender->statsMutex));
+    return ARSTREAM_OK;
+}
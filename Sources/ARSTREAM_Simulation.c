@@ -0,0 +1,560 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Simulation.c
+ * @brief Virtual clock and discrete-event scheduler of the simulation builds
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARStream/ARSTREAM_Simulation.h>
+#include <libARSAL/ARSAL_Print.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_SIMULATION_TAG "ARSTREAM_Simulation"
+
+/**
+ * Deadline of the waits without timeout
+ */
+#define ARSTREAM_SIMULATION_NO_DEADLINE (UINT64_MAX)
+
+/*
+ * Types
+ */
+
+typedef enum {
+    ARSTREAM_SIMULATION_THREAD_STATE_RUNNABLE = 0, /**< Running, or waiting for its turn */
+    ARSTREAM_SIMULATION_THREAD_STATE_WAITING, /**< Waiting for a notification or a deadline */
+    ARSTREAM_SIMULATION_THREAD_STATE_FINISHED, /**< Routine returned, waiting to be joined */
+} eARSTREAM_SIMULATION_THREAD_STATE;
+
+typedef struct ARSTREAM_Simulation_Thread_t ARSTREAM_Simulation_Thread_t;
+
+/**
+ * @brief A simulated thread
+ */
+struct ARSTREAM_Simulation_Thread_t {
+    uint32_t id; /**< Creation order, used to order the threads woken at the same time */
+    eARSTREAM_SIMULATION_THREAD_STATE state;
+    const void *waitObject;
+    uint64_t deadlineUs;
+    int timedOut;
+    ARSAL_Cond_t turnCond; /**< Signaled when the thread gets the turn */
+
+    ARSAL_Thread_t handle;
+    ARSAL_Thread_Routine_t routine;
+    void *arg;
+    void *retval;
+
+    ARSTREAM_Simulation_Thread_t *next; /**< All threads, by id */
+    ARSTREAM_Simulation_Thread_t *nextRunnable; /**< Runnable queue */
+};
+
+/**
+ * @brief The scheduler
+ */
+typedef struct {
+    ARSAL_Mutex_t mutex;
+    uint64_t nowUs;
+    uint64_t nbSwitches;
+    uint32_t nextId;
+    ARSTREAM_Simulation_Thread_t *threads;
+    ARSTREAM_Simulation_Thread_t *runnableHead;
+    ARSTREAM_Simulation_Thread_t *runnableTail;
+    ARSTREAM_Simulation_Thread_t *current; /**< The only thread allowed to run */
+    ARSTREAM_Simulation_Thread_t *mainThread;
+} ARSTREAM_Simulation_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Allocates a thread and adds it to the thread list
+ * @warning Called with the mutex locked
+ */
+static ARSTREAM_Simulation_Thread_t* ARSTREAM_Simulation_NewThread (void);
+
+/**
+ * @brief Adds a thread at the end of the runnable queue
+ * @warning Called with the mutex locked
+ */
+static void ARSTREAM_Simulation_MakeRunnable (ARSTREAM_Simulation_Thread_t *thread, int timedOut);
+
+/**
+ * @brief Gives the turn to the next runnable thread, advancing the virtual clock if needed
+ * @warning Called with the mutex locked
+ */
+static void ARSTREAM_Simulation_ScheduleNext (void);
+
+/**
+ * @brief Puts the calling thread in the waiting state, and returns when it gets the turn again
+ * @return 0 if notified, ETIMEDOUT if the deadline was reached
+ * @warning Called with the mutex locked
+ */
+static int ARSTREAM_Simulation_Park (ARSTREAM_Simulation_Thread_t *self, const void *object, uint64_t deadlineUs);
+
+/**
+ * @brief Routine of the real threads behind the simulated threads
+ */
+static void* ARSTREAM_Simulation_ThreadTrampoline (void *param);
+
+/*
+ * Internal variables
+ */
+
+static ARSTREAM_Simulation_t *g_simulation = NULL;
+static __thread ARSTREAM_Simulation_Thread_t *g_self = NULL;
+
+/*
+ * Internal functions implementation
+ */
+
+static ARSTREAM_Simulation_Thread_t* ARSTREAM_Simulation_NewThread (void)
+{
+    ARSTREAM_Simulation_Thread_t *thread = calloc (1, sizeof (ARSTREAM_Simulation_Thread_t));
+    ARSTREAM_Simulation_Thread_t **last;
+    if (thread == NULL)
+    {
+        return NULL;
+    }
+    if (ARSAL_Cond_Init (&(thread->turnCond)) != 0)
+    {
+        free (thread);
+        return NULL;
+    }
+    thread->id = g_simulation->nextId++;
+    thread->state = ARSTREAM_SIMULATION_THREAD_STATE_RUNNABLE;
+    thread->deadlineUs = ARSTREAM_SIMULATION_NO_DEADLINE;
+    for (last = &(g_simulation->threads); *last != NULL; last = &((*last)->next))
+    {
+    }
+    *last = thread;
+    return thread;
+}
+
+static void ARSTREAM_Simulation_MakeRunnable (ARSTREAM_Simulation_Thread_t *thread, int timedOut)
+{
+    thread->state = ARSTREAM_SIMULATION_THREAD_STATE_RUNNABLE;
+    thread->waitObject = NULL;
+    thread->deadlineUs = ARSTREAM_SIMULATION_NO_DEADLINE;
+    thread->timedOut = timedOut;
+    thread->nextRunnable = NULL;
+    if (g_simulation->runnableTail != NULL)
+    {
+        g_simulation->runnableTail->nextRunnable = thread;
+    }
+    else
+    {
+        g_simulation->runnableHead = thread;
+    }
+    g_simulation->runnableTail = thread;
+}
+
+static void ARSTREAM_Simulation_ScheduleNext (void)
+{
+    ARSTREAM_Simulation_Thread_t *next;
+
+    if (g_simulation->runnableHead == NULL)
+    {
+        /* Everybody waits : jump to the earliest deadline, and wake all the threads waiting for it */
+        ARSTREAM_Simulation_Thread_t *thread;
+        uint64_t earliestUs = ARSTREAM_SIMULATION_NO_DEADLINE;
+        for (thread = g_simulation->threads; thread != NULL; thread = thread->next)
+        {
+            if ((thread->state == ARSTREAM_SIMULATION_THREAD_STATE_WAITING) &&
+                (thread->deadlineUs < earliestUs))
+            {
+                earliestUs = thread->deadlineUs;
+            }
+        }
+        if (earliestUs == ARSTREAM_SIMULATION_NO_DEADLINE)
+        {
+            // No thread can ever be woken : leave the turn unassigned, a thread finishing may be the last one
+            g_simulation->current = NULL;
+            return;
+        }
+        if (earliestUs > g_simulation->nowUs)
+        {
+            g_simulation->nowUs = earliestUs;
+        }
+        for (thread = g_simulation->threads; thread != NULL; thread = thread->next)
+        {
+            if ((thread->state == ARSTREAM_SIMULATION_THREAD_STATE_WAITING) &&
+                (thread->deadlineUs <= g_simulation->nowUs))
+            {
+                ARSTREAM_Simulation_MakeRunnable (thread, 1);
+            }
+        }
+    }
+
+    next = g_simulation->runnableHead;
+    g_simulation->runnableHead = next->nextRunnable;
+    if (g_simulation->runnableHead == NULL)
+    {
+        g_simulation->runnableTail = NULL;
+    }
+    next->nextRunnable = NULL;
+    g_simulation->current = next;
+    g_simulation->nbSwitches++;
+    ARSAL_Cond_Signal (&(next->turnCond));
+}
+
+static int ARSTREAM_Simulation_Park (ARSTREAM_Simulation_Thread_t *self, const void *object, uint64_t deadlineUs)
+{
+    self->state = ARSTREAM_SIMULATION_THREAD_STATE_WAITING;
+    self->waitObject = object;
+    self->deadlineUs = deadlineUs;
+    self->timedOut = 0;
+    ARSTREAM_Simulation_ScheduleNext ();
+    if (g_simulation->current == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_FATAL, ARSTREAM_SIMULATION_TAG, "Deadlock : all the simulated threads wait without deadline (at %llu us)", (unsigned long long)g_simulation->nowUs);
+        abort ();
+    }
+    while (g_simulation->current != self)
+    {
+        ARSAL_Cond_Wait (&(self->turnCond), &(g_simulation->mutex));
+    }
+    return (self->timedOut != 0) ? ETIMEDOUT : 0;
+}
+
+static void* ARSTREAM_Simulation_ThreadTrampoline (void *param)
+{
+    ARSTREAM_Simulation_Thread_t *self = (ARSTREAM_Simulation_Thread_t *)param;
+    ARSTREAM_Simulation_Thread_t *thread;
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    g_self = self;
+    while (g_simulation->current != self)
+    {
+        ARSAL_Cond_Wait (&(self->turnCond), &(g_simulation->mutex));
+    }
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+
+    self->retval = self->routine (self->arg);
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    self->state = ARSTREAM_SIMULATION_THREAD_STATE_FINISHED;
+    for (thread = g_simulation->threads; thread != NULL; thread = thread->next)
+    {
+        if ((thread->state == ARSTREAM_SIMULATION_THREAD_STATE_WAITING) &&
+            (thread->waitObject == self))
+        {
+            ARSTREAM_Simulation_MakeRunnable (thread, 0);
+        }
+    }
+    ARSTREAM_Simulation_ScheduleNext ();
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    return self->retval;
+}
+
+/*
+ * Implementation
+ */
+
+eARSTREAM_ERROR ARSTREAM_Simulation_Init (uint64_t startTimeUs)
+{
+    ARSTREAM_Simulation_t *simulation;
+
+    if (g_simulation != NULL)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+    simulation = calloc (1, sizeof (ARSTREAM_Simulation_t));
+    if (simulation == NULL)
+    {
+        return ARSTREAM_ERROR_ALLOC;
+    }
+    if (ARSAL_Mutex_Init (&(simulation->mutex)) != 0)
+    {
+        free (simulation);
+        return ARSTREAM_ERROR_ALLOC;
+    }
+    simulation->nowUs = startTimeUs;
+    g_simulation = simulation;
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    g_self = ARSTREAM_Simulation_NewThread ();
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    if (g_self == NULL)
+    {
+        ARSAL_Mutex_Destroy (&(simulation->mutex));
+        free (simulation);
+        g_simulation = NULL;
+        return ARSTREAM_ERROR_ALLOC;
+    }
+    simulation->mainThread = g_self;
+    simulation->current = g_self;
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Simulation_Deinit (void)
+{
+    if ((g_simulation == NULL) ||
+        (g_self != g_simulation->mainThread))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    if (g_simulation->threads->next != NULL)
+    {
+        return ARSTREAM_ERROR_BUSY;
+    }
+    ARSAL_Cond_Destroy (&(g_self->turnCond));
+    free (g_self);
+    g_self = NULL;
+    ARSAL_Mutex_Destroy (&(g_simulation->mutex));
+    free (g_simulation);
+    g_simulation = NULL;
+    return ARSTREAM_OK;
+}
+
+int ARSTREAM_Simulation_GetTime (struct timespec *res)
+{
+    uint64_t nowUs = ARSTREAM_Simulation_GetTimeUs ();
+    res->tv_sec = (time_t)(nowUs / 1000000);
+    res->tv_nsec = (long)(nowUs % 1000000) * 1000;
+    return 0;
+}
+
+uint64_t ARSTREAM_Simulation_GetTimeUs (void)
+{
+    uint64_t nowUs;
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    nowUs = g_simulation->nowUs;
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    return nowUs;
+}
+
+uint64_t ARSTREAM_Simulation_GetNbSwitches (void)
+{
+    uint64_t nbSwitches;
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    nbSwitches = g_simulation->nbSwitches;
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    return nbSwitches;
+}
+
+void ARSTREAM_Simulation_SleepUs (uint64_t us)
+{
+    ARSTREAM_Simulation_Wait (NULL, ARSTREAM_Simulation_GetTimeUs () + us);
+}
+
+int ARSTREAM_Simulation_Wait (const void *object, uint64_t deadlineUs)
+{
+    int retVal;
+    if (g_self == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_FATAL, ARSTREAM_SIMULATION_TAG, "Wait called from a thread which is not simulated");
+        abort ();
+    }
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    if (deadlineUs < g_simulation->nowUs)
+    {
+        deadlineUs = g_simulation->nowUs;
+    }
+    retVal = ARSTREAM_Simulation_Park (g_self, object, deadlineUs);
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    return retVal;
+}
+
+void ARSTREAM_Simulation_Notify (const void *object, int all)
+{
+    ARSTREAM_Simulation_Thread_t *thread;
+    ARSTREAM_Simulation_Thread_t *oldest = NULL;
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    for (thread = g_simulation->threads; thread != NULL; thread = thread->next)
+    {
+        if ((thread->state == ARSTREAM_SIMULATION_THREAD_STATE_WAITING) &&
+            (thread->waitObject == object) &&
+            (object != NULL))
+        {
+            if (all != 0)
+            {
+                ARSTREAM_Simulation_MakeRunnable (thread, 0);
+            }
+            else if (oldest == NULL)
+            {
+                oldest = thread;
+            }
+        }
+    }
+    if (oldest != NULL)
+    {
+        ARSTREAM_Simulation_MakeRunnable (oldest, 0);
+    }
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+}
+
+int ARSTREAM_Simulation_CondWait (ARSAL_Cond_t *cond, ARSAL_Mutex_t *mutex)
+{
+    int retVal;
+    ARSAL_Mutex_Unlock (mutex);
+    retVal = ARSTREAM_Simulation_Wait (cond, ARSTREAM_SIMULATION_NO_DEADLINE);
+    ARSAL_Mutex_Lock (mutex);
+    return retVal;
+}
+
+int ARSTREAM_Simulation_CondTimedwait (ARSAL_Cond_t *cond, ARSAL_Mutex_t *mutex, int timeout)
+{
+    int retVal;
+    uint64_t deadlineUs = ARSTREAM_Simulation_GetTimeUs ();
+    if (timeout > 0)
+    {
+        deadlineUs += (uint64_t)timeout * 1000;
+    }
+    ARSAL_Mutex_Unlock (mutex);
+    retVal = ARSTREAM_Simulation_Wait (cond, deadlineUs);
+    ARSAL_Mutex_Lock (mutex);
+    if (retVal != 0)
+    {
+        errno = retVal;
+    }
+    return retVal;
+}
+
+int ARSTREAM_Simulation_CondSignal (ARSAL_Cond_t *cond)
+{
+    ARSTREAM_Simulation_Notify (cond, 0);
+    return 0;
+}
+
+int ARSTREAM_Simulation_CondBroadcast (ARSAL_Cond_t *cond)
+{
+    ARSTREAM_Simulation_Notify (cond, 1);
+    return 0;
+}
+
+int ARSTREAM_Simulation_ThreadCreate (ARSAL_Thread_t *thread, ARSAL_Thread_Routine_t routine, void *arg)
+{
+    ARSTREAM_Simulation_Thread_t *simThread;
+    int retVal = 0;
+
+    if ((thread == NULL) ||
+        (routine == NULL))
+    {
+        return -1;
+    }
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    simThread = ARSTREAM_Simulation_NewThread ();
+    if (simThread != NULL)
+    {
+        simThread->routine = routine;
+        simThread->arg = arg;
+        if (ARSAL_Thread_Create (&(simThread->handle), ARSTREAM_Simulation_ThreadTrampoline, simThread) != 0)
+        {
+            // Never started : remove it from the list (it is the last one)
+            ARSTREAM_Simulation_Thread_t **last;
+            for (last = &(g_simulation->threads); *last != simThread; last = &((*last)->next))
+            {
+            }
+            *last = NULL;
+            ARSAL_Cond_Destroy (&(simThread->turnCond));
+            free (simThread);
+            simThread = NULL;
+        }
+    }
+    if (simThread != NULL)
+    {
+        ARSTREAM_Simulation_MakeRunnable (simThread, 0);
+        *thread = simThread->handle;
+    }
+    else
+    {
+        retVal = -1;
+    }
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+    return retVal;
+}
+
+int ARSTREAM_Simulation_ThreadJoin (ARSAL_Thread_t thread, void **retval)
+{
+    ARSTREAM_Simulation_Thread_t *simThread;
+    ARSTREAM_Simulation_Thread_t **link;
+
+    ARSAL_Mutex_Lock (&(g_simulation->mutex));
+    for (link = &(g_simulation->threads); *link != NULL; link = &((*link)->next))
+    {
+        if (((*link)->handle == thread) &&
+            ((*link) != g_simulation->mainThread))
+        {
+            break;
+        }
+    }
+    simThread = *link;
+    if (simThread == NULL)
+    {
+        ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+        return -1;
+    }
+    while (simThread->state != ARSTREAM_SIMULATION_THREAD_STATE_FINISHED)
+    {
+        ARSTREAM_Simulation_Park (g_self, simThread, ARSTREAM_SIMULATION_NO_DEADLINE);
+    }
+    /* The list may have changed while we waited */
+    for (link = &(g_simulation->threads); *link != simThread; link = &((*link)->next))
+    {
+    }
+    *link = simThread->next;
+    ARSAL_Mutex_Unlock (&(g_simulation->mutex));
+
+    ARSAL_Thread_Join (thread, NULL);
+    if (retval != NULL)
+    {
+        *retval = simThread->retval;
+    }
+    ARSAL_Cond_Destroy (&(simThread->turnCond));
+    free (simThread);
+    return 0;
+}
+
+#endif /* ARSTREAM_SIMULATION */
@@ -0,0 +1,555 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Trace.c
+ * @brief Per-frame lifecycle tracing of the stream sender and reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_Clock.h"
+#include "ARSTREAM_TracePoints.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRACE_TAG "ARSTREAM_Trace"
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Events of a thread
+ * Single producer (the owner thread) / single consumer (ARSTREAM_Trace_Drain) ring
+ */
+typedef struct {
+    uint32_t tail; /**< Next event to write, only written by the owner */
+    uint8_t padding [60]; /**< Keeps the producer and consumer indexes on different cache lines */
+    uint32_t head; /**< Next event to read, only written by the drain */
+    uint32_t mask;
+    uint32_t index;
+    int isOwned; /**< 0 once the owner called ARSTREAM_Trace_ReleaseThread() */
+    uint64_t nbDropped;
+    char name [ARSTREAM_TRACE_THREAD_NAME_SIZE];
+    ARSTREAM_Trace_Event_t *events;
+} ARSTREAM_Trace_Ring_t;
+
+/**
+ * @brief State of the Chrome JSON writer
+ */
+typedef struct {
+    FILE *file;
+    int isFirst;
+} ARSTREAM_Trace_JsonWriter_t;
+
+/*
+ * Internal functions declarations
+ */
+
+#if ARSTREAM_TRACE
+
+/**
+ * @brief Gets the ring of the calling thread, reusing a released ring or creating a new one if needed
+ * @return The ring, or NULL if ARSTREAM_TRACE_MAX_THREADS rings are owned
+ */
+static ARSTREAM_Trace_Ring_t* ARSTREAM_Trace_GetRing (void);
+
+#endif /* ARSTREAM_TRACE */
+
+/**
+ * @brief Writes a string as a JSON string
+ */
+static void ARSTREAM_Trace_WriteJsonString (FILE *file, const char *string);
+
+/**
+ * @brief Begins a new element of the traceEvents array
+ */
+static void ARSTREAM_Trace_BeginJsonEvent (ARSTREAM_Trace_JsonWriter_t *writer);
+
+/**
+ * @brief ARSTREAM_Trace_Callback_t of ARSTREAM_Trace_WriteChromeJson()
+ */
+static void ARSTREAM_Trace_WriteJsonEvent (const ARSTREAM_Trace_Event_t *event, const char *threadName, void *custom);
+
+/*
+ * Internal variables
+ */
+
+static const char *g_eventNames [ARSTREAM_TRACE_EVENT_MAX] = {
+    "SENDER_FRAME_QUEUED",
+    "SENDER_FILTERS_BEGIN",
+    "SENDER_FILTERS_END",
+    "SENDER_FRAME_START",
+    "SENDER_FIRST_FRAGMENT",
+    "SENDER_RETRY",
+    "SENDER_ACK_RECEIVED",
+    "SENDER_FRAME_ACKED",
+    "SENDER_FRAME_CANCELLED",
+    "READER_FIRST_FRAGMENT",
+    "READER_FRAME_COMPLETE",
+    "READER_FILTERS_BEGIN",
+    "READER_FILTERS_END",
+    "READER_FRAME_DELIVERED",
+    "READER_FRAME_PARTIAL",
+    "READER_FRAME_DROPPED",
+    "READER_FRAME_SKIPPED",
+    "READER_ACK_SENT",
+};
+
+static ARSTREAM_Trace_Ring_t *g_rings [ARSTREAM_TRACE_MAX_THREADS];
+static uint32_t g_nbRings = 0;
+static uint32_t g_ringSize = ARSTREAM_TRACE_DEFAULT_RING_SIZE;
+static uint64_t g_nbDroppedWithoutRing = 0;
+static int g_isDraining = 0;
+
+static __thread ARSTREAM_Trace_Ring_t *g_threadRing = NULL;
+static __thread char g_threadName [ARSTREAM_TRACE_THREAD_NAME_SIZE];
+
+#if ARSTREAM_TRACE
+int ARSTREAM_Trace_IsEnabled = 0;
+#endif
+
+/*
+ * Internal functions implementation
+ */
+
+#if ARSTREAM_TRACE
+
+static ARSTREAM_Trace_Ring_t* ARSTREAM_Trace_GetRing (void)
+{
+    ARSTREAM_Trace_Ring_t *ring = NULL;
+    uint32_t nbRings = __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE);
+    uint32_t i;
+
+    /* Reuse a drained ring of a finished thread */
+    for (i = 0; (i < nbRings) && (i < ARSTREAM_TRACE_MAX_THREADS) && (ring == NULL); i++)
+    {
+        ARSTREAM_Trace_Ring_t *candidate = __atomic_load_n (&(g_rings [i]), __ATOMIC_ACQUIRE);
+        int notOwned = 0;
+        if ((candidate != NULL) &&
+            (__atomic_load_n (&(candidate->head), __ATOMIC_ACQUIRE) == candidate->tail) &&
+            (__atomic_compare_exchange_n (&(candidate->isOwned), &notOwned, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)))
+        {
+            ring = candidate;
+        }
+    }
+
+    /* Or create a new one */
+    while ((ring == NULL) &&
+           (nbRings < ARSTREAM_TRACE_MAX_THREADS))
+    {
+        if (__atomic_compare_exchange_n (&g_nbRings, &nbRings, nbRings + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            uint32_t size = __atomic_load_n (&g_ringSize, __ATOMIC_RELAXED);
+            ring = calloc (1, sizeof (ARSTREAM_Trace_Ring_t));
+            if (ring != NULL)
+            {
+                ring->events = malloc (size * sizeof (ARSTREAM_Trace_Event_t));
+                if (ring->events == NULL)
+                {
+                    free (ring);
+                    ring = NULL;
+                }
+            }
+            if (ring == NULL)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRACE_TAG, "Unable to allocate a trace ring");
+                break;
+            }
+            ring->mask = size - 1;
+            ring->index = nbRings;
+            ring->isOwned = 1;
+            __atomic_store_n (&(g_rings [nbRings]), ring, __ATOMIC_RELEASE);
+        }
+    }
+
+    if (ring != NULL)
+    {
+        if (g_threadName [0] != '\0')
+        {
+            memcpy (ring->name, g_threadName, ARSTREAM_TRACE_THREAD_NAME_SIZE);
+        }
+        else
+        {
+            snprintf (ring->name, ARSTREAM_TRACE_THREAD_NAME_SIZE, "thread-%u", ring->index);
+        }
+        g_threadRing = ring;
+    }
+    return ring;
+}
+
+#endif /* ARSTREAM_TRACE */
+
+static void ARSTREAM_Trace_WriteJsonString (FILE *file, const char *string)
+{
+    fputc ('"', file);
+    for (; *string != '\0'; string++)
+    {
+        if ((*string == '"') ||
+            (*string == '\\'))
+        {
+            fputc ('\\', file);
+            fputc (*string, file);
+        }
+        else if ((unsigned char)*string >= 0x20)
+        {
+            fputc (*string, file);
+        }
+    }
+    fputc ('"', file);
+}
+
+static void ARSTREAM_Trace_BeginJsonEvent (ARSTREAM_Trace_JsonWriter_t *writer)
+{
+    fputs ((writer->isFirst != 0) ? "\n" : ",\n", writer->file);
+    writer->isFirst = 0;
+}
+
+static void ARSTREAM_Trace_WriteJsonEvent (const ARSTREAM_Trace_Event_t *event, const char *threadName, void *custom)
+{
+    ARSTREAM_Trace_JsonWriter_t *writer = (ARSTREAM_Trace_JsonWriter_t *)custom;
+    FILE *file = writer->file;
+    unsigned long long tsUs = (unsigned long long)(event->timestampNs / 1000);
+    unsigned int tsNs = (unsigned int)(event->timestampNs % 1000);
+    unsigned int tid = (unsigned int)event->threadIndex + 1;
+    const char *name = ARSTREAM_Trace_EventToString ((eARSTREAM_TRACE_EVENT)event->event);
+    const char *category = (event->event < ARSTREAM_TRACE_EVENT_READER_FIRST_FRAGMENT) ? "sender" : "reader";
+    const char *phase = "i";
+    const char *asyncPhase = NULL;
+
+    (void)threadName;
+
+    switch (event->event)
+    {
+    case ARSTREAM_TRACE_EVENT_SENDER_FILTERS_BEGIN:
+    case ARSTREAM_TRACE_EVENT_READER_FILTERS_BEGIN:
+        phase = "B";
+        name = "filters";
+        break;
+    case ARSTREAM_TRACE_EVENT_SENDER_FILTERS_END:
+    case ARSTREAM_TRACE_EVENT_READER_FILTERS_END:
+        phase = "E";
+        name = "filters";
+        break;
+    case ARSTREAM_TRACE_EVENT_SENDER_FRAME_QUEUED:
+    case ARSTREAM_TRACE_EVENT_READER_FIRST_FRAGMENT:
+        asyncPhase = "b";
+        break;
+    case ARSTREAM_TRACE_EVENT_SENDER_FRAME_ACKED:
+    case ARSTREAM_TRACE_EVENT_SENDER_FRAME_CANCELLED:
+    case ARSTREAM_TRACE_EVENT_READER_FRAME_DELIVERED:
+    case ARSTREAM_TRACE_EVENT_READER_FRAME_PARTIAL:
+    case ARSTREAM_TRACE_EVENT_READER_FRAME_DROPPED:
+    case ARSTREAM_TRACE_EVENT_READER_FRAME_SKIPPED:
+        asyncPhase = "e";
+        break;
+    default:
+        break;
+    }
+
+    ARSTREAM_Trace_BeginJsonEvent (writer);
+    fprintf (file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",%s\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%u,\"arg\":%u}}",
+             name, category, phase, (phase [0] == 'i') ? "\"s\":\"t\"," : "", tsUs, tsNs, tid,
+             (unsigned int)event->frameNumber, (unsigned int)event->arg);
+
+    /* Life of the frame, as an async slice */
+    if (asyncPhase != NULL)
+    {
+        ARSTREAM_Trace_BeginJsonEvent (writer);
+        fprintf (file, "{\"name\":\"%s frame\",\"cat\":\"%s_frame\",\"ph\":\"%s\",\"id\":\"0x%x\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%u,\"end\":\"%s\"}}",
+                 category, category, asyncPhase, (unsigned int)event->frameNumber, tsUs, tsNs, tid,
+                 (unsigned int)event->frameNumber, (asyncPhase [0] == 'e') ? name : "");
+    }
+}
+
+/*
+ * Implementation
+ */
+
+eARSTREAM_ERROR ARSTREAM_Trace_Enable (int enable)
+{
+#if ARSTREAM_TRACE
+    __atomic_store_n (&ARSTREAM_Trace_IsEnabled, (enable != 0) ? 1 : 0, __ATOMIC_RELAXED);
+    return ARSTREAM_OK;
+#else
+    (void)enable;
+    return ARSTREAM_ERROR_BAD_PARAMETERS;
+#endif
+}
+
+eARSTREAM_ERROR ARSTREAM_Trace_SetRingSize (uint32_t nbEvents)
+{
+    if ((nbEvents < 2) ||
+        ((nbEvents & (nbEvents - 1)) != 0))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    __atomic_store_n (&g_ringSize, nbEvents, __ATOMIC_RELAXED);
+    return ARSTREAM_OK;
+}
+
+void ARSTREAM_Trace_SetThreadName (const char *name)
+{
+    if (name == NULL)
+    {
+        return;
+    }
+    snprintf (g_threadName, ARSTREAM_TRACE_THREAD_NAME_SIZE, "%s", name);
+    if (g_threadRing != NULL)
+    {
+        memcpy (g_threadRing->name, g_threadName, ARSTREAM_TRACE_THREAD_NAME_SIZE);
+    }
+}
+
+void ARSTREAM_Trace_ReleaseThread (void)
+{
+    if (g_threadRing != NULL)
+    {
+        __atomic_store_n (&(g_threadRing->isOwned), 0, __ATOMIC_RELEASE);
+        g_threadRing = NULL;
+    }
+    g_threadName [0] = '\0';
+}
+
+#if ARSTREAM_TRACE
+
+void ARSTREAM_Trace_Record (eARSTREAM_TRACE_EVENT event, uint16_t frameNumber, uint32_t arg)
+{
+    ARSTREAM_Trace_Ring_t *ring = g_threadRing;
+    ARSTREAM_Trace_Event_t *slot;
+    struct timespec now;
+    uint32_t tail, head;
+
+    if (ring == NULL)
+    {
+        ring = ARSTREAM_Trace_GetRing ();
+        if (ring == NULL)
+        {
+            __atomic_add_fetch (&g_nbDroppedWithoutRing, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    tail = ring->tail;
+    head = __atomic_load_n (&(ring->head), __ATOMIC_ACQUIRE);
+    if ((tail - head) > ring->mask)
+    {
+        __atomic_add_fetch (&(ring->nbDropped), 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    ARSTREAM_Clock_GetTime (&now);
+    slot = &(ring->events [tail & ring->mask]);
+    slot->timestampNs = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    slot->arg = arg;
+    slot->frameNumber = frameNumber;
+    slot->event = (uint8_t)event;
+    slot->threadIndex = (uint8_t)ring->index;
+    __atomic_store_n (&(ring->tail), tail + 1, __ATOMIC_RELEASE);
+}
+
+#endif /* ARSTREAM_TRACE */
+
+const char* ARSTREAM_Trace_EventToString (eARSTREAM_TRACE_EVENT event)
+{
+    if ((event < 0) ||
+        (event >= ARSTREAM_TRACE_EVENT_MAX))
+    {
+        return "UNKNOWN";
+    }
+    return g_eventNames [event];
+}
+
+int ARSTREAM_Trace_Drain (ARSTREAM_Trace_Callback_t callback, void *custom)
+{
+    int notDraining = 0;
+    int nbEvents = 0;
+    uint32_t nbRings, i;
+
+    if (callback == NULL)
+    {
+        return 0;
+    }
+    if (!__atomic_compare_exchange_n (&g_isDraining, &notDraining, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return -1;
+    }
+
+    nbRings = __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE);
+    for (i = 0; (i < nbRings) && (i < ARSTREAM_TRACE_MAX_THREADS); i++)
+    {
+        ARSTREAM_Trace_Ring_t *ring = __atomic_load_n (&(g_rings [i]), __ATOMIC_ACQUIRE);
+        uint32_t head, tail;
+        if (ring == NULL)
+        {
+            continue;
+        }
+        head = ring->head;
+        tail = __atomic_load_n (&(ring->tail), __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            callback (&(ring->events [head & ring->mask]), ring->name, custom);
+            head++;
+            nbEvents++;
+        }
+        __atomic_store_n (&(ring->head), head, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n (&g_isDraining, 0, __ATOMIC_RELEASE);
+    return nbEvents;
+}
+
+int ARSTREAM_Trace_DrainToArray (ARSTREAM_Trace_Event_t *events, int maxEvents)
+{
+    int notDraining = 0;
+    int nbEvents = 0;
+    uint32_t nbRings, i;
+
+    if ((events == NULL) ||
+        (maxEvents <= 0))
+    {
+        return 0;
+    }
+    if (!__atomic_compare_exchange_n (&g_isDraining, &notDraining, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return -1;
+    }
+
+    nbRings = __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE);
+    for (i = 0; (i < nbRings) && (i < ARSTREAM_TRACE_MAX_THREADS) && (nbEvents < maxEvents); i++)
+    {
+        ARSTREAM_Trace_Ring_t *ring = __atomic_load_n (&(g_rings [i]), __ATOMIC_ACQUIRE);
+        uint32_t head, tail;
+        if (ring == NULL)
+        {
+            continue;
+        }
+        head = ring->head;
+        tail = __atomic_load_n (&(ring->tail), __ATOMIC_ACQUIRE);
+        while ((head != tail) &&
+               (nbEvents < maxEvents))
+        {
+            events [nbEvents] = ring->events [head & ring->mask];
+            head++;
+            nbEvents++;
+        }
+        __atomic_store_n (&(ring->head), head, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n (&g_isDraining, 0, __ATOMIC_RELEASE);
+    return nbEvents;
+}
+
+const char* ARSTREAM_Trace_GetThreadName (uint8_t threadIndex)
+{
+    ARSTREAM_Trace_Ring_t *ring = NULL;
+    if ((threadIndex < ARSTREAM_TRACE_MAX_THREADS) &&
+        (threadIndex < __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE)))
+    {
+        ring = __atomic_load_n (&(g_rings [threadIndex]), __ATOMIC_ACQUIRE);
+    }
+    return (ring != NULL) ? ring->name : NULL;
+}
+
+eARSTREAM_ERROR ARSTREAM_Trace_WriteChromeJson (FILE *file)
+{
+    ARSTREAM_Trace_JsonWriter_t writer;
+    uint32_t nbRings, i;
+
+    if (file == NULL)
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    writer.file = file;
+    writer.isFirst = 1;
+
+    fputs ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+    /* Thread names */
+    nbRings = __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE);
+    for (i = 0; (i < nbRings) && (i < ARSTREAM_TRACE_MAX_THREADS); i++)
+    {
+        ARSTREAM_Trace_Ring_t *ring = __atomic_load_n (&(g_rings [i]), __ATOMIC_ACQUIRE);
+        if (ring != NULL)
+        {
+            ARSTREAM_Trace_BeginJsonEvent (&writer);
+            fprintf (file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", i + 1);
+            ARSTREAM_Trace_WriteJsonString (file, ring->name);
+            fputs ("}}", file);
+        }
+    }
+
+    if (ARSTREAM_Trace_Drain (ARSTREAM_Trace_WriteJsonEvent, &writer) < 0)
+    {
+        fputs ("\n]}\n", file);
+        return ARSTREAM_ERROR_BUSY;
+    }
+
+    fputs ("\n]}\n", file);
+    return ARSTREAM_OK;
+}
+
+uint64_t ARSTREAM_Trace_GetNbDroppedEvents (void)
+{
+    uint64_t nbDropped = __atomic_load_n (&g_nbDroppedWithoutRing, __ATOMIC_RELAXED);
+    uint32_t nbRings = __atomic_load_n (&g_nbRings, __ATOMIC_ACQUIRE);
+    uint32_t i;
+    for (i = 0; (i < nbRings) && (i < ARSTREAM_TRACE_MAX_THREADS); i++)
+    {
+        ARSTREAM_Trace_Ring_t *ring = __atomic_load_n (&(g_rings [i]), __ATOMIC_ACQUIRE);
+        if (ring != NULL)
+        {
+            nbDropped += __atomic_load_n (&(ring->nbDropped), __ATOMIC_RELAXED);
+        }
+    }
+    return nbDropped;
+}
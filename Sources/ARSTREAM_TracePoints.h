@@ -0,0 +1,107 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TracePoints.h
+ * @brief Tracepoints of the stream sender and reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_TRACEPOINTS_PRIVATE_H_
+#define _ARSTREAM_TRACEPOINTS_PRIVATE_H_
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Trace.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * Build with ARSTREAM_TRACE=0 to compile the tracepoints out
+ */
+#ifndef ARSTREAM_TRACE
+#define ARSTREAM_TRACE (1)
+#endif
+
+#if ARSTREAM_TRACE
+
+/**
+ * @brief Runtime switch of the tracepoints, set by ARSTREAM_Trace_Enable()
+ */
+extern int ARSTREAM_Trace_IsEnabled;
+
+/**
+ * @brief Records an event in the ring of the calling thread
+ * @note Use ARSTREAM_TRACE_POINT() instead
+ */
+void ARSTREAM_Trace_Record (eARSTREAM_TRACE_EVENT event, uint16_t frameNumber, uint32_t arg);
+
+/**
+ * Records an event if tracing is enabled. FRAME and ARG are only evaluated if it is.
+ */
+#define ARSTREAM_TRACE_POINT(EVENT,FRAME,ARG)                           \
+    do                                                                  \
+    {                                                                   \
+        if (__builtin_expect (ARSTREAM_Trace_IsEnabled != 0, 0))        \
+        {                                                               \
+            ARSTREAM_Trace_Record ((EVENT), (uint16_t)(FRAME), (uint32_t)(ARG)); \
+        }                                                               \
+    } while (0)
+
+/**
+ * Records an event if tracing is enabled and COND is true. COND is only evaluated if tracing is enabled.
+ */
+#define ARSTREAM_TRACE_POINT_IF(COND,EVENT,FRAME,ARG)                   \
+    do                                                                  \
+    {                                                                   \
+        if (__builtin_expect (ARSTREAM_Trace_IsEnabled != 0, 0) &&      \
+            (COND))                                                     \
+        {                                                               \
+            ARSTREAM_Trace_Record ((EVENT), (uint16_t)(FRAME), (uint32_t)(ARG)); \
+        }                                                               \
+    } while (0)
+
+#define ARSTREAM_TRACE_THREAD_BEGIN(NAME) ARSTREAM_Trace_SetThreadName ((NAME))
+#define ARSTREAM_TRACE_THREAD_END() ARSTREAM_Trace_ReleaseThread ()
+
+#else /* ARSTREAM_TRACE */
+
+#define ARSTREAM_TRACE_POINT(EVENT,FRAME,ARG) do { } while (0)
+#define ARSTREAM_TRACE_POINT_IF(COND,EVENT,FRAME,ARG) do { (void)sizeof ((COND)); } while (0)
+#define ARSTREAM_TRACE_THREAD_BEGIN(NAME) do { } while (0)
+#define ARSTREAM_TRACE_THREAD_END() do { } while (0)
+
+#endif /* ARSTREAM_TRACE */
+
+#endif /* _ARSTREAM_TRACEPOINTS_PRIVATE_H_ */
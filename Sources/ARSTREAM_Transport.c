@@ -0,0 +1,239 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Transport.c
+ * @brief Transport interface used by the stream sender and reader, ARNETWORK_Manager_t backend
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_Transport.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRANSPORT_TAG "ARSTREAM_Transport"
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    ARNETWORK_Manager_t *manager;
+    int sendBufferID;
+    int readBufferID;
+} ARSTREAM_TransportNetwork_Context_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief ARNETWORK_Manager_Callback_t for ARNETWORK_Manager_SendData calls
+ * Forwards the SENT and CANCEL status to the ARSTREAM_Transport_SendParam_t given as customData
+ */
+static eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_TransportNetwork_Callback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status);
+
+static int ARSTREAM_TransportNetwork_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+static void ARSTREAM_TransportNetwork_Flush (void *context);
+static void ARSTREAM_TransportNetwork_Cancel (void *context);
+static int ARSTREAM_TransportNetwork_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+static int ARSTREAM_TransportNetwork_GetEstimatedLatency (void *context);
+static void ARSTREAM_TransportNetwork_Destroy (void *context);
+
+/*
+ * Internal variables
+ */
+
+static const ARSTREAM_Transport_Ops_t ARSTREAM_TransportNetwork_Ops = {
+    .send = ARSTREAM_TransportNetwork_Send,
+    .flush = ARSTREAM_TransportNetwork_Flush,
+    .cancel = ARSTREAM_TransportNetwork_Cancel,
+    .read = ARSTREAM_TransportNetwork_Read,
+    .getEstimatedLatency = ARSTREAM_TransportNetwork_GetEstimatedLatency,
+    .destroy = ARSTREAM_TransportNetwork_Destroy,
+};
+
+/*
+ * Internal functions implementation
+ */
+
+static eARNETWORK_MANAGER_CALLBACK_RETURN ARSTREAM_TransportNetwork_Callback (int IoBufferId, uint8_t *dataPtr, void *customData, eARNETWORK_MANAGER_CALLBACK_STATUS status)
+{
+    ARSTREAM_Transport_SendParam_t *param = (ARSTREAM_Transport_SendParam_t *)customData;
+
+    /* Remove "unused parameter" warnings */
+    (void)IoBufferId;
+    (void)dataPtr;
+
+    if (param != NULL)
+    {
+        switch (status)
+        {
+        case ARNETWORK_MANAGER_CALLBACK_STATUS_SENT:
+            param->callback (param, ARSTREAM_TRANSPORT_SEND_STATUS_SENT);
+            break;
+        case ARNETWORK_MANAGER_CALLBACK_STATUS_CANCEL:
+            param->callback (param, ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL);
+            break;
+        default:
+            break;
+        }
+    }
+    return ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT;
+}
+
+static int ARSTREAM_TransportNetwork_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param)
+{
+    ARSTREAM_TransportNetwork_Context_t *network = (ARSTREAM_TransportNetwork_Context_t *)context;
+    eARNETWORK_ERROR err = ARNETWORK_Manager_SendData (network->manager, network->sendBufferID, data, size, (void *)param, ARSTREAM_TransportNetwork_Callback, 1);
+    if (err != ARNETWORK_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_TAG, "Error occurred during sending of the data ; error: %d : %s", err, ARNETWORK_Error_ToString (err));
+        return -1;
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportNetwork_Flush (void *context)
+{
+    // ARNETWORK_Manager_t threads send the data as soon as possible
+    (void)context;
+}
+
+static void ARSTREAM_TransportNetwork_Cancel (void *context)
+{
+    ARSTREAM_TransportNetwork_Context_t *network = (ARSTREAM_TransportNetwork_Context_t *)context;
+    ARNETWORK_Manager_FlushInputBuffer (network->manager, network->sendBufferID);
+}
+
+static int ARSTREAM_TransportNetwork_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs)
+{
+    ARSTREAM_TransportNetwork_Context_t *network = (ARSTREAM_TransportNetwork_Context_t *)context;
+    int recvSize = 0;
+    eARNETWORK_ERROR err = ARNETWORK_Manager_ReadDataWithTimeout (network->manager, network->readBufferID, data, capacity, &recvSize, timeoutMs);
+    if (err != ARNETWORK_OK)
+    {
+        if (err != ARNETWORK_ERROR_BUFFER_EMPTY)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_TAG, "Error while reading data: %s", ARNETWORK_Error_ToString (err));
+        }
+        return -1;
+    }
+    return recvSize;
+}
+
+static int ARSTREAM_TransportNetwork_GetEstimatedLatency (void *context)
+{
+    ARSTREAM_TransportNetwork_Context_t *network = (ARSTREAM_TransportNetwork_Context_t *)context;
+    return ARNETWORK_Manager_GetEstimatedLatency (network->manager);
+}
+
+static void ARSTREAM_TransportNetwork_Destroy (void *context)
+{
+    free (context);
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewNetwork (ARNETWORK_Manager_t *manager, int sendBufferID, int readBufferID, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Transport_t *retTransport = NULL;
+    ARSTREAM_TransportNetwork_Context_t *network = NULL;
+    if (manager == NULL)
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retTransport;
+    }
+
+    retTransport = malloc (sizeof (ARSTREAM_Transport_t));
+    network = malloc (sizeof (ARSTREAM_TransportNetwork_Context_t));
+    if ((retTransport == NULL) ||
+        (network == NULL))
+    {
+        free (retTransport);
+        free (network);
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_ALLOC);
+        return NULL;
+    }
+
+    network->manager = manager;
+    network->sendBufferID = sendBufferID;
+    network->readBufferID = readBufferID;
+    retTransport->ops = &ARSTREAM_TransportNetwork_Ops;
+    retTransport->context = network;
+    SET_WITH_CHECK (error, ARSTREAM_OK);
+    return retTransport;
+}
+
+void ARSTREAM_Transport_Delete (ARSTREAM_Transport_t **transport)
+{
+    if ((transport != NULL) &&
+        (*transport != NULL))
+    {
+        (*transport)->ops->destroy ((*transport)->context);
+        free (*transport);
+        *transport = NULL;
+    }
+}
@@ -0,0 +1,250 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Transport.h
+ * @brief Transport interface used by the stream sender and reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_TRANSPORT_PRIVATE_H_
+#define _ARSTREAM_TRANSPORT_PRIVATE_H_
+
+/*
+ * System Headers
+ */
+#include <inttypes.h>
+
+/*
+ * Private Headers
+ */
+
+/*
+ * ARSDK Headers
+ */
+#include <libARStream/ARSTREAM_Error.h>
+#include <libARStream/ARSTREAM_Capture.h>
+#include <libARStream/ARSTREAM_Impairment.h>
+#include <libARStream/ARSTREAM_Loopback.h>
+#include <libARNetwork/ARNETWORK_Manager.h>
+
+/*
+ * Macros
+ */
+
+/**
+ * Size of the send/receive batches of the UDP transport
+ */
+#define ARSTREAM_TRANSPORT_UDP_BATCH_SIZE (32)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Status given to the send callbacks
+ */
+typedef enum {
+    ARSTREAM_TRANSPORT_SEND_STATUS_SENT = 0, /**< The packet was given to the network */
+    ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL, /**< The packet was dropped before being sent */
+} eARSTREAM_TRANSPORT_SEND_STATUS;
+
+typedef struct ARSTREAM_Transport_SendParam_t ARSTREAM_Transport_SendParam_t;
+
+/**
+ * @brief Callback called when a packet was sent or cancelled
+ * @param param The param given to ARSTREAM_Transport_Send
+ * @param status What happened to the packet
+ */
+typedef void (*ARSTREAM_Transport_SendCallback_t) (ARSTREAM_Transport_SendParam_t *param, eARSTREAM_TRANSPORT_SEND_STATUS status);
+
+/**
+ * @brief Send callback infos
+ * This struct should be the first member of a bigger struct holding the caller infos,
+ * so the callback can get them back without any extra allocation.
+ */
+struct ARSTREAM_Transport_SendParam_t {
+    ARSTREAM_Transport_SendCallback_t callback;
+};
+
+/**
+ * @brief Operations of a transport backend
+ * All operations take the context of the transport as first parameter
+ */
+typedef struct {
+    /**
+     * @brief Sends (or queues) a packet. The data is copied.
+     * @return 0 on success, -1 on error
+     */
+    int (*send) (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+    /**
+     * @brief Sends all the queued packets
+     */
+    void (*flush) (void *context);
+    /**
+     * @brief Drops all the packets which were not sent yet
+     */
+    void (*cancel) (void *context);
+    /**
+     * @brief Reads a packet
+     * @return The size of the packet, or -1 if no packet was received before the timeout
+     */
+    int (*read) (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+    /**
+     * @brief Gets the estimated network latency
+     * @return The latency in ms, or -1 if unknown
+     */
+    int (*getEstimatedLatency) (void *context);
+    /**
+     * @brief Frees the context
+     */
+    void (*destroy) (void *context);
+} ARSTREAM_Transport_Ops_t;
+
+/**
+ * @brief A transport : a backend and its context
+ */
+typedef struct {
+    const ARSTREAM_Transport_Ops_t *ops;
+    void *context;
+} ARSTREAM_Transport_t;
+
+/*
+ * Functions declarations
+ */
+
+/**
+ * @brief Creates a transport over two ARNETWORK_Manager_t IOBuffers
+ * @param manager The ARNETWORK_Manager_t
+ * @param sendBufferID Buffer on which the packets are sent
+ * @param readBufferID Buffer on which the packets are read
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return The new transport, or NULL on error
+ */
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewNetwork (ARNETWORK_Manager_t *manager, int sendBufferID, int readBufferID, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Creates a transport which owns a nonblocking UDP socket
+ * On Linux, packets are sent and received by batches (sendmmsg/recvmmsg).
+ * @param remoteAddr IP address (dotted notation) of the peer, or NULL to answer to the source of the last packet received
+ * @param remotePort UDP port of the peer (unused if remoteAddr is NULL)
+ * @param localAddr IP address (dotted notation) of the local interface, or NULL for any interface
+ * @param localPort Local UDP port, or 0 for any port
+ * @param maxPacketSize Maximum size of a packet
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return The new transport, or NULL on error
+ */
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewUDP (const char *remoteAddr, int remotePort, const char *localAddr, int localPort, uint32_t maxPacketSize, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Side of an ARSTREAM_Loopback_t used by a transport
+ */
+typedef enum {
+    ARSTREAM_TRANSPORT_LOOPBACK_SIDE_SENDER = 0, /**< Sends on the data ring, reads the ack ring */
+    ARSTREAM_TRANSPORT_LOOPBACK_SIDE_READER, /**< Sends on the ack ring, reads the data ring */
+} eARSTREAM_TRANSPORT_LOOPBACK_SIDE;
+
+/**
+ * @brief Creates a transport over one side of an ARSTREAM_Loopback_t
+ * Packets are given to the peer during send (the send callback is called immediately).
+ * @param loopback The loopback (must outlive the transport)
+ * @param side Which side of the loopback to use. Only one transport per side can exist.
+ * @param maxPacketSize Maximum size of a packet
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information (ARSTREAM_ERROR_BUSY if the side is already used)
+ * @return The new transport, or NULL on error
+ */
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewLoopback (ARSTREAM_Loopback_t *loopback, eARSTREAM_TRANSPORT_LOOPBACK_SIDE side, uint32_t maxPacketSize, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Creates a transport which impairs the packets sent on another transport
+ * Sent packets are copied into a time-ordered queue, and given to the underlying transport by an internal
+ * thread when their delivery time is reached. The send callback is called immediately, as the packet is
+ * then "on the network". Reads are forwarded to the underlying transport.
+ * @param inner The transport to impair. It is owned (and deleted) by the new transport on success.
+ * @param config The impairments to apply (copied)
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return The new transport, or NULL on error (inner is then left untouched)
+ */
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewImpairment (ARSTREAM_Transport_t *inner, const ARSTREAM_Impairment_Config_t *config, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Replaces the impairments of an impairment transport
+ * The PRNG is seeded again from the new config. Packets already queued keep their delivery time, and the statistics are kept.
+ * @param transport The transport
+ * @param config The new impairments (copied)
+ * @return ARSTREAM_OK on success, ARSTREAM_ERROR_BAD_PARAMETERS if the transport was not created by ARSTREAM_Transport_NewImpairment()
+ * @warning Must not be called while packets are being sent
+ */
+eARSTREAM_ERROR ARSTREAM_Transport_SetImpairmentConfig (ARSTREAM_Transport_t *transport, const ARSTREAM_Impairment_Config_t *config);
+
+/**
+ * @brief Gets the statistics of an impairment transport
+ * @param transport The transport
+ * @param stats Pointer to the structure to fill
+ * @return ARSTREAM_OK on success, ARSTREAM_ERROR_BAD_PARAMETERS if the transport was not created by ARSTREAM_Transport_NewImpairment()
+ */
+eARSTREAM_ERROR ARSTREAM_Transport_GetImpairmentStats (ARSTREAM_Transport_t *transport, ARSTREAM_Impairment_Stats_t *stats);
+
+/**
+ * @brief Creates a read-only transport which gives the packets of a capture file
+ * The file is mapped in memory. Sent packets are dropped. Once the whole file was read, reads time out.
+ * @param path Path of the capture file (see ARSTREAM_Capture.h)
+ * @param mode Timing of the replay
+ * @param maxPacketSize Maximum size of a packet (larger captured packets are dropped)
+ * @param error Optionnal pointer to an eARSTREAM_ERROR to hold any error information
+ * @return The new transport, or NULL on error
+ */
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewReplay (const char *path, eARSTREAM_CAPTURE_REPLAY_MODE mode, uint32_t maxPacketSize, eARSTREAM_ERROR *error);
+
+/**
+ * @brief Gets the statistics of a replay transport
+ * @param transport The transport
+ * @param stats Pointer to the structure to fill
+ * @return ARSTREAM_OK on success, ARSTREAM_ERROR_BAD_PARAMETERS if the transport was not created by ARSTREAM_Transport_NewReplay()
+ */
+eARSTREAM_ERROR ARSTREAM_Transport_GetReplayStats (ARSTREAM_Transport_t *transport, ARSTREAM_Capture_Stats_t *stats);
+
+/**
+ * @brief Deletes a transport
+ * @param transport Pointer to the transport to delete, set to NULL after deletion
+ */
+void ARSTREAM_Transport_Delete (ARSTREAM_Transport_t **transport);
+
+/**
+ * @brief Helpers to call the operations of a transport
+ */
+#define ARSTREAM_Transport_Send(TRANSPORT,DATA,SIZE,PARAM) ((TRANSPORT)->ops->send ((TRANSPORT)->context, (DATA), (SIZE), (PARAM)))
+#define ARSTREAM_Transport_Flush(TRANSPORT) ((TRANSPORT)->ops->flush ((TRANSPORT)->context))
+#define ARSTREAM_Transport_Cancel(TRANSPORT) ((TRANSPORT)->ops->cancel ((TRANSPORT)->context))
+#define ARSTREAM_Transport_Read(TRANSPORT,DATA,CAPACITY,TIMEOUT) ((TRANSPORT)->ops->read ((TRANSPORT)->context, (DATA), (CAPACITY), (TIMEOUT)))
+#define ARSTREAM_Transport_GetEstimatedLatency(TRANSPORT) ((TRANSPORT)->ops->getEstimatedLatency ((TRANSPORT)->context))
+
+#endif /* _ARSTREAM_TRANSPORT_PRIVATE_H_ */
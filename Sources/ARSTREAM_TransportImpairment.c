@@ -0,0 +1,711 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportImpairment.c
+ * @brief Transport interface used by the stream sender and reader, network impairment decorator
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_Transport.h"
+#include "ARSTREAM_Clock.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRANSPORT_IMPAIRMENT_TAG "ARSTREAM_TransportImpairment"
+
+/**
+ * Wait time of the delivery thread when no packets are queued
+ */
+#define ARSTREAM_TRANSPORT_IMPAIRMENT_IDLE_WAIT_MS (100)
+
+/**
+ * Below this wait time (in microseconds), the delivery thread sleeps instead of waiting on the cond,
+ * as ARSAL_Cond_Timedwait only has a millisecond resolution
+ */
+#define ARSTREAM_TRANSPORT_IMPAIRMENT_SLEEP_THRESHOLD_US (2000)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief A packet waiting for its delivery time
+ */
+typedef struct {
+    uint64_t deliveryTimeUs;
+    uint64_t sendTimeUs;
+    uint64_t seqNum; /**< Keeps the send order between packets with the same delivery time */
+    uint32_t size;
+    uint8_t data [];
+} ARSTREAM_TransportImpairment_Packet_t;
+
+typedef struct {
+    ARSTREAM_Transport_t *inner;
+    ARSTREAM_Impairment_Config_t config;
+
+    /* Random decisions, only used by the sending thread */
+    uint64_t prngState;
+    int isInBadState;
+    uint64_t lastInOrderDeliveryUs;
+    uint64_t linkFreeTimeUs;
+    uint64_t nextSeqNum;
+
+    /* Min-heap of the queued packets, ordered by delivery time */
+    ARSAL_Mutex_t mutex;
+    ARSAL_Cond_t cond;
+    ARSTREAM_TransportImpairment_Packet_t **heap;
+    uint32_t heapSize;
+    ARSTREAM_Impairment_Stats_t stats;
+    uint64_t totalDelayUs;
+
+    ARSAL_Thread_t deliveryThread;
+    int threadShouldStop;
+} ARSTREAM_TransportImpairment_Context_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Gets the current time in microseconds
+ */
+static uint64_t ARSTREAM_TransportImpairment_GetTimeUs (void);
+
+/**
+ * @brief Gets the next value of the PRNG (xorshift64*)
+ * @param impair The impairment context
+ * @return A pseudo-random 64 bits value
+ */
+static uint64_t ARSTREAM_TransportImpairment_Random (ARSTREAM_TransportImpairment_Context_t *impair);
+
+/**
+ * @brief Draws a random event
+ * @param impair The impairment context
+ * @param percent Probability of the event (0 to 100)
+ * @return 1 if the event happens, 0 otherwise
+ */
+static int ARSTREAM_TransportImpairment_Draw (ARSTREAM_TransportImpairment_Context_t *impair, float percent);
+
+/**
+ * @brief Sets the impairments to apply, and seeds the PRNG
+ * @param impair The impairment context
+ * @param config The new impairments (copied)
+ */
+static void ARSTREAM_TransportImpairment_ApplyConfig (ARSTREAM_TransportImpairment_Context_t *impair, const ARSTREAM_Impairment_Config_t *config);
+
+/**
+ * @brief Computes the delivery time of a packet and queues a copy of it
+ * @param impair The impairment context
+ * @param data The packet
+ * @param size The packet size
+ * @param nowUs The send time
+ * @warning Called with the mutex locked
+ */
+static void ARSTREAM_TransportImpairment_Enqueue (ARSTREAM_TransportImpairment_Context_t *impair, uint8_t *data, uint32_t size, uint64_t nowUs);
+
+/**
+ * @brief Compares two packets of the heap
+ * @return 1 if a must be delivered before b, 0 otherwise
+ */
+static int ARSTREAM_TransportImpairment_IsBefore (ARSTREAM_TransportImpairment_Packet_t *a, ARSTREAM_TransportImpairment_Packet_t *b);
+
+/**
+ * @brief Removes the first packet of the heap
+ * @param impair The impairment context
+ * @return The packet (to be freed by the caller)
+ * @warning Called with the mutex locked, on a non-empty heap
+ */
+static ARSTREAM_TransportImpairment_Packet_t* ARSTREAM_TransportImpairment_HeapPop (ARSTREAM_TransportImpairment_Context_t *impair);
+
+/**
+ * @brief Gives the packets to the underlying transport when their delivery time is reached
+ * @param param The impairment context
+ */
+static void* ARSTREAM_TransportImpairment_DeliveryThread (void *param);
+
+static int ARSTREAM_TransportImpairment_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+static void ARSTREAM_TransportImpairment_Flush (void *context);
+static void ARSTREAM_TransportImpairment_Cancel (void *context);
+static int ARSTREAM_TransportImpairment_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+static int ARSTREAM_TransportImpairment_GetEstimatedLatency (void *context);
+static void ARSTREAM_TransportImpairment_Destroy (void *context);
+
+/*
+ * Internal variables
+ */
+
+static const ARSTREAM_Transport_Ops_t ARSTREAM_TransportImpairment_Ops = {
+    .send = ARSTREAM_TransportImpairment_Send,
+    .flush = ARSTREAM_TransportImpairment_Flush,
+    .cancel = ARSTREAM_TransportImpairment_Cancel,
+    .read = ARSTREAM_TransportImpairment_Read,
+    .getEstimatedLatency = ARSTREAM_TransportImpairment_GetEstimatedLatency,
+    .destroy = ARSTREAM_TransportImpairment_Destroy,
+};
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_TransportImpairment_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static uint64_t ARSTREAM_TransportImpairment_Random (ARSTREAM_TransportImpairment_Context_t *impair)
+{
+    uint64_t x = impair->prngState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    impair->prngState = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int ARSTREAM_TransportImpairment_Draw (ARSTREAM_TransportImpairment_Context_t *impair, float percent)
+{
+    double value;
+    if (percent <= 0.f)
+    {
+        return 0;
+    }
+    // 53 bits uniform value in [0, 100)
+    value = (double)(ARSTREAM_TransportImpairment_Random (impair) >> 11) * (100.0 / 9007199254740992.0);
+    return (value < percent) ? 1 : 0;
+}
+
+static void ARSTREAM_TransportImpairment_ApplyConfig (ARSTREAM_TransportImpairment_Context_t *impair, const ARSTREAM_Impairment_Config_t *config)
+{
+    uint64_t seed;
+
+    impair->config = *config;
+    impair->isInBadState = 0;
+
+    /* Spread the seed bits (splitmix64), the xorshift state must not be 0 */
+    seed = (uint64_t)((config->seed != 0) ? config->seed : 1) + 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+    impair->prngState = (seed != 0) ? seed : 1;
+}
+
+static int ARSTREAM_TransportImpairment_IsBefore (ARSTREAM_TransportImpairment_Packet_t *a, ARSTREAM_TransportImpairment_Packet_t *b)
+{
+    if (a->deliveryTimeUs != b->deliveryTimeUs)
+    {
+        return (a->deliveryTimeUs < b->deliveryTimeUs) ? 1 : 0;
+    }
+    return (a->seqNum < b->seqNum) ? 1 : 0;
+}
+
+static void ARSTREAM_TransportImpairment_Enqueue (ARSTREAM_TransportImpairment_Context_t *impair, uint8_t *data, uint32_t size, uint64_t nowUs)
+{
+    ARSTREAM_Impairment_Config_t *config = &(impair->config);
+    ARSTREAM_TransportImpairment_Packet_t *packet;
+    uint64_t departureUs = nowUs;
+    uint64_t deliveryUs;
+    uint32_t index;
+
+    /* Serialization on the bandwidth limited link */
+    if (config->bandwidthKbps > 0)
+    {
+        if (impair->linkFreeTimeUs > nowUs)
+        {
+            departureUs = impair->linkFreeTimeUs;
+        }
+        if (config->queueLimitBytes > 0)
+        {
+            uint64_t backlogBytes = (departureUs - nowUs) * config->bandwidthKbps / 8000;
+            if (backlogBytes + size > config->queueLimitBytes)
+            {
+                impair->stats.nbLostQueue++;
+                return;
+            }
+        }
+        departureUs += ((uint64_t)size * 8000) / config->bandwidthKbps;
+        impair->linkFreeTimeUs = departureUs;
+    }
+
+    /* Propagation delay */
+    deliveryUs = departureUs + (uint64_t)config->delayMs * 1000;
+    if (config->jitterMs > 0)
+    {
+        deliveryUs += ARSTREAM_TransportImpairment_Random (impair) % ((uint64_t)config->jitterMs * 1000 + 1);
+    }
+    if (ARSTREAM_TransportImpairment_Draw (impair, config->reorderPercent) != 0)
+    {
+        deliveryUs += (uint64_t)config->reorderDelayMs * 1000;
+        impair->stats.nbReordered++;
+    }
+    else
+    {
+        if (deliveryUs < impair->lastInOrderDeliveryUs)
+        {
+            deliveryUs = impair->lastInOrderDeliveryUs;
+        }
+        impair->lastInOrderDeliveryUs = deliveryUs;
+    }
+
+    if (impair->heapSize >= ARSTREAM_IMPAIRMENT_MAX_PACKETS)
+    {
+        impair->stats.nbLostQueue++;
+        return;
+    }
+    packet = malloc (sizeof (ARSTREAM_TransportImpairment_Packet_t) + size);
+    if (packet == NULL)
+    {
+        impair->stats.nbLostQueue++;
+        return;
+    }
+    packet->deliveryTimeUs = deliveryUs;
+    packet->sendTimeUs = nowUs;
+    packet->seqNum = impair->nextSeqNum++;
+    packet->size = size;
+    memcpy (packet->data, data, size);
+
+    /* Sift up */
+    index = impair->heapSize++;
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+        if (ARSTREAM_TransportImpairment_IsBefore (packet, impair->heap [parent]) == 0)
+        {
+            break;
+        }
+        impair->heap [index] = impair->heap [parent];
+        index = parent;
+    }
+    impair->heap [index] = packet;
+}
+
+static ARSTREAM_TransportImpairment_Packet_t* ARSTREAM_TransportImpairment_HeapPop (ARSTREAM_TransportImpairment_Context_t *impair)
+{
+    ARSTREAM_TransportImpairment_Packet_t *first = impair->heap [0];
+    ARSTREAM_TransportImpairment_Packet_t *last = impair->heap [--impair->heapSize];
+    uint32_t index = 0;
+
+    /* Sift down the last packet from the root */
+    while (1)
+    {
+        uint32_t child = 2 * index + 1;
+        if (child >= impair->heapSize)
+        {
+            break;
+        }
+        if ((child + 1 < impair->heapSize) &&
+            (ARSTREAM_TransportImpairment_IsBefore (impair->heap [child + 1], impair->heap [child]) != 0))
+        {
+            child++;
+        }
+        if (ARSTREAM_TransportImpairment_IsBefore (impair->heap [child], last) == 0)
+        {
+            break;
+        }
+        impair->heap [index] = impair->heap [child];
+        index = child;
+    }
+    if (impair->heapSize > 0)
+    {
+        impair->heap [index] = last;
+    }
+    return first;
+}
+
+static void* ARSTREAM_TransportImpairment_DeliveryThread (void *param)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair = (ARSTREAM_TransportImpairment_Context_t *)param;
+    int needFlush = 0;
+
+    ARSAL_Mutex_Lock (&(impair->mutex));
+    while (impair->threadShouldStop == 0)
+    {
+        uint64_t nowUs = ARSTREAM_TransportImpairment_GetTimeUs ();
+        uint64_t waitUs;
+
+        if ((impair->heapSize > 0) &&
+            (impair->heap [0]->deliveryTimeUs <= nowUs))
+        {
+            ARSTREAM_TransportImpairment_Packet_t *packet = ARSTREAM_TransportImpairment_HeapPop (impair);
+            uint64_t delayUs = nowUs - packet->sendTimeUs;
+            impair->stats.nbDelivered++;
+            impair->totalDelayUs += delayUs;
+            if (delayUs > impair->stats.maxDelayUs)
+            {
+                impair->stats.maxDelayUs = (uint32_t)delayUs;
+            }
+            ARSAL_Mutex_Unlock (&(impair->mutex));
+
+            ARSTREAM_Transport_Send (impair->inner, packet->data, packet->size, NULL);
+            free (packet);
+            needFlush = 1;
+
+            ARSAL_Mutex_Lock (&(impair->mutex));
+            continue;
+        }
+
+        /* Nothing to deliver now : flush what was given to the underlying transport, then wait */
+        if (needFlush != 0)
+        {
+            ARSAL_Mutex_Unlock (&(impair->mutex));
+            ARSTREAM_Transport_Flush (impair->inner);
+            needFlush = 0;
+            ARSAL_Mutex_Lock (&(impair->mutex));
+            continue;
+        }
+
+        if (impair->heapSize == 0)
+        {
+            ARSTREAM_Clock_CondTimedwait (&(impair->cond), &(impair->mutex), ARSTREAM_TRANSPORT_IMPAIRMENT_IDLE_WAIT_MS);
+            continue;
+        }
+
+        waitUs = impair->heap [0]->deliveryTimeUs - nowUs;
+        if (waitUs < ARSTREAM_TRANSPORT_IMPAIRMENT_SLEEP_THRESHOLD_US)
+        {
+            ARSAL_Mutex_Unlock (&(impair->mutex));
+            ARSTREAM_Clock_SleepUs (waitUs);
+            ARSAL_Mutex_Lock (&(impair->mutex));
+        }
+        else
+        {
+            // New packets may be delivered before the current first one : the send wakes us up
+            ARSTREAM_Clock_CondTimedwait (&(impair->cond), &(impair->mutex), (int)(waitUs / 1000) - 1);
+        }
+    }
+    ARSAL_Mutex_Unlock (&(impair->mutex));
+
+    if (needFlush != 0)
+    {
+        ARSTREAM_Transport_Flush (impair->inner);
+    }
+    return (void *)0;
+}
+
+static int ARSTREAM_TransportImpairment_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair = (ARSTREAM_TransportImpairment_Context_t *)context;
+    ARSTREAM_Impairment_Config_t *config = &(impair->config);
+    uint64_t nowUs = ARSTREAM_TransportImpairment_GetTimeUs ();
+    int isLost;
+
+    ARSAL_Mutex_Lock (&(impair->mutex));
+    impair->stats.nbPackets++;
+
+    /* Gilbert-Elliott state transition, then loss */
+    if (config->burstEnterPercent > 0.f)
+    {
+        if (impair->isInBadState == 0)
+        {
+            impair->isInBadState = ARSTREAM_TransportImpairment_Draw (impair, config->burstEnterPercent);
+        }
+        else if (ARSTREAM_TransportImpairment_Draw (impair, config->burstExitPercent) != 0)
+        {
+            impair->isInBadState = 0;
+        }
+    }
+    if (impair->isInBadState != 0)
+    {
+        isLost = ARSTREAM_TransportImpairment_Draw (impair, config->burstLossPercent);
+        impair->stats.nbLostBurst += isLost;
+    }
+    else
+    {
+        isLost = ARSTREAM_TransportImpairment_Draw (impair, config->lossPercent);
+        impair->stats.nbLostRandom += isLost;
+    }
+
+    if (isLost == 0)
+    {
+        ARSTREAM_TransportImpairment_Enqueue (impair, data, size, nowUs);
+        if (ARSTREAM_TransportImpairment_Draw (impair, config->duplicatePercent) != 0)
+        {
+            impair->stats.nbDuplicated++;
+            ARSTREAM_TransportImpairment_Enqueue (impair, data, size, nowUs);
+        }
+        ARSTREAM_Clock_CondSignal (&(impair->cond));
+    }
+    ARSAL_Mutex_Unlock (&(impair->mutex));
+
+    // The packet is now on the (emulated) network, even if it was lost
+    if (param != NULL)
+    {
+        param->callback (param, ARSTREAM_TRANSPORT_SEND_STATUS_SENT);
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportImpairment_Flush (void *context)
+{
+    // The delivery thread flushes the underlying transport
+    (void)context;
+}
+
+static void ARSTREAM_TransportImpairment_Cancel (void *context)
+{
+    // Queued packets are already on the network and can not be recalled. The underlying transport is not
+    // cancelled either : only the delivery thread may call it, and it sends without callbacks to cancel
+    (void)context;
+}
+
+static int ARSTREAM_TransportImpairment_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair = (ARSTREAM_TransportImpairment_Context_t *)context;
+    return ARSTREAM_Transport_Read (impair->inner, data, capacity, timeoutMs);
+}
+
+static int ARSTREAM_TransportImpairment_GetEstimatedLatency (void *context)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair = (ARSTREAM_TransportImpairment_Context_t *)context;
+    int latency = ARSTREAM_Transport_GetEstimatedLatency (impair->inner);
+    if (latency >= 0)
+    {
+        // A latency probe would also wait for the serialization backlog
+        uint64_t nowUs = ARSTREAM_TransportImpairment_GetTimeUs ();
+        uint64_t linkFreeTimeUs;
+        ARSAL_Mutex_Lock (&(impair->mutex));
+        linkFreeTimeUs = impair->linkFreeTimeUs;
+        ARSAL_Mutex_Unlock (&(impair->mutex));
+        latency += (int)(impair->config.delayMs + impair->config.jitterMs / 2);
+        if (linkFreeTimeUs > nowUs)
+        {
+            latency += (int)((linkFreeTimeUs - nowUs) / 1000);
+        }
+    }
+    return latency;
+}
+
+static void ARSTREAM_TransportImpairment_Destroy (void *context)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair = (ARSTREAM_TransportImpairment_Context_t *)context;
+
+    ARSAL_Mutex_Lock (&(impair->mutex));
+    impair->threadShouldStop = 1;
+    ARSTREAM_Clock_CondSignal (&(impair->cond));
+    ARSAL_Mutex_Unlock (&(impair->mutex));
+    ARSTREAM_Clock_ThreadJoin (impair->deliveryThread, NULL);
+    ARSAL_Thread_Destroy (&(impair->deliveryThread));
+
+    // Packets still in flight are lost
+    while (impair->heapSize > 0)
+    {
+        free (ARSTREAM_TransportImpairment_HeapPop (impair));
+    }
+    free (impair->heap);
+    ARSAL_Cond_Destroy (&(impair->cond));
+    ARSAL_Mutex_Destroy (&(impair->mutex));
+    ARSTREAM_Transport_Delete (&(impair->inner));
+    free (impair);
+}
+
+/*
+ * Implementation
+ */
+
+void ARSTREAM_Impairment_DefaultConfig (ARSTREAM_Impairment_Config_t *config)
+{
+    if (config != NULL)
+    {
+        memset (config, 0, sizeof (ARSTREAM_Impairment_Config_t));
+        config->seed = 1;
+    }
+}
+
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewImpairment (ARSTREAM_Transport_t *inner, const ARSTREAM_Impairment_Config_t *config, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Transport_t *retTransport = NULL;
+    ARSTREAM_TransportImpairment_Context_t *impair = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    int mutexWasInit = 0;
+    int condWasInit = 0;
+
+    /* ARGS Check */
+    if ((inner == NULL) ||
+        (config == NULL) ||
+        (inner->ops == &ARSTREAM_TransportImpairment_Ops))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retTransport;
+    }
+
+    retTransport = malloc (sizeof (ARSTREAM_Transport_t));
+    impair = calloc (1, sizeof (ARSTREAM_TransportImpairment_Context_t));
+    if ((retTransport == NULL) ||
+        (impair == NULL))
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        impair->heap = malloc (ARSTREAM_IMPAIRMENT_MAX_PACKETS * sizeof (ARSTREAM_TransportImpairment_Packet_t *));
+        if (impair->heap == NULL)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        if (ARSAL_Mutex_Init (&(impair->mutex)) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            mutexWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        if (ARSAL_Cond_Init (&(impair->cond)) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            condWasInit = 1;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        impair->inner = inner;
+        ARSTREAM_TransportImpairment_ApplyConfig (impair, config);
+
+        if (ARSTREAM_Clock_ThreadCreate (&(impair->deliveryThread), ARSTREAM_TransportImpairment_DeliveryThread, impair) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        retTransport->ops = &ARSTREAM_TransportImpairment_Ops;
+        retTransport->context = impair;
+    }
+    else
+    {
+        if (condWasInit == 1)
+        {
+            ARSAL_Cond_Destroy (&(impair->cond));
+        }
+        if (mutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(impair->mutex));
+        }
+        if (impair != NULL)
+        {
+            free (impair->heap);
+        }
+        free (impair);
+        free (retTransport);
+        retTransport = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retTransport;
+}
+
+eARSTREAM_ERROR ARSTREAM_Transport_SetImpairmentConfig (ARSTREAM_Transport_t *transport, const ARSTREAM_Impairment_Config_t *config)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair;
+
+    if ((transport == NULL) ||
+        (config == NULL) ||
+        (transport->ops != &ARSTREAM_TransportImpairment_Ops))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    impair = (ARSTREAM_TransportImpairment_Context_t *)transport->context;
+    ARSAL_Mutex_Lock (&(impair->mutex));
+    ARSTREAM_TransportImpairment_ApplyConfig (impair, config);
+    ARSAL_Mutex_Unlock (&(impair->mutex));
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Transport_GetImpairmentStats (ARSTREAM_Transport_t *transport, ARSTREAM_Impairment_Stats_t *stats)
+{
+    ARSTREAM_TransportImpairment_Context_t *impair;
+
+    if ((transport == NULL) ||
+        (stats == NULL) ||
+        (transport->ops != &ARSTREAM_TransportImpairment_Ops))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    impair = (ARSTREAM_TransportImpairment_Context_t *)transport->context;
+    ARSAL_Mutex_Lock (&(impair->mutex));
+    *stats = impair->stats;
+    stats->meanDelayUs = (impair->stats.nbDelivered > 0) ? (uint32_t)(impair->totalDelayUs / impair->stats.nbDelivered) : 0;
+    ARSAL_Mutex_Unlock (&(impair->mutex));
+    return ARSTREAM_OK;
+}
@@ -0,0 +1,649 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportLoopback.c
+ * @brief Transport interface used by the stream sender and reader, in-process loopback backend
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_NetworkHeaders.h"
+#include "ARSTREAM_Transport.h"
+#include "ARSTREAM_Clock.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRANSPORT_LOOPBACK_TAG "ARSTREAM_TransportLoopback"
+
+/**
+ * Size of a cache line, used to keep the producer and consumer indexes apart
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_CACHE_LINE_SIZE (64)
+
+/**
+ * Minimum size of a packet slot (acks and key frame requests must fit)
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_MIN_SLOT_SIZE (64)
+
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+
+/*
+ * Simulated threads never spin : an idle reader waits until the next send
+ * (or its timeout) on the virtual clock
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_SPIN_COUNT (0)
+#define ARSTREAM_TRANSPORT_LOOPBACK_YIELD_COUNT (0)
+#define ARSTREAM_TRANSPORT_LOOPBACK_SLEEP_US (UINT32_MAX)
+#define ARSTREAM_TRANSPORT_LOOPBACK_YIELD() do { } while (0)
+
+#else /* ARSTREAM_SIMULATION */
+
+/**
+ * Number of empty polls of a ring before yielding the CPU
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_SPIN_COUNT (1000)
+
+/**
+ * Number of yields before sleeping between the polls of a ring
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_YIELD_COUNT (100)
+
+/**
+ * Sleep time between two polls of an idle ring, in microseconds
+ */
+#define ARSTREAM_TRANSPORT_LOOPBACK_SLEEP_US (50)
+
+#define ARSTREAM_TRANSPORT_LOOPBACK_YIELD() sched_yield ()
+
+#endif /* ARSTREAM_SIMULATION */
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Single producer / single consumer ring of packets
+ */
+typedef struct {
+    /* Written by the consumer only */
+    uint32_t head;
+    uint8_t headPadding [ARSTREAM_TRANSPORT_LOOPBACK_CACHE_LINE_SIZE - sizeof (uint32_t)];
+
+    /* Written by the producer only */
+    uint32_t tail;
+    ARSTREAM_Loopback_Stats_t stats;
+    uint8_t tailPadding [ARSTREAM_TRANSPORT_LOOPBACK_CACHE_LINE_SIZE - sizeof (uint32_t)];
+
+    /* Constant while the threads run */
+    uint32_t mask;
+    uint32_t slotSize;
+    uint8_t *slots;
+    uint32_t *sizes;
+    uint64_t *deliveryTimesUs;
+    ARSTREAM_Loopback_PacketHook_t hook;
+    void *hookCustom;
+} ARSTREAM_TransportLoopback_Ring_t;
+
+struct ARSTREAM_Loopback_t {
+    ARSTREAM_TransportLoopback_Ring_t rings [ARSTREAM_LOOPBACK_DIRECTION_MAX];
+
+    ARSAL_Mutex_t attachMutex;
+    int senderIsAttached;
+    int readerIsAttached;
+};
+
+typedef struct {
+    ARSTREAM_Loopback_t *loopback;
+    eARSTREAM_TRANSPORT_LOOPBACK_SIDE side;
+    ARSTREAM_TransportLoopback_Ring_t *sendRing;
+    ARSTREAM_TransportLoopback_Ring_t *readRing;
+} ARSTREAM_TransportLoopback_Context_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Gets the current time in microseconds
+ */
+static uint64_t ARSTREAM_TransportLoopback_GetTimeUs (void);
+
+/**
+ * @brief Allocates the storage of a ring
+ * @param ring The ring
+ * @param nbSlots Number of packets of the ring (power of 2)
+ * @param slotSize Maximum size of a packet
+ * @return 0 on success, -1 on allocation error
+ */
+static int ARSTREAM_TransportLoopback_RingInit (ARSTREAM_TransportLoopback_Ring_t *ring, uint32_t nbSlots, uint32_t slotSize);
+
+/**
+ * @brief Frees the storage of a ring
+ * @param ring The ring
+ */
+static void ARSTREAM_TransportLoopback_RingDestroy (ARSTREAM_TransportLoopback_Ring_t *ring);
+
+static int ARSTREAM_TransportLoopback_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+static void ARSTREAM_TransportLoopback_Flush (void *context);
+static void ARSTREAM_TransportLoopback_Cancel (void *context);
+static int ARSTREAM_TransportLoopback_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+static int ARSTREAM_TransportLoopback_GetEstimatedLatency (void *context);
+static void ARSTREAM_TransportLoopback_Destroy (void *context);
+
+/*
+ * Internal variables
+ */
+
+static const ARSTREAM_Transport_Ops_t ARSTREAM_TransportLoopback_Ops = {
+    .send = ARSTREAM_TransportLoopback_Send,
+    .flush = ARSTREAM_TransportLoopback_Flush,
+    .cancel = ARSTREAM_TransportLoopback_Cancel,
+    .read = ARSTREAM_TransportLoopback_Read,
+    .getEstimatedLatency = ARSTREAM_TransportLoopback_GetEstimatedLatency,
+    .destroy = ARSTREAM_TransportLoopback_Destroy,
+};
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_TransportLoopback_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int ARSTREAM_TransportLoopback_RingInit (ARSTREAM_TransportLoopback_Ring_t *ring, uint32_t nbSlots, uint32_t slotSize)
+{
+    memset (ring, 0, sizeof (ARSTREAM_TransportLoopback_Ring_t));
+    ring->mask = nbSlots - 1;
+    ring->slotSize = slotSize;
+    ring->slots = malloc ((size_t)nbSlots * slotSize);
+    ring->sizes = malloc (nbSlots * sizeof (uint32_t));
+    ring->deliveryTimesUs = malloc (nbSlots * sizeof (uint64_t));
+    if ((ring->slots == NULL) ||
+        (ring->sizes == NULL) ||
+        (ring->deliveryTimesUs == NULL))
+    {
+        ARSTREAM_TransportLoopback_RingDestroy (ring);
+        return -1;
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportLoopback_RingDestroy (ARSTREAM_TransportLoopback_Ring_t *ring)
+{
+    free (ring->slots);
+    free (ring->sizes);
+    free (ring->deliveryTimesUs);
+    ring->slots = NULL;
+    ring->sizes = NULL;
+    ring->deliveryTimesUs = NULL;
+}
+
+static int ARSTREAM_TransportLoopback_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param)
+{
+    ARSTREAM_TransportLoopback_Context_t *loop = (ARSTREAM_TransportLoopback_Context_t *)context;
+    ARSTREAM_TransportLoopback_Ring_t *ring = loop->sendRing;
+    eARSTREAM_TRANSPORT_SEND_STATUS status = ARSTREAM_TRANSPORT_SEND_STATUS_SENT;
+    int delayUs = 0;
+    uint32_t tail, head;
+
+    if (size > ring->slotSize)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_LOOPBACK_TAG, "Packet too large (%u bytes, max %u)", size, ring->slotSize);
+        return -1;
+    }
+
+    if (ring->hook != NULL)
+    {
+        delayUs = ring->hook (data, size, ring->hookCustom);
+    }
+
+    tail = ring->tail;
+    head = __atomic_load_n (&(ring->head), __ATOMIC_ACQUIRE);
+    if (delayUs < 0)
+    {
+        // Lost on the "network" : the packet was still sent
+        __atomic_store_n (&(ring->stats.nbDroppedByHook), ring->stats.nbDroppedByHook + 1, __ATOMIC_RELAXED);
+    }
+    else if ((tail - head) > ring->mask)
+    {
+        // Reader is late, the packet never left the sender
+        __atomic_store_n (&(ring->stats.nbDroppedFull), ring->stats.nbDroppedFull + 1, __ATOMIC_RELAXED);
+        status = ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL;
+    }
+    else
+    {
+        uint32_t index = tail & ring->mask;
+        memcpy (&(ring->slots [(size_t)index * ring->slotSize]), data, size);
+        ring->sizes [index] = size;
+        ring->deliveryTimesUs [index] = (delayUs > 0) ? ARSTREAM_TransportLoopback_GetTimeUs () + delayUs : 0;
+        __atomic_store_n (&(ring->tail), tail + 1, __ATOMIC_RELEASE);
+        __atomic_store_n (&(ring->stats.nbPackets), ring->stats.nbPackets + 1, __ATOMIC_RELAXED);
+        __atomic_store_n (&(ring->stats.nbBytes), ring->stats.nbBytes + size, __ATOMIC_RELAXED);
+    }
+
+    ARSTREAM_Clock_Notify (ring);
+
+    if (param != NULL)
+    {
+        param->callback (param, status);
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportLoopback_Flush (void *context)
+{
+    // Packets are given to the peer during send
+    (void)context;
+}
+
+static void ARSTREAM_TransportLoopback_Cancel (void *context)
+{
+    // No packets are waiting on our side
+    (void)context;
+}
+
+static int ARSTREAM_TransportLoopback_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs)
+{
+    ARSTREAM_TransportLoopback_Context_t *loop = (ARSTREAM_TransportLoopback_Context_t *)context;
+    ARSTREAM_TransportLoopback_Ring_t *ring = loop->readRing;
+    uint64_t deadlineUs = 0;
+    int nbPolls = 0;
+
+    while (1)
+    {
+        uint32_t head = ring->head;
+        uint32_t tail = __atomic_load_n (&(ring->tail), __ATOMIC_ACQUIRE);
+        uint64_t nowUs = 0;
+        uint64_t wakeUpUs;
+
+        if (head != tail)
+        {
+            uint32_t index = head & ring->mask;
+            uint64_t deliveryTimeUs = ring->deliveryTimesUs [index];
+            if (deliveryTimeUs != 0)
+            {
+                nowUs = ARSTREAM_TransportLoopback_GetTimeUs ();
+            }
+            if (nowUs >= deliveryTimeUs)
+            {
+                uint32_t size = ring->sizes [index];
+                int retVal = -1;
+                if (size <= capacity)
+                {
+                    memcpy (data, &(ring->slots [(size_t)index * ring->slotSize]), size);
+                    retVal = (int)size;
+                }
+                else
+                {
+                    ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_LOOPBACK_TAG, "Dropping a too large packet (%u bytes)", size);
+                }
+                __atomic_store_n (&(ring->head), head + 1, __ATOMIC_RELEASE);
+                if (retVal >= 0)
+                {
+                    return retVal;
+                }
+                continue;
+            }
+            // Delayed packet : sleep until its delivery time
+            wakeUpUs = deliveryTimeUs;
+        }
+        else if (nbPolls < ARSTREAM_TRANSPORT_LOOPBACK_SPIN_COUNT)
+        {
+            nbPolls++;
+            continue;
+        }
+        else if (nbPolls < ARSTREAM_TRANSPORT_LOOPBACK_SPIN_COUNT + ARSTREAM_TRANSPORT_LOOPBACK_YIELD_COUNT)
+        {
+            nbPolls++;
+            ARSTREAM_TRANSPORT_LOOPBACK_YIELD ();
+            continue;
+        }
+        else
+        {
+            nowUs = ARSTREAM_TransportLoopback_GetTimeUs ();
+            wakeUpUs = nowUs + ARSTREAM_TRANSPORT_LOOPBACK_SLEEP_US;
+        }
+
+        /* Check the timeout, then sleep */
+        if (deadlineUs == 0)
+        {
+            deadlineUs = nowUs + (uint64_t)timeoutMs * 1000;
+        }
+        if (nowUs >= deadlineUs)
+        {
+            return -1;
+        }
+        if (wakeUpUs > deadlineUs)
+        {
+            wakeUpUs = deadlineUs;
+        }
+        if (wakeUpUs > nowUs)
+        {
+            ARSTREAM_Clock_WaitUs (ring, wakeUpUs - nowUs);
+        }
+    }
+}
+
+static int ARSTREAM_TransportLoopback_GetEstimatedLatency (void *context)
+{
+    (void)context;
+    return 0;
+}
+
+static void ARSTREAM_TransportLoopback_Destroy (void *context)
+{
+    ARSTREAM_TransportLoopback_Context_t *loop = (ARSTREAM_TransportLoopback_Context_t *)context;
+    ARSAL_Mutex_Lock (&(loop->loopback->attachMutex));
+    if (loop->side == ARSTREAM_TRANSPORT_LOOPBACK_SIDE_SENDER)
+    {
+        loop->loopback->senderIsAttached = 0;
+    }
+    else
+    {
+        loop->loopback->readerIsAttached = 0;
+    }
+    ARSAL_Mutex_Unlock (&(loop->loopback->attachMutex));
+    free (loop);
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewLoopback (ARSTREAM_Loopback_t *loopback, eARSTREAM_TRANSPORT_LOOPBACK_SIDE side, uint32_t maxPacketSize, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Transport_t *retTransport = NULL;
+    ARSTREAM_TransportLoopback_Context_t *loop = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    int *isAttached;
+
+    /* ARGS Check */
+    if ((loopback == NULL) ||
+        (maxPacketSize > loopback->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA].slotSize))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retTransport;
+    }
+
+    retTransport = malloc (sizeof (ARSTREAM_Transport_t));
+    loop = malloc (sizeof (ARSTREAM_TransportLoopback_Context_t));
+    if ((retTransport == NULL) ||
+        (loop == NULL))
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    /* Only one sender and one reader per loopback */
+    if (internalError == ARSTREAM_OK)
+    {
+        isAttached = (side == ARSTREAM_TRANSPORT_LOOPBACK_SIDE_SENDER) ? &(loopback->senderIsAttached) : &(loopback->readerIsAttached);
+        ARSAL_Mutex_Lock (&(loopback->attachMutex));
+        if (*isAttached != 0)
+        {
+            internalError = ARSTREAM_ERROR_BUSY;
+        }
+        else
+        {
+            *isAttached = 1;
+        }
+        ARSAL_Mutex_Unlock (&(loopback->attachMutex));
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        loop->loopback = loopback;
+        loop->side = side;
+        if (side == ARSTREAM_TRANSPORT_LOOPBACK_SIDE_SENDER)
+        {
+            loop->sendRing = &(loopback->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA]);
+            loop->readRing = &(loopback->rings [ARSTREAM_LOOPBACK_DIRECTION_ACK]);
+        }
+        else
+        {
+            loop->sendRing = &(loopback->rings [ARSTREAM_LOOPBACK_DIRECTION_ACK]);
+            loop->readRing = &(loopback->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA]);
+        }
+        retTransport->ops = &ARSTREAM_TransportLoopback_Ops;
+        retTransport->context = loop;
+    }
+    else
+    {
+        free (retTransport);
+        free (loop);
+        retTransport = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retTransport;
+}
+
+ARSTREAM_Loopback_t* ARSTREAM_Loopback_New (uint32_t nbPackets, uint32_t maxFragmentSize, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Loopback_t *retLoopback = NULL;
+    int attachMutexWasInit = 0;
+    int dataRingWasInit = 0;
+    int ackRingWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    uint32_t nbSlots = 1;
+    uint32_t slotSize = maxFragmentSize + sizeof (ARSTREAM_NetworkHeaders_DataHeader_t);
+
+    /* ARGS Check */
+    if ((nbPackets == 0) ||
+        (nbPackets > (1u << 20)) ||
+        (maxFragmentSize == 0))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retLoopback;
+    }
+    while (nbSlots < nbPackets)
+    {
+        nbSlots <<= 1;
+    }
+    if (slotSize < ARSTREAM_TRANSPORT_LOOPBACK_MIN_SLOT_SIZE)
+    {
+        slotSize = ARSTREAM_TRANSPORT_LOOPBACK_MIN_SLOT_SIZE;
+    }
+
+    /* Alloc new loopback */
+    retLoopback = malloc (sizeof (ARSTREAM_Loopback_t));
+    if (retLoopback == NULL)
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        if (ARSTREAM_TransportLoopback_RingInit (&(retLoopback->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA]), nbSlots, slotSize) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            dataRingWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        if (ARSTREAM_TransportLoopback_RingInit (&(retLoopback->rings [ARSTREAM_LOOPBACK_DIRECTION_ACK]), nbSlots, slotSize) != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            ackRingWasInit = 1;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(retLoopback->attachMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            attachMutexWasInit = 1;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        retLoopback->senderIsAttached = 0;
+        retLoopback->readerIsAttached = 0;
+    }
+
+    if ((internalError != ARSTREAM_OK) &&
+        (retLoopback != NULL))
+    {
+        if (dataRingWasInit == 1)
+        {
+            ARSTREAM_TransportLoopback_RingDestroy (&(retLoopback->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA]));
+        }
+        if (ackRingWasInit == 1)
+        {
+            ARSTREAM_TransportLoopback_RingDestroy (&(retLoopback->rings [ARSTREAM_LOOPBACK_DIRECTION_ACK]));
+        }
+        if (attachMutexWasInit == 1)
+        {
+            ARSAL_Mutex_Destroy (&(retLoopback->attachMutex));
+        }
+        free (retLoopback);
+        retLoopback = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retLoopback;
+}
+
+eARSTREAM_ERROR ARSTREAM_Loopback_SetHook (ARSTREAM_Loopback_t *loopback, eARSTREAM_LOOPBACK_DIRECTION direction, ARSTREAM_Loopback_PacketHook_t hook, void *custom)
+{
+    if ((loopback == NULL) ||
+        (direction < 0) ||
+        (direction >= ARSTREAM_LOOPBACK_DIRECTION_MAX))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    loopback->rings [direction].hook = hook;
+    loopback->rings [direction].hookCustom = custom;
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Loopback_GetStats (ARSTREAM_Loopback_t *loopback, eARSTREAM_LOOPBACK_DIRECTION direction, ARSTREAM_Loopback_Stats_t *stats)
+{
+    ARSTREAM_TransportLoopback_Ring_t *ring;
+    if ((loopback == NULL) ||
+        (direction < 0) ||
+        (direction >= ARSTREAM_LOOPBACK_DIRECTION_MAX) ||
+        (stats == NULL))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+    ring = &(loopback->rings [direction]);
+    stats->nbPackets = __atomic_load_n (&(ring->stats.nbPackets), __ATOMIC_RELAXED);
+    stats->nbBytes = __atomic_load_n (&(ring->stats.nbBytes), __ATOMIC_RELAXED);
+    stats->nbDroppedByHook = __atomic_load_n (&(ring->stats.nbDroppedByHook), __ATOMIC_RELAXED);
+    stats->nbDroppedFull = __atomic_load_n (&(ring->stats.nbDroppedFull), __ATOMIC_RELAXED);
+    return ARSTREAM_OK;
+}
+
+eARSTREAM_ERROR ARSTREAM_Loopback_Delete (ARSTREAM_Loopback_t **loopback)
+{
+    eARSTREAM_ERROR retVal = ARSTREAM_ERROR_BAD_PARAMETERS;
+    if ((loopback != NULL) &&
+        (*loopback != NULL))
+    {
+        int canDelete = 0;
+        ARSAL_Mutex_Lock (&((*loopback)->attachMutex));
+        if (((*loopback)->senderIsAttached == 0) &&
+            ((*loopback)->readerIsAttached == 0))
+        {
+            canDelete = 1;
+        }
+        ARSAL_Mutex_Unlock (&((*loopback)->attachMutex));
+
+        if (canDelete == 1)
+        {
+            ARSTREAM_TransportLoopback_RingDestroy (&((*loopback)->rings [ARSTREAM_LOOPBACK_DIRECTION_DATA]));
+            ARSTREAM_TransportLoopback_RingDestroy (&((*loopback)->rings [ARSTREAM_LOOPBACK_DIRECTION_ACK]));
+            ARSAL_Mutex_Destroy (&((*loopback)->attachMutex));
+            free (*loopback);
+            *loopback = NULL;
+            retVal = ARSTREAM_OK;
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_LOOPBACK_TAG, "Delete the sender and the reader before calling this function");
+            retVal = ARSTREAM_ERROR_BUSY;
+        }
+    }
+    return retVal;
+}
@@ -0,0 +1,396 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportReplay.c
+ * @brief Transport interface used by the stream reader, capture file replay backend
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_Transport.h"
+#include "ARSTREAM_CaptureFile.h"
+#include "ARSTREAM_Clock.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRANSPORT_REPLAY_TAG "ARSTREAM_TransportReplay"
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    /* Whole file, mapped read only */
+    uint8_t *map;
+    size_t mapSize;
+    size_t offset;
+    eARSTREAM_CAPTURE_REPLAY_MODE mode;
+
+    /* Next record, already parsed (only used by the reading thread) */
+    int hasPendingPacket;
+    uint64_t pendingTimeUs; // Capture time, relative to the start of the capture
+    const uint8_t *pendingData;
+    uint32_t pendingSize;
+    int hasStarted;
+    uint64_t startTimeUs; // Replay time of the start of the capture
+
+    /* Written by the reading thread only, read with atomics by ARSTREAM_Transport_GetReplayStats */
+    ARSTREAM_Capture_Stats_t stats;
+} ARSTREAM_TransportReplay_Context_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Gets the current time in microseconds
+ */
+static uint64_t ARSTREAM_TransportReplay_GetTimeUs (void);
+
+/**
+ * @brief Parses the next record of the file
+ * @return 1 if a record is pending, 0 at the end of the file (or of its valid part)
+ */
+static int ARSTREAM_TransportReplay_ParseNext (ARSTREAM_TransportReplay_Context_t *replay);
+
+/*
+ * Transport operations
+ */
+static int ARSTREAM_TransportReplay_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+static void ARSTREAM_TransportReplay_Flush (void *context);
+static void ARSTREAM_TransportReplay_Cancel (void *context);
+static int ARSTREAM_TransportReplay_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+static int ARSTREAM_TransportReplay_GetEstimatedLatency (void *context);
+static void ARSTREAM_TransportReplay_Destroy (void *context);
+
+/*
+ * Internal variables
+ */
+
+static const ARSTREAM_Transport_Ops_t ARSTREAM_TransportReplay_Ops = {
+    .send = ARSTREAM_TransportReplay_Send,
+    .flush = ARSTREAM_TransportReplay_Flush,
+    .cancel = ARSTREAM_TransportReplay_Cancel,
+    .read = ARSTREAM_TransportReplay_Read,
+    .getEstimatedLatency = ARSTREAM_TransportReplay_GetEstimatedLatency,
+    .destroy = ARSTREAM_TransportReplay_Destroy,
+};
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_TransportReplay_GetTimeUs (void)
+{
+    struct timespec now;
+    ARSTREAM_Clock_GetTime (&now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int ARSTREAM_TransportReplay_ParseNext (ARSTREAM_TransportReplay_Context_t *replay)
+{
+    uint64_t deltaUs = 0, size = 0;
+    size_t used;
+
+    if (replay->offset >= replay->mapSize)
+    {
+        return 0;
+    }
+
+    used = ARSTREAM_CaptureFile_ReadVarint (&(replay->map [replay->offset]), replay->mapSize - replay->offset, &deltaUs);
+    if (used > 0)
+    {
+        replay->offset += used;
+        used = ARSTREAM_CaptureFile_ReadVarint (&(replay->map [replay->offset]), replay->mapSize - replay->offset, &size);
+    }
+    if ((used == 0) ||
+        (size > replay->mapSize - replay->offset - used))
+    {
+        // Truncated capture (e.g. the capturing process was killed) : replay what was valid
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_REPLAY_TAG, "Truncated record at offset %zu, end of the replay", replay->offset);
+        __atomic_store_n (&(replay->stats.nbErrors), replay->stats.nbErrors + 1, __ATOMIC_RELAXED);
+        replay->offset = replay->mapSize;
+        return 0;
+    }
+    replay->offset += used;
+
+    replay->pendingTimeUs += deltaUs;
+    replay->pendingData = &(replay->map [replay->offset]);
+    replay->pendingSize = (uint32_t)size;
+    replay->offset += size;
+    replay->hasPendingPacket = 1;
+    return 1;
+}
+
+static int ARSTREAM_TransportReplay_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param)
+{
+    // Nobody listens to the acks and key frame requests of a replay
+    (void)context;
+    (void)data;
+    (void)size;
+    if (param != NULL)
+    {
+        param->callback (param, ARSTREAM_TRANSPORT_SEND_STATUS_SENT);
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportReplay_Flush (void *context)
+{
+    (void)context;
+}
+
+static void ARSTREAM_TransportReplay_Cancel (void *context)
+{
+    (void)context;
+}
+
+static int ARSTREAM_TransportReplay_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs)
+{
+    ARSTREAM_TransportReplay_Context_t *replay = (ARSTREAM_TransportReplay_Context_t *)context;
+
+    while (1)
+    {
+        if ((replay->hasPendingPacket == 0) &&
+            (ARSTREAM_TransportReplay_ParseNext (replay) == 0))
+        {
+            // End of the capture : behave like an idle network
+            __atomic_store_n (&(replay->stats.isFinished), 1, __ATOMIC_RELEASE);
+            ARSTREAM_Clock_SleepUs ((uint64_t)timeoutMs * 1000);
+            return -1;
+        }
+
+        if (replay->mode == ARSTREAM_CAPTURE_REPLAY_ORIGINAL_TIMING)
+        {
+            uint64_t nowUs = ARSTREAM_TransportReplay_GetTimeUs ();
+            uint64_t dueUs;
+            if (replay->hasStarted == 0)
+            {
+                // The first packet is given immediately, the following ones keep their captured spacing
+                replay->startTimeUs = nowUs - replay->pendingTimeUs;
+                replay->hasStarted = 1;
+            }
+            dueUs = replay->startTimeUs + replay->pendingTimeUs;
+            if (dueUs > nowUs)
+            {
+                if (dueUs - nowUs > (uint64_t)timeoutMs * 1000)
+                {
+                    ARSTREAM_Clock_SleepUs ((uint64_t)timeoutMs * 1000);
+                    return -1;
+                }
+                ARSTREAM_Clock_SleepUs (dueUs - nowUs);
+            }
+        }
+
+        replay->hasPendingPacket = 0;
+        if (replay->pendingSize > capacity)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_REPLAY_TAG, "Dropping a too large packet (%u bytes)", replay->pendingSize);
+            __atomic_store_n (&(replay->stats.nbErrors), replay->stats.nbErrors + 1, __ATOMIC_RELAXED);
+            continue;
+        }
+        memcpy (data, replay->pendingData, replay->pendingSize);
+        __atomic_store_n (&(replay->stats.nbPackets), replay->stats.nbPackets + 1, __ATOMIC_RELAXED);
+        __atomic_store_n (&(replay->stats.nbBytes), replay->stats.nbBytes + replay->pendingSize, __ATOMIC_RELAXED);
+        __atomic_store_n (&(replay->stats.durationUs), replay->pendingTimeUs, __ATOMIC_RELAXED);
+        return (int)replay->pendingSize;
+    }
+}
+
+static int ARSTREAM_TransportReplay_GetEstimatedLatency (void *context)
+{
+    (void)context;
+    return 0;
+}
+
+static void ARSTREAM_TransportReplay_Destroy (void *context)
+{
+    ARSTREAM_TransportReplay_Context_t *replay = (ARSTREAM_TransportReplay_Context_t *)context;
+    munmap (replay->map, replay->mapSize);
+    free (replay);
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewReplay (const char *path, eARSTREAM_CAPTURE_REPLAY_MODE mode, uint32_t maxPacketSize, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Transport_t *retTransport = NULL;
+    ARSTREAM_TransportReplay_Context_t *replay = NULL;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    struct stat fileStat;
+    int fd = -1;
+
+    /* ARGS Check */
+    if ((path == NULL) ||
+        ((mode != ARSTREAM_CAPTURE_REPLAY_ORIGINAL_TIMING) &&
+         (mode != ARSTREAM_CAPTURE_REPLAY_AS_FAST_AS_POSSIBLE)))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retTransport;
+    }
+
+    retTransport = malloc (sizeof (ARSTREAM_Transport_t));
+    replay = calloc (1, sizeof (ARSTREAM_TransportReplay_Context_t));
+    if ((retTransport == NULL) ||
+        (replay == NULL))
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        fd = open (path, O_RDONLY);
+        if ((fd < 0) ||
+            (fstat (fd, &fileStat) != 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_REPLAY_TAG, "Unable to open %s : %s", path, strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else if (fileStat.st_size < ARSTREAM_CAPTURE_FILE_HEADER_SIZE)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_REPLAY_TAG, "%s is not a capture file", path);
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        replay->mapSize = (size_t)fileStat.st_size;
+        replay->map = mmap (NULL, replay->mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (replay->map == MAP_FAILED)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_REPLAY_TAG, "Unable to map %s : %s", path, strerror (errno));
+            replay->map = NULL;
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+    if (internalError == ARSTREAM_OK)
+    {
+        uint32_t capturedMaxPacketSize = (uint32_t)replay->map [8] | ((uint32_t)replay->map [9] << 8) | ((uint32_t)replay->map [10] << 16) | ((uint32_t)replay->map [11] << 24);
+        if (memcmp (replay->map, ARSTREAM_CAPTURE_MAGIC, ARSTREAM_CAPTURE_FILE_MAGIC_SIZE) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_REPLAY_TAG, "%s is not a capture file", path);
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else if (capturedMaxPacketSize > maxPacketSize)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_REPLAY_TAG, "%s was captured with larger packets (%u > %u), they will be dropped", path, capturedMaxPacketSize, maxPacketSize);
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        madvise (replay->map, replay->mapSize, MADV_SEQUENTIAL);
+        replay->offset = ARSTREAM_CAPTURE_FILE_HEADER_SIZE;
+        replay->mode = mode;
+        retTransport->ops = &ARSTREAM_TransportReplay_Ops;
+        retTransport->context = replay;
+    }
+    else
+    {
+        if ((replay != NULL) &&
+            (replay->map != NULL))
+        {
+            munmap (replay->map, replay->mapSize);
+        }
+        free (replay);
+        free (retTransport);
+        retTransport = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retTransport;
+}
+
+eARSTREAM_ERROR ARSTREAM_Transport_GetReplayStats (ARSTREAM_Transport_t *transport, ARSTREAM_Capture_Stats_t *stats)
+{
+    ARSTREAM_TransportReplay_Context_t *replay;
+
+    if ((transport == NULL) ||
+        (stats == NULL) ||
+        (transport->ops != &ARSTREAM_TransportReplay_Ops))
+    {
+        return ARSTREAM_ERROR_BAD_PARAMETERS;
+    }
+
+    replay = (ARSTREAM_TransportReplay_Context_t *)transport->context;
+    memset (stats, 0, sizeof (ARSTREAM_Capture_Stats_t));
+    stats->nbPackets = __atomic_load_n (&(replay->stats.nbPackets), __ATOMIC_RELAXED);
+    stats->nbBytes = __atomic_load_n (&(replay->stats.nbBytes), __ATOMIC_RELAXED);
+    stats->durationUs = __atomic_load_n (&(replay->stats.durationUs), __ATOMIC_RELAXED);
+    stats->nbErrors = __atomic_load_n (&(replay->stats.nbErrors), __ATOMIC_RELAXED);
+    stats->isFinished = __atomic_load_n (&(replay->stats.isFinished), __ATOMIC_ACQUIRE);
+    return ARSTREAM_OK;
+}
@@ -0,0 +1,562 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportUDP.c
+ * @brief Transport interface used by the stream sender and reader, direct UDP socket backend
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#include <config.h>
+
+#if defined (__linux__) && !defined (_GNU_SOURCE)
+#define _GNU_SOURCE // For sendmmsg/recvmmsg
+#endif
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_Transport.h"
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Socket.h>
+
+/*
+ * Macros
+ */
+
+#define ARSTREAM_TRANSPORT_UDP_TAG "ARSTREAM_TransportUDP"
+
+/**
+ * Use sendmmsg/recvmmsg to send/receive several packets per system call
+ * Can be forced to 0 from the build flags, e.g. for old C libraries or kernels (before Linux 3.0) without sendmmsg
+ */
+#ifndef ARSTREAM_TRANSPORT_UDP_USE_MMSG
+#if defined (__linux__)
+#define ARSTREAM_TRANSPORT_UDP_USE_MMSG (1)
+#else
+#define ARSTREAM_TRANSPORT_UDP_USE_MMSG (0)
+#endif
+#endif
+
+/**
+ * Maximum time to wait for some room in the socket send buffer before dropping the queued packets
+ */
+#define ARSTREAM_TRANSPORT_UDP_SEND_TIMEOUT_MS (20)
+
+/**
+ * Requested socket buffers size, to absorb the bursts of large frames
+ */
+#define ARSTREAM_TRANSPORT_UDP_SOCKET_BUFFER_SIZE (600 * 1024)
+
+/**
+ * Sets *PTR to VAL if PTR is not null
+ */
+#define SET_WITH_CHECK(PTR,VAL)                 \
+    do                                          \
+    {                                           \
+        if (PTR != NULL)                        \
+        {                                       \
+            *PTR = VAL;                         \
+        }                                       \
+    } while (0)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    int socket;
+    uint32_t maxPacketSize;
+
+    /* Remote address : fixed when connected, otherwise the source of the last received packet */
+    int isConnected;
+    ARSAL_Mutex_t remoteMutex;
+    struct sockaddr_in remoteSin;
+    int hasRemote;
+
+    /* Send batch */
+    uint8_t *sendBuffers;
+    uint32_t sendSizes [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    ARSTREAM_Transport_SendParam_t *sendParams [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    int nbPendingSends;
+
+    /* Receive batch */
+    uint8_t *recvBuffers;
+    uint32_t recvSizes [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    struct sockaddr_in recvSins [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    int nbReceived;
+    int recvIndex;
+} ARSTREAM_TransportUDP_Context_t;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Sends some of the queued packets
+ * @param udp The transport context
+ * @param first Index of the first packet to send
+ * @param count Number of packets to send
+ * @param remote Destination of the packets (NULL if the socket is connected)
+ * @return The number of packets sent, or -1 on error (see errno)
+ */
+static int ARSTREAM_TransportUDP_SendBatch (ARSTREAM_TransportUDP_Context_t *udp, int first, int count, struct sockaddr_in *remote);
+
+/**
+ * @brief Receives the packets waiting in the socket into the receive batch
+ * @param udp The transport context
+ * @return The number of packets received, or -1 on error (see errno)
+ */
+static int ARSTREAM_TransportUDP_RecvBatch (ARSTREAM_TransportUDP_Context_t *udp);
+
+static int ARSTREAM_TransportUDP_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param);
+static void ARSTREAM_TransportUDP_Flush (void *context);
+static void ARSTREAM_TransportUDP_Cancel (void *context);
+static int ARSTREAM_TransportUDP_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs);
+static int ARSTREAM_TransportUDP_GetEstimatedLatency (void *context);
+static void ARSTREAM_TransportUDP_Destroy (void *context);
+
+/*
+ * Internal variables
+ */
+
+static const ARSTREAM_Transport_Ops_t ARSTREAM_TransportUDP_Ops = {
+    .send = ARSTREAM_TransportUDP_Send,
+    .flush = ARSTREAM_TransportUDP_Flush,
+    .cancel = ARSTREAM_TransportUDP_Cancel,
+    .read = ARSTREAM_TransportUDP_Read,
+    .getEstimatedLatency = ARSTREAM_TransportUDP_GetEstimatedLatency,
+    .destroy = ARSTREAM_TransportUDP_Destroy,
+};
+
+/*
+ * Internal functions implementation
+ */
+
+static int ARSTREAM_TransportUDP_SendBatch (ARSTREAM_TransportUDP_Context_t *udp, int first, int count, struct sockaddr_in *remote)
+{
+#if ARSTREAM_TRANSPORT_UDP_USE_MMSG == 1
+    struct mmsghdr msgs [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    struct iovec iovs [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    int i;
+    memset (msgs, 0, count * sizeof (struct mmsghdr));
+    for (i = 0; i < count; i++)
+    {
+        iovs[i].iov_base = &(udp->sendBuffers [(first + i) * udp->maxPacketSize]);
+        iovs[i].iov_len = udp->sendSizes [first + i];
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (remote != NULL)
+        {
+            msgs[i].msg_hdr.msg_name = remote;
+            msgs[i].msg_hdr.msg_namelen = sizeof (struct sockaddr_in);
+        }
+    }
+    return sendmmsg (udp->socket, msgs, count, 0);
+#else
+    ssize_t ret;
+    uint8_t *data = &(udp->sendBuffers [first * udp->maxPacketSize]);
+    (void)count;
+    if (remote != NULL)
+    {
+        ret = ARSAL_Socket_Sendto (udp->socket, data, udp->sendSizes [first], 0, (struct sockaddr *)remote, sizeof (struct sockaddr_in));
+    }
+    else
+    {
+        ret = ARSAL_Socket_Send (udp->socket, data, udp->sendSizes [first], 0);
+    }
+    return (ret < 0) ? -1 : 1;
+#endif
+}
+
+static int ARSTREAM_TransportUDP_RecvBatch (ARSTREAM_TransportUDP_Context_t *udp)
+{
+#if ARSTREAM_TRANSPORT_UDP_USE_MMSG == 1
+    struct mmsghdr msgs [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    struct iovec iovs [ARSTREAM_TRANSPORT_UDP_BATCH_SIZE];
+    int i, ret;
+    memset (msgs, 0, sizeof (msgs));
+    for (i = 0; i < ARSTREAM_TRANSPORT_UDP_BATCH_SIZE; i++)
+    {
+        iovs[i].iov_base = &(udp->recvBuffers [i * udp->maxPacketSize]);
+        iovs[i].iov_len = udp->maxPacketSize;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &(udp->recvSins [i]);
+        msgs[i].msg_hdr.msg_namelen = sizeof (struct sockaddr_in);
+    }
+    ret = recvmmsg (udp->socket, msgs, ARSTREAM_TRANSPORT_UDP_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    for (i = 0; i < ret; i++)
+    {
+        // Truncated packets are larger than maxPacketSize, they are dropped by the read function
+        udp->recvSizes [i] = ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) ? udp->maxPacketSize + 1 : msgs[i].msg_len;
+    }
+    return ret;
+#else
+    socklen_t sinSize = sizeof (struct sockaddr_in);
+    ssize_t ret = ARSAL_Socket_Recvfrom (udp->socket, udp->recvBuffers, udp->maxPacketSize + 1, MSG_DONTWAIT, (struct sockaddr *)&(udp->recvSins [0]), &sinSize);
+    if (ret < 0)
+    {
+        return -1;
+    }
+    udp->recvSizes [0] = (uint32_t)ret;
+    return 1;
+#endif
+}
+
+static int ARSTREAM_TransportUDP_Send (void *context, uint8_t *data, uint32_t size, ARSTREAM_Transport_SendParam_t *param)
+{
+    ARSTREAM_TransportUDP_Context_t *udp = (ARSTREAM_TransportUDP_Context_t *)context;
+    if (size > udp->maxPacketSize)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Packet too large (%u bytes, max %u)", size, udp->maxPacketSize);
+        return -1;
+    }
+    if (udp->nbPendingSends == ARSTREAM_TRANSPORT_UDP_BATCH_SIZE)
+    {
+        ARSTREAM_TransportUDP_Flush (context);
+    }
+    memcpy (&(udp->sendBuffers [udp->nbPendingSends * udp->maxPacketSize]), data, size);
+    udp->sendSizes [udp->nbPendingSends] = size;
+    udp->sendParams [udp->nbPendingSends] = param;
+    udp->nbPendingSends++;
+    return 0;
+}
+
+static void ARSTREAM_TransportUDP_Flush (void *context)
+{
+    ARSTREAM_TransportUDP_Context_t *udp = (ARSTREAM_TransportUDP_Context_t *)context;
+    struct sockaddr_in remote;
+    struct sockaddr_in *remotePtr = NULL;
+    int nbSent = 0;
+    int canSend = 1;
+    int i;
+
+    if (udp->nbPendingSends == 0)
+    {
+        return;
+    }
+
+    if (udp->isConnected == 0)
+    {
+        ARSAL_Mutex_Lock (&(udp->remoteMutex));
+        remote = udp->remoteSin;
+        canSend = udp->hasRemote;
+        ARSAL_Mutex_Unlock (&(udp->remoteMutex));
+        remotePtr = &remote;
+    }
+
+    while ((canSend == 1) &&
+           (nbSent < udp->nbPendingSends))
+    {
+        int ret = ARSTREAM_TransportUDP_SendBatch (udp, nbSent, udp->nbPendingSends - nbSent, remotePtr);
+        if (ret > 0)
+        {
+            nbSent += ret;
+        }
+        else if ((errno == EAGAIN) ||
+                 (errno == EWOULDBLOCK) ||
+                 (errno == ENOBUFS))
+        {
+            // Socket buffer is full, wait a bit for some room
+            struct pollfd fds;
+            fds.fd = udp->socket;
+            fds.events = POLLOUT;
+            fds.revents = 0;
+            if (poll (&fds, 1, ARSTREAM_TRANSPORT_UDP_SEND_TIMEOUT_MS) <= 0)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_TRANSPORT_UDP_TAG, "Socket send buffer full, dropping %d packets", udp->nbPendingSends - nbSent);
+                canSend = 0;
+            }
+        }
+        else if (errno != EINTR)
+        {
+            // e.g. ECONNREFUSED when the peer is not (yet) listening : the packet is lost, like on the network
+            ARSAL_PRINT (ARSAL_PRINT_DEBUG, ARSTREAM_TRANSPORT_UDP_TAG, "Send error : %s", strerror (errno));
+            nbSent++;
+        }
+    }
+
+    for (i = 0; i < udp->nbPendingSends; i++)
+    {
+        if (udp->sendParams [i] != NULL)
+        {
+            udp->sendParams [i]->callback (udp->sendParams [i], (i < nbSent) ? ARSTREAM_TRANSPORT_SEND_STATUS_SENT : ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL);
+        }
+    }
+    udp->nbPendingSends = 0;
+}
+
+static void ARSTREAM_TransportUDP_Cancel (void *context)
+{
+    ARSTREAM_TransportUDP_Context_t *udp = (ARSTREAM_TransportUDP_Context_t *)context;
+    int i;
+    for (i = 0; i < udp->nbPendingSends; i++)
+    {
+        if (udp->sendParams [i] != NULL)
+        {
+            udp->sendParams [i]->callback (udp->sendParams [i], ARSTREAM_TRANSPORT_SEND_STATUS_CANCEL);
+        }
+    }
+    udp->nbPendingSends = 0;
+}
+
+static int ARSTREAM_TransportUDP_Read (void *context, uint8_t *data, uint32_t capacity, int timeoutMs)
+{
+    ARSTREAM_TransportUDP_Context_t *udp = (ARSTREAM_TransportUDP_Context_t *)context;
+    while (1)
+    {
+        uint32_t size;
+        if (udp->recvIndex >= udp->nbReceived)
+        {
+            int ret;
+            udp->recvIndex = 0;
+            udp->nbReceived = 0;
+            ret = ARSTREAM_TransportUDP_RecvBatch (udp);
+            if (ret <= 0)
+            {
+                struct pollfd fds;
+                fds.fd = udp->socket;
+                fds.events = POLLIN;
+                fds.revents = 0;
+                if (poll (&fds, 1, timeoutMs) <= 0)
+                {
+                    return -1;
+                }
+                ret = ARSTREAM_TransportUDP_RecvBatch (udp);
+                if (ret <= 0)
+                {
+                    if ((errno != EAGAIN) &&
+                        (errno != EWOULDBLOCK) &&
+                        (errno != EINTR) &&
+                        (errno != ECONNREFUSED))
+                    {
+                        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Error while reading data: %s", strerror (errno));
+                    }
+                    return -1;
+                }
+            }
+            udp->nbReceived = ret;
+            if (udp->isConnected == 0)
+            {
+                ARSAL_Mutex_Lock (&(udp->remoteMutex));
+                udp->remoteSin = udp->recvSins [ret - 1];
+                udp->hasRemote = 1;
+                ARSAL_Mutex_Unlock (&(udp->remoteMutex));
+            }
+        }
+
+        size = udp->recvSizes [udp->recvIndex];
+        if ((size <= udp->maxPacketSize) &&
+            (size <= capacity))
+        {
+            memcpy (data, &(udp->recvBuffers [udp->recvIndex * udp->maxPacketSize]), size);
+            udp->recvIndex++;
+            return (int)size;
+        }
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_UDP_TAG, "Dropping a too large packet (%u bytes)", size);
+        udp->recvIndex++;
+    }
+}
+
+static int ARSTREAM_TransportUDP_GetEstimatedLatency (void *context)
+{
+    // No estimation available : the sender uses its default
+    (void)context;
+    return -1;
+}
+
+static void ARSTREAM_TransportUDP_Destroy (void *context)
+{
+    ARSTREAM_TransportUDP_Context_t *udp = (ARSTREAM_TransportUDP_Context_t *)context;
+    ARSTREAM_TransportUDP_Cancel (context);
+    ARSAL_Socket_Close (udp->socket);
+    ARSAL_Mutex_Destroy (&(udp->remoteMutex));
+    free (udp->sendBuffers);
+    free (udp->recvBuffers);
+    free (udp);
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_Transport_t* ARSTREAM_Transport_NewUDP (const char *remoteAddr, int remotePort, const char *localAddr, int localPort, uint32_t maxPacketSize, eARSTREAM_ERROR *error)
+{
+    ARSTREAM_Transport_t *retTransport = NULL;
+    ARSTREAM_TransportUDP_Context_t *udp = NULL;
+    int remoteMutexWasInit = 0;
+    eARSTREAM_ERROR internalError = ARSTREAM_OK;
+    struct sockaddr_in remoteSin;
+    struct sockaddr_in localSin;
+
+    /* ARGS Check */
+    memset (&remoteSin, 0, sizeof (remoteSin));
+    remoteSin.sin_family = AF_INET;
+    remoteSin.sin_port = htons (remotePort);
+    memset (&localSin, 0, sizeof (localSin));
+    localSin.sin_family = AF_INET;
+    localSin.sin_port = htons (localPort);
+    localSin.sin_addr.s_addr = htonl (INADDR_ANY);
+    if (((remoteAddr != NULL) &&
+         (inet_pton (AF_INET, remoteAddr, &(remoteSin.sin_addr)) != 1)) ||
+        ((localAddr != NULL) &&
+         (inet_pton (AF_INET, localAddr, &(localSin.sin_addr)) != 1)) ||
+        (maxPacketSize == 0))
+    {
+        SET_WITH_CHECK (error, ARSTREAM_ERROR_BAD_PARAMETERS);
+        return retTransport;
+    }
+
+    /* Alloc new transport */
+    retTransport = malloc (sizeof (ARSTREAM_Transport_t));
+    udp = calloc (1, sizeof (ARSTREAM_TransportUDP_Context_t));
+    if ((retTransport == NULL) ||
+        (udp == NULL))
+    {
+        internalError = ARSTREAM_ERROR_ALLOC;
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        udp->socket = -1;
+        udp->maxPacketSize = maxPacketSize;
+        udp->sendBuffers = malloc (ARSTREAM_TRANSPORT_UDP_BATCH_SIZE * maxPacketSize);
+        // One more byte to detect the truncated packets
+        udp->recvBuffers = malloc (ARSTREAM_TRANSPORT_UDP_BATCH_SIZE * maxPacketSize + 1);
+        if ((udp->sendBuffers == NULL) ||
+            (udp->recvBuffers == NULL))
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        int mutexInitRet = ARSAL_Mutex_Init (&(udp->remoteMutex));
+        if (mutexInitRet != 0)
+        {
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            remoteMutexWasInit = 1;
+        }
+    }
+
+    /* Setup the socket */
+    if (internalError == ARSTREAM_OK)
+    {
+        udp->socket = ARSAL_Socket_Create (AF_INET, SOCK_DGRAM, 0);
+        if (udp->socket < 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Socket creation error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else if (((localAddr != NULL) ||
+                  (localPort != 0)) &&
+                 (ARSAL_Socket_Bind (udp->socket, (struct sockaddr *)&localSin, sizeof (localSin)) != 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Socket bind error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else if ((remoteAddr != NULL) &&
+                 (ARSAL_Socket_Connect (udp->socket, (struct sockaddr *)&remoteSin, sizeof (remoteSin)) != 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Socket connect error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_BAD_PARAMETERS;
+        }
+        else if (fcntl (udp->socket, F_SETFL, fcntl (udp->socket, F_GETFL, 0) | O_NONBLOCK) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, ARSTREAM_TRANSPORT_UDP_TAG, "Socket nonblocking setup error : %s", strerror (errno));
+            internalError = ARSTREAM_ERROR_ALLOC;
+        }
+        else
+        {
+            int bufferSize = ARSTREAM_TRANSPORT_UDP_SOCKET_BUFFER_SIZE;
+            /* Not fatal: the transport still works with the default sizes, it may only lose packets on large bursts */
+            if ((ARSAL_Socket_Setsockopt (udp->socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof (bufferSize)) != 0) ||
+                (ARSAL_Socket_Setsockopt (udp->socket, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof (bufferSize)) != 0))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_WARNING, ARSTREAM_TRANSPORT_UDP_TAG, "Unable to set the socket buffers size : %s", strerror (errno));
+            }
+        }
+    }
+
+    if (internalError == ARSTREAM_OK)
+    {
+        udp->isConnected = (remoteAddr != NULL) ? 1 : 0;
+        udp->hasRemote = udp->isConnected;
+        udp->remoteSin = remoteSin;
+        retTransport->ops = &ARSTREAM_TransportUDP_Ops;
+        retTransport->context = udp;
+    }
+    else
+    {
+        if (udp != NULL)
+        {
+            if (udp->socket >= 0)
+            {
+                ARSAL_Socket_Close (udp->socket);
+            }
+            if (remoteMutexWasInit == 1)
+            {
+                ARSAL_Mutex_Destroy (&(udp->remoteMutex));
+            }
+            free (udp->sendBuffers);
+            free (udp->recvBuffers);
+            free (udp);
+        }
+        free (retTransport);
+        retTransport = NULL;
+    }
+
+    SET_WITH_CHECK (error, internalError);
+    return retTransport;
+}
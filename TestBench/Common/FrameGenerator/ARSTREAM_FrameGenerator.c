@@ -0,0 +1,390 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_FrameGenerator.c
+ * @brief Synthetic encoder output : frame sizes and types following a GOP structure
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Private Headers
+ */
+
+#include "ARSTREAM_FrameGenerator.h"
+
+/*
+ * Macros
+ */
+
+/**
+ * Frames are never smaller than the header written by ARSTREAM_FrameGenerator_Fill
+ */
+#define FRAMEGENERATOR_MIN_FRAME_SIZE (8)
+#define FRAMEGENERATOR_HEADER_SIZE (5)
+
+/**
+ * Size deviation draws are clamped to this many standard deviations
+ */
+#define FRAMEGENERATOR_MAX_SIGMAS (4.)
+
+/**
+ * Rate control : the bitrate error is corrected over this many seconds, and the correction
+ * factor is kept in [1 - RC_MAX_CORRECTION, 1 + RC_MAX_CORRECTION]
+ */
+#define FRAMEGENERATOR_RC_WINDOW_S (1)
+#define FRAMEGENERATOR_RC_MAX_CORRECTION (0.5)
+
+/*
+ * Types
+ */
+
+struct ARSTREAM_FrameGenerator {
+    ARSTREAM_FrameGenerator_Config_t config;
+    double bytesPerFrame;
+    double meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_MAX];
+    uint32_t maxFrameSize;
+    uint64_t rngState;
+    uint32_t index;
+    uint32_t posInGop;
+    int forceKeyFrame;
+    double producedBytes;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_FrameGenerator_Random (ARSTREAM_FrameGenerator_t *generator);
+static double ARSTREAM_FrameGenerator_RandomUniform (ARSTREAM_FrameGenerator_t *generator);
+static double ARSTREAM_FrameGenerator_RandomDeviation (ARSTREAM_FrameGenerator_t *generator);
+static eARSTREAM_FRAMEGENERATOR_FRAME ARSTREAM_FrameGenerator_TypeAt (const ARSTREAM_FrameGenerator_Config_t *config, uint32_t posInGop);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_FrameGenerator_Random (ARSTREAM_FrameGenerator_t *generator)
+{
+    // splitmix64
+    uint64_t z = (generator->rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double ARSTREAM_FrameGenerator_RandomUniform (ARSTREAM_FrameGenerator_t *generator)
+{
+    // 53 random bits in ]0, 1]
+    return ((ARSTREAM_FrameGenerator_Random (generator) >> 11) + 1) * (1. / 9007199254740992.);
+}
+
+static double ARSTREAM_FrameGenerator_RandomDeviation (ARSTREAM_FrameGenerator_t *generator)
+{
+    double sigma = generator->config.sizeDeviation;
+    double z;
+    if (sigma <= 0.)
+    {
+        return 1.;
+    }
+    // Box-Muller, then log-normal of mean 1
+    z = sqrt (-2. * log (ARSTREAM_FrameGenerator_RandomUniform (generator))) * cos (2. * M_PI * ARSTREAM_FrameGenerator_RandomUniform (generator));
+    if (z > FRAMEGENERATOR_MAX_SIGMAS)
+    {
+        z = FRAMEGENERATOR_MAX_SIGMAS;
+    }
+    else if (z < -FRAMEGENERATOR_MAX_SIGMAS)
+    {
+        z = -FRAMEGENERATOR_MAX_SIGMAS;
+    }
+    return exp (sigma * z - sigma * sigma / 2.);
+}
+
+static eARSTREAM_FRAMEGENERATOR_FRAME ARSTREAM_FrameGenerator_TypeAt (const ARSTREAM_FrameGenerator_Config_t *config, uint32_t posInGop)
+{
+    if (posInGop == 0)
+    {
+        return ARSTREAM_FRAMEGENERATOR_FRAME_I;
+    }
+    return (((posInGop - 1) % (config->nbBFrames + 1)) == 0) ? ARSTREAM_FRAMEGENERATOR_FRAME_P : ARSTREAM_FRAMEGENERATOR_FRAME_B;
+}
+
+/*
+ * Implementation
+ */
+
+void ARSTREAM_FrameGenerator_DefaultConfig (ARSTREAM_FrameGenerator_Config_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+    memset (config, 0, sizeof (ARSTREAM_FrameGenerator_Config_t));
+    config->bitrateKbps = 4000;
+    config->fps = 30;
+    config->gopLength = 30;
+    config->nbBFrames = 0;
+    config->iWeight = 8.f;
+    config->pWeight = 1.f;
+    config->bWeight = 0.5f;
+    config->sizeDeviation = 0.2f;
+    config->sceneChangePercent = 0.f;
+    config->sceneChangeRatio = 1.5f;
+    config->maxFrameSize = 0;
+    config->startOffset = 0;
+    config->seed = 1;
+}
+
+ARSTREAM_FrameGenerator_t* ARSTREAM_FrameGenerator_New (const ARSTREAM_FrameGenerator_Config_t *config)
+{
+    ARSTREAM_FrameGenerator_t *retGenerator = NULL;
+    double gopWeight = 0.;
+    double maxMean, maxDeviation, maxSize;
+    uint32_t pos;
+
+    if ((config == NULL) ||
+        (config->bitrateKbps == 0) ||
+        (config->fps == 0) ||
+        (config->gopLength == 0) ||
+        (config->iWeight <= 0.f) ||
+        (config->pWeight <= 0.f) ||
+        (config->bWeight <= 0.f) ||
+        (config->sizeDeviation < 0.f) ||
+        (config->sceneChangePercent < 0.f) ||
+        (config->sceneChangeRatio <= 0.f) ||
+        ((config->maxFrameSize != 0) && (config->maxFrameSize < FRAMEGENERATOR_MIN_FRAME_SIZE)))
+    {
+        return NULL;
+    }
+
+    retGenerator = calloc (1, sizeof (ARSTREAM_FrameGenerator_t));
+    if (retGenerator == NULL)
+    {
+        return NULL;
+    }
+    retGenerator->config = *config;
+    retGenerator->rngState = (config->seed != 0) ? config->seed : 1;
+    retGenerator->posInGop = config->startOffset % config->gopLength;
+    retGenerator->bytesPerFrame = config->bitrateKbps * 1000. / 8. / config->fps;
+
+    /* Mean sizes : the weights of a whole GOP add up to gopLength frames at the target bitrate */
+    for (pos = 0; pos < config->gopLength; pos++)
+    {
+        switch (ARSTREAM_FrameGenerator_TypeAt (config, pos))
+        {
+        case ARSTREAM_FRAMEGENERATOR_FRAME_I:
+            gopWeight += config->iWeight;
+            break;
+        case ARSTREAM_FRAMEGENERATOR_FRAME_P:
+            gopWeight += config->pWeight;
+            break;
+        default:
+            gopWeight += config->bWeight;
+            break;
+        }
+    }
+    retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_I] = retGenerator->bytesPerFrame * config->gopLength * config->iWeight / gopWeight;
+    retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_P] = retGenerator->bytesPerFrame * config->gopLength * config->pWeight / gopWeight;
+    retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_B] = retGenerator->bytesPerFrame * config->gopLength * config->bWeight / gopWeight;
+
+    /* Upper bound : largest mean, largest deviation, largest rate control correction */
+    maxMean = retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_I];
+    if (maxMean < retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_P])
+    {
+        maxMean = retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_P];
+    }
+    if (maxMean < retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_B])
+    {
+        maxMean = retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_B];
+    }
+    if ((config->sceneChangePercent > 0.f) &&
+        (config->sceneChangeRatio > 1.f + FRAMEGENERATOR_RC_MAX_CORRECTION))
+    {
+        maxMean = retGenerator->meanSize [ARSTREAM_FRAMEGENERATOR_FRAME_I] * config->sceneChangeRatio;
+    }
+    else
+    {
+        maxMean *= 1. + FRAMEGENERATOR_RC_MAX_CORRECTION;
+    }
+    maxDeviation = exp (config->sizeDeviation * FRAMEGENERATOR_MAX_SIGMAS - config->sizeDeviation * config->sizeDeviation / 2.);
+    maxSize = ceil (maxMean * maxDeviation);
+    if ((config->maxFrameSize != 0) &&
+        (maxSize > config->maxFrameSize))
+    {
+        maxSize = config->maxFrameSize;
+    }
+    else if (maxSize > UINT32_MAX)
+    {
+        maxSize = UINT32_MAX;
+    }
+    retGenerator->maxFrameSize = (maxSize < FRAMEGENERATOR_MIN_FRAME_SIZE) ? FRAMEGENERATOR_MIN_FRAME_SIZE : (uint32_t)maxSize;
+
+    return retGenerator;
+}
+
+void ARSTREAM_FrameGenerator_Delete (ARSTREAM_FrameGenerator_t **generator)
+{
+    if (generator != NULL)
+    {
+        free (*generator);
+        *generator = NULL;
+    }
+}
+
+uint32_t ARSTREAM_FrameGenerator_GetMaxFrameSize (ARSTREAM_FrameGenerator_t *generator)
+{
+    return (generator != NULL) ? generator->maxFrameSize : 0;
+}
+
+uint32_t ARSTREAM_FrameGenerator_GetMeanFrameSize (ARSTREAM_FrameGenerator_t *generator, eARSTREAM_FRAMEGENERATOR_FRAME type)
+{
+    if ((generator == NULL) ||
+        (type < 0) ||
+        (type >= ARSTREAM_FRAMEGENERATOR_FRAME_MAX))
+    {
+        return 0;
+    }
+    return (uint32_t)generator->meanSize [type];
+}
+
+void ARSTREAM_FrameGenerator_ForceKeyFrame (ARSTREAM_FrameGenerator_t *generator)
+{
+    if (generator != NULL)
+    {
+        generator->forceKeyFrame = 1;
+    }
+}
+
+void ARSTREAM_FrameGenerator_Next (ARSTREAM_FrameGenerator_t *generator, ARSTREAM_FrameGenerator_Frame_t *frame)
+{
+    ARSTREAM_FrameGenerator_Config_t *config;
+    double size, correction;
+    int isSceneChange = 0;
+
+    if ((generator == NULL) ||
+        (frame == NULL))
+    {
+        return;
+    }
+    config = &(generator->config);
+
+    /* The draw is done for every frame, so that forcing a key frame does not shift the following scene changes */
+    if ((config->sceneChangePercent > 0.f) &&
+        (ARSTREAM_FrameGenerator_RandomUniform (generator) * 100. <= config->sceneChangePercent))
+    {
+        isSceneChange = 1;
+    }
+    if ((isSceneChange != 0) ||
+        (generator->forceKeyFrame != 0))
+    {
+        generator->posInGop = 0;
+    }
+
+    frame->index = generator->index;
+    frame->timestampUs = (uint64_t)generator->index * 1000000 / config->fps;
+    frame->type = ARSTREAM_FrameGenerator_TypeAt (config, generator->posInGop);
+    frame->isKeyFrame = (frame->type == ARSTREAM_FRAMEGENERATOR_FRAME_I) ? 1 : 0;
+    frame->isSceneChange = ((isSceneChange != 0) || (generator->forceKeyFrame != 0)) ? 1 : 0;
+
+    size = generator->meanSize [frame->type] * ARSTREAM_FrameGenerator_RandomDeviation (generator);
+    if (isSceneChange != 0)
+    {
+        /* Scene cuts are not rate controlled : the following frames pay for them */
+        size *= config->sceneChangeRatio;
+    }
+    else
+    {
+        double deficit = generator->index * generator->bytesPerFrame - generator->producedBytes;
+        correction = 1. + deficit / (generator->bytesPerFrame * config->fps * FRAMEGENERATOR_RC_WINDOW_S);
+        if (correction > 1. + FRAMEGENERATOR_RC_MAX_CORRECTION)
+        {
+            correction = 1. + FRAMEGENERATOR_RC_MAX_CORRECTION;
+        }
+        else if (correction < 1. - FRAMEGENERATOR_RC_MAX_CORRECTION)
+        {
+            correction = 1. - FRAMEGENERATOR_RC_MAX_CORRECTION;
+        }
+        size *= correction;
+    }
+    if (size > generator->maxFrameSize)
+    {
+        size = generator->maxFrameSize;
+    }
+    else if (size < FRAMEGENERATOR_MIN_FRAME_SIZE)
+    {
+        size = FRAMEGENERATOR_MIN_FRAME_SIZE;
+    }
+    frame->size = (uint32_t)size;
+
+    generator->producedBytes += frame->size;
+    generator->forceKeyFrame = 0;
+    generator->index++;
+    generator->posInGop = (generator->posInGop + 1) % config->gopLength;
+}
+
+void ARSTREAM_FrameGenerator_Fill (const ARSTREAM_FrameGenerator_Frame_t *frame, uint8_t *buffer)
+{
+    if ((frame == NULL) ||
+        (buffer == NULL) ||
+        (frame->size < FRAMEGENERATOR_HEADER_SIZE))
+    {
+        return;
+    }
+    buffer [0] = (uint8_t)(frame->index);
+    buffer [1] = (uint8_t)(frame->index >> 8);
+    buffer [2] = (uint8_t)(frame->index >> 16);
+    buffer [3] = (uint8_t)(frame->index >> 24);
+    buffer [4] = (uint8_t)(frame->type);
+    memset (&buffer [FRAMEGENERATOR_HEADER_SIZE], (uint8_t)(frame->index), frame->size - FRAMEGENERATOR_HEADER_SIZE);
+}
+
+const char* ARSTREAM_FrameGenerator_FrameTypeToString (eARSTREAM_FRAMEGENERATOR_FRAME type)
+{
+    switch (type)
+    {
+    case ARSTREAM_FRAMEGENERATOR_FRAME_I:
+        return "I";
+    case ARSTREAM_FRAMEGENERATOR_FRAME_P:
+        return "P";
+    case ARSTREAM_FRAMEGENERATOR_FRAME_B:
+        return "B";
+    default:
+        return "?";
+    }
+}
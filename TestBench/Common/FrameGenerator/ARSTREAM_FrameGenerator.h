@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_FrameGenerator.h
+ * @brief Synthetic encoder output : frame sizes and types following a GOP structure
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_FRAMEGENERATOR_H_
+#define _ARSTREAM_FRAMEGENERATOR_H_
+
+#include <inttypes.h>
+
+/**
+ * @brief Type of a generated frame
+ */
+typedef enum {
+    ARSTREAM_FRAMEGENERATOR_FRAME_I = 0, /**< Key frame, starts a GOP */
+    ARSTREAM_FRAMEGENERATOR_FRAME_P, /**< Predicted from the previous reference frame */
+    ARSTREAM_FRAMEGENERATOR_FRAME_B, /**< Bi-predicted, never a reference */
+    ARSTREAM_FRAMEGENERATOR_FRAME_MAX,
+} eARSTREAM_FRAMEGENERATOR_FRAME;
+
+/**
+ * @brief Configuration of a generator
+ *
+ * Frames are produced in decoding order : I P B..B P B..B ..., with nbBFrames B-frames
+ * after each reference frame but the I-frame.
+ * The mean size of each frame type is proportional to its weight, so that a GOP matches
+ * bitrateKbps. Each size is then multiplied by a log-normal factor of mean 1
+ * (sizeDeviation is its standard deviation, in log space), and by a rate control factor
+ * which slowly pulls the produced bitrate back to the target.
+ * A scene change replaces the next frame by an I-frame sceneChangeRatio times larger than
+ * a normal I-frame, and restarts the GOP, as encoders do on a scene cut.
+ */
+typedef struct {
+    uint32_t bitrateKbps; /**< Target bitrate */
+    uint32_t fps; /**< Frame rate (timestamps, and frame size from the bitrate) */
+    uint32_t gopLength; /**< Number of frames between two I-frames (1 for intra only) */
+    uint32_t nbBFrames; /**< Number of consecutive B-frames between reference frames */
+    float iWeight; /**< Relative size of an I-frame */
+    float pWeight; /**< Relative size of a P-frame */
+    float bWeight; /**< Relative size of a B-frame */
+    float sizeDeviation; /**< Log-normal size deviation (0 for constant sizes per type) */
+    float sceneChangePercent; /**< Probability of a scene change, per frame (0 to 100) */
+    float sceneChangeRatio; /**< Size of a scene change I-frame, relative to a normal I-frame */
+    uint32_t maxFrameSize; /**< Sizes are clamped to this value (0 for no limit) */
+    uint32_t startOffset; /**< Position of the first frame in its GOP, to shift streams started together */
+    uint32_t seed; /**< Seed of the PRNG (0 is replaced by 1) */
+} ARSTREAM_FrameGenerator_Config_t;
+
+/**
+ * @brief Description of a generated frame
+ */
+typedef struct {
+    uint32_t index; /**< Number of the frame, from 0 */
+    uint32_t size; /**< Size of the frame, in bytes */
+    uint64_t timestampUs; /**< Timestamp of the frame, from the first frame */
+    eARSTREAM_FRAMEGENERATOR_FRAME type; /**< Type of the frame */
+    int isKeyFrame; /**< Frame must be sent with flushPreviousFrames set */
+    int isSceneChange; /**< Key frame caused by a scene change (or a forced key frame) */
+} ARSTREAM_FrameGenerator_Frame_t;
+
+/**
+ * @brief A frame generator
+ * A generator is not thread safe : use one generator per stream, from the encoder thread of the stream.
+ * Two generators with the same configuration produce the same frames.
+ */
+typedef struct ARSTREAM_FrameGenerator ARSTREAM_FrameGenerator_t;
+
+/**
+ * @brief Sets a configuration to the defaults
+ * 4 Mbit/s at 30 fps, GOP of 30 frames without B-frames, I-frames 8 times the size of P-frames,
+ * 20% size deviation, no scene change
+ * @param config The configuration to fill
+ */
+void ARSTREAM_FrameGenerator_DefaultConfig (ARSTREAM_FrameGenerator_Config_t *config);
+
+/**
+ * @brief Creates a generator
+ * @param config The configuration (copied)
+ * @return A new generator, or NULL if the configuration is invalid
+ */
+ARSTREAM_FrameGenerator_t* ARSTREAM_FrameGenerator_New (const ARSTREAM_FrameGenerator_Config_t *config);
+
+/**
+ * @brief Deletes a generator
+ * @param generator Pointer to the generator to delete (set to NULL)
+ */
+void ARSTREAM_FrameGenerator_Delete (ARSTREAM_FrameGenerator_t **generator);
+
+/**
+ * @brief Gets an upper bound of the generated frame sizes
+ * Used to size the frame buffers
+ */
+uint32_t ARSTREAM_FrameGenerator_GetMaxFrameSize (ARSTREAM_FrameGenerator_t *generator);
+
+/**
+ * @brief Gets the mean frame size of each type
+ * @param generator The generator
+ * @param type The frame type
+ * @return The mean size, before deviation and rate control
+ */
+uint32_t ARSTREAM_FrameGenerator_GetMeanFrameSize (ARSTREAM_FrameGenerator_t *generator, eARSTREAM_FRAMEGENERATOR_FRAME type);
+
+/**
+ * @brief Makes the next frame a key frame, and restarts the GOP
+ * To be called when the sender reports ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST
+ */
+void ARSTREAM_FrameGenerator_ForceKeyFrame (ARSTREAM_FrameGenerator_t *generator);
+
+/**
+ * @brief Generates the next frame
+ * @param generator The generator
+ * @param[out] frame Description of the frame
+ */
+void ARSTREAM_FrameGenerator_Next (ARSTREAM_FrameGenerator_t *generator, ARSTREAM_FrameGenerator_Frame_t *frame);
+
+/**
+ * @brief Fills a buffer with the content of a frame
+ * The first bytes hold the frame index (little endian) and the type, the rest is a pattern
+ * depending on the index, so that a reader can check what it got.
+ * @param frame The frame description
+ * @param buffer The buffer, of at least frame->size bytes
+ */
+void ARSTREAM_FrameGenerator_Fill (const ARSTREAM_FrameGenerator_Frame_t *frame, uint8_t *buffer);
+
+/**
+ * @brief Gets the name of a frame type ("I", "P" or "B")
+ */
+const char* ARSTREAM_FrameGenerator_FrameTypeToString (eARSTREAM_FRAMEGENERATOR_FRAME type);
+
+#endif /* _ARSTREAM_FRAMEGENERATOR_H_ */
@@ -0,0 +1,648 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_ImpairmentScenarios.c
+ * @brief Runs scripted network impairment scenarios and reports the stream latency and losses
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_ImpairmentScenarios.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_ImpairmentScenarios"
+
+#define SCENARIO_NAME_SIZE (64)
+#define LINE_SIZE (1024)
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define DRAIN_TIME_MS (500)
+#define HEADER_SIZE (4)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    char name [SCENARIO_NAME_SIZE];
+    int nbFrames;
+    int fps;
+    int frameSize;
+    int fragSize;
+    int minRetryMs;
+    int maxRetryMs;
+    int ackIntervalMs;
+    ARSTREAM_Impairment_Config_t data;
+    ARSTREAM_Impairment_Config_t ack;
+} ARSTREAM_ImpairmentScenarios_Scenario_t;
+
+typedef struct {
+    int nbReceived;
+    int nbSkipped;
+    uint32_t latencyP50Us;
+    uint32_t latencyP95Us;
+    uint32_t latencyP99Us;
+    uint32_t latencyMaxUs;
+    ARSTREAM_Impairment_Stats_t dataStats;
+    ARSTREAM_Impairment_Stats_t ackStats;
+    ARSTREAM_Reader_FreezeStats_t freezeStats;
+} ARSTREAM_ImpairmentScenarios_Result_t;
+
+/*
+ * Globals
+ */
+
+static pthread_mutex_t g_RecvMutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t *g_SendTimesUs = NULL;
+static uint32_t *g_LatenciesUs = NULL;
+static uint8_t *g_Received = NULL;
+static int g_NbFrames = 0;
+static int g_NbReceived = 0;
+static int g_NbSkipped = 0;
+static uint8_t *g_RecvBuffer = NULL;
+static uint32_t g_RecvBufferSize = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_ImpairmentScenarios_GetTimeUs (void);
+static void ARSTREAM_ImpairmentScenarios_DefaultScenario (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, const char *name);
+static int ARSTREAM_ImpairmentScenarios_SetImpairmentKey (ARSTREAM_Impairment_Config_t *config, const char *key, const char *value);
+static int ARSTREAM_ImpairmentScenarios_ParseLine (char *line, ARSTREAM_ImpairmentScenarios_Scenario_t *scenario);
+static int ARSTREAM_ImpairmentScenarios_BuiltIn (ARSTREAM_ImpairmentScenarios_Scenario_t **scenarios);
+static int ARSTREAM_ImpairmentScenarios_ReadFile (const char *path, ARSTREAM_ImpairmentScenarios_Scenario_t **scenarios);
+static int ARSTREAM_ImpairmentScenarios_CompareU32 (const void *a, const void *b);
+static void ARSTREAM_ImpairmentScenarios_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_ImpairmentScenarios_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static int ARSTREAM_ImpairmentScenarios_Run (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, int udpPort, ARSTREAM_ImpairmentScenarios_Result_t *result);
+static void ARSTREAM_ImpairmentScenarios_PrintResult (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, ARSTREAM_ImpairmentScenarios_Result_t *result, int csv);
+static void ARSTREAM_ImpairmentScenarios_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_ImpairmentScenarios_GetTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void ARSTREAM_ImpairmentScenarios_DefaultScenario (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, const char *name)
+{
+    memset (scenario, 0, sizeof (ARSTREAM_ImpairmentScenarios_Scenario_t));
+    snprintf (scenario->name, SCENARIO_NAME_SIZE, "%s", name);
+    scenario->nbFrames = 150;
+    scenario->fps = 30;
+    scenario->frameSize = 20000;
+    scenario->fragSize = 1000;
+    scenario->minRetryMs = 15;
+    scenario->maxRetryMs = 50;
+    scenario->ackIntervalMs = ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT;
+    ARSTREAM_Impairment_DefaultConfig (&(scenario->data));
+    ARSTREAM_Impairment_DefaultConfig (&(scenario->ack));
+    scenario->data.seed = 1;
+    scenario->ack.seed = 2;
+}
+
+static int ARSTREAM_ImpairmentScenarios_SetImpairmentKey (ARSTREAM_Impairment_Config_t *config, const char *key, const char *value)
+{
+    if (strcmp (key, "loss") == 0) { config->lossPercent = atof (value); }
+    else if (strcmp (key, "burst_enter") == 0) { config->burstEnterPercent = atof (value); }
+    else if (strcmp (key, "burst_exit") == 0) { config->burstExitPercent = atof (value); }
+    else if (strcmp (key, "burst_loss") == 0) { config->burstLossPercent = atof (value); }
+    else if (strcmp (key, "delay") == 0) { config->delayMs = atoi (value); }
+    else if (strcmp (key, "jitter") == 0) { config->jitterMs = atoi (value); }
+    else if (strcmp (key, "reorder") == 0) { config->reorderPercent = atof (value); }
+    else if (strcmp (key, "reorder_delay") == 0) { config->reorderDelayMs = atoi (value); }
+    else if (strcmp (key, "dup") == 0) { config->duplicatePercent = atof (value); }
+    else if (strcmp (key, "bw") == 0) { config->bandwidthKbps = atoi (value); }
+    else if (strcmp (key, "queue") == 0) { config->queueLimitBytes = atoi (value); }
+    else if (strcmp (key, "seed") == 0) { config->seed = strtoul (value, NULL, 0); }
+    else { return -1; }
+    return 0;
+}
+
+static int ARSTREAM_ImpairmentScenarios_ParseLine (char *line, ARSTREAM_ImpairmentScenarios_Scenario_t *scenario)
+{
+    char *saveptr = NULL;
+    char *token = strtok_r (line, " \t\r\n", &saveptr);
+
+    if ((token == NULL) ||
+        (token [0] == '#'))
+    {
+        return 0;
+    }
+    ARSTREAM_ImpairmentScenarios_DefaultScenario (scenario, token);
+
+    while ((token = strtok_r (NULL, " \t\r\n", &saveptr)) != NULL)
+    {
+        char *value = strchr (token, '=');
+        int ret = 0;
+        if (value == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Scenario %s : missing value for %s", scenario->name, token);
+            return -1;
+        }
+        *value++ = '\0';
+
+        if (strcmp (token, "frames") == 0) { scenario->nbFrames = atoi (value); }
+        else if (strcmp (token, "fps") == 0) { scenario->fps = atoi (value); }
+        else if (strcmp (token, "size") == 0) { scenario->frameSize = atoi (value); }
+        else if (strcmp (token, "frag") == 0) { scenario->fragSize = atoi (value); }
+        else if (strcmp (token, "minretry") == 0) { scenario->minRetryMs = atoi (value); }
+        else if (strcmp (token, "maxretry") == 0) { scenario->maxRetryMs = atoi (value); }
+        else if (strcmp (token, "ackinterval") == 0) { scenario->ackIntervalMs = atoi (value); }
+        else if (strncmp (token, "data.", 5) == 0)
+        {
+            ret = ARSTREAM_ImpairmentScenarios_SetImpairmentKey (&(scenario->data), token + 5, value);
+        }
+        else if (strncmp (token, "ack.", 4) == 0)
+        {
+            ret = ARSTREAM_ImpairmentScenarios_SetImpairmentKey (&(scenario->ack), token + 4, value);
+        }
+        else
+        {
+            // Unprefixed impairment keys apply to both directions (seeds are kept different)
+            uint32_t dataSeed = scenario->data.seed, ackSeed = scenario->ack.seed;
+            ret = ARSTREAM_ImpairmentScenarios_SetImpairmentKey (&(scenario->data), token, value);
+            if (ret == 0)
+            {
+                ARSTREAM_ImpairmentScenarios_SetImpairmentKey (&(scenario->ack), token, value);
+                if (strcmp (token, "seed") == 0)
+                {
+                    scenario->ack.seed = scenario->data.seed + 1;
+                }
+                else
+                {
+                    scenario->data.seed = dataSeed;
+                    scenario->ack.seed = ackSeed;
+                }
+            }
+        }
+        if (ret != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Scenario %s : unknown key %s", scenario->name, token);
+            return -1;
+        }
+    }
+
+    if ((scenario->nbFrames <= 0) ||
+        (scenario->fps <= 0) ||
+        (scenario->fragSize <= 0) ||
+        (scenario->frameSize < HEADER_SIZE) ||
+        (scenario->frameSize > scenario->fragSize * MAX_NB_FRAG) ||
+        (scenario->minRetryMs <= 0) ||
+        (scenario->maxRetryMs < scenario->minRetryMs))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Scenario %s : invalid stream parameters", scenario->name);
+        return -1;
+    }
+    return 1;
+}
+
+static int ARSTREAM_ImpairmentScenarios_BuiltIn (ARSTREAM_ImpairmentScenarios_Scenario_t **scenarios)
+{
+    static const char *lines [] = {
+        "perfect",
+        "random_loss_2 loss=2",
+        "random_loss_10 loss=10",
+        "burst_loss burst_enter=2 burst_exit=25 burst_loss=70",
+        "long_rtt delay=40 jitter=10",
+        "jitter_reorder delay=5 jitter=15 reorder=5 reorder_delay=20 dup=1",
+        "ack_loss_only ack.loss=20",
+        "bandwidth_6M data.bw=6000 data.queue=60000 data.delay=5 ack.delay=5",
+    };
+    int nbLines = sizeof (lines) / sizeof (lines [0]);
+    int nbScenarios = 0;
+    int i;
+
+    *scenarios = malloc (nbLines * sizeof (ARSTREAM_ImpairmentScenarios_Scenario_t));
+    if (*scenarios == NULL)
+    {
+        return -1;
+    }
+    for (i = 0; i < nbLines; i++)
+    {
+        char line [LINE_SIZE];
+        snprintf (line, LINE_SIZE, "%s", lines [i]);
+        if (ARSTREAM_ImpairmentScenarios_ParseLine (line, &((*scenarios) [nbScenarios])) == 1)
+        {
+            nbScenarios++;
+        }
+    }
+    return nbScenarios;
+}
+
+static int ARSTREAM_ImpairmentScenarios_ReadFile (const char *path, ARSTREAM_ImpairmentScenarios_Scenario_t **scenarios)
+{
+    FILE *file = fopen (path, "r");
+    char line [LINE_SIZE];
+    int nbScenarios = 0;
+    int capacity = 0;
+
+    *scenarios = NULL;
+    if (file == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to open %s", path);
+        return -1;
+    }
+    while (fgets (line, LINE_SIZE, file) != NULL)
+    {
+        ARSTREAM_ImpairmentScenarios_Scenario_t scenario;
+        int ret = ARSTREAM_ImpairmentScenarios_ParseLine (line, &scenario);
+        if (ret < 0)
+        {
+            nbScenarios = -1;
+            break;
+        }
+        if (ret == 0)
+        {
+            continue;
+        }
+        if (nbScenarios == capacity)
+        {
+            ARSTREAM_ImpairmentScenarios_Scenario_t *newScenarios;
+            capacity = (capacity == 0) ? 8 : capacity * 2;
+            newScenarios = realloc (*scenarios, capacity * sizeof (ARSTREAM_ImpairmentScenarios_Scenario_t));
+            if (newScenarios == NULL)
+            {
+                nbScenarios = -1;
+                break;
+            }
+            *scenarios = newScenarios;
+        }
+        (*scenarios) [nbScenarios++] = scenario;
+    }
+    fclose (file);
+    return nbScenarios;
+}
+
+static int ARSTREAM_ImpairmentScenarios_CompareU32 (const void *a, const void *b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static void ARSTREAM_ImpairmentScenarios_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_ImpairmentScenarios_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)isFlushFrame;
+    (void)custom;
+    if ((cause == ARSTREAM_READER_CAUSE_FRAME_COMPLETE) &&
+        (frameSize >= HEADER_SIZE))
+    {
+        uint64_t nowUs = ARSTREAM_ImpairmentScenarios_GetTimeUs ();
+        uint32_t index;
+        memcpy (&index, framePointer, HEADER_SIZE);
+
+        pthread_mutex_lock (&g_RecvMutex);
+        if ((index < (uint32_t)g_NbFrames) &&
+            (g_Received [index] == 0))
+        {
+            g_Received [index] = 1;
+            g_LatenciesUs [g_NbReceived++] = (uint32_t)(nowUs - g_SendTimesUs [index]);
+        }
+        if (numberOfSkippedFrames > 0)
+        {
+            g_NbSkipped += numberOfSkippedFrames;
+        }
+        pthread_mutex_unlock (&g_RecvMutex);
+    }
+    *newBufferCapacity = g_RecvBufferSize;
+    return g_RecvBuffer;
+}
+
+static int ARSTREAM_ImpairmentScenarios_Run (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, int udpPort, ARSTREAM_ImpairmentScenarios_Result_t *result)
+{
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint64_t startUs, periodUs;
+    struct timespec drainTime;
+    int drainMs;
+    int retVal = 0;
+    int i, j;
+
+    /* Buffers and results storage */
+    g_NbFrames = scenario->nbFrames;
+    g_NbReceived = 0;
+    g_NbSkipped = 0;
+    g_SendTimesUs = calloc (scenario->nbFrames, sizeof (uint64_t));
+    g_LatenciesUs = calloc (scenario->nbFrames, sizeof (uint32_t));
+    g_Received = calloc (scenario->nbFrames, 1);
+    g_RecvBufferSize = scenario->frameSize;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (scenario->frameSize);
+        if (sendBuffers [i] != NULL)
+        {
+            for (j = HEADER_SIZE; j < scenario->frameSize; j++)
+            {
+                sendBuffers [i][j] = (uint8_t)(i + j);
+            }
+        }
+        else
+        {
+            retVal = -1;
+        }
+    }
+    if ((g_SendTimesUs == NULL) ||
+        (g_LatenciesUs == NULL) ||
+        (g_Received == NULL) ||
+        (g_RecvBuffer == NULL))
+    {
+        retVal = -1;
+    }
+
+    /* Library objects */
+    if (retVal == 0)
+    {
+        if (udpPort > 0)
+        {
+            sender = ARSTREAM_Sender_NewUDP ("127.0.0.1", udpPort, ARSTREAM_ImpairmentScenarios_FrameUpdateCallback, SENDER_QUEUE_SIZE, scenario->fragSize, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewUDP ("127.0.0.1", udpPort, ARSTREAM_ImpairmentScenarios_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, scenario->fragSize, scenario->ackIntervalMs, NULL, &err);
+        }
+        else
+        {
+            loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, scenario->fragSize, &err);
+            if (loopback != NULL)
+            {
+                sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_ImpairmentScenarios_FrameUpdateCallback, SENDER_QUEUE_SIZE, scenario->fragSize, MAX_NB_FRAG, NULL, &err);
+                reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_ImpairmentScenarios_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, scenario->fragSize, scenario->ackIntervalMs, NULL, &err);
+            }
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+    if (retVal == 0)
+    {
+        if ((ARSTREAM_Sender_SetImpairment (sender, &(scenario->data)) != ARSTREAM_OK) ||
+            (ARSTREAM_Reader_SetImpairment (reader, &(scenario->ack)) != ARSTREAM_OK) ||
+            (ARSTREAM_Sender_SetTimeBetweenRetries (sender, scenario->minRetryMs, scenario->maxRetryMs) != ARSTREAM_OK))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to configure the sender/reader");
+            retVal = -1;
+        }
+    }
+
+    if (retVal == 0)
+    {
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        /* Open loop : one frame per period, whatever happens on the link */
+        periodUs = 1000000 / scenario->fps;
+        startUs = ARSTREAM_ImpairmentScenarios_GetTimeUs ();
+        for (i = 0; i < scenario->nbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            uint64_t targetUs = startUs + i * periodUs;
+            uint64_t nowUs = ARSTREAM_ImpairmentScenarios_GetTimeUs ();
+            uint32_t index = i;
+            if (targetUs > nowUs)
+            {
+                usleep ((useconds_t)(targetUs - nowUs));
+            }
+            memcpy (frame, &index, HEADER_SIZE);
+            pthread_mutex_lock (&g_RecvMutex);
+            g_SendTimesUs [i] = ARSTREAM_ImpairmentScenarios_GetTimeUs ();
+            pthread_mutex_unlock (&g_RecvMutex);
+            ARSTREAM_Sender_SendNewFrame (sender, frame, scenario->frameSize, 0, NULL);
+        }
+        drainMs = DRAIN_TIME_MS + scenario->maxRetryMs + scenario->data.delayMs + scenario->data.jitterMs + scenario->data.reorderDelayMs;
+        drainTime.tv_sec = drainMs / 1000;
+        drainTime.tv_nsec = (drainMs % 1000) * 1000000L;
+        nanosleep (&drainTime, NULL);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        /* Results */
+        memset (result, 0, sizeof (ARSTREAM_ImpairmentScenarios_Result_t));
+        ARSTREAM_Sender_GetImpairmentStats (sender, &(result->dataStats));
+        ARSTREAM_Reader_GetImpairmentStats (reader, &(result->ackStats));
+        ARSTREAM_Reader_GetFreezeStats (reader, &(result->freezeStats));
+        result->nbReceived = g_NbReceived;
+        result->nbSkipped = g_NbSkipped;
+        if (g_NbReceived > 0)
+        {
+            qsort (g_LatenciesUs, g_NbReceived, sizeof (uint32_t), ARSTREAM_ImpairmentScenarios_CompareU32);
+            result->latencyP50Us = g_LatenciesUs [(g_NbReceived - 1) * 50 / 100];
+            result->latencyP95Us = g_LatenciesUs [(g_NbReceived - 1) * 95 / 100];
+            result->latencyP99Us = g_LatenciesUs [(g_NbReceived - 1) * 99 / 100];
+            result->latencyMaxUs = g_LatenciesUs [g_NbReceived - 1];
+        }
+    }
+
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    free (g_SendTimesUs);
+    free (g_LatenciesUs);
+    free (g_Received);
+    free (g_RecvBuffer);
+    g_SendTimesUs = NULL;
+    g_LatenciesUs = NULL;
+    g_Received = NULL;
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static void ARSTREAM_ImpairmentScenarios_PrintResult (ARSTREAM_ImpairmentScenarios_Scenario_t *scenario, ARSTREAM_ImpairmentScenarios_Result_t *result, int csv)
+{
+    ARSTREAM_Impairment_Stats_t *data = &(result->dataStats);
+    ARSTREAM_Impairment_Stats_t *ack = &(result->ackStats);
+    uint64_t dataLost = data->nbLostRandom + data->nbLostBurst + data->nbLostQueue;
+    uint64_t ackLost = ack->nbLostRandom + ack->nbLostBurst + ack->nbLostQueue;
+    int nbFragPerFrame = (scenario->frameSize + scenario->fragSize - 1) / scenario->fragSize;
+    double deliveredPercent = 100. * result->nbReceived / scenario->nbFrames;
+    double dataLossPercent = (data->nbPackets > 0) ? 100. * dataLost / data->nbPackets : 0.;
+    double ackLossPercent = (ack->nbPackets > 0) ? 100. * ackLost / ack->nbPackets : 0.;
+    double sendOverhead = (double)data->nbPackets / ((double)scenario->nbFrames * nbFragPerFrame);
+
+    if (csv != 0)
+    {
+        printf ("%s,%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%u,%u\n",
+                scenario->name, scenario->nbFrames, result->nbReceived, deliveredPercent,
+                result->latencyP50Us / 1000., result->latencyP95Us / 1000., result->latencyP99Us / 1000., result->latencyMaxUs / 1000.,
+                dataLossPercent, ackLossPercent, sendOverhead,
+                result->freezeStats.nbFreezes, result->freezeStats.maxFreezeMs);
+    }
+    else
+    {
+        printf ("%-20s %5d/%-5d %6.1f%% %8.2f %8.2f %8.2f %8.2f %7.2f%% %7.2f%% %6.3f %5u %6u\n",
+                scenario->name, result->nbReceived, scenario->nbFrames, deliveredPercent,
+                result->latencyP50Us / 1000., result->latencyP95Us / 1000., result->latencyP99Us / 1000., result->latencyMaxUs / 1000.,
+                dataLossPercent, ackLossPercent, sendOverhead,
+                result->freezeStats.nbFreezes, result->freezeStats.maxFreezeMs);
+    }
+    fflush (stdout);
+}
+
+static void ARSTREAM_ImpairmentScenarios_Usage (const char *name)
+{
+    printf ("Usage: %s [-f scenarioFile] [-u udpPort] [-c]\n", name);
+    printf ("  -f : read the scenarios from a file instead of the built-in list\n");
+    printf ("  -u : stream over UDP on localhost instead of an in-process loopback\n");
+    printf ("  -c : print the reports as CSV\n");
+    printf ("Scenario file : one scenario per line, '#' for comments :\n");
+    printf ("  name [key=value ...]\n");
+    printf ("Stream keys : frames, fps, size, frag, minretry, maxretry (ms), ackinterval (ms)\n");
+    printf ("Impairment keys (prefix with data. or ack. for a single direction) :\n");
+    printf ("  loss, burst_enter, burst_exit, burst_loss, reorder, dup (percent),\n");
+    printf ("  delay, jitter, reorder_delay (ms), bw (kbit/s), queue (bytes), seed\n");
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_ImpairmentScenarios_Main (int argc, char *argv[])
+{
+    ARSTREAM_ImpairmentScenarios_Scenario_t *scenarios = NULL;
+    const char *scenarioFile = NULL;
+    int nbScenarios;
+    int udpPort = 0;
+    int csv = 0;
+    int nbFailures = 0;
+    int opt, i;
+
+    while ((opt = getopt (argc, argv, "f:u:ch")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f': scenarioFile = optarg; break;
+        case 'u': udpPort = atoi (optarg); break;
+        case 'c': csv = 1; break;
+        default:
+            ARSTREAM_ImpairmentScenarios_Usage (argv[0]);
+            return 1;
+        }
+    }
+
+    if (scenarioFile != NULL)
+    {
+        nbScenarios = ARSTREAM_ImpairmentScenarios_ReadFile (scenarioFile, &scenarios);
+    }
+    else
+    {
+        nbScenarios = ARSTREAM_ImpairmentScenarios_BuiltIn (&scenarios);
+    }
+    if (nbScenarios <= 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "No valid scenario to run");
+        free (scenarios);
+        return 1;
+    }
+
+    if (csv != 0)
+    {
+        printf ("scenario,frames,received,delivered_pct,lat_p50_ms,lat_p95_ms,lat_p99_ms,lat_max_ms,data_loss_pct,ack_loss_pct,send_overhead,freezes,max_freeze_ms\n");
+    }
+    else
+    {
+        printf ("%-20s %11s %7s %8s %8s %8s %8s %8s %8s %6s %5s %6s\n",
+                "scenario", "frames", "deliv", "p50(ms)", "p95(ms)", "p99(ms)", "max(ms)", "dataLoss", "ackLoss", "ovhd", "frz", "maxFrz");
+    }
+
+    for (i = 0; i < nbScenarios; i++)
+    {
+        ARSTREAM_ImpairmentScenarios_Result_t result;
+        if (ARSTREAM_ImpairmentScenarios_Run (&(scenarios [i]), udpPort, &result) == 0)
+        {
+            ARSTREAM_ImpairmentScenarios_PrintResult (&(scenarios [i]), &result, csv);
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Scenario %s failed", scenarios [i].name);
+            nbFailures++;
+        }
+    }
+
+    free (scenarios);
+    return (nbFailures == 0) ? 0 : 1;
+}
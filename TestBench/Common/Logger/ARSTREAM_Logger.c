@@ -32,21 +32,354 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
 #include <time.h>
+#include <pthread.h>
 #include <sys/time.h>
 
 #define ARSTREAM_LOGGER_DEFAULT_NAME "ARStreamLog"
 #define ARSTREAM_LOGGER_DATE_FORMAT  "_%04d%02d%02d_%02d%02d%02d"
+#define ARSTREAM_LOGGER_DATE_STRLEN (80) // Large enough for any int in the fields of ARSTREAM_LOGGER_DATE_FORMAT
 #define ARSTREAM_LOGGER_STRLEN (1024)
 
 #define ENABLE_LOGGER (1)
 
+/*
+ * File layout (host endianness) :
+ *  - header : magic, CLOCK_REALTIME and CLOCK_MONOTONIC times of the creation, in ns (uint64)
+ *  - entries, each starting with a type byte :
+ *    'F' : format definition : id (uint16), isValid (uint8), length (uint16), characters (no null byte)
+ *    'R' : record : format id (uint16), payload size (uint16), CLOCK_MONOTONIC time in ns (uint64), payload
+ *    'D' : dropped records : CLOCK_MONOTONIC time in ns (uint64), number of records (uint64)
+ * Record payloads hold the arguments in order : 8 bytes for integers, doubles and pointers,
+ * a length byte then the characters for strings.
+ */
+#define ARSTREAM_LOGGER_MAGIC "ARSLOG01"
+#define ARSTREAM_LOGGER_MAGIC_SIZE (8)
+
+#define ARSTREAM_LOGGER_RECORD_SIZE (128)
+#define ARSTREAM_LOGGER_RECORD_HEADER_SIZE (24)
+#define ARSTREAM_LOGGER_PAYLOAD_SIZE (ARSTREAM_LOGGER_RECORD_SIZE - ARSTREAM_LOGGER_RECORD_HEADER_SIZE)
+#define ARSTREAM_LOGGER_MAX_ARGS (12)
+#define ARSTREAM_LOGGER_MAX_FORMATS (1024)
+#define ARSTREAM_LOGGER_FORMATS_HASH_SIZE (2 * ARSTREAM_LOGGER_MAX_FORMATS)
+#define ARSTREAM_LOGGER_FILE_BUFFER_SIZE (64 * 1024)
+#define ARSTREAM_LOGGER_IDLE_SLEEP_US (1000)
+#define ARSTREAM_LOGGER_SPEC_SIZE (64)
+
+typedef enum {
+    ARSTREAM_LOGGER_ARG_INT = 0,
+    ARSTREAM_LOGGER_ARG_UINT,
+    ARSTREAM_LOGGER_ARG_DOUBLE,
+    ARSTREAM_LOGGER_ARG_STRING,
+    ARSTREAM_LOGGER_ARG_POINTER,
+} eARSTREAM_LOGGER_ARG;
+
+typedef enum {
+    ARSTREAM_LOGGER_LENGTH_NONE = 0,
+    ARSTREAM_LOGGER_LENGTH_HH,
+    ARSTREAM_LOGGER_LENGTH_H,
+    ARSTREAM_LOGGER_LENGTH_L,
+    ARSTREAM_LOGGER_LENGTH_LL,
+    ARSTREAM_LOGGER_LENGTH_J,
+    ARSTREAM_LOGGER_LENGTH_Z,
+    ARSTREAM_LOGGER_LENGTH_T,
+    ARSTREAM_LOGGER_LENGTH_LONG_DOUBLE,
+} eARSTREAM_LOGGER_LENGTH;
+
+/* A conversion specification of a format */
+typedef struct {
+    const char *start; /* The '%' */
+    size_t prefixSize; /* '%', flags, width and precision */
+    eARSTREAM_LOGGER_LENGTH length;
+    char conversion;
+} ARSTREAM_Logger_Spec_t;
+
+typedef struct {
+    const char *format;
+    int isValid;
+    int nbArgs;
+    uint8_t types [ARSTREAM_LOGGER_MAX_ARGS];
+    uint8_t lengths [ARSTREAM_LOGGER_MAX_ARGS];
+} ARSTREAM_Logger_Format_t;
+
+/* A slot of the ring (bounded MPSC queue : producers claim slots with a CAS, sequence tells who owns the slot) */
+typedef struct {
+    uint64_t sequence;
+    uint64_t timestampNs;
+    uint16_t formatId;
+    uint16_t payloadSize;
+    uint32_t reserved;
+    uint8_t payload [ARSTREAM_LOGGER_PAYLOAD_SIZE];
+} ARSTREAM_Logger_Record_t;
+
 struct ARSTREAM_Logger {
     char filename [ARSTREAM_LOGGER_STRLEN];
-    char date[ARSTREAM_LOGGER_STRLEN];
+    char date[ARSTREAM_LOGGER_DATE_STRLEN];
     FILE *file;
+    char *fileBuffer;
+
+    ARSTREAM_Logger_Record_t *records;
+    uint64_t enqueuePos;
+    uint8_t padding [56]; /* Producers and consumer indexes on different cache lines */
+    uint64_t dequeuePos;
+    uint64_t nbDropped;
+    uint64_t nbDroppedWritten;
+
+    pthread_mutex_t formatsMutex;
+    const char *formatKeys [ARSTREAM_LOGGER_FORMATS_HASH_SIZE];
+    uint16_t formatIds [ARSTREAM_LOGGER_FORMATS_HASH_SIZE];
+    ARSTREAM_Logger_Format_t formats [ARSTREAM_LOGGER_MAX_FORMATS];
+    uint32_t nbFormats;
+    uint32_t nbFormatsWritten;
+
+    pthread_t writerThread;
+    int writerThreadStarted;
+    int writerShouldStop;
 };
 
+static uint64_t ARSTREAM_Logger_GetTimeNs (clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime (clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Finds the next conversion of a format. Returns 1 if found, 0 at the end of the format, -1 if not supported */
+static int ARSTREAM_Logger_NextSpec (const char **cursor, ARSTREAM_Logger_Spec_t *spec)
+{
+    const char *p = *cursor;
+    while (*p != '\0')
+    {
+        if (*p != '%')
+        {
+            p++;
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            p += 2;
+            continue;
+        }
+        spec->start = p++;
+        while ((*p != '\0') && (strchr ("-+ #0'", *p) != NULL)) { p++; }
+        while ((*p >= '0') && (*p <= '9')) { p++; }
+        if (*p == '.')
+        {
+            p++;
+            while ((*p >= '0') && (*p <= '9')) { p++; }
+        }
+        if (*p == '*')
+        {
+            return -1;
+        }
+        spec->prefixSize = p - spec->start;
+        spec->length = ARSTREAM_LOGGER_LENGTH_NONE;
+        switch (*p)
+        {
+        case 'h':
+            p++;
+            spec->length = ARSTREAM_LOGGER_LENGTH_H;
+            if (*p == 'h') { p++; spec->length = ARSTREAM_LOGGER_LENGTH_HH; }
+            break;
+        case 'l':
+            p++;
+            spec->length = ARSTREAM_LOGGER_LENGTH_L;
+            if (*p == 'l') { p++; spec->length = ARSTREAM_LOGGER_LENGTH_LL; }
+            break;
+        case 'j': p++; spec->length = ARSTREAM_LOGGER_LENGTH_J; break;
+        case 'z': p++; spec->length = ARSTREAM_LOGGER_LENGTH_Z; break;
+        case 't': p++; spec->length = ARSTREAM_LOGGER_LENGTH_T; break;
+        case 'L': p++; spec->length = ARSTREAM_LOGGER_LENGTH_LONG_DOUBLE; break;
+        default: break;
+        }
+        if ((*p == '\0') ||
+            (strchr ("diuoxXceEfFgGaAsp", *p) == NULL))
+        {
+            return -1;
+        }
+        spec->conversion = *p++;
+        *cursor = p;
+        return 1;
+    }
+    *cursor = p;
+    return 0;
+}
+
+static eARSTREAM_LOGGER_ARG ARSTREAM_Logger_ArgType (char conversion)
+{
+    switch (conversion)
+    {
+    case 'd': case 'i': case 'c':
+        return ARSTREAM_LOGGER_ARG_INT;
+    case 'u': case 'o': case 'x': case 'X':
+        return ARSTREAM_LOGGER_ARG_UINT;
+    case 's':
+        return ARSTREAM_LOGGER_ARG_STRING;
+    case 'p':
+        return ARSTREAM_LOGGER_ARG_POINTER;
+    default:
+        return ARSTREAM_LOGGER_ARG_DOUBLE;
+    }
+}
+
+static void ARSTREAM_Logger_ParseFormat (const char *format, ARSTREAM_Logger_Format_t *parsed)
+{
+    ARSTREAM_Logger_Spec_t spec;
+    const char *cursor = format;
+    int ret;
+
+    parsed->format = format;
+    parsed->isValid = 1;
+    parsed->nbArgs = 0;
+    while ((ret = ARSTREAM_Logger_NextSpec (&cursor, &spec)) == 1)
+    {
+        if (parsed->nbArgs == ARSTREAM_LOGGER_MAX_ARGS)
+        {
+            ret = -1;
+            break;
+        }
+        parsed->types [parsed->nbArgs] = ARSTREAM_Logger_ArgType (spec.conversion);
+        parsed->lengths [parsed->nbArgs] = spec.length;
+        parsed->nbArgs++;
+    }
+    if (ret < 0)
+    {
+        // Logged as is, without arguments
+        parsed->isValid = 0;
+        parsed->nbArgs = 0;
+    }
+}
+
+/* Returns the id of a format, registering it on first use. Returns -1 if the formats table is full */
+static int ARSTREAM_Logger_GetFormatId (ARSTREAM_Logger_t *logger, const char *format)
+{
+    uint32_t hash = (uint32_t)(((uintptr_t)format >> 3) * 2654435761u);
+    uint32_t index = hash & (ARSTREAM_LOGGER_FORMATS_HASH_SIZE - 1);
+    int retVal = -1;
+    int i;
+
+    /* Lock-free lookup of the known formats */
+    for (i = 0; i < ARSTREAM_LOGGER_FORMATS_HASH_SIZE; i++)
+    {
+        uint32_t slot = (index + i) & (ARSTREAM_LOGGER_FORMATS_HASH_SIZE - 1);
+        const char *key = __atomic_load_n (&(logger->formatKeys [slot]), __ATOMIC_ACQUIRE);
+        if (key == format)
+        {
+            return logger->formatIds [slot];
+        }
+        if (key == NULL)
+        {
+            break;
+        }
+    }
+
+    /* First use : register it */
+    pthread_mutex_lock (&(logger->formatsMutex));
+    for (i = 0; i < ARSTREAM_LOGGER_FORMATS_HASH_SIZE; i++)
+    {
+        uint32_t slot = (index + i) & (ARSTREAM_LOGGER_FORMATS_HASH_SIZE - 1);
+        const char *key = logger->formatKeys [slot];
+        if (key == format)
+        {
+            retVal = logger->formatIds [slot];
+            break;
+        }
+        if (key == NULL)
+        {
+            uint32_t id = logger->nbFormats;
+            if (id < ARSTREAM_LOGGER_MAX_FORMATS)
+            {
+                ARSTREAM_Logger_ParseFormat (format, &(logger->formats [id]));
+                __atomic_store_n (&(logger->nbFormats), id + 1, __ATOMIC_RELEASE);
+                logger->formatIds [slot] = id;
+                __atomic_store_n (&(logger->formatKeys [slot]), format, __ATOMIC_RELEASE);
+                retVal = id;
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock (&(logger->formatsMutex));
+    return retVal;
+}
+
+static void ARSTREAM_Logger_WriteFormats (ARSTREAM_Logger_t *logger)
+{
+    uint32_t nbFormats = __atomic_load_n (&(logger->nbFormats), __ATOMIC_ACQUIRE);
+    while (logger->nbFormatsWritten < nbFormats)
+    {
+        ARSTREAM_Logger_Format_t *format = &(logger->formats [logger->nbFormatsWritten]);
+        uint16_t id = logger->nbFormatsWritten;
+        uint8_t isValid = format->isValid;
+        size_t length = strlen (format->format);
+        uint16_t length16 = (length > UINT16_MAX) ? UINT16_MAX : length;
+        fputc ('F', logger->file);
+        fwrite (&id, sizeof (id), 1, logger->file);
+        fwrite (&isValid, sizeof (isValid), 1, logger->file);
+        fwrite (&length16, sizeof (length16), 1, logger->file);
+        fwrite (format->format, 1, length16, logger->file);
+        logger->nbFormatsWritten++;
+    }
+}
+
+/* Writes the records of the ring to the file, returns the number of records written */
+static int ARSTREAM_Logger_WriteRecords (ARSTREAM_Logger_t *logger)
+{
+    int nbRecords = 0;
+    uint64_t nbDropped;
+    while (1)
+    {
+        ARSTREAM_Logger_Record_t *record = &(logger->records [logger->dequeuePos & (ARSTREAM_LOGGER_NB_RECORDS - 1)]);
+        uint64_t sequence = __atomic_load_n (&(record->sequence), __ATOMIC_ACQUIRE);
+        if (sequence != logger->dequeuePos + 1)
+        {
+            break;
+        }
+        if (record->formatId >= logger->nbFormatsWritten)
+        {
+            ARSTREAM_Logger_WriteFormats (logger);
+        }
+        fputc ('R', logger->file);
+        fwrite (&(record->formatId), sizeof (record->formatId), 1, logger->file);
+        fwrite (&(record->payloadSize), sizeof (record->payloadSize), 1, logger->file);
+        fwrite (&(record->timestampNs), sizeof (record->timestampNs), 1, logger->file);
+        fwrite (record->payload, 1, record->payloadSize, logger->file);
+        __atomic_store_n (&(record->sequence), logger->dequeuePos + ARSTREAM_LOGGER_NB_RECORDS, __ATOMIC_RELEASE);
+        logger->dequeuePos++;
+        nbRecords++;
+    }
+
+    nbDropped = __atomic_load_n (&(logger->nbDropped), __ATOMIC_RELAXED);
+    if (nbDropped != logger->nbDroppedWritten)
+    {
+        uint64_t now = ARSTREAM_Logger_GetTimeNs (CLOCK_MONOTONIC);
+        uint64_t count = nbDropped - logger->nbDroppedWritten;
+        fputc ('D', logger->file);
+        fwrite (&now, sizeof (now), 1, logger->file);
+        fwrite (&count, sizeof (count), 1, logger->file);
+        logger->nbDroppedWritten = nbDropped;
+    }
+    return nbRecords;
+}
+
+static void* ARSTREAM_Logger_WriterThread (void *param)
+{
+    ARSTREAM_Logger_t *logger = (ARSTREAM_Logger_t *)param;
+    while (__atomic_load_n (&(logger->writerShouldStop), __ATOMIC_ACQUIRE) == 0)
+    {
+        if (ARSTREAM_Logger_WriteRecords (logger) == 0)
+        {
+            fflush (logger->file);
+            usleep (ARSTREAM_LOGGER_IDLE_SLEEP_US);
+        }
+    }
+    ARSTREAM_Logger_WriteRecords (logger);
+    fflush (logger->file);
+    return NULL;
+}
+
 ARSTREAM_Logger_t* ARSTREAM_Logger_NewWithDefaultName ()
 {
     return ARSTREAM_Logger_New (ARSTREAM_LOGGER_DEFAULT_NAME, 1);
@@ -56,26 +389,58 @@ ARSTREAM_Logger_t* ARSTREAM_Logger_New (const char *basePath, int useDate)
 {
 #if ENABLE_LOGGER
     ARSTREAM_Logger_t *retLogger = calloc (1, sizeof (ARSTREAM_Logger_t));
+    uint64_t times [2];
+    int i;
     if (retLogger == NULL)
     {
         return retLogger;
     }
+    pthread_mutex_init (&(retLogger->formatsMutex), NULL);
 
     if (useDate == 1)
     {
         struct tm *nowtm;
         time_t now = time (NULL);
         nowtm = localtime (&now);
-        snprintf (retLogger->date, ARSTREAM_LOGGER_STRLEN, ARSTREAM_LOGGER_DATE_FORMAT, nowtm->tm_year+1900, nowtm->tm_mon+1, nowtm->tm_mday, nowtm->tm_hour, nowtm->tm_min, nowtm->tm_sec);
+        snprintf (retLogger->date, ARSTREAM_LOGGER_DATE_STRLEN, ARSTREAM_LOGGER_DATE_FORMAT, nowtm->tm_year+1900, nowtm->tm_mon+1, nowtm->tm_mday, nowtm->tm_hour, nowtm->tm_min, nowtm->tm_sec);
+    }
+    if (snprintf (retLogger->filename, ARSTREAM_LOGGER_STRLEN, "./%s%s.bin", basePath, retLogger->date) >= ARSTREAM_LOGGER_STRLEN)
+    {
+        // Never log into a truncated path
+        ARSTREAM_Logger_Delete (&retLogger);
+        return retLogger;
     }
-    snprintf (retLogger->filename, ARSTREAM_LOGGER_STRLEN, "./%s%s.log", basePath, retLogger->date);
 
     retLogger->file = fopen (retLogger->filename, "w+b");
+    retLogger->fileBuffer = malloc (ARSTREAM_LOGGER_FILE_BUFFER_SIZE);
+    if (posix_memalign ((void **)&(retLogger->records), ARSTREAM_LOGGER_RECORD_SIZE, ARSTREAM_LOGGER_NB_RECORDS * sizeof (ARSTREAM_Logger_Record_t)) != 0)
+    {
+        retLogger->records = NULL;
+    }
+    if ((retLogger->file == NULL) ||
+        (retLogger->fileBuffer == NULL) ||
+        (retLogger->records == NULL))
+    {
+        ARSTREAM_Logger_Delete (&retLogger);
+        return retLogger;
+    }
+    setvbuf (retLogger->file, retLogger->fileBuffer, _IOFBF, ARSTREAM_LOGGER_FILE_BUFFER_SIZE);
+    for (i = 0; i < ARSTREAM_LOGGER_NB_RECORDS; i++)
+    {
+        retLogger->records [i].sequence = i;
+    }
+
+    times [0] = ARSTREAM_Logger_GetTimeNs (CLOCK_REALTIME);
+    times [1] = ARSTREAM_Logger_GetTimeNs (CLOCK_MONOTONIC);
+    fwrite (ARSTREAM_LOGGER_MAGIC, 1, ARSTREAM_LOGGER_MAGIC_SIZE, retLogger->file);
+    fwrite (times, sizeof (times [0]), 2, retLogger->file);
 
-    if (retLogger->file == NULL)
+    if (pthread_create (&(retLogger->writerThread), NULL, ARSTREAM_Logger_WriterThread, retLogger) != 0)
     {
         ARSTREAM_Logger_Delete (&retLogger);
+        return retLogger;
     }
+    retLogger->writerThreadStarted = 1;
 
     return retLogger;
 #else
@@ -87,10 +452,20 @@ void ARSTREAM_Logger_Delete (ARSTREAM_Logger_t **logger)
 {
     if (logger != NULL)
     {
-        if ((*logger != NULL) &&
-            ((*logger)->file != NULL))
+        if (*logger != NULL)
         {
-            fclose ((*logger)->file);
+            if ((*logger)->writerThreadStarted == 1)
+            {
+                __atomic_store_n (&((*logger)->writerShouldStop), 1, __ATOMIC_RELEASE);
+                pthread_join ((*logger)->writerThread, NULL);
+            }
+            if ((*logger)->file != NULL)
+            {
+                fclose ((*logger)->file);
+            }
+            pthread_mutex_destroy (&((*logger)->formatsMutex));
+            free ((*logger)->fileBuffer);
+            free ((*logger)->records);
         }
         free (*logger);
         *logger = NULL;
@@ -99,20 +474,362 @@ void ARSTREAM_Logger_Delete (ARSTREAM_Logger_t **logger)
 
 void ARSTREAM_Logger_Log (ARSTREAM_Logger_t *logger, const char *format, ...)
 {
+    ARSTREAM_Logger_Format_t *parsed;
+    ARSTREAM_Logger_Record_t *record;
+    uint64_t pos;
+    uint16_t size = 0;
+    int formatId;
+    int i;
     va_list ap;
 
     if ((logger == NULL) ||
-        (logger->file == NULL))
+        (logger->records == NULL) ||
+        (format == NULL))
     {
         return;
     }
 
+    formatId = ARSTREAM_Logger_GetFormatId (logger, format);
+    if (formatId < 0)
+    {
+        __atomic_add_fetch (&(logger->nbDropped), 1, __ATOMIC_RELAXED);
+        return;
+    }
+    parsed = &(logger->formats [formatId]);
+
+    /* Claim a slot */
+    pos = __atomic_load_n (&(logger->enqueuePos), __ATOMIC_RELAXED);
+    while (1)
+    {
+        int64_t diff;
+        record = &(logger->records [pos & (ARSTREAM_LOGGER_NB_RECORDS - 1)]);
+        diff = (int64_t)__atomic_load_n (&(record->sequence), __ATOMIC_ACQUIRE) - (int64_t)pos;
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n (&(logger->enqueuePos), &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full : the writer thread is late
+            __atomic_add_fetch (&(logger->nbDropped), 1, __ATOMIC_RELAXED);
+            return;
+        }
+        else
+        {
+            pos = __atomic_load_n (&(logger->enqueuePos), __ATOMIC_RELAXED);
+        }
+    }
+
+    /* Copy the arguments */
     va_start (ap, format);
+    for (i = 0; i < parsed->nbArgs; i++)
+    {
+        int64_t intValue = 0;
+        double doubleValue;
+        switch (parsed->types [i])
+        {
+        case ARSTREAM_LOGGER_ARG_INT:
+        case ARSTREAM_LOGGER_ARG_UINT:
+            switch (parsed->lengths [i])
+            {
+            case ARSTREAM_LOGGER_LENGTH_L: intValue = va_arg (ap, long); break;
+            case ARSTREAM_LOGGER_LENGTH_LL: intValue = va_arg (ap, long long); break;
+            case ARSTREAM_LOGGER_LENGTH_J: intValue = va_arg (ap, intmax_t); break;
+            case ARSTREAM_LOGGER_LENGTH_Z: intValue = va_arg (ap, size_t); break;
+            case ARSTREAM_LOGGER_LENGTH_T: intValue = va_arg (ap, ptrdiff_t); break;
+            default: intValue = va_arg (ap, int); break;
+            }
+            // Apply the truncations printf would apply, the decoder prints 64 bits values
+            if (parsed->types [i] == ARSTREAM_LOGGER_ARG_INT)
+            {
+                if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_HH) { intValue = (signed char)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_H) { intValue = (short)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_NONE) { intValue = (int)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_L) { intValue = (long)intValue; }
+            }
+            else
+            {
+                if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_HH) { intValue = (unsigned char)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_H) { intValue = (unsigned short)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_NONE) { intValue = (unsigned int)intValue; }
+                else if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_L) { intValue = (unsigned long)intValue; }
+            }
+            memcpy (&(record->payload [size]), &intValue, sizeof (intValue));
+            size += sizeof (intValue);
+            break;
+        case ARSTREAM_LOGGER_ARG_POINTER:
+            intValue = (intptr_t)va_arg (ap, void *);
+            memcpy (&(record->payload [size]), &intValue, sizeof (intValue));
+            size += sizeof (intValue);
+            break;
+        case ARSTREAM_LOGGER_ARG_DOUBLE:
+            if (parsed->lengths [i] == ARSTREAM_LOGGER_LENGTH_LONG_DOUBLE)
+            {
+                doubleValue = (double)va_arg (ap, long double);
+            }
+            else
+            {
+                doubleValue = va_arg (ap, double);
+            }
+            memcpy (&(record->payload [size]), &doubleValue, sizeof (doubleValue));
+            size += sizeof (doubleValue);
+            break;
+        case ARSTREAM_LOGGER_ARG_STRING:
+        default:
+        {
+            const char *string = va_arg (ap, const char *);
+            // Keep room for the length bytes of the next strings
+            size_t maxLength = ARSTREAM_LOGGER_PAYLOAD_SIZE - size - 1 - (parsed->nbArgs - i - 1) * sizeof (int64_t);
+            size_t length = 0;
+            if (string == NULL)
+            {
+                string = "(null)";
+            }
+            if (maxLength > ARSTREAM_LOGGER_MAX_STRING_SIZE)
+            {
+                maxLength = ARSTREAM_LOGGER_MAX_STRING_SIZE;
+            }
+            while ((length < maxLength) && (string [length] != '\0'))
+            {
+                length++;
+            }
+            record->payload [size++] = (uint8_t)length;
+            memcpy (&(record->payload [size]), string, length);
+            size += length;
+            break;
+        }
+        }
+    }
+    va_end (ap);
 
-    vfprintf (logger->file, format, ap);
-    fprintf (logger->file, "\n");
+    record->timestampNs = ARSTREAM_Logger_GetTimeNs (CLOCK_MONOTONIC);
+    record->formatId = formatId;
+    record->payloadSize = size;
+    __atomic_store_n (&(record->sequence), pos + 1, __ATOMIC_RELEASE);
+}
 
-    fflush (logger->file);
+uint64_t ARSTREAM_Logger_GetNbDropped (ARSTREAM_Logger_t *logger)
+{
+    if (logger == NULL)
+    {
+        return 0;
+    }
+    return __atomic_load_n (&(logger->nbDropped), __ATOMIC_RELAXED);
+}
 
-    va_end (ap);
+/* Prints the text of a format between two conversions ("%%" becomes '%') */
+static void ARSTREAM_Logger_DecodeText (FILE *out, const char *start, const char *end)
+{
+    while (start < end)
+    {
+        if ((start [0] == '%') &&
+            (start + 1 < end) &&
+            (start [1] == '%'))
+        {
+            start++;
+        }
+        fputc (*start++, out);
+    }
+}
+
+static void ARSTREAM_Logger_DecodeRecord (FILE *out, const char *format, int isValid, const uint8_t *payload, uint16_t payloadSize)
+{
+    ARSTREAM_Logger_Spec_t spec;
+    const char *cursor = format;
+    const char *text = format;
+    uint16_t offset = 0;
+
+    if (isValid == 0)
+    {
+        fputs (format, out);
+        return;
+    }
+
+    while (ARSTREAM_Logger_NextSpec (&cursor, &spec) == 1)
+    {
+        char specString [ARSTREAM_LOGGER_SPEC_SIZE];
+        size_t prefixSize = (spec.prefixSize < ARSTREAM_LOGGER_SPEC_SIZE - 4) ? spec.prefixSize : ARSTREAM_LOGGER_SPEC_SIZE - 4;
+        eARSTREAM_LOGGER_ARG type = ARSTREAM_Logger_ArgType (spec.conversion);
+        size_t needed = (type == ARSTREAM_LOGGER_ARG_STRING) ? 1 : 8;
+
+        ARSTREAM_Logger_DecodeText (out, text, spec.start);
+        text = cursor;
+        if (offset + needed > payloadSize)
+        {
+            fputs ("<truncated>", out);
+            break;
+        }
+
+        memcpy (specString, spec.start, prefixSize);
+        switch (type)
+        {
+        case ARSTREAM_LOGGER_ARG_INT:
+        case ARSTREAM_LOGGER_ARG_UINT:
+        {
+            long long value;
+            memcpy (&value, &(payload [offset]), sizeof (value));
+            offset += sizeof (value);
+            if (spec.conversion == 'c')
+            {
+                snprintf (&(specString [prefixSize]), 2, "%c", 'c');
+                fprintf (out, specString, (int)value);
+            }
+            else
+            {
+                snprintf (&(specString [prefixSize]), 4, "ll%c", spec.conversion);
+                fprintf (out, specString, value);
+            }
+            break;
+        }
+        case ARSTREAM_LOGGER_ARG_POINTER:
+        {
+            long long value;
+            memcpy (&value, &(payload [offset]), sizeof (value));
+            offset += sizeof (value);
+            snprintf (&(specString [prefixSize]), 2, "%c", 'p');
+            fprintf (out, specString, (void *)(intptr_t)value);
+            break;
+        }
+        case ARSTREAM_LOGGER_ARG_DOUBLE:
+        {
+            double value;
+            memcpy (&value, &(payload [offset]), sizeof (value));
+            offset += sizeof (value);
+            snprintf (&(specString [prefixSize]), 2, "%c", spec.conversion);
+            fprintf (out, specString, value);
+            break;
+        }
+        case ARSTREAM_LOGGER_ARG_STRING:
+        default:
+        {
+            char string [ARSTREAM_LOGGER_PAYLOAD_SIZE + 1];
+            uint8_t length = payload [offset++];
+            if (offset + length > payloadSize)
+            {
+                length = payloadSize - offset;
+            }
+            memcpy (string, &(payload [offset]), length);
+            string [length] = '\0';
+            offset += length;
+            snprintf (&(specString [prefixSize]), 2, "%c", 's');
+            fprintf (out, specString, string);
+            break;
+        }
+        }
+    }
+    ARSTREAM_Logger_DecodeText (out, text, text + strlen (text));
+}
+
+int ARSTREAM_Logger_Decode (FILE *in, FILE *out)
+{
+    char magic [ARSTREAM_LOGGER_MAGIC_SIZE];
+    uint64_t times [2];
+    char *formats [ARSTREAM_LOGGER_MAX_FORMATS] = { NULL };
+    uint8_t formatsValid [ARSTREAM_LOGGER_MAX_FORMATS] = { 0 };
+    uint8_t payload [ARSTREAM_LOGGER_PAYLOAD_SIZE];
+    int nbRecords = 0;
+    int type;
+    int i;
+
+    if ((in == NULL) ||
+        (out == NULL) ||
+        (fread (magic, 1, ARSTREAM_LOGGER_MAGIC_SIZE, in) != ARSTREAM_LOGGER_MAGIC_SIZE) ||
+        (memcmp (magic, ARSTREAM_LOGGER_MAGIC, ARSTREAM_LOGGER_MAGIC_SIZE) != 0) ||
+        (fread (times, sizeof (times [0]), 2, in) != 2))
+    {
+        return -1;
+    }
+
+    while ((type = fgetc (in)) != EOF)
+    {
+        int isTruncated = 0;
+        if (type == 'F')
+        {
+            uint16_t id, length;
+            uint8_t isValid;
+            if ((fread (&id, sizeof (id), 1, in) != 1) ||
+                (fread (&isValid, sizeof (isValid), 1, in) != 1) ||
+                (fread (&length, sizeof (length), 1, in) != 1) ||
+                (id >= ARSTREAM_LOGGER_MAX_FORMATS))
+            {
+                isTruncated = 1;
+            }
+            else
+            {
+                free (formats [id]);
+                formats [id] = malloc (length + 1);
+                if ((formats [id] == NULL) ||
+                    (fread (formats [id], 1, length, in) != length))
+                {
+                    isTruncated = 1;
+                }
+                else
+                {
+                    formats [id][length] = '\0';
+                    formatsValid [id] = isValid;
+                }
+            }
+        }
+        else if (type == 'R')
+        {
+            uint16_t id, size;
+            uint64_t timestampNs;
+            if ((fread (&id, sizeof (id), 1, in) != 1) ||
+                (fread (&size, sizeof (size), 1, in) != 1) ||
+                (fread (&timestampNs, sizeof (timestampNs), 1, in) != 1) ||
+                (size > ARSTREAM_LOGGER_PAYLOAD_SIZE) ||
+                (fread (payload, 1, size, in) != size))
+            {
+                isTruncated = 1;
+            }
+            else
+            {
+                uint64_t relativeUs = (timestampNs - times [1]) / 1000;
+                fprintf (out, "[%6llu.%06llu] ", (unsigned long long)(relativeUs / 1000000), (unsigned long long)(relativeUs % 1000000));
+                if ((id < ARSTREAM_LOGGER_MAX_FORMATS) &&
+                    (formats [id] != NULL))
+                {
+                    ARSTREAM_Logger_DecodeRecord (out, formats [id], formatsValid [id], payload, size);
+                }
+                else
+                {
+                    fprintf (out, "<unknown format %u>", id);
+                }
+                fputc ('\n', out);
+                nbRecords++;
+            }
+        }
+        else if (type == 'D')
+        {
+            uint64_t values [2];
+            if (fread (values, sizeof (values [0]), 2, in) != 2)
+            {
+                isTruncated = 1;
+            }
+            else
+            {
+                uint64_t relativeUs = (values [0] - times [1]) / 1000;
+                fprintf (out, "[%6llu.%06llu] <%llu records dropped>\n", (unsigned long long)(relativeUs / 1000000), (unsigned long long)(relativeUs % 1000000), (unsigned long long)values [1]);
+            }
+        }
+        else
+        {
+            fprintf (out, "<corrupted file : unknown entry type 0x%02x>\n", type);
+            break;
+        }
+        if (isTruncated != 0)
+        {
+            fprintf (out, "<truncated file>\n");
+            break;
+        }
+    }
+
+    for (i = 0; i < ARSTREAM_LOGGER_MAX_FORMATS; i++)
+    {
+        free (formats [i]);
+    }
+    return nbRecords;
 }
@@ -31,6 +31,27 @@
 #ifndef _ARSTREAM_LOGGER_H_
 #define _ARSTREAM_LOGGER_H_
 
+#include <inttypes.h>
+#include <stdio.h>
+
+/*
+ * Asynchronous binary logger
+ *
+ * ARSTREAM_Logger_Log does not format anything : it copies the arguments (as described by the
+ * printf-like format, parsed once per format string) and a timestamp into a lock-free ring.
+ * A background thread writes the records to a compact binary file, and ARSTREAM_Logger_Decode
+ * (or the LoggerDecoder testbench) turns the file back into text.
+ *
+ * Format strings must stay valid while the logger exists (string literals are fine).
+ * Supported conversions : d i u o x X c (any length modifier), e E f F g G a A, s (copied, up to
+ * ARSTREAM_LOGGER_MAX_STRING_SIZE characters), p and %%. A format with %n or with too many arguments
+ * is logged as is, without its arguments.
+ * Records are dropped (and counted) if the ring is full : Log never blocks.
+ */
+
+#define ARSTREAM_LOGGER_NB_RECORDS (8192)
+#define ARSTREAM_LOGGER_MAX_STRING_SIZE (40)
+
 typedef struct ARSTREAM_Logger ARSTREAM_Logger_t;
 
 ARSTREAM_Logger_t* ARSTREAM_Logger_NewWithDefaultName ();
@@ -38,6 +59,22 @@ ARSTREAM_Logger_t* ARSTREAM_Logger_New (const char *basePath, int useDate);
 
 void ARSTREAM_Logger_Log (ARSTREAM_Logger_t *logger, const char *format, ...);
 
+/**
+ * @brief Gets the number of records dropped because the ring was full
+ */
+uint64_t ARSTREAM_Logger_GetNbDropped (ARSTREAM_Logger_t *logger);
+
+/**
+ * @brief Writes the remaining records, and closes the file
+ */
 void ARSTREAM_Logger_Delete (ARSTREAM_Logger_t **logger);
 
+/**
+ * @brief Decodes a binary log file as text, one line per record : "[seconds.microseconds] message"
+ * @param in The binary log file
+ * @param out Where to write the text
+ * @return The number of decoded records, or -1 if the file is not a log file
+ */
+int ARSTREAM_Logger_Decode (FILE *in, FILE *out);
+
 #endif /* _ARSTREAM_LOGGER_H_ */
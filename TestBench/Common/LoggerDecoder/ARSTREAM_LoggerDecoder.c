@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_LoggerDecoder.c
+ * @brief Decodes the binary files written by ARSTREAM_Logger
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+
+/*
+ * Private Headers
+ */
+
+#include "../../Common/Logger/ARSTREAM_Logger.h"
+#include "ARSTREAM_LoggerDecoder.h"
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_LoggerDecoder_Main (int argc, char *argv[])
+{
+    FILE *in = NULL;
+    FILE *out = stdout;
+    int nbRecords;
+
+    if ((argc < 2) ||
+        (argc > 3))
+    {
+        printf ("Usage: %s logFile.bin [output.log]\n", argv[0]);
+        return 1;
+    }
+
+    in = fopen (argv[1], "rb");
+    if (in == NULL)
+    {
+        fprintf (stderr, "Unable to open %s\n", argv[1]);
+        return 1;
+    }
+    if (argc == 3)
+    {
+        out = fopen (argv[2], "w");
+        if (out == NULL)
+        {
+            fprintf (stderr, "Unable to open %s\n", argv[2]);
+            fclose (in);
+            return 1;
+        }
+    }
+
+    nbRecords = ARSTREAM_Logger_Decode (in, out);
+    if (nbRecords < 0)
+    {
+        fprintf (stderr, "%s is not an ARSTREAM_Logger file\n", argv[1]);
+    }
+    else
+    {
+        fprintf (stderr, "%d records decoded\n", nbRecords);
+    }
+
+    fclose (in);
+    if (out != stdout)
+    {
+        fclose (out);
+    }
+    return (nbRecords < 0) ? 1 : 0;
+}
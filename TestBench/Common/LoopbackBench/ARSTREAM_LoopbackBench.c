@@ -0,0 +1,1015 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_LoopbackBench.c
+ * @brief Measures the costs of the library (fragmentation, acks, filters, callbacks) and the frame latency
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "../FrameGenerator/ARSTREAM_FrameGenerator.h"
+#include "ARSTREAM_LoopbackBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_LoopbackBench"
+
+#define DEFAULT_NB_FRAMES (2000)
+#define DEFAULT_FRAME_SIZE (50000)
+#define DEFAULT_FRAG_SIZE (1400)
+#define MAX_NB_FRAG (128)
+#define MAX_SWEEP_VALUES (16)
+#define MAX_FILTERS (4)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define FILTER_NB_BUFFERS (16)
+#define FRAME_TIMEOUT_MS (1000)
+#define DRAIN_TIME_MS (500)
+#define HEADER_SIZE (4)
+#define TAG_SIZE (64)
+#define TRACE_RING_SIZE (1 << 18)
+#define CIPHER_KEY_BYTE (0x5a)
+#define CIPHER_KAT_SIZE (114)
+#define CIPHER_KAT_NONCE_SIZE (12)
+#define CIPHER_KAT_COUNTER (1)
+#define CIPHER_KAT_BLOCK_SIZE (64)
+/**
+ * @brief Size of the multi-block known answer test : 4 blocks for the vector path, then 1 full block and a partial one for the tail path
+ */
+#define CIPHER_KAT_LONG_SIZE (5 * CIPHER_KAT_BLOCK_SIZE + 37)
+
+/**
+ * GOP distribution : encoder-like sizes from an ARSTREAM_FrameGenerator_t, with an I-frame GOP_I_FRAME_RATIO
+ * times larger than the P-frames every GOP_LENGTH frames, and a mean frame size equal to the requested one.
+ * The generator takes a bitrate in kbit/s : at GOP_GENERATOR_FPS, it is exactly 8 times the mean frame size.
+ */
+#define GOP_LENGTH (30)
+#define GOP_I_FRAME_RATIO (5)
+#define GOP_GENERATOR_FPS (1000)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Distribution of the frame sizes
+ */
+typedef enum {
+    ARSTREAM_LOOPBACKBENCH_DIST_FIXED = 0, /**< All frames have the same size */
+    ARSTREAM_LOOPBACKBENCH_DIST_UNIFORM, /**< Uniform in [size/2, 3*size/2] */
+    ARSTREAM_LOOPBACKBENCH_DIST_GOP, /**< Large I-frames and smaller P-frames */
+    ARSTREAM_LOOPBACKBENCH_DIST_MAX,
+} eARSTREAM_LOOPBACKBENCH_DIST;
+
+/**
+ * @brief Output format of the results
+ */
+typedef enum {
+    ARSTREAM_LOOPBACKBENCH_OUTPUT_TEXT = 0,
+    ARSTREAM_LOOPBACKBENCH_OUTPUT_CSV,
+    ARSTREAM_LOOPBACKBENCH_OUTPUT_JSON,
+} eARSTREAM_LOOPBACKBENCH_OUTPUT;
+
+/**
+ * @brief Pass-through filter, to measure the cost of a filter stage
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    uint8_t *buffers [FILTER_NB_BUFFERS];
+    int inUse [FILTER_NB_BUFFERS];
+    int bufferSize;
+} ARSTREAM_LoopbackBench_CopyFilter_t;
+
+/**
+ * @brief Parameters of one run
+ */
+typedef struct {
+    int nbFrames;
+    eARSTREAM_LOOPBACKBENCH_DIST dist;
+    int frameSize; /**< Mean frame size */
+    int fragSize;
+    int fps; /**< 0 for a closed loop (next frame sent when the previous one was received) */
+    int nbFilters; /**< Number of copy filters on each side */
+    int encrypt; /**< Adds an ARSTREAM_CipherFilter_t at the end of the sender chain, and at the start of the reader chain */
+    double lossPercent; /**< Loss rate of each direction */
+    int udpPort; /**< 0 for the in-process loopback */
+} ARSTREAM_LoopbackBench_Params_t;
+
+/**
+ * @brief Results of one run
+ */
+typedef struct {
+    int nbReceived;
+    int nbTimeouts;
+    uint64_t nbBytesSent;
+    uint64_t nbBytesReceived;
+    uint64_t wallNs;
+    uint64_t cpuNs;
+    uint32_t latencyP50Us;
+    uint32_t latencyP99Us;
+    uint32_t latencyP999Us;
+    uint32_t latencyMaxUs;
+    int hasLoopbackStats;
+    ARSTREAM_Loopback_Stats_t dataStats;
+    ARSTREAM_Loopback_Stats_t ackStats;
+} ARSTREAM_LoopbackBench_Result_t;
+
+/*
+ * Globals
+ */
+
+static const char *g_DistNames [ARSTREAM_LOOPBACKBENCH_DIST_MAX] = { "fixed", "uniform", "gop" };
+
+/* ChaCha20 encryption test vector of RFC 8439, section 2.4.2 */
+static const uint8_t g_CipherKatNonce [CIPHER_KAT_NONCE_SIZE] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00,
+};
+static const char g_CipherKatPlaintext [CIPHER_KAT_SIZE + 1] =
+    "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+static const uint8_t g_CipherKatCiphertext [CIPHER_KAT_SIZE] = {
+    0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+    0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2, 0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+    0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+    0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+    0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61, 0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+    0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+    0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+    0x87, 0x4d,
+};
+
+static pthread_mutex_t g_FrameMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_FrameCond = PTHREAD_COND_INITIALIZER;
+static int g_NbFrames = 0;
+static int g_NbFramesReceived = 0;
+static uint64_t g_NbBytesReceived = 0;
+static uint64_t *g_SendTimesNs = NULL;
+static uint32_t *g_LatenciesUs = NULL;
+static uint8_t *g_RecvBuffer = NULL;
+static uint32_t g_RecvBufferSize = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_LoopbackBench_GetClockNs (clockid_t clock);
+static uint8_t* ARSTREAM_LoopbackBench_FilterGetBuffer (void *context, int size);
+static int ARSTREAM_LoopbackBench_FilterGetOutputSize (void *context, int inputSize);
+static int ARSTREAM_LoopbackBench_FilterBuffer (void *context, uint8_t *input, int inSize, uint8_t *output, int outSize);
+static void ARSTREAM_LoopbackBench_FilterReleaseBuffer (void *context, uint8_t *buffer);
+static void ARSTREAM_LoopbackBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_LoopbackBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static ARSTREAM_FrameGenerator_t* ARSTREAM_LoopbackBench_NewGenerator (ARSTREAM_LoopbackBench_Params_t *params);
+static int ARSTREAM_LoopbackBench_MaxFrameSize (ARSTREAM_LoopbackBench_Params_t *params);
+static int ARSTREAM_LoopbackBench_NextFrameSize (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_FrameGenerator_t *generator, unsigned int *seed);
+static int ARSTREAM_LoopbackBench_CompareU32 (const void *a, const void *b);
+static int ARSTREAM_LoopbackBench_CipherKnownAnswerTest (void);
+static int ARSTREAM_LoopbackBench_Run (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_LoopbackBench_Result_t *result);
+static void ARSTREAM_LoopbackBench_PrintResult (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_LoopbackBench_Result_t *result, eARSTREAM_LOOPBACKBENCH_OUTPUT output, const char *tag);
+static int ARSTREAM_LoopbackBench_ParseIntList (const char *arg, int *values, int minValue);
+static int ARSTREAM_LoopbackBench_ParseDoubleList (const char *arg, double *values);
+static int ARSTREAM_LoopbackBench_ParseDistList (const char *arg, int *values);
+static void ARSTREAM_LoopbackBench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_LoopbackBench_GetClockNs (clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime (clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint8_t* ARSTREAM_LoopbackBench_FilterGetBuffer (void *context, int size)
+{
+    ARSTREAM_LoopbackBench_CopyFilter_t *filter = (ARSTREAM_LoopbackBench_CopyFilter_t *)context;
+    uint8_t *retBuffer = NULL;
+    int i;
+    if (size > filter->bufferSize)
+    {
+        return NULL;
+    }
+    pthread_mutex_lock (&(filter->mutex));
+    for (i = 0; i < FILTER_NB_BUFFERS; i++)
+    {
+        if (filter->inUse [i] == 0)
+        {
+            filter->inUse [i] = 1;
+            retBuffer = filter->buffers [i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&(filter->mutex));
+    if (retBuffer == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Filter pool exhausted");
+    }
+    return retBuffer;
+}
+
+static int ARSTREAM_LoopbackBench_FilterGetOutputSize (void *context, int inputSize)
+{
+    (void)context;
+    return inputSize;
+}
+
+static int ARSTREAM_LoopbackBench_FilterBuffer (void *context, uint8_t *input, int inSize, uint8_t *output, int outSize)
+{
+    int size = (inSize < outSize) ? inSize : outSize;
+    (void)context;
+    memcpy (output, input, size);
+    return size;
+}
+
+static void ARSTREAM_LoopbackBench_FilterReleaseBuffer (void *context, uint8_t *buffer)
+{
+    ARSTREAM_LoopbackBench_CopyFilter_t *filter = (ARSTREAM_LoopbackBench_CopyFilter_t *)context;
+    int i;
+    pthread_mutex_lock (&(filter->mutex));
+    for (i = 0; i < FILTER_NB_BUFFERS; i++)
+    {
+        if (filter->buffers [i] == buffer)
+        {
+            filter->inUse [i] = 0;
+        }
+    }
+    pthread_mutex_unlock (&(filter->mutex));
+}
+
+static void ARSTREAM_LoopbackBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_LoopbackBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)numberOfSkippedFrames;
+    (void)isFlushFrame;
+    (void)custom;
+    if ((cause == ARSTREAM_READER_CAUSE_FRAME_COMPLETE) &&
+        (frameSize >= HEADER_SIZE))
+    {
+        uint64_t nowNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC);
+        uint32_t index;
+        memcpy (&index, framePointer, HEADER_SIZE);
+
+        pthread_mutex_lock (&g_FrameMutex);
+        if ((index < (uint32_t)g_NbFrames) &&
+            (g_NbFramesReceived < g_NbFrames))
+        {
+            g_LatenciesUs [g_NbFramesReceived++] = (uint32_t)((nowNs - g_SendTimesNs [index]) / 1000);
+            g_NbBytesReceived += frameSize;
+        }
+        pthread_cond_signal (&g_FrameCond);
+        pthread_mutex_unlock (&g_FrameMutex);
+    }
+    *newBufferCapacity = g_RecvBufferSize;
+    return g_RecvBuffer;
+}
+
+static ARSTREAM_FrameGenerator_t* ARSTREAM_LoopbackBench_NewGenerator (ARSTREAM_LoopbackBench_Params_t *params)
+{
+    ARSTREAM_FrameGenerator_Config_t config;
+    if (params->dist != ARSTREAM_LOOPBACKBENCH_DIST_GOP)
+    {
+        return NULL;
+    }
+    ARSTREAM_FrameGenerator_DefaultConfig (&config);
+    config.bitrateKbps = params->frameSize * 8;
+    config.fps = GOP_GENERATOR_FPS;
+    config.gopLength = GOP_LENGTH;
+    config.iWeight = GOP_I_FRAME_RATIO;
+    // Like an encoder configured for the stream, never produce frames which do not fit in it
+    config.maxFrameSize = params->fragSize * MAX_NB_FRAG - ((params->encrypt != 0) ? ARSTREAM_CIPHER_FILTER_NONCE_SIZE : 0);
+    return ARSTREAM_FrameGenerator_New (&config);
+}
+
+static int ARSTREAM_LoopbackBench_MaxFrameSize (ARSTREAM_LoopbackBench_Params_t *params)
+{
+    ARSTREAM_FrameGenerator_t *generator;
+    int maxFrameSize;
+    switch (params->dist)
+    {
+    case ARSTREAM_LOOPBACKBENCH_DIST_UNIFORM:
+        return params->frameSize + params->frameSize / 2;
+    case ARSTREAM_LOOPBACKBENCH_DIST_GOP:
+        generator = ARSTREAM_LoopbackBench_NewGenerator (params);
+        maxFrameSize = (int)ARSTREAM_FrameGenerator_GetMaxFrameSize (generator);
+        ARSTREAM_FrameGenerator_Delete (&generator);
+        return maxFrameSize;
+    default:
+        return params->frameSize;
+    }
+}
+
+static int ARSTREAM_LoopbackBench_NextFrameSize (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_FrameGenerator_t *generator, unsigned int *seed)
+{
+    ARSTREAM_FrameGenerator_Frame_t frame;
+    int size;
+    switch (params->dist)
+    {
+    case ARSTREAM_LOOPBACKBENCH_DIST_UNIFORM:
+        size = params->frameSize / 2 + (int)(rand_r (seed) % (params->frameSize + 1));
+        break;
+    case ARSTREAM_LOOPBACKBENCH_DIST_GOP:
+        ARSTREAM_FrameGenerator_Next (generator, &frame);
+        size = (int)frame.size;
+        break;
+    default:
+        size = params->frameSize;
+        break;
+    }
+    return (size < HEADER_SIZE) ? HEADER_SIZE : size;
+}
+
+static int ARSTREAM_LoopbackBench_CompareU32 (const void *a, const void *b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Checks ARSTREAM_CipherFilter_ChaCha20 against the RFC 8439 test vector
+ * The vector is checked alone (single block code only), then at the start of a longer buffer
+ * which also goes through the 4-blocks vector code, and each block of that buffer is
+ * compared to the same block encrypted alone.
+ * @return The number of errors
+ */
+static int ARSTREAM_LoopbackBench_CipherKnownAnswerTest (void)
+{
+    uint8_t key [ARSTREAM_CIPHER_FILTER_KEY_SIZE];
+    uint8_t output [CIPHER_KAT_LONG_SIZE];
+    uint8_t longInput [CIPHER_KAT_LONG_SIZE];
+    uint8_t longOutput [CIPHER_KAT_LONG_SIZE];
+    int nbErrors = 0;
+    int i;
+
+    for (i = 0; i < ARSTREAM_CIPHER_FILTER_KEY_SIZE; i++)
+    {
+        key [i] = i;
+    }
+    memcpy (longInput, g_CipherKatPlaintext, CIPHER_KAT_SIZE);
+    for (i = CIPHER_KAT_SIZE; i < CIPHER_KAT_LONG_SIZE; i++)
+    {
+        longInput [i] = (uint8_t)(i * 7);
+    }
+
+    ARSTREAM_CipherFilter_ChaCha20 (key, g_CipherKatNonce, CIPHER_KAT_COUNTER, longInput, output, CIPHER_KAT_SIZE);
+    if (memcmp (output, g_CipherKatCiphertext, CIPHER_KAT_SIZE) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "ChaCha20 of the %d bytes test vector does not match RFC 8439", CIPHER_KAT_SIZE);
+        nbErrors++;
+    }
+
+    ARSTREAM_CipherFilter_ChaCha20 (key, g_CipherKatNonce, CIPHER_KAT_COUNTER, longInput, longOutput, CIPHER_KAT_LONG_SIZE);
+    if (memcmp (longOutput, g_CipherKatCiphertext, CIPHER_KAT_SIZE) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "ChaCha20 of the test vector in a %d bytes buffer does not match RFC 8439", CIPHER_KAT_LONG_SIZE);
+        nbErrors++;
+    }
+    for (i = 0; i < CIPHER_KAT_LONG_SIZE; i += CIPHER_KAT_BLOCK_SIZE)
+    {
+        int blockSize = (CIPHER_KAT_LONG_SIZE - i < CIPHER_KAT_BLOCK_SIZE) ? CIPHER_KAT_LONG_SIZE - i : CIPHER_KAT_BLOCK_SIZE;
+        ARSTREAM_CipherFilter_ChaCha20 (key, g_CipherKatNonce, CIPHER_KAT_COUNTER + i / CIPHER_KAT_BLOCK_SIZE, &longInput [i], output, blockSize);
+        if (memcmp (output, &longOutput [i], blockSize) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "ChaCha20 block at offset %d differs when encrypted alone", i);
+            nbErrors++;
+        }
+    }
+
+    /* Decrypt in place, as the reader filter may */
+    ARSTREAM_CipherFilter_ChaCha20 (key, g_CipherKatNonce, CIPHER_KAT_COUNTER, longOutput, longOutput, CIPHER_KAT_LONG_SIZE);
+    if (memcmp (longOutput, longInput, CIPHER_KAT_LONG_SIZE) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "ChaCha20 decryption in place does not give back the %d bytes input", CIPHER_KAT_LONG_SIZE);
+        nbErrors++;
+    }
+
+    printf ("ChaCha20 known answer test (%s implementation) : %s\n", ARSTREAM_CipherFilter_GetImplementation (), (nbErrors == 0) ? "PASSED" : "FAILED");
+    return nbErrors;
+}
+
+static int ARSTREAM_LoopbackBench_Run (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_LoopbackBench_Result_t *result)
+{
+    ARSTREAM_LoopbackBench_CopyFilter_t copyFilters [2 * MAX_FILTERS];
+    ARSTREAM_Filter_t filters [2 * MAX_FILTERS];
+    ARSTREAM_CipherFilter_t *encryptFilter = NULL;
+    ARSTREAM_CipherFilter_t *decryptFilter = NULL;
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    ARSTREAM_Impairment_Config_t dataImpairment, ackImpairment;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    int maxFrameSize = ARSTREAM_LoopbackBench_MaxFrameSize (params);
+    uint64_t wallStartNs, cpuStartNs, periodNs = 0;
+    ARSTREAM_FrameGenerator_t *generator = NULL;
+    unsigned int sizeSeed = 1;
+    int retVal = 0;
+    int i, j;
+
+    memset (result, 0, sizeof (ARSTREAM_LoopbackBench_Result_t));
+    memset (sendBuffers, 0, sizeof (sendBuffers));
+    memset (copyFilters, 0, sizeof (copyFilters));
+
+    /* Buffers */
+    g_NbFrames = params->nbFrames;
+    g_NbFramesReceived = 0;
+    g_NbBytesReceived = 0;
+    g_SendTimesNs = calloc (params->nbFrames, sizeof (uint64_t));
+    g_LatenciesUs = calloc (params->nbFrames, sizeof (uint32_t));
+    g_RecvBufferSize = maxFrameSize;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    if ((g_SendTimesNs == NULL) ||
+        (g_LatenciesUs == NULL) ||
+        (g_RecvBuffer == NULL))
+    {
+        retVal = -1;
+    }
+    generator = ARSTREAM_LoopbackBench_NewGenerator (params);
+    if ((params->dist == ARSTREAM_LOOPBACKBENCH_DIST_GOP) &&
+        (generator == NULL))
+    {
+        retVal = -1;
+    }
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (maxFrameSize);
+        if (sendBuffers [i] == NULL)
+        {
+            retVal = -1;
+            continue;
+        }
+        for (j = HEADER_SIZE; j < maxFrameSize; j++)
+        {
+            sendBuffers [i][j] = (uint8_t)(i + j);
+        }
+    }
+    for (i = 0; i < 2 * params->nbFilters; i++)
+    {
+        pthread_mutex_init (&(copyFilters [i].mutex), NULL);
+        copyFilters [i].bufferSize = maxFrameSize;
+        for (j = 0; j < FILTER_NB_BUFFERS; j++)
+        {
+            copyFilters [i].buffers [j] = malloc (maxFrameSize);
+            if (copyFilters [i].buffers [j] == NULL)
+            {
+                retVal = -1;
+            }
+        }
+        filters [i].getBuffer = ARSTREAM_LoopbackBench_FilterGetBuffer;
+        filters [i].getOutputSize = ARSTREAM_LoopbackBench_FilterGetOutputSize;
+        filters [i].filterBuffer = ARSTREAM_LoopbackBench_FilterBuffer;
+        filters [i].releaseBuffer = ARSTREAM_LoopbackBench_FilterReleaseBuffer;
+        filters [i].context = &(copyFilters [i]);
+    }
+    if ((retVal == 0) &&
+        (params->encrypt != 0))
+    {
+        uint8_t key [ARSTREAM_CIPHER_FILTER_KEY_SIZE];
+        memset (key, CIPHER_KEY_BYTE, sizeof (key));
+        encryptFilter = ARSTREAM_CipherFilter_New (key, ARSTREAM_CIPHER_FILTER_MODE_ENCRYPT, &err);
+        decryptFilter = ARSTREAM_CipherFilter_New (key, ARSTREAM_CIPHER_FILTER_MODE_DECRYPT, &err);
+        if ((encryptFilter == NULL) ||
+            (decryptFilter == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the cipher filters : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+
+    /* Library objects */
+    if (retVal == 0)
+    {
+        if (params->udpPort > 0)
+        {
+            sender = ARSTREAM_Sender_NewUDP ("127.0.0.1", params->udpPort, ARSTREAM_LoopbackBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, params->fragSize, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewUDP ("127.0.0.1", params->udpPort, ARSTREAM_LoopbackBench_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, params->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+        }
+        else
+        {
+            loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, params->fragSize, &err);
+            if (loopback != NULL)
+            {
+                sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_LoopbackBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, params->fragSize, MAX_NB_FRAG, NULL, &err);
+                reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_LoopbackBench_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, params->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+            }
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+    if (retVal == 0)
+    {
+        if (decryptFilter != NULL)
+        {
+            ARSTREAM_Reader_AddFilter (reader, ARSTREAM_CipherFilter_GetFilter (decryptFilter));
+        }
+        for (i = 0; i < params->nbFilters; i++)
+        {
+            ARSTREAM_Sender_AddFilter (sender, &(filters [i]));
+            ARSTREAM_Reader_AddFilter (reader, &(filters [params->nbFilters + i]));
+        }
+        if (encryptFilter != NULL)
+        {
+            ARSTREAM_Sender_AddFilter (sender, ARSTREAM_CipherFilter_GetFilter (encryptFilter));
+        }
+        if (params->lossPercent > 0.)
+        {
+            // Fixed seeds : the same run on two commits sees the same losses
+            ARSTREAM_Impairment_DefaultConfig (&dataImpairment);
+            ARSTREAM_Impairment_DefaultConfig (&ackImpairment);
+            dataImpairment.lossPercent = (float)params->lossPercent;
+            ackImpairment.lossPercent = (float)params->lossPercent;
+            ackImpairment.seed = 2;
+            ARSTREAM_Sender_SetImpairment (sender, &dataImpairment);
+            ARSTREAM_Reader_SetImpairment (reader, &ackImpairment);
+        }
+        // Retry as soon as the acks say so : localhost has almost no latency
+        ARSTREAM_Sender_SetTimeBetweenRetries (sender, 1, FRAME_TIMEOUT_MS);
+
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        if (params->fps > 0)
+        {
+            periodNs = 1000000000ULL / params->fps;
+        }
+        wallStartNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC);
+        cpuStartNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_PROCESS_CPUTIME_ID);
+        for (i = 0; i < params->nbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            int frameSize = ARSTREAM_LoopbackBench_NextFrameSize (params, generator, &sizeSeed);
+            uint32_t index = i;
+            int target = 0;
+
+            if (periodNs > 0)
+            {
+                /* Open loop : one frame per period */
+                uint64_t targetNs = wallStartNs + i * periodNs;
+                uint64_t nowNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC);
+                if (targetNs > nowNs)
+                {
+                    struct timespec wait = { (time_t)((targetNs - nowNs) / 1000000000ULL), (long)((targetNs - nowNs) % 1000000000ULL) };
+                    nanosleep (&wait, NULL);
+                }
+            }
+
+            memcpy (frame, &index, HEADER_SIZE);
+            pthread_mutex_lock (&g_FrameMutex);
+            target = g_NbFramesReceived + 1;
+            g_SendTimesNs [i] = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC);
+            pthread_mutex_unlock (&g_FrameMutex);
+            ARSTREAM_Sender_SendNewFrame (sender, frame, frameSize, 0, NULL);
+            result->nbBytesSent += frameSize;
+
+            if (periodNs == 0)
+            {
+                /* Closed loop : wait for the frame to be received */
+                struct timespec deadline;
+                clock_gettime (CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += FRAME_TIMEOUT_MS / 1000;
+                pthread_mutex_lock (&g_FrameMutex);
+                while (g_NbFramesReceived < target)
+                {
+                    if (pthread_cond_timedwait (&g_FrameCond, &g_FrameMutex, &deadline) != 0)
+                    {
+                        result->nbTimeouts++;
+                        break;
+                    }
+                }
+                pthread_mutex_unlock (&g_FrameMutex);
+            }
+        }
+        if (periodNs > 0)
+        {
+            /* Wait for the last frames, without counting the idle time */
+            uint64_t drainEndNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC) + DRAIN_TIME_MS * 1000000ULL;
+            while (ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC) < drainEndNs)
+            {
+                int nbReceived;
+                pthread_mutex_lock (&g_FrameMutex);
+                nbReceived = g_NbFramesReceived;
+                pthread_mutex_unlock (&g_FrameMutex);
+                if (nbReceived >= params->nbFrames)
+                {
+                    break;
+                }
+                usleep (1000);
+            }
+        }
+        result->wallNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_MONOTONIC) - wallStartNs;
+        result->cpuNs = ARSTREAM_LoopbackBench_GetClockNs (CLOCK_PROCESS_CPUTIME_ID) - cpuStartNs;
+
+        if (loopback != NULL)
+        {
+            result->hasLoopbackStats = 1;
+            ARSTREAM_Loopback_GetStats (loopback, ARSTREAM_LOOPBACK_DIRECTION_DATA, &(result->dataStats));
+            ARSTREAM_Loopback_GetStats (loopback, ARSTREAM_LOOPBACK_DIRECTION_ACK, &(result->ackStats));
+        }
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        result->nbReceived = g_NbFramesReceived;
+        result->nbBytesReceived = g_NbBytesReceived;
+        if (g_NbFramesReceived > 0)
+        {
+            qsort (g_LatenciesUs, g_NbFramesReceived, sizeof (uint32_t), ARSTREAM_LoopbackBench_CompareU32);
+            result->latencyP50Us = g_LatenciesUs [(int64_t)(g_NbFramesReceived - 1) * 500 / 1000];
+            result->latencyP99Us = g_LatenciesUs [(int64_t)(g_NbFramesReceived - 1) * 990 / 1000];
+            result->latencyP999Us = g_LatenciesUs [(int64_t)(g_NbFramesReceived - 1) * 999 / 1000];
+            result->latencyMaxUs = g_LatenciesUs [g_NbFramesReceived - 1];
+        }
+    }
+
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    if (encryptFilter != NULL)
+    {
+        ARSTREAM_CipherFilter_Delete (&encryptFilter);
+    }
+    if (decryptFilter != NULL)
+    {
+        ARSTREAM_CipherFilter_Delete (&decryptFilter);
+    }
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    ARSTREAM_FrameGenerator_Delete (&generator);
+    for (i = 0; i < 2 * params->nbFilters; i++)
+    {
+        for (j = 0; j < FILTER_NB_BUFFERS; j++)
+        {
+            free (copyFilters [i].buffers [j]);
+        }
+        pthread_mutex_destroy (&(copyFilters [i].mutex));
+    }
+    free (g_SendTimesNs);
+    free (g_LatenciesUs);
+    free (g_RecvBuffer);
+    g_SendTimesNs = NULL;
+    g_LatenciesUs = NULL;
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static void ARSTREAM_LoopbackBench_PrintResult (ARSTREAM_LoopbackBench_Params_t *params, ARSTREAM_LoopbackBench_Result_t *result, eARSTREAM_LOOPBACKBENCH_OUTPUT output, const char *tag)
+{
+    double wallS = result->wallNs / 1e9;
+    double framesPerS = (wallS > 0.) ? result->nbReceived / wallS : 0.;
+    double mbitPerS = (wallS > 0.) ? result->nbBytesReceived * 8e-6 / wallS : 0.;
+    double cpuUsPerFrame = result->cpuNs / 1e3 / params->nbFrames;
+    double cpuNsPerByte = (result->nbBytesSent > 0) ? (double)result->cpuNs / result->nbBytesSent : 0.;
+    const char *transport = (params->udpPort > 0) ? "udp" : "loopback";
+
+    switch (output)
+    {
+    case ARSTREAM_LOOPBACKBENCH_OUTPUT_CSV:
+        printf ("%s,%s,%s,%d,%d,%d,%d,%d,%d,%.2f,%d,%d,%.1f,%.2f,%.2f,%.3f,%u,%u,%u,%u\n",
+                tag, transport, g_DistNames [params->dist], params->frameSize, params->fragSize, params->fps, params->nbFilters, params->encrypt, params->nbFrames, params->lossPercent,
+                result->nbReceived, result->nbTimeouts, framesPerS, mbitPerS, cpuUsPerFrame, cpuNsPerByte,
+                result->latencyP50Us, result->latencyP99Us, result->latencyP999Us, result->latencyMaxUs);
+        break;
+    case ARSTREAM_LOOPBACKBENCH_OUTPUT_JSON:
+        printf ("{\"tag\":\"%s\",\"transport\":\"%s\",\"dist\":\"%s\",\"frame_size\":%d,\"frag_size\":%d,\"fps\":%d,\"filters\":%d,\"encrypt\":%d,\"frames\":%d,\"loss_pct\":%.2f,"
+                "\"received\":%d,\"timeouts\":%d,\"frames_per_s\":%.1f,\"mbit_per_s\":%.2f,\"cpu_us_per_frame\":%.2f,\"cpu_ns_per_byte\":%.3f,"
+                "\"lat_p50_us\":%u,\"lat_p99_us\":%u,\"lat_p999_us\":%u,\"lat_max_us\":%u}\n",
+                tag, transport, g_DistNames [params->dist], params->frameSize, params->fragSize, params->fps, params->nbFilters, params->encrypt, params->nbFrames, params->lossPercent,
+                result->nbReceived, result->nbTimeouts, framesPerS, mbitPerS, cpuUsPerFrame, cpuNsPerByte,
+                result->latencyP50Us, result->latencyP99Us, result->latencyP999Us, result->latencyMaxUs);
+        break;
+    default:
+        printf ("Config : %s, %d frames (%s, mean %d bytes), %d bytes fragments, %d fps%s, loss %.2f%%, %d filters per side%s\n",
+                transport, params->nbFrames, g_DistNames [params->dist], params->frameSize, params->fragSize, params->fps, (params->fps == 0) ? " (closed loop)" : "", params->lossPercent, params->nbFilters, (params->encrypt != 0) ? ", encrypted" : "");
+        printf ("Frames : %d received, %d timeouts\n", result->nbReceived, result->nbTimeouts);
+        if (result->hasLoopbackStats != 0)
+        {
+            printf ("Data packets : %llu delivered (%llu bytes), %llu overflow\n",
+                    (unsigned long long)result->dataStats.nbPackets, (unsigned long long)result->dataStats.nbBytes, (unsigned long long)result->dataStats.nbDroppedFull);
+            printf ("Ack packets : %llu delivered\n", (unsigned long long)result->ackStats.nbPackets);
+        }
+        printf ("Throughput : %.1f frames/s, %.2f Mbit/s\n", framesPerS, mbitPerS);
+        printf ("CPU time : %.2f us/frame, %.3f ns/byte (all threads)\n", cpuUsPerFrame, cpuNsPerByte);
+        printf ("Latency : p50 %u us, p99 %u us, p99.9 %u us, max %u us\n\n",
+                result->latencyP50Us, result->latencyP99Us, result->latencyP999Us, result->latencyMaxUs);
+        break;
+    }
+    fflush (stdout);
+}
+
+static int ARSTREAM_LoopbackBench_ParseIntList (const char *arg, int *values, int minValue)
+{
+    char *end;
+    int nbValues = 0;
+    while ((*arg != '\0') &&
+           (nbValues < MAX_SWEEP_VALUES))
+    {
+        long value = strtol (arg, &end, 10);
+        if ((end == arg) ||
+            (value < minValue))
+        {
+            return -1;
+        }
+        values [nbValues++] = (int)value;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+    return nbValues;
+}
+
+static int ARSTREAM_LoopbackBench_ParseDoubleList (const char *arg, double *values)
+{
+    char *end;
+    int nbValues = 0;
+    while ((*arg != '\0') &&
+           (nbValues < MAX_SWEEP_VALUES))
+    {
+        double value = strtod (arg, &end);
+        if ((end == arg) ||
+            (value < 0.))
+        {
+            return -1;
+        }
+        values [nbValues++] = value;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+    return nbValues;
+}
+
+static int ARSTREAM_LoopbackBench_ParseDistList (const char *arg, int *values)
+{
+    int nbValues = 0;
+    while ((*arg != '\0') &&
+           (nbValues < MAX_SWEEP_VALUES))
+    {
+        size_t len = strcspn (arg, ",");
+        int dist;
+        for (dist = 0; dist < ARSTREAM_LOOPBACKBENCH_DIST_MAX; dist++)
+        {
+            if ((strlen (g_DistNames [dist]) == len) &&
+                (strncmp (arg, g_DistNames [dist], len) == 0))
+            {
+                break;
+            }
+        }
+        if (dist == ARSTREAM_LOOPBACKBENCH_DIST_MAX)
+        {
+            return -1;
+        }
+        values [nbValues++] = dist;
+        arg += len;
+        if (*arg == ',')
+        {
+            arg++;
+        }
+    }
+    return nbValues;
+}
+
+static void ARSTREAM_LoopbackBench_Usage (const char *name)
+{
+    printf ("Usage: %s [-n nbFrames] [-s frameSizes] [-D dists] [-f fragmentSizes] [-r fpsList] [-F filterCounts] [-e] [-k] [-l lossPercents] [-u udpPort] [-o text|csv|json] [-t tag] [-T traceFile]\n", name);
+    printf ("  All the list options take comma separated values, and every combination is run\n");
+    printf ("  -s : mean frame sizes in bytes (default %d)\n", DEFAULT_FRAME_SIZE);
+    printf ("  -D : frame size distributions : fixed, uniform (size/2 to 3*size/2), gop (ARSTREAM_FrameGenerator, I-frames %dx the P-frames every %d frames)\n", GOP_I_FRAME_RATIO, GOP_LENGTH);
+    printf ("  -f : fragment sizes (default %d)\n", DEFAULT_FRAG_SIZE);
+    printf ("  -r : frame rates, 0 to send each frame when the previous one was received (default 0)\n");
+    printf ("  -F : number of pass-through copy filters on the sender and on the reader (max %d)\n", MAX_FILTERS);
+    printf ("  -e : encrypt the frames with ChaCha20 (%s implementation), after the sender filters and before the reader filters\n", ARSTREAM_CipherFilter_GetImplementation ());
+    printf ("  -k : only check ChaCha20 against the RFC 8439 test vector (also checked before the runs with -e)\n");
+    printf ("  -l : loss rates in percent, applied to both directions with fixed seeds\n");
+    printf ("  -u : stream over UDP on localhost instead of an in-process loopback\n");
+    printf ("  -o : output format, csv and json (one object per line) are meant to be compared across commits\n");
+    printf ("  -t : tag copied in the csv/json results (e.g. a commit id)\n");
+    printf ("  -T : record the frame lifecycle events, and write them as a Chrome trace (chrome://tracing, ui.perfetto.dev)\n");
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_LoopbackBench_Main (int argc, char *argv[])
+{
+    int dists [MAX_SWEEP_VALUES] = { ARSTREAM_LOOPBACKBENCH_DIST_FIXED };
+    int frameSizes [MAX_SWEEP_VALUES] = { DEFAULT_FRAME_SIZE };
+    int fragSizes [MAX_SWEEP_VALUES] = { DEFAULT_FRAG_SIZE };
+    int fpsList [MAX_SWEEP_VALUES] = { 0 };
+    int filterCounts [MAX_SWEEP_VALUES] = { 0 };
+    double lossPercents [MAX_SWEEP_VALUES] = { 0. };
+    int nbDists = 1, nbFrameSizes = 1, nbFragSizes = 1, nbFps = 1, nbFilterCounts = 1, nbLossPercents = 1;
+    eARSTREAM_LOOPBACKBENCH_OUTPUT output = ARSTREAM_LOOPBACKBENCH_OUTPUT_TEXT;
+    ARSTREAM_LoopbackBench_Params_t params;
+    const char *tag = "";
+    const char *traceFile = NULL;
+    int nbFrames = DEFAULT_NB_FRAMES;
+    int udpPort = 0;
+    int encrypt = 0;
+    int katOnly = 0;
+    int nbFailures = 0;
+    int badArgs = 0;
+    int opt, iDist, iSize, iFrag, iFps, iFilter, iLoss;
+
+    while ((opt = getopt (argc, argv, "n:s:D:f:r:F:ekl:u:o:t:T:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': nbFrames = atoi (optarg); break;
+        case 's': nbFrameSizes = ARSTREAM_LoopbackBench_ParseIntList (optarg, frameSizes, HEADER_SIZE); break;
+        case 'D': nbDists = ARSTREAM_LoopbackBench_ParseDistList (optarg, dists); break;
+        case 'f': nbFragSizes = ARSTREAM_LoopbackBench_ParseIntList (optarg, fragSizes, 1); break;
+        case 'r': nbFps = ARSTREAM_LoopbackBench_ParseIntList (optarg, fpsList, 0); break;
+        case 'F': nbFilterCounts = ARSTREAM_LoopbackBench_ParseIntList (optarg, filterCounts, 0); break;
+        case 'e': encrypt = 1; break;
+        case 'k': katOnly = 1; break;
+        case 'l': nbLossPercents = ARSTREAM_LoopbackBench_ParseDoubleList (optarg, lossPercents); break;
+        case 'u': udpPort = atoi (optarg); break;
+        case 'o':
+            if (strcmp (optarg, "csv") == 0) { output = ARSTREAM_LOOPBACKBENCH_OUTPUT_CSV; }
+            else if (strcmp (optarg, "json") == 0) { output = ARSTREAM_LOOPBACKBENCH_OUTPUT_JSON; }
+            else if (strcmp (optarg, "text") == 0) { output = ARSTREAM_LOOPBACKBENCH_OUTPUT_TEXT; }
+            else { badArgs = 1; }
+            break;
+        case 't': tag = optarg; break;
+        case 'T': traceFile = optarg; break;
+        default:
+            badArgs = 1;
+            break;
+        }
+    }
+    for (iFilter = 0; iFilter < nbFilterCounts; iFilter++)
+    {
+        if (filterCounts [iFilter] > MAX_FILTERS)
+        {
+            badArgs = 1;
+        }
+    }
+    if ((badArgs != 0) ||
+        (nbFrames <= 0) ||
+        (nbDists <= 0) ||
+        (nbFrameSizes <= 0) ||
+        (nbFragSizes <= 0) ||
+        (nbFps <= 0) ||
+        (nbFilterCounts <= 0) ||
+        (nbLossPercents <= 0))
+    {
+        ARSTREAM_LoopbackBench_Usage (argv[0]);
+        return 1;
+    }
+
+    if ((encrypt != 0) || (katOnly != 0))
+    {
+        /* Encrypted runs are meaningless with a broken cipher */
+        if (ARSTREAM_LoopbackBench_CipherKnownAnswerTest () != 0)
+        {
+            return 1;
+        }
+        if (katOnly != 0)
+        {
+            return 0;
+        }
+    }
+
+    if (output == ARSTREAM_LOOPBACKBENCH_OUTPUT_CSV)
+    {
+        printf ("tag,transport,dist,frame_size,frag_size,fps,filters,encrypt,frames,loss_pct,received,timeouts,frames_per_s,mbit_per_s,cpu_us_per_frame,cpu_ns_per_byte,lat_p50_us,lat_p99_us,lat_p999_us,lat_max_us\n");
+    }
+
+    if (traceFile != NULL)
+    {
+        ARSTREAM_Trace_SetRingSize (TRACE_RING_SIZE);
+        ARSTREAM_Trace_SetThreadName ("LoopbackBench");
+        if (ARSTREAM_Trace_Enable (1) != ARSTREAM_OK)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Tracing is not built in this libARStream");
+            return 1;
+        }
+    }
+
+    params.nbFrames = nbFrames;
+    params.udpPort = udpPort;
+    params.encrypt = encrypt;
+    for (iDist = 0; iDist < nbDists; iDist++)
+    for (iSize = 0; iSize < nbFrameSizes; iSize++)
+    for (iFrag = 0; iFrag < nbFragSizes; iFrag++)
+    for (iFps = 0; iFps < nbFps; iFps++)
+    for (iFilter = 0; iFilter < nbFilterCounts; iFilter++)
+    for (iLoss = 0; iLoss < nbLossPercents; iLoss++)
+    {
+        ARSTREAM_LoopbackBench_Result_t result;
+        params.dist = dists [iDist];
+        params.frameSize = frameSizes [iSize];
+        params.fragSize = fragSizes [iFrag];
+        params.fps = fpsList [iFps];
+        params.nbFilters = filterCounts [iFilter];
+        params.lossPercent = lossPercents [iLoss];
+
+        if (ARSTREAM_LoopbackBench_MaxFrameSize (&params) + ((encrypt != 0) ? ARSTREAM_CIPHER_FILTER_NONCE_SIZE : 0) > params.fragSize * MAX_NB_FRAG)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Skipping %s frames of %d bytes : too large for %d bytes fragments",
+                         g_DistNames [params.dist], params.frameSize, params.fragSize);
+            continue;
+        }
+        if (ARSTREAM_LoopbackBench_Run (&params, &result) == 0)
+        {
+            ARSTREAM_LoopbackBench_PrintResult (&params, &result, output, tag);
+        }
+        else
+        {
+            nbFailures++;
+        }
+    }
+
+    if (traceFile != NULL)
+    {
+        FILE *file = fopen (traceFile, "w");
+        ARSTREAM_Trace_Enable (0);
+        if ((file == NULL) ||
+            (ARSTREAM_Trace_WriteChromeJson (file) != ARSTREAM_OK))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to write the trace to %s", traceFile);
+            nbFailures++;
+        }
+        if (file != NULL)
+        {
+            fclose (file);
+        }
+        if (ARSTREAM_Trace_GetNbDroppedEvents () > 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "%llu trace events were dropped (rings full)", (unsigned long long)ARSTREAM_Trace_GetNbDroppedEvents ());
+        }
+    }
+
+    return (nbFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_LoopbackBench.h
+ * @brief Header file for the platform independant in-process loopback benchmark
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_LOOPBACKBENCH_H_
+#define _ARSTREAM_LOOPBACKBENCH_H_
+
+/**
+ * @brief Benchmark entry point
+ * Streams frames from an ARSTREAM_Sender_t to an ARSTREAM_Reader_t of the same process
+ * (through an ARSTREAM_Loopback_t, or UDP on localhost), for every combination of the
+ * swept parameters (fragment size, frame size distribution, frame rate, filter count, loss rate),
+ * and prints the throughput, the CPU cost per frame and the frame latency percentiles
+ * as text, CSV or JSON lines. With -T, the frame lifecycle events are written as a Chrome trace.
+ * With -e or -k, ARSTREAM_CipherFilter_ChaCha20 is first checked against the RFC 8439 test vector.
+ * Run with -h for the options.
+ * @param argc Argument count of the main function
+ * @param argv Arguments values of the main function
+ * @return The "main" return value
+ */
+int ARSTREAM_LoopbackBench_Main (int argc, char *argv[]);
+
+#endif /* _ARSTREAM_LOOPBACKBENCH_H_ */
@@ -0,0 +1,1045 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_MP4Recorder.c
+ * @brief Fragmented mp4 recording sink for received frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARSTREAM_MP4Recorder.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_MP4Recorder"
+
+#define ARSTREAM_MP4RECORDER_MIN_BUFFER_SIZE (64 * 1024)
+#define ARSTREAM_MP4RECORDER_RECORD_ALIGN (16)
+#define ARSTREAM_MP4RECORDER_PADDING_RECORD (UINT32_MAX)
+
+/* Writes are blocks of this size, at offsets multiple of this size */
+#define ARSTREAM_MP4RECORDER_WRITE_BLOCK_SIZE (1024 * 1024)
+#define ARSTREAM_MP4RECORDER_WRITE_ALIGN (4096)
+
+#define ARSTREAM_MP4RECORDER_MAX_SAMPLES_PER_FRAGMENT (1024)
+#define ARSTREAM_MP4RECORDER_MAX_PARAMETER_SET_SIZE (256)
+#define ARSTREAM_MP4RECORDER_TIMESCALE (90000)
+#define ARSTREAM_MP4RECORDER_DEFAULT_SAMPLE_DURATION (ARSTREAM_MP4RECORDER_TIMESCALE / 30)
+#define ARSTREAM_MP4RECORDER_IDLE_SLEEP_US (2000)
+
+#define ARSTREAM_MP4RECORDER_SAMPLE_FLAGS_SYNC (0x02000000)
+#define ARSTREAM_MP4RECORDER_SAMPLE_FLAGS_NON_SYNC (0x01010000)
+
+#define ARSTREAM_MP4RECORDER_NALU_TYPE_SPS (7)
+#define ARSTREAM_MP4RECORDER_NALU_TYPE_PPS (8)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Header of a frame in the ring, followed by the frame (padded to ARSTREAM_MP4RECORDER_RECORD_ALIGN)
+ * A size of ARSTREAM_MP4RECORDER_PADDING_RECORD means that the rest of the ring is unused (next record at the beginning)
+ */
+typedef struct {
+    uint32_t size;
+    uint32_t isKeyFrame;
+    uint64_t timestampUs;
+} ARSTREAM_MP4Recorder_RecordHeader_t;
+
+/**
+ * @brief A sample of the current fragment, still in the ring
+ */
+typedef struct {
+    uint64_t ringPos;
+    uint32_t inputSize;
+    uint32_t sampleSize;
+    uint64_t decodeTime;
+    int isKeyFrame;
+    int isAnnexB;
+} ARSTREAM_MP4Recorder_Sample_t;
+
+/**
+ * @brief Entry of the random access index (one per fragment starting with a key frame)
+ */
+typedef struct {
+    uint64_t decodeTime;
+    uint64_t moofOffset;
+} ARSTREAM_MP4Recorder_RandomAccess_t;
+
+/**
+ * @brief Growable buffer where boxes are built
+ */
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    int error;
+} ARSTREAM_MP4Recorder_Box_t;
+
+struct ARSTREAM_MP4Recorder {
+    uint32_t width;
+    uint32_t height;
+    uint64_t fragmentDurationUs;
+    int fd;
+
+    /* Frames ring : single producer (AddFrame), single consumer (writer thread) */
+    uint8_t *ring;
+    uint32_t ringSize;
+    uint64_t head;
+    uint64_t tail;
+    int dropUntilKeyFrame;
+
+    /* Stats */
+    uint32_t nbFramesRecorded;
+    uint32_t nbFramesDropped;
+    uint32_t nbFramesSkipped;
+    uint32_t nbFragments;
+    uint64_t nbBytesWritten;
+    uint32_t nbWriteErrors;
+
+    /* Writer thread */
+    pthread_t writerThread;
+    int writerThreadStarted;
+    int writerShouldStop;
+    uint64_t peekPos;
+    ARSTREAM_MP4Recorder_Sample_t samples [ARSTREAM_MP4RECORDER_MAX_SAMPLES_PER_FRAGMENT];
+    uint32_t nbSamples;
+    uint64_t fragmentRingBytes;
+    uint64_t fragmentStartUs;
+    uint64_t lastFrameArrivalUs;
+    int initWritten;
+    uint8_t sps [ARSTREAM_MP4RECORDER_MAX_PARAMETER_SET_SIZE];
+    uint32_t spsSize;
+    uint8_t pps [ARSTREAM_MP4RECORDER_MAX_PARAMETER_SET_SIZE];
+    uint32_t ppsSize;
+    uint64_t firstTimestampUs;
+    uint64_t lastDecodeTime;
+    uint32_t lastDuration;
+    uint32_t sequenceNumber;
+    ARSTREAM_MP4Recorder_RandomAccess_t *randomAccess;
+    uint32_t nbRandomAccess;
+    uint32_t randomAccessCapacity;
+    ARSTREAM_MP4Recorder_Box_t box;
+
+    /* Output : the current block, and its offset in the file */
+    uint8_t *block;
+    uint32_t blockSize;
+    uint64_t blockOffset;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Writer thread : muxes the frames of the ring into fragments
+ */
+static void* ARSTREAM_MP4Recorder_WriterThread (void *param);
+
+/**
+ * @brief Writes the current fragment (moof + mdat) and releases its frames from the ring
+ * @param nextDecodeTime Decode time of the frame following the fragment (gives the duration of its last frame), 0 if unknown
+ */
+static void ARSTREAM_MP4Recorder_CloseFragment (ARSTREAM_MP4Recorder_t *recorder, uint64_t nextDecodeTime);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_MP4Recorder_GetTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static inline uint32_t ARSTREAM_MP4Recorder_RecordSize (uint32_t frameSize)
+{
+    return sizeof (ARSTREAM_MP4Recorder_RecordHeader_t) + ((frameSize + ARSTREAM_MP4RECORDER_RECORD_ALIGN - 1) & ~(ARSTREAM_MP4RECORDER_RECORD_ALIGN - 1));
+}
+
+/* Box building */
+
+static void ARSTREAM_MP4Recorder_BoxPutBytes (ARSTREAM_MP4Recorder_Box_t *box, const void *data, size_t size)
+{
+    if (box->size + size > box->capacity)
+    {
+        size_t newCapacity = (box->capacity == 0) ? 4096 : box->capacity;
+        uint8_t *newData;
+        while (newCapacity < box->size + size)
+        {
+            newCapacity *= 2;
+        }
+        newData = realloc (box->data, newCapacity);
+        if (newData == NULL)
+        {
+            box->error = 1;
+            return;
+        }
+        box->data = newData;
+        box->capacity = newCapacity;
+    }
+    memcpy (&(box->data [box->size]), data, size);
+    box->size += size;
+}
+
+static void ARSTREAM_MP4Recorder_BoxPut8 (ARSTREAM_MP4Recorder_Box_t *box, uint8_t value)
+{
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, &value, 1);
+}
+
+static void ARSTREAM_MP4Recorder_BoxPut16 (ARSTREAM_MP4Recorder_Box_t *box, uint16_t value)
+{
+    uint8_t bytes [2] = { value >> 8, value };
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, bytes, 2);
+}
+
+static void ARSTREAM_MP4Recorder_BoxPut32 (ARSTREAM_MP4Recorder_Box_t *box, uint32_t value)
+{
+    uint8_t bytes [4] = { value >> 24, value >> 16, value >> 8, value };
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, bytes, 4);
+}
+
+static void ARSTREAM_MP4Recorder_BoxPut64 (ARSTREAM_MP4Recorder_Box_t *box, uint64_t value)
+{
+    ARSTREAM_MP4Recorder_BoxPut32 (box, (uint32_t)(value >> 32));
+    ARSTREAM_MP4Recorder_BoxPut32 (box, (uint32_t)value);
+}
+
+static void ARSTREAM_MP4Recorder_BoxPutZeros (ARSTREAM_MP4Recorder_Box_t *box, size_t size)
+{
+    static const uint8_t zeros [32] = { 0 };
+    while (size > 0)
+    {
+        size_t chunk = (size > sizeof (zeros)) ? sizeof (zeros) : size;
+        ARSTREAM_MP4Recorder_BoxPutBytes (box, zeros, chunk);
+        size -= chunk;
+    }
+}
+
+static void ARSTREAM_MP4Recorder_BoxPutMatrix (ARSTREAM_MP4Recorder_Box_t *box)
+{
+    static const uint32_t matrix [9] = { 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000 };
+    int i;
+    for (i = 0; i < 9; i++)
+    {
+        ARSTREAM_MP4Recorder_BoxPut32 (box, matrix [i]);
+    }
+}
+
+/* Starts a box, returns its offset (to give to BoxEnd) */
+static size_t ARSTREAM_MP4Recorder_BoxBegin (ARSTREAM_MP4Recorder_Box_t *box, const char *type)
+{
+    size_t offset = box->size;
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, type, 4);
+    return offset;
+}
+
+static size_t ARSTREAM_MP4Recorder_BoxBeginFull (ARSTREAM_MP4Recorder_Box_t *box, const char *type, uint8_t version, uint32_t flags)
+{
+    size_t offset = ARSTREAM_MP4Recorder_BoxBegin (box, type);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, ((uint32_t)version << 24) | (flags & 0xFFFFFF));
+    return offset;
+}
+
+static void ARSTREAM_MP4Recorder_BoxPatch32 (ARSTREAM_MP4Recorder_Box_t *box, size_t offset, uint32_t value)
+{
+    if ((box->error == 0) &&
+        (offset + 4 <= box->size))
+    {
+        box->data [offset] = value >> 24;
+        box->data [offset + 1] = value >> 16;
+        box->data [offset + 2] = value >> 8;
+        box->data [offset + 3] = value;
+    }
+}
+
+static void ARSTREAM_MP4Recorder_BoxEnd (ARSTREAM_MP4Recorder_Box_t *box, size_t offset)
+{
+    ARSTREAM_MP4Recorder_BoxPatch32 (box, offset, (uint32_t)(box->size - offset));
+}
+
+/* Output */
+
+static void ARSTREAM_MP4Recorder_WriteBlock (ARSTREAM_MP4Recorder_t *recorder)
+{
+    uint32_t written = 0;
+    while (written < recorder->blockSize)
+    {
+        ssize_t res = pwrite (recorder->fd, &(recorder->block [written]), recorder->blockSize - written, recorder->blockOffset + written);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Write error : %s", strerror (errno));
+            __atomic_add_fetch (&(recorder->nbWriteErrors), 1, __ATOMIC_RELAXED);
+            break;
+        }
+        written += res;
+    }
+}
+
+static void ARSTREAM_MP4Recorder_Output (ARSTREAM_MP4Recorder_t *recorder, const uint8_t *data, size_t size)
+{
+    while (size > 0)
+    {
+        size_t chunk = ARSTREAM_MP4RECORDER_WRITE_BLOCK_SIZE - recorder->blockSize;
+        if (chunk > size)
+        {
+            chunk = size;
+        }
+        memcpy (&(recorder->block [recorder->blockSize]), data, chunk);
+        recorder->blockSize += chunk;
+        data += chunk;
+        size -= chunk;
+        if (recorder->blockSize == ARSTREAM_MP4RECORDER_WRITE_BLOCK_SIZE)
+        {
+            ARSTREAM_MP4Recorder_WriteBlock (recorder);
+            recorder->blockOffset += ARSTREAM_MP4RECORDER_WRITE_BLOCK_SIZE;
+            recorder->blockSize = 0;
+        }
+    }
+}
+
+static void ARSTREAM_MP4Recorder_Output32 (ARSTREAM_MP4Recorder_t *recorder, uint32_t value)
+{
+    uint8_t bytes [4] = { value >> 24, value >> 16, value >> 8, value };
+    ARSTREAM_MP4Recorder_Output (recorder, bytes, 4);
+}
+
+static uint64_t ARSTREAM_MP4Recorder_OutputOffset (ARSTREAM_MP4Recorder_t *recorder)
+{
+    return recorder->blockOffset + recorder->blockSize;
+}
+
+/* H.264 */
+
+static int ARSTREAM_MP4Recorder_IsAnnexB (const uint8_t *data, uint32_t size)
+{
+    return ((size >= 3) && (data [0] == 0) && (data [1] == 0) && (data [2] == 1)) ||
+        ((size >= 4) && (data [0] == 0) && (data [1] == 0) && (data [2] == 0) && (data [3] == 1));
+}
+
+/* Finds the next "00 00 01" from offset, returns size if there is none */
+static uint32_t ARSTREAM_MP4Recorder_FindStartCode (const uint8_t *data, uint32_t size, uint32_t offset)
+{
+    while (offset + 3 <= size)
+    {
+        const uint8_t *one = memchr (&(data [offset + 2]), 1, size - offset - 2);
+        uint32_t onePos;
+        if (one == NULL)
+        {
+            break;
+        }
+        onePos = one - data;
+        if ((data [onePos - 1] == 0) &&
+            (data [onePos - 2] == 0))
+        {
+            return onePos - 2;
+        }
+        offset = onePos - 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Iterates over the NAL units of a frame (Annex-B or 4 bytes length prefixed)
+ * @param[in,out] offset Position in the frame, 0 for the first call
+ * @return 1 if a NAL unit was found, 0 at the end of the frame
+ */
+static int ARSTREAM_MP4Recorder_NextNalu (const uint8_t *data, uint32_t size, int isAnnexB, uint32_t *offset, const uint8_t **nalu, uint32_t *naluSize)
+{
+    if (isAnnexB)
+    {
+        uint32_t start = ARSTREAM_MP4Recorder_FindStartCode (data, size, *offset);
+        uint32_t end;
+        if (start >= size)
+        {
+            return 0;
+        }
+        start += 3;
+        end = ARSTREAM_MP4Recorder_FindStartCode (data, size, start);
+        *offset = end;
+        // Zeros before the next start code belong to it (4 bytes start codes, trailing zeros)
+        while ((end > start) && (data [end - 1] == 0))
+        {
+            end--;
+        }
+        *nalu = &(data [start]);
+        *naluSize = end - start;
+        return 1;
+    }
+    else
+    {
+        uint32_t length;
+        if (*offset + 4 > size)
+        {
+            return 0;
+        }
+        length = ((uint32_t)data [*offset] << 24) | ((uint32_t)data [*offset + 1] << 16) | ((uint32_t)data [*offset + 2] << 8) | data [*offset + 3];
+        if (length > size - *offset - 4)
+        {
+            return 0;
+        }
+        *nalu = &(data [*offset + 4]);
+        *naluSize = length;
+        *offset += 4 + length;
+        return 1;
+    }
+}
+
+static uint32_t ARSTREAM_MP4Recorder_SampleSize (const uint8_t *data, uint32_t size, int isAnnexB)
+{
+    uint32_t sampleSize = 0;
+    uint32_t offset = 0;
+    const uint8_t *nalu;
+    uint32_t naluSize;
+    if (isAnnexB == 0)
+    {
+        return size;
+    }
+    while (ARSTREAM_MP4Recorder_NextNalu (data, size, 1, &offset, &nalu, &naluSize))
+    {
+        if (naluSize > 0)
+        {
+            sampleSize += 4 + naluSize;
+        }
+    }
+    return sampleSize;
+}
+
+static void ARSTREAM_MP4Recorder_GetParameterSets (ARSTREAM_MP4Recorder_t *recorder, const uint8_t *data, uint32_t size, int isAnnexB)
+{
+    uint32_t offset = 0;
+    const uint8_t *nalu;
+    uint32_t naluSize;
+    while (ARSTREAM_MP4Recorder_NextNalu (data, size, isAnnexB, &offset, &nalu, &naluSize))
+    {
+        if ((naluSize == 0) ||
+            (naluSize > ARSTREAM_MP4RECORDER_MAX_PARAMETER_SET_SIZE))
+        {
+            continue;
+        }
+        if (((nalu [0] & 0x1F) == ARSTREAM_MP4RECORDER_NALU_TYPE_SPS) &&
+            (recorder->spsSize == 0))
+        {
+            memcpy (recorder->sps, nalu, naluSize);
+            recorder->spsSize = naluSize;
+        }
+        else if (((nalu [0] & 0x1F) == ARSTREAM_MP4RECORDER_NALU_TYPE_PPS) &&
+                 (recorder->ppsSize == 0))
+        {
+            memcpy (recorder->pps, nalu, naluSize);
+            recorder->ppsSize = naluSize;
+        }
+    }
+}
+
+/* Muxing */
+
+static void ARSTREAM_MP4Recorder_WriteInit (ARSTREAM_MP4Recorder_t *recorder)
+{
+    ARSTREAM_MP4Recorder_Box_t *box = &(recorder->box);
+    size_t ftyp, moov, trak, mdia, minf, dinf, stbl, stsd, avc1, avcC, mvex, b;
+
+    if (recorder->spsSize < 4)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "No SPS/PPS in the first key frame, the file will not be playable");
+    }
+
+    box->size = 0;
+    ftyp = ARSTREAM_MP4Recorder_BoxBegin (box, "ftyp");
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, "isom", 4);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0x200);
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, "isomiso6avc1mp41", 16);
+    ARSTREAM_MP4Recorder_BoxEnd (box, ftyp);
+
+    moov = ARSTREAM_MP4Recorder_BoxBegin (box, "moov");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "mvhd", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 8); // creation / modification times
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1000);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0); // duration : given by the fragments
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0x00010000);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 0x0100);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 10);
+    ARSTREAM_MP4Recorder_BoxPutMatrix (box);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 24);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 2); // next track id
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+
+    trak = ARSTREAM_MP4Recorder_BoxBegin (box, "trak");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "tkhd", 0, 0x7);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 8);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1); // track id
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 4 + 4 + 8 + 2 + 2 + 2 + 2); // reserved, duration, reserved, layer, group, volume, reserved
+    ARSTREAM_MP4Recorder_BoxPutMatrix (box);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, recorder->width << 16);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, recorder->height << 16);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+
+    mdia = ARSTREAM_MP4Recorder_BoxBegin (box, "mdia");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "mdhd", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 8);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, ARSTREAM_MP4RECORDER_TIMESCALE);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 0x55C4); // "und"
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 0);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "hdlr", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, "vide", 4);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 12);
+    ARSTREAM_MP4Recorder_BoxPutBytes (box, "ARStream video", 15);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+
+    minf = ARSTREAM_MP4Recorder_BoxBegin (box, "minf");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "vmhd", 0, 1);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 8);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    dinf = ARSTREAM_MP4Recorder_BoxBegin (box, "dinf");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "dref", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1);
+    ARSTREAM_MP4Recorder_BoxEnd (box, ARSTREAM_MP4Recorder_BoxBeginFull (box, "url ", 0, 1)); // Data in the same file
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    ARSTREAM_MP4Recorder_BoxEnd (box, dinf);
+
+    /* Empty sample table : samples are in the fragments */
+    stbl = ARSTREAM_MP4Recorder_BoxBegin (box, "stbl");
+    stsd = ARSTREAM_MP4Recorder_BoxBeginFull (box, "stsd", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1);
+    avc1 = ARSTREAM_MP4Recorder_BoxBegin (box, "avc1");
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 6);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 1); // data reference index
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 16);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, recorder->width);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, recorder->height);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0x00480000); // 72 dpi
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0x00480000);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 1); // frame count
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 32); // compressor name
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 0x0018);
+    ARSTREAM_MP4Recorder_BoxPut16 (box, 0xFFFF);
+    avcC = ARSTREAM_MP4Recorder_BoxBegin (box, "avcC");
+    ARSTREAM_MP4Recorder_BoxPut8 (box, 1);
+    ARSTREAM_MP4Recorder_BoxPut8 (box, (recorder->spsSize >= 4) ? recorder->sps [1] : 0x42); // profile, compatibility, level
+    ARSTREAM_MP4Recorder_BoxPut8 (box, (recorder->spsSize >= 4) ? recorder->sps [2] : 0);
+    ARSTREAM_MP4Recorder_BoxPut8 (box, (recorder->spsSize >= 4) ? recorder->sps [3] : 0x1E);
+    ARSTREAM_MP4Recorder_BoxPut8 (box, 0xFF); // 4 bytes NAL unit lengths
+    ARSTREAM_MP4Recorder_BoxPut8 (box, 0xE0 | ((recorder->spsSize > 0) ? 1 : 0));
+    if (recorder->spsSize > 0)
+    {
+        ARSTREAM_MP4Recorder_BoxPut16 (box, recorder->spsSize);
+        ARSTREAM_MP4Recorder_BoxPutBytes (box, recorder->sps, recorder->spsSize);
+    }
+    ARSTREAM_MP4Recorder_BoxPut8 (box, (recorder->ppsSize > 0) ? 1 : 0);
+    if (recorder->ppsSize > 0)
+    {
+        ARSTREAM_MP4Recorder_BoxPut16 (box, recorder->ppsSize);
+        ARSTREAM_MP4Recorder_BoxPutBytes (box, recorder->pps, recorder->ppsSize);
+    }
+    ARSTREAM_MP4Recorder_BoxEnd (box, avcC);
+    ARSTREAM_MP4Recorder_BoxEnd (box, avc1);
+    ARSTREAM_MP4Recorder_BoxEnd (box, stsd);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "stts", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "stsc", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "stsz", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 8);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "stco", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    ARSTREAM_MP4Recorder_BoxEnd (box, stbl);
+    ARSTREAM_MP4Recorder_BoxEnd (box, minf);
+    ARSTREAM_MP4Recorder_BoxEnd (box, mdia);
+    ARSTREAM_MP4Recorder_BoxEnd (box, trak);
+
+    mvex = ARSTREAM_MP4Recorder_BoxBegin (box, "mvex");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "trex", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1); // track id
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1); // sample description index
+    ARSTREAM_MP4Recorder_BoxPutZeros (box, 12); // default duration, size, flags : given by each trun
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    ARSTREAM_MP4Recorder_BoxEnd (box, mvex);
+    ARSTREAM_MP4Recorder_BoxEnd (box, moov);
+
+    if (box->error == 0)
+    {
+        ARSTREAM_MP4Recorder_Output (recorder, box->data, box->size);
+    }
+}
+
+static void ARSTREAM_MP4Recorder_CloseFragment (ARSTREAM_MP4Recorder_t *recorder, uint64_t nextDecodeTime)
+{
+    ARSTREAM_MP4Recorder_Box_t *box = &(recorder->box);
+    size_t moof, traf, trun, b, dataOffsetPos;
+    uint64_t mdatSize = 8;
+    uint32_t i;
+
+    if (recorder->nbSamples == 0)
+    {
+        return;
+    }
+
+    /* moof */
+    box->size = 0;
+    moof = ARSTREAM_MP4Recorder_BoxBegin (box, "moof");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "mfhd", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, ++recorder->sequenceNumber);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    traf = ARSTREAM_MP4Recorder_BoxBegin (box, "traf");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "tfhd", 0, 0x020000); // default-base-is-moof
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "tfdt", 1, 0);
+    ARSTREAM_MP4Recorder_BoxPut64 (box, recorder->samples [0].decodeTime);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    trun = ARSTREAM_MP4Recorder_BoxBeginFull (box, "trun", 0, 0x000701); // data offset, durations, sizes, flags
+    ARSTREAM_MP4Recorder_BoxPut32 (box, recorder->nbSamples);
+    dataOffsetPos = box->size;
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0);
+    for (i = 0; i < recorder->nbSamples; i++)
+    {
+        ARSTREAM_MP4Recorder_Sample_t *sample = &(recorder->samples [i]);
+        uint32_t duration;
+        if (i + 1 < recorder->nbSamples)
+        {
+            duration = recorder->samples [i + 1].decodeTime - sample->decodeTime;
+        }
+        else if (nextDecodeTime > sample->decodeTime)
+        {
+            duration = nextDecodeTime - sample->decodeTime;
+        }
+        else
+        {
+            duration = recorder->lastDuration;
+        }
+        recorder->lastDuration = duration;
+        ARSTREAM_MP4Recorder_BoxPut32 (box, duration);
+        ARSTREAM_MP4Recorder_BoxPut32 (box, sample->sampleSize);
+        ARSTREAM_MP4Recorder_BoxPut32 (box, sample->isKeyFrame ? ARSTREAM_MP4RECORDER_SAMPLE_FLAGS_SYNC : ARSTREAM_MP4RECORDER_SAMPLE_FLAGS_NON_SYNC);
+        mdatSize += sample->sampleSize;
+    }
+    ARSTREAM_MP4Recorder_BoxEnd (box, trun);
+    ARSTREAM_MP4Recorder_BoxEnd (box, traf);
+    ARSTREAM_MP4Recorder_BoxEnd (box, moof);
+    ARSTREAM_MP4Recorder_BoxPatch32 (box, dataOffsetPos, box->size + 8);
+
+    if (box->error == 0)
+    {
+        if (recorder->samples [0].isKeyFrame)
+        {
+            if (recorder->nbRandomAccess == recorder->randomAccessCapacity)
+            {
+                uint32_t newCapacity = (recorder->randomAccessCapacity == 0) ? 256 : 2 * recorder->randomAccessCapacity;
+                ARSTREAM_MP4Recorder_RandomAccess_t *newArray = realloc (recorder->randomAccess, newCapacity * sizeof (ARSTREAM_MP4Recorder_RandomAccess_t));
+                if (newArray != NULL)
+                {
+                    recorder->randomAccess = newArray;
+                    recorder->randomAccessCapacity = newCapacity;
+                }
+            }
+            if (recorder->nbRandomAccess < recorder->randomAccessCapacity)
+            {
+                recorder->randomAccess [recorder->nbRandomAccess].decodeTime = recorder->samples [0].decodeTime;
+                recorder->randomAccess [recorder->nbRandomAccess].moofOffset = ARSTREAM_MP4Recorder_OutputOffset (recorder);
+                recorder->nbRandomAccess++;
+            }
+        }
+
+        ARSTREAM_MP4Recorder_Output (recorder, box->data, box->size);
+        ARSTREAM_MP4Recorder_Output32 (recorder, mdatSize);
+        ARSTREAM_MP4Recorder_Output (recorder, (const uint8_t *)"mdat", 4);
+        for (i = 0; i < recorder->nbSamples; i++)
+        {
+            ARSTREAM_MP4Recorder_Sample_t *sample = &(recorder->samples [i]);
+            const uint8_t *data = &(recorder->ring [sample->ringPos % recorder->ringSize]);
+            if (sample->isAnnexB)
+            {
+                uint32_t offset = 0;
+                const uint8_t *nalu;
+                uint32_t naluSize;
+                while (ARSTREAM_MP4Recorder_NextNalu (data, sample->inputSize, 1, &offset, &nalu, &naluSize))
+                {
+                    if (naluSize > 0)
+                    {
+                        ARSTREAM_MP4Recorder_Output32 (recorder, naluSize);
+                        ARSTREAM_MP4Recorder_Output (recorder, nalu, naluSize);
+                    }
+                }
+            }
+            else
+            {
+                ARSTREAM_MP4Recorder_Output (recorder, data, sample->inputSize);
+            }
+        }
+        __atomic_add_fetch (&(recorder->nbFramesRecorded), recorder->nbSamples, __ATOMIC_RELAXED);
+        __atomic_add_fetch (&(recorder->nbFragments), 1, __ATOMIC_RELAXED);
+        __atomic_store_n (&(recorder->nbBytesWritten), ARSTREAM_MP4Recorder_OutputOffset (recorder), __ATOMIC_RELAXED);
+    }
+    else
+    {
+        __atomic_add_fetch (&(recorder->nbFramesDropped), recorder->nbSamples, __ATOMIC_RELAXED);
+    }
+
+    /* Give the frames back to the producer */
+    __atomic_store_n (&(recorder->tail), recorder->peekPos, __ATOMIC_RELEASE);
+    recorder->nbSamples = 0;
+    recorder->fragmentRingBytes = 0;
+}
+
+static void ARSTREAM_MP4Recorder_WriteIndex (ARSTREAM_MP4Recorder_t *recorder)
+{
+    ARSTREAM_MP4Recorder_Box_t *box = &(recorder->box);
+    size_t mfra, b;
+    uint32_t i;
+
+    box->size = 0;
+    mfra = ARSTREAM_MP4Recorder_BoxBegin (box, "mfra");
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "tfra", 1, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 1); // track id
+    ARSTREAM_MP4Recorder_BoxPut32 (box, 0); // 1 byte traf/trun/sample numbers
+    ARSTREAM_MP4Recorder_BoxPut32 (box, recorder->nbRandomAccess);
+    for (i = 0; i < recorder->nbRandomAccess; i++)
+    {
+        ARSTREAM_MP4Recorder_BoxPut64 (box, recorder->randomAccess [i].decodeTime);
+        ARSTREAM_MP4Recorder_BoxPut64 (box, recorder->randomAccess [i].moofOffset);
+        ARSTREAM_MP4Recorder_BoxPut8 (box, 1);
+        ARSTREAM_MP4Recorder_BoxPut8 (box, 1);
+        ARSTREAM_MP4Recorder_BoxPut8 (box, 1);
+    }
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    b = ARSTREAM_MP4Recorder_BoxBeginFull (box, "mfro", 0, 0);
+    ARSTREAM_MP4Recorder_BoxPut32 (box, box->size - mfra + 4);
+    ARSTREAM_MP4Recorder_BoxEnd (box, b);
+    ARSTREAM_MP4Recorder_BoxEnd (box, mfra);
+
+    if (box->error == 0)
+    {
+        ARSTREAM_MP4Recorder_Output (recorder, box->data, box->size);
+        __atomic_store_n (&(recorder->nbBytesWritten), ARSTREAM_MP4Recorder_OutputOffset (recorder), __ATOMIC_RELAXED);
+    }
+}
+
+static void* ARSTREAM_MP4Recorder_WriterThread (void *param)
+{
+    ARSTREAM_MP4Recorder_t *recorder = (ARSTREAM_MP4Recorder_t *)param;
+    while (1)
+    {
+        ARSTREAM_MP4Recorder_RecordHeader_t header;
+        ARSTREAM_MP4Recorder_Sample_t *sample;
+        uint64_t head = __atomic_load_n (&(recorder->head), __ATOMIC_ACQUIRE);
+        uint64_t decodeTime;
+        uint32_t recordSize;
+        const uint8_t *data;
+
+        if (recorder->peekPos == head)
+        {
+            uint64_t nowUs;
+            if (__atomic_load_n (&(recorder->writerShouldStop), __ATOMIC_ACQUIRE) != 0)
+            {
+                break;
+            }
+            nowUs = ARSTREAM_MP4Recorder_GetTimeUs ();
+            if ((recorder->nbSamples > 0) &&
+                (nowUs - recorder->lastFrameArrivalUs > 2 * recorder->fragmentDurationUs))
+            {
+                // The stream stalled : do not keep the fragment (and the frames) waiting for the next key frame
+                ARSTREAM_MP4Recorder_CloseFragment (recorder, 0);
+                if (recorder->blockSize > 0)
+                {
+                    // Partial block, rewritten at the same offset once complete
+                    ARSTREAM_MP4Recorder_WriteBlock (recorder);
+                }
+            }
+            usleep (ARSTREAM_MP4RECORDER_IDLE_SLEEP_US);
+            continue;
+        }
+
+        memcpy (&header, &(recorder->ring [recorder->peekPos % recorder->ringSize]), sizeof (header));
+        if (header.size == ARSTREAM_MP4RECORDER_PADDING_RECORD)
+        {
+            recorder->peekPos += recorder->ringSize - (recorder->peekPos % recorder->ringSize);
+            if (recorder->nbSamples == 0)
+            {
+                __atomic_store_n (&(recorder->tail), recorder->peekPos, __ATOMIC_RELEASE);
+            }
+            continue;
+        }
+        recordSize = ARSTREAM_MP4Recorder_RecordSize (header.size);
+        data = &(recorder->ring [(recorder->peekPos + sizeof (header)) % recorder->ringSize]);
+        recorder->lastFrameArrivalUs = ARSTREAM_MP4Recorder_GetTimeUs ();
+
+        if (recorder->initWritten == 0)
+        {
+            if (header.isKeyFrame == 0)
+            {
+                __atomic_add_fetch (&(recorder->nbFramesSkipped), 1, __ATOMIC_RELAXED);
+                recorder->peekPos += recordSize;
+                __atomic_store_n (&(recorder->tail), recorder->peekPos, __ATOMIC_RELEASE);
+                continue;
+            }
+            ARSTREAM_MP4Recorder_GetParameterSets (recorder, data, header.size, ARSTREAM_MP4Recorder_IsAnnexB (data, header.size));
+            ARSTREAM_MP4Recorder_WriteInit (recorder);
+            recorder->firstTimestampUs = header.timestampUs;
+            recorder->initWritten = 1;
+        }
+
+        /* Decode time on the 90kHz clock, strictly increasing */
+        decodeTime = ((header.timestampUs - recorder->firstTimestampUs) * (ARSTREAM_MP4RECORDER_TIMESCALE / 1000)) / 1000;
+        if ((recorder->sequenceNumber > 0 || recorder->nbSamples > 0) &&
+            (decodeTime <= recorder->lastDecodeTime))
+        {
+            decodeTime = recorder->lastDecodeTime + 1;
+        }
+
+        /* Fragments start on key frames, unless they would hold too much of the ring */
+        if ((recorder->nbSamples > 0) &&
+            (((header.isKeyFrame != 0) && (header.timestampUs - recorder->fragmentStartUs >= recorder->fragmentDurationUs)) ||
+             (recorder->nbSamples == ARSTREAM_MP4RECORDER_MAX_SAMPLES_PER_FRAGMENT) ||
+             (recorder->fragmentRingBytes + recordSize > recorder->ringSize / 2)))
+        {
+            ARSTREAM_MP4Recorder_CloseFragment (recorder, decodeTime);
+        }
+        if (recorder->nbSamples == 0)
+        {
+            recorder->fragmentStartUs = header.timestampUs;
+        }
+
+        sample = &(recorder->samples [recorder->nbSamples++]);
+        sample->ringPos = recorder->peekPos + sizeof (header);
+        sample->inputSize = header.size;
+        sample->isKeyFrame = header.isKeyFrame;
+        sample->isAnnexB = ARSTREAM_MP4Recorder_IsAnnexB (data, header.size);
+        sample->sampleSize = ARSTREAM_MP4Recorder_SampleSize (data, header.size, sample->isAnnexB);
+        sample->decodeTime = decodeTime;
+        recorder->lastDecodeTime = decodeTime;
+        recorder->fragmentRingBytes += recordSize;
+        recorder->peekPos += recordSize;
+    }
+
+    ARSTREAM_MP4Recorder_CloseFragment (recorder, 0);
+    if (recorder->initWritten != 0)
+    {
+        ARSTREAM_MP4Recorder_WriteIndex (recorder);
+    }
+    if (recorder->blockSize > 0)
+    {
+        ARSTREAM_MP4Recorder_WriteBlock (recorder);
+    }
+    return NULL;
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_MP4Recorder_t* ARSTREAM_MP4Recorder_New (const ARSTREAM_MP4Recorder_Config_t *config)
+{
+    ARSTREAM_MP4Recorder_t *retRecorder = NULL;
+    void *block = NULL;
+
+    if ((config == NULL) ||
+        (config->path == NULL))
+    {
+        return NULL;
+    }
+    retRecorder = calloc (1, sizeof (ARSTREAM_MP4Recorder_t));
+    if (retRecorder == NULL)
+    {
+        return NULL;
+    }
+    retRecorder->width = config->width;
+    retRecorder->height = config->height;
+    retRecorder->fragmentDurationUs = 1000 * (uint64_t)((config->fragmentDurationMs != 0) ? config->fragmentDurationMs : ARSTREAM_MP4RECORDER_DEFAULT_FRAGMENT_DURATION_MS);
+    retRecorder->ringSize = (config->bufferSize != 0) ? config->bufferSize : ARSTREAM_MP4RECORDER_DEFAULT_BUFFER_SIZE;
+    if (retRecorder->ringSize < ARSTREAM_MP4RECORDER_MIN_BUFFER_SIZE)
+    {
+        retRecorder->ringSize = ARSTREAM_MP4RECORDER_MIN_BUFFER_SIZE;
+    }
+    retRecorder->ringSize &= ~(ARSTREAM_MP4RECORDER_RECORD_ALIGN - 1);
+    retRecorder->lastDuration = ARSTREAM_MP4RECORDER_DEFAULT_SAMPLE_DURATION;
+
+    retRecorder->fd = open (config->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    retRecorder->ring = malloc (retRecorder->ringSize);
+    if (posix_memalign (&block, ARSTREAM_MP4RECORDER_WRITE_ALIGN, ARSTREAM_MP4RECORDER_WRITE_BLOCK_SIZE) == 0)
+    {
+        retRecorder->block = block;
+    }
+    if ((retRecorder->fd < 0) ||
+        (retRecorder->ring == NULL) ||
+        (retRecorder->block == NULL))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the recording %s", config->path);
+        ARSTREAM_MP4Recorder_Delete (&retRecorder);
+        return NULL;
+    }
+    // Fault the pages in now rather than in the thread delivering the frames
+    memset (retRecorder->ring, 0, retRecorder->ringSize);
+
+    if (pthread_create (&(retRecorder->writerThread), NULL, ARSTREAM_MP4Recorder_WriterThread, retRecorder) != 0)
+    {
+        ARSTREAM_MP4Recorder_Delete (&retRecorder);
+        return NULL;
+    }
+    retRecorder->writerThreadStarted = 1;
+
+    return retRecorder;
+}
+
+void ARSTREAM_MP4Recorder_Stop (ARSTREAM_MP4Recorder_t *recorder)
+{
+    if (recorder == NULL)
+    {
+        return;
+    }
+    if (recorder->writerThreadStarted == 1)
+    {
+        __atomic_store_n (&(recorder->writerShouldStop), 1, __ATOMIC_RELEASE);
+        pthread_join (recorder->writerThread, NULL);
+        recorder->writerThreadStarted = 0;
+    }
+    if (recorder->fd >= 0)
+    {
+        close (recorder->fd);
+        recorder->fd = -1;
+    }
+}
+
+void ARSTREAM_MP4Recorder_Delete (ARSTREAM_MP4Recorder_t **recorder)
+{
+    if ((recorder != NULL) &&
+        (*recorder != NULL))
+    {
+        ARSTREAM_MP4Recorder_Stop (*recorder);
+        free ((*recorder)->ring);
+        free ((*recorder)->block);
+        free ((*recorder)->box.data);
+        free ((*recorder)->randomAccess);
+        free (*recorder);
+        *recorder = NULL;
+    }
+}
+
+int ARSTREAM_MP4Recorder_AddFrame (ARSTREAM_MP4Recorder_t *recorder, const uint8_t *frame, uint32_t frameSize, uint64_t timestampUs, int isKeyFrame)
+{
+    ARSTREAM_MP4Recorder_RecordHeader_t header;
+    uint64_t head, tail;
+    uint32_t needed, contiguous, padding;
+
+    if ((recorder == NULL) ||
+        (frame == NULL) ||
+        (frameSize == 0) ||
+        (__atomic_load_n (&(recorder->writerShouldStop), __ATOMIC_ACQUIRE) != 0) ||
+        (frameSize >= ARSTREAM_MP4RECORDER_PADDING_RECORD))
+    {
+        return -1;
+    }
+    if ((recorder->dropUntilKeyFrame != 0) &&
+        (isKeyFrame == 0))
+    {
+        __atomic_add_fetch (&(recorder->nbFramesDropped), 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    head = recorder->head;
+    tail = __atomic_load_n (&(recorder->tail), __ATOMIC_ACQUIRE);
+    needed = ARSTREAM_MP4Recorder_RecordSize (frameSize);
+    contiguous = recorder->ringSize - (head % recorder->ringSize);
+    padding = (needed > contiguous) ? contiguous : 0;
+    if ((uint64_t)needed + padding > recorder->ringSize - (head - tail))
+    {
+        // The writer is late : drop, and keep dropping until a frame which does not depend on this one
+        __atomic_add_fetch (&(recorder->nbFramesDropped), 1, __ATOMIC_RELAXED);
+        recorder->dropUntilKeyFrame = 1;
+        return -1;
+    }
+    if (padding != 0)
+    {
+        header.size = ARSTREAM_MP4RECORDER_PADDING_RECORD;
+        header.isKeyFrame = 0;
+        header.timestampUs = 0;
+        memcpy (&(recorder->ring [head % recorder->ringSize]), &header, sizeof (header));
+        head += padding;
+    }
+
+    header.size = frameSize;
+    header.isKeyFrame = (isKeyFrame != 0) ? 1 : 0;
+    header.timestampUs = timestampUs;
+    memcpy (&(recorder->ring [head % recorder->ringSize]), &header, sizeof (header));
+    memcpy (&(recorder->ring [(head % recorder->ringSize) + sizeof (header)]), frame, frameSize);
+    __atomic_store_n (&(recorder->head), head + needed, __ATOMIC_RELEASE);
+    recorder->dropUntilKeyFrame = 0;
+    return 0;
+}
+
+void ARSTREAM_MP4Recorder_GetStats (ARSTREAM_MP4Recorder_t *recorder, ARSTREAM_MP4Recorder_Stats_t *stats)
+{
+    if ((recorder == NULL) ||
+        (stats == NULL))
+    {
+        return;
+    }
+    stats->nbFramesRecorded = __atomic_load_n (&(recorder->nbFramesRecorded), __ATOMIC_RELAXED);
+    stats->nbFramesDropped = __atomic_load_n (&(recorder->nbFramesDropped), __ATOMIC_RELAXED);
+    stats->nbFramesSkipped = __atomic_load_n (&(recorder->nbFramesSkipped), __ATOMIC_RELAXED);
+    stats->nbFragments = __atomic_load_n (&(recorder->nbFragments), __ATOMIC_RELAXED);
+    stats->nbBytesWritten = __atomic_load_n (&(recorder->nbBytesWritten), __ATOMIC_RELAXED);
+    stats->nbWriteErrors = __atomic_load_n (&(recorder->nbWriteErrors), __ATOMIC_RELAXED);
+}
@@ -0,0 +1,130 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_MP4Recorder.h
+ * @brief Fragmented mp4 recording sink for received frames
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_MP4RECORDER_H_
+#define _ARSTREAM_MP4RECORDER_H_
+
+#include <inttypes.h>
+
+/**
+ * @brief Records H.264 frames into a fragmented mp4 file
+ *
+ * ARSTREAM_MP4Recorder_AddFrame only copies the frame into a bounded ring, and never blocks :
+ * when the ring is full, the frame is dropped (and counted), as well as the following frames
+ * until the next key frame, so that the recording stays decodable.
+ * A background thread muxes the frames into fragments (moof + mdat, starting on key frames),
+ * and writes the file with large aligned writes. The random access index (mfra) is written when
+ * the recorder is deleted, so that players can seek in the file.
+ *
+ * Frames can be Annex-B (start codes) or already length prefixed (avcC style, 4 bytes lengths).
+ * SPS and PPS are taken from the first key frame. Frames before the first key frame are dropped.
+ */
+typedef struct ARSTREAM_MP4Recorder ARSTREAM_MP4Recorder_t;
+
+/**
+ * @brief Default size of the frames ring, in bytes
+ */
+#define ARSTREAM_MP4RECORDER_DEFAULT_BUFFER_SIZE (8 * 1024 * 1024)
+
+/**
+ * @brief Default target duration of the fragments
+ */
+#define ARSTREAM_MP4RECORDER_DEFAULT_FRAGMENT_DURATION_MS (1000)
+
+/**
+ * @brief Recorder configuration
+ */
+typedef struct {
+    const char *path; /**< Path of the mp4 file to create */
+    uint32_t width; /**< Width of the video (only used for the track header, can be 0) */
+    uint32_t height; /**< Height of the video (only used for the track header, can be 0) */
+    uint32_t bufferSize; /**< Size of the frames ring (0 for ARSTREAM_MP4RECORDER_DEFAULT_BUFFER_SIZE) */
+    uint32_t fragmentDurationMs; /**< Minimum duration of a fragment (0 for ARSTREAM_MP4RECORDER_DEFAULT_FRAGMENT_DURATION_MS) */
+} ARSTREAM_MP4Recorder_Config_t;
+
+/**
+ * @brief Recorder statistics
+ */
+typedef struct {
+    uint32_t nbFramesRecorded; /**< Frames written to the file */
+    uint32_t nbFramesDropped; /**< Frames dropped because the ring was full (including the following non key frames) */
+    uint32_t nbFramesSkipped; /**< Frames dropped while waiting for the first key frame */
+    uint32_t nbFragments; /**< Fragments written to the file */
+    uint64_t nbBytesWritten; /**< Size of the file */
+    uint32_t nbWriteErrors; /**< Failed writes (the file is incomplete) */
+} ARSTREAM_MP4Recorder_Stats_t;
+
+/**
+ * @brief Creates the file and starts the writer thread
+ * @param config Recorder configuration
+ * @return A new recorder, or NULL if the file can not be created
+ */
+ARSTREAM_MP4Recorder_t* ARSTREAM_MP4Recorder_New (const ARSTREAM_MP4Recorder_Config_t *config);
+
+/**
+ * @brief Writes the pending frames and the index, and closes the file
+ * Frames added after this call are dropped. Statistics stay available until the recorder is deleted.
+ * @param recorder The recorder
+ */
+void ARSTREAM_MP4Recorder_Stop (ARSTREAM_MP4Recorder_t *recorder);
+
+/**
+ * @brief Stops the recorder (if not already stopped), and frees it
+ * @param recorder Pointer to the recorder to delete (set to NULL)
+ */
+void ARSTREAM_MP4Recorder_Delete (ARSTREAM_MP4Recorder_t **recorder);
+
+/**
+ * @brief Adds a frame to the recording, never blocks
+ * Must always be called from the same thread (typically the frame complete callback of an ARSTREAM_Reader_t)
+ * @param recorder The recorder
+ * @param frame The frame, which is copied : it can be reused as soon as the function returns
+ * @param frameSize Size of the frame
+ * @param timestampUs Time of the frame (e.g. its reception time), increasing
+ * @param isKeyFrame Key (flush) frame (1) or not (0)
+ * @return 0 if the frame will be recorded, -1 if it was dropped
+ */
+int ARSTREAM_MP4Recorder_AddFrame (ARSTREAM_MP4Recorder_t *recorder, const uint8_t *frame, uint32_t frameSize, uint64_t timestampUs, int isKeyFrame);
+
+/**
+ * @brief Gets the statistics of the recorder
+ * @param recorder The recorder
+ * @param[out] stats Statistics
+ */
+void ARSTREAM_MP4Recorder_GetStats (ARSTREAM_MP4Recorder_t *recorder, ARSTREAM_MP4Recorder_Stats_t *stats);
+
+#endif /* _ARSTREAM_MP4RECORDER_H_ */
@@ -36,6 +36,7 @@
  * @author nicolas.brulez@parrot.com
  */
 
+
 /*
  * System Headers
  */
@@ -45,7 +46,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
-#include <arpa/inet.h>
+#include <time.h>
 #include <errno.h>
 
 /*
@@ -56,6 +57,7 @@
 #include <libARStream/ARSTREAM_Sender.h>
 
 #include "../ARSTREAM_TB_Config.h"
+#include "../MP4Source/ARSTREAM_MP4Source.h"
 
 /*
  * Macros
@@ -68,15 +70,6 @@
 #define READING_PORT (43210)
 
 #define NB_BUFFERS (40)
-#define I_FRAME_EVERY_N (30)
-
-#define TEST_MODE (0)
-
-#if TEST_MODE
-# define TIME_BETWEEN_FRAMES_MS (1000)
-#else
-# define TIME_BETWEEN_FRAMES_MS (33)
-#endif
 
 #define __TAG__ "ARSTREAM_MP4Sender_TB"
 
@@ -100,18 +93,12 @@ float ARSTREAM_MP4Sender_PercentOk = 0.0;
 static int nbSent = 0;
 static int nbOk = 0;
 
-static int currentBufferIndex = 0;
-static uint8_t *multiBuffer[NB_BUFFERS];
-static uint32_t multiBufferSize[NB_BUFFERS];
-static int multiBufferIsFree[NB_BUFFERS];
-
 static char *appName;
 
-static FILE *mp4File;
-static int mp4NbFrames;
-static int mp4CurrentFrame;
-static uint32_t *framesOffsetArray;
-static uint32_t *framesSizeArray;
+static ARSTREAM_MP4Source_t *mp4Source;
+static double playbackSpeed = 1.0;
+
+static int skipToNextIFrame = 0;
 
 /*
  * Internal functions declarations
@@ -122,33 +109,14 @@ static uint32_t *framesSizeArray;
  */
 void ARSTREAM_MP4SenderTb_printUsage ();
 
-/**
- * @brief Initializes the multi buffers of the testbench
- * @param maxsize Maximum size of a frame in the current mp4 file
- */
-void ARSTREAM_MP4SenderTb_initMultiBuffers (int maxsize);
-
 /**
  * @see ARSTREAM_Sender.h
  */
 void ARSTREAM_MP4SenderTb_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
 
-/**
- * @brief Gets a free buffer pointer
- * @param[in] buffer the buffer to mark as free
- */
-void ARSTREAM_MP4SenderTb_SetBufferFree (uint8_t *buffer);
-
-/**
- * @brief Gets a free buffer pointer
- * @param[out] retSize Pointer where to store the size of the next free buffer (or 0 if there is no free buffer)
- * @return Pointer to the next free buffer, or NULL if there is no free buffer
- */
-uint8_t* ARSTREAM_MP4SenderTb_GetNextFreeBuffer (uint32_t *retSize);
-
 /**
  * @brief File reader thread function
- * This function reads frames periodically from the given mp4 file, and sends them through the ARSTREAM_Sender_t
+ * This function sends the frames of the mp4 file through the ARSTREAM_Sender_t, at the times given by the file
  * @param ARSTREAM_Sender_t_Param A valid ARSTREAM_Sender_t, casted as a (void *), which will be used by the thread
  * @return No meaningful value : (void *)0
  *
@@ -164,152 +132,128 @@ void* fileReaderThread (void *ARSTREAM_Sender_t_Param);
  */
 int ARSTREAM_MP4SenderTb_StartStreamTest (const char *fpath, ARNETWORK_Manager_t *manager);
 
-/**
- * @brief Opens the file for reading + get the largest frame size
- * @param path Path of the mp4 file
- * @return the size of the largest frame in the file
- */
-int ARSTREAM_MP4SenderTb_OpenStreamFile (const char *path);
-
-/**
- * @brief Get the "next" frame from file
- * @param nextFrame buffer in which to store nextFrame
- * @param nextFrameSize size of the nextFrame buffer
- * @param isIFrame pointer to an int which will hold this boolean-like flag
- * @return actual data size of the nextFrame
- *
- * @note After reading the last frame from the file, this function goes back to the beginning
- */
-uint32_t ARSTREAM_MP4SenderTb_GetNextFrame (uint8_t *nextFrame, int nextFrameSize, int *isIFrame);
-
-/**
- * @brief seeks the global mp4File to the given atom
- * @param atomName 4CC of the atom to seek
- * @return size of the atom (-1 means failure)
- */
-int ARSTREAM_MP4SenderTb_JumpToAtom (const char *atomName);
-
 /*
  * Internal functions implementation
  */
 
 void ARSTREAM_MP4SenderTb_printUsage ()
 {
-    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Usage : %s file [ip]", appName);
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Usage : %s file [ip [speed]]", appName);
     ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        file -> mp4 file to read from");
     ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        ip -> optionnal, ip of the stream reader");
-}
-
-void ARSTREAM_MP4SenderTb_initMultiBuffers (int maxsize)
-{
-    int buffIndex;
-    for (buffIndex = 0; buffIndex < NB_BUFFERS; buffIndex++)
-    {
-        multiBuffer[buffIndex] = malloc (maxsize);
-        multiBufferSize[buffIndex] = maxsize;
-        multiBufferIsFree[buffIndex] = 1;
-    }
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        speed -> optionnal, playback speed factor (default 1.0, 0 sends as fast as possible)");
 }
 
 void ARSTREAM_MP4SenderTb_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
 {
     custom = custom;
+    framePointer = framePointer;
     switch (status)
     {
     case ARSTREAM_SENDER_STATUS_FRAME_SENT:
-        ARSTREAM_MP4SenderTb_SetBufferFree (framePointer);
         ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Successfully sent a frame of size %u", frameSize);
         nbSent++;
         nbOk++;
         ARSTREAM_MP4Sender_PercentOk = (100.f * nbOk) / (1.f * nbSent);
         break;
     case ARSTREAM_SENDER_STATUS_FRAME_CANCEL:
-        ARSTREAM_MP4SenderTb_SetBufferFree (framePointer);
         ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Cancelled a frame of size %u", frameSize);
         nbSent++;
         ARSTREAM_MP4Sender_PercentOk = (100.f * nbOk) / (1.f * nbSent);
         break;
+    case ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST:
+        // We can't encode a new I-Frame from a file, jump to the next one instead
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Reader asked for a key frame (reason %u)", frameSize);
+        skipToNextIFrame = 1;
+        break;
     default:
         // All cases handled
         break;
     }
 }
 
-void ARSTREAM_MP4SenderTb_SetBufferFree (uint8_t *buffer)
+static uint64_t ARSTREAM_MP4SenderTb_GetTimeUs ()
 {
-    int i;
-    for (i = 0; i < NB_BUFFERS; i++)
-    {
-        if (multiBuffer[i] == buffer)
-        {
-            multiBufferIsFree[i] = 1;
-        }
-    }
-}
-
-uint8_t* ARSTREAM_MP4SenderTb_GetNextFreeBuffer (uint32_t *retSize)
-{
-    uint8_t *retBuffer = NULL;
-    int nbtest = 0;
-    if (retSize == NULL)
-    {
-        return NULL;
-    }
-    do
-    {
-        if (multiBufferIsFree[currentBufferIndex] == 1)
-        {
-            retBuffer = multiBuffer[currentBufferIndex];
-            *retSize = multiBufferSize[currentBufferIndex];
-        }
-        currentBufferIndex = (currentBufferIndex + 1) % NB_BUFFERS;
-        nbtest++;
-    } while (retBuffer == NULL && nbtest < NB_BUFFERS);
-    return retBuffer;
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
 }
 
 void* fileReaderThread (void *ARSTREAM_Sender_t_Param)
 {
-
-    uint8_t cnt = 0;
-    uint32_t frameSize = 0;
-    uint32_t frameCapacity = 0;
-    uint8_t *nextFrameAddr;
     ARSTREAM_Sender_t *sender = (ARSTREAM_Sender_t *)ARSTREAM_Sender_t_Param;
-    srand (time (NULL));
+    uint32_t nbFrames = ARSTREAM_MP4Source_GetNbFrames (mp4Source);
+    uint64_t durationUs = ARSTREAM_MP4Source_GetDurationUs (mp4Source);
+    uint64_t startUs = ARSTREAM_MP4SenderTb_GetTimeUs ();
+    /* Stream time of the current frame : file timestamp + previous loops - skipped durations */
+    uint64_t loopOffsetUs = 0;
+    uint64_t skippedUs = 0;
+    uint32_t index = 0;
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Encoder thread running");
     while (stillRunning)
     {
-        int flush;
-        nextFrameAddr = ARSTREAM_MP4SenderTb_GetNextFreeBuffer (&frameCapacity);
-        frameSize = ARSTREAM_MP4SenderTb_GetNextFrame (nextFrameAddr, frameCapacity, &flush);
-        cnt++;
+        ARSTREAM_MP4Source_Frame_t frame;
+        int nbPrevious = 0;
+        eARSTREAM_ERROR res;
 
-        if (frameSize != 0)
+        if (skipToNextIFrame == 1)
         {
-            int nbPrevious = 0;
-            eARSTREAM_ERROR res = ARSTREAM_Sender_SendNewFrame (sender, nextFrameAddr, frameSize, flush, &nbPrevious);
-            switch (res)
+            ARSTREAM_MP4Source_Frame_t current, keyFrame;
+            uint32_t keyIndex = ARSTREAM_MP4Source_GetNextKeyFrame (mp4Source, index);
+            ARSTREAM_MP4Source_GetFrame (mp4Source, index, &current);
+            ARSTREAM_MP4Source_GetFrame (mp4Source, keyIndex, &keyFrame);
+            if (keyIndex < index)
             {
-            case ARSTREAM_OK:
-                ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Added a frame of size %u to the Sender (already %d in queue)", frameSize, nbPrevious);
-                break;
-            case ARSTREAM_ERROR_BAD_PARAMETERS:
-            case ARSTREAM_ERROR_FRAME_TOO_LARGE:
-            case ARSTREAM_ERROR_QUEUE_FULL:
-                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to send the new frame : %s", ARSTREAM_Error_ToString(res));
-                break;
-            default:
-                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unknown error code for SendNewFrame");
-                break;
+                loopOffsetUs += durationUs;
             }
+            // Send the key frame now instead of waiting for the skipped frames duration
+            skippedUs += ((keyIndex < index) ? durationUs : 0) + keyFrame.timestampUs - current.timestampUs;
+            index = keyIndex;
+            skipToNextIFrame = 0;
         }
-        else
+
+        ARSTREAM_MP4Source_GetFrame (mp4Source, index, &frame);
+        if (playbackSpeed > 0.0)
         {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Could not get a new encoded frame");
+            uint64_t streamTimeUs = loopOffsetUs + frame.timestampUs - skippedUs;
+            uint64_t sendTimeUs = startUs + (uint64_t)(streamTimeUs / playbackSpeed);
+            uint64_t nowUs = ARSTREAM_MP4SenderTb_GetTimeUs ();
+            if (sendTimeUs > nowUs)
+            {
+                usleep (sendTimeUs - nowUs);
+            }
+        }
+
+        // Frames point into the file mapping : no copy, and nothing to free in the callback
+        res = ARSTREAM_Sender_SendNewFrame (sender, frame.data, frame.size, frame.isKeyFrame, &nbPrevious);
+        switch (res)
+        {
+        case ARSTREAM_OK:
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Added a frame of size %u to the Sender (already %d in queue)", frame.size, nbPrevious);
+            break;
+        case ARSTREAM_ERROR_BAD_PARAMETERS:
+        case ARSTREAM_ERROR_FRAME_TOO_LARGE:
+        case ARSTREAM_ERROR_QUEUE_FULL:
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to send the new frame : %s", ARSTREAM_Error_ToString(res));
+            if ((res == ARSTREAM_ERROR_QUEUE_FULL) &&
+                (playbackSpeed <= 0.0))
+            {
+                // As fast as possible : wait for the sender instead of skipping the frame
+                usleep (1000);
+                continue;
+            }
+            break;
+        default:
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unknown error code for SendNewFrame");
+            break;
         }
 
-        usleep (1000 * TIME_BETWEEN_FRAMES_MS);
+        index++;
+        if (index >= nbFrames)
+        {
+            index = 0;
+            loopOffsetUs += durationUs;
+        }
     }
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Encoder thread ended");
     return (void *)0;
@@ -320,11 +264,18 @@ int ARSTREAM_MP4SenderTb_StartStreamTest (const char *fpath, ARNETWORK_Manager_t
     int retVal = 0;
     eARSTREAM_ERROR err;
     ARSTREAM_Sender_t *sender;
-    ARSTREAM_MP4SenderTb_initMultiBuffers (ARSTREAM_MP4SenderTb_OpenStreamFile (fpath));
+    mp4Source = ARSTREAM_MP4Source_New (fpath);
+    if (mp4Source == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to read %s", fpath);
+        return 1;
+    }
+    ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "%s : %u frames, %llu ms, largest frame %u bytes", fpath, ARSTREAM_MP4Source_GetNbFrames (mp4Source), (unsigned long long)ARSTREAM_MP4Source_GetDurationUs (mp4Source) / 1000, ARSTREAM_MP4Source_GetMaxFrameSize (mp4Source));
     sender = ARSTREAM_Sender_New (manager, DATA_BUFFER_ID, ACK_BUFFER_ID, ARSTREAM_MP4SenderTb_FrameUpdateCallback, NB_BUFFERS, ARSTREAM_TB_FRAG_SIZE, ARSTREAM_TB_MAX_NB_FRAG, NULL, &err);
     if (sender == NULL)
     {
         ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Error during ARSTREAM_Sender_New call : %s", ARSTREAM_Error_ToString(err));
+        ARSTREAM_MP4Source_Delete (&mp4Source);
         return 1;
     }
 
@@ -347,234 +298,10 @@ int ARSTREAM_MP4SenderTb_StartStreamTest (const char *fpath, ARNETWORK_Manager_t
 
     ARSTREAM_Sender_Delete (&sender);
 
-    return retVal;
-}
-
-int ARSTREAM_MP4SenderTb_OpenStreamFile (const char *path)
-{
-    int res = 1;
-    int greatest = 0;
-    mp4File = fopen (path, "rb");
-    if (NULL == mp4File)
-    {
-        perror ("Open error");
-        exit (1);
-    }
-
-    /* Jump to stsz atom */
-    res = ARSTREAM_MP4SenderTb_JumpToAtom ("moov");
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("trak");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("mdia");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("minf");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("stbl");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("stsz");
-    }
-
-    /* Read nbFrames + all frames sizes */
-    if (res != -1)
-    {
-        uint8_t *data = malloc (res);
-        res = fread (data, 1, res, mp4File);
-        uint32_t neNbFrames = *(uint32_t *)&data[8];
-        mp4NbFrames = ntohl (neNbFrames);
-        framesSizeArray = malloc (mp4NbFrames * sizeof (uint32_t));
-        memcpy (framesSizeArray, &data[12], mp4NbFrames * sizeof (uint32_t));
-        int i;
-        for (i = 0; i < mp4NbFrames; i++)
-        {
-            framesSizeArray [i] = ntohl (framesSizeArray [i]);
-            if (framesSizeArray [i] > greatest)
-            {
-                greatest = framesSizeArray [i];
-            }
-        }
-        free (data);
-    }
-
-    /* Rewind file */
-    rewind (mp4File);
+    // Frames must not be used after the sender is deleted
+    ARSTREAM_MP4Source_Delete (&mp4Source);
 
-    /* Jump to stco atom */
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("moov");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("trak");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("mdia");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("minf");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("stbl");
-    }
-    if (res != -1)
-    {
-        res = ARSTREAM_MP4SenderTb_JumpToAtom ("stco");
-    }
-
-    /* Read nbFrames + all frames sizes */
-    if (res != -1)
-    {
-        uint8_t *data = malloc (res);
-        res = fread (data, 1, res, mp4File);
-        framesOffsetArray = malloc (mp4NbFrames * sizeof (uint32_t));
-        memcpy (framesOffsetArray, &data[8], mp4NbFrames * sizeof (uint32_t));
-        int i;
-        for (i = 0; i < mp4NbFrames; i++)
-        {
-            framesOffsetArray [i] = ntohl (framesOffsetArray [i]);
-        }
-        free (data);
-    }
-
-    mp4CurrentFrame = 0;
-    return greatest;
-}
-
-uint32_t ARSTREAM_MP4SenderTb_GetNextFrame (uint8_t *nextFrame, int nextFrameSize, int *isIFrame)
-{
-    uint32_t nextSize = framesSizeArray [mp4CurrentFrame];
-    uint32_t nextOffset = framesOffsetArray [mp4CurrentFrame];
-
-    *isIFrame = 0;
-
-    if (nextSize <= nextFrameSize)
-    {
-        fseek (mp4File, nextOffset, SEEK_SET);
-        int readRes = fread (nextFrame, 1, nextSize, mp4File);
-        if (readRes != nextSize)
-        {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Fread error: %s", strerror(errno));
-        }
-    }
-    else
-    {
-        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "GetNextFrame error ... this is pretty bad !");
-        return 0;
-    }
-
-    mp4CurrentFrame++;
-    if (mp4CurrentFrame >= mp4NbFrames)
-    {
-        mp4CurrentFrame = 0;
-    }
-
-    *isIFrame = ((mp4CurrentFrame % I_FRAME_EVERY_N) == 1) ? 1 : 0;
-
-    return nextSize;
-}
-
-
-/**
- * Read from a file functions
- * Note : fptr MUST be a valid file pointer
- */
-static void read_uint32 (FILE *fptr, uint32_t *dest)
-{
-    uint32_t locValue = 0;
-    if (1 != fread (&locValue, sizeof (locValue), 1, fptr))
-    {
-        fprintf (stderr, "Error reading a uint32_t\n");
-    }
-    *dest = ntohl (locValue);
-}
-
-static void read_uint64 (FILE *fptr, uint64_t *dest)
-{
-    uint64_t retValue = 0;
-    uint32_t locValue = 0;
-    if (1 != fread (&locValue, sizeof (locValue), 1, fptr))
-    {
-        fprintf (stderr, "Error reading low value of a uint64_t\n");
-        return;
-    }
-    retValue = (uint64_t)(ntohl (locValue));
-    if (1 != fread (&locValue, sizeof (locValue), 1, fptr))
-    {
-        fprintf (stderr, "Error reading a high value of a uint64_t\n");
-    }
-    retValue += ((uint64_t)(ntohl (locValue))) << 32;
-    *dest = retValue;
-}
-
-void read_4cc (FILE *fptr, char dest[5])
-{
-    if (1 != fread (dest, 4, 1, fptr))
-    {
-        fprintf (stderr, "Error reading a 4cc\n");
-    }
-}
-
-int ARSTREAM_MP4SenderTb_JumpToAtom (const char *atomName)
-{
-    uint32_t atomSize = 0;
-    char fourCCTag [5] = {0};
-    uint64_t wideAtomSize = 0;
-    int found = 0;
-    FILE *streamFile = mp4File;
-    if (NULL == streamFile)
-    {
-        return 0;
-    }
-
-    read_uint32 (streamFile, &atomSize);
-    read_4cc (streamFile, fourCCTag);
-    if (0 == atomSize)
-    {
-        read_uint64 (streamFile, &wideAtomSize);
-    }
-    else
-    {
-        wideAtomSize = atomSize;
-    }
-    if (0 == strncmp (fourCCTag, atomName, 4))
-    {
-        found = 1;
-    }
-
-    while (0 == found &&
-           !feof (streamFile))
-    {
-        fseek (streamFile, wideAtomSize - 8, SEEK_CUR);
-
-        read_uint32 (streamFile, &atomSize);
-        read_4cc (streamFile, fourCCTag);
-        if (0 == atomSize)
-        {
-            read_uint64 (streamFile, &wideAtomSize);
-        }
-        else
-        {
-            wideAtomSize = atomSize;
-        }
-        if (0 == strncmp (fourCCTag, atomName, 4))
-        {
-            found = 1;
-        }
-    }
-    return wideAtomSize;
+    return retVal;
 }
 
 /*
@@ -600,6 +327,11 @@ int ARSTREAM_MP4Sender_TestBenchMain (int argc, char *argv[])
         ip = argv[2];
     }
 
+    if (argc >= 4)
+    {
+        playbackSpeed = atof (argv[3]);
+    }
+
     int nbInBuff = 1;
     ARNETWORK_IOBufferParam_t inParams;
     ARSTREAM_Sender_InitStreamDataBuffer (&inParams, DATA_BUFFER_ID, ARSTREAM_TB_FRAG_SIZE, ARSTREAM_TB_MAX_NB_FRAG);
@@ -0,0 +1,517 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_MP4Source.c
+ * @brief Memory mapped mp4 frame source
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARSTREAM_MP4Source.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_MP4Source"
+
+#define ARSTREAM_MP4SOURCE_FULLBOX_HEADER_SIZE (4)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Payload of a box, inside the mapping
+ */
+typedef struct {
+    const uint8_t *data;
+    uint64_t size;
+} ARSTREAM_MP4Source_Box_t;
+
+struct ARSTREAM_MP4Source {
+    int fd;
+    uint8_t *map;
+    uint64_t mapSize;
+
+    ARSTREAM_MP4Source_Frame_t *frames;
+    uint32_t nbFrames;
+    uint32_t maxFrameSize;
+    uint64_t durationUs;
+};
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Finds a child box
+ * @param parent Payload of the parent box (or the whole file)
+ * @param type 4CC of the box
+ * @param after If not NULL, only look at the boxes after this payload (to iterate over boxes of the same type)
+ * @param[out] box Payload of the box
+ * @return 0 if found, -1 otherwise
+ */
+static int ARSTREAM_MP4Source_FindBox (const ARSTREAM_MP4Source_Box_t *parent, const char *type, const ARSTREAM_MP4Source_Box_t *after, ARSTREAM_MP4Source_Box_t *box);
+
+/**
+ * @brief Finds a box from a path of 4CC ("mdia/minf/stbl")
+ */
+static int ARSTREAM_MP4Source_FindPath (const ARSTREAM_MP4Source_Box_t *parent, const char *path, ARSTREAM_MP4Source_Box_t *box);
+
+/**
+ * @brief Builds the frames index from the sample table of a track
+ */
+static int ARSTREAM_MP4Source_IndexTrack (ARSTREAM_MP4Source_t *source, const ARSTREAM_MP4Source_Box_t *trak);
+
+/*
+ * Internal functions implementation
+ */
+
+static inline uint32_t ARSTREAM_MP4Source_ReadU32 (const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline uint64_t ARSTREAM_MP4Source_ReadU64 (const uint8_t *p)
+{
+    return ((uint64_t)ARSTREAM_MP4Source_ReadU32 (p) << 32) | ARSTREAM_MP4Source_ReadU32 (p + 4);
+}
+
+static int ARSTREAM_MP4Source_FindBox (const ARSTREAM_MP4Source_Box_t *parent, const char *type, const ARSTREAM_MP4Source_Box_t *after, ARSTREAM_MP4Source_Box_t *box)
+{
+    const uint8_t *cursor = parent->data;
+    const uint8_t *end = parent->data + parent->size;
+    if (after != NULL)
+    {
+        cursor = after->data + after->size;
+    }
+    while ((end - cursor) >= 8)
+    {
+        uint64_t boxSize = ARSTREAM_MP4Source_ReadU32 (cursor);
+        uint64_t headerSize = 8;
+        if (boxSize == 1)
+        {
+            if ((end - cursor) < 16)
+            {
+                return -1;
+            }
+            boxSize = ARSTREAM_MP4Source_ReadU64 (cursor + 8);
+            headerSize = 16;
+        }
+        else if (boxSize == 0)
+        {
+            // Extends to the end of its parent
+            boxSize = end - cursor;
+        }
+        if ((boxSize < headerSize) ||
+            (boxSize > (uint64_t)(end - cursor)))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Corrupted box at offset %ld of its parent", (long)(cursor - parent->data));
+            return -1;
+        }
+        if (memcmp (cursor + 4, type, 4) == 0)
+        {
+            box->data = cursor + headerSize;
+            box->size = boxSize - headerSize;
+            return 0;
+        }
+        cursor += boxSize;
+    }
+    return -1;
+}
+
+static int ARSTREAM_MP4Source_FindPath (const ARSTREAM_MP4Source_Box_t *parent, const char *path, ARSTREAM_MP4Source_Box_t *box)
+{
+    ARSTREAM_MP4Source_Box_t current = *parent;
+    while (*path != '\0')
+    {
+        if (ARSTREAM_MP4Source_FindBox (&current, path, NULL, &current) != 0)
+        {
+            return -1;
+        }
+        path += 4;
+        if (*path == '/')
+        {
+            path++;
+        }
+    }
+    *box = current;
+    return 0;
+}
+
+/**
+ * @brief Gets the entries of a table box (full box header, entry count, entries) after checking its size
+ * @return Number of entries, or -1 if the box is too small
+ */
+static int64_t ARSTREAM_MP4Source_GetTable (const ARSTREAM_MP4Source_Box_t *box, uint32_t headerSize, uint32_t entrySize, const uint8_t **entries)
+{
+    uint32_t nbEntries;
+    if (box->size < headerSize)
+    {
+        return -1;
+    }
+    nbEntries = ARSTREAM_MP4Source_ReadU32 (box->data + headerSize - 4);
+    if ((box->size - headerSize) / entrySize < nbEntries)
+    {
+        return -1;
+    }
+    *entries = box->data + headerSize;
+    return nbEntries;
+}
+
+static int ARSTREAM_MP4Source_IndexTrack (ARSTREAM_MP4Source_t *source, const ARSTREAM_MP4Source_Box_t *trak)
+{
+    ARSTREAM_MP4Source_Box_t mdhd, stbl, stsz, stco, stsc, stss, stts;
+    const uint8_t *sizes = NULL, *chunks, *stscEntries, *sttsEntries, *stssEntries = NULL;
+    int64_t nbChunks, nbStscEntries, nbSttsEntries, nbSyncSamples = -1;
+    uint32_t timescale, uniformSize, nbSamples, sample, chunk, stscIndex;
+    int isCo64 = 0;
+    uint64_t dts;
+
+    if ((ARSTREAM_MP4Source_FindPath (trak, "mdia/mdhd", &mdhd) != 0) ||
+        (ARSTREAM_MP4Source_FindPath (trak, "mdia/minf/stbl", &stbl) != 0) ||
+        (ARSTREAM_MP4Source_FindBox (&stbl, "stsz", NULL, &stsz) != 0) ||
+        (ARSTREAM_MP4Source_FindBox (&stbl, "stsc", NULL, &stsc) != 0) ||
+        (ARSTREAM_MP4Source_FindBox (&stbl, "stts", NULL, &stts) != 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Missing sample table box");
+        return -1;
+    }
+    if (ARSTREAM_MP4Source_FindBox (&stbl, "stco", NULL, &stco) != 0)
+    {
+        if (ARSTREAM_MP4Source_FindBox (&stbl, "co64", NULL, &stco) != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Missing chunk offsets box");
+            return -1;
+        }
+        isCo64 = 1;
+    }
+
+    /* Timescale : version 1 mdhd has 64 bits creation/modification times */
+    if ((mdhd.size < 24) ||
+        ((mdhd.data [0] == 1) && (mdhd.size < 32)))
+    {
+        return -1;
+    }
+    timescale = ARSTREAM_MP4Source_ReadU32 (mdhd.data + ((mdhd.data [0] == 1) ? 20 : 12));
+    if (timescale == 0)
+    {
+        return -1;
+    }
+
+    /* Sizes : version/flags, sample_size, sample_count, [entry_size] */
+    if (stsz.size < 12)
+    {
+        return -1;
+    }
+    uniformSize = ARSTREAM_MP4Source_ReadU32 (stsz.data + 4);
+    nbSamples = ARSTREAM_MP4Source_ReadU32 (stsz.data + 8);
+    if (uniformSize == 0)
+    {
+        if (ARSTREAM_MP4Source_GetTable (&stsz, 12, 4, &sizes) != nbSamples)
+        {
+            return -1;
+        }
+    }
+    if (nbSamples == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Empty track");
+        return -1;
+    }
+
+    nbChunks = ARSTREAM_MP4Source_GetTable (&stco, 8, isCo64 ? 8 : 4, &chunks);
+    nbStscEntries = ARSTREAM_MP4Source_GetTable (&stsc, 8, 12, &stscEntries);
+    nbSttsEntries = ARSTREAM_MP4Source_GetTable (&stts, 8, 8, &sttsEntries);
+    if (ARSTREAM_MP4Source_FindBox (&stbl, "stss", NULL, &stss) == 0)
+    {
+        nbSyncSamples = ARSTREAM_MP4Source_GetTable (&stss, 8, 4, &stssEntries);
+    }
+    if ((nbChunks <= 0) ||
+        (nbStscEntries <= 0) ||
+        (nbSttsEntries < 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Corrupted sample table");
+        return -1;
+    }
+
+    source->frames = calloc (nbSamples, sizeof (ARSTREAM_MP4Source_Frame_t));
+    if (source->frames == NULL)
+    {
+        return -1;
+    }
+    source->nbFrames = nbSamples;
+
+    /* Sizes and offsets : samples are stored by chunks, stsc gives the number of samples of each run of chunks */
+    sample = 0;
+    stscIndex = 0;
+    for (chunk = 0; (chunk < nbChunks) && (sample < nbSamples); chunk++)
+    {
+        uint64_t offset = isCo64 ? ARSTREAM_MP4Source_ReadU64 (chunks + 8 * chunk) : ARSTREAM_MP4Source_ReadU32 (chunks + 4 * chunk);
+        uint32_t samplesInChunk, i;
+        while ((stscIndex + 1 < nbStscEntries) &&
+               (ARSTREAM_MP4Source_ReadU32 (stscEntries + 12 * (stscIndex + 1)) <= chunk + 1))
+        {
+            stscIndex++;
+        }
+        samplesInChunk = ARSTREAM_MP4Source_ReadU32 (stscEntries + 12 * stscIndex + 4);
+        for (i = 0; (i < samplesInChunk) && (sample < nbSamples); i++, sample++)
+        {
+            uint32_t size = (sizes != NULL) ? ARSTREAM_MP4Source_ReadU32 (sizes + 4 * sample) : uniformSize;
+            if ((offset > source->mapSize) ||
+                (size > source->mapSize - offset))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Sample %u is outside of the file", sample);
+                return -1;
+            }
+            source->frames [sample].data = source->map + offset;
+            source->frames [sample].size = size;
+            if (size > source->maxFrameSize)
+            {
+                source->maxFrameSize = size;
+            }
+            offset += size;
+        }
+    }
+    if (sample < nbSamples)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Chunks only hold %u of the %u samples", sample, nbSamples);
+        return -1;
+    }
+
+    /* Decoding times : runs of (sample_count, sample_delta). Missing entries repeat the last delta */
+    {
+        uint32_t delta = 0;
+        int64_t entry;
+        sample = 0;
+        dts = 0;
+        for (entry = 0; (entry < nbSttsEntries) && (sample < nbSamples); entry++)
+        {
+            uint32_t count = ARSTREAM_MP4Source_ReadU32 (sttsEntries + 8 * entry);
+            uint32_t i;
+            delta = ARSTREAM_MP4Source_ReadU32 (sttsEntries + 8 * entry + 4);
+            for (i = 0; (i < count) && (sample < nbSamples); i++, sample++)
+            {
+                source->frames [sample].timestampUs = (dts / timescale) * 1000000 + ((dts % timescale) * 1000000) / timescale;
+                dts += delta;
+            }
+        }
+        for (; sample < nbSamples; sample++)
+        {
+            source->frames [sample].timestampUs = (dts / timescale) * 1000000 + ((dts % timescale) * 1000000) / timescale;
+            dts += delta;
+        }
+        source->durationUs = (dts / timescale) * 1000000 + ((dts % timescale) * 1000000) / timescale;
+    }
+
+    /* Key frames : no stss means that every sample is a sync sample */
+    if (nbSyncSamples < 0)
+    {
+        for (sample = 0; sample < nbSamples; sample++)
+        {
+            source->frames [sample].isKeyFrame = 1;
+        }
+    }
+    else
+    {
+        int64_t entry;
+        for (entry = 0; entry < nbSyncSamples; entry++)
+        {
+            uint32_t number = ARSTREAM_MP4Source_ReadU32 (stssEntries + 4 * entry);
+            if ((number >= 1) &&
+                (number <= nbSamples))
+            {
+                source->frames [number - 1].isKeyFrame = 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Implementation
+ */
+
+ARSTREAM_MP4Source_t* ARSTREAM_MP4Source_New (const char *path)
+{
+    ARSTREAM_MP4Source_t *retSource = NULL;
+    ARSTREAM_MP4Source_Box_t file, moov, trak, hdlr;
+    struct stat fileStat;
+    int found = 0;
+
+    if (path == NULL)
+    {
+        return NULL;
+    }
+    retSource = calloc (1, sizeof (ARSTREAM_MP4Source_t));
+    if (retSource == NULL)
+    {
+        return NULL;
+    }
+    retSource->map = MAP_FAILED;
+
+    retSource->fd = open (path, O_RDONLY);
+    if ((retSource->fd < 0) ||
+        (fstat (retSource->fd, &fileStat) != 0) ||
+        (fileStat.st_size <= 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to open %s", path);
+        ARSTREAM_MP4Source_Delete (&retSource);
+        return NULL;
+    }
+    retSource->mapSize = fileStat.st_size;
+    retSource->map = mmap (NULL, retSource->mapSize, PROT_READ, MAP_PRIVATE, retSource->fd, 0);
+    if (retSource->map == MAP_FAILED)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to map %s", path);
+        ARSTREAM_MP4Source_Delete (&retSource);
+        return NULL;
+    }
+    // Frames are read in order
+    madvise (retSource->map, retSource->mapSize, MADV_SEQUENTIAL);
+
+    /* First video track of the movie */
+    file.data = retSource->map;
+    file.size = retSource->mapSize;
+    if (ARSTREAM_MP4Source_FindBox (&file, "moov", NULL, &moov) == 0)
+    {
+        const ARSTREAM_MP4Source_Box_t *after = NULL;
+        while ((found == 0) &&
+               (ARSTREAM_MP4Source_FindBox (&moov, "trak", after, &trak) == 0))
+        {
+            // hdlr : version/flags, pre_defined, handler_type
+            if ((ARSTREAM_MP4Source_FindPath (&trak, "mdia/hdlr", &hdlr) == 0) &&
+                (hdlr.size >= 12) &&
+                (memcmp (hdlr.data + 8, "vide", 4) == 0))
+            {
+                found = 1;
+            }
+            after = &trak;
+        }
+    }
+    if (found == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "No video track in %s", path);
+        ARSTREAM_MP4Source_Delete (&retSource);
+        return NULL;
+    }
+
+    if (ARSTREAM_MP4Source_IndexTrack (retSource, &trak) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to index the video track of %s", path);
+        ARSTREAM_MP4Source_Delete (&retSource);
+        return NULL;
+    }
+
+    return retSource;
+}
+
+void ARSTREAM_MP4Source_Delete (ARSTREAM_MP4Source_t **source)
+{
+    if ((source != NULL) &&
+        (*source != NULL))
+    {
+        if ((*source)->map != MAP_FAILED)
+        {
+            munmap ((*source)->map, (*source)->mapSize);
+        }
+        if ((*source)->fd >= 0)
+        {
+            close ((*source)->fd);
+        }
+        free ((*source)->frames);
+        free (*source);
+        *source = NULL;
+    }
+}
+
+uint32_t ARSTREAM_MP4Source_GetNbFrames (ARSTREAM_MP4Source_t *source)
+{
+    return (source != NULL) ? source->nbFrames : 0;
+}
+
+uint32_t ARSTREAM_MP4Source_GetMaxFrameSize (ARSTREAM_MP4Source_t *source)
+{
+    return (source != NULL) ? source->maxFrameSize : 0;
+}
+
+uint64_t ARSTREAM_MP4Source_GetDurationUs (ARSTREAM_MP4Source_t *source)
+{
+    return (source != NULL) ? source->durationUs : 0;
+}
+
+int ARSTREAM_MP4Source_GetFrame (ARSTREAM_MP4Source_t *source, uint32_t index, ARSTREAM_MP4Source_Frame_t *frame)
+{
+    if ((source == NULL) ||
+        (frame == NULL) ||
+        (index >= source->nbFrames))
+    {
+        return -1;
+    }
+    *frame = source->frames [index];
+    return 0;
+}
+
+uint32_t ARSTREAM_MP4Source_GetNextKeyFrame (ARSTREAM_MP4Source_t *source, uint32_t index)
+{
+    uint32_t i;
+    if ((source == NULL) ||
+        (source->nbFrames == 0))
+    {
+        return 0;
+    }
+    for (i = 0; i < source->nbFrames; i++)
+    {
+        uint32_t candidate = (index + i) % source->nbFrames;
+        if (source->frames [candidate].isKeyFrame != 0)
+        {
+            return candidate;
+        }
+    }
+    return index % source->nbFrames;
+}
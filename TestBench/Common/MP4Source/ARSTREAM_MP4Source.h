@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_MP4Source.h
+ * @brief Memory mapped mp4 frame source
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_MP4SOURCE_H_
+#define _ARSTREAM_MP4SOURCE_H_
+
+#include <inttypes.h>
+
+/**
+ * @brief A mp4 file, mapped in memory, with the sample table of its first video track
+ *
+ * The sample tables (stsz, stco/co64, stsc, stss, stts) are parsed once, when the source is created.
+ * Frames are then pointers into the mapping : they can be given to ARSTREAM_Sender_SendNewFrame
+ * without any copy, and stay valid until the source is deleted.
+ * The mapping is read-only : filters of the sender must not work in place.
+ */
+typedef struct ARSTREAM_MP4Source ARSTREAM_MP4Source_t;
+
+/**
+ * @brief A frame (mp4 sample) of the source
+ */
+typedef struct {
+    uint8_t *data; /**< Pointer into the (read-only) mapping */
+    uint32_t size; /**< Size of the frame, in bytes */
+    uint64_t timestampUs; /**< Decoding time of the frame, from the first frame of the file */
+    int isKeyFrame; /**< Sync sample (1) or not (0) */
+} ARSTREAM_MP4Source_Frame_t;
+
+/**
+ * @brief Maps a mp4 file and indexes the samples of its first video track
+ * @param path Path of the mp4 file
+ * @return A new source, or NULL if the file can not be mapped or has no usable video track
+ */
+ARSTREAM_MP4Source_t* ARSTREAM_MP4Source_New (const char *path);
+
+/**
+ * @brief Unmaps the file and frees the index
+ * @param source Pointer to the source to delete (set to NULL)
+ * @warning Frames got from the source are no longer valid
+ */
+void ARSTREAM_MP4Source_Delete (ARSTREAM_MP4Source_t **source);
+
+/**
+ * @brief Gets the number of frames of the source
+ */
+uint32_t ARSTREAM_MP4Source_GetNbFrames (ARSTREAM_MP4Source_t *source);
+
+/**
+ * @brief Gets the size of the largest frame of the source
+ */
+uint32_t ARSTREAM_MP4Source_GetMaxFrameSize (ARSTREAM_MP4Source_t *source);
+
+/**
+ * @brief Gets the duration of the source (timestamp of the last frame plus its duration)
+ * Used to keep the timestamps increasing when looping through the file
+ */
+uint64_t ARSTREAM_MP4Source_GetDurationUs (ARSTREAM_MP4Source_t *source);
+
+/**
+ * @brief Gets a frame of the source
+ * @param source The source
+ * @param index Index of the frame (0 to GetNbFrames - 1)
+ * @param[out] frame Frame description
+ * @return 0 if the frame exists, -1 otherwise
+ */
+int ARSTREAM_MP4Source_GetFrame (ARSTREAM_MP4Source_t *source, uint32_t index, ARSTREAM_MP4Source_Frame_t *frame);
+
+/**
+ * @brief Gets the index of the first key frame at or after a given index
+ * Looks from the beginning of the file if there is no key frame after index
+ * @param source The source
+ * @param index Index to start from
+ * @return The index of the key frame
+ */
+uint32_t ARSTREAM_MP4Source_GetNextKeyFrame (ARSTREAM_MP4Source_t *source, uint32_t index);
+
+#endif /* _ARSTREAM_MP4SOURCE_H_ */
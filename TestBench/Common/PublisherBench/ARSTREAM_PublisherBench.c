@@ -0,0 +1,602 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_PublisherBench.c
+ * @brief Shares a loopback stream between consumers of different speeds through an ARSTREAM_Publisher_t
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_PublisherBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_PublisherBench"
+
+#define DEFAULT_NB_FRAMES (600)
+#define DEFAULT_FPS (100)
+#define DEFAULT_FRAME_SIZE (20000)
+#define FRAG_SIZE (1400)
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define FLUSH_PERIOD (30)
+#define HEADER_SIZE (4)
+#define DRAIN_TIME_MS (500)
+#define POP_TIMEOUT_MS (100)
+
+#define NB_SUBSCRIBERS (3)
+
+/*
+ * Exhausted pool scenario : frames bigger than the pool buffers, whose only grown buffer is held by a subscriber
+ */
+#define EXHAUSTED_NB_BUFFERS (2)
+#define EXHAUSTED_BUFFER_CAPACITY (100)
+#define EXHAUSTED_FRAME_SIZE (3 * FRAG_SIZE)
+#define EXHAUSTED_NB_FRAMES (20)
+#define EXHAUSTED_FPS (50)
+#define EXHAUSTED_MAX_CPU_PERCENT (50)
+/**
+ * Pool size : the queues of all subscribers, the frame each subscriber is processing, the reader buffer, and a spare one
+ */
+#define PUBLISHER_NB_BUFFERS (2 + 8 + 4 + NB_SUBSCRIBERS + 1 + 1)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief A consumer of the published frames
+ */
+typedef struct {
+    const char *name;
+    int queueDepth;
+    eARSTREAM_PUBLISHER_DROP_POLICY dropPolicy;
+    int processingTimeMs; /**< Time spent on each frame before releasing it */
+    ARSTREAM_Publisher_Subscriber_t *subscriber;
+    ARSAL_Thread_t thread;
+    volatile int stop;
+    /* Results */
+    int nbConsumed;
+    int nbDropped;
+    int nbIncomplete;
+    int nbOutOfOrder;
+    int nbCorrupted;
+    int nbMissingFlush; /**< Frames delivered after a drop without being a flush frame (DROP_UNTIL_FLUSH_FRAME only) */
+} ARSTREAM_PublisherBench_Consumer_t;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_PublisherBench_GetTimeNs (void);
+static void ARSTREAM_PublisherBench_SleepMs (int ms);
+static void ARSTREAM_PublisherBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static void* ARSTREAM_PublisherBench_ConsumerThread (void *param);
+static void ARSTREAM_PublisherBench_SendFrames (ARSTREAM_Sender_t *sender, uint8_t *frame, int frameSize, int firstFrameNumber, int nbFrames, int fps);
+static int ARSTREAM_PublisherBench_RunExhaustedPool (void);
+static void ARSTREAM_PublisherBench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_PublisherBench_GetTimeNs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void ARSTREAM_PublisherBench_SleepMs (int ms)
+{
+    struct timespec wait = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep (&wait, NULL);
+}
+
+static void ARSTREAM_PublisherBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static void* ARSTREAM_PublisherBench_ConsumerThread (void *param)
+{
+    ARSTREAM_PublisherBench_Consumer_t *consumer = (ARSTREAM_PublisherBench_Consumer_t *)param;
+    uint32_t lastIndex = 0, lastFrameNumber = 0;
+    int hasLast = 0;
+
+    while (consumer->stop == 0)
+    {
+        int nbDropped = 0;
+        const ARSTREAM_Publisher_Frame_t *frame = ARSTREAM_Publisher_PopFrame (consumer->subscriber, POP_TIMEOUT_MS, &nbDropped);
+        consumer->nbDropped += nbDropped;
+        if (frame == NULL)
+        {
+            continue;
+        }
+
+        consumer->nbConsumed++;
+        if (frame->isIncomplete != 0)
+        {
+            consumer->nbIncomplete++;
+        }
+        if ((nbDropped > 0) &&
+            (consumer->dropPolicy == ARSTREAM_PUBLISHER_DROP_UNTIL_FLUSH_FRAME) &&
+            (frame->isFlushFrame == 0))
+        {
+            consumer->nbMissingFlush++;
+        }
+        if ((frame->isIncomplete == 0) &&
+            (frame->size >= HEADER_SIZE))
+        {
+            uint32_t frameNumber, i;
+            memcpy (&frameNumber, frame->data, HEADER_SIZE);
+            if ((hasLast != 0) &&
+                ((frame->index <= lastIndex) ||
+                 (frameNumber <= lastFrameNumber)))
+            {
+                consumer->nbOutOfOrder++;
+            }
+            lastIndex = frame->index;
+            lastFrameNumber = frameNumber;
+            hasLast = 1;
+
+            if (consumer->processingTimeMs > 0)
+            {
+                ARSTREAM_PublisherBench_SleepMs (consumer->processingTimeMs);
+            }
+            /* Checked after the processing time : the buffer must not have been reused meanwhile */
+            for (i = HEADER_SIZE; i < frame->size; i++)
+            {
+                if (frame->data [i] != (uint8_t)(frameNumber + i))
+                {
+                    consumer->nbCorrupted++;
+                    break;
+                }
+            }
+        }
+        ARSTREAM_Publisher_ReleaseFrame (frame);
+    }
+    return NULL;
+}
+
+static void ARSTREAM_PublisherBench_SendFrames (ARSTREAM_Sender_t *sender, uint8_t *frame, int frameSize, int firstFrameNumber, int nbFrames, int fps)
+{
+    uint64_t periodNs = 1000000000ULL / fps;
+    uint64_t startNs = ARSTREAM_PublisherBench_GetTimeNs ();
+    int i, j;
+    for (i = 0; i < nbFrames; i++)
+    {
+        uint64_t targetNs = startNs + i * periodNs;
+        uint64_t nowNs = ARSTREAM_PublisherBench_GetTimeNs ();
+        uint32_t frameNumber = firstFrameNumber + i;
+        if (targetNs > nowNs)
+        {
+            struct timespec wait = { (time_t)((targetNs - nowNs) / 1000000000ULL), (long)((targetNs - nowNs) % 1000000000ULL) };
+            nanosleep (&wait, NULL);
+        }
+        memcpy (frame, &frameNumber, HEADER_SIZE);
+        for (j = HEADER_SIZE; j < frameSize; j++)
+        {
+            frame [j] = (uint8_t)(frameNumber + j);
+        }
+        ARSTREAM_Sender_SendNewFrame (sender, frame, frameSize, (i == 0) ? 1 : 0, NULL);
+    }
+}
+
+/**
+ * Every buffer of the pool is held by a subscriber (or too small) while the reader needs a bigger one.
+ * The reader must skip the frames and keep reading, without spinning on its data thread, and must
+ * publish again once the subscriber releases its frame.
+ */
+static int ARSTREAM_PublisherBench_RunExhaustedPool (void)
+{
+    ARSTREAM_Publisher_t *publisher = NULL;
+    ARSTREAM_Publisher_Subscriber_t *subscriber = NULL;
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    ARSTREAM_Reader_Stats_t stats;
+    const ARSTREAM_Publisher_Frame_t *frame;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffer = malloc (EXHAUSTED_FRAME_SIZE);
+    uint8_t *firstBuffer;
+    uint32_t firstBufferCapacity = 0;
+    struct timespec cpuStart, cpuEnd;
+    uint64_t wallStartNs, wallNs, cpuNs;
+    int nbHeld = 0, nbDroppedHeld, nbPublishedAfter = 0;
+    int nbErrors = 0;
+
+    publisher = ARSTREAM_Publisher_New (EXHAUSTED_NB_BUFFERS, EXHAUSTED_BUFFER_CAPACITY, &err);
+    if (publisher != NULL)
+    {
+        subscriber = ARSTREAM_Publisher_Subscribe (publisher, EXHAUSTED_NB_FRAMES, ARSTREAM_PUBLISHER_DROP_NEWEST, &err);
+    }
+    if ((sendBuffer == NULL) ||
+        (subscriber == NULL))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the publisher : %s", ARSTREAM_Error_ToString (err));
+        nbErrors++;
+    }
+    if (nbErrors == 0)
+    {
+        firstBuffer = ARSTREAM_Publisher_GetFirstBuffer (publisher, &firstBufferCapacity);
+        loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, FRAG_SIZE, &err);
+        if (loopback != NULL)
+        {
+            sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_PublisherBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, FRAG_SIZE, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_Publisher_FrameCompleteCallback, firstBuffer, firstBufferCapacity, FRAG_SIZE, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, publisher, &err);
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+
+    if (nbErrors == 0)
+    {
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        /* The subscriber does not pop : the first published frame holds the only grown buffer */
+        clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &cpuStart);
+        wallStartNs = ARSTREAM_PublisherBench_GetTimeNs ();
+        ARSTREAM_PublisherBench_SendFrames (sender, sendBuffer, EXHAUSTED_FRAME_SIZE, 0, EXHAUSTED_NB_FRAMES, EXHAUSTED_FPS);
+        ARSTREAM_PublisherBench_SleepMs (DRAIN_TIME_MS);
+        clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &cpuEnd);
+        wallNs = ARSTREAM_PublisherBench_GetTimeNs () - wallStartNs;
+        cpuNs = (uint64_t)(cpuEnd.tv_sec - cpuStart.tv_sec) * 1000000000ULL + cpuEnd.tv_nsec - cpuStart.tv_nsec;
+        ARSTREAM_Reader_GetStats (reader, &stats);
+        nbDroppedHeld = ARSTREAM_Publisher_GetNumberOfDroppedFrames (publisher);
+        printf ("Exhausted pool : %d frames sent, %u fragments received, %u frames complete, %d frames dropped by the publisher, cpu %d%%\n",
+                EXHAUSTED_NB_FRAMES, stats.nbFragmentsReceived, stats.nbFramesComplete, nbDroppedHeld, (int)(cpuNs * 100 / wallNs));
+        if (cpuNs * 100 > wallNs * EXHAUSTED_MAX_CPU_PERCENT)
+        {
+            // The library threads can not be stopped: leave them to the process exit
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "The reader spins while no pool buffer is free");
+            free (sendBuffer);
+            return 1;
+        }
+        if ((stats.nbFragmentsReceived < (uint32_t)(EXHAUSTED_NB_FRAMES * (EXHAUSTED_FRAME_SIZE / FRAG_SIZE))) ||
+            (nbDroppedHeld == 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "The reader did not keep reading and skipping frames while the pool was exhausted");
+            nbErrors++;
+        }
+
+        /* Release the held frames : the reader must publish again */
+        while ((frame = ARSTREAM_Publisher_PopFrame (subscriber, 0, NULL)) != NULL)
+        {
+            nbHeld++;
+            ARSTREAM_Publisher_ReleaseFrame (frame);
+        }
+        ARSTREAM_PublisherBench_SendFrames (sender, sendBuffer, EXHAUSTED_FRAME_SIZE, EXHAUSTED_NB_FRAMES, EXHAUSTED_NB_FRAMES, EXHAUSTED_FPS);
+        ARSTREAM_PublisherBench_SleepMs (DRAIN_TIME_MS);
+        while ((frame = ARSTREAM_Publisher_PopFrame (subscriber, 0, NULL)) != NULL)
+        {
+            uint32_t frameNumber;
+            memcpy (&frameNumber, frame->data, HEADER_SIZE);
+            if ((frame->size == EXHAUSTED_FRAME_SIZE) &&
+                (frameNumber >= EXHAUSTED_NB_FRAMES))
+            {
+                nbPublishedAfter++;
+            }
+            ARSTREAM_Publisher_ReleaseFrame (frame);
+        }
+        printf ("Exhausted pool : %d frames held by the subscriber, %d frames published after their release\n", nbHeld, nbPublishedAfter);
+        if ((nbHeld == 0) ||
+            (nbPublishedAfter == 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "The reader did not publish again once the pool buffers were released");
+            nbErrors++;
+        }
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+    }
+
+    if (subscriber != NULL)
+    {
+        ARSTREAM_Publisher_Unsubscribe (&subscriber);
+    }
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    if (publisher != NULL)
+    {
+        /* COPY_COMPLETE must have given back every buffer the reader dropped, and none it still used */
+        err = ARSTREAM_Publisher_Delete (&publisher);
+        if (err != ARSTREAM_OK)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to delete the publisher after the exhausted pool scenario : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+    free (sendBuffer);
+    return nbErrors;
+}
+
+static void ARSTREAM_PublisherBench_Usage (const char *name)
+{
+    printf ("Usage: %s [-n nbFrames] [-r fps] [-s frameSize] [-l lossPercent]\n", name);
+    printf ("  -n : number of frames to send (default %d)\n", DEFAULT_NB_FRAMES);
+    printf ("  -r : frame rate (default %d), one flush frame every %d frames\n", DEFAULT_FPS, FLUSH_PERIOD);
+    printf ("  -s : frame size in bytes (default %d)\n", DEFAULT_FRAME_SIZE);
+    printf ("  -l : loss rate in percent, applied to both directions with fixed seeds\n");
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_PublisherBench_Main (int argc, char *argv[])
+{
+    ARSTREAM_PublisherBench_Consumer_t consumers [NB_SUBSCRIBERS] = {
+        { .name = "display", .queueDepth = 2, .dropPolicy = ARSTREAM_PUBLISHER_DROP_OLDEST, .processingTimeMs = 0 },
+        { .name = "recorder", .queueDepth = 8, .dropPolicy = ARSTREAM_PUBLISHER_DROP_NEWEST, .processingTimeMs = 5 },
+        { .name = "analytics", .queueDepth = 4, .dropPolicy = ARSTREAM_PUBLISHER_DROP_UNTIL_FLUSH_FRAME, .processingTimeMs = 40 },
+    };
+    ARSTREAM_Publisher_t *publisher = NULL;
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    ARSTREAM_Impairment_Config_t dataImpairment, ackImpairment;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint8_t *firstBuffer;
+    uint32_t firstBufferCapacity = 0;
+    uint64_t startNs, periodNs;
+    int nbFrames = DEFAULT_NB_FRAMES;
+    int fps = DEFAULT_FPS;
+    int frameSize = DEFAULT_FRAME_SIZE;
+    double lossPercent = 0.;
+    int nbErrors = 0;
+    int badArgs = 0;
+    int opt, i, j;
+
+    while ((opt = getopt (argc, argv, "n:r:s:l:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': nbFrames = atoi (optarg); break;
+        case 'r': fps = atoi (optarg); break;
+        case 's': frameSize = atoi (optarg); break;
+        case 'l': lossPercent = atof (optarg); break;
+        default:
+            badArgs = 1;
+            break;
+        }
+    }
+    if ((badArgs != 0) ||
+        (nbFrames <= 0) ||
+        (fps <= 0) ||
+        (frameSize < HEADER_SIZE) ||
+        (frameSize > FRAG_SIZE * MAX_NB_FRAG))
+    {
+        ARSTREAM_PublisherBench_Usage (argv[0]);
+        return 1;
+    }
+
+    memset (sendBuffers, 0, sizeof (sendBuffers));
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (frameSize);
+        if (sendBuffers [i] == NULL)
+        {
+            nbErrors++;
+        }
+    }
+
+    /* Publisher and subscribers */
+    if (nbErrors == 0)
+    {
+        publisher = ARSTREAM_Publisher_New (PUBLISHER_NB_BUFFERS, frameSize, &err);
+        if (publisher == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the publisher : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+    for (i = 0; (nbErrors == 0) && (i < NB_SUBSCRIBERS); i++)
+    {
+        consumers [i].subscriber = ARSTREAM_Publisher_Subscribe (publisher, consumers [i].queueDepth, consumers [i].dropPolicy, &err);
+        if (consumers [i].subscriber == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to subscribe %s : %s", consumers [i].name, ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+
+    /* Library objects : the reader fills the buffers of the publisher */
+    if (nbErrors == 0)
+    {
+        firstBuffer = ARSTREAM_Publisher_GetFirstBuffer (publisher, &firstBufferCapacity);
+        loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, FRAG_SIZE, &err);
+        if (loopback != NULL)
+        {
+            sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_PublisherBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, FRAG_SIZE, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_Publisher_FrameCompleteCallback, firstBuffer, firstBufferCapacity, FRAG_SIZE, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, publisher, &err);
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+
+    if (nbErrors == 0)
+    {
+        if (lossPercent > 0.)
+        {
+            ARSTREAM_Impairment_DefaultConfig (&dataImpairment);
+            ARSTREAM_Impairment_DefaultConfig (&ackImpairment);
+            dataImpairment.lossPercent = (float)lossPercent;
+            ackImpairment.lossPercent = (float)lossPercent;
+            ackImpairment.seed = 2;
+            ARSTREAM_Sender_SetImpairment (sender, &dataImpairment);
+            ARSTREAM_Reader_SetImpairment (reader, &ackImpairment);
+        }
+
+        for (i = 0; i < NB_SUBSCRIBERS; i++)
+        {
+            ARSAL_Thread_Create (&(consumers [i].thread), ARSTREAM_PublisherBench_ConsumerThread, &(consumers [i]));
+        }
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        periodNs = 1000000000ULL / fps;
+        startNs = ARSTREAM_PublisherBench_GetTimeNs ();
+        for (i = 0; i < nbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            uint64_t targetNs = startNs + i * periodNs;
+            uint64_t nowNs = ARSTREAM_PublisherBench_GetTimeNs ();
+            uint32_t frameNumber = i;
+            if (targetNs > nowNs)
+            {
+                struct timespec wait = { (time_t)((targetNs - nowNs) / 1000000000ULL), (long)((targetNs - nowNs) % 1000000000ULL) };
+                nanosleep (&wait, NULL);
+            }
+            memcpy (frame, &frameNumber, HEADER_SIZE);
+            for (j = HEADER_SIZE; j < frameSize; j++)
+            {
+                frame [j] = (uint8_t)(frameNumber + j);
+            }
+            ARSTREAM_Sender_SendNewFrame (sender, frame, frameSize, ((i % FLUSH_PERIOD) == 0) ? 1 : 0, NULL);
+        }
+        ARSTREAM_PublisherBench_SleepMs (DRAIN_TIME_MS);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        for (i = 0; i < NB_SUBSCRIBERS; i++)
+        {
+            consumers [i].stop = 1;
+            ARSAL_Thread_Join (consumers [i].thread, NULL);
+            ARSAL_Thread_Destroy (&(consumers [i].thread));
+        }
+
+        printf ("Config : %d frames of %d bytes at %d fps, loss %.2f%%, %d buffers in the pool\n", nbFrames, frameSize, fps, lossPercent, PUBLISHER_NB_BUFFERS);
+        printf ("Publisher : %d frames dropped (pool exhausted)\n", ARSTREAM_Publisher_GetNumberOfDroppedFrames (publisher));
+        for (i = 0; i < NB_SUBSCRIBERS; i++)
+        {
+            ARSTREAM_PublisherBench_Consumer_t *consumer = &(consumers [i]);
+            printf ("%-10s : depth %d, %3d ms per frame : %d consumed (%d incomplete), %d dropped, %d out of order, %d corrupted, %d missing flush frames\n",
+                    consumer->name, consumer->queueDepth, consumer->processingTimeMs, consumer->nbConsumed, consumer->nbIncomplete, consumer->nbDropped,
+                    consumer->nbOutOfOrder, consumer->nbCorrupted, consumer->nbMissingFlush);
+            nbErrors += consumer->nbOutOfOrder + consumer->nbCorrupted + consumer->nbMissingFlush;
+            if (consumer->nbConsumed == 0)
+            {
+                nbErrors++;
+            }
+        }
+    }
+
+    for (i = 0; i < NB_SUBSCRIBERS; i++)
+    {
+        if (consumers [i].subscriber != NULL)
+        {
+            ARSTREAM_Publisher_Unsubscribe (&(consumers [i].subscriber));
+        }
+    }
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    if (publisher != NULL)
+    {
+        /* Every buffer must be back in the pool once the reader is stopped and the subscribers are gone */
+        err = ARSTREAM_Publisher_Delete (&publisher);
+        if (err != ARSTREAM_OK)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to delete the publisher : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+
+    if (nbErrors == 0)
+    {
+        nbErrors += ARSTREAM_PublisherBench_RunExhaustedPool ();
+    }
+
+    return (nbErrors == 0) ? 0 : 1;
+}
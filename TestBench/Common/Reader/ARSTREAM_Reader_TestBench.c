@@ -42,6 +42,7 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <string.h>
 
 /*
  * ARSDK Headers
@@ -50,8 +51,10 @@
 #include <libARSAL/ARSAL_Print.h>
 #include <libARSAL/ARSAL_Sem.h>
 #include <libARStream/ARSTREAM_Reader.h>
+#include <libARStream/ARSTREAM_JitterBuffer.h>
 
 #include "../ARSTREAM_TB_Config.h"
+#include "../MP4Recorder/ARSTREAM_MP4Recorder.h"
 
 /*
  * Macros
@@ -67,6 +70,8 @@
 #define FRAME_MAX_SIZE (40000)
 
 #define NB_BUFFERS (3)
+#define JITTER_BUFFER_NB_FRAMES (16)
+#define MAX_NB_BUFFERS (NB_BUFFERS + JITTER_BUFFER_NB_FRAMES)
 
 #define __TAG__ "ARSTREAM_Reader_TB"
 
@@ -108,13 +113,18 @@ static ARNETWORK_Manager_t *g_Manager = NULL;
 static ARSTREAM_Reader_t *g_Reader = NULL;
 
 static int currentBufferIndex = 0;
-static uint8_t *multiBuffer[NB_BUFFERS];
-static uint32_t multiBufferSize[NB_BUFFERS];
-static int multiBufferIsFree[NB_BUFFERS];
+static int nbBuffers = NB_BUFFERS;
+static uint8_t *multiBuffer[MAX_NB_BUFFERS];
+static uint32_t multiBufferSize[MAX_NB_BUFFERS];
+static int multiBufferIsFree[MAX_NB_BUFFERS];
+// Buffers are freed by the jitter buffer thread when it is used
+static pthread_mutex_t multiBufferMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static ARSTREAM_JitterBuffer_t *jitterBuffer = NULL;
 
 static char *appName;
 
-static FILE *outFile;
+static ARSTREAM_MP4Recorder_t *recorder;
 
 static filter_ctx fctx[NB_FILTERS] = {};
 static ARSTREAM_Filter_t filters[NB_FILTERS] = {};
@@ -200,6 +210,16 @@ void reallocBuffer (int id, int newSize);
  */
 uint8_t* ARSTREAM_ReaderTb_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
 
+/**
+ * @see ARSTREAM_JitterBuffer.h
+ */
+void ARSTREAM_ReaderTb_JitterBufferCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint64_t timestampUs, void *custom);
+
+/**
+ * @brief Accounts and records a received frame
+ */
+void ARSTREAM_ReaderTb_ProcessFrame (uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame);
+
 /**
  * @brief Gets a free buffer pointer
  * @param[in] buffer the buffer to mark as free
@@ -219,7 +239,7 @@ uint8_t* ARSTREAM_ReaderTb_GetNextFreeBuffer (uint32_t *retSize, int reallocToDo
  * @param manager An initialized network manager
  * @return "Main" return value
  */
-int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char *outPath);
+int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char *outPath, int jitterMaxDelayMs);
 
 /*
  * Internal functions implementation
@@ -227,15 +247,16 @@ int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char
 
 void ARSTREAM_ReaderTb_printUsage ()
 {
-    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Usage : %s [ip] [outFile]", appName);
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Usage : %s [ip] [outFile] [jitterMs]", appName);
     ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        ip -> optionnal, ip of the stream sender");
-    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        outFile -> optionnal (ip must be provided), output file for received stream");
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        outFile -> optionnal (ip must be provided), fragmented mp4 file to record the received stream (H.264) into, or - for none");
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "        jitterMs -> optionnal (outFile must be provided), maximum playout delay of an adaptive jitter buffer between the reader and the frame processing (0 for none)");
 }
 
 void ARSTREAM_ReaderTb_initMultiBuffers (int initialSize)
 {
     int buffIndex;
-    for (buffIndex = 0; buffIndex < NB_BUFFERS; buffIndex++)
+    for (buffIndex = 0; buffIndex < nbBuffers; buffIndex++)
     {
         reallocBuffer (buffIndex, initialSize);
         multiBufferIsFree[buffIndex] = 1;
@@ -251,43 +272,25 @@ void reallocBuffer (int id, int newSize)
 uint8_t* ARSTREAM_ReaderTb_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *buffer)
 {
     uint8_t *retVal = NULL;
-    struct timespec now;
-    int dt;
     buffer = buffer;
     switch (cause)
     {
     case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
-        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Got a frame of size %d, at address %p (isFlush : %d) [%u, %u, %u]", 
-                     frameSize,
-                     framePointer,
-                     isFlushFrame,
-                     framePointer[0],
-                     framePointer[1],
-                     framePointer[2]);
-        if (isFlushFrame != 0)
-            nbRead++;
-        if (numberOfSkippedFrames != 0)
+    case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+        if (jitterBuffer != NULL)
         {
-            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Skipped %d frames", numberOfSkippedFrames);
-            if (numberOfSkippedFrames > 0)
+            // The buffer is given back by ARSTREAM_ReaderTb_JitterBufferCallback
+            if (ARSTREAM_JitterBuffer_PushFrame (jitterBuffer, cause, framePointer, frameSize, numberOfSkippedFrames, isFlushFrame, 0) != ARSTREAM_OK)
             {
-                nbSkipped += numberOfSkippedFrames;
-                nbSkippedSinceLast += numberOfSkippedFrames;
+                ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Jitter buffer is full, dropping frame");
+                ARSTREAM_ReaderTb_SetBufferFree (framePointer);
             }
         }
-        ARSTREAM_Reader_PercentOk = (100.f * nbRead) / (1.f * (nbRead + nbSkipped));
-        if (outFile != NULL)
+        else
         {
-            fwrite (framePointer, 1, frameSize, outFile);
+            ARSTREAM_ReaderTb_ProcessFrame (framePointer, frameSize, numberOfSkippedFrames, isFlushFrame);
+            ARSTREAM_ReaderTb_SetBufferFree (framePointer);
         }
-        ARSAL_Time_GetTime(&now);
-        dt = ARSAL_Time_ComputeTimespecMsTimeDiff(&lastRecv, &now);
-        lastDt [currentIndexInDt] = dt;
-        currentIndexInDt ++;
-        currentIndexInDt %= NB_FRAMES_FOR_AVERAGE;
-        lastRecv.tv_sec = now.tv_sec;
-        lastRecv.tv_nsec = now.tv_nsec;
-        ARSTREAM_ReaderTb_SetBufferFree (framePointer);
         retVal = ARSTREAM_ReaderTb_GetNextFreeBuffer (newBufferCapacity, 0);
         break;
 
@@ -313,16 +316,70 @@ uint8_t* ARSTREAM_ReaderTb_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause,
     return retVal;
 }
 
+void ARSTREAM_ReaderTb_ProcessFrame (uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame)
+{
+    struct timespec now;
+    int dt;
+    ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Got a frame of size %d, at address %p (isFlush : %d) [%u, %u, %u]", 
+                 frameSize,
+                 framePointer,
+                 isFlushFrame,
+                 framePointer[0],
+                 framePointer[1],
+                 framePointer[2]);
+    if (isFlushFrame != 0)
+        nbRead++;
+    if (numberOfSkippedFrames != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Skipped %d frames", numberOfSkippedFrames);
+        if (numberOfSkippedFrames > 0)
+        {
+            nbSkipped += numberOfSkippedFrames;
+            nbSkippedSinceLast += numberOfSkippedFrames;
+        }
+    }
+    ARSTREAM_Reader_PercentOk = (100.f * nbRead) / (1.f * (nbRead + nbSkipped));
+    ARSAL_Time_GetTime(&now);
+    if (recorder != NULL)
+    {
+        // Copied to the recorder ring, written by its own thread
+        ARSTREAM_MP4Recorder_AddFrame (recorder, framePointer, frameSize, (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000, isFlushFrame);
+    }
+    dt = ARSAL_Time_ComputeTimespecMsTimeDiff(&lastRecv, &now);
+    lastDt [currentIndexInDt] = dt;
+    currentIndexInDt ++;
+    currentIndexInDt %= NB_FRAMES_FOR_AVERAGE;
+    lastRecv.tv_sec = now.tv_sec;
+    lastRecv.tv_nsec = now.tv_nsec;
+}
+
+void ARSTREAM_ReaderTb_JitterBufferCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint64_t timestampUs, void *custom)
+{
+    (void)timestampUs;
+    (void)custom;
+    if (cause == ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Frame of size %d is incomplete", frameSize);
+    }
+    if (cause != ARSTREAM_READER_CAUSE_CANCEL)
+    {
+        ARSTREAM_ReaderTb_ProcessFrame (framePointer, frameSize, numberOfSkippedFrames, isFlushFrame);
+    }
+    ARSTREAM_ReaderTb_SetBufferFree (framePointer);
+}
+
 void ARSTREAM_ReaderTb_SetBufferFree (uint8_t *buffer)
 {
     int i;
-    for (i = 0; i < NB_BUFFERS; i++)
+    pthread_mutex_lock (&multiBufferMutex);
+    for (i = 0; i < nbBuffers; i++)
     {
         if (multiBuffer[i] == buffer)
         {
             multiBufferIsFree[i] = 1;
         }
     }
+    pthread_mutex_unlock (&multiBufferMutex);
 }
 
 uint8_t* ARSTREAM_ReaderTb_GetNextFreeBuffer (uint32_t *retSize, int reallocToDouble)
@@ -333,6 +390,7 @@ uint8_t* ARSTREAM_ReaderTb_GetNextFreeBuffer (uint32_t *retSize, int reallocToDo
     {
         return NULL;
     }
+    pthread_mutex_lock (&multiBufferMutex);
     do
     {
         if (multiBufferIsFree[currentBufferIndex] == 1)
@@ -343,27 +401,41 @@ uint8_t* ARSTREAM_ReaderTb_GetNextFreeBuffer (uint32_t *retSize, int reallocToDo
             }
             retBuffer = multiBuffer[currentBufferIndex];
             *retSize = multiBufferSize[currentBufferIndex];
+            multiBufferIsFree[currentBufferIndex] = 0;
         }
-        currentBufferIndex = (currentBufferIndex + 1) % NB_BUFFERS;
+        currentBufferIndex = (currentBufferIndex + 1) % nbBuffers;
         nbtest++;
-    } while (retBuffer == NULL && nbtest < NB_BUFFERS);
+    } while (retBuffer == NULL && nbtest < nbBuffers);
+    pthread_mutex_unlock (&multiBufferMutex);
     return retBuffer;
 }
 
-int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char *outPath)
+int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char *outPath, int jitterMaxDelayMs)
 {
     int retVal = 0;
 
     uint8_t *firstFrame;
     uint32_t firstFrameSize;
     eARSTREAM_ERROR err;
+    recorder = NULL;
     if (NULL != outPath)
     {
-        outFile = fopen (outPath, "wb");
+        ARSTREAM_MP4Recorder_Config_t recorderConfig = {
+            .path = outPath,
+        };
+        recorder = ARSTREAM_MP4Recorder_New (&recorderConfig);
     }
-    else
+    pthread_t jitterThread;
+    if (jitterMaxDelayMs > 0)
     {
-        outFile = NULL;
+        jitterBuffer = ARSTREAM_JitterBuffer_New (ARSTREAM_ReaderTb_JitterBufferCallback, JITTER_BUFFER_NB_FRAMES, ARSTREAM_JITTER_BUFFER_MIN_DELAY_MS_DEFAULT, jitterMaxDelayMs, NULL, &err);
+        if (jitterBuffer == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Error during ARSTREAM_JitterBuffer_New call : %s", ARSTREAM_Error_ToString(err));
+            return 1;
+        }
+        nbBuffers = MAX_NB_BUFFERS;
+        pthread_create (&jitterThread, NULL, ARSTREAM_JitterBuffer_RunThread, jitterBuffer);
     }
     ARSTREAM_ReaderTb_initMultiBuffers (FRAME_MAX_SIZE);
     ARSAL_Sem_Init (&closeSem, 0, 0);
@@ -376,6 +448,7 @@ int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char
     }
 
     ARSTREAM_ReaderTB_AddFilters();
+    ARSTREAM_Reader_SetKeyFrameRequests (g_Reader, 1, ARSTREAM_READER_KEY_FRAME_REQUEST_INTERVAL_DEFAULT_MS);
 
     pthread_t streamsend, streamread;
     pthread_create (&streamsend, NULL, ARSTREAM_Reader_RunDataThread, g_Reader);
@@ -394,8 +467,38 @@ int ARSTREAM_ReaderTb_StartStreamTest (ARNETWORK_Manager_t *manager, const char
     pthread_join (streamread, NULL);
     pthread_join (streamsend, NULL);
 
+    if (jitterBuffer != NULL)
+    {
+        ARSTREAM_JitterBuffer_Stats_t jitterStats;
+        ARSTREAM_JitterBuffer_Stop (jitterBuffer);
+        pthread_join (jitterThread, NULL);
+        if (ARSTREAM_JitterBuffer_GetStats (jitterBuffer, &jitterStats) == ARSTREAM_OK)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Jitter buffer : %u frames in, %u out, %u rejected, %u late (max %u us), jitter %u us, playout delay %u us",
+                         jitterStats.nbFramesIn, jitterStats.nbFramesOut, jitterStats.nbFramesRejected, jitterStats.nbLateFrames, jitterStats.maxLatenessUs, jitterStats.jitterUs, jitterStats.targetDelayUs);
+        }
+        ARSTREAM_JitterBuffer_Delete (&jitterBuffer);
+    }
+
+    ARSTREAM_Reader_FreezeStats_t freezeStats;
+    if (ARSTREAM_Reader_GetFreezeStats (g_Reader, &freezeStats) == ARSTREAM_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "First frame after %u ms, %u freezes (total %u ms, max %u ms), %u key frame requests",
+                     freezeStats.firstFrameDelayMs, freezeStats.nbFreezes, freezeStats.totalFreezeMs, freezeStats.maxFreezeMs, freezeStats.nbKeyFrameRequests);
+    }
+
     ARSTREAM_Reader_Delete (&g_Reader);
 
+    if (recorder != NULL)
+    {
+        ARSTREAM_MP4Recorder_Stats_t recorderStats;
+        ARSTREAM_MP4Recorder_Stop (recorder);
+        ARSTREAM_MP4Recorder_GetStats (recorder, &recorderStats);
+        ARSTREAM_MP4Recorder_Delete (&recorder);
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Recorded %u frames in %u fragments, %u dropped, %u before the first key frame",
+                     recorderStats.nbFramesRecorded, recorderStats.nbFragments, recorderStats.nbFramesDropped, recorderStats.nbFramesSkipped);
+    }
+
     ARSAL_Sem_Destroy (&closeSem);
 
     return retVal;
@@ -409,7 +512,7 @@ int ARSTREAM_Reader_TestBenchMain (int argc, char *argv[])
 {
     int retVal = 0;
     appName = argv[0];
-    if (argc > 3)
+    if (argc > 4)
     {
         ARSTREAM_ReaderTb_printUsage ();
         return 1;
@@ -417,15 +520,21 @@ int ARSTREAM_Reader_TestBenchMain (int argc, char *argv[])
 
     char *ip = __IP;
     char *outPath = NULL;
+    int jitterMaxDelayMs = 0;
 
     if (argc >= 2)
     {
         ip = argv[1];
     }
-    if (argc >= 3)
+    if ((argc >= 3) &&
+        (strcmp (argv[2], "-") != 0))
     {
         outPath = argv[2];
     }
+    if (argc >= 4)
+    {
+        jitterMaxDelayMs = atoi (argv[3]);
+    }
 
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "IP = %s", ip);
 
@@ -470,7 +579,7 @@ int ARSTREAM_Reader_TestBenchMain (int argc, char *argv[])
     pthread_create (&netsend, NULL, ARNETWORK_Manager_SendingThreadRun, g_Manager);
     pthread_create (&netread, NULL, ARNETWORK_Manager_ReceivingThreadRun, g_Manager);
 
-    retVal = ARSTREAM_ReaderTb_StartStreamTest (g_Manager, outPath);
+    retVal = ARSTREAM_ReaderTb_StartStreamTest (g_Manager, outPath, jitterMaxDelayMs);
 
     ARNETWORK_Manager_Stop (g_Manager);
 
@@ -0,0 +1,357 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_ReentrancyBench.c
+ * @brief Calls the functions which are documented as callable from the callbacks, from inside the callbacks
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_ReentrancyBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_ReentrancyBench"
+
+#define DEFAULT_NB_FRAMES (300)
+#define DEFAULT_FPS (100)
+#define FRAME_SIZE (8000)
+#define FRAG_SIZE (1400)
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define GOP_LENGTH (30)
+#define REQUEST_PERIOD (10)
+#define KEY_FRAME_REQUEST_INTERVAL_MS (20)
+#define WATCHDOG_MS (2000)
+#define DRAIN_TIME_MS (300)
+
+/*
+ * Globals
+ */
+
+static ARSTREAM_Sender_t *g_Sender = NULL;
+static ARSTREAM_Reader_t *g_Reader = NULL;
+static uint8_t *g_RecvBuffer = NULL;
+static pthread_mutex_t g_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static int g_NbFramesReceived = 0;
+static int g_NbCallsFromCallbacks = 0;
+static int g_NbSenderStatsCalls = 0;
+static int g_NbKeyFrameRequests [ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_MAX];
+static int g_ForceFlushFrame = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_ReentrancyBench_GetTimeNs (void);
+static void ARSTREAM_ReentrancyBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_ReentrancyBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static void ARSTREAM_ReentrancyBench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_ReentrancyBench_GetTimeNs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void ARSTREAM_ReentrancyBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)framePointer;
+    (void)custom;
+    if (((status == ARSTREAM_SENDER_STATUS_FRAME_SENT) ||
+         (status == ARSTREAM_SENDER_STATUS_FRAME_CANCEL)) &&
+        (g_Sender != NULL))
+    {
+        /* Called with the sender ackMutex (FRAME_SENT) or nextFrameMutex (queue flush) held */
+        ARSTREAM_Sender_Stats_t stats;
+        ARSTREAM_Sender_GetStats (g_Sender, &stats);
+        ARSTREAM_Sender_GetEstimatedEfficiency (g_Sender);
+        pthread_mutex_lock (&g_Mutex);
+        g_NbCallsFromCallbacks += 2;
+        g_NbSenderStatsCalls++;
+        pthread_mutex_unlock (&g_Mutex);
+    }
+    else if (status == ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST)
+    {
+        pthread_mutex_lock (&g_Mutex);
+        if (frameSize < ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_MAX)
+        {
+            g_NbKeyFrameRequests [frameSize]++;
+        }
+        g_ForceFlushFrame = 1;
+        pthread_mutex_unlock (&g_Mutex);
+    }
+}
+
+static uint8_t* ARSTREAM_ReentrancyBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)framePointer;
+    (void)frameSize;
+    (void)numberOfSkippedFrames;
+    (void)isFlushFrame;
+    (void)custom;
+    if (cause == ARSTREAM_READER_CAUSE_FRAME_COMPLETE)
+    {
+        int nbReceived;
+        pthread_mutex_lock (&g_Mutex);
+        nbReceived = ++g_NbFramesReceived;
+        pthread_mutex_unlock (&g_Mutex);
+
+        if ((nbReceived % REQUEST_PERIOD) == 0)
+        {
+            ARSTREAM_Reader_FreezeStats_t freezeStats;
+            ARSTREAM_Reader_Stats_t stats;
+            /* Called with the reader ackPacketMutex held */
+            ARSTREAM_Reader_RequestKeyFrame (g_Reader);
+            ARSTREAM_Reader_GetFreezeStats (g_Reader, &freezeStats);
+            ARSTREAM_Reader_GetStats (g_Reader, &stats);
+            ARSTREAM_Reader_GetEstimatedEfficiency (g_Reader);
+            pthread_mutex_lock (&g_Mutex);
+            g_NbCallsFromCallbacks += 4;
+            pthread_mutex_unlock (&g_Mutex);
+        }
+    }
+    *newBufferCapacity = FRAME_SIZE;
+    return g_RecvBuffer;
+}
+
+static void ARSTREAM_ReentrancyBench_Usage (const char *name)
+{
+    printf ("Usage: %s [-n nbFrames] [-r fps] [-l lossPercent]\n", name);
+    printf ("  -n : number of frames to send (default %d)\n", DEFAULT_NB_FRAMES);
+    printf ("  -r : frame rate (default %d)\n", DEFAULT_FPS);
+    printf ("  -l : loss rate in percent, applied to both directions with fixed seeds\n");
+    printf ("  The test fails if no frame is received for %d ms\n", WATCHDOG_MS);
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_ReentrancyBench_Main (int argc, char *argv[])
+{
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    ARSTREAM_Impairment_Config_t dataImpairment, ackImpairment;
+    ARSTREAM_Reader_FreezeStats_t freezeStats;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint64_t startNs, periodNs, lastProgressNs;
+    int nbFrames = DEFAULT_NB_FRAMES;
+    int fps = DEFAULT_FPS;
+    double lossPercent = 0.;
+    int lastNbReceived = 0;
+    int nbErrors = 0;
+    int badArgs = 0;
+    int opt, i;
+
+    while ((opt = getopt (argc, argv, "n:r:l:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': nbFrames = atoi (optarg); break;
+        case 'r': fps = atoi (optarg); break;
+        case 'l': lossPercent = atof (optarg); break;
+        default:
+            badArgs = 1;
+            break;
+        }
+    }
+    if ((badArgs != 0) ||
+        (nbFrames <= 0) ||
+        (fps <= 0))
+    {
+        ARSTREAM_ReentrancyBench_Usage (argv[0]);
+        return 1;
+    }
+
+    memset (sendBuffers, 0, sizeof (sendBuffers));
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = calloc (1, FRAME_SIZE);
+        if (sendBuffers [i] == NULL)
+        {
+            nbErrors++;
+        }
+    }
+    g_RecvBuffer = malloc (FRAME_SIZE);
+    if (g_RecvBuffer == NULL)
+    {
+        nbErrors++;
+    }
+
+    if (nbErrors == 0)
+    {
+        loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, FRAG_SIZE, &err);
+        if (loopback != NULL)
+        {
+            sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_ReentrancyBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, FRAG_SIZE, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_ReentrancyBench_FrameCompleteCallback, g_RecvBuffer, FRAME_SIZE, FRAG_SIZE, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            nbErrors++;
+        }
+    }
+
+    if (nbErrors == 0)
+    {
+        g_Sender = sender;
+        g_Reader = reader;
+        ARSTREAM_Reader_SetKeyFrameRequests (reader, 1, KEY_FRAME_REQUEST_INTERVAL_MS);
+        if (lossPercent > 0.)
+        {
+            ARSTREAM_Impairment_DefaultConfig (&dataImpairment);
+            ARSTREAM_Impairment_DefaultConfig (&ackImpairment);
+            dataImpairment.lossPercent = (float)lossPercent;
+            ackImpairment.lossPercent = (float)lossPercent;
+            ackImpairment.seed = 2;
+            ARSTREAM_Sender_SetImpairment (sender, &dataImpairment);
+            ARSTREAM_Reader_SetImpairment (reader, &ackImpairment);
+        }
+
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        periodNs = 1000000000ULL / fps;
+        startNs = ARSTREAM_ReentrancyBench_GetTimeNs ();
+        lastProgressNs = startNs;
+        for (i = 0; i < nbFrames; i++)
+        {
+            uint64_t targetNs = startNs + i * periodNs;
+            uint64_t nowNs = ARSTREAM_ReentrancyBench_GetTimeNs ();
+            int isFlushFrame, nbReceived;
+            if (targetNs > nowNs)
+            {
+                struct timespec wait = { (time_t)((targetNs - nowNs) / 1000000000ULL), (long)((targetNs - nowNs) % 1000000000ULL) };
+                nanosleep (&wait, NULL);
+                nowNs = targetNs;
+            }
+
+            pthread_mutex_lock (&g_Mutex);
+            isFlushFrame = (((i % GOP_LENGTH) == 0) || (g_ForceFlushFrame != 0)) ? 1 : 0;
+            g_ForceFlushFrame = 0;
+            nbReceived = g_NbFramesReceived;
+            pthread_mutex_unlock (&g_Mutex);
+
+            if (nbReceived != lastNbReceived)
+            {
+                lastNbReceived = nbReceived;
+                lastProgressNs = nowNs;
+            }
+            else if ((nowNs - lastProgressNs) / 1000000ULL > WATCHDOG_MS)
+            {
+                // The library threads can not be stopped: leave them to the process exit
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "No frame received for %d ms (after %d frames) : a call from a callback probably deadlocked", WATCHDOG_MS, nbReceived);
+                printf ("FAILED\n");
+                return 1;
+            }
+            ARSTREAM_Sender_SendNewFrame (sender, sendBuffers [i % NB_SEND_BUFFERS], FRAME_SIZE, isFlushFrame, NULL);
+        }
+        usleep (DRAIN_TIME_MS * 1000);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        ARSTREAM_Reader_GetFreezeStats (reader, &freezeStats);
+        printf ("Frames : %d sent, %d received, %d calls from the callbacks\n", nbFrames, g_NbFramesReceived, g_NbCallsFromCallbacks);
+        printf ("Key frame requests : %u sent by the reader, received by the sender : %d startup, %d loss, %d application\n",
+                freezeStats.nbKeyFrameRequests, g_NbKeyFrameRequests [ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_STARTUP],
+                g_NbKeyFrameRequests [ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_LOSS], g_NbKeyFrameRequests [ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_APPLICATION]);
+        if ((g_NbFramesReceived < REQUEST_PERIOD) ||
+            (g_NbKeyFrameRequests [ARSTREAM_READER_KEY_FRAME_REQUEST_REASON_APPLICATION] == 0))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "The key frame requests made from the reader callback did not reach the sender");
+            nbErrors++;
+        }
+        if (g_NbSenderStatsCalls == 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "The sender statistics were never read from the sender callback");
+            nbErrors++;
+        }
+    }
+
+    g_Sender = NULL;
+    g_Reader = NULL;
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    free (g_RecvBuffer);
+    g_RecvBuffer = NULL;
+
+    printf ("%s\n", (nbErrors == 0) ? "PASSED" : "FAILED");
+    return (nbErrors == 0) ? 0 : 1;
+}
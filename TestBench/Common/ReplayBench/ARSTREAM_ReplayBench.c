@@ -0,0 +1,443 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_ReplayBench.c
+ * @brief Captures the packets received by a stream reader, and replays them to benchmark the reader
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_ReplayBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_ReplayBench"
+
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define DRAIN_TIME_MS (500)
+#define POLL_PERIOD_US (1000)
+#define HEADER_SIZE (4)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    const char *capturePath;
+    int isRecording;
+    int fragSize;
+    /* Recording */
+    int nbFrames;
+    int fps;
+    int frameSize;
+    ARSTREAM_Impairment_Config_t data;
+    /* Replay */
+    eARSTREAM_CAPTURE_REPLAY_MODE mode;
+    int nbIterations;
+} ARSTREAM_ReplayBench_Config_t;
+
+typedef struct {
+    uint64_t nbComplete;
+    uint64_t nbIncomplete;
+    uint64_t nbSkipped;
+    uint64_t nbBytes;
+} ARSTREAM_ReplayBench_Counters_t;
+
+/*
+ * Globals
+ */
+
+static ARSTREAM_ReplayBench_Counters_t g_Counters;
+static uint8_t *g_RecvBuffer = NULL;
+static uint32_t g_RecvBufferSize = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_ReplayBench_GetTimeUs (void);
+static void ARSTREAM_ReplayBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_ReplayBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static int ARSTREAM_ReplayBench_Record (ARSTREAM_ReplayBench_Config_t *config);
+static int ARSTREAM_ReplayBench_ReplayOnce (ARSTREAM_ReplayBench_Config_t *config, uint64_t *elapsedUs, ARSTREAM_Capture_Stats_t *replayStats);
+static int ARSTREAM_ReplayBench_CompareU64 (const void *a, const void *b);
+static int ARSTREAM_ReplayBench_Replay (ARSTREAM_ReplayBench_Config_t *config);
+static void ARSTREAM_ReplayBench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_ReplayBench_GetTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void ARSTREAM_ReplayBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_ReplayBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)framePointer;
+    (void)isFlushFrame;
+    (void)custom;
+    // Only called from the reader data thread
+    switch (cause)
+    {
+    case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+        g_Counters.nbComplete++;
+        g_Counters.nbBytes += frameSize;
+        break;
+    case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+        g_Counters.nbIncomplete++;
+        break;
+    default:
+        break;
+    }
+    if (numberOfSkippedFrames > 0)
+    {
+        g_Counters.nbSkipped += numberOfSkippedFrames;
+    }
+    *newBufferCapacity = g_RecvBufferSize;
+    return g_RecvBuffer;
+}
+
+static int ARSTREAM_ReplayBench_Record (ARSTREAM_ReplayBench_Config_t *config)
+{
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    ARSTREAM_Capture_Stats_t stats;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint64_t startUs, periodUs;
+    int retVal = 0;
+    int i, j;
+
+    memset (&g_Counters, 0, sizeof (g_Counters));
+    g_RecvBufferSize = config->frameSize;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    if (g_RecvBuffer == NULL)
+    {
+        retVal = -1;
+    }
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (config->frameSize);
+        if (sendBuffers [i] != NULL)
+        {
+            for (j = HEADER_SIZE; j < config->frameSize; j++)
+            {
+                sendBuffers [i][j] = (uint8_t)(i + j);
+            }
+        }
+        else
+        {
+            retVal = -1;
+        }
+    }
+
+    if (retVal == 0)
+    {
+        loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, config->fragSize, &err);
+        if (loopback != NULL)
+        {
+            sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_ReplayBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, config->fragSize, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_ReplayBench_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, config->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+    if (retVal == 0)
+    {
+        if ((ARSTREAM_Sender_SetImpairment (sender, &(config->data)) != ARSTREAM_OK) ||
+            ((err = ARSTREAM_Reader_StartCapture (reader, config->capturePath)) != ARSTREAM_OK))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to configure the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+
+    if (retVal == 0)
+    {
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        periodUs = 1000000 / config->fps;
+        startUs = ARSTREAM_ReplayBench_GetTimeUs ();
+        for (i = 0; i < config->nbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            uint64_t targetUs = startUs + i * periodUs;
+            uint64_t nowUs = ARSTREAM_ReplayBench_GetTimeUs ();
+            uint32_t index = i;
+            if (targetUs > nowUs)
+            {
+                usleep ((useconds_t)(targetUs - nowUs));
+            }
+            memcpy (frame, &index, HEADER_SIZE);
+            ARSTREAM_Sender_SendNewFrame (sender, frame, config->frameSize, 0, NULL);
+        }
+        usleep ((DRAIN_TIME_MS + config->data.delayMs + config->data.jitterMs) * 1000);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        ARSTREAM_Reader_GetCaptureStats (reader, &stats);
+        printf ("Captured %llu packets (%llu bytes) over %.3f s into %s, %u errors\n",
+                (unsigned long long)stats.nbPackets, (unsigned long long)stats.nbBytes, stats.durationUs / 1000000.,
+                config->capturePath, stats.nbErrors);
+        printf ("Reader : %llu complete frames, %llu incomplete, %llu skipped\n",
+                (unsigned long long)g_Counters.nbComplete, (unsigned long long)g_Counters.nbIncomplete, (unsigned long long)g_Counters.nbSkipped);
+        if (stats.nbErrors > 0)
+        {
+            retVal = -1;
+        }
+    }
+
+    // The capture file is flushed and closed by ARSTREAM_Reader_Delete
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    free (g_RecvBuffer);
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static int ARSTREAM_ReplayBench_ReplayOnce (ARSTREAM_ReplayBench_Config_t *config, uint64_t *elapsedUs, ARSTREAM_Capture_Stats_t *replayStats)
+{
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t readerDataThread, readerAckThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint64_t startUs;
+
+    memset (&g_Counters, 0, sizeof (g_Counters));
+    memset (replayStats, 0, sizeof (ARSTREAM_Capture_Stats_t));
+    reader = ARSTREAM_Reader_NewReplay (config->capturePath, config->mode, ARSTREAM_ReplayBench_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, config->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+    if (reader == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to replay %s : %s", config->capturePath, ARSTREAM_Error_ToString (err));
+        return -1;
+    }
+
+    startUs = ARSTREAM_ReplayBench_GetTimeUs ();
+    ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+    ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+    while ((ARSTREAM_Reader_GetReplayStats (reader, replayStats) == ARSTREAM_OK) &&
+           (replayStats->isFinished == 0))
+    {
+        usleep (POLL_PERIOD_US);
+    }
+    *elapsedUs = ARSTREAM_ReplayBench_GetTimeUs () - startUs;
+
+    ARSTREAM_Reader_StopReader (reader);
+    ARSAL_Thread_Join (readerDataThread, NULL);
+    ARSAL_Thread_Join (readerAckThread, NULL);
+    ARSAL_Thread_Destroy (&readerDataThread);
+    ARSAL_Thread_Destroy (&readerAckThread);
+    ARSTREAM_Reader_Delete (&reader);
+    return 0;
+}
+
+static int ARSTREAM_ReplayBench_CompareU64 (const void *a, const void *b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static int ARSTREAM_ReplayBench_Replay (ARSTREAM_ReplayBench_Config_t *config)
+{
+    uint64_t *elapsedUs = calloc (config->nbIterations, sizeof (uint64_t));
+    ARSTREAM_Capture_Stats_t stats;
+    int retVal = 0;
+    int i;
+
+    g_RecvBufferSize = config->fragSize * MAX_NB_FRAG;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    if ((elapsedUs == NULL) ||
+        (g_RecvBuffer == NULL))
+    {
+        retVal = -1;
+    }
+
+    printf ("%5s %10s %12s %8s %8s %8s %10s %12s %10s\n",
+            "iter", "packets", "bytes", "frames", "incompl", "skipped", "time(ms)", "packets/s", "MB/s");
+    for (i = 0; (retVal == 0) && (i < config->nbIterations); i++)
+    {
+        double seconds;
+        retVal = ARSTREAM_ReplayBench_ReplayOnce (config, &elapsedUs [i], &stats);
+        if (retVal != 0)
+        {
+            break;
+        }
+        seconds = (elapsedUs [i] > 0) ? elapsedUs [i] / 1000000. : 1e-6;
+        printf ("%5d %10llu %12llu %8llu %8llu %8llu %10.2f %12.0f %10.1f\n", i,
+                (unsigned long long)stats.nbPackets, (unsigned long long)stats.nbBytes,
+                (unsigned long long)g_Counters.nbComplete, (unsigned long long)g_Counters.nbIncomplete, (unsigned long long)g_Counters.nbSkipped,
+                elapsedUs [i] / 1000., stats.nbPackets / seconds, stats.nbBytes / seconds / 1e6);
+        fflush (stdout);
+        if (stats.nbErrors > 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "%u records were skipped or corrupted", stats.nbErrors);
+        }
+    }
+
+    if ((retVal == 0) &&
+        (config->nbIterations > 1))
+    {
+        qsort (elapsedUs, config->nbIterations, sizeof (uint64_t), ARSTREAM_ReplayBench_CompareU64);
+        printf ("median %.2f ms, min %.2f ms, max %.2f ms\n",
+                elapsedUs [config->nbIterations / 2] / 1000., elapsedUs [0] / 1000., elapsedUs [config->nbIterations - 1] / 1000.);
+    }
+
+    free (elapsedUs);
+    free (g_RecvBuffer);
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static void ARSTREAM_ReplayBench_Usage (const char *name)
+{
+    printf ("Usage: %s -w captureFile [-n frames] [-s frameSize] [-p fps] [-F fragSize] [-l loss] [-d delay] [-j jitter]\n", name);
+    printf ("       %s -r captureFile [-t] [-i iterations] [-F fragSize]\n", name);
+    printf ("  -w : stream through an impaired in-process loopback, and capture what the reader receives\n");
+    printf ("       -n frames (300), -s frame size (20000), -p fps (30), -l loss (percent), -d delay, -j jitter (ms)\n");
+    printf ("  -r : replay a capture into a reader, as fast as possible\n");
+    printf ("       -t : keep the original timing, -i : number of replays (1)\n");
+    printf ("  -F : fragment size of the stream (1000), must match the captured stream\n");
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_ReplayBench_Main (int argc, char *argv[])
+{
+    ARSTREAM_ReplayBench_Config_t config;
+    int opt;
+
+    memset (&config, 0, sizeof (config));
+    config.fragSize = 1000;
+    config.nbFrames = 300;
+    config.fps = 30;
+    config.frameSize = 20000;
+    config.mode = ARSTREAM_CAPTURE_REPLAY_AS_FAST_AS_POSSIBLE;
+    config.nbIterations = 1;
+    ARSTREAM_Impairment_DefaultConfig (&(config.data));
+
+    while ((opt = getopt (argc, argv, "w:r:n:s:p:F:l:d:j:ti:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w': config.capturePath = optarg; config.isRecording = 1; break;
+        case 'r': config.capturePath = optarg; config.isRecording = 0; break;
+        case 'n': config.nbFrames = atoi (optarg); break;
+        case 's': config.frameSize = atoi (optarg); break;
+        case 'p': config.fps = atoi (optarg); break;
+        case 'F': config.fragSize = atoi (optarg); break;
+        case 'l': config.data.lossPercent = atof (optarg); break;
+        case 'd': config.data.delayMs = atoi (optarg); break;
+        case 'j': config.data.jitterMs = atoi (optarg); break;
+        case 't': config.mode = ARSTREAM_CAPTURE_REPLAY_ORIGINAL_TIMING; break;
+        case 'i': config.nbIterations = atoi (optarg); break;
+        default:
+            ARSTREAM_ReplayBench_Usage (argv[0]);
+            return 1;
+        }
+    }
+
+    if ((config.capturePath == NULL) ||
+        (config.fragSize <= 0) ||
+        (config.nbFrames <= 0) ||
+        (config.fps <= 0) ||
+        (config.frameSize < HEADER_SIZE) ||
+        (config.frameSize > config.fragSize * MAX_NB_FRAG) ||
+        (config.nbIterations <= 0))
+    {
+        ARSTREAM_ReplayBench_Usage (argv[0]);
+        return 1;
+    }
+
+    if (config.isRecording != 0)
+    {
+        return (ARSTREAM_ReplayBench_Record (&config) == 0) ? 0 : 1;
+    }
+    return (ARSTREAM_ReplayBench_Replay (&config) == 0) ? 0 : 1;
+}
@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
 
 /*
  * ARSDK Headers
@@ -52,6 +53,7 @@
 #include <libARStream/ARSTREAM_Sender.h>
 
 #include "../ARSTREAM_TB_Config.h"
+#include "../FrameGenerator/ARSTREAM_FrameGenerator.h"
 
 /*
  * Macros
@@ -66,11 +68,6 @@
 #define BITRATE_KBPS (1)
 #define FPS          (1)
 
-#define FRAME_SIZE   (1000 * BITRATE_KBPS / FPS / 8)
-
-#define FRAME_MIN_SIZE (FRAME_SIZE)
-#define FRAME_MAX_SIZE (FRAME_SIZE)
-
 #define I_FRAME_EVERY_N (15)
 #define NB_BUFFERS (2 * I_FRAME_EVERY_N)
 
@@ -108,6 +105,10 @@ static int currentIndexInDt = 0;
 
 static int nbSkippedSinceLast = 0;
 
+static int forceIFrame = 0;
+
+static ARSTREAM_FrameGenerator_t *g_Generator;
+
 static int stillRunning = 1;
 
 float ARSTREAM_Sender_PercentOk = 0.0;
@@ -241,8 +242,8 @@ void ARSTREAM_SenderTb_initMultiBuffers ()
     int buffIndex;
     for (buffIndex = 0; buffIndex < NB_BUFFERS; buffIndex++)
     {
-        multiBuffer[buffIndex] = malloc (FRAME_MAX_SIZE);
-        multiBufferSize[buffIndex] = FRAME_MAX_SIZE;
+        multiBuffer[buffIndex] = malloc (ARSTREAM_FrameGenerator_GetMaxFrameSize (g_Generator));
+        multiBufferSize[buffIndex] = ARSTREAM_FrameGenerator_GetMaxFrameSize (g_Generator);
         multiBufferIsFree[buffIndex] = 1;
     }
 }
@@ -281,6 +282,10 @@ void ARSTREAM_SenderTb_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint
         nbOk++;
         ARSTREAM_Sender_PercentOk = (100.f * nbOk) / (1.f * nbSent);
         break;
+    case ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST:
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Reader asked for a key frame (reason %u)", frameSize);
+        forceIFrame = 1;
+        break;
     default:
         // All cases handled
         break;
@@ -323,37 +328,34 @@ uint8_t* ARSTREAM_SenderTb_GetNextFreeBuffer (uint32_t *retSize)
 void* fakeEncoderThread (void *ARSTREAM_Sender_t_Param)
 {
 
-    uint32_t cnt = 0;
-    uint32_t frameSize = 0;
+    ARSTREAM_FrameGenerator_Frame_t frame;
     uint32_t frameCapacity = 0;
     uint8_t *nextFrameAddr;
     ARSTREAM_Sender_t *sender = (ARSTREAM_Sender_t *)ARSTREAM_Sender_t_Param;
-    srand (time (NULL));
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Encoder thread running");
     while (stillRunning)
     {
-        cnt++;
-        frameSize = rand () % FRAME_MAX_SIZE;
-        if (frameSize < FRAME_MIN_SIZE)
+        if (forceIFrame == 1)
         {
-            frameSize = FRAME_MIN_SIZE;
+            ARSTREAM_FrameGenerator_ForceKeyFrame (g_Generator);
+            forceIFrame = 0;
         }
-        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Generating a frame of size %d with number %u", frameSize, cnt);
+        ARSTREAM_FrameGenerator_Next (g_Generator, &frame);
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Generating a %s-frame of size %u with number %u", ARSTREAM_FrameGenerator_FrameTypeToString (frame.type), frame.size, frame.index);
 
         nextFrameAddr = ARSTREAM_SenderTb_GetNextFreeBuffer (&frameCapacity);
         if (nextFrameAddr != NULL)
         {
-            if (frameCapacity >= frameSize)
+            if (frameCapacity >= frame.size)
             {
                 eARSTREAM_ERROR res;
                 int nbPrevious;
-                int flush = ((cnt % I_FRAME_EVERY_N) == 1) ? 1 : 0;
-                memset (nextFrameAddr, cnt, frameSize);
-                res = ARSTREAM_Sender_SendNewFrame (sender, nextFrameAddr, frameSize, flush, &nbPrevious);
+                ARSTREAM_FrameGenerator_Fill (&frame, nextFrameAddr);
+                res = ARSTREAM_Sender_SendNewFrame (sender, nextFrameAddr, frame.size, frame.isKeyFrame, &nbPrevious);
                 switch (res)
                 {
                 case ARSTREAM_OK:
-                    ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Added a frame of size %u to the Sender (already %d in queue)", frameSize, nbPrevious);
+                    ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Added a frame of size %u to the Sender (already %d in queue)", frame.size, nbPrevious);
                     break;
                 case ARSTREAM_ERROR_BAD_PARAMETERS:
                 case ARSTREAM_ERROR_FRAME_TOO_LARGE:
@@ -385,6 +387,19 @@ int ARSTREAM_SenderTb_StartStreamTest (ARNETWORK_Manager_t *manager)
 {
     int retVal = 0;
     eARSTREAM_ERROR err;
+    ARSTREAM_FrameGenerator_Config_t encoder;
+    ARSTREAM_FrameGenerator_DefaultConfig (&encoder);
+    encoder.bitrateKbps = BITRATE_KBPS;
+    encoder.fps = FPS;
+    encoder.gopLength = I_FRAME_EVERY_N;
+    encoder.maxFrameSize = ARSTREAM_TB_FRAG_SIZE * ARSTREAM_TB_MAX_NB_FRAG;
+    encoder.seed = (uint32_t)time (NULL);
+    g_Generator = ARSTREAM_FrameGenerator_New (&encoder);
+    if (g_Generator == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the frame generator");
+        return 1;
+    }
     ARSTREAM_SenderTb_initMultiBuffers ();
     g_Sender = ARSTREAM_Sender_New (manager, DATA_BUFFER_ID, ACK_BUFFER_ID, ARSTREAM_SenderTb_FrameUpdateCallback, NB_BUFFERS, ARSTREAM_TB_FRAG_SIZE, ARSTREAM_TB_MAX_NB_FRAG, NULL, &err);
     if (g_Sender == NULL)
@@ -413,6 +428,7 @@ int ARSTREAM_SenderTb_StartStreamTest (ARNETWORK_Manager_t *manager)
     pthread_join (streamsend, NULL);
 
     ARSTREAM_Sender_Delete (&g_Sender);
+    ARSTREAM_FrameGenerator_Delete (&g_Generator);
 
     return retVal;
 }
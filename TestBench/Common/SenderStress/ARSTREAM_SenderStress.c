@@ -0,0 +1,642 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_SenderStress.c
+ * @brief Sender queueing stress bench with synthetic encoders
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_SenderStress.h"
+#include "../FrameGenerator/ARSTREAM_FrameGenerator.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_SenderStress"
+
+#define MAX_STREAMS (16)
+#define MAX_NB_FRAG (128)
+#define DEFAULT_NB_FRAMES (900)
+#define DEFAULT_FRAG_SIZE (1400)
+#define DEFAULT_QUEUE_SIZE (8)
+#define FRAME_TIMEOUT_MS (1000)
+#define DRAIN_TIME_MS (1000)
+
+/*
+ * Types
+ */
+
+/**
+ * @brief Parameters common to all the streams
+ */
+typedef struct {
+    int nbStreams;
+    int nbFrames;
+    int fragSize;
+    int queueSize; /**< Size of the sender frame queue */
+    int outputCsv;
+    ARSTREAM_FrameGenerator_Config_t encoder;
+    ARSTREAM_Impairment_Config_t link;
+} ARSTREAM_SenderStress_Params_t;
+
+/**
+ * @brief One stream : a generator, a sender, a reader and a loopback between them
+ */
+typedef struct {
+    int id;
+    ARSTREAM_SenderStress_Params_t *params;
+    ARSTREAM_FrameGenerator_t *generator;
+    ARSTREAM_Loopback_t *loopback;
+    ARSTREAM_Sender_t *sender;
+    ARSTREAM_Reader_t *reader;
+    ARSAL_Thread_t threads [5];
+    int nbThreads;
+    uint64_t startUs;
+
+    /* Frame buffers, owned by the sender between SendNewFrame and the SENT/CANCEL callback */
+    pthread_mutex_t mutex;
+    uint8_t **buffers;
+    int *isFree;
+    int nbBuffers;
+    uint8_t *recvBuffer;
+    uint32_t recvBufferSize;
+    int keyFrameRequested;
+
+    /* Encoder thread */
+    uint64_t nbGenerated;
+    uint64_t nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_MAX];
+    uint64_t nbSceneChanges;
+    uint64_t nbBytesGenerated;
+    uint64_t nbQueueFull;
+    uint64_t nbOtherErrors;
+    uint64_t nbStalls; /**< Frames dropped because all the buffers were owned by the sender */
+    uint64_t queueDepthSum;
+    int queueDepthMax;
+    /* Sender callback (protected by mutex) */
+    uint64_t nbAcked;
+    uint64_t nbCancelled;
+    uint64_t nbLateAcks;
+    uint64_t nbKeyFrameRequests;
+    /* Reader callback (reader data thread only) */
+    uint64_t nbReceived;
+    uint64_t nbIncomplete;
+    uint64_t nbSkipped;
+    uint64_t nbBytesReceived;
+} ARSTREAM_SenderStress_Stream_t;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_SenderStress_GetTimeUs (void);
+static void ARSTREAM_SenderStress_ReleaseBuffer (ARSTREAM_SenderStress_Stream_t *stream, uint8_t *buffer);
+static uint8_t* ARSTREAM_SenderStress_GetBuffer (ARSTREAM_SenderStress_Stream_t *stream);
+static void ARSTREAM_SenderStress_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_SenderStress_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static void* ARSTREAM_SenderStress_EncoderThread (void *param);
+static int ARSTREAM_SenderStress_InitStream (ARSTREAM_SenderStress_Stream_t *stream, ARSTREAM_SenderStress_Params_t *params, int id);
+static void ARSTREAM_SenderStress_DeleteStream (ARSTREAM_SenderStress_Stream_t *stream);
+static void ARSTREAM_SenderStress_PrintStream (ARSTREAM_SenderStress_Stream_t *stream, const char *name, double durationS);
+static void ARSTREAM_SenderStress_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_SenderStress_GetTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void ARSTREAM_SenderStress_ReleaseBuffer (ARSTREAM_SenderStress_Stream_t *stream, uint8_t *buffer)
+{
+    int i;
+    for (i = 0; i < stream->nbBuffers; i++)
+    {
+        if (stream->buffers [i] == buffer)
+        {
+            stream->isFree [i] = 1;
+            break;
+        }
+    }
+}
+
+static uint8_t* ARSTREAM_SenderStress_GetBuffer (ARSTREAM_SenderStress_Stream_t *stream)
+{
+    uint8_t *retBuffer = NULL;
+    int i;
+    pthread_mutex_lock (&(stream->mutex));
+    for (i = 0; i < stream->nbBuffers; i++)
+    {
+        if (stream->isFree [i] != 0)
+        {
+            stream->isFree [i] = 0;
+            retBuffer = stream->buffers [i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&(stream->mutex));
+    return retBuffer;
+}
+
+static void ARSTREAM_SenderStress_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    ARSTREAM_SenderStress_Stream_t *stream = (ARSTREAM_SenderStress_Stream_t *)custom;
+    (void)frameSize;
+    pthread_mutex_lock (&(stream->mutex));
+    switch (status)
+    {
+    case ARSTREAM_SENDER_STATUS_FRAME_SENT:
+        stream->nbAcked++;
+        ARSTREAM_SenderStress_ReleaseBuffer (stream, framePointer);
+        break;
+    case ARSTREAM_SENDER_STATUS_FRAME_CANCEL:
+        stream->nbCancelled++;
+        ARSTREAM_SenderStress_ReleaseBuffer (stream, framePointer);
+        break;
+    case ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK:
+        stream->nbLateAcks++;
+        break;
+    case ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST:
+        stream->nbKeyFrameRequests++;
+        stream->keyFrameRequested = 1;
+        break;
+    default:
+        break;
+    }
+    pthread_mutex_unlock (&(stream->mutex));
+}
+
+static uint8_t* ARSTREAM_SenderStress_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    ARSTREAM_SenderStress_Stream_t *stream = (ARSTREAM_SenderStress_Stream_t *)custom;
+    (void)framePointer;
+    (void)isFlushFrame;
+    switch (cause)
+    {
+    case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+        stream->nbReceived++;
+        stream->nbBytesReceived += frameSize;
+        break;
+    case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+        stream->nbIncomplete++;
+        break;
+    default:
+        break;
+    }
+    if (numberOfSkippedFrames > 0)
+    {
+        stream->nbSkipped += numberOfSkippedFrames;
+    }
+    *newBufferCapacity = stream->recvBufferSize;
+    return stream->recvBuffer;
+}
+
+static void* ARSTREAM_SenderStress_EncoderThread (void *param)
+{
+    ARSTREAM_SenderStress_Stream_t *stream = (ARSTREAM_SenderStress_Stream_t *)param;
+    ARSTREAM_SenderStress_Params_t *params = stream->params;
+    ARSTREAM_FrameGenerator_Frame_t frame;
+    int i;
+
+    for (i = 0; i < params->nbFrames; i++)
+    {
+        uint8_t *buffer;
+        uint64_t nowUs;
+        int keyFrameRequested;
+        int nbPrevious = 0;
+        eARSTREAM_ERROR err;
+
+        pthread_mutex_lock (&(stream->mutex));
+        keyFrameRequested = stream->keyFrameRequested;
+        stream->keyFrameRequested = 0;
+        pthread_mutex_unlock (&(stream->mutex));
+        if (keyFrameRequested != 0)
+        {
+            ARSTREAM_FrameGenerator_ForceKeyFrame (stream->generator);
+        }
+        ARSTREAM_FrameGenerator_Next (stream->generator, &frame);
+
+        nowUs = ARSTREAM_SenderStress_GetTimeUs ();
+        if (stream->startUs + frame.timestampUs > nowUs)
+        {
+            usleep ((useconds_t)(stream->startUs + frame.timestampUs - nowUs));
+        }
+
+        stream->nbGenerated++;
+        stream->nbByType [frame.type]++;
+        stream->nbBytesGenerated += frame.size;
+        if ((frame.isSceneChange != 0) &&
+            (keyFrameRequested == 0))
+        {
+            stream->nbSceneChanges++;
+        }
+
+        buffer = ARSTREAM_SenderStress_GetBuffer (stream);
+        if (buffer == NULL)
+        {
+            stream->nbStalls++;
+            continue;
+        }
+        ARSTREAM_FrameGenerator_Fill (&frame, buffer);
+        err = ARSTREAM_Sender_SendNewFrame (stream->sender, buffer, frame.size, frame.isKeyFrame, &nbPrevious);
+        if (err == ARSTREAM_OK)
+        {
+            stream->queueDepthSum += nbPrevious;
+            if (nbPrevious > stream->queueDepthMax)
+            {
+                stream->queueDepthMax = nbPrevious;
+            }
+        }
+        else
+        {
+            if (err == ARSTREAM_ERROR_QUEUE_FULL)
+            {
+                stream->nbQueueFull++;
+            }
+            else
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Stream %d : unable to send frame %u : %s", stream->id, frame.index, ARSTREAM_Error_ToString (err));
+                stream->nbOtherErrors++;
+            }
+            pthread_mutex_lock (&(stream->mutex));
+            ARSTREAM_SenderStress_ReleaseBuffer (stream, buffer);
+            pthread_mutex_unlock (&(stream->mutex));
+        }
+    }
+    return (void *)0;
+}
+
+static int ARSTREAM_SenderStress_InitStream (ARSTREAM_SenderStress_Stream_t *stream, ARSTREAM_SenderStress_Params_t *params, int id)
+{
+    ARSTREAM_FrameGenerator_Config_t encoder = params->encoder;
+    ARSTREAM_Impairment_Config_t link = params->link;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint32_t maxFrameSize;
+    int i;
+
+    memset (stream, 0, sizeof (ARSTREAM_SenderStress_Stream_t));
+    stream->id = id;
+    stream->params = params;
+    pthread_mutex_init (&(stream->mutex), NULL);
+
+    /* Each stream has its own sizes, losses and GOP phase */
+    encoder.seed += id;
+    encoder.startOffset += (id * encoder.gopLength) / params->nbStreams;
+    if ((encoder.maxFrameSize == 0) ||
+        (encoder.maxFrameSize > (uint32_t)(params->fragSize * MAX_NB_FRAG)))
+    {
+        encoder.maxFrameSize = params->fragSize * MAX_NB_FRAG;
+    }
+    link.seed += id;
+    stream->generator = ARSTREAM_FrameGenerator_New (&encoder);
+    if (stream->generator == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Invalid encoder configuration");
+        return -1;
+    }
+    maxFrameSize = ARSTREAM_FrameGenerator_GetMaxFrameSize (stream->generator);
+
+    /* The sender owns at most queueSize frames, plus the one being sent */
+    stream->nbBuffers = params->queueSize + 2;
+    stream->buffers = calloc (stream->nbBuffers, sizeof (uint8_t *));
+    stream->isFree = calloc (stream->nbBuffers, sizeof (int));
+    stream->recvBufferSize = maxFrameSize;
+    stream->recvBuffer = malloc (stream->recvBufferSize);
+    if ((stream->buffers == NULL) ||
+        (stream->isFree == NULL) ||
+        (stream->recvBuffer == NULL))
+    {
+        return -1;
+    }
+    for (i = 0; i < stream->nbBuffers; i++)
+    {
+        stream->buffers [i] = malloc (maxFrameSize);
+        if (stream->buffers [i] == NULL)
+        {
+            return -1;
+        }
+        stream->isFree [i] = 1;
+    }
+
+    stream->loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, params->fragSize, &err);
+    if (stream->loopback != NULL)
+    {
+        stream->sender = ARSTREAM_Sender_NewLoopback (stream->loopback, ARSTREAM_SenderStress_FrameUpdateCallback, params->queueSize, params->fragSize, MAX_NB_FRAG, stream, &err);
+        stream->reader = ARSTREAM_Reader_NewLoopback (stream->loopback, ARSTREAM_SenderStress_FrameCompleteCallback, stream->recvBuffer, stream->recvBufferSize, params->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, stream, &err);
+    }
+    if ((stream->sender == NULL) ||
+        (stream->reader == NULL))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader of stream %d : %s", id, ARSTREAM_Error_ToString (err));
+        return -1;
+    }
+    err = ARSTREAM_Sender_SetImpairment (stream->sender, &link);
+    if (err != ARSTREAM_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Invalid link configuration : %s", ARSTREAM_Error_ToString (err));
+        return -1;
+    }
+    return 0;
+}
+
+static void ARSTREAM_SenderStress_DeleteStream (ARSTREAM_SenderStress_Stream_t *stream)
+{
+    int i;
+    ARSTREAM_Sender_Delete (&(stream->sender));
+    ARSTREAM_Reader_Delete (&(stream->reader));
+    ARSTREAM_Loopback_Delete (&(stream->loopback));
+    ARSTREAM_FrameGenerator_Delete (&(stream->generator));
+    if (stream->buffers != NULL)
+    {
+        for (i = 0; i < stream->nbBuffers; i++)
+        {
+            free (stream->buffers [i]);
+        }
+    }
+    free (stream->buffers);
+    free (stream->isFree);
+    free (stream->recvBuffer);
+    pthread_mutex_destroy (&(stream->mutex));
+}
+
+static void ARSTREAM_SenderStress_PrintStream (ARSTREAM_SenderStress_Stream_t *stream, const char *name, double durationS)
+{
+    double meanQueue = (stream->nbGenerated > stream->nbStalls) ? (double)stream->queueDepthSum / (stream->nbGenerated - stream->nbStalls) : 0.;
+    double genKbps = stream->nbBytesGenerated * 8. / 1000. / durationS;
+    double rxKbps = stream->nbBytesReceived * 8. / 1000. / durationS;
+    if (stream->params->outputCsv != 0)
+    {
+        printf ("%s,%llu,%llu,%llu,%llu,%llu,%.0f,%llu,%llu,%llu,%llu,%llu,%.2f,%d,%llu,%llu,%llu,%.0f,%llu\n", name,
+                (unsigned long long)stream->nbGenerated, (unsigned long long)stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_I],
+                (unsigned long long)stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_P], (unsigned long long)stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_B],
+                (unsigned long long)stream->nbSceneChanges, genKbps,
+                (unsigned long long)stream->nbAcked, (unsigned long long)stream->nbCancelled, (unsigned long long)stream->nbQueueFull,
+                (unsigned long long)stream->nbStalls, (unsigned long long)stream->nbOtherErrors, meanQueue, stream->queueDepthMax,
+                (unsigned long long)stream->nbReceived, (unsigned long long)stream->nbIncomplete, (unsigned long long)stream->nbSkipped, rxKbps,
+                (unsigned long long)stream->nbKeyFrameRequests);
+    }
+    else
+    {
+        printf ("%-6s %6llu %5llu/%-6llu %5llu %8.0f %6llu %6llu %5llu %5llu %6.2f %4d %6llu %6llu %8.0f %5llu\n", name,
+                (unsigned long long)stream->nbGenerated, (unsigned long long)stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_I],
+                (unsigned long long)(stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_P] + stream->nbByType [ARSTREAM_FRAMEGENERATOR_FRAME_B]),
+                (unsigned long long)stream->nbSceneChanges, genKbps,
+                (unsigned long long)stream->nbAcked, (unsigned long long)stream->nbCancelled, (unsigned long long)stream->nbQueueFull,
+                (unsigned long long)stream->nbStalls, meanQueue, stream->queueDepthMax,
+                (unsigned long long)stream->nbReceived, (unsigned long long)stream->nbIncomplete, rxKbps,
+                (unsigned long long)stream->nbKeyFrameRequests);
+    }
+}
+
+static void ARSTREAM_SenderStress_Usage (const char *name)
+{
+    printf ("Usage: %s [-S streams] [-n frames] [-b kbps] [-r fps] [-g gop] [-B bFrames] [-w I:P:B] [-v deviation] [-s scene%%] [-k sceneRatio]\n", name);
+    printf ("       [-L linkKbps] [-Q linkQueueBytes] [-d delayMs] [-l loss%%] [-q queueSize] [-f fragSize] [-x seed] [-c]\n");
+    printf ("Encoder (each stream) :\n");
+    printf ("  -S : number of concurrent streams (1, max %d)\n", MAX_STREAMS);
+    printf ("  -n : frames per stream (%d)\n", DEFAULT_NB_FRAMES);
+    printf ("  -b : target bitrate in kbit/s, -r : frame rate, -g : GOP length, -B : B-frames between references\n");
+    printf ("  -w : relative sizes of the I, P and B frames\n");
+    printf ("  -v : log-normal size deviation, -s : scene change probability per frame, -k : scene change I-frame size ratio\n");
+    printf ("Link (each stream, sender to reader) :\n");
+    printf ("  -L : bandwidth in kbit/s (0 for unlimited), -Q : link queue limit in bytes, -d : delay, -l : loss rate\n");
+    printf ("Sender :\n");
+    printf ("  -q : frame queue size (%d), -f : fragment size (%d)\n", DEFAULT_QUEUE_SIZE, DEFAULT_FRAG_SIZE);
+    printf ("  -x : seed of the encoders and links, -c : CSV output\n");
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_SenderStress_Main (int argc, char *argv[])
+{
+    ARSTREAM_SenderStress_Params_t params;
+    ARSTREAM_SenderStress_Stream_t *streams = NULL;
+    ARSTREAM_SenderStress_Stream_t total;
+    uint64_t startUs, durationUs;
+    int retVal = 0;
+    int opt, i, j;
+
+    memset (&params, 0, sizeof (params));
+    params.nbStreams = 1;
+    params.nbFrames = DEFAULT_NB_FRAMES;
+    params.fragSize = DEFAULT_FRAG_SIZE;
+    params.queueSize = DEFAULT_QUEUE_SIZE;
+    ARSTREAM_FrameGenerator_DefaultConfig (&(params.encoder));
+    ARSTREAM_Impairment_DefaultConfig (&(params.link));
+
+    while ((opt = getopt (argc, argv, "S:n:b:r:g:B:w:v:s:k:L:Q:d:l:q:f:x:ch")) != -1)
+    {
+        switch (opt)
+        {
+        case 'S': params.nbStreams = atoi (optarg); break;
+        case 'n': params.nbFrames = atoi (optarg); break;
+        case 'b': params.encoder.bitrateKbps = atoi (optarg); break;
+        case 'r': params.encoder.fps = atoi (optarg); break;
+        case 'g': params.encoder.gopLength = atoi (optarg); break;
+        case 'B': params.encoder.nbBFrames = atoi (optarg); break;
+        case 'w':
+            if (sscanf (optarg, "%f:%f:%f", &(params.encoder.iWeight), &(params.encoder.pWeight), &(params.encoder.bWeight)) < 2)
+            {
+                ARSTREAM_SenderStress_Usage (argv[0]);
+                return 1;
+            }
+            break;
+        case 'v': params.encoder.sizeDeviation = atof (optarg); break;
+        case 's': params.encoder.sceneChangePercent = atof (optarg); break;
+        case 'k': params.encoder.sceneChangeRatio = atof (optarg); break;
+        case 'L': params.link.bandwidthKbps = atoi (optarg); break;
+        case 'Q': params.link.queueLimitBytes = atoi (optarg); break;
+        case 'd': params.link.delayMs = atoi (optarg); break;
+        case 'l': params.link.lossPercent = atof (optarg); break;
+        case 'q': params.queueSize = atoi (optarg); break;
+        case 'f': params.fragSize = atoi (optarg); break;
+        case 'x': params.encoder.seed = params.link.seed = atoi (optarg); break;
+        case 'c': params.outputCsv = 1; break;
+        default:
+            ARSTREAM_SenderStress_Usage (argv[0]);
+            return 1;
+        }
+    }
+    if ((params.nbStreams <= 0) ||
+        (params.nbStreams > MAX_STREAMS) ||
+        (params.nbFrames <= 0) ||
+        (params.fragSize <= 0) ||
+        (params.queueSize <= 0))
+    {
+        ARSTREAM_SenderStress_Usage (argv[0]);
+        return 1;
+    }
+
+    streams = calloc (params.nbStreams, sizeof (ARSTREAM_SenderStress_Stream_t));
+    if (streams == NULL)
+    {
+        return 1;
+    }
+    for (i = 0; (retVal == 0) && (i < params.nbStreams); i++)
+    {
+        retVal = ARSTREAM_SenderStress_InitStream (&streams [i], &params, i);
+    }
+
+    if (retVal == 0)
+    {
+        if (params.outputCsv == 0)
+        {
+            ARSTREAM_FrameGenerator_t *generator = streams [0].generator;
+            printf ("%d stream(s) of %d frames : %u kbit/s at %u fps, GOP %u with %u B-frames, mean I/P/B %u/%u/%u bytes, max %u\n",
+                    params.nbStreams, params.nbFrames, params.encoder.bitrateKbps, params.encoder.fps, params.encoder.gopLength, params.encoder.nbBFrames,
+                    ARSTREAM_FrameGenerator_GetMeanFrameSize (generator, ARSTREAM_FRAMEGENERATOR_FRAME_I),
+                    ARSTREAM_FrameGenerator_GetMeanFrameSize (generator, ARSTREAM_FRAMEGENERATOR_FRAME_P),
+                    ARSTREAM_FrameGenerator_GetMeanFrameSize (generator, ARSTREAM_FRAMEGENERATOR_FRAME_B),
+                    ARSTREAM_FrameGenerator_GetMaxFrameSize (generator));
+            printf ("Link : %u kbit/s, %u ms, %.1f%% loss - sender queue of %d frames\n",
+                    params.link.bandwidthKbps, params.link.delayMs, params.link.lossPercent, params.queueSize);
+        }
+
+        startUs = ARSTREAM_SenderStress_GetTimeUs ();
+        for (i = 0; i < params.nbStreams; i++)
+        {
+            ARSTREAM_SenderStress_Stream_t *stream = &streams [i];
+            // Retry as soon as the acks say so, as the link latency is known
+            ARSTREAM_Sender_SetTimeBetweenRetries (stream->sender, 1, FRAME_TIMEOUT_MS);
+            stream->startUs = startUs;
+            ARSAL_Thread_Create (&(stream->threads [0]), ARSTREAM_Reader_RunDataThread, stream->reader);
+            ARSAL_Thread_Create (&(stream->threads [1]), ARSTREAM_Reader_RunAckThread, stream->reader);
+            ARSAL_Thread_Create (&(stream->threads [2]), ARSTREAM_Sender_RunDataThread, stream->sender);
+            ARSAL_Thread_Create (&(stream->threads [3]), ARSTREAM_Sender_RunAckThread, stream->sender);
+            ARSAL_Thread_Create (&(stream->threads [4]), ARSTREAM_SenderStress_EncoderThread, stream);
+            stream->nbThreads = 5;
+        }
+
+        for (i = 0; i < params.nbStreams; i++)
+        {
+            ARSAL_Thread_Join (streams [i].threads [4], NULL);
+        }
+        durationUs = ARSTREAM_SenderStress_GetTimeUs () - startUs;
+        usleep ((DRAIN_TIME_MS + params.link.delayMs) * 1000);
+
+        for (i = 0; i < params.nbStreams; i++)
+        {
+            ARSTREAM_Sender_StopSender (streams [i].sender);
+            ARSTREAM_Reader_StopReader (streams [i].reader);
+        }
+        for (i = 0; i < params.nbStreams; i++)
+        {
+            for (j = 0; j < 4; j++)
+            {
+                ARSAL_Thread_Join (streams [i].threads [j], NULL);
+            }
+        }
+
+        if (params.outputCsv != 0)
+        {
+            printf ("stream,frames,I,P,B,scenes,genKbps,acked,cancelled,queueFull,stalls,errors,meanQueue,maxQueue,received,incomplete,skipped,rxKbps,keyRequests\n");
+        }
+        else
+        {
+            printf ("%-6s %6s %12s %5s %8s %6s %6s %5s %5s %6s %4s %6s %6s %8s %5s\n",
+                    "stream", "frames", "I/PB", "scene", "genKbps", "acked", "cancel", "qfull", "stall", "meanQ", "maxQ", "rx", "incompl", "rxKbps", "keyRq");
+        }
+        memset (&total, 0, sizeof (total));
+        total.params = &params;
+        for (i = 0; i < params.nbStreams; i++)
+        {
+            ARSTREAM_SenderStress_Stream_t *stream = &streams [i];
+            char name [16];
+            snprintf (name, sizeof (name), "%d", i);
+            ARSTREAM_SenderStress_PrintStream (stream, name, durationUs / 1000000.);
+
+            total.nbGenerated += stream->nbGenerated;
+            for (j = 0; j < ARSTREAM_FRAMEGENERATOR_FRAME_MAX; j++)
+            {
+                total.nbByType [j] += stream->nbByType [j];
+            }
+            total.nbSceneChanges += stream->nbSceneChanges;
+            total.nbBytesGenerated += stream->nbBytesGenerated;
+            total.nbQueueFull += stream->nbQueueFull;
+            total.nbOtherErrors += stream->nbOtherErrors;
+            total.nbStalls += stream->nbStalls;
+            total.queueDepthSum += stream->queueDepthSum;
+            if (stream->queueDepthMax > total.queueDepthMax)
+            {
+                total.queueDepthMax = stream->queueDepthMax;
+            }
+            total.nbAcked += stream->nbAcked;
+            total.nbCancelled += stream->nbCancelled;
+            total.nbLateAcks += stream->nbLateAcks;
+            total.nbKeyFrameRequests += stream->nbKeyFrameRequests;
+            total.nbReceived += stream->nbReceived;
+            total.nbIncomplete += stream->nbIncomplete;
+            total.nbSkipped += stream->nbSkipped;
+            total.nbBytesReceived += stream->nbBytesReceived;
+        }
+        if (params.nbStreams > 1)
+        {
+            ARSTREAM_SenderStress_PrintStream (&total, "total", durationUs / 1000000.);
+        }
+    }
+
+    for (i = 0; i < params.nbStreams; i++)
+    {
+        for (j = 0; j < streams [i].nbThreads; j++)
+        {
+            ARSAL_Thread_Destroy (&(streams [i].threads [j]));
+        }
+        ARSTREAM_SenderStress_DeleteStream (&streams [i]);
+    }
+    free (streams);
+    return (retVal == 0) ? 0 : 1;
+}
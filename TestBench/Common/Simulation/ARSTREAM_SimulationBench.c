@@ -0,0 +1,412 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_SimulationBench.c
+ * @brief Streams hours of video on the virtual clock, through an impaired loopback
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_SimulationBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_SimulationBench"
+
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define DRAIN_TIME_MS (2000)
+#define HEADER_SIZE (4)
+
+/**
+ * Virtual time of the first event, far from zero so time differences never underflow
+ */
+#define START_TIME_US (1000000000ULL)
+
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+
+/*
+ * Types
+ */
+
+typedef struct {
+    int durationSec;
+    int fps;
+    int frameSize;
+    int fragSize;
+    int minRetryMs;
+    int maxRetryMs;
+    ARSTREAM_Impairment_Config_t data;
+    ARSTREAM_Impairment_Config_t ack;
+} ARSTREAM_SimulationBench_Config_t;
+
+/*
+ * Globals
+ */
+
+static uint64_t *g_SendTimesUs = NULL;
+static uint32_t *g_LatenciesUs = NULL;
+static uint8_t *g_Received = NULL;
+static int g_NbFrames = 0;
+static int g_NbReceived = 0;
+static int g_NbSkipped = 0;
+static uint64_t g_Fingerprint = 0;
+static uint8_t *g_RecvBuffer = NULL;
+static uint32_t g_RecvBufferSize = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_SimulationBench_GetRealTimeUs (void);
+static int ARSTREAM_SimulationBench_CompareU32 (const void *a, const void *b);
+static void ARSTREAM_SimulationBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_SimulationBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static int ARSTREAM_SimulationBench_Run (ARSTREAM_SimulationBench_Config_t *config);
+static void ARSTREAM_SimulationBench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_SimulationBench_GetRealTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int ARSTREAM_SimulationBench_CompareU32 (const void *a, const void *b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static void ARSTREAM_SimulationBench_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_SimulationBench_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)isFlushFrame;
+    (void)custom;
+    // Only one simulated thread runs at a time : no lock needed
+    if ((cause == ARSTREAM_READER_CAUSE_FRAME_COMPLETE) &&
+        (frameSize >= HEADER_SIZE))
+    {
+        uint64_t nowUs = ARSTREAM_Simulation_GetTimeUs ();
+        uint32_t index;
+        memcpy (&index, framePointer, HEADER_SIZE);
+        if ((index < (uint32_t)g_NbFrames) &&
+            (g_Received [index] == 0))
+        {
+            uint32_t latencyUs = (uint32_t)(nowUs - g_SendTimesUs [index]);
+            g_Received [index] = 1;
+            g_LatenciesUs [g_NbReceived++] = latencyUs;
+            // FNV-1a like mix of the delivery order and latencies
+            g_Fingerprint = (g_Fingerprint ^ (((uint64_t)index << 32) | latencyUs)) * 0x100000001b3ULL;
+        }
+        if (numberOfSkippedFrames > 0)
+        {
+            g_NbSkipped += numberOfSkippedFrames;
+        }
+    }
+    *newBufferCapacity = g_RecvBufferSize;
+    return g_RecvBuffer;
+}
+
+static int ARSTREAM_SimulationBench_Run (ARSTREAM_SimulationBench_Config_t *config)
+{
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    ARSTREAM_Impairment_Stats_t dataStats, ackStats;
+    ARSTREAM_Reader_FreezeStats_t freezeStats;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint64_t startUs, periodUs, virtualUs, realStartUs, realUs;
+    int retVal = 0;
+    int i, j;
+
+    g_NbFrames = config->durationSec * config->fps;
+    g_NbReceived = 0;
+    g_NbSkipped = 0;
+    g_Fingerprint = 0xcbf29ce484222325ULL;
+    g_SendTimesUs = calloc (g_NbFrames, sizeof (uint64_t));
+    g_LatenciesUs = calloc (g_NbFrames, sizeof (uint32_t));
+    g_Received = calloc (g_NbFrames, 1);
+    g_RecvBufferSize = config->frameSize;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (config->frameSize);
+        if (sendBuffers [i] != NULL)
+        {
+            for (j = HEADER_SIZE; j < config->frameSize; j++)
+            {
+                sendBuffers [i][j] = (uint8_t)(i + j);
+            }
+        }
+        else
+        {
+            retVal = -1;
+        }
+    }
+    if ((g_SendTimesUs == NULL) ||
+        (g_LatenciesUs == NULL) ||
+        (g_Received == NULL) ||
+        (g_RecvBuffer == NULL))
+    {
+        retVal = -1;
+    }
+
+    realStartUs = ARSTREAM_SimulationBench_GetRealTimeUs ();
+    if ((retVal == 0) &&
+        (ARSTREAM_Simulation_Init (START_TIME_US) != ARSTREAM_OK))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to start the simulation");
+        retVal = -1;
+    }
+
+    if (retVal == 0)
+    {
+        loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, config->fragSize, &err);
+        if (loopback != NULL)
+        {
+            sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_SimulationBench_FrameUpdateCallback, SENDER_QUEUE_SIZE, config->fragSize, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_SimulationBench_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, config->fragSize, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+        else if ((ARSTREAM_Sender_SetImpairment (sender, &(config->data)) != ARSTREAM_OK) ||
+                 (ARSTREAM_Reader_SetImpairment (reader, &(config->ack)) != ARSTREAM_OK) ||
+                 (ARSTREAM_Sender_SetTimeBetweenRetries (sender, config->minRetryMs, config->maxRetryMs) != ARSTREAM_OK))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to configure the sender/reader");
+            retVal = -1;
+        }
+    }
+
+    if (retVal == 0)
+    {
+        ARSTREAM_Simulation_ThreadCreate (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSTREAM_Simulation_ThreadCreate (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSTREAM_Simulation_ThreadCreate (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSTREAM_Simulation_ThreadCreate (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        /* Open loop : one frame per period, whatever happens on the link */
+        periodUs = 1000000 / config->fps;
+        startUs = ARSTREAM_Simulation_GetTimeUs ();
+        for (i = 0; i < g_NbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            uint64_t targetUs = startUs + i * periodUs;
+            uint64_t nowUs = ARSTREAM_Simulation_GetTimeUs ();
+            uint32_t index = i;
+            if (targetUs > nowUs)
+            {
+                ARSTREAM_Simulation_SleepUs (targetUs - nowUs);
+            }
+            memcpy (frame, &index, HEADER_SIZE);
+            g_SendTimesUs [i] = ARSTREAM_Simulation_GetTimeUs ();
+            ARSTREAM_Sender_SendNewFrame (sender, frame, config->frameSize, 0, NULL);
+        }
+        ARSTREAM_Simulation_SleepUs ((uint64_t)(DRAIN_TIME_MS + config->maxRetryMs + config->data.delayMs + config->data.jitterMs + config->data.reorderDelayMs) * 1000);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSTREAM_Simulation_ThreadJoin (senderDataThread, NULL);
+        ARSTREAM_Simulation_ThreadJoin (senderAckThread, NULL);
+        ARSTREAM_Simulation_ThreadJoin (readerDataThread, NULL);
+        ARSTREAM_Simulation_ThreadJoin (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+        virtualUs = ARSTREAM_Simulation_GetTimeUs () - startUs;
+
+        /* Results : the impairment delivery threads are joined by the deletes */
+        ARSTREAM_Sender_GetImpairmentStats (sender, &dataStats);
+        ARSTREAM_Reader_GetImpairmentStats (reader, &ackStats);
+        ARSTREAM_Reader_GetFreezeStats (reader, &freezeStats);
+        ARSTREAM_Sender_Delete (&sender);
+        ARSTREAM_Reader_Delete (&reader);
+
+        printf ("Virtual time     : %.1f s (%d frames at %d fps, %d bytes)\n", virtualUs / 1000000., g_NbFrames, config->fps, config->frameSize);
+        printf ("Delivered        : %d/%d frames (%.3f%%), %d skipped\n", g_NbReceived, g_NbFrames, 100. * g_NbReceived / g_NbFrames, g_NbSkipped);
+        if (g_NbReceived > 0)
+        {
+            qsort (g_LatenciesUs, g_NbReceived, sizeof (uint32_t), ARSTREAM_SimulationBench_CompareU32);
+            printf ("Latency          : p50 %u us, p99 %u us, p99.9 %u us, max %u us\n",
+                    g_LatenciesUs [(g_NbReceived - 1) * 50 / 100], g_LatenciesUs [(g_NbReceived - 1) * 99 / 100],
+                    g_LatenciesUs [(uint64_t)(g_NbReceived - 1) * 999 / 1000], g_LatenciesUs [g_NbReceived - 1]);
+        }
+        printf ("Freezes          : %u (max %u ms)\n", freezeStats.nbFreezes, freezeStats.maxFreezeMs);
+        printf ("Data packets     : %llu sent, %llu lost\n", (unsigned long long)dataStats.nbPackets, (unsigned long long)(dataStats.nbLostRandom + dataStats.nbLostBurst + dataStats.nbLostQueue));
+        printf ("Ack packets      : %llu sent, %llu lost\n", (unsigned long long)ackStats.nbPackets, (unsigned long long)(ackStats.nbLostRandom + ackStats.nbLostBurst + ackStats.nbLostQueue));
+        printf ("Context switches : %llu\n", (unsigned long long)ARSTREAM_Simulation_GetNbSwitches ());
+        printf ("Fingerprint      : %016llx\n", (unsigned long long)g_Fingerprint);
+        realUs = ARSTREAM_SimulationBench_GetRealTimeUs () - realStartUs;
+        // Real time is the only non deterministic output : keep it on stderr so runs can be diffed
+        fprintf (stderr, "Real time        : %.2f s (x%.0f)\n", realUs / 1000000., (realUs > 0) ? (double)virtualUs / realUs : 0.);
+    }
+
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    ARSTREAM_Simulation_Deinit ();
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    free (g_SendTimesUs);
+    free (g_LatenciesUs);
+    free (g_Received);
+    free (g_RecvBuffer);
+    g_SendTimesUs = NULL;
+    g_LatenciesUs = NULL;
+    g_Received = NULL;
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static void ARSTREAM_SimulationBench_Usage (const char *name)
+{
+    printf ("Usage: %s [-d seconds] [-r fps] [-s frameSize] [-f fragSize] [-l loss] [-a ackLoss] [-D delay] [-J jitter] [-S seed]\n", name);
+    printf ("  -d : virtual duration of the stream, in seconds (default 3600)\n");
+    printf ("  -r : frames per second (default 30)\n");
+    printf ("  -s : frame size, in bytes (default 20000)\n");
+    printf ("  -f : fragment size, in bytes (default 1000)\n");
+    printf ("  -l : data packets loss, in percent (default 2)\n");
+    printf ("  -a : ack packets loss, in percent (default same as -l)\n");
+    printf ("  -D : one way delay, in ms (default 10)\n");
+    printf ("  -J : jitter, in ms (default 5)\n");
+    printf ("  -S : seed of the impairments (default 1)\n");
+}
+
+#endif /* ARSTREAM_SIMULATION */
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_SimulationBench_Main (int argc, char *argv[])
+{
+#if defined (ARSTREAM_SIMULATION) && ARSTREAM_SIMULATION
+    ARSTREAM_SimulationBench_Config_t config;
+    double ackLoss = -1.;
+    int opt;
+
+    memset (&config, 0, sizeof (ARSTREAM_SimulationBench_Config_t));
+    config.durationSec = 3600;
+    config.fps = 30;
+    config.frameSize = 20000;
+    config.fragSize = 1000;
+    config.minRetryMs = 15;
+    config.maxRetryMs = 50;
+    ARSTREAM_Impairment_DefaultConfig (&(config.data));
+    config.data.lossPercent = 2.;
+    config.data.delayMs = 10;
+    config.data.jitterMs = 5;
+
+    while ((opt = getopt (argc, argv, "d:r:s:f:l:a:D:J:S:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd': config.durationSec = atoi (optarg); break;
+        case 'r': config.fps = atoi (optarg); break;
+        case 's': config.frameSize = atoi (optarg); break;
+        case 'f': config.fragSize = atoi (optarg); break;
+        case 'l': config.data.lossPercent = atof (optarg); break;
+        case 'a': ackLoss = atof (optarg); break;
+        case 'D': config.data.delayMs = atoi (optarg); break;
+        case 'J': config.data.jitterMs = atoi (optarg); break;
+        case 'S': config.data.seed = strtoul (optarg, NULL, 0); break;
+        default:
+            ARSTREAM_SimulationBench_Usage (argv[0]);
+            return 1;
+        }
+    }
+    if ((config.durationSec <= 0) ||
+        (config.fps <= 0) ||
+        (config.fragSize <= 0) ||
+        (config.frameSize < HEADER_SIZE) ||
+        (config.frameSize > config.fragSize * MAX_NB_FRAG))
+    {
+        ARSTREAM_SimulationBench_Usage (argv[0]);
+        return 1;
+    }
+
+    config.ack = config.data;
+    config.ack.seed = config.data.seed + 1;
+    if (ackLoss >= 0.)
+    {
+        config.ack.lossPercent = ackLoss;
+    }
+
+    return (ARSTREAM_SimulationBench_Run (&config) == 0) ? 0 : 1;
+#else
+    (void)argc;
+    ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "%s needs a simulation build of libARStream (ARSTREAM_SIMULATION=1)", argv[0]);
+    return 1;
+#endif
+}
@@ -0,0 +1,398 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_Stream2Bench.c
+ * @brief Checks that an ARSTREAM_Reader2_t follows sender restarts, with clock synchronization and reports
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_Stream2Bench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_Stream2Bench"
+
+#define DEFAULT_PORT (55010)
+#define DEFAULT_NB_AUS (60)
+#define DEFAULT_FPS (60)
+#define AU_SIZE (10000)
+#define AU_BUFFER_SIZE (2 * AU_SIZE)
+#define MAX_PACKET_SIZE (1500)
+#define SENDER_FIFO_SIZE (8)
+#define DRAIN_TIME_MS (300)
+#define NB_SESSIONS (2)
+
+/* Handcrafted packets : one single NAL unit access unit per packet */
+#define RAW_NB_PACKETS (10)
+#define RAW_FIRST_SSRC (0x11111111)
+#define RAW_FIRST_SEQNUM (65530) // Wraps around during the first session
+#define RAW_SECOND_SSRC (0x22222222)
+#define RAW_SECOND_SEQNUM (100) // Lower than the end of the first session
+#define RAW_JUMP_SEQNUM (40000) // Same SSRC as the second session
+#define RAW_PAYLOAD_SIZE (100)
+#define RAW_PACKET_INTERVAL_MS (2)
+
+/*
+ * Globals
+ */
+
+static pthread_mutex_t g_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static int g_Phase = 0;
+static int g_NbAusComplete [NB_SESSIONS + 3];
+static int g_NbAusIncomplete [NB_SESSIONS + 3];
+static uint8_t *g_RecvBuffer = NULL;
+
+/*
+ * Internal functions declarations
+ */
+
+static void ARSTREAM_Stream2Bench_SenderCallback (eARSTREAM_SENDER2_STATUS status, uint8_t *auBuffer, uint32_t auSize, void *custom);
+static uint8_t* ARSTREAM_Stream2Bench_ReaderCallback (eARSTREAM_READER2_CAUSE cause, uint8_t *auBuffer, uint32_t auSize, uint64_t auTimestampUs, uint32_t *newBufferCapacity, void *custom);
+static void ARSTREAM_Stream2Bench_SetPhase (int phase);
+static int ARSTREAM_Stream2Bench_GetNbAus (int phase);
+static int ARSTREAM_Stream2Bench_RunSession (int port, int session, int nbAus, int fps, ARSTREAM_Reader2_t *reader);
+static int ARSTREAM_Stream2Bench_RunRawPackets (int port);
+static void ARSTREAM_Stream2Bench_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static void ARSTREAM_Stream2Bench_SenderCallback (eARSTREAM_SENDER2_STATUS status, uint8_t *auBuffer, uint32_t auSize, void *custom)
+{
+    /* All the access units share one constant buffer */
+    (void)status;
+    (void)auBuffer;
+    (void)auSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_Stream2Bench_ReaderCallback (eARSTREAM_READER2_CAUSE cause, uint8_t *auBuffer, uint32_t auSize, uint64_t auTimestampUs, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)auBuffer;
+    (void)auSize;
+    (void)auTimestampUs;
+    (void)custom;
+    pthread_mutex_lock (&g_Mutex);
+    if (cause == ARSTREAM_READER2_CAUSE_AU_COMPLETE)
+    {
+        g_NbAusComplete [g_Phase]++;
+    }
+    else if (cause == ARSTREAM_READER2_CAUSE_AU_INCOMPLETE)
+    {
+        g_NbAusIncomplete [g_Phase]++;
+    }
+    pthread_mutex_unlock (&g_Mutex);
+    *newBufferCapacity = AU_BUFFER_SIZE;
+    return g_RecvBuffer;
+}
+
+static void ARSTREAM_Stream2Bench_SetPhase (int phase)
+{
+    pthread_mutex_lock (&g_Mutex);
+    g_Phase = phase;
+    pthread_mutex_unlock (&g_Mutex);
+}
+
+static int ARSTREAM_Stream2Bench_GetNbAus (int phase)
+{
+    int nbAus;
+    pthread_mutex_lock (&g_Mutex);
+    nbAus = g_NbAusComplete [phase];
+    pthread_mutex_unlock (&g_Mutex);
+    return nbAus;
+}
+
+static int ARSTREAM_Stream2Bench_RunSession (int port, int session, int nbAus, int fps, ARSTREAM_Reader2_t *reader)
+{
+    ARSTREAM_Sender2_t *sender = NULL;
+    ARSAL_Thread_t senderDataThread, senderControlThread;
+    ARSTREAM_Sender2_Stats_t senderStats;
+    ARSTREAM_Reader2_Stats_t readerStats;
+    ARSTREAM_Reader2_ClockSync_t clockSync;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    uint8_t *au;
+    int nbReceived;
+    int nbErrors = 0;
+    int i;
+
+    au = malloc (AU_SIZE);
+    if (au == NULL)
+    {
+        return 1;
+    }
+    /* One IDR slice, large enough to be fragmented */
+    au[0] = 0;
+    au[1] = 0;
+    au[2] = 0;
+    au[3] = 1;
+    au[4] = 0x65;
+    for (i = 5; i < AU_SIZE; i++)
+    {
+        au[i] = (uint8_t)(i | 0x80);
+    }
+
+    sender = ARSTREAM_Sender2_New ("127.0.0.1", port, ARSTREAM_Stream2Bench_SenderCallback, SENDER_FIFO_SIZE, MAX_PACKET_SIZE, NULL, &err);
+    if (sender == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender : %s", ARSTREAM_Error_ToString (err));
+        free (au);
+        return 1;
+    }
+
+    ARSTREAM_Stream2Bench_SetPhase (session);
+    ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender2_RunDataThread, sender);
+    ARSAL_Thread_Create (&senderControlThread, ARSTREAM_Sender2_RunControlThread, sender);
+    for (i = 0; i < nbAus; i++)
+    {
+        struct timespec now;
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        ARSTREAM_Sender2_SendNewAu (sender, au, AU_SIZE, ((uint64_t)now.tv_sec * 1000000) + (now.tv_nsec / 1000), 0, NULL);
+        usleep (1000000 / fps);
+    }
+    usleep (DRAIN_TIME_MS * 1000);
+
+    ARSTREAM_Sender2_StopSender (sender);
+    ARSAL_Thread_Join (senderDataThread, NULL);
+    ARSAL_Thread_Join (senderControlThread, NULL);
+    ARSAL_Thread_Destroy (&senderDataThread);
+    ARSAL_Thread_Destroy (&senderControlThread);
+
+    ARSTREAM_Sender2_GetStats (sender, &senderStats);
+    ARSTREAM_Reader2_GetStats (reader, &readerStats);
+    ARSTREAM_Reader2_GetClockSync (reader, &clockSync);
+    ARSTREAM_Sender2_Delete (&sender);
+    free (au);
+
+    nbReceived = ARSTREAM_Stream2Bench_GetNbAus (session);
+    printf ("Session %d : %d access units sent, %d received (%d incomplete)\n", session, nbAus, nbReceived, g_NbAusIncomplete [session]);
+    printf ("  Sender : %u packets sent, %u sender reports, %u receiver reports received\n", senderStats.packetsSent, senderStats.nbSenderReports, senderStats.nbReceiverReports);
+    printf ("  Reader : %u packets received, %d lost, %u sender reports received, %u receiver reports\n", readerStats.packetsReceived, readerStats.cumulativeLost, readerStats.nbSenderReports, readerStats.nbReceiverReports);
+    printf ("  Clock : %s, %u exchanges, offset %lld us, min RTT %u us\n", (clockSync.isSynchronized == 1) ? "synchronized" : "not synchronized", clockSync.nbExchanges, (long long)clockSync.offsetUs, clockSync.minRttUs);
+
+    /* Localhost does not lose packets, but leave some room for a loaded machine */
+    if (nbReceived < (nbAus * 9) / 10)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Session %d : the reader did not follow the sender", session);
+        nbErrors++;
+    }
+    if ((readerStats.packetsReceived == 0) ||
+        (readerStats.packetsReceived > senderStats.packetsSent))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Session %d : the reception statistics were not restarted with the session", session);
+        nbErrors++;
+    }
+    if ((readerStats.nbSenderReports == 0) ||
+        (senderStats.nbReceiverReports == 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Session %d : no sender/receiver report exchanged", session);
+        nbErrors++;
+    }
+    if (clockSync.isSynchronized == 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Session %d : the clocks were not synchronized", session);
+        nbErrors++;
+    }
+    return nbErrors;
+}
+
+static int ARSTREAM_Stream2Bench_RunRawPackets (int port)
+{
+    static const struct {
+        uint32_t ssrc;
+        uint16_t firstSeqNum;
+        int nbExpectedAus;
+    } rawSessions [] = {
+        { RAW_FIRST_SSRC, RAW_FIRST_SEQNUM, RAW_NB_PACKETS },
+        { RAW_SECOND_SSRC, RAW_SECOND_SEQNUM, RAW_NB_PACKETS },
+        { RAW_SECOND_SSRC, RAW_JUMP_SEQNUM, RAW_NB_PACKETS - 1 }, // The first packet after the jump is kept on probation
+    };
+    uint8_t packet [12 + RAW_PAYLOAD_SIZE];
+    struct sockaddr_in readerSin;
+    uint32_t timestamp = 0;
+    int nbErrors = 0;
+    int rawSocket;
+    int s, i;
+
+    rawSocket = socket (AF_INET, SOCK_DGRAM, 0);
+    if (rawSocket < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the raw socket");
+        return 1;
+    }
+    memset (&readerSin, 0, sizeof (readerSin));
+    readerSin.sin_family = AF_INET;
+    readerSin.sin_port = htons (port);
+    readerSin.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+
+    memset (packet, 0xA5, sizeof (packet));
+    packet[12] = 0x65; // IDR slice
+    for (s = 0; s < (int)(sizeof (rawSessions) / sizeof (rawSessions[0])); s++)
+    {
+        int phase = NB_SESSIONS + s;
+        int nbReceived;
+        ARSTREAM_Stream2Bench_SetPhase (phase);
+        for (i = 0; i < RAW_NB_PACKETS; i++)
+        {
+            uint16_t seqNum = (uint16_t)(rawSessions[s].firstSeqNum + i);
+            timestamp += 3000;
+            /* RTP header : version 2, payload type 96, marker bit (one packet per access unit) */
+            packet[0] = 0x80;
+            packet[1] = 0xE0;
+            packet[2] = (uint8_t)(seqNum >> 8);
+            packet[3] = (uint8_t)(seqNum);
+            packet[4] = (uint8_t)(timestamp >> 24);
+            packet[5] = (uint8_t)(timestamp >> 16);
+            packet[6] = (uint8_t)(timestamp >> 8);
+            packet[7] = (uint8_t)(timestamp);
+            packet[8] = (uint8_t)(rawSessions[s].ssrc >> 24);
+            packet[9] = (uint8_t)(rawSessions[s].ssrc >> 16);
+            packet[10] = (uint8_t)(rawSessions[s].ssrc >> 8);
+            packet[11] = (uint8_t)(rawSessions[s].ssrc);
+            sendto (rawSocket, packet, sizeof (packet), 0, (struct sockaddr *)&readerSin, sizeof (readerSin));
+            usleep (RAW_PACKET_INTERVAL_MS * 1000);
+        }
+        usleep (DRAIN_TIME_MS * 1000);
+        nbReceived = ARSTREAM_Stream2Bench_GetNbAus (phase);
+        printf ("Raw session %d (SSRC 0x%08x, from sequence number %d) : %d access units sent, %d received, %d expected\n",
+                s, rawSessions[s].ssrc, rawSessions[s].firstSeqNum, RAW_NB_PACKETS, nbReceived, rawSessions[s].nbExpectedAus);
+        if (nbReceived != rawSessions[s].nbExpectedAus)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Raw session %d : the reader did not resynchronize", s);
+            nbErrors++;
+        }
+    }
+
+    close (rawSocket);
+    return nbErrors;
+}
+
+static void ARSTREAM_Stream2Bench_Usage (const char *name)
+{
+    printf ("Usage: %s [-p port] [-n nbAus] [-r fps]\n", name);
+    printf ("  -p : localhost port of the reader (default %d)\n", DEFAULT_PORT);
+    printf ("  -n : number of access units sent by each sender session (default %d)\n", DEFAULT_NB_AUS);
+    printf ("  -r : access unit rate (default %d)\n", DEFAULT_FPS);
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_Stream2Bench_Main (int argc, char *argv[])
+{
+    ARSTREAM_Reader2_t *reader = NULL;
+    ARSAL_Thread_t readerDataThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    int port = DEFAULT_PORT;
+    int nbAus = DEFAULT_NB_AUS;
+    int fps = DEFAULT_FPS;
+    int nbErrors = 0;
+    int badArgs = 0;
+    int opt, session;
+
+    while ((opt = getopt (argc, argv, "p:n:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'p': port = atoi (optarg); break;
+        case 'n': nbAus = atoi (optarg); break;
+        case 'r': fps = atoi (optarg); break;
+        default:
+            badArgs = 1;
+            break;
+        }
+    }
+    if ((badArgs != 0) ||
+        (port <= 0) ||
+        (nbAus <= 0) ||
+        (fps <= 0))
+    {
+        ARSTREAM_Stream2Bench_Usage (argv[0]);
+        return 1;
+    }
+
+    g_RecvBuffer = malloc (AU_BUFFER_SIZE);
+    if (g_RecvBuffer == NULL)
+    {
+        return 1;
+    }
+    reader = ARSTREAM_Reader2_New ("127.0.0.1", port, ARSTREAM_Stream2Bench_ReaderCallback, g_RecvBuffer, AU_BUFFER_SIZE, MAX_PACKET_SIZE, NULL, &err);
+    if (reader == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the reader : %s", ARSTREAM_Error_ToString (err));
+        free (g_RecvBuffer);
+        return 1;
+    }
+    ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader2_RunDataThread, reader);
+
+    /* Each session is a new sender, as after a restart of the sending application */
+    for (session = 0; session < NB_SESSIONS; session++)
+    {
+        nbErrors += ARSTREAM_Stream2Bench_RunSession (port, session, nbAus, fps, reader);
+    }
+    nbErrors += ARSTREAM_Stream2Bench_RunRawPackets (port);
+
+    ARSTREAM_Reader2_StopReader (reader);
+    ARSAL_Thread_Join (readerDataThread, NULL);
+    ARSAL_Thread_Destroy (&readerDataThread);
+    ARSTREAM_Reader2_Delete (&reader);
+    free (g_RecvBuffer);
+    g_RecvBuffer = NULL;
+
+    printf ("%s\n", (nbErrors == 0) ? "PASSED" : "FAILED");
+    return (nbErrors == 0) ? 0 : 1;
+}
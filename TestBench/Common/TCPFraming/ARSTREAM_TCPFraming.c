@@ -0,0 +1,219 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TCPFraming.c
+ * @brief Length-prefixed frame transport over a TCP socket, shared by the TCP testbenches
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Socket.h>
+
+#include "ARSTREAM_TCPFraming.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_TCPFraming"
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Receives exactly size bytes
+ * @return 0 on success, -1 if the connection was closed or failed
+ */
+static int ARSTREAM_TCPFraming_RecvAll (int socket, uint8_t *buffer, uint32_t size);
+
+/*
+ * Internal functions implementation
+ */
+
+static int ARSTREAM_TCPFraming_RecvAll (int socket, uint8_t *buffer, uint32_t size)
+{
+    uint32_t offset = 0;
+    while (offset < size)
+    {
+        // MSG_WAITALL : one wakeup per request, unless a signal or the end of the stream interrupts it
+        ssize_t nbRead = ARSAL_Socket_Recv (socket, &buffer [offset], size - offset, MSG_WAITALL);
+        if (nbRead > 0)
+        {
+            offset += nbRead;
+        }
+        else if ((nbRead < 0) &&
+                 (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            if (nbRead < 0)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Read error : %s", strerror (errno));
+            }
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_TCPFraming_ConfigureSocket (int socket)
+{
+    int flag = 1;
+    if (ARSAL_Socket_Setsockopt (socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof (flag)) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to set TCP_NODELAY : %s", strerror (errno));
+        return -1;
+    }
+    return 0;
+}
+
+int ARSTREAM_TCPFraming_SendFrame (int socket, uint32_t num, const uint8_t *frame, uint32_t size)
+{
+    uint32_t header [2];
+    struct iovec iov [2];
+    struct msghdr msg;
+    int iovIndex = 0;
+
+    if ((frame == NULL) &&
+        (size > 0))
+    {
+        return -1;
+    }
+
+    header [0] = htonl (size);
+    header [1] = htonl (num);
+    iov [0].iov_base = header;
+    iov [0].iov_len = ARSTREAM_TCPFRAMING_HEADER_SIZE;
+    iov [1].iov_base = (void *)frame;
+    iov [1].iov_len = size;
+    memset (&msg, 0, sizeof (msg));
+
+    while (iovIndex < 2)
+    {
+        ssize_t nbSent;
+        msg.msg_iov = &iov [iovIndex];
+        msg.msg_iovlen = 2 - iovIndex;
+        nbSent = sendmsg (socket, &msg, MSG_NOSIGNAL);
+        if (nbSent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Send error : %s", strerror (errno));
+            return -1;
+        }
+
+        /* Partial write : skip what was sent, and send the rest */
+        while ((iovIndex < 2) &&
+               ((size_t)nbSent >= iov [iovIndex].iov_len))
+        {
+            nbSent -= iov [iovIndex].iov_len;
+            iovIndex++;
+        }
+        if (iovIndex < 2)
+        {
+            iov [iovIndex].iov_base = (uint8_t *)iov [iovIndex].iov_base + nbSent;
+            iov [iovIndex].iov_len -= nbSent;
+        }
+    }
+    return 0;
+}
+
+int ARSTREAM_TCPFraming_ReadFrame (int socket, uint8_t *frame, uint32_t capacity, uint32_t *num)
+{
+    uint32_t header [2];
+    uint32_t size;
+
+    if ((frame == NULL) ||
+        (capacity == 0))
+    {
+        return ARSTREAM_TCPFRAMING_ERROR;
+    }
+
+    if (ARSTREAM_TCPFraming_RecvAll (socket, (uint8_t *)header, ARSTREAM_TCPFRAMING_HEADER_SIZE) != 0)
+    {
+        return ARSTREAM_TCPFRAMING_ERROR;
+    }
+    size = ntohl (header [0]);
+    if (num != NULL)
+    {
+        *num = ntohl (header [1]);
+    }
+
+    if (size > capacity)
+    {
+        /* Keep the stream in sync : read the frame by chunks into the buffer, then drop it */
+        uint32_t remaining = size;
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Frame too big for buffer (%u / %u), dropped", size, capacity);
+        while (remaining > 0)
+        {
+            uint32_t chunk = (remaining < capacity) ? remaining : capacity;
+            if (ARSTREAM_TCPFraming_RecvAll (socket, frame, chunk) != 0)
+            {
+                return ARSTREAM_TCPFRAMING_ERROR;
+            }
+            remaining -= chunk;
+        }
+        return ARSTREAM_TCPFRAMING_FRAME_TOO_BIG;
+    }
+
+    if (ARSTREAM_TCPFraming_RecvAll (socket, frame, size) != 0)
+    {
+        return ARSTREAM_TCPFRAMING_ERROR;
+    }
+    return (int)size;
+}
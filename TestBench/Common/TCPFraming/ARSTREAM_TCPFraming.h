@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TCPFraming.h
+ * @brief Length-prefixed frame transport over a TCP socket, shared by the TCP testbenches
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_TCPFRAMING_H_
+#define _ARSTREAM_TCPFRAMING_H_
+
+#include <inttypes.h>
+
+/**
+ * @brief Size of the header sent before each frame
+ * The header holds the frame size then the frame number, both as 32 bits big endian values.
+ */
+#define ARSTREAM_TCPFRAMING_HEADER_SIZE (8)
+
+/**
+ * @brief ARSTREAM_TCPFraming_ReadFrame() return value when the connection was closed or failed
+ */
+#define ARSTREAM_TCPFRAMING_ERROR (-1)
+
+/**
+ * @brief ARSTREAM_TCPFraming_ReadFrame() return value when a frame did not fit in the given buffer
+ * The frame was read and discarded, the stream is still usable.
+ */
+#define ARSTREAM_TCPFRAMING_FRAME_TOO_BIG (-2)
+
+/**
+ * @brief Configures a connected TCP socket for frame streaming
+ * Disables Nagle's algorithm, so that the end of a frame is not held back waiting for an ACK.
+ * @param socket The connected socket
+ * @return 0 on success, -1 on error
+ */
+int ARSTREAM_TCPFraming_ConfigureSocket (int socket);
+
+/**
+ * @brief Sends a frame, preceded by its header, in a single system call
+ * Blocks until the whole frame was given to the kernel.
+ * @param socket The connected socket
+ * @param num The frame number
+ * @param frame The frame data
+ * @param size The frame size
+ * @return 0 on success, -1 on error
+ */
+int ARSTREAM_TCPFraming_SendFrame (int socket, uint32_t num, const uint8_t *frame, uint32_t size);
+
+/**
+ * @brief Reads the next frame
+ * The frame is received straight into the given buffer: there is no intermediate copy.
+ * @param socket The connected socket
+ * @param frame The buffer to fill
+ * @param capacity The buffer capacity
+ * @param[out] num Optional pointer which will hold the frame number
+ * @return The frame size, ARSTREAM_TCPFRAMING_FRAME_TOO_BIG, or ARSTREAM_TCPFRAMING_ERROR
+ */
+int ARSTREAM_TCPFraming_ReadFrame (int socket, uint8_t *frame, uint32_t capacity, uint32_t *num);
+
+#endif /* _ARSTREAM_TCPFRAMING_H_ */
@@ -49,6 +49,8 @@
 #include <libARSAL/ARSAL_Print.h>
 #include <libARSAL/ARSAL_Socket.h>
 
+#include "../TCPFraming/ARSTREAM_TCPFraming.h"
+
 /*
  * Macros
  */
@@ -61,10 +63,6 @@
 
 #define NB_FRAMES_FOR_AVERAGE (15)
 
-#define HEADER_MAGIC (0x37333331)
-
-#define READSIZE (1000)
-
 #define __IP "127.0.0.1"
 
 /*
@@ -73,16 +71,8 @@
 
 typedef struct {
     int socket;
-    uint8_t *buffer;
-    uint32_t index;
 } ARSTREAM_TCPReader_t;
 
-typedef struct {
-    uint32_t header;
-    uint32_t size;
-    uint32_t num;
-} ARSTREAM_TCPReader_FrameHeader_t;
-
 /*
  * Globals
  */
@@ -102,7 +92,7 @@ static int stillRunning = 1;
 ARSTREAM_TCPReader_t *ARSTREAM_TCPReader_Create (int port, const char *ip);
 
 /**
- * Send a frame through an ARSTREAM_TCPReader_t
+ * Read a frame from an ARSTREAM_TCPReader_t
  */
 int ARSTREAM_TCPReader_ReadFrame (ARSTREAM_TCPReader_t *reader, uint8_t *frame, uint32_t capacity);
 
@@ -123,8 +113,6 @@ ARSTREAM_TCPReader_t *ARSTREAM_TCPReader_Create (int port, const char *ip)
         return NULL;
     }
 
-    reader->index = 0;
-
     reader->socket = ARSAL_Socket_Create (AF_INET, SOCK_STREAM, 0);
 
     if (reader->socket == -1)
@@ -146,14 +134,7 @@ ARSTREAM_TCPReader_t *ARSTREAM_TCPReader_Create (int port, const char *ip)
         return NULL;
     }
 
-    reader->buffer = malloc (2*FRAME_MAX_SIZE);
-    if (reader->buffer == NULL)
-    {
-        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Malloc error");
-        ARSAL_Socket_Close (reader->socket);
-        free (reader);
-        return NULL;
-    }
+    ARSTREAM_TCPFraming_ConfigureSocket (reader->socket);
 
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Connected !");
 
@@ -168,99 +149,7 @@ int ARSTREAM_TCPReader_ReadFrame (ARSTREAM_TCPReader_t *reader, uint8_t *frame,
         return -1;
     }
 
-    /*
-     * Read frame algo :
-     * 1> Read data until the buffer contains the HEADER_MAGIC number
-     * 2> Discard all data before the number
-     * 3> Read data until the buffer contains header.size bytes
-     * 4> Copy this data to frame, and return its size
-     */
-
-    int magicFound = 0;
-    int magicIndex = 0;
-    ARSTREAM_TCPReader_FrameHeader_t header;
-    while (magicFound == 0)
-    {
-        if ((reader->index + READSIZE) > capacity)
-        {
-            reader->index = 0;
-        }
-        int nbRead = ARSAL_Socket_Recv (reader->socket, &(reader->buffer [reader->index]), READSIZE, 0);
-        if (nbRead < 0)
-        {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Read error %s", strerror (errno));
-            break;
-        }
-
-        reader->index += nbRead;
-
-        int i;
-        for (i = 0; i < (reader->index - sizeof header); i++)
-        {
-            uint32_t magic = 0;
-            memcpy ((uint8_t *)&magic, &(reader->buffer[i]), sizeof magic);
-            if (magic == HEADER_MAGIC)
-            {
-                magicFound = 1;
-                magicIndex = i;
-                break;
-            }
-        }
-    }
-
-    if (magicFound == 1)
-    {
-        memcpy (&header, &(reader->buffer [magicIndex]), sizeof header);
-        reader->index -= (magicIndex + sizeof header);
-        memmove (reader->buffer, &(reader->buffer [magicIndex + sizeof header]), reader->index);
-    }
-    else
-    {
-        return -1;
-    }
-
-    int frameComplete = 0;
-    while (frameComplete == 0)
-    {
-        if (reader->index + READSIZE > capacity)
-        {
-            reader->index = 0;
-        }
-        int nbRead = ARSAL_Socket_Recv (reader->socket, &(reader->buffer [reader->index]), READSIZE, 0);
-        if (nbRead < 0)
-        {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Read error %s", strerror (errno));
-            break;
-        }
-
-        reader->index += nbRead;
-
-        if (reader->index >= header.size)
-        {
-            frameComplete = 1;
-        }
-    }
-
-    if (frameComplete == 1)
-    {
-        if (header.size <= capacity)
-        {
-            memcpy (frame, reader->buffer, header.size);
-        }
-        else
-        {
-            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Can't copy frame -> Too big for buffer (%d / %d)", header.size, capacity);
-        }
-        reader->index -= header.size;
-        memmove (reader->buffer, &(reader->buffer [header.size]), reader->index);
-    }
-    else
-    {
-        return -1;
-    }
-
-    return header.size;
-
+    return ARSTREAM_TCPFraming_ReadFrame (reader->socket, frame, capacity, NULL);
 }
 
 void ARSTREAM_TCPReader_Delete (ARSTREAM_TCPReader_t **reader)
@@ -269,7 +158,6 @@ void ARSTREAM_TCPReader_Delete (ARSTREAM_TCPReader_t **reader)
         (*reader != NULL))
     {
         ARSAL_Socket_Close ((*reader)->socket);
-        free ((*reader)->buffer);
         free (*reader);
         *reader = NULL;
     }
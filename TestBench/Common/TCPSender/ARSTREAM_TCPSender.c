@@ -50,6 +50,8 @@
 #include <libARSAL/ARSAL_Print.h>
 #include <libARSAL/ARSAL_Socket.h>
 
+#include "../TCPFraming/ARSTREAM_TCPFraming.h"
+
 /*
  * Macros
  */
@@ -73,8 +75,6 @@
 
 #define NB_FRAMES_FOR_AVERAGE (15)
 
-#define HEADER_MAGIC (0x37333331)
-
 /*
  * Types
  */
@@ -84,12 +84,6 @@ typedef struct {
     int csocket;
 } ARSTREAM_TCPSender_t;
 
-typedef struct {
-    uint32_t header;
-    uint32_t size;
-    uint32_t num;
-} ARSTREAM_TCPSender_FrameHeader_t;
-
 /*
  * Globals
  */
@@ -117,7 +111,7 @@ ARSTREAM_TCPSender_t *ARSTREAM_TCPSender_Create (int port);
 /**
  * Send a frame through an ARSTREAM_TCPSender_t
  */
-void ARSTREAM_TCPSender_SendFrame (ARSTREAM_TCPSender_t *sender, ARSTREAM_TCPSender_FrameHeader_t *header, uint8_t *frame);
+void ARSTREAM_TCPSender_SendFrame (ARSTREAM_TCPSender_t *sender, uint32_t num, uint8_t *frame, uint32_t size);
 
 /**
  * Delete an ARSTREAM_TCPSender_t
@@ -131,7 +125,7 @@ void ARSTREAM_TCPSender_Delete (ARSTREAM_TCPSender_t **sender);
 void* TCP_fakeEncoderThread (void *param)
 {
     uint8_t *buffer;
-    ARSTREAM_TCPSender_FrameHeader_t header = { HEADER_MAGIC, 0, 0 };
+    uint32_t num = 0;
     ARSTREAM_TCPSender_t *sender = (ARSTREAM_TCPSender_t *)param;
     srand (time (NULL));
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Encoder thread running");
@@ -143,17 +137,16 @@ void* TCP_fakeEncoderThread (void *param)
     }
     while (stillRunning)
     {
-        header.num ++;
+        num ++;
         int frameSize = rand () % FRAME_MAX_SIZE;
         if (frameSize < FRAME_MIN_SIZE)
         {
             frameSize = FRAME_MIN_SIZE;
         }
-        header.size = frameSize;
-        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Generating a frame of size %d with number %u", header.size, header.num);
+        ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Generating a frame of size %d with number %u", frameSize, num);
 
-        memset (buffer, header.num, header.size);
-        ARSTREAM_TCPSender_SendFrame (sender, &header, buffer);
+        memset (buffer, num, frameSize);
+        ARSTREAM_TCPSender_SendFrame (sender, num, buffer, frameSize);
         usleep (1000 * TIME_BETWEEN_FRAMES_MS);
     }
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Encoder thread ended");
@@ -207,22 +200,25 @@ ARSTREAM_TCPSender_t *ARSTREAM_TCPSender_Create (int port)
         return NULL;
     }
 
+    ARSTREAM_TCPFraming_ConfigureSocket (sender->csocket);
+
     ARSAL_PRINT (ARSAL_PRINT_WARNING, __TAG__, "Connected !");
 
     return sender;
 }
 
-void ARSTREAM_TCPSender_SendFrame (ARSTREAM_TCPSender_t *sender, ARSTREAM_TCPSender_FrameHeader_t *header, uint8_t *frame)
+void ARSTREAM_TCPSender_SendFrame (ARSTREAM_TCPSender_t *sender, uint32_t num, uint8_t *frame, uint32_t size)
 {
     if ((sender == NULL) ||
-        (header == NULL) ||
         (frame  == NULL))
     {
         return;
     }
 
-    ARSAL_Socket_Send (sender->csocket, header, sizeof (ARSTREAM_TCPSender_FrameHeader_t), 0);
-    ARSAL_Socket_Send (sender->csocket, frame, header->size, 0);
+    if (ARSTREAM_TCPFraming_SendFrame (sender->csocket, num, frame, size) != 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to send frame %u", num);
+    }
 }
 
 void ARSTREAM_TCPSender_Delete (ARSTREAM_TCPSender_t **sender)
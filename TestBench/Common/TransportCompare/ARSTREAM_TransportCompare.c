@@ -0,0 +1,1243 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportCompare.c
+ * @brief Streams the same frames over ARStream and over TCP through the same impaired links, and compares them
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Socket.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARStream/ARStream.h>
+
+#include "../TCPFraming/ARSTREAM_TCPFraming.h"
+#include "ARSTREAM_TransportCompare.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_TransportCompare"
+
+#define PROFILE_NAME_SIZE (64)
+#define LINE_SIZE (1024)
+#define MAX_NB_FRAG (128)
+#define NB_SEND_BUFFERS (16)
+#define SENDER_QUEUE_SIZE (8)
+#define DRAIN_TIME_MS (500)
+#define HEADER_SIZE (4)
+
+/* Frame sizes vary by +/- FRAME_SIZE_VARIATION_PERCENT around the I or P frame size */
+#define FRAME_SIZE_VARIATION_PERCENT (25)
+#define FRAME_SOURCE_SEED (0x5EED)
+
+/* A gap longer than FREEZE_THRESHOLD_PERIODS frame periods between two delivered frames is a freeze */
+#define FREEZE_THRESHOLD_PERIODS (2)
+
+/* TCP model (Linux defaults) */
+#define TRANSPORT_COMPARE_TCP_MSS (1448)
+#define TCP_MIN_RTO_MS (200)
+#define TCP_MIN_TLP_MS (10)
+#define TCP_DUPACK_THRESHOLD (3)
+#define RELAY_READ_SIZE (64 * 1024)
+
+/*
+ * Types
+ */
+
+typedef struct {
+    char name [PROFILE_NAME_SIZE];
+    int nbFrames;
+    int fps;
+    int pFrameSize;
+    int iFrameRatio;
+    int gopLength;
+    int fragSize;
+    int minRetryMs;
+    int maxRetryMs;
+    int ackIntervalMs;
+    ARSTREAM_Impairment_Config_t data;
+    ARSTREAM_Impairment_Config_t ack;
+} ARSTREAM_TransportCompare_Profile_t;
+
+typedef struct {
+    int nbReceived;
+    uint32_t latencyP50Us;
+    uint32_t latencyP95Us;
+    uint32_t latencyP99Us;
+    uint32_t latencyMaxUs;
+    uint32_t nbFreezes;
+    uint32_t totalFreezeMs;
+    uint32_t maxFreezeMs;
+    uint64_t nbPackets; /**< Packets (ARStream) or segments (TCP) which went on the link */
+    uint64_t nbLost; /**< Packets or segments lost on the link */
+    uint64_t nbRetransmissions; /**< TCP only : fast retransmissions + timeouts */
+    uint64_t nbTimeouts; /**< TCP only : retransmission timeouts */
+} ARSTREAM_TransportCompare_Result_t;
+
+typedef struct ARSTREAM_TransportCompare_Segment_t {
+    struct ARSTREAM_TransportCompare_Segment_t *next;
+    uint64_t deliveryUs;
+    uint32_t size;
+    uint8_t data [TRANSPORT_COMPARE_TCP_MSS];
+} ARSTREAM_TransportCompare_Segment_t;
+
+/**
+ * @brief Emulated link between the TCP sender and the TCP reader
+ * The ingress thread reads the sender stream, cuts it into MSS sized segments, and computes the time at which
+ * the reader TCP stack would give each segment to the application. The egress thread writes the segments to
+ * the reader connection at that time.
+ */
+typedef struct {
+    ARSTREAM_Impairment_Config_t config;
+    uint64_t rttUs;
+
+    /* Model state, only used by the ingress thread */
+    uint64_t prngState;
+    int isInBadState;
+    uint64_t linkFreeTimeUs;
+    uint64_t lastDeliveryUs;
+
+    /* Segments queue, ordered by delivery time */
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    ARSTREAM_TransportCompare_Segment_t *head;
+    ARSTREAM_TransportCompare_Segment_t *tail;
+    int isClosed;
+
+    int inSocket;
+    int outSocket;
+
+    uint64_t nbTransmissions;
+    uint64_t nbLost;
+    uint64_t nbFastRetransmits;
+    uint64_t nbTimeouts;
+} ARSTREAM_TransportCompare_TCPLink_t;
+
+typedef struct {
+    int socket;
+    uint8_t *buffer;
+    uint32_t capacity;
+} ARSTREAM_TransportCompare_TCPReader_t;
+
+/*
+ * Globals
+ */
+
+static pthread_mutex_t g_RecvMutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t *g_SendTimesUs = NULL;
+static uint64_t *g_DeliveryTimesUs = NULL;
+static uint32_t *g_LatenciesUs = NULL;
+static uint8_t *g_Received = NULL;
+static int g_NbFrames = 0;
+static int g_NbReceived = 0;
+static uint8_t *g_RecvBuffer = NULL;
+static uint32_t g_RecvBufferSize = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+static uint64_t ARSTREAM_TransportCompare_GetTimeUs (void);
+static void ARSTREAM_TransportCompare_DefaultProfile (ARSTREAM_TransportCompare_Profile_t *profile, const char *name);
+static int ARSTREAM_TransportCompare_SetImpairmentKey (ARSTREAM_Impairment_Config_t *config, const char *key, const char *value);
+static int ARSTREAM_TransportCompare_ParseLine (char *line, ARSTREAM_TransportCompare_Profile_t *profile);
+static int ARSTREAM_TransportCompare_BuiltIn (ARSTREAM_TransportCompare_Profile_t **profiles);
+static int ARSTREAM_TransportCompare_ReadFile (const char *path, ARSTREAM_TransportCompare_Profile_t **profiles);
+static uint32_t ARSTREAM_TransportCompare_MaxFrameSize (ARSTREAM_TransportCompare_Profile_t *profile);
+static uint32_t ARSTREAM_TransportCompare_FrameSize (ARSTREAM_TransportCompare_Profile_t *profile, int index);
+static void ARSTREAM_TransportCompare_FillFrame (uint8_t *frame, uint32_t size, uint32_t index);
+static int ARSTREAM_TransportCompare_InitRecording (ARSTREAM_TransportCompare_Profile_t *profile);
+static void ARSTREAM_TransportCompare_FrameReceived (uint32_t index);
+static void ARSTREAM_TransportCompare_FinishRecording (ARSTREAM_TransportCompare_Profile_t *profile, ARSTREAM_TransportCompare_Result_t *result);
+static int ARSTREAM_TransportCompare_CompareU32 (const void *a, const void *b);
+static void ARSTREAM_TransportCompare_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+static uint8_t* ARSTREAM_TransportCompare_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+static int ARSTREAM_TransportCompare_RunARStream (ARSTREAM_TransportCompare_Profile_t *profile, int udpPort, ARSTREAM_TransportCompare_Result_t *result);
+static uint64_t ARSTREAM_TransportCompare_Random (ARSTREAM_TransportCompare_TCPLink_t *link);
+static int ARSTREAM_TransportCompare_Draw (ARSTREAM_TransportCompare_TCPLink_t *link, float percent);
+static int ARSTREAM_TransportCompare_Transmit (ARSTREAM_TransportCompare_TCPLink_t *link, uint32_t size, uint64_t sendUs, int isRetransmission, uint64_t *deliveryUs);
+static uint64_t ARSTREAM_TransportCompare_ScheduleSegment (ARSTREAM_TransportCompare_TCPLink_t *link, uint32_t size, uint64_t nowUs, int nbFollowingSegments);
+static void* ARSTREAM_TransportCompare_IngressThread (void *param);
+static void* ARSTREAM_TransportCompare_EgressThread (void *param);
+static void* ARSTREAM_TransportCompare_TCPReaderThread (void *param);
+static int ARSTREAM_TransportCompare_ConnectLocal (int *clientSocket, int *serverSocket);
+static int ARSTREAM_TransportCompare_RunTCP (ARSTREAM_TransportCompare_Profile_t *profile, ARSTREAM_TransportCompare_Result_t *result);
+static void ARSTREAM_TransportCompare_PrintResult (ARSTREAM_TransportCompare_Profile_t *profile, const char *transport, ARSTREAM_TransportCompare_Result_t *result, int csv);
+static void ARSTREAM_TransportCompare_Usage (const char *name);
+
+/*
+ * Internal functions implementation
+ */
+
+static uint64_t ARSTREAM_TransportCompare_GetTimeUs (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void ARSTREAM_TransportCompare_DefaultProfile (ARSTREAM_TransportCompare_Profile_t *profile, const char *name)
+{
+    memset (profile, 0, sizeof (ARSTREAM_TransportCompare_Profile_t));
+    snprintf (profile->name, PROFILE_NAME_SIZE, "%s", name);
+    profile->nbFrames = 300;
+    profile->fps = 30;
+    profile->pFrameSize = 8000;
+    profile->iFrameRatio = 5;
+    profile->gopLength = 30;
+    profile->fragSize = 1000;
+    profile->minRetryMs = 15;
+    profile->maxRetryMs = 50;
+    profile->ackIntervalMs = ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT;
+    ARSTREAM_Impairment_DefaultConfig (&(profile->data));
+    ARSTREAM_Impairment_DefaultConfig (&(profile->ack));
+    profile->data.seed = 1;
+    profile->ack.seed = 2;
+}
+
+static int ARSTREAM_TransportCompare_SetImpairmentKey (ARSTREAM_Impairment_Config_t *config, const char *key, const char *value)
+{
+    if (strcmp (key, "loss") == 0) { config->lossPercent = atof (value); }
+    else if (strcmp (key, "burst_enter") == 0) { config->burstEnterPercent = atof (value); }
+    else if (strcmp (key, "burst_exit") == 0) { config->burstExitPercent = atof (value); }
+    else if (strcmp (key, "burst_loss") == 0) { config->burstLossPercent = atof (value); }
+    else if (strcmp (key, "delay") == 0) { config->delayMs = atoi (value); }
+    else if (strcmp (key, "jitter") == 0) { config->jitterMs = atoi (value); }
+    else if (strcmp (key, "reorder") == 0) { config->reorderPercent = atof (value); }
+    else if (strcmp (key, "reorder_delay") == 0) { config->reorderDelayMs = atoi (value); }
+    else if (strcmp (key, "dup") == 0) { config->duplicatePercent = atof (value); }
+    else if (strcmp (key, "bw") == 0) { config->bandwidthKbps = atoi (value); }
+    else if (strcmp (key, "queue") == 0) { config->queueLimitBytes = atoi (value); }
+    else if (strcmp (key, "seed") == 0) { config->seed = strtoul (value, NULL, 0); }
+    else { return -1; }
+    return 0;
+}
+
+static int ARSTREAM_TransportCompare_ParseLine (char *line, ARSTREAM_TransportCompare_Profile_t *profile)
+{
+    char *saveptr = NULL;
+    char *token = strtok_r (line, " \t\r\n", &saveptr);
+
+    if ((token == NULL) ||
+        (token [0] == '#'))
+    {
+        return 0;
+    }
+    ARSTREAM_TransportCompare_DefaultProfile (profile, token);
+
+    while ((token = strtok_r (NULL, " \t\r\n", &saveptr)) != NULL)
+    {
+        char *value = strchr (token, '=');
+        int ret = 0;
+        if (value == NULL)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Profile %s : missing value for %s", profile->name, token);
+            return -1;
+        }
+        *value++ = '\0';
+
+        if (strcmp (token, "frames") == 0) { profile->nbFrames = atoi (value); }
+        else if (strcmp (token, "fps") == 0) { profile->fps = atoi (value); }
+        else if (strcmp (token, "size") == 0) { profile->pFrameSize = atoi (value); }
+        else if (strcmp (token, "iratio") == 0) { profile->iFrameRatio = atoi (value); }
+        else if (strcmp (token, "gop") == 0) { profile->gopLength = atoi (value); }
+        else if (strcmp (token, "frag") == 0) { profile->fragSize = atoi (value); }
+        else if (strcmp (token, "minretry") == 0) { profile->minRetryMs = atoi (value); }
+        else if (strcmp (token, "maxretry") == 0) { profile->maxRetryMs = atoi (value); }
+        else if (strcmp (token, "ackinterval") == 0) { profile->ackIntervalMs = atoi (value); }
+        else if (strncmp (token, "data.", 5) == 0)
+        {
+            ret = ARSTREAM_TransportCompare_SetImpairmentKey (&(profile->data), token + 5, value);
+        }
+        else if (strncmp (token, "ack.", 4) == 0)
+        {
+            ret = ARSTREAM_TransportCompare_SetImpairmentKey (&(profile->ack), token + 4, value);
+        }
+        else
+        {
+            // Unprefixed impairment keys apply to both directions (seeds are kept different)
+            uint32_t dataSeed = profile->data.seed, ackSeed = profile->ack.seed;
+            ret = ARSTREAM_TransportCompare_SetImpairmentKey (&(profile->data), token, value);
+            if (ret == 0)
+            {
+                ARSTREAM_TransportCompare_SetImpairmentKey (&(profile->ack), token, value);
+                if (strcmp (token, "seed") == 0)
+                {
+                    profile->ack.seed = profile->data.seed + 1;
+                }
+                else
+                {
+                    profile->data.seed = dataSeed;
+                    profile->ack.seed = ackSeed;
+                }
+            }
+        }
+        if (ret != 0)
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Profile %s : unknown key %s", profile->name, token);
+            return -1;
+        }
+    }
+
+    if ((profile->nbFrames <= 0) ||
+        (profile->fps <= 0) ||
+        (profile->fragSize <= 0) ||
+        (profile->gopLength <= 0) ||
+        (profile->iFrameRatio <= 0) ||
+        (profile->pFrameSize < HEADER_SIZE) ||
+        (ARSTREAM_TransportCompare_MaxFrameSize (profile) > (uint32_t)(profile->fragSize * MAX_NB_FRAG)) ||
+        (profile->minRetryMs <= 0) ||
+        (profile->maxRetryMs < profile->minRetryMs))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Profile %s : invalid stream parameters", profile->name);
+        return -1;
+    }
+    return 1;
+}
+
+static int ARSTREAM_TransportCompare_BuiltIn (ARSTREAM_TransportCompare_Profile_t **profiles)
+{
+    static const char *lines [] = {
+        "perfect",
+        "random_loss_1 loss=1",
+        "random_loss_5 loss=5",
+        "burst_loss burst_enter=2 burst_exit=25 burst_loss=70",
+        "long_rtt delay=40 jitter=10",
+        "long_rtt_loss_2 delay=40 jitter=10 loss=2",
+        "bandwidth_6M data.bw=6000 data.queue=60000 data.delay=5 ack.delay=5",
+    };
+    int nbLines = sizeof (lines) / sizeof (lines [0]);
+    int nbProfiles = 0;
+    int i;
+
+    *profiles = malloc (nbLines * sizeof (ARSTREAM_TransportCompare_Profile_t));
+    if (*profiles == NULL)
+    {
+        return -1;
+    }
+    for (i = 0; i < nbLines; i++)
+    {
+        char line [LINE_SIZE];
+        snprintf (line, LINE_SIZE, "%s", lines [i]);
+        if (ARSTREAM_TransportCompare_ParseLine (line, &((*profiles) [nbProfiles])) == 1)
+        {
+            nbProfiles++;
+        }
+    }
+    return nbProfiles;
+}
+
+static int ARSTREAM_TransportCompare_ReadFile (const char *path, ARSTREAM_TransportCompare_Profile_t **profiles)
+{
+    FILE *file = fopen (path, "r");
+    char line [LINE_SIZE];
+    int nbProfiles = 0;
+    int capacity = 0;
+
+    *profiles = NULL;
+    if (file == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to open %s", path);
+        return -1;
+    }
+    while (fgets (line, LINE_SIZE, file) != NULL)
+    {
+        ARSTREAM_TransportCompare_Profile_t profile;
+        int ret = ARSTREAM_TransportCompare_ParseLine (line, &profile);
+        if (ret < 0)
+        {
+            nbProfiles = -1;
+            break;
+        }
+        if (ret == 0)
+        {
+            continue;
+        }
+        if (nbProfiles == capacity)
+        {
+            ARSTREAM_TransportCompare_Profile_t *newProfiles;
+            capacity = (capacity == 0) ? 8 : capacity * 2;
+            newProfiles = realloc (*profiles, capacity * sizeof (ARSTREAM_TransportCompare_Profile_t));
+            if (newProfiles == NULL)
+            {
+                nbProfiles = -1;
+                break;
+            }
+            *profiles = newProfiles;
+        }
+        (*profiles) [nbProfiles++] = profile;
+    }
+    fclose (file);
+    return nbProfiles;
+}
+
+static uint32_t ARSTREAM_TransportCompare_MaxFrameSize (ARSTREAM_TransportCompare_Profile_t *profile)
+{
+    return (uint32_t)profile->pFrameSize * profile->iFrameRatio * (100 + FRAME_SIZE_VARIATION_PERCENT) / 100;
+}
+
+static uint32_t ARSTREAM_TransportCompare_FrameSize (ARSTREAM_TransportCompare_Profile_t *profile, int index)
+{
+    // Stateless (splitmix64 of the index), so that both transports get the exact same frame sequence
+    uint64_t hash = (uint64_t)FRAME_SOURCE_SEED + (uint64_t)index * 0x9E3779B97F4A7C15ULL;
+    uint32_t baseSize = profile->pFrameSize;
+    uint32_t size;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+
+    if ((index % profile->gopLength) == 0)
+    {
+        baseSize *= profile->iFrameRatio;
+    }
+    size = (uint32_t)((uint64_t)baseSize * (100 - FRAME_SIZE_VARIATION_PERCENT + hash % (2 * FRAME_SIZE_VARIATION_PERCENT + 1)) / 100);
+    return (size < HEADER_SIZE) ? HEADER_SIZE : size;
+}
+
+static void ARSTREAM_TransportCompare_FillFrame (uint8_t *frame, uint32_t size, uint32_t index)
+{
+    uint32_t i;
+    memcpy (frame, &index, HEADER_SIZE);
+    for (i = HEADER_SIZE; i < size; i++)
+    {
+        frame [i] = (uint8_t)(index + i);
+    }
+}
+
+static int ARSTREAM_TransportCompare_InitRecording (ARSTREAM_TransportCompare_Profile_t *profile)
+{
+    g_NbFrames = profile->nbFrames;
+    g_NbReceived = 0;
+    g_SendTimesUs = calloc (profile->nbFrames, sizeof (uint64_t));
+    g_DeliveryTimesUs = calloc (profile->nbFrames, sizeof (uint64_t));
+    g_LatenciesUs = calloc (profile->nbFrames, sizeof (uint32_t));
+    g_Received = calloc (profile->nbFrames, 1);
+    if ((g_SendTimesUs == NULL) ||
+        (g_DeliveryTimesUs == NULL) ||
+        (g_LatenciesUs == NULL) ||
+        (g_Received == NULL))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static void ARSTREAM_TransportCompare_FrameReceived (uint32_t index)
+{
+    uint64_t nowUs = ARSTREAM_TransportCompare_GetTimeUs ();
+    pthread_mutex_lock (&g_RecvMutex);
+    if ((index < (uint32_t)g_NbFrames) &&
+        (g_Received [index] == 0))
+    {
+        g_Received [index] = 1;
+        g_DeliveryTimesUs [g_NbReceived] = nowUs;
+        g_LatenciesUs [g_NbReceived++] = (uint32_t)(nowUs - g_SendTimesUs [index]);
+    }
+    pthread_mutex_unlock (&g_RecvMutex);
+}
+
+static void ARSTREAM_TransportCompare_FinishRecording (ARSTREAM_TransportCompare_Profile_t *profile, ARSTREAM_TransportCompare_Result_t *result)
+{
+    uint64_t freezeThresholdUs = (uint64_t)FREEZE_THRESHOLD_PERIODS * 1000000 / profile->fps;
+    int i;
+
+    if (g_NbReceived > 0)
+    {
+        /* Same freeze definition for both transports : a too long gap between two displayed frames */
+        for (i = 1; i < g_NbReceived; i++)
+        {
+            uint64_t gapUs = g_DeliveryTimesUs [i] - g_DeliveryTimesUs [i - 1];
+            if (gapUs > freezeThresholdUs)
+            {
+                uint32_t freezeMs = (uint32_t)(gapUs / 1000);
+                result->nbFreezes++;
+                result->totalFreezeMs += freezeMs;
+                if (freezeMs > result->maxFreezeMs)
+                {
+                    result->maxFreezeMs = freezeMs;
+                }
+            }
+        }
+
+        qsort (g_LatenciesUs, g_NbReceived, sizeof (uint32_t), ARSTREAM_TransportCompare_CompareU32);
+        result->latencyP50Us = g_LatenciesUs [(g_NbReceived - 1) * 50 / 100];
+        result->latencyP95Us = g_LatenciesUs [(g_NbReceived - 1) * 95 / 100];
+        result->latencyP99Us = g_LatenciesUs [(g_NbReceived - 1) * 99 / 100];
+        result->latencyMaxUs = g_LatenciesUs [g_NbReceived - 1];
+    }
+    result->nbReceived = g_NbReceived;
+
+    free (g_SendTimesUs);
+    free (g_DeliveryTimesUs);
+    free (g_LatenciesUs);
+    free (g_Received);
+    g_SendTimesUs = NULL;
+    g_DeliveryTimesUs = NULL;
+    g_LatenciesUs = NULL;
+    g_Received = NULL;
+}
+
+static int ARSTREAM_TransportCompare_CompareU32 (const void *a, const void *b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static void ARSTREAM_TransportCompare_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)status;
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+}
+
+static uint8_t* ARSTREAM_TransportCompare_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    (void)numberOfSkippedFrames;
+    (void)isFlushFrame;
+    (void)custom;
+    if ((cause == ARSTREAM_READER_CAUSE_FRAME_COMPLETE) &&
+        (frameSize >= HEADER_SIZE))
+    {
+        uint32_t index;
+        memcpy (&index, framePointer, HEADER_SIZE);
+        ARSTREAM_TransportCompare_FrameReceived (index);
+    }
+    *newBufferCapacity = g_RecvBufferSize;
+    return g_RecvBuffer;
+}
+
+static int ARSTREAM_TransportCompare_RunARStream (ARSTREAM_TransportCompare_Profile_t *profile, int udpPort, ARSTREAM_TransportCompare_Result_t *result)
+{
+    ARSTREAM_Loopback_t *loopback = NULL;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    ARSTREAM_Impairment_Stats_t dataStats;
+    uint8_t *sendBuffers [NB_SEND_BUFFERS];
+    uint32_t maxFrameSize = ARSTREAM_TransportCompare_MaxFrameSize (profile);
+    uint64_t startUs, periodUs;
+    struct timespec drainTime;
+    int drainMs;
+    int retVal = 0;
+    int i;
+
+    memset (result, 0, sizeof (ARSTREAM_TransportCompare_Result_t));
+    if (ARSTREAM_TransportCompare_InitRecording (profile) != 0)
+    {
+        retVal = -1;
+    }
+    g_RecvBufferSize = maxFrameSize;
+    g_RecvBuffer = malloc (g_RecvBufferSize);
+    if (g_RecvBuffer == NULL)
+    {
+        retVal = -1;
+    }
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        sendBuffers [i] = malloc (maxFrameSize);
+        if (sendBuffers [i] == NULL)
+        {
+            retVal = -1;
+        }
+    }
+
+    /* Library objects */
+    if (retVal == 0)
+    {
+        if (udpPort > 0)
+        {
+            sender = ARSTREAM_Sender_NewUDP ("127.0.0.1", udpPort, ARSTREAM_TransportCompare_FrameUpdateCallback, SENDER_QUEUE_SIZE, profile->fragSize, MAX_NB_FRAG, NULL, &err);
+            reader = ARSTREAM_Reader_NewUDP ("127.0.0.1", udpPort, ARSTREAM_TransportCompare_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, profile->fragSize, profile->ackIntervalMs, NULL, &err);
+        }
+        else
+        {
+            loopback = ARSTREAM_Loopback_New (ARSTREAM_LOOPBACK_DEFAULT_NB_PACKETS, profile->fragSize, &err);
+            if (loopback != NULL)
+            {
+                sender = ARSTREAM_Sender_NewLoopback (loopback, ARSTREAM_TransportCompare_FrameUpdateCallback, SENDER_QUEUE_SIZE, profile->fragSize, MAX_NB_FRAG, NULL, &err);
+                reader = ARSTREAM_Reader_NewLoopback (loopback, ARSTREAM_TransportCompare_FrameCompleteCallback, g_RecvBuffer, g_RecvBufferSize, profile->fragSize, profile->ackIntervalMs, NULL, &err);
+            }
+        }
+        if ((sender == NULL) ||
+            (reader == NULL))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to create the sender/reader : %s", ARSTREAM_Error_ToString (err));
+            retVal = -1;
+        }
+    }
+    if (retVal == 0)
+    {
+        if ((ARSTREAM_Sender_SetImpairment (sender, &(profile->data)) != ARSTREAM_OK) ||
+            (ARSTREAM_Reader_SetImpairment (reader, &(profile->ack)) != ARSTREAM_OK) ||
+            (ARSTREAM_Sender_SetTimeBetweenRetries (sender, profile->minRetryMs, profile->maxRetryMs) != ARSTREAM_OK))
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to configure the sender/reader");
+            retVal = -1;
+        }
+    }
+
+    if (retVal == 0)
+    {
+        ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+        ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+        ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+        ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+        /* Open loop : one frame per period, whatever happens on the link */
+        periodUs = 1000000 / profile->fps;
+        startUs = ARSTREAM_TransportCompare_GetTimeUs ();
+        for (i = 0; i < profile->nbFrames; i++)
+        {
+            uint8_t *frame = sendBuffers [i % NB_SEND_BUFFERS];
+            uint32_t frameSize = ARSTREAM_TransportCompare_FrameSize (profile, i);
+            uint64_t targetUs = startUs + i * periodUs;
+            uint64_t nowUs = ARSTREAM_TransportCompare_GetTimeUs ();
+            if (targetUs > nowUs)
+            {
+                usleep ((useconds_t)(targetUs - nowUs));
+            }
+            ARSTREAM_TransportCompare_FillFrame (frame, frameSize, i);
+            pthread_mutex_lock (&g_RecvMutex);
+            g_SendTimesUs [i] = ARSTREAM_TransportCompare_GetTimeUs ();
+            pthread_mutex_unlock (&g_RecvMutex);
+            ARSTREAM_Sender_SendNewFrame (sender, frame, frameSize, ((i % profile->gopLength) == 0) ? 1 : 0, NULL);
+        }
+        drainMs = DRAIN_TIME_MS + profile->maxRetryMs + profile->data.delayMs + profile->data.jitterMs + profile->data.reorderDelayMs;
+        drainTime.tv_sec = drainMs / 1000;
+        drainTime.tv_nsec = (drainMs % 1000) * 1000000L;
+        nanosleep (&drainTime, NULL);
+
+        ARSTREAM_Sender_StopSender (sender);
+        ARSTREAM_Reader_StopReader (reader);
+        ARSAL_Thread_Join (senderDataThread, NULL);
+        ARSAL_Thread_Join (senderAckThread, NULL);
+        ARSAL_Thread_Join (readerDataThread, NULL);
+        ARSAL_Thread_Join (readerAckThread, NULL);
+        ARSAL_Thread_Destroy (&senderDataThread);
+        ARSAL_Thread_Destroy (&senderAckThread);
+        ARSAL_Thread_Destroy (&readerDataThread);
+        ARSAL_Thread_Destroy (&readerAckThread);
+
+        memset (&dataStats, 0, sizeof (dataStats));
+        ARSTREAM_Sender_GetImpairmentStats (sender, &dataStats);
+        result->nbPackets = dataStats.nbPackets;
+        result->nbLost = dataStats.nbLostRandom + dataStats.nbLostBurst + dataStats.nbLostQueue;
+    }
+
+    ARSTREAM_TransportCompare_FinishRecording (profile, result);
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+    ARSTREAM_Loopback_Delete (&loopback);
+    for (i = 0; i < NB_SEND_BUFFERS; i++)
+    {
+        free (sendBuffers [i]);
+    }
+    free (g_RecvBuffer);
+    g_RecvBuffer = NULL;
+    return retVal;
+}
+
+static uint64_t ARSTREAM_TransportCompare_Random (ARSTREAM_TransportCompare_TCPLink_t *link)
+{
+    // Same generator as the library impairment layer
+    uint64_t x = link->prngState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    link->prngState = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int ARSTREAM_TransportCompare_Draw (ARSTREAM_TransportCompare_TCPLink_t *link, float percent)
+{
+    double value;
+    if (percent <= 0.f)
+    {
+        return 0;
+    }
+    value = (double)(ARSTREAM_TransportCompare_Random (link) >> 11) * (100.0 / 9007199254740992.0);
+    return (value < percent) ? 1 : 0;
+}
+
+static int ARSTREAM_TransportCompare_Transmit (ARSTREAM_TransportCompare_TCPLink_t *link, uint32_t size, uint64_t sendUs, int isRetransmission, uint64_t *deliveryUs)
+{
+    ARSTREAM_Impairment_Config_t *config = &(link->config);
+    uint64_t departureUs = sendUs;
+    int isLost;
+
+    link->nbTransmissions++;
+
+    /* Same loss model as ARSTREAM_Impairment_Config_t : Gilbert-Elliott state transition, then loss */
+    if (config->burstEnterPercent > 0.f)
+    {
+        if (link->isInBadState == 0)
+        {
+            link->isInBadState = ARSTREAM_TransportCompare_Draw (link, config->burstEnterPercent);
+        }
+        else if (ARSTREAM_TransportCompare_Draw (link, config->burstExitPercent) != 0)
+        {
+            link->isInBadState = 0;
+        }
+    }
+    isLost = ARSTREAM_TransportCompare_Draw (link, (link->isInBadState != 0) ? config->burstLossPercent : config->lossPercent);
+    if (isLost != 0)
+    {
+        return 0;
+    }
+
+    /* Serialization on the bandwidth limited link */
+    if (config->bandwidthKbps > 0)
+    {
+        uint64_t serializationUs = ((uint64_t)size * 8000) / config->bandwidthKbps;
+        if (isRetransmission != 0)
+        {
+            // The retransmission uses link capacity, but does not delay the segments already queued before it
+            departureUs += serializationUs;
+            link->linkFreeTimeUs += serializationUs;
+        }
+        else
+        {
+            if (link->linkFreeTimeUs > sendUs)
+            {
+                departureUs = link->linkFreeTimeUs;
+            }
+            if ((config->queueLimitBytes > 0) &&
+                ((departureUs - sendUs) * config->bandwidthKbps / 8000 + size > config->queueLimitBytes))
+            {
+                return 0;
+            }
+            departureUs += serializationUs;
+            link->linkFreeTimeUs = departureUs;
+        }
+    }
+
+    /* Propagation delay */
+    *deliveryUs = departureUs + (uint64_t)config->delayMs * 1000;
+    if (config->jitterMs > 0)
+    {
+        *deliveryUs += ARSTREAM_TransportCompare_Random (link) % ((uint64_t)config->jitterMs * 1000 + 1);
+    }
+    return 1;
+}
+
+static uint64_t ARSTREAM_TransportCompare_ScheduleSegment (ARSTREAM_TransportCompare_TCPLink_t *link, uint32_t size, uint64_t nowUs, int nbFollowingSegments)
+{
+    uint64_t sendUs = nowUs;
+    uint64_t rtoUs = (uint64_t)TCP_MIN_RTO_MS * 1000 + link->rttUs;
+    uint64_t deliveryUs = 0;
+    int isRetransmission = 0;
+
+    while (ARSTREAM_TransportCompare_Transmit (link, size, sendUs, isRetransmission, &deliveryUs) == 0)
+    {
+        link->nbLost++;
+        if ((isRetransmission == 0) &&
+            (nbFollowingSegments >= TCP_DUPACK_THRESHOLD))
+        {
+            /* Fast retransmit : the duplicate ACKs of the following segments come back about one RTT later */
+            sendUs += link->rttUs;
+            link->nbFastRetransmits++;
+        }
+        else if (isRetransmission == 0)
+        {
+            /* Tail loss : recovered by a tail loss probe after two RTTs */
+            uint64_t probeUs = 2 * link->rttUs;
+            sendUs += (probeUs > (uint64_t)TCP_MIN_TLP_MS * 1000) ? probeUs : (uint64_t)TCP_MIN_TLP_MS * 1000;
+            link->nbFastRetransmits++;
+        }
+        else
+        {
+            /* Lost retransmission : wait for the retransmission timeout, with exponential backoff */
+            sendUs += rtoUs;
+            rtoUs *= 2;
+            link->nbTimeouts++;
+        }
+        isRetransmission = 1;
+    }
+
+    /* In order delivery to the application : head of line blocking behind the retransmitted segments */
+    if (deliveryUs < link->lastDeliveryUs)
+    {
+        deliveryUs = link->lastDeliveryUs;
+    }
+    link->lastDeliveryUs = deliveryUs;
+    return deliveryUs;
+}
+
+static void* ARSTREAM_TransportCompare_IngressThread (void *param)
+{
+    ARSTREAM_TransportCompare_TCPLink_t *link = (ARSTREAM_TransportCompare_TCPLink_t *)param;
+    uint8_t *buffer = malloc (RELAY_READ_SIZE);
+    ssize_t nbRead = (buffer != NULL) ? 1 : -1;
+
+    while (nbRead > 0)
+    {
+        uint64_t nowUs;
+        ssize_t offset = 0;
+        nbRead = ARSAL_Socket_Recv (link->inSocket, buffer, RELAY_READ_SIZE, 0);
+        if ((nbRead < 0) &&
+            (errno == EINTR))
+        {
+            nbRead = 1;
+            continue;
+        }
+        nowUs = ARSTREAM_TransportCompare_GetTimeUs ();
+        while (offset < nbRead)
+        {
+            ARSTREAM_TransportCompare_Segment_t *segment = malloc (sizeof (ARSTREAM_TransportCompare_Segment_t));
+            uint32_t size = ((nbRead - offset) > TRANSPORT_COMPARE_TCP_MSS) ? TRANSPORT_COMPARE_TCP_MSS : (uint32_t)(nbRead - offset);
+            int nbFollowingSegments = (int)((nbRead - offset - size + TRANSPORT_COMPARE_TCP_MSS - 1) / TRANSPORT_COMPARE_TCP_MSS);
+            if (segment == NULL)
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to allocate a segment");
+                nbRead = -1;
+                break;
+            }
+            segment->next = NULL;
+            segment->size = size;
+            memcpy (segment->data, &buffer [offset], size);
+            segment->deliveryUs = ARSTREAM_TransportCompare_ScheduleSegment (link, size, nowUs, nbFollowingSegments);
+            offset += size;
+
+            pthread_mutex_lock (&(link->mutex));
+            if (link->tail != NULL)
+            {
+                link->tail->next = segment;
+            }
+            else
+            {
+                link->head = segment;
+                pthread_cond_signal (&(link->cond));
+            }
+            link->tail = segment;
+            pthread_mutex_unlock (&(link->mutex));
+        }
+    }
+
+    pthread_mutex_lock (&(link->mutex));
+    link->isClosed = 1;
+    pthread_cond_signal (&(link->cond));
+    pthread_mutex_unlock (&(link->mutex));
+    free (buffer);
+    return (void *)0;
+}
+
+static void* ARSTREAM_TransportCompare_EgressThread (void *param)
+{
+    ARSTREAM_TransportCompare_TCPLink_t *link = (ARSTREAM_TransportCompare_TCPLink_t *)param;
+    int isRunning = 1;
+
+    pthread_mutex_lock (&(link->mutex));
+    while (isRunning != 0)
+    {
+        ARSTREAM_TransportCompare_Segment_t *segment = link->head;
+        uint64_t nowUs = ARSTREAM_TransportCompare_GetTimeUs ();
+        uint32_t offset = 0;
+
+        if (segment == NULL)
+        {
+            if (link->isClosed != 0)
+            {
+                break;
+            }
+            pthread_cond_wait (&(link->cond), &(link->mutex));
+            continue;
+        }
+        if (segment->deliveryUs > nowUs)
+        {
+            struct timespec deadline;
+            deadline.tv_sec = segment->deliveryUs / 1000000;
+            deadline.tv_nsec = (segment->deliveryUs % 1000000) * 1000;
+            pthread_cond_timedwait (&(link->cond), &(link->mutex), &deadline);
+            continue;
+        }
+
+        link->head = segment->next;
+        if (link->head == NULL)
+        {
+            link->tail = NULL;
+        }
+        pthread_mutex_unlock (&(link->mutex));
+
+        while (offset < segment->size)
+        {
+            ssize_t nbSent = ARSAL_Socket_Send (link->outSocket, &(segment->data [offset]), segment->size - offset, MSG_NOSIGNAL);
+            if (nbSent > 0)
+            {
+                offset += nbSent;
+            }
+            else if ((nbSent < 0) &&
+                     (errno != EINTR))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Relay send error : %s", strerror (errno));
+                isRunning = 0;
+                break;
+            }
+        }
+        free (segment);
+        pthread_mutex_lock (&(link->mutex));
+    }
+    pthread_mutex_unlock (&(link->mutex));
+
+    shutdown (link->outSocket, SHUT_WR);
+    return (void *)0;
+}
+
+static void* ARSTREAM_TransportCompare_TCPReaderThread (void *param)
+{
+    ARSTREAM_TransportCompare_TCPReader_t *reader = (ARSTREAM_TransportCompare_TCPReader_t *)param;
+    int size = 0;
+
+    while (size != ARSTREAM_TCPFRAMING_ERROR)
+    {
+        uint32_t num;
+        size = ARSTREAM_TCPFraming_ReadFrame (reader->socket, reader->buffer, reader->capacity, &num);
+        if (size >= HEADER_SIZE)
+        {
+            ARSTREAM_TransportCompare_FrameReceived (num);
+        }
+    }
+    return (void *)0;
+}
+
+static int ARSTREAM_TransportCompare_ConnectLocal (int *clientSocket, int *serverSocket)
+{
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof (addr);
+    int listenSocket = ARSAL_Socket_Create (AF_INET, SOCK_STREAM, 0);
+    int retVal = -1;
+
+    *clientSocket = -1;
+    *serverSocket = -1;
+    if (listenSocket < 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Socket error : %s", strerror (errno));
+        return -1;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if ((ARSAL_Socket_Bind (listenSocket, (struct sockaddr *)&addr, sizeof (addr)) == 0) &&
+        (ARSAL_Socket_Listen (listenSocket, 1) == 0) &&
+        (getsockname (listenSocket, (struct sockaddr *)&addr, &addrLen) == 0))
+    {
+        *clientSocket = ARSAL_Socket_Create (AF_INET, SOCK_STREAM, 0);
+        if ((*clientSocket >= 0) &&
+            (ARSAL_Socket_Connect (*clientSocket, (struct sockaddr *)&addr, sizeof (addr)) == 0))
+        {
+            *serverSocket = ARSAL_Socket_Accept (listenSocket, NULL, NULL);
+        }
+    }
+    if (*serverSocket >= 0)
+    {
+        ARSTREAM_TCPFraming_ConfigureSocket (*clientSocket);
+        ARSTREAM_TCPFraming_ConfigureSocket (*serverSocket);
+        retVal = 0;
+    }
+    else
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Unable to connect on localhost : %s", strerror (errno));
+        if (*clientSocket >= 0)
+        {
+            ARSAL_Socket_Close (*clientSocket);
+            *clientSocket = -1;
+        }
+    }
+    ARSAL_Socket_Close (listenSocket);
+    return retVal;
+}
+
+static int ARSTREAM_TransportCompare_RunTCP (ARSTREAM_TransportCompare_Profile_t *profile, ARSTREAM_TransportCompare_Result_t *result)
+{
+    ARSTREAM_TransportCompare_TCPLink_t link;
+    ARSTREAM_TransportCompare_TCPReader_t reader;
+    pthread_t ingressThread, egressThread, readerThread;
+    pthread_condattr_t condAttr;
+    int senderSocket = -1;
+    uint32_t maxFrameSize = ARSTREAM_TransportCompare_MaxFrameSize (profile);
+    uint8_t *sendBuffer = malloc (maxFrameSize);
+    uint64_t seed, startUs, periodUs;
+    int retVal = 0;
+    int i;
+
+    memset (result, 0, sizeof (ARSTREAM_TransportCompare_Result_t));
+    memset (&link, 0, sizeof (link));
+    memset (&reader, 0, sizeof (reader));
+    link.inSocket = -1;
+    link.outSocket = -1;
+    reader.socket = -1;
+    reader.capacity = maxFrameSize;
+    reader.buffer = malloc (maxFrameSize);
+    if ((ARSTREAM_TransportCompare_InitRecording (profile) != 0) ||
+        (sendBuffer == NULL) ||
+        (reader.buffer == NULL))
+    {
+        retVal = -1;
+    }
+
+    /* sender -> relay ingress, relay egress -> reader : two real localhost TCP connections */
+    if ((retVal == 0) &&
+        ((ARSTREAM_TransportCompare_ConnectLocal (&senderSocket, &(link.inSocket)) != 0) ||
+         (ARSTREAM_TransportCompare_ConnectLocal (&(link.outSocket), &(reader.socket)) != 0)))
+    {
+        retVal = -1;
+    }
+
+    if (retVal == 0)
+    {
+        link.config = profile->data;
+        link.rttUs = ((uint64_t)profile->data.delayMs + profile->data.jitterMs / 2 + profile->ack.delayMs + profile->ack.jitterMs / 2) * 1000;
+        seed = (uint64_t)((link.config.seed != 0) ? link.config.seed : 1) + 0x9E3779B97F4A7C15ULL;
+        seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+        seed ^= seed >> 31;
+        link.prngState = (seed != 0) ? seed : 1;
+        pthread_mutex_init (&(link.mutex), NULL);
+        pthread_condattr_init (&condAttr);
+        pthread_condattr_setclock (&condAttr, CLOCK_MONOTONIC);
+        pthread_cond_init (&(link.cond), &condAttr);
+        pthread_condattr_destroy (&condAttr);
+
+        pthread_create (&readerThread, NULL, ARSTREAM_TransportCompare_TCPReaderThread, &reader);
+        pthread_create (&egressThread, NULL, ARSTREAM_TransportCompare_EgressThread, &link);
+        pthread_create (&ingressThread, NULL, ARSTREAM_TransportCompare_IngressThread, &link);
+
+        /* Open loop : one frame per period, same timing and frames as the ARStream run */
+        periodUs = 1000000 / profile->fps;
+        startUs = ARSTREAM_TransportCompare_GetTimeUs ();
+        for (i = 0; i < profile->nbFrames; i++)
+        {
+            uint32_t frameSize = ARSTREAM_TransportCompare_FrameSize (profile, i);
+            uint64_t targetUs = startUs + i * periodUs;
+            uint64_t nowUs = ARSTREAM_TransportCompare_GetTimeUs ();
+            if (targetUs > nowUs)
+            {
+                usleep ((useconds_t)(targetUs - nowUs));
+            }
+            ARSTREAM_TransportCompare_FillFrame (sendBuffer, frameSize, i);
+            pthread_mutex_lock (&g_RecvMutex);
+            g_SendTimesUs [i] = ARSTREAM_TransportCompare_GetTimeUs ();
+            pthread_mutex_unlock (&g_RecvMutex);
+            if (ARSTREAM_TCPFraming_SendFrame (senderSocket, i, sendBuffer, frameSize) != 0)
+            {
+                break;
+            }
+        }
+
+        /* TCP is reliable : wait for everything to be delivered */
+        shutdown (senderSocket, SHUT_WR);
+        pthread_join (ingressThread, NULL);
+        pthread_join (egressThread, NULL);
+        pthread_join (readerThread, NULL);
+
+        result->nbPackets = link.nbTransmissions;
+        result->nbLost = link.nbLost;
+        result->nbRetransmissions = link.nbFastRetransmits + link.nbTimeouts;
+        result->nbTimeouts = link.nbTimeouts;
+        while (link.head != NULL)
+        {
+            ARSTREAM_TransportCompare_Segment_t *next = link.head->next;
+            free (link.head);
+            link.head = next;
+        }
+        pthread_cond_destroy (&(link.cond));
+        pthread_mutex_destroy (&(link.mutex));
+    }
+
+    ARSTREAM_TransportCompare_FinishRecording (profile, result);
+    if (senderSocket >= 0)
+    {
+        ARSAL_Socket_Close (senderSocket);
+    }
+    if (link.inSocket >= 0)
+    {
+        ARSAL_Socket_Close (link.inSocket);
+    }
+    if (link.outSocket >= 0)
+    {
+        ARSAL_Socket_Close (link.outSocket);
+    }
+    if (reader.socket >= 0)
+    {
+        ARSAL_Socket_Close (reader.socket);
+    }
+    free (reader.buffer);
+    free (sendBuffer);
+    return retVal;
+}
+
+static void ARSTREAM_TransportCompare_PrintResult (ARSTREAM_TransportCompare_Profile_t *profile, const char *transport, ARSTREAM_TransportCompare_Result_t *result, int csv)
+{
+    double deliveredPercent = 100. * result->nbReceived / profile->nbFrames;
+    double linkLossPercent = (result->nbPackets > 0) ? 100. * result->nbLost / result->nbPackets : 0.;
+
+    if (csv != 0)
+    {
+        printf ("%s,%s,%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%u,%u,%u,%.2f,%llu,%llu\n",
+                profile->name, transport, profile->nbFrames, result->nbReceived, deliveredPercent,
+                result->latencyP50Us / 1000., result->latencyP95Us / 1000., result->latencyP99Us / 1000., result->latencyMaxUs / 1000.,
+                result->nbFreezes, result->totalFreezeMs, result->maxFreezeMs, linkLossPercent,
+                (unsigned long long)result->nbRetransmissions, (unsigned long long)result->nbTimeouts);
+    }
+    else
+    {
+        printf ("%-20s %-8s %5d/%-5d %6.1f%% %8.2f %8.2f %8.2f %8.2f %5u %7u %6u %7.2f%% %6llu %5llu\n",
+                profile->name, transport, result->nbReceived, profile->nbFrames, deliveredPercent,
+                result->latencyP50Us / 1000., result->latencyP95Us / 1000., result->latencyP99Us / 1000., result->latencyMaxUs / 1000.,
+                result->nbFreezes, result->totalFreezeMs, result->maxFreezeMs, linkLossPercent,
+                (unsigned long long)result->nbRetransmissions, (unsigned long long)result->nbTimeouts);
+    }
+    fflush (stdout);
+}
+
+static void ARSTREAM_TransportCompare_Usage (const char *name)
+{
+    printf ("Usage: %s [-f profileFile] [-u udpPort] [-c]\n", name);
+    printf ("  -f : read the profiles from a file instead of the built-in list\n");
+    printf ("  -u : run the ARStream side over UDP on localhost instead of an in-process loopback\n");
+    printf ("  -c : print the reports as CSV\n");
+    printf ("Profile file : one profile per line, '#' for comments :\n");
+    printf ("  name [key=value ...]\n");
+    printf ("Stream keys : frames, fps, size (P frame bytes), iratio (I/P size ratio), gop (frames),\n");
+    printf ("  frag, minretry, maxretry (ms), ackinterval (ms)\n");
+    printf ("Impairment keys (prefix with data. or ack. for a single direction) :\n");
+    printf ("  loss, burst_enter, burst_exit, burst_loss, reorder, dup (percent),\n");
+    printf ("  delay, jitter, reorder_delay (ms), bw (kbit/s), queue (bytes), seed\n");
+    printf ("TCP side : data.* keys apply to the segments, the ack. delay and jitter only count in the RTT.\n");
+    printf ("  reorder and dup are ignored : the TCP receiver hides them from the application.\n");
+    printf ("A freeze is a gap of more than %d frame periods between two delivered frames.\n", FREEZE_THRESHOLD_PERIODS);
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_TransportCompare_Main (int argc, char *argv[])
+{
+    ARSTREAM_TransportCompare_Profile_t *profiles = NULL;
+    const char *profileFile = NULL;
+    int nbProfiles;
+    int udpPort = 0;
+    int csv = 0;
+    int nbFailures = 0;
+    int opt, i;
+
+    while ((opt = getopt (argc, argv, "f:u:ch")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f': profileFile = optarg; break;
+        case 'u': udpPort = atoi (optarg); break;
+        case 'c': csv = 1; break;
+        default:
+            ARSTREAM_TransportCompare_Usage (argv[0]);
+            return 1;
+        }
+    }
+
+    if (profileFile != NULL)
+    {
+        nbProfiles = ARSTREAM_TransportCompare_ReadFile (profileFile, &profiles);
+    }
+    else
+    {
+        nbProfiles = ARSTREAM_TransportCompare_BuiltIn (&profiles);
+    }
+    if (nbProfiles <= 0)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "No valid profile to run");
+        free (profiles);
+        return 1;
+    }
+
+    if (csv != 0)
+    {
+        printf ("profile,transport,frames,received,delivered_pct,lat_p50_ms,lat_p95_ms,lat_p99_ms,lat_max_ms,freezes,total_freeze_ms,max_freeze_ms,link_loss_pct,retransmissions,timeouts\n");
+    }
+    else
+    {
+        printf ("%-20s %-8s %11s %7s %8s %8s %8s %8s %5s %7s %6s %8s %6s %5s\n",
+                "profile", "link", "frames", "deliv", "p50(ms)", "p95(ms)", "p99(ms)", "max(ms)", "frz", "totFrz", "maxFrz", "linkLoss", "retx", "rto");
+    }
+
+    for (i = 0; i < nbProfiles; i++)
+    {
+        ARSTREAM_TransportCompare_Result_t result;
+        if (ARSTREAM_TransportCompare_RunARStream (&(profiles [i]), udpPort, &result) == 0)
+        {
+            ARSTREAM_TransportCompare_PrintResult (&(profiles [i]), "arstream", &result, csv);
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Profile %s failed on ARStream", profiles [i].name);
+            nbFailures++;
+        }
+        if (ARSTREAM_TransportCompare_RunTCP (&(profiles [i]), &result) == 0)
+        {
+            ARSTREAM_TransportCompare_PrintResult (&(profiles [i]), "tcp", &result, csv);
+        }
+        else
+        {
+            ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Profile %s failed on TCP", profiles [i].name);
+            nbFailures++;
+        }
+    }
+
+    free (profiles);
+    return (nbFailures == 0) ? 0 : 1;
+}
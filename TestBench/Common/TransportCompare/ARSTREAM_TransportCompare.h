@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_TransportCompare.h
+ * @brief Header file for the ARStream versus TCP comparative benchmark
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+#ifndef _ARSTREAM_TRANSPORTCOMPARE_H_
+#define _ARSTREAM_TRANSPORTCOMPARE_H_
+
+/**
+ * @brief Comparative benchmark entry point
+ * Streams the same frame sequence through an ARSTREAM_Sender_t/ARSTREAM_Reader_t pair and through a TCP
+ * connection using the length-prefixed framing of the TCP testbenches, under the same impairment profiles
+ * (see ARSTREAM_Impairment_Config_t), and prints the latency percentiles and freezes of both transports
+ * side by side.
+ * The TCP connection goes through an in-process relay which applies the profile to MSS sized segments,
+ * and models the retransmissions (fast retransmit, tail loss probe, timeouts) and head of line blocking of TCP.
+ * Run with -h for the options and the profile syntax.
+ * @param argc Argument count of the main function
+ * @param argv Arguments values of the main function
+ * @return The "main" return value
+ */
+int ARSTREAM_TransportCompare_Main (int argc, char *argv[]);
+
+#endif /* _ARSTREAM_TRANSPORTCOMPARE_H_ */
@@ -0,0 +1,277 @@
+/*
+    Copyright (C) 2026 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARSTREAM_UDPLoopback_TestBench.c
+ * @brief Localhost test of the sender and reader over the direct UDP transport
+ * @date 10/19/2026
+ * @author nicolas.brulez@parrot.com
+ */
+
+/*
+ * System Headers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * ARSDK Headers
+ */
+
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARSAL/ARSAL_Time.h>
+#include <libARStream/ARStream.h>
+
+#include "ARSTREAM_UDPLoopback_TestBench.h"
+
+/*
+ * Macros
+ */
+
+#define __TAG__ "ARSTREAM_UDPLoopback_TB"
+
+#define DEFAULT_NB_FRAMES (300)
+#define DEFAULT_FRAME_SIZE (40000)
+#define DEFAULT_FPS (30)
+#define DEFAULT_PORT (5010)
+
+#define FRAG_SIZE (1400)
+#define MAX_NB_FRAG (128)
+#define NB_BUFFERS (16)
+#define IFRAME_INTERVAL (30)
+
+/*
+ * Globals
+ */
+
+static int g_FrameSize = DEFAULT_FRAME_SIZE;
+static uint8_t *g_SendBuffers [NB_BUFFERS];
+static uint8_t *g_RecvBuffer = NULL;
+
+static int g_NbSent = 0;
+static int g_NbCancelled = 0;
+static int g_NbReceived = 0;
+static int g_NbCorrupted = 0;
+static int g_NbSkipped = 0;
+
+/*
+ * Internal functions declarations
+ */
+
+/**
+ * @brief Fills a frame with a pattern depending on its index
+ * @param buffer The frame buffer
+ * @param size The frame size
+ * @param index The frame index
+ */
+static void ARSTREAM_UDPLoopbackTb_FillFrame (uint8_t *buffer, int size, uint32_t index);
+
+/**
+ * @brief Sender callback : counts the sent/cancelled frames
+ */
+static void ARSTREAM_UDPLoopbackTb_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom);
+
+/**
+ * @brief Reader callback : checks the content of the received frames
+ */
+static uint8_t* ARSTREAM_UDPLoopbackTb_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom);
+
+/*
+ * Internal functions implementation
+ */
+
+static void ARSTREAM_UDPLoopbackTb_FillFrame (uint8_t *buffer, int size, uint32_t index)
+{
+    int i;
+    // The first bytes hold the frame index, so the reader can check the pattern
+    memcpy (buffer, &index, sizeof (index));
+    for (i = sizeof (index); i < size; i++)
+    {
+        buffer[i] = (uint8_t)(index * 31 + i);
+    }
+}
+
+static void ARSTREAM_UDPLoopbackTb_FrameUpdateCallback (eARSTREAM_SENDER_STATUS status, uint8_t *framePointer, uint32_t frameSize, void *custom)
+{
+    (void)framePointer;
+    (void)frameSize;
+    (void)custom;
+    switch (status)
+    {
+    case ARSTREAM_SENDER_STATUS_FRAME_SENT:
+        g_NbSent++;
+        break;
+    case ARSTREAM_SENDER_STATUS_FRAME_CANCEL:
+        g_NbCancelled++;
+        break;
+    default:
+        break;
+    }
+}
+
+static uint8_t* ARSTREAM_UDPLoopbackTb_FrameCompleteCallback (eARSTREAM_READER_CAUSE cause, uint8_t *framePointer, uint32_t frameSize, int numberOfSkippedFrames, int isFlushFrame, uint32_t *newBufferCapacity, void *custom)
+{
+    uint32_t index;
+    uint32_t i;
+    (void)isFlushFrame;
+    (void)custom;
+    switch (cause)
+    {
+    case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+        g_NbReceived++;
+        if (numberOfSkippedFrames > 0)
+        {
+            g_NbSkipped += numberOfSkippedFrames;
+        }
+        memcpy (&index, framePointer, sizeof (index));
+        if (frameSize != (uint32_t)g_FrameSize)
+        {
+            g_NbCorrupted++;
+            break;
+        }
+        for (i = sizeof (index); i < frameSize; i++)
+        {
+            if (framePointer[i] != (uint8_t)(index * 31 + i))
+            {
+                ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Frame %u corrupted at byte %u", index, i);
+                g_NbCorrupted++;
+                break;
+            }
+        }
+        break;
+    case ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL:
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Frame buffer too small (%u needed)", *newBufferCapacity);
+        return NULL;
+    default:
+        break;
+    }
+    *newBufferCapacity = g_FrameSize;
+    return g_RecvBuffer;
+}
+
+/*
+ * Implementation
+ */
+
+int ARSTREAM_UDPLoopback_TestBenchMain (int argc, char *argv[])
+{
+    int retVal = 0;
+    int nbFrames = (argc > 1) ? atoi (argv[1]) : DEFAULT_NB_FRAMES;
+    int fps = (argc > 3) ? atoi (argv[3]) : DEFAULT_FPS;
+    int port = (argc > 4) ? atoi (argv[4]) : DEFAULT_PORT;
+    ARSTREAM_Sender_t *sender = NULL;
+    ARSTREAM_Reader_t *reader = NULL;
+    ARSAL_Thread_t senderDataThread, senderAckThread, readerDataThread, readerAckThread;
+    eARSTREAM_ERROR err = ARSTREAM_OK;
+    struct timespec start, end;
+    int elapsedMs;
+    int i;
+
+    g_FrameSize = (argc > 2) ? atoi (argv[2]) : DEFAULT_FRAME_SIZE;
+    if ((nbFrames <= 0) ||
+        (g_FrameSize < (int)sizeof (uint32_t)) ||
+        (g_FrameSize > FRAG_SIZE * MAX_NB_FRAG) ||
+        (fps <= 0) ||
+        (port <= 0))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Usage: %s [nbFrames [frameSize (max %d) [fps [port]]]]", argv[0], FRAG_SIZE * MAX_NB_FRAG);
+        return 1;
+    }
+
+    for (i = 0; i < NB_BUFFERS; i++)
+    {
+        g_SendBuffers[i] = malloc (g_FrameSize);
+    }
+    g_RecvBuffer = malloc (g_FrameSize);
+
+    reader = ARSTREAM_Reader_NewUDP ("127.0.0.1", port, ARSTREAM_UDPLoopbackTb_FrameCompleteCallback, g_RecvBuffer, g_FrameSize, FRAG_SIZE, ARSTREAM_READER_MAX_ACK_INTERVAL_DEFAULT, NULL, &err);
+    if (reader == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Error during ARSTREAM_Reader_NewUDP call : %s", ARSTREAM_Error_ToString (err));
+        return 1;
+    }
+    sender = ARSTREAM_Sender_NewUDP ("127.0.0.1", port, ARSTREAM_UDPLoopbackTb_FrameUpdateCallback, NB_BUFFERS, FRAG_SIZE, MAX_NB_FRAG, NULL, &err);
+    if (sender == NULL)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, __TAG__, "Error during ARSTREAM_Sender_NewUDP call : %s", ARSTREAM_Error_ToString (err));
+        ARSTREAM_Reader_Delete (&reader);
+        return 1;
+    }
+
+    ARSAL_Thread_Create (&readerDataThread, ARSTREAM_Reader_RunDataThread, reader);
+    ARSAL_Thread_Create (&readerAckThread, ARSTREAM_Reader_RunAckThread, reader);
+    ARSAL_Thread_Create (&senderDataThread, ARSTREAM_Sender_RunDataThread, sender);
+    ARSAL_Thread_Create (&senderAckThread, ARSTREAM_Sender_RunAckThread, sender);
+
+    ARSAL_Time_GetTime (&start);
+    for (i = 0; i < nbFrames; i++)
+    {
+        uint8_t *buffer = g_SendBuffers [i % NB_BUFFERS];
+        ARSTREAM_UDPLoopbackTb_FillFrame (buffer, g_FrameSize, i);
+        ARSTREAM_Sender_SendNewFrame (sender, buffer, g_FrameSize, ((i % IFRAME_INTERVAL) == 0) ? 1 : 0, NULL);
+        usleep (1000000 / fps);
+    }
+    // Let the last frame go through
+    usleep (200000);
+    ARSAL_Time_GetTime (&end);
+    elapsedMs = ARSAL_Time_ComputeTimespecMsTimeDiff (&start, &end);
+
+    ARSTREAM_Sender_StopSender (sender);
+    ARSTREAM_Reader_StopReader (reader);
+    ARSAL_Thread_Join (senderDataThread, NULL);
+    ARSAL_Thread_Join (senderAckThread, NULL);
+    ARSAL_Thread_Join (readerDataThread, NULL);
+    ARSAL_Thread_Join (readerAckThread, NULL);
+    ARSAL_Thread_Destroy (&senderDataThread);
+    ARSAL_Thread_Destroy (&senderAckThread);
+    ARSAL_Thread_Destroy (&readerDataThread);
+    ARSAL_Thread_Destroy (&readerAckThread);
+    ARSTREAM_Sender_Delete (&sender);
+    ARSTREAM_Reader_Delete (&reader);
+
+    printf ("Frames : %d sent, %d acknowledged, %d cancelled, %d received, %d skipped, %d corrupted\n", nbFrames, g_NbSent, g_NbCancelled, g_NbReceived, g_NbSkipped, g_NbCorrupted);
+    printf ("Throughput : %.2f Mbit/s over %d ms\n", (elapsedMs > 0) ? ((double)g_NbReceived * g_FrameSize * 8. / (elapsedMs * 1000.)) : 0., elapsedMs);
+    if ((g_NbCorrupted != 0) ||
+        (g_NbReceived == 0))
+    {
+        retVal = 1;
+    }
+
+    for (i = 0; i < NB_BUFFERS; i++)
+    {
+        free (g_SendBuffers[i]);
+    }
+    free (g_RecvBuffer);
+    return retVal;
+}
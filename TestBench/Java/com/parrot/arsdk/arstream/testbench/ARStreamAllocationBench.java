@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+package com.parrot.arsdk.arstream.testbench;
+
+import java.lang.management.ManagementFactory;
+import java.util.concurrent.locks.LockSupport;
+
+import com.parrot.arsdk.ARSDK;
+import com.parrot.arsdk.arsal.ARNativeData;
+
+import com.parrot.arsdk.arstream.ARSTREAM_READER_CAUSE_ENUM;
+import com.parrot.arsdk.arstream.ARSTREAM_SENDER_STATUS_ENUM;
+import com.parrot.arsdk.arstream.ARStreamReaderListener;
+import com.parrot.arsdk.arstream.ARStreamSenderListener;
+
+/**
+ * Checks that the ARStreamReader does not allocate Java objects per frame.<br>
+ * <br>
+ * Frames are streamed over an ARStreamBenchLink, and the reader listener returns
+ * its buffers from a pool allocated once. The bytes allocated by the reader data
+ * thread (ThreadMXBean.getThreadAllocatedBytes, read from inside the listener) must
+ * stay flat across the measured callbacks, after a warmup which lets the JIT settle.<br>
+ * Requires a HotSpot-compatible JVM (com.sun.management.ThreadMXBean).<br>
+ * <br>
+ * Usage: java -Djava.library.path=&lt;ARSDK libs&gt; -cp &lt;ARSDK jars&gt;:. com.parrot.arsdk.arstream.testbench.ARStreamAllocationBench [-n nbMeasuredFrames]<br>
+ * Prints PASSED or FAILED, and exits with 0 if the test passed.
+ */
+public class ARStreamAllocationBench
+{
+    private static final int BASE_PORT = 55030;
+    private static final int DEFAULT_NB_MEASURED_FRAMES = 2000;
+    private static final int WARMUP_FRAMES = 500;
+    private static final int FPS = 500;
+    private static final int FRAME_SIZE = 8000;
+    private static final int NB_SEND_BUFFERS = 16;
+    private static final int GOP_LENGTH = 30;
+    private static final long TIMEOUT_MS = 5000;
+
+    /**
+     * Allowed allocation per callback, averaged over the measured callbacks.<br>
+     * Only covers the two getThreadAllocatedBytes calls themselves : any per frame
+     * object (a boxed value, an array, an enum lookup map entry) is at least 16 bytes.
+     */
+    private static final long MAX_BYTES_PER_CALLBACK = 1;
+
+    /**
+     * Reader listener alternating between two buffers, and sampling the allocated bytes of its thread
+     */
+    private static class PoolReaderListener implements ARStreamReaderListener
+    {
+        private final ARNativeData[] pool = { new ARNativeData (ARStreamBenchLink.FRAME_CAPACITY), new ARNativeData (ARStreamBenchLink.FRAME_CAPACITY) };
+        private final com.sun.management.ThreadMXBean threadBean = (com.sun.management.ThreadMXBean) ManagementFactory.getThreadMXBean ();
+        private final int nbMeasuredFrames;
+        private int poolIndex = 0;
+        volatile int nbFrames = 0;
+        volatile long startBytes = -1;
+        volatile long endBytes = -1;
+
+        PoolReaderListener (int nbMeasuredFrames) {
+            this.nbMeasuredFrames = nbMeasuredFrames;
+        }
+
+        ARNativeData firstBuffer () {
+            return pool[0];
+        }
+
+        public ARNativeData didUpdateFrameStatus (ARSTREAM_READER_CAUSE_ENUM cause, ARNativeData currentFrame, boolean isFlushFrame, int nbSkippedFrames, int newBufferCapacity) {
+            switch (cause) {
+            case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+            case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+                int nb = nbFrames + 1;
+                if (nb == WARMUP_FRAMES) {
+                    startBytes = threadBean.getThreadAllocatedBytes (Thread.currentThread ().getId ());
+                } else if (nb == WARMUP_FRAMES + nbMeasuredFrames) {
+                    endBytes = threadBean.getThreadAllocatedBytes (Thread.currentThread ().getId ());
+                }
+                nbFrames = nb;
+                poolIndex ^= 1;
+                return pool[poolIndex];
+            default:
+                // Frames always fit the pool buffers : no "too small" event is expected
+                return null;
+            }
+        }
+    }
+
+    /**
+     * Sender listener which does nothing : the send buffers are reused round robin
+     */
+    private static class IdleSenderListener implements ARStreamSenderListener
+    {
+        public void didUpdateFrameStatus (ARSTREAM_SENDER_STATUS_ENUM cause, ARNativeData currentFrame) {
+        }
+    }
+
+    private static void usage () {
+        System.out.println ("Usage: ARStreamAllocationBench [-n nbMeasuredFrames]");
+        System.out.println ("  -n : number of reader callbacks measured after " + WARMUP_FRAMES + " warmup frames (default " + DEFAULT_NB_MEASURED_FRAMES + ")");
+    }
+
+    public static void main (String[] args) throws InterruptedException {
+        int nbMeasuredFrames = DEFAULT_NB_MEASURED_FRAMES;
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals ("-n") && (i + 1 < args.length)) {
+                nbMeasuredFrames = Integer.parseInt (args[++i]);
+            } else {
+                usage ();
+                System.exit (1);
+            }
+        }
+        if (nbMeasuredFrames <= 0) {
+            usage ();
+            System.exit (1);
+        }
+
+        com.sun.management.ThreadMXBean threadBean = (com.sun.management.ThreadMXBean) ManagementFactory.getThreadMXBean ();
+        if (!threadBean.isThreadAllocatedMemorySupported ()) {
+            System.out.println ("Thread allocated memory is not supported by this JVM");
+            System.out.println ("FAILED");
+            System.exit (1);
+        }
+        threadBean.setThreadAllocatedMemoryEnabled (true);
+
+        ARSDK.loadSDKLibs ();
+
+        PoolReaderListener readerListener = new PoolReaderListener (nbMeasuredFrames);
+        ARStreamBenchLink link = new ARStreamBenchLink (BASE_PORT, new IdleSenderListener (), readerListener, readerListener.firstBuffer ());
+        ARNativeData[] sendBuffers = new ARNativeData[NB_SEND_BUFFERS];
+        for (int i = 0; i < NB_SEND_BUFFERS; i++) {
+            sendBuffers[i] = new ARNativeData (FRAME_SIZE);
+            sendBuffers[i].setUsedSize (FRAME_SIZE);
+        }
+        link.start ();
+
+        int nbExpected = WARMUP_FRAMES + nbMeasuredFrames;
+        long periodNs = 1000000000L / FPS;
+        long startNs = System.nanoTime ();
+        long lastProgressNs = startNs;
+        int lastNbFrames = 0;
+        boolean stalled = false;
+        for (int i = 0; readerListener.nbFrames < nbExpected; i++) {
+            long waitNs = startNs + i * periodNs - System.nanoTime ();
+            if (waitNs > 0) {
+                LockSupport.parkNanos (waitNs);
+            }
+            int nbFrames = readerListener.nbFrames;
+            if (nbFrames != lastNbFrames) {
+                lastNbFrames = nbFrames;
+                lastProgressNs = System.nanoTime ();
+            } else if ((System.nanoTime () - lastProgressNs) / 1000000L > TIMEOUT_MS) {
+                stalled = true;
+                break;
+            }
+            link.sender.sendNewFrame (sendBuffers[i % NB_SEND_BUFFERS], (i % GOP_LENGTH) == 0);
+        }
+        link.close ();
+
+        boolean passed = false;
+        if (stalled) {
+            System.out.println ("No frame received for " + TIMEOUT_MS + " ms (after " + lastNbFrames + " frames)");
+        } else {
+            long bytes = readerListener.endBytes - readerListener.startBytes;
+            System.out.println ("Reader data thread : " + bytes + " bytes allocated over " + nbMeasuredFrames + " callbacks (" + ((double)bytes / nbMeasuredFrames) + " per callback)");
+            passed = (readerListener.startBytes >= 0) && (bytes <= MAX_BYTES_PER_CALLBACK * nbMeasuredFrames);
+        }
+        System.out.println (passed ? "PASSED" : "FAILED");
+        System.exit (passed ? 0 : 1);
+    }
+}
@@ -0,0 +1,173 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+package com.parrot.arsdk.arstream.testbench;
+
+import com.parrot.arsdk.arsal.ARNativeData;
+
+import com.parrot.arsdk.arnetwork.ARNetworkManager;
+import com.parrot.arsdk.arnetwork.ARNetworkIOBufferParam;
+import com.parrot.arsdk.arnetwork.ARNETWORK_MANAGER_CALLBACK_RETURN_ENUM;
+import com.parrot.arsdk.arnetwork.ARNETWORK_MANAGER_CALLBACK_STATUS_ENUM;
+import com.parrot.arsdk.arnetworkal.ARNetworkALManager;
+import com.parrot.arsdk.arnetworkal.ARNETWORKAL_ERROR_ENUM;
+
+import com.parrot.arsdk.arstream.ARStreamReader;
+import com.parrot.arsdk.arstream.ARStreamReaderListener;
+import com.parrot.arsdk.arstream.ARStreamSender;
+import com.parrot.arsdk.arstream.ARStreamSenderListener;
+
+/**
+ * An ARStreamSender and an ARStreamReader connected through two ARNetworkManager on localhost.<br>
+ * <br>
+ * Used by the Java benches, which run on a desktop JVM with the ARSDK native libraries
+ * in <code>java.library.path</code>. All the threads are started by <code>start</code>
+ * and joined by <code>close</code>.
+ */
+public class ARStreamBenchLink
+{
+    public static final int DATA_BUFFER_ID = 125;
+    public static final int ACK_BUFFER_ID = 13;
+    public static final int FRAG_SIZE = 1000;
+    public static final int MAX_NB_FRAG = 128;
+    public static final int FRAME_CAPACITY = FRAG_SIZE * MAX_NB_FRAG;
+    public static final int SENDER_QUEUE_SIZE = 8;
+
+    private static final String ADDRESS = "127.0.0.1";
+    private static final int RECV_TIMEOUT_SEC = 1;
+    private static final int PING_DELAY_MS = 0;
+
+    private final ARNetworkALManager senderAlManager;
+    private final ARNetworkALManager readerAlManager;
+    private ARNetworkManager senderNetManager;
+    private ARNetworkManager readerNetManager;
+    private final Thread[] threads;
+
+    public final ARStreamSender sender;
+    public final ARStreamReader reader;
+
+    /**
+     * Network manager without application buffers : the callbacks are never called for the ARStream buffers
+     */
+    private static class BenchNetworkManager extends ARNetworkManager
+    {
+        public BenchNetworkManager (ARNetworkALManager alManager, ARNetworkIOBufferParam[] inputParams, ARNetworkIOBufferParam[] outputParams)
+        {
+            super (alManager, inputParams, outputParams, PING_DELAY_MS);
+        }
+
+        @Override
+        public ARNETWORK_MANAGER_CALLBACK_RETURN_ENUM onCallback (int ioBufferId, ARNativeData data, ARNETWORK_MANAGER_CALLBACK_STATUS_ENUM status, Object customData) {
+            return ARNETWORK_MANAGER_CALLBACK_RETURN_ENUM.ARNETWORK_MANAGER_CALLBACK_RETURN_DEFAULT;
+        }
+
+        @Override
+        public void onDisconnect (ARNetworkALManager alManager) {
+        }
+    }
+
+    /**
+     * Creates the sender and the reader
+     * @param basePort The sender sends to basePort, the reader sends its acks to basePort + 1
+     * @param senderListener Listener of the sender
+     * @param readerListener Listener of the reader
+     * @param firstReaderBuffer First frame buffer of the reader (at least FRAME_CAPACITY bytes)
+     * @throws IllegalStateException if the link could not be created
+     */
+    public ARStreamBenchLink (int basePort, ARStreamSenderListener senderListener, ARStreamReaderListener readerListener, ARNativeData firstReaderBuffer)
+    {
+        senderAlManager = new ARNetworkALManager ();
+        readerAlManager = new ARNetworkALManager ();
+        if ((senderAlManager.initWifiNetwork (ADDRESS, basePort, basePort + 1, RECV_TIMEOUT_SEC) != ARNETWORKAL_ERROR_ENUM.ARNETWORKAL_OK) ||
+            (readerAlManager.initWifiNetwork (ADDRESS, basePort + 1, basePort, RECV_TIMEOUT_SEC) != ARNETWORKAL_ERROR_ENUM.ARNETWORKAL_OK)) {
+            throw new IllegalStateException ("Unable to open the localhost sockets on ports " + basePort + " and " + (basePort + 1));
+        }
+
+        ARNetworkIOBufferParam[] dataParams = { ARStreamSender.newDataARNetworkIOBufferParam (DATA_BUFFER_ID, FRAG_SIZE, MAX_NB_FRAG) };
+        ARNetworkIOBufferParam[] ackParams = { ARStreamSender.newAckARNetworkIOBufferParam (ACK_BUFFER_ID) };
+        senderNetManager = new BenchNetworkManager (senderAlManager, dataParams, ackParams);
+        readerNetManager = new BenchNetworkManager (readerAlManager, ackParams, dataParams);
+        if (!senderNetManager.isCorrectlyInitialized () ||
+            !readerNetManager.isCorrectlyInitialized ()) {
+            throw new IllegalStateException ("Unable to create the network managers");
+        }
+
+        sender = new ARStreamSender (senderNetManager, DATA_BUFFER_ID, ACK_BUFFER_ID, senderListener, SENDER_QUEUE_SIZE, FRAG_SIZE, MAX_NB_FRAG);
+        reader = new ARStreamReader (readerNetManager, DATA_BUFFER_ID, ACK_BUFFER_ID, firstReaderBuffer, readerListener, FRAG_SIZE, ARStreamReader.DEFAULT_MAX_ACK_INTERVAL);
+        if (!sender.isValid () ||
+            !reader.isValid ()) {
+            throw new IllegalStateException ("Unable to create the sender/reader");
+        }
+
+        threads = new Thread[] {
+            new Thread (senderNetManager.m_sendingRunnable, "SenderNetSend"),
+            new Thread (senderNetManager.m_receivingRunnable, "SenderNetRecv"),
+            new Thread (readerNetManager.m_sendingRunnable, "ReaderNetSend"),
+            new Thread (readerNetManager.m_receivingRunnable, "ReaderNetRecv"),
+            new Thread (sender.getDataRunnable (), "SenderData"),
+            new Thread (sender.getAckRunnable (), "SenderAck"),
+            new Thread (reader.getDataRunnable (), "ReaderData"),
+            new Thread (reader.getAckRunnable (), "ReaderAck"),
+        };
+    }
+
+    /**
+     * Starts the network and stream threads
+     */
+    public void start () {
+        for (Thread thread : threads) {
+            thread.start ();
+        }
+    }
+
+    /**
+     * Stops and joins all the threads, then disposes the sender, the reader and the network managers
+     */
+    public void close () throws InterruptedException {
+        sender.stop ();
+        reader.stop ();
+        for (int i = 4; i < threads.length; i++) {
+            threads[i].join ();
+        }
+        senderNetManager.stop ();
+        readerNetManager.stop ();
+        for (int i = 0; i < 4; i++) {
+            threads[i].join ();
+        }
+        sender.dispose ();
+        reader.dispose ();
+        senderNetManager.dispose ();
+        readerNetManager.dispose ();
+        senderAlManager.closeWifiNetwork ();
+        readerAlManager.closeWifiNetwork ();
+        senderAlManager.dispose ();
+        readerAlManager.dispose ();
+    }
+}
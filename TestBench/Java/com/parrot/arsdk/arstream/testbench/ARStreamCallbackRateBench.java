@@ -0,0 +1,213 @@
+/*
+  Copyright (C) 2026 Parrot SA
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+  * Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in
+  the documentation and/or other materials provided with the
+  distribution.
+  * Neither the name of Parrot nor the names
+  of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written
+  permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+  AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+  SUCH DAMAGE.
+*/
+package com.parrot.arsdk.arstream.testbench;
+
+import java.lang.management.ManagementFactory;
+import java.util.concurrent.atomic.AtomicLong;
+
+import com.parrot.arsdk.ARSDK;
+import com.parrot.arsdk.arsal.ARNativeData;
+
+import com.parrot.arsdk.arstream.ARSTREAM_ERROR_ENUM;
+import com.parrot.arsdk.arstream.ARSTREAM_READER_CAUSE_ENUM;
+import com.parrot.arsdk.arstream.ARSTREAM_SENDER_STATUS_ENUM;
+import com.parrot.arsdk.arstream.ARStreamReaderListener;
+import com.parrot.arsdk.arstream.ARStreamSenderListener;
+
+/**
+ * Measures the rate of the ARStreamSender callbacks, and the Java allocations they cause.<br>
+ * <br>
+ * Single fragment frames are sent over an ARStreamBenchLink as fast as the sender
+ * accepts them. After a warmup, the bench counts the "frame sent" callbacks and the
+ * bytes allocated by the thread calling them (ThreadMXBean.getThreadAllocatedBytes)
+ * for the measurement duration. The rate depends on the machine and is only reported :
+ * run the bench on two revisions to compare them. The bench fails if the stream stalls,
+ * or if the sender callbacks allocate Java objects.<br>
+ * Requires a HotSpot-compatible JVM (com.sun.management.ThreadMXBean).<br>
+ * <br>
+ * Usage: java -Djava.library.path=&lt;ARSDK libs&gt; -cp &lt;ARSDK jars&gt;:. com.parrot.arsdk.arstream.testbench.ARStreamCallbackRateBench [-d durationSec]<br>
+ * Prints PASSED or FAILED, and exits with 0 if the test passed.
+ */
+public class ARStreamCallbackRateBench
+{
+    private static final int BASE_PORT = 55040;
+    private static final int DEFAULT_DURATION_SEC = 5;
+    private static final long WARMUP_MS = 1000;
+    private static final int FRAME_SIZE = ARStreamBenchLink.FRAG_SIZE;
+    private static final int NB_SEND_BUFFERS = 32;
+    private static final int GOP_LENGTH = 30;
+
+    /**
+     * Allowed allocation per "frame sent" callback, averaged over the measurement.<br>
+     * Any per frame object (a boxed key, a map entry, an enum lookup) is at least 16 bytes.
+     */
+    private static final long MAX_BYTES_PER_CALLBACK = 1;
+
+    /**
+     * Sender listener counting the callbacks, and remembering the thread which calls the "frame sent" ones
+     */
+    private static class CountingSenderListener implements ARStreamSenderListener
+    {
+        final AtomicLong nbSent = new AtomicLong ();
+        final AtomicLong nbCancelled = new AtomicLong ();
+        volatile long sentThreadId = -1;
+
+        public void didUpdateFrameStatus (ARSTREAM_SENDER_STATUS_ENUM cause, ARNativeData currentFrame) {
+            switch (cause) {
+            case ARSTREAM_SENDER_STATUS_FRAME_SENT:
+                if (sentThreadId < 0) {
+                    sentThreadId = Thread.currentThread ().getId ();
+                }
+                nbSent.incrementAndGet ();
+                break;
+            case ARSTREAM_SENDER_STATUS_FRAME_CANCEL:
+                nbCancelled.incrementAndGet ();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    /**
+     * Reader listener counting the frames, and always reusing the same buffer
+     */
+    private static class CountingReaderListener implements ARStreamReaderListener
+    {
+        final ARNativeData buffer = new ARNativeData (ARStreamBenchLink.FRAME_CAPACITY);
+        volatile long nbFrames = 0;
+
+        public ARNativeData didUpdateFrameStatus (ARSTREAM_READER_CAUSE_ENUM cause, ARNativeData currentFrame, boolean isFlushFrame, int nbSkippedFrames, int newBufferCapacity) {
+            switch (cause) {
+            case ARSTREAM_READER_CAUSE_FRAME_COMPLETE:
+            case ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE:
+                nbFrames++;
+                return buffer;
+            default:
+                return null;
+            }
+        }
+    }
+
+    private static void usage () {
+        System.out.println ("Usage: ARStreamCallbackRateBench [-d durationSec]");
+        System.out.println ("  -d : measurement duration, after " + WARMUP_MS + " ms of warmup (default " + DEFAULT_DURATION_SEC + ")");
+    }
+
+    /**
+     * Index of the next frame to send
+     */
+    private static long frameIndex = 0;
+
+    /**
+     * Sends frames until the given time, retrying the frames refused because the queue is full
+     * @return The number of refused sends
+     */
+    private static long sendUntil (ARStreamBenchLink link, ARNativeData[] sendBuffers, long endNs) {
+        long nbQueueFull = 0;
+        for (; System.nanoTime () < endNs; frameIndex++) {
+            ARNativeData frame = sendBuffers[(int)(frameIndex % NB_SEND_BUFFERS)];
+            while ((link.sender.sendNewFrame (frame, (frameIndex % GOP_LENGTH) == 0) == ARSTREAM_ERROR_ENUM.ARSTREAM_ERROR_QUEUE_FULL) &&
+                   (System.nanoTime () < endNs)) {
+                nbQueueFull++;
+                Thread.yield ();
+            }
+        }
+        return nbQueueFull;
+    }
+
+    public static void main (String[] args) throws InterruptedException {
+        int durationSec = DEFAULT_DURATION_SEC;
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals ("-d") && (i + 1 < args.length)) {
+                durationSec = Integer.parseInt (args[++i]);
+            } else {
+                usage ();
+                System.exit (1);
+            }
+        }
+        if (durationSec <= 0) {
+            usage ();
+            System.exit (1);
+        }
+
+        com.sun.management.ThreadMXBean threadBean = (com.sun.management.ThreadMXBean) ManagementFactory.getThreadMXBean ();
+        if (!threadBean.isThreadAllocatedMemorySupported ()) {
+            System.out.println ("Thread allocated memory is not supported by this JVM");
+            System.out.println ("FAILED");
+            System.exit (1);
+        }
+        threadBean.setThreadAllocatedMemoryEnabled (true);
+
+        ARSDK.loadSDKLibs ();
+
+        CountingSenderListener senderListener = new CountingSenderListener ();
+        CountingReaderListener readerListener = new CountingReaderListener ();
+        ARStreamBenchLink link = new ARStreamBenchLink (BASE_PORT, senderListener, readerListener, readerListener.buffer);
+        ARNativeData[] sendBuffers = new ARNativeData[NB_SEND_BUFFERS];
+        for (int i = 0; i < NB_SEND_BUFFERS; i++) {
+            sendBuffers[i] = new ARNativeData (FRAME_SIZE);
+            sendBuffers[i].setUsedSize (FRAME_SIZE);
+        }
+        link.start ();
+
+        // Warmup : lets the JIT compile the callback paths
+        sendUntil (link, sendBuffers, System.nanoTime () + WARMUP_MS * 1000000L);
+
+        long sentThreadId = senderListener.sentThreadId;
+        long startSent = senderListener.nbSent.get ();
+        long startCancelled = senderListener.nbCancelled.get ();
+        long startFrames = readerListener.nbFrames;
+        long startBytes = (sentThreadId >= 0) ? threadBean.getThreadAllocatedBytes (sentThreadId) : -1;
+        long startNs = System.nanoTime ();
+        long nbQueueFull = sendUntil (link, sendBuffers, startNs + durationSec * 1000000000L);
+        long endBytes = (sentThreadId >= 0) ? threadBean.getThreadAllocatedBytes (sentThreadId) : -1;
+        long elapsedNs = System.nanoTime () - startNs;
+        long nbSent = senderListener.nbSent.get () - startSent;
+        long nbCancelled = senderListener.nbCancelled.get () - startCancelled;
+        long nbFrames = readerListener.nbFrames - startFrames;
+        link.close ();
+
+        double seconds = elapsedNs / 1e9;
+        System.out.println ("Sender : " + nbSent + " frame sent callbacks (" + (long)(nbSent / seconds) + " /s), " + nbCancelled + " cancel callbacks, " + nbQueueFull + " queue full retries");
+        System.out.println ("Reader : " + nbFrames + " frames (" + (long)(nbFrames / seconds) + " /s)");
+        boolean passed = false;
+        if ((sentThreadId < 0) || (nbSent == 0)) {
+            System.out.println ("No frame sent callback during the measurement");
+        } else {
+            long bytes = endBytes - startBytes;
+            System.out.println ("Sender callback thread : " + bytes + " bytes allocated (" + ((double)bytes / nbSent) + " per frame sent callback)");
+            passed = (bytes <= MAX_BYTES_PER_CALLBACK * nbSent);
+        }
+        System.out.println (passed ? "PASSED" : "FAILED");
+        System.exit (passed ? 0 : 1);
+    }
+}
@@ -17,18 +17,53 @@ LOCAL_C_INCLUDES := \
 LOCAL_CFLAGS := \
 	-DHAVE_CONFIG_H
 
+# Virtual clock build, see ARSTREAM_Simulation.h (never for production)
+ifeq ("$(ARSTREAM_SIMULATION)","1")
+LOCAL_CFLAGS += -DARSTREAM_SIMULATION=1
+LOCAL_EXPORT_CFLAGS += -DARSTREAM_SIMULATION=1
+endif
+
+# Tracepoints are built in (disabled at runtime) unless ARSTREAM_TRACE=0, see ARSTREAM_Trace.h
+ifeq ("$(ARSTREAM_TRACE)","0")
+LOCAL_CFLAGS += -DARSTREAM_TRACE=0
+endif
+
 LOCAL_SRC_FILES := \
 	Sources/ARSTREAM_Buffers.c \
+	Sources/ARSTREAM_CaptureFile.c \
+	Sources/ARSTREAM_CipherFilter.c \
+	Sources/ARSTREAM_JitterBuffer.c \
 	Sources/ARSTREAM_NetworkHeaders.c \
+	Sources/ARSTREAM_Publisher.c \
 	Sources/ARSTREAM_Reader.c \
+	Sources/ARSTREAM_Reader2.c \
 	Sources/ARSTREAM_Sender.c \
+	Sources/ARSTREAM_Sender2.c \
+	Sources/ARSTREAM_Simulation.c \
+	Sources/ARSTREAM_Trace.c \
+	Sources/ARSTREAM_Transport.c \
+	Sources/ARSTREAM_TransportImpairment.c \
+	Sources/ARSTREAM_TransportLoopback.c \
+	Sources/ARSTREAM_TransportReplay.c \
+	Sources/ARSTREAM_TransportUDP.c \
 	gen/Sources/ARSTREAM_Error.c
 
 LOCAL_INSTALL_HEADERS := \
 	Includes/libARStream/ARStream.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Capture.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_CipherFilter.h:usr/include/libARStream/ \
 	Includes/libARStream/ARSTREAM_Error.h:usr/include/libARStream/ \
 	Includes/libARStream/ARSTREAM_Filter.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Impairment.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_JitterBuffer.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Loopback.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Publisher.h:usr/include/libARStream/ \
 	Includes/libARStream/ARSTREAM_Reader.h:usr/include/libARStream/  \
+	Includes/libARStream/ARSTREAM_Reader2.h:usr/include/libARStream/ \
 	Includes/libARStream/ARSTREAM_Sender.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Sender2.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Simulation.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Stats.h:usr/include/libARStream/ \
+	Includes/libARStream/ARSTREAM_Trace.h:usr/include/libARStream/ \
 
 include $(BUILD_LIBRARY)
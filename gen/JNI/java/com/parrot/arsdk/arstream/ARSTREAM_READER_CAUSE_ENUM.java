@@ -51,7 +51,9 @@ public enum ARSTREAM_READER_CAUSE_ENUM {
     ARSTREAM_READER_CAUSE_COPY_COMPLETE (2, "Copy of previous frame buffer is complete (called only after ARSTREAM_READER_CAUSE_FRAME_TOO_SMALL)"),
    /** Reader is closing, so buffer is no longer used */
     ARSTREAM_READER_CAUSE_CANCEL (3, "Reader is closing, so buffer is no longer used"),
-   ARSTREAM_READER_CAUSE_MAX (4);
+   /** Frame is incomplete (only sent when partial frame delivery is enabled) */
+    ARSTREAM_READER_CAUSE_FRAME_INCOMPLETE (4, "Frame is incomplete (only sent when partial frame delivery is enabled)"),
+   ARSTREAM_READER_CAUSE_MAX (5);
 
     private final int value;
     private final String comment;
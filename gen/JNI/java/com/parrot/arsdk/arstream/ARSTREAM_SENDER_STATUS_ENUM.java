@@ -49,7 +49,9 @@ public enum ARSTREAM_SENDER_STATUS_ENUM {
     ARSTREAM_SENDER_STATUS_FRAME_CANCEL (1, "Frame was not sent, and was cancelled by a new frame"),
    /** We received a full ack for an old frame. The callback will be called with null pointer and zero size. */
     ARSTREAM_SENDER_STATUS_FRAME_LATE_ACK (2, "We received a full ack for an old frame. The callback will be called with null pointer and zero size."),
-   ARSTREAM_SENDER_STATUS_MAX (3);
+   /** The reader asked for a key frame. The callback will be called with null pointer, and the reason as the size. */
+    ARSTREAM_SENDER_STATUS_KEY_FRAME_REQUEST (3, "The reader asked for a key frame. The callback will be called with null pointer, and the reason as the size."),
+   ARSTREAM_SENDER_STATUS_MAX (4);
 
     private final int value;
     private final String comment;
@@ -62,6 +62,9 @@ const char* ARSTREAM_Error_ToString (eARSTREAM_ERROR error)
     case ARSTREAM_ERROR_QUEUE_FULL:
         return "Frame queue is full";
         break;
+    case ARSTREAM_ERROR_NOT_SYNCHRONIZED:
+        return "Clocks are not synchronized yet";
+        break;
     default:
         break;
     }